@@ -16,6 +16,9 @@ constexpr float DEFAULT_PEROBJECT_MAX_INTERACTION_DISTANCE = 150;
 constexpr float DEFAULT_TRACER_MAX_INTERACTION_DISTANCE = 1500;
 constexpr float DEFAULT_TRACER_MAX_RADIAL_DISTANCE = 500;
 
+/* Spatial index */
+constexpr double DEFAULT_INTERACTABLE_INDEX_CELLSIZE = DEFAULT_TRACER_MAX_RADIAL_DISTANCE * 2;
+
 
 namespace PD::Interact::Constants
 {
@@ -433,6 +436,86 @@ struct PDINTERACTION_API FRTSSavedInteractable
 	}
 };
 
+/**
+ * @brief Uniform hash-grid over the registered interactables of a world, keyed by their instance IDs.
+ * Lets radius and closest-interactable queries run without touching the physics scene.
+ * @note Is maintained by 'UPDInteractSubsystem' on register, deregister and movement. Queries are read-only and safe to run in parallel
+ */
+struct PDINTERACTION_API FPDInteractableSpatialIndex
+{
+	/** @brief Indexed data for a single interactable */
+	struct FEntry
+	{
+		/** @brief The interactable actor */
+		TWeakObjectPtr<AActor> Actor = nullptr;
+		/** @brief Last indexed location */
+		FVector Location = FVector::ZeroVector;
+		/** @brief Cell the interactable is currently bucketed in */
+		FIntVector Cell = FIntVector::ZeroValue;
+		/** @brief Cached result of 'IPDInteractInterface::GetMaxInteractionDistance', resolved when (re-)indexed */
+		double MaxInteractionDistance = DEFAULT_PEROBJECT_MAX_INTERACTION_DISTANCE;
+		/** @brief Collision object types of the actors query-enabled primitive components, one bit per 'ECollisionChannel'. Resolved when (re-)indexed */
+		uint32 ObjectTypeBits = 0;
+	};
+
+	/** @brief Adds, or re-adds, an interactable to the index */
+	void Add(int32 InstanceID, AActor* Interactable, const FVector& Location, double MaxInteractionDistance);
+	/** @brief Removes an interactable from the index */
+	void Remove(int32 InstanceID);
+	/** @brief Updates the location of an indexed interactable. Only touches the cell buckets if the cell has changed
+	 * @return false if the interactable was not indexed */
+	bool Move(int32 InstanceID, const FVector& NewLocation);
+	/** @brief Clears the index */
+	void Reset();
+
+	/** @brief Gathers the instance IDs of all interactables within radius of origin.
+	 * @param bRespectPerObjectInteractionDistance if true, also filters out interactables that are further away than their own max interaction distance
+	 * @param ObjectTypeFilter if set, filters out interactables without a query-enabled primitive of that object type. 'ObjectTypeQuery_MAX' does not filter */
+	void QueryRadius(const FVector& Origin, double Radius, bool bRespectPerObjectInteractionDistance, TArray<int32>& OutInstanceIDs, const AActor* IgnoredActor = nullptr, EObjectTypeQuery ObjectTypeFilter = EObjectTypeQuery::ObjectTypeQuery_MAX) const;
+	/** @brief Returns the instance ID of the closest interactable within radius of origin, INDEX_NONE if none was found. Filters like 'QueryRadius'
+	 * @note Ties are broken by the lowest instance ID, so results are stable between frames */
+	int32 FindClosest(const FVector& Origin, double Radius, bool bRespectPerObjectInteractionDistance, const AActor* IgnoredActor = nullptr, EObjectTypeQuery ObjectTypeFilter = EObjectTypeQuery::ObjectTypeQuery_MAX) const;
+
+	/** @brief Returns the entry for the given instance ID, nullptr if it is not indexed */
+	FORCEINLINE const FEntry* FindEntry(int32 InstanceID) const { return Entries.Find(InstanceID); }
+	/** @brief Returns the actor for the given instance ID, nullptr if it is not indexed or has been destroyed */
+	FORCEINLINE AActor* GetActor(int32 InstanceID) const { const FEntry* Entry = Entries.Find(InstanceID); return Entry != nullptr ? Entry->Actor.Get() : nullptr; }
+	/** @brief Number of indexed interactables */
+	FORCEINLINE int32 Num() const { return Entries.Num(); }
+
+	/** @brief Collects the object types of the actors query-enabled primitive components, one bit per 'ECollisionChannel' */
+	static uint32 GatherObjectTypeBits(const AActor* Interactable);
+	/** @brief Does the entry pass the object type filter, always true for 'ObjectTypeQuery_MAX' */
+	static FORCEINLINE bool MatchesObjectType(const FEntry& Entry, EObjectTypeQuery ObjectTypeFilter)
+	{
+		return ObjectTypeFilter == EObjectTypeQuery::ObjectTypeQuery_MAX
+			|| (Entry.ObjectTypeBits & (1u << UEngineTypes::ConvertToCollisionChannel(ObjectTypeFilter))) != 0;
+	}
+
+	/** @brief Calculates the cell a location falls into */
+	FORCEINLINE FIntVector GetCell(const FVector& Location) const
+	{
+		return FIntVector{
+			FMath::FloorToInt32(Location.X / CellSize),
+			FMath::FloorToInt32(Location.Y / CellSize),
+			FMath::FloorToInt32(Location.Z / CellSize)};
+	}
+
+private:
+	/** @brief Calls 'Visitor' for every indexed entry that may be within radius of origin. Walks the overlapped cells,
+	 * or all entries if the query volume covers more cells than there are entries */
+	void ForEachCandidate(const FVector& Origin, double Radius, TFunctionRef<void(int32 /*InstanceID*/, const FEntry& /*Entry*/)> Visitor) const;
+	
+public:
+	/** @brief Edge length of each cell, in unreal units */
+	double CellSize = DEFAULT_INTERACTABLE_INDEX_CELLSIZE;
+	
+	/** @brief Indexed entries, keyed by instance ID */
+	TMap<int32 /*InstanceID*/, FEntry> Entries{};
+	/** @brief Instance IDs bucketed per cell */
+	TMap<FIntVector, TArray<int32 /*InstanceID*/>> Cells{};
+};
+
 /** @brief System Behaviours - Resource Availability */
 UENUM()
 enum class ERTSResourceAvailability : uint8
@@ -8,6 +8,7 @@
 
 #include "GameplayTagContainer.h"
 #include "Subsystems/EngineSubsystem.h"
+#include "Tickable.h"
 #include "PDInteractSubsystem.generated.h"
 
 /** @brief Wrapper to allow nesting container in a map, sadly TMap<int32,TArray<>> is not viable */
@@ -19,23 +20,107 @@ struct FPDArrayListWrapper
 	/** @brief Wrapper of interactable data that we want to save to file */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	TMap<int32 /*InstanceID*/, FRTSSavedInteractable> ActorInfo{};
+
+	/** @brief Spatial index of the registered interactables, keyed by the same instance IDs as 'ActorInfo'
+	 * @note Runtime only, is rebuilt as interactables register themselves */
+	FPDInteractableSpatialIndex SpatialIndex{};
+};
+
+/** @brief Callback for batched radial queries, gets passed the interactables that were found */
+DECLARE_DELEGATE_OneParam(FPDOnRadialQueryResolved, const TArray<AActor*>& /*Interactables*/);
+
+/** @brief A deferred radial query. Queued with 'UPDInteractSubsystem::RequestRadialQuery' and resolved in a single batch at the end of the frame */
+struct FPDInteractRadialQuery
+{
+	/** @brief Query origin */
+	FVector Origin = FVector::ZeroVector;
+	/** @brief Query radius */
+	double Radius = DEFAULT_TRACER_MAX_RADIAL_DISTANCE;
+	/** @brief Filter out interactables that are further away than their own max interaction distance */
+	bool bRespectPerObjectInteractionDistance = false;
+	/** @brief Actor to exclude from the results, usually the querying pawn */
+	TWeakObjectPtr<const AActor> IgnoredActor = nullptr;
+	/** @brief Filter out interactables without a primitive of this object type, 'ObjectTypeQuery_MAX' does not filter */
+	TEnumAsByte<EObjectTypeQuery> ObjectTypeFilter = EObjectTypeQuery::ObjectTypeQuery_MAX;
+	/** @brief Called with the results when the batch has been resolved */
+	FPDOnRadialQueryResolved OnResolved{};
+};
+
+/** @brief Callback for queued interactions, gets passed the result the targets handler reported */
+DECLARE_DELEGATE_OneParam(FPDOnInteractionResolved, EPDInteractResult /*InteractResult*/);
+
+/** @brief A deferred interaction. Queued with 'UPDInteractSubsystem::RequestInteraction' and dispatched, grouped per handler, at the end of the frame
+ * @note Exactly one of 'TargetActor' or 'TargetEntity' is expected to be set */
+struct FPDInteractionRequest
+{
+	/** @brief Interaction target: Actor implementing IPDInteractInterface */
+	TWeakObjectPtr<AActor> TargetActor = nullptr;
+	/** @brief Interaction target: Mass entity */
+	FMassEntityHandle TargetEntity{};
+	/** @brief The parameters that would otherwise have been passed to OnInteract */
+	FPDInteractionParamsWithCustomHandling Params{};
+	/** @brief Called with the interaction result once the request has been dispatched, or with INTERACT_FAIL if it got dropped */
+	FPDOnInteractionResolved OnResolved{};
 };
 
-/** @brief Interaction subsystem, tracks all the interactables in the world for fast querying */
+/** @brief Native interaction handler, gets passed every request aimed at the type it was registered for, once per frame
+ * @note 'OutResults' matches 'Requests' index for index and comes in set to INTERACT_UNHANDLED, the handler writes the result of each request it processed */
+DECLARE_DELEGATE_ThreeParams(FPDOnInteractionBatch, const UWorld* /*World*/, TConstArrayView<FPDInteractionRequest> /*Requests*/, TArrayView<EPDInteractResult> /*OutResults*/);
+
+/** @brief A native entity interaction handler and the fragment or tag type it was registered for */
+struct FPDEntityInteractionHandler
+{
+	/** @brief Fragment or tag type the target archetype needs to contain */
+	const UScriptStruct* FragmentOrTagType = nullptr;
+	/** @brief Archetypes matching several handlers go to the one with the highest priority, ties go to the earliest registered */
+	int32 Priority = 0;
+	/** @brief The handler itself */
+	FPDOnInteractionBatch Handler{};
+};
+
+/** @brief Native interaction handlers registered for a single world */
+struct FPDWorldInteractionHandlers
+{
+	/** @brief Keyed by the interactable class they were registered for */
+	TMap<const UClass*, FPDOnInteractionBatch> ActorHandlers{};
+	/** @brief Kept sorted by descending priority, so the first match is always the one selected */
+	TArray<FPDEntityInteractionHandler> EntityHandlers{};
+};
+
+/** @brief Interaction subsystem, tracks all the interactables in the world for fast querying
+ * - Keeps a spatial index per world so radius and closest-interactable queries never need to touch the physics scene
+ * - Batches radial queries that are requested during a frame and resolves them together at the end of said frame
+ * - Batches interaction requests and dispatches them to natively registered handlers, one call per handler per frame */
 UCLASS(BlueprintType, Blueprintable)
-class PDINTERACTION_API UPDInteractSubsystem : public UEngineSubsystem, public IPDWorldManagementInterface
+class PDINTERACTION_API UPDInteractSubsystem 
+	: public UEngineSubsystem
+	, public IPDWorldManagementInterface
+	, public FTickableGameObject
 {
 	GENERATED_BODY()
 public:
 	/** @brief Shorthand to get the subsystem,
 	 * @note as the engine will instantiate these subsystem earlier than anything will reasonably call Get()  */
 	static UPDInteractSubsystem* Get();
+
+	// Tickable Interface
+	virtual bool IsTickableWhenPaused() const final { return false; }
+	virtual bool IsTickableInEditor() const final {return false;}
+	virtual void Tick( float DeltaTime ) final;
+	virtual ETickableTickType GetTickableTickType() const final { return ETickableTickType::Conditional; }
+	virtual bool IsTickable() const final { return PendingRadialQueries.IsEmpty() == false || PendingInteractions.IsEmpty() == false; }
+	virtual bool IsAllowedToTick() const final { return true; }
+	virtual TStatId GetStatId() const final;
 	
 	/** @brief Register an interactable in the world. APDInteractableActor does this by default in the base class */
 	virtual void RegisterWorldInteractable_Implementation(UWorld* SelectedWorld, AActor* SelectedInteractable) override;
 
 	/** @brief Register an interactable in the world. APDInteractableActor does this by default in the base class */
 	virtual void DeregisterWorldInteractable_Implementation(UWorld* SelectedWorld, AActor* SelectedInteractable) override;
+
+	/** @brief Updates the indexed location of an already registered interactable. APDInteractableActor calls this when its root is moved */
+	UFUNCTION(BlueprintCallable)
+	void UpdateWorldInteractableLocation(UWorld* SelectedWorld, AActor* SelectedInteractable);
 	
 	/** @brief Transferring world interactable pointers. @todo replace dummy implementation, will not actually work and will leave garbage pointers */
 	virtual void TransferringWorld(UWorld* OldWorld, UWorld* TargetWorld);
@@ -44,11 +129,46 @@ public:
 	UFUNCTION(BlueprintCallable)
 	const FPDArrayListWrapper& GetAllWorldInteractables(UObject* WorldContextObject);
 
+	/** @brief Gathers all registered interactables within the given radius. Uses the spatial index, does not touch the physics scene */
+	void GetInteractablesInRadius(const UWorld* SelectedWorld, const FVector& Origin, double Radius, bool bRespectPerObjectInteractionDistance, TArray<AActor*>& OutInteractables, const AActor* IgnoredActor = nullptr, EObjectTypeQuery ObjectTypeFilter = EObjectTypeQuery::ObjectTypeQuery_MAX) const;
+	/** @brief Returns the closest registered interactable within the given radius, nullptr if none was found. Uses the spatial index, does not touch the physics scene */
+	AActor* FindClosestInteractable(const UWorld* SelectedWorld, const FVector& Origin, double Radius, bool bRespectPerObjectInteractionDistance, const AActor* IgnoredActor = nullptr, EObjectTypeQuery ObjectTypeFilter = EObjectTypeQuery::ObjectTypeQuery_MAX) const;
+
+	/** @brief Queues a radial query, it is resolved alongside every other query raised this frame and the results are passed to 'Query.OnResolved' */
+	void RequestRadialQuery(const UWorld* SelectedWorld, FPDInteractRadialQuery&& Query);
+	/** @brief Resolves all queued radial queries in one batch. Is called from Tick */
+	void ResolveRadialQueries();
+
+	/** @brief Registers a native handler for all interactions in the given world targeting actors of the given class, or of any subclass without a handler of its own */
+	void RegisterActorInteractionHandler(const UWorld* SelectedWorld, const UClass* InteractableClass, FPDOnInteractionBatch&& Handler);
+	/** @brief Removes the native handler of the given actor class in the given world */
+	void DeregisterActorInteractionHandler(const UWorld* SelectedWorld, const UClass* InteractableClass);
+	/** @brief Registers a native handler for all interactions in the given world targeting entities which have the given fragment or tag type
+	 * @note If an archetype matches several handlers, the one with the highest 'Priority' is selected */
+	void RegisterEntityInteractionHandler(const UWorld* SelectedWorld, const UScriptStruct* FragmentOrTagType, FPDOnInteractionBatch&& Handler, int32 Priority = 0);
+	/** @brief Removes the native handler of the given fragment or tag type in the given world */
+	void DeregisterEntityInteractionHandler(const UWorld* SelectedWorld, const UScriptStruct* FragmentOrTagType);
+
+	/** @brief Queues an interaction, it is dispatched to its targets handler alongside every other interaction raised this frame */
+	void RequestInteraction(const UWorld* SelectedWorld, FPDInteractionRequest&& Request);
+	/** @brief Dispatches all queued interactions, grouped per handler. Is called from Tick
+	 * @note Actors without a registered handler fall back to OnInteract, which is called natively unless the class implements it in blueprint */
+	void ResolveInteractions();
+
 public:	
 	/** @brief The Map of tracked world interactables, keyed by the actual world pointer */
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Interaction Subsystem")
 	TMap<UWorld* /*SelectedWorld*/, FPDArrayListWrapper /*SelectedInteractables*/> WorldInteractables{};
 
+	/** @brief Radial queries raised this frame, per world */
+	TMap<const UWorld*, TArray<FPDInteractRadialQuery>> PendingRadialQueries{};
+
+	/** @brief Interactions raised this frame, per world */
+	TMap<const UWorld*, TArray<FPDInteractionRequest>> PendingInteractions{};
+
+	/** @brief Native interaction handlers, per world */
+	TMap<const UWorld*, FPDWorldInteractionHandlers> InteractionHandlers{};
+
 	/** @brief Dummy wrapper which is returned from 'GetAllWorldInteractables' when it fails to finds a valid info container */
 	inline static const FPDArrayListWrapper DummyWrapper{};
 };
@@ -1,6 +1,7 @@
 ﻿/* @author: Ario Amin @ Permafrost Development. @copyright: Full BSL(1.1) License included at bottom of the file  */
 
 #include "Actors/PDInteractActor.h"
+#include "PDInteractSubsystem.h"
 
 #include "Components/BoxComponent.h"
 #include "Components/StaticMeshComponent.h"
@@ -46,6 +47,12 @@ void APDInteractActor::BeginPlay()
 	IPDInteractInterface::Execute_RefetchInteractionSettings(this, InteractionSettingsHandle);
 	
 	check(bHasBeenRegisteredWithCurrentWorld)
+
+	// Static interactables never move, no need to keep the spatial index updated for them
+	if (Scenecomp != nullptr && Scenecomp->Mobility != EComponentMobility::Static)
+	{
+		Scenecomp->TransformUpdated.AddUObject(this, &APDInteractActor::OnRootTransformUpdated);
+	}
 }
 
 void APDInteractActor::BeginDestroy()
@@ -54,6 +61,11 @@ void APDInteractActor::BeginDestroy()
 	IPDInteractInterface::Execute_DeregisterWorldInteractable(this, GetWorld(), this);
 }
 
+void APDInteractActor::OnRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	UPDInteractSubsystem::Get()->UpdateWorldInteractableLocation(GetWorld(), this);
+}
+
 void APDInteractActor::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
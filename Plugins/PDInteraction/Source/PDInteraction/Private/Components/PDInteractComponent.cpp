@@ -2,6 +2,8 @@
 
 #include "Components/PDInteractComponent.h"
 #include "PDInteractCommon.h"
+#include "PDInteractSubsystem.h"
+#include "PDInteractTraceScheduler.h"
 #include "Interfaces/PDInteractInterface.h"
 
 #include <CollisionQueryParams.h>
@@ -11,6 +13,7 @@
 #include "Camera/CameraComponent.h"
 
 #include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerController.h"
 
 FPDTraceResult DummyTrace;
 
@@ -27,6 +30,14 @@ void UPDInteractComponent::BeginPlay()
 	Prerequisites();
 }
 
+void UPDInteractComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UPDInteractTraceScheduler* TraceScheduler = UPDInteractTraceScheduler::Get(this);
+	if (TraceScheduler != nullptr) { TraceScheduler->DeregisterComponent(this); }
+	
+	Super::EndPlay(EndPlayReason);
+}
+
 void UPDInteractComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
@@ -65,29 +76,76 @@ void UPDInteractComponent::TickComponent(float DeltaTime, enum ELevelTick TickTy
 	}
 }
 
-void UPDInteractComponent::FindClosestRadialTraceActor(const FVector& OwnerActorLocation, const AActor*& ClosestInteractable)
+void UPDInteractComponent::ExecuteScheduledTrace(const int32 TraceIdx, const double ElapsedSeconds)
 {
-	for (const AActor* TraceActor : TraceBuffer[CurrentTraceIndex].RadialTraceActors)
+	if (TraceSettings.TickTraceTypeSettings.IsValidIndex(TraceIdx) == false) { return; }
+	
+	// Dispatched through the native events so blueprint overrides still run
+	CurrentTraceIndex = TraceIdx;
+	const FPDTraceTickSettings& Setting = TraceSettings.TickTraceTypeSettings[TraceIdx];
+	switch(Setting.TickTraceType)
 	{
-		if (TraceActor == nullptr)
-		{
-			continue;
-		}
+	case EPDTickTraceType::TRACE_RADIAL:
+		PerformRadialTrace(ElapsedSeconds, Setting);
+		break;
+	case EPDTickTraceType::TRACE_LINESHAPE:
+		PerformLineShapeTrace(ElapsedSeconds, Setting);
+		break;
+	case EPDTickTraceType::TRACE_MAX:
+	default: ;
+		PerformLineShapeTrace(ElapsedSeconds, Setting);
+		PerformRadialTrace(ElapsedSeconds, Setting);
+		break;
+	}
+}
 
-		if (ClosestInteractable == nullptr)
-		{
-			ClosestInteractable = TraceActor;
-			continue;
-		}
-		const double AbsoluteDistanceToNewActor = (TraceActor->GetActorLocation() - OwnerActorLocation).Length(); 
-		const double AbsoluteDistanceToCurrentClosest = (ClosestInteractable->GetActorLocation() - OwnerActorLocation).Length();
-				
-		if (AbsoluteDistanceToNewActor >= AbsoluteDistanceToCurrentClosest) { continue; }
+bool UPDInteractComponent::CanRunScheduledTrace(const int32 TraceIdx) const
+{
+	const APawn* OwnerPawn = GetOwner<APawn>();
+	if (OwnerPawn == nullptr || OwnerPawn->IsLocallyControlled() == false) { return false; }
+	if (TraceBuffer.IsValidIndex(TraceIdx) == false) { return false; }
+	
+	return AsyncTracesInFlight.IsValidIndex(TraceIdx) == false || AsyncTracesInFlight[TraceIdx] == false;
+}
+
+int32 UPDInteractComponent::GetScheduledTraceCost(const int32 TraceIdx) const
+{
+	if (TraceSettings.TickTraceTypeSettings.IsValidIndex(TraceIdx) == false) { return 1; }
 
-		ClosestInteractable = TraceActor; 
+	const FPDTraceTickSettings& Setting = TraceSettings.TickTraceTypeSettings[TraceIdx];
+	const bool bIsLandscapeTrace = TEXT("LandscapeTrace") == Setting.TraceNameID.ToString();
+	const int32 LineShapeCost = bIsLandscapeTrace ? 1 : 2;
+	switch(Setting.TickTraceType)
+	{
+	case EPDTickTraceType::TRACE_RADIAL:
+		return 1;
+	case EPDTickTraceType::TRACE_LINESHAPE:
+		return LineShapeCost;
+	case EPDTickTraceType::TRACE_MAX:
+	default:
+		return LineShapeCost + 1;
 	}
 }
 
+bool UPDInteractComponent::IsCameraOwner() const
+{
+	const APawn* OwnerPawn = GetOwner<APawn>();
+	const APlayerController* PC = OwnerPawn != nullptr ? Cast<APlayerController>(OwnerPawn->GetController()) : nullptr;
+	return PC != nullptr && PC->IsLocalController() && PC->GetViewTarget() == OwnerPawn;
+}
+
+void UPDInteractComponent::FindClosestRadialTraceActor(const FVector& OwnerActorLocation, const AActor*& ClosestInteractable)
+{
+	// Resolved against the subsystems spatial index rather than scanning the buffered actors
+	const double Radius = GetMaxTraceDistanceByIdx(CurrentTraceIndex);
+	const AActor* ClosestIndexed = UPDInteractSubsystem::Get()->FindClosestInteractable(GetWorld(), OwnerActorLocation, Radius, true, GetOwner(), GetObjectTypeByIdx(CurrentTraceIndex));
+	if (ClosestIndexed == nullptr) { return; }
+
+	const bool bIsCloserThanCurrent = ClosestInteractable == nullptr
+		|| FVector::DistSquared(ClosestIndexed->GetActorLocation(), OwnerActorLocation) < FVector::DistSquared(ClosestInteractable->GetActorLocation(), OwnerActorLocation);
+	ClosestInteractable = bIsCloserThanCurrent ? ClosestIndexed : ClosestInteractable;
+}
+
 void UPDInteractComponent::BeginInteraction(FName TraceID)
 {
 	const bool bTraceIdxExists = TraceNameToIndexMappings.Contains(TraceID);
@@ -277,44 +335,24 @@ TArray<AActor*> UPDInteractComponent::GetAllInteractablesInRadius(double Radius,
 	APawn* OwnerPawn = GetOwner<APawn>();
 	if (OwnerPawn == nullptr) { return Aggregate; }
 
-	TArray<AActor*> OverlapActors{};
-	UKismetSystemLibrary::SphereOverlapActors(
-		OwnerPawn,
-		OverridePosition == PD::Interact::Constants::INVALID_WORLD_LOC ? OwnerPawn->GetActorLocation() : OverridePosition,
+	UPDInteractSubsystem::Get()->GetInteractablesInRadius(
+		GetWorld(),
+		GetRadialQueryOrigin(),
 		Radius,
-		{TraceSettings.TickTraceTypeSettings[CurrentTraceIndex].GeneratedObjectType},
-		nullptr, 
-		{OwnerPawn},
-		Aggregate);
-	OverridePosition = bResetOverrideNextFrame ? PD::Interact::Constants::INVALID_WORLD_LOC : OverridePosition;
-	
-	if (bIgnorePerObjectInteractionDistance)
-	{
-		for (AActor* OverlappingActor : OverlapActors)
-		{
-			const IPDInteractInterface* ActorAsInterface = Cast<IPDInteractInterface>(OverlappingActor);
-			if (ActorAsInterface == nullptr) { continue; }
-			Aggregate.Emplace(OverlappingActor);
-		}
-	}
-	else
-	{
-		for (AActor* OverlappingActor : OverlapActors)
-		{
-			const IPDInteractInterface* ActorAsInterface = Cast<IPDInteractInterface>(OverlappingActor);
-			if (ActorAsInterface == nullptr) { continue; }
-
-			FVector DistanceVector = OverlappingActor->GetActorLocation() - OwnerPawn->GetActorLocation();
-			const bool bPastInteractionDistance = DistanceVector.Length() > ActorAsInterface->GetMaxInteractionDistance();
-
-			if (bPastInteractionDistance) { continue; }
-			Aggregate.Emplace(OverlappingActor);
-		}		
-	}
-	
+		bIgnorePerObjectInteractionDistance == false,
+		Aggregate,
+		OwnerPawn,
+		GetObjectTypeByIdx(CurrentTraceIndex));
 	return Aggregate;
 }
 
+FVector UPDInteractComponent::GetRadialQueryOrigin()
+{
+	const FVector QueryOrigin = OverridePosition == PD::Interact::Constants::INVALID_WORLD_LOC ? GetOwner()->GetActorLocation() : OverridePosition;
+	OverridePosition = bResetOverrideNextFrame ? PD::Interact::Constants::INVALID_WORLD_LOC : OverridePosition;
+	return QueryOrigin;
+}
+
 void UPDInteractComponent::TraceToTarget(const FVector& TraceEnd)
 {
 	FCollisionQueryParams TraceParams;
@@ -406,9 +444,11 @@ void UPDInteractComponent::Prerequisites()
 	{ 
 		PerTraceBuffer.Setup(); 
 	}
-		
+	AsyncTracesInFlight.Init(false, TraceLim);
 
-	SetComponentTickEnabled(true);
+	// The worlds trace scheduler budgets traces across all interact components and dispatches ours when they are due
+	UPDInteractTraceScheduler* TraceScheduler = UPDInteractTraceScheduler::Get(this);
+	if (TraceScheduler != nullptr) { TraceScheduler->RegisterComponent(this); }
 }
 
 void UPDInteractComponent::ClearCurrentTraceResult()
@@ -433,27 +473,11 @@ void UPDInteractComponent::PerformLineShapeTrace_Implementation(double DeltaSeco
 	TraceBuffer[CurrentTraceIndex].LineTraceTickTime += DeltaSeconds;
 	const bool bCanTick = TraceBuffer[CurrentTraceIndex].LineTraceTickTime >= PerTickTraceSettings.TickInterval && GetOwner<APawn>() != nullptr;
 	if (bCanTick == false) { return; }
+	if (AsyncTracesInFlight.IsValidIndex(CurrentTraceIndex) && AsyncTracesInFlight[CurrentTraceIndex]) { return; }
 
-	FVector TraceStart, TraceEnd;
-	FCollisionQueryParams TraceParams;
-	FHitResult InteractHitResult;
-	
-	// UE_LOG(LogTemp, Warning, TEXT("UPDInteractComponent::PerformLineShapeTrace"))
-	if (TEXT("LandscapeTrace") == PerTickTraceSettings.TraceNameID.ToString())
-	{
-		// bLogTrace = true;
-		// UE_LOG(LogTemp, Warning, TEXT("UPDInteractComponent::PerformLineShapeTrace -- Performing Landscape Trace"))
-		EPDTraceResult TraceResult;
-		PerformCameraTrace(TraceStart, TraceEnd, PerTickTraceSettings, TraceParams, InteractHitResult, TraceResult);
-		TraceBuffer[CurrentTraceIndex].AddTraceFrame(TraceResult, InteractHitResult, PerTickTraceSettings.TickTraceType);
-	}
-	else
-	{
-		// bLogTrace = false;
-		EPDTraceResult TraceResult;
-		PerformComparativeTraces(TraceStart, TraceEnd, PerTickTraceSettings, TraceParams, InteractHitResult, TraceResult);
-		TraceBuffer[CurrentTraceIndex].AddTraceFrame(TraceResult, InteractHitResult, PerTickTraceSettings.TickTraceType);
-	}
+	// Clear accumulated time and dispatch the sweep(s) async, the result is written to the trace buffer when they complete
+	TraceBuffer[CurrentTraceIndex].LineTraceTickTime = 0;
+	DispatchAsyncLineShapeTrace(CurrentTraceIndex, PerTickTraceSettings);
 }
 
 void UPDInteractComponent::PerformRadialTrace_Implementation(double DeltaSeconds, const FPDTraceTickSettings& PerTickTraceSettings)
@@ -462,9 +486,26 @@ void UPDInteractComponent::PerformRadialTrace_Implementation(double DeltaSeconds
 	const bool bCanTick = TraceBuffer[CurrentTraceIndex].RadialTraceTickTime >= PerTickTraceSettings.TickInterval;
 	if (bCanTick == false) { return; }
 
-	// Clear accumulated time and Store any interactables
+	// Clear accumulated time and queue the query, the subsystem resolves every radial query raised this frame in one batch
 	TraceBuffer[CurrentTraceIndex].RadialTraceTickTime = 0;
-	TraceBuffer[CurrentTraceIndex].RadialTraceActors = GetAllInteractablesInRadius(PerTickTraceSettings.MaxTraceDistanceInUnrealUnits);
+	QueueRadialQuery(CurrentTraceIndex, PerTickTraceSettings);
+}
+
+void UPDInteractComponent::QueueRadialQuery(const int32 TraceIdx, const FPDTraceTickSettings& PerTickTraceSettings)
+{
+	FPDInteractRadialQuery Query;
+	Query.Origin = GetRadialQueryOrigin();
+	Query.Radius = PerTickTraceSettings.MaxTraceDistanceInUnrealUnits;
+	Query.bRespectPerObjectInteractionDistance = true;
+	Query.IgnoredActor = GetOwner();
+	Query.ObjectTypeFilter = PerTickTraceSettings.GeneratedObjectType;
+	Query.OnResolved.BindWeakLambda(this,
+		[this, TraceIdx](const TArray<AActor*>& Interactables)
+		{
+			if (TraceBuffer.IsValidIndex(TraceIdx) == false) { return; }
+			TraceBuffer[TraceIdx].RadialTraceActors = Interactables;
+		});
+	UPDInteractSubsystem::Get()->RequestRadialQuery(GetWorld(), MoveTemp(Query));
 }
 void UPDInteractComponent::PerformCameraTrace(FVector& TraceStart, FVector& TraceEnd, const FPDTraceTickSettings& PerTickTraceSettings, FCollisionQueryParams& TraceParams, FHitResult& TraceHitResult, EPDTraceResult& TraceResultFlag) const
 {
@@ -536,6 +577,14 @@ void UPDInteractComponent::PerformSimpleTrace(const FVector& TraceStart, const F
 }
 
 void UPDInteractComponent::TracePass(const FVector& TraceFromLocation, const FVector& TraceEnd,  ECollisionChannel TraceChannel, FCollisionQueryParams& TraceParams, FHitResult& InteractHitResult, bool& bTraceResultFlag) const
+{
+	MakeTraceParams(TraceParams);
+	
+	InteractHitResult = FHitResult(ForceInit);
+	bTraceResultFlag = GetWorld()->SweepSingleByChannel(InteractHitResult, TraceFromLocation, TraceEnd, FQuat::Identity, TraceChannel, FCollisionShape::MakeBox(FVector(BoxTraceExtent)), TraceParams);
+}
+
+void UPDInteractComponent::MakeTraceParams(FCollisionQueryParams& TraceParams) const
 {
 	const APawn* OwnerPawn = GetOwner<APawn>();
 
@@ -545,9 +594,90 @@ void UPDInteractComponent::TracePass(const FVector& TraceFromLocation, const FVe
 	{
 		TraceParams.AddIgnoredActor(ActorToIgnore);
 	}
-	
-	InteractHitResult = FHitResult(ForceInit);
-	bTraceResultFlag = GetWorld()->SweepSingleByChannel(InteractHitResult, TraceFromLocation, TraceEnd, FQuat::Identity, TraceChannel, FCollisionShape::MakeBox(FVector(BoxTraceExtent)), TraceParams);
+}
+
+void UPDInteractComponent::DispatchAsyncLineShapeTrace(const int32 TraceIdx, const FPDTraceTickSettings& PerTickTraceSettings)
+{
+	if (Camera == nullptr || GetOwner<APawn>() == nullptr)
+	{
+		TraceBuffer[TraceIdx].AddTraceFrame(EPDTraceResult::TRACE_FAIL, FHitResult(), PerTickTraceSettings.TickTraceType);
+		return;
+	}
+
+	FMinimalViewInfo ViewInfo;
+	Camera->GetCameraView(0.0, ViewInfo);
+	const FVector TraceStart = ViewInfo.Location;
+	const FVector TraceEnd = TraceStart + (GetMaxTraceDistanceByIdx(TraceIdx) * ViewInfo.Rotation.Vector());
+
+	FCollisionQueryParams TraceParams;
+	MakeTraceParams(TraceParams);
+
+	FTraceDelegate OnTraceDone;
+	OnTraceDone.BindUObject(this, &UPDInteractComponent::OnAsyncCameraTraceDone, TraceIdx);
+
+	AsyncTracesInFlight[TraceIdx] = true;
+	GetWorld()->AsyncSweepByChannel(
+		EAsyncTraceType::Single, TraceStart, TraceEnd, FQuat::Identity, PerTickTraceSettings.TraceChannel,
+		FCollisionShape::MakeBox(FVector(BoxTraceExtent)), TraceParams, FCollisionResponseParams::DefaultResponseParam, &OnTraceDone);
+}
+
+void UPDInteractComponent::OnAsyncCameraTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum, int32 TraceIdx)
+{
+	// Every exit goes through 'CompleteAsyncTrace' so the in-flight bit is always cleared, even if the settings changed while the trace was in flight
+	if (TraceSettings.TickTraceTypeSettings.IsValidIndex(TraceIdx) == false)
+	{
+		CompleteAsyncTrace(TraceIdx, EPDTraceResult::TRACE_FAIL, FHitResult());
+		return;
+	}
+	const FPDTraceTickSettings& PerTickTraceSettings = TraceSettings.TickTraceTypeSettings[TraceIdx];
+
+	const bool bTraceResult = TraceDatum.OutHits.IsEmpty() == false && TraceDatum.OutHits[0].bBlockingHit;
+	const FHitResult LeadingHitResult = bTraceResult ? TraceDatum.OutHits[0] : FHitResult();
+	if (TEXT("LandscapeTrace") == PerTickTraceSettings.TraceNameID.ToString())
+	{
+		CompleteAsyncTrace(TraceIdx, bTraceResult ? EPDTraceResult::TRACE_SUCCESS : EPDTraceResult::TRACE_FAIL, LeadingHitResult);
+		return;
+	}
+
+	// Comparison trace, from the owners eye location towards the location the leading trace hit
+	const APawn* OwnerPawn = GetOwner<APawn>();
+	if (bTraceResult == false || OwnerPawn == nullptr || LeadingHitResult.GetActor() == nullptr)
+	{
+		CompleteAsyncTrace(TraceIdx, bTraceResult ? EPDTraceResult::TRACE_SUCCESS : EPDTraceResult::TRACE_FAIL, FHitResult());
+		return;
+	}
+
+	const FVector PawnEyeLocation = OwnerPawn->GetActorLocation() + FVector(0.f,0.f, OwnerPawn->BaseEyeHeight);
+	const FVector TargetEndLocation = 
+		LeadingHitResult.ImpactPoint != PD::Interact::Constants::INVALID_WORLD_LOC ? LeadingHitResult.ImpactPoint :
+		LeadingHitResult.Location;
+
+	FCollisionQueryParams TraceParams;
+	MakeTraceParams(TraceParams);
+
+	FTraceDelegate OnTraceDone;
+	OnTraceDone.BindUObject(this, &UPDInteractComponent::OnAsyncComparativeTraceDone, TraceIdx, TWeakObjectPtr<AActor>(LeadingHitResult.GetActor()));
+	GetWorld()->AsyncSweepByChannel(
+		EAsyncTraceType::Single, PawnEyeLocation, TargetEndLocation, FQuat::Identity, PerTickTraceSettings.TraceChannel,
+		FCollisionShape::MakeBox(FVector(BoxTraceExtent)), TraceParams, FCollisionResponseParams::DefaultResponseParam, &OnTraceDone);
+}
+
+void UPDInteractComponent::OnAsyncComparativeTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum, int32 TraceIdx, TWeakObjectPtr<AActor> LeadingActor)
+{
+	const bool bComparativeTraces = TraceDatum.OutHits.IsEmpty() == false && TraceDatum.OutHits[0].bBlockingHit;
+	const FHitResult ComparativeHitResult = bComparativeTraces ? TraceDatum.OutHits[0] : FHitResult();
+
+	// The leading trace succeeded to get here, clear hit-results if comparison checks or validity checks fail
+	const bool bInteractTracesValid = bComparativeTraces && LeadingActor.IsValid() && ComparativeHitResult.GetActor() == LeadingActor.Get();
+	CompleteAsyncTrace(TraceIdx, EPDTraceResult::TRACE_SUCCESS, bInteractTracesValid ? ComparativeHitResult : FHitResult());
+}
+
+void UPDInteractComponent::CompleteAsyncTrace(const int32 TraceIdx, const EPDTraceResult TraceResult, const FHitResult& HitResult)
+{
+	if (AsyncTracesInFlight.IsValidIndex(TraceIdx)) { AsyncTracesInFlight[TraceIdx] = false; }
+	if (TraceBuffer.IsValidIndex(TraceIdx) == false || TraceSettings.TickTraceTypeSettings.IsValidIndex(TraceIdx) == false) { return; }
+
+	TraceBuffer[TraceIdx].AddTraceFrame(TraceResult, HitResult, TraceSettings.TickTraceTypeSettings[TraceIdx].TickTraceType);
 }
 
 
@@ -2,6 +2,7 @@
 
 #include "PDInteractCommon.h"
 #include "MassEntityTypes.h"
+#include "Components/PrimitiveComponent.h"
 
 FString FPDKeyCombination::ConvertToString()
 {
@@ -69,6 +70,155 @@ void FPDTraceBuffer::AddTraceFrame(EPDTraceResult TraceResult, const FHitResult&
 }
 
 
+//
+// Spatial index
+void FPDInteractableSpatialIndex::Add(int32 InstanceID, AActor* Interactable, const FVector& Location, double MaxInteractionDistance)
+{
+	Remove(InstanceID);
+
+	FEntry& Entry = Entries.Emplace(InstanceID);
+	Entry.Actor = Interactable;
+	Entry.Location = Location;
+	Entry.Cell = GetCell(Location);
+	Entry.MaxInteractionDistance = MaxInteractionDistance;
+	Entry.ObjectTypeBits = GatherObjectTypeBits(Interactable);
+
+	Cells.FindOrAdd(Entry.Cell).Emplace(InstanceID);
+}
+
+uint32 FPDInteractableSpatialIndex::GatherObjectTypeBits(const AActor* Interactable)
+{
+	uint32 ObjectTypeBits = 0;
+	if (Interactable == nullptr) { return ObjectTypeBits; }
+
+	Interactable->ForEachComponent<UPrimitiveComponent>(false,
+		[&ObjectTypeBits](const UPrimitiveComponent* Primitive)
+		{
+			const ECollisionChannel ObjectType = Primitive->GetCollisionObjectType();
+			if (Primitive->IsQueryCollisionEnabled() == false || ObjectType >= 32) { return; }
+			
+			ObjectTypeBits |= 1u << ObjectType;
+		});
+	return ObjectTypeBits;
+}
+
+void FPDInteractableSpatialIndex::Remove(int32 InstanceID)
+{
+	const FEntry* Entry = Entries.Find(InstanceID);
+	if (Entry == nullptr) { return; }
+
+	TArray<int32>* Bucket = Cells.Find(Entry->Cell);
+	if (Bucket != nullptr)
+	{
+		Bucket->RemoveSwap(InstanceID, false);
+		if (Bucket->IsEmpty()) { Cells.Remove(Entry->Cell); }
+	}
+	Entries.Remove(InstanceID);
+}
+
+bool FPDInteractableSpatialIndex::Move(int32 InstanceID, const FVector& NewLocation)
+{
+	FEntry* Entry = Entries.Find(InstanceID);
+	if (Entry == nullptr) { return false; }
+
+	Entry->Location = NewLocation;
+	const FIntVector NewCell = GetCell(NewLocation);
+	if (NewCell == Entry->Cell) { return true; }
+
+	TArray<int32>* OldBucket = Cells.Find(Entry->Cell);
+	if (OldBucket != nullptr)
+	{
+		OldBucket->RemoveSwap(InstanceID, false);
+		if (OldBucket->IsEmpty()) { Cells.Remove(Entry->Cell); }
+	}
+	Entry->Cell = NewCell;
+	Cells.FindOrAdd(NewCell).Emplace(InstanceID);
+	return true;
+}
+
+void FPDInteractableSpatialIndex::Reset()
+{
+	Entries.Reset();
+	Cells.Reset();
+}
+
+void FPDInteractableSpatialIndex::ForEachCandidate(const FVector& Origin, double Radius, TFunctionRef<void(int32, const FEntry&)> Visitor) const
+{
+	const FIntVector MinCell = GetCell(Origin - FVector(Radius));
+	const FIntVector MaxCell = GetCell(Origin + FVector(Radius));
+	const int64 CoveredCellCount =
+		static_cast<int64>(MaxCell.X - MinCell.X + 1)
+		* static_cast<int64>(MaxCell.Y - MinCell.Y + 1)
+		* static_cast<int64>(MaxCell.Z - MinCell.Z + 1);
+
+	// Cheaper to walk the entries than to probe a large amount of mostly empty cells 
+	if (CoveredCellCount > Cells.Num())
+	{
+		for (const TPair<int32, FEntry>& EntryPair : Entries)
+		{
+			Visitor(EntryPair.Key, EntryPair.Value);
+		}
+		return;
+	}
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+			{
+				const TArray<int32>* Bucket = Cells.Find(FIntVector{X, Y, Z});
+				if (Bucket == nullptr) { continue; }
+
+				for (const int32 InstanceID : *Bucket)
+				{
+					Visitor(InstanceID, Entries.FindChecked(InstanceID));
+				}
+			}
+		}
+	}
+}
+
+void FPDInteractableSpatialIndex::QueryRadius(const FVector& Origin, double Radius, bool bRespectPerObjectInteractionDistance, TArray<int32>& OutInstanceIDs, const AActor* IgnoredActor, EObjectTypeQuery ObjectTypeFilter) const
+{
+	const double RadiusSquared = Radius * Radius;
+	ForEachCandidate(Origin, Radius,
+		[&](int32 InstanceID, const FEntry& Entry)
+		{
+			if (IgnoredActor != nullptr && Entry.Actor.Get() == IgnoredActor) { return; }
+			if (MatchesObjectType(Entry, ObjectTypeFilter) == false) { return; }
+
+			const double DistanceSquared = FVector::DistSquared(Entry.Location, Origin);
+			if (DistanceSquared > RadiusSquared) { return; }
+			if (bRespectPerObjectInteractionDistance && DistanceSquared > FMath::Square(Entry.MaxInteractionDistance)) { return; }
+
+			OutInstanceIDs.Emplace(InstanceID);
+		});
+}
+
+int32 FPDInteractableSpatialIndex::FindClosest(const FVector& Origin, double Radius, bool bRespectPerObjectInteractionDistance, const AActor* IgnoredActor, EObjectTypeQuery ObjectTypeFilter) const
+{
+	int32 ClosestInstanceID = INDEX_NONE;
+	double ClosestDistanceSquared = Radius * Radius;
+	ForEachCandidate(Origin, Radius,
+		[&](int32 InstanceID, const FEntry& Entry)
+		{
+			if (IgnoredActor != nullptr && Entry.Actor.Get() == IgnoredActor) { return; }
+			if (MatchesObjectType(Entry, ObjectTypeFilter) == false) { return; }
+
+			const double DistanceSquared = FVector::DistSquared(Entry.Location, Origin);
+			if (bRespectPerObjectInteractionDistance && DistanceSquared > FMath::Square(Entry.MaxInteractionDistance)) { return; }
+
+			const bool bIsCloser = DistanceSquared < ClosestDistanceSquared
+				|| (DistanceSquared == ClosestDistanceSquared && (ClosestInstanceID == INDEX_NONE || InstanceID < ClosestInstanceID));
+			if (bIsCloser == false) { return; }
+
+			ClosestDistanceSquared = DistanceSquared;
+			ClosestInstanceID = InstanceID;
+		});
+	return ClosestInstanceID;
+}
+
 /**
 Business Source License 1.1
 
@@ -5,6 +5,12 @@
 #include "PDInteractCommon.h"
 #include "Interfaces/PDInteractInterface.h"
 
+#include "Async/ParallelFor.h"
+#include "MassEntitySubsystem.h"
+
+/** @brief Below this many queries in a world the batch is resolved on the game-thread, the task overhead would outweigh the gain */
+constexpr int32 PARALLEL_RADIALQUERY_THRESHOLD = 16;
+
 UPDInteractSubsystem* UPDInteractSubsystem::Get()
 {
 	return GEngine->GetEngineSubsystem<UPDInteractSubsystem>();
@@ -33,8 +39,15 @@ void UPDInteractSubsystem::RegisterWorldInteractable_Implementation(UWorld* Sele
 		SelectedInteractable->GetActorLocation(), // Interact Actor location
 		IPDInteractInterface::Execute_GetCurrentUsability(SelectedInteractable) // Interact Actor usability
 		};
-	
-	WorldInteractables.FindOrAdd(SelectedWorld).ActorInfo.Emplace(AsInterface->GetInstanceID(), Interactable);
+
+	const int32 InstanceID = AsInterface->GetInstanceID();
+	FPDArrayListWrapper& WorldWrapper = WorldInteractables.FindOrAdd(SelectedWorld);
+	WorldWrapper.ActorInfo.Emplace(InstanceID, Interactable);
+	WorldWrapper.SpatialIndex.Add(
+		InstanceID,
+		SelectedInteractable,
+		SelectedInteractable->GetActorLocation(),
+		IPDInteractInterface::Execute_GetMaxInteractionDistance(SelectedInteractable));
 }
 
 void UPDInteractSubsystem::DeregisterWorldInteractable_Implementation(UWorld* SelectedWorld, AActor* SelectedInteractable)
@@ -54,8 +67,27 @@ void UPDInteractSubsystem::DeregisterWorldInteractable_Implementation(UWorld* Se
 	}
 	
 	IPDInteractInterface* AsInterface = Cast<IPDInteractInterface>(SelectedInteractable);	
-	
-	WorldInteractables.FindOrAdd(SelectedWorld).ActorInfo.Remove(AsInterface->GetInstanceID());
+
+	const int32 InstanceID = AsInterface->GetInstanceID();
+	FPDArrayListWrapper& WorldWrapper = WorldInteractables.FindOrAdd(SelectedWorld);
+	WorldWrapper.ActorInfo.Remove(InstanceID);
+	WorldWrapper.SpatialIndex.Remove(InstanceID);
+}
+
+void UPDInteractSubsystem::UpdateWorldInteractableLocation(UWorld* SelectedWorld, AActor* SelectedInteractable)
+{
+	if (SelectedWorld == nullptr || SelectedInteractable == nullptr) { return; }
+
+	IPDInteractInterface* AsInterface = Cast<IPDInteractInterface>(SelectedInteractable);
+	FPDArrayListWrapper* WorldWrapper = WorldInteractables.Find(SelectedWorld);
+	if (AsInterface == nullptr || WorldWrapper == nullptr) { return; }
+
+	const int32 InstanceID = AsInterface->GetInstanceID();
+	const FVector NewLocation = SelectedInteractable->GetActorLocation();
+	if (WorldWrapper->SpatialIndex.Move(InstanceID, NewLocation) == false) { return; }
+
+	FRTSSavedInteractable* SavedInteractable = WorldWrapper->ActorInfo.Find(InstanceID);
+	if (SavedInteractable != nullptr) { SavedInteractable->Location = NewLocation; }
 }
 
 void UPDInteractSubsystem::TransferringWorld(UWorld* OldWorld, UWorld* TargetWorld)
@@ -64,8 +96,21 @@ void UPDInteractSubsystem::TransferringWorld(UWorld* OldWorld, UWorld* TargetWor
 	check(TargetWorld != nullptr)
 
 	// Is there an already existing set of functions that allow transferring between worlds, and not just u-levels?
-	WorldInteractables.FindOrAdd(TargetWorld).ActorInfo = WorldInteractables.Find(OldWorld)->ActorInfo;
+	FPDArrayListWrapper& TargetWrapper = WorldInteractables.FindOrAdd(TargetWorld);
+	const FPDArrayListWrapper& OldWrapper = *WorldInteractables.Find(OldWorld);
+	TargetWrapper.ActorInfo = OldWrapper.ActorInfo;
+	TargetWrapper.SpatialIndex = OldWrapper.SpatialIndex;
 	WorldInteractables.Remove(OldWorld);
+	PendingRadialQueries.Remove(OldWorld);
+	InteractionHandlers.Remove(OldWorld);
+
+	// Dropped interactions still resolve, so whoever is waiting on them does not stall
+	TArray<FPDInteractionRequest> DroppedInteractions;
+	PendingInteractions.RemoveAndCopyValue(OldWorld, DroppedInteractions);
+	for (const FPDInteractionRequest& Request : DroppedInteractions)
+	{
+		Request.OnResolved.ExecuteIfBound(EPDInteractResult::INTERACT_FAIL);
+	}
 }
 
 const FPDArrayListWrapper& UPDInteractSubsystem::GetAllWorldInteractables(UObject* WorldContextObject)
@@ -76,6 +121,277 @@ const FPDArrayListWrapper& UPDInteractSubsystem::GetAllWorldInteractables(UObjec
 	return WorldInteractables.Contains(ContextWorld) ? *WorldInteractables.Find(ContextWorld) : DummyWrapper;
 }
 
+void UPDInteractSubsystem::GetInteractablesInRadius(const UWorld* SelectedWorld, const FVector& Origin, double Radius, bool bRespectPerObjectInteractionDistance, TArray<AActor*>& OutInteractables, const AActor* IgnoredActor, EObjectTypeQuery ObjectTypeFilter) const
+{
+	const FPDArrayListWrapper* WorldWrapper = WorldInteractables.Find(SelectedWorld);
+	if (WorldWrapper == nullptr) { return; }
+
+	TArray<int32> InstanceIDs;
+	WorldWrapper->SpatialIndex.QueryRadius(Origin, Radius, bRespectPerObjectInteractionDistance, InstanceIDs, IgnoredActor, ObjectTypeFilter);
+
+	OutInteractables.Reserve(OutInteractables.Num() + InstanceIDs.Num());
+	for (const int32 InstanceID : InstanceIDs)
+	{
+		AActor* Interactable = WorldWrapper->SpatialIndex.GetActor(InstanceID);
+		if (Interactable == nullptr) { continue; }
+		OutInteractables.Emplace(Interactable);
+	}
+}
+
+AActor* UPDInteractSubsystem::FindClosestInteractable(const UWorld* SelectedWorld, const FVector& Origin, double Radius, bool bRespectPerObjectInteractionDistance, const AActor* IgnoredActor, EObjectTypeQuery ObjectTypeFilter) const
+{
+	const FPDArrayListWrapper* WorldWrapper = WorldInteractables.Find(SelectedWorld);
+	if (WorldWrapper == nullptr) { return nullptr; }
+
+	const int32 ClosestInstanceID = WorldWrapper->SpatialIndex.FindClosest(Origin, Radius, bRespectPerObjectInteractionDistance, IgnoredActor, ObjectTypeFilter);
+	return ClosestInstanceID != INDEX_NONE ? WorldWrapper->SpatialIndex.GetActor(ClosestInstanceID) : nullptr;
+}
+
+void UPDInteractSubsystem::RequestRadialQuery(const UWorld* SelectedWorld, FPDInteractRadialQuery&& Query)
+{
+	if (SelectedWorld == nullptr || Query.OnResolved.IsBound() == false) { return; }
+
+	PendingRadialQueries.FindOrAdd(SelectedWorld).Emplace(MoveTemp(Query));
+}
+
+void UPDInteractSubsystem::ResolveRadialQueries()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_InteractResolveRadialQueries)
+
+	// Swap out the pending queries, callbacks are allowed to queue new queries for the next frame
+	TMap<const UWorld*, TArray<FPDInteractRadialQuery>> QueriesToResolve = MoveTemp(PendingRadialQueries);
+	PendingRadialQueries.Reset();
+
+	for (TPair<const UWorld*, TArray<FPDInteractRadialQuery>>& WorldQueries : QueriesToResolve)
+	{
+		TArray<FPDInteractRadialQuery>& Queries = WorldQueries.Value;
+		const FPDArrayListWrapper* WorldWrapper = WorldInteractables.Find(WorldQueries.Key);
+		if (WorldWrapper == nullptr)
+		{
+			const TArray<AActor*> NoInteractables{};
+			for (const FPDInteractRadialQuery& Query : Queries) { Query.OnResolved.ExecuteIfBound(NoInteractables); }
+			continue;
+		}
+
+		// The index is not modified while resolving, so the queries themselves may run in parallel
+		const FPDInteractableSpatialIndex& SpatialIndex = WorldWrapper->SpatialIndex;
+		TArray<TArray<int32>> ResultsPerQuery;
+		ResultsPerQuery.SetNum(Queries.Num());
+		ParallelFor(Queries.Num(),
+			[&](const int32 QueryIdx)
+			{
+				const FPDInteractRadialQuery& Query = Queries[QueryIdx];
+				SpatialIndex.QueryRadius(Query.Origin, Query.Radius, Query.bRespectPerObjectInteractionDistance, ResultsPerQuery[QueryIdx], Query.IgnoredActor.Get(), Query.ObjectTypeFilter);
+			},
+			Queries.Num() < PARALLEL_RADIALQUERY_THRESHOLD ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+		TArray<AActor*> ResolvedActors;
+		for (int32 QueryIdx = 0; QueryIdx < Queries.Num(); QueryIdx++)
+		{
+			ResolvedActors.Reset();
+			for (const int32 InstanceID : ResultsPerQuery[QueryIdx])
+			{
+				AActor* Interactable = SpatialIndex.GetActor(InstanceID);
+				if (Interactable == nullptr) { continue; }
+				ResolvedActors.Emplace(Interactable);
+			}
+			Queries[QueryIdx].OnResolved.ExecuteIfBound(ResolvedActors);
+		}
+	}
+}
+
+void UPDInteractSubsystem::RegisterActorInteractionHandler(const UWorld* SelectedWorld, const UClass* InteractableClass, FPDOnInteractionBatch&& Handler)
+{
+	if (SelectedWorld == nullptr || InteractableClass == nullptr || Handler.IsBound() == false) { return; }
+
+	InteractionHandlers.FindOrAdd(SelectedWorld).ActorHandlers.Emplace(InteractableClass, MoveTemp(Handler));
+}
+
+void UPDInteractSubsystem::DeregisterActorInteractionHandler(const UWorld* SelectedWorld, const UClass* InteractableClass)
+{
+	FPDWorldInteractionHandlers* WorldHandlers = InteractionHandlers.Find(SelectedWorld);
+	if (WorldHandlers == nullptr) { return; }
+
+	WorldHandlers->ActorHandlers.Remove(InteractableClass);
+	if (WorldHandlers->ActorHandlers.IsEmpty() && WorldHandlers->EntityHandlers.IsEmpty()) { InteractionHandlers.Remove(SelectedWorld); }
+}
+
+void UPDInteractSubsystem::RegisterEntityInteractionHandler(const UWorld* SelectedWorld, const UScriptStruct* FragmentOrTagType, FPDOnInteractionBatch&& Handler, const int32 Priority)
+{
+	if (SelectedWorld == nullptr || FragmentOrTagType == nullptr || Handler.IsBound() == false) { return; }
+
+	TArray<FPDEntityInteractionHandler>& EntityHandlers = InteractionHandlers.FindOrAdd(SelectedWorld).EntityHandlers;
+	EntityHandlers.RemoveAll([FragmentOrTagType](const FPDEntityInteractionHandler& Entry) { return Entry.FragmentOrTagType == FragmentOrTagType; });
+
+	// Insert after every entry of equal or higher priority, keeps the array sorted and ties in registration order
+	int32 InsertIdx = 0;
+	while (InsertIdx < EntityHandlers.Num() && EntityHandlers[InsertIdx].Priority >= Priority) { InsertIdx++; }
+	EntityHandlers.Insert(FPDEntityInteractionHandler{FragmentOrTagType, Priority, MoveTemp(Handler)}, InsertIdx);
+}
+
+void UPDInteractSubsystem::DeregisterEntityInteractionHandler(const UWorld* SelectedWorld, const UScriptStruct* FragmentOrTagType)
+{
+	FPDWorldInteractionHandlers* WorldHandlers = InteractionHandlers.Find(SelectedWorld);
+	if (WorldHandlers == nullptr) { return; }
+
+	WorldHandlers->EntityHandlers.RemoveAll([FragmentOrTagType](const FPDEntityInteractionHandler& Entry) { return Entry.FragmentOrTagType == FragmentOrTagType; });
+	if (WorldHandlers->ActorHandlers.IsEmpty() && WorldHandlers->EntityHandlers.IsEmpty()) { InteractionHandlers.Remove(SelectedWorld); }
+}
+
+void UPDInteractSubsystem::RequestInteraction(const UWorld* SelectedWorld, FPDInteractionRequest&& Request)
+{
+	if (SelectedWorld == nullptr || (Request.TargetActor.IsValid() == false && Request.TargetEntity.IsSet() == false))
+	{
+		Request.OnResolved.ExecuteIfBound(EPDInteractResult::INTERACT_FAIL);
+		return;
+	}
+
+	PendingInteractions.FindOrAdd(SelectedWorld).Emplace(MoveTemp(Request));
+}
+
+void UPDInteractSubsystem::ResolveInteractions()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_InteractResolveInteractions)
+
+	// Swap out the pending interactions, handlers are allowed to queue new interactions for the next frame
+	TMap<const UWorld*, TArray<FPDInteractionRequest>> InteractionsToResolve = MoveTemp(PendingInteractions);
+	PendingInteractions.Reset();
+
+	// Resolved once per class/archetype, not once per request
+	struct FPDResolvedActorClass
+	{
+		const UClass* HandlerKey = nullptr;
+		bool bImplementedInScript = false;
+	};
+	TMap<const UClass*, FPDResolvedActorClass> ResolvedActorClasses;
+	TMap<FMassArchetypeHandle, const UScriptStruct*> ResolvedArchetypes;
+
+	TMap<const UClass*, TArray<FPDInteractionRequest>> ActorBatches;
+	TMap<const UScriptStruct*, TArray<FPDInteractionRequest>> EntityBatches;
+	TArray<EPDInteractResult> BatchResults;
+	for (TPair<const UWorld*, TArray<FPDInteractionRequest>>& WorldInteractions : InteractionsToResolve)
+	{
+		const UWorld* World = WorldInteractions.Key;
+		const UMassEntitySubsystem* EntitySubsystem = World != nullptr ? World->GetSubsystem<UMassEntitySubsystem>() : nullptr;
+		const FPDWorldInteractionHandlers* WorldHandlers = InteractionHandlers.Find(World);
+		ActorBatches.Reset();
+		EntityBatches.Reset();
+		ResolvedActorClasses.Reset();
+		ResolvedArchetypes.Reset();
+
+		for (FPDInteractionRequest& Request : WorldInteractions.Value)
+		{
+			AActor* TargetActor = Request.TargetActor.Get();
+			if (TargetActor != nullptr)
+			{
+				const UClass* TargetClass = TargetActor->GetClass();
+				FPDResolvedActorClass* ResolvedClass = ResolvedActorClasses.Find(TargetClass);
+				if (ResolvedClass == nullptr)
+				{
+					ResolvedClass = &ResolvedActorClasses.Emplace(TargetClass);
+					ResolvedClass->bImplementedInScript = TargetClass->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(IPDInteractInterface, OnInteract));
+					for (const UClass* HandlerClass = TargetClass; WorldHandlers != nullptr && HandlerClass != nullptr; HandlerClass = HandlerClass->GetSuperClass())
+					{
+						if (WorldHandlers->ActorHandlers.Contains(HandlerClass) == false) { continue; }
+						ResolvedClass->HandlerKey = HandlerClass;
+						break;
+					}
+				}
+
+				if (ResolvedClass->HandlerKey != nullptr)
+				{
+					ActorBatches.FindOrAdd(ResolvedClass->HandlerKey).Emplace(MoveTemp(Request));
+					continue;
+				}
+
+				// No native handler, fall back to the interface. Skip the reflection call if no blueprint overrides it
+				EPDInteractResult InteractResult = EPDInteractResult::INTERACT_UNHANDLED;
+				const IPDInteractInterface* AsInterface = Cast<IPDInteractInterface>(TargetActor);
+				if (ResolvedClass->bImplementedInScript)
+				{
+					IPDInteractInterface::Execute_OnInteract(TargetActor, Request.Params, InteractResult);
+				}
+				else if (AsInterface != nullptr)
+				{
+					AsInterface->OnInteract_Implementation(Request.Params, InteractResult);
+				}
+				Request.OnResolved.ExecuteIfBound(InteractResult);
+				continue;
+			}
+
+			const FMassEntityManager* EntityManager = EntitySubsystem != nullptr ? &EntitySubsystem->GetEntityManager() : nullptr;
+			if (EntityManager == nullptr || EntityManager->IsEntityValid(Request.TargetEntity) == false)
+			{
+				Request.OnResolved.ExecuteIfBound(EPDInteractResult::INTERACT_FAIL);
+				continue;
+			}
+
+			const FMassArchetypeHandle Archetype = EntityManager->GetArchetypeForEntity(Request.TargetEntity);
+			const UScriptStruct** HandlerKeyPtr = ResolvedArchetypes.Find(Archetype);
+			if (HandlerKeyPtr == nullptr)
+			{
+				// Handlers are sorted by priority, the first match wins
+				const FMassArchetypeCompositionDescriptor& Composition = EntityManager->GetArchetypeComposition(Archetype);
+				const UScriptStruct* HandlerKey = nullptr;
+				for (int32 HandlerIdx = 0; WorldHandlers != nullptr && HandlerIdx < WorldHandlers->EntityHandlers.Num(); HandlerIdx++)
+				{
+					const UScriptStruct* HandlerType = WorldHandlers->EntityHandlers[HandlerIdx].FragmentOrTagType;
+					if (Composition.Fragments.Contains(*HandlerType) == false && Composition.Tags.Contains(*HandlerType) == false) { continue; }
+					HandlerKey = HandlerType;
+					break;
+				}
+				HandlerKeyPtr = &ResolvedArchetypes.Emplace(Archetype, HandlerKey);
+			}
+
+			if (*HandlerKeyPtr == nullptr)
+			{
+				UE_LOG(PDLog_Interact, Verbose, TEXT("UPDInteractSubsystem::ResolveInteractions -- No handler registered for target entity(%i), dropping interaction"), Request.TargetEntity.Index);
+				Request.OnResolved.ExecuteIfBound(EPDInteractResult::INTERACT_UNHANDLED);
+				continue;
+			}
+			EntityBatches.FindOrAdd(*HandlerKeyPtr).Emplace(MoveTemp(Request));
+		}
+
+		// Copy the delegates before executing, handlers are allowed to (de)register handlers
+		const auto DispatchBatch = [World, &BatchResults](const FPDOnInteractionBatch& Handler, const TArray<FPDInteractionRequest>& Requests)
+		{
+			BatchResults.Init(EPDInteractResult::INTERACT_UNHANDLED, Requests.Num());
+			Handler.ExecuteIfBound(World, Requests, BatchResults);
+			for (int32 RequestIdx = 0; RequestIdx < Requests.Num(); RequestIdx++)
+			{
+				Requests[RequestIdx].OnResolved.ExecuteIfBound(BatchResults[RequestIdx]);
+			}
+		};
+		for (const TPair<const UClass*, TArray<FPDInteractionRequest>>& Batch : ActorBatches)
+		{
+			WorldHandlers = InteractionHandlers.Find(World);
+			const FPDOnInteractionBatch Handler = WorldHandlers != nullptr ? WorldHandlers->ActorHandlers.FindRef(Batch.Key) : FPDOnInteractionBatch{};
+			DispatchBatch(Handler, Batch.Value);
+		}
+		for (const TPair<const UScriptStruct*, TArray<FPDInteractionRequest>>& Batch : EntityBatches)
+		{
+			WorldHandlers = InteractionHandlers.Find(World);
+			const FPDEntityInteractionHandler* Entry = WorldHandlers != nullptr
+				? WorldHandlers->EntityHandlers.FindByPredicate([&Batch](const FPDEntityInteractionHandler& Candidate) { return Candidate.FragmentOrTagType == Batch.Key; })
+				: nullptr;
+			const FPDOnInteractionBatch Handler = Entry != nullptr ? Entry->Handler : FPDOnInteractionBatch{};
+			DispatchBatch(Handler, Batch.Value);
+		}
+	}
+}
+
+// Tickable interface
+void UPDInteractSubsystem::Tick(float DeltaTime)
+{
+	ResolveRadialQueries();
+	ResolveInteractions();
+}
+
+TStatId UPDInteractSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPDInteractSubsystem, STATGROUP_Tickables);
+}
+
 /**
 Business Source License 1.1
 
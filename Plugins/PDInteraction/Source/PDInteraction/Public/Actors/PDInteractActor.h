@@ -20,7 +20,7 @@ class UBoxComponent;
 /**
  * @brief Base interactable actor.
  * Handles default behaviour for an interactable actor out-of-the box.
- * - Registers with the interactable subsystem upon begin-play
+ * - Registers with the interactable subsystem upon begin-play, and keeps its indexed location updated if it is movable
  * - Binds editor delegates
  * - If given: Handles processing custom interaction process function delegates and passes result downstream
  * - Handles building a base-line interaction message filling in necessary data from the actor
@@ -59,6 +59,8 @@ protected:
 	/** @brief Function that resizes the collision bounds based on the property 'UniformCollisionPadding' */
 	UFUNCTION() 
 	void ResizeCollisionBounds(UStaticMeshComponent* NewMeshDummy = nullptr);
+	/** @brief Keeps the interaction subsystems spatial index in sync when a movable interactable is moved */
+	void OnRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
 	/** @brief Binds delegate(s) to Mesh->OnStaticMeshChanged */
 	void BindDelegates();
 
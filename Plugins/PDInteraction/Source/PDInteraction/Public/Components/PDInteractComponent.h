@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "PDInteractCommon.h"
 #include "Components/ActorComponent.h"
+#include "WorldCollision.h"
 #include "PDInteractComponent.generated.h"
 
 class UCameraComponent;
@@ -19,14 +20,28 @@ class PDINTERACTION_API UPDInteractComponent : public UActorComponent
 public:
 	/** @brief Calls Super::BeginPlay() and Prerequisites()*/
 	virtual void BeginPlay() override; 
-	/** @brief Calls trace functions. Which trace functions depends on which trace type has been assigned to 'TraceSettings.TickTraceType'*/
+	/** @brief Deregisters from the worlds 'UPDInteractTraceScheduler' and calls Super::EndPlay() */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	/** @brief Calls trace functions. Which trace functions depends on which trace type has been assigned to 'TraceSettings.TickTraceType'
+	 * @note Tick is disabled by default, the worlds 'UPDInteractTraceScheduler' dispatches our traces */
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
+	/** @brief Called by 'UPDInteractTraceScheduler' when the trace at the given index is due and fits within the frame budget.
+	 * Calls 'PerformRadialTrace' and/or 'PerformLineShapeTrace' with the time since the trace was last dispatched */
+	void ExecuteScheduledTrace(const int32 TraceIdx, const double ElapsedSeconds);
+	/** @brief Can the scheduler dispatch the trace at the given index. False while a previous async trace for the same index is still in flight */
+	bool CanRunScheduledTrace(const int32 TraceIdx) const;
+	/** @brief Budget cost of the trace at the given index. A comparative line-shape trace sweeps twice */
+	int32 GetScheduledTraceCost(const int32 TraceIdx) const;
+	/** @brief Is the owning pawn the view target of a local player controller */
+	bool IsCameraOwner() const;
+
 
 	/** @brief */
 	void SetCamera(UCameraComponent* InCamera) { Camera = InCamera; }; 
 
-	/** @brief Finds the closest interactable of the actors in the radial trace  */
+	/** @brief Finds the closest interactable within the radial trace distance, via the interaction subsystems spatial index.
+	 * @note Filters the same way as the queued radial query, per-object interaction distance and the traces object type */
 	void FindClosestRadialTraceActor(const FVector& OwnerActorLocation, const AActor*& ClosestInteractable);
 
 	/** @brief Registers the start interaction time and sets the interaction timer that accumulates the held time */
@@ -60,9 +75,11 @@ public:
 	UFUNCTION(BlueprintCallable)
 	bool ContainsValidTraceResults(FName TraceID) const;
 
-	/** @brief Returns a list of all interactables within the given radius */
+	/** @brief Returns a list of all interactables within the given radius, of the current traces object type. Queries the interaction subsystems spatial index, not the physics scene */
 	UFUNCTION(BlueprintCallable)
 	TArray<AActor*> GetAllInteractablesInRadius(double Radius = 500.0, bool bIgnorePerObjectInteractionDistance = false);
+	/** @brief Returns the override position if one is set, otherwise the owners location. Resets the override if it was only meant to last one frame */
+	FVector GetRadialQueryOrigin();
 	
 	/** @brief Meant to be used on the server for one-off for comparisons/validations */
 	UFUNCTION(BlueprintCallable)
@@ -100,6 +117,12 @@ public:
 		const bool bTraceIdxExists = TraceSettings.TickTraceTypeSettings.IsValidIndex(TraceIdx);
 		return bTraceIdxExists ? TraceSettings.TickTraceTypeSettings[TraceIdx].MaxTraceDistanceInUnrealUnits : 0.0;
 	}
+	/** @brief Returns the object type radial queries of the trace filter by, 'ObjectTypeQuery_MAX' if the trace does not exist */
+	FORCEINLINE EObjectTypeQuery GetObjectTypeByIdx(const int32 TraceIdx) const
+	{
+		const bool bTraceIdxExists = TraceSettings.TickTraceTypeSettings.IsValidIndex(TraceIdx);
+		return bTraceIdxExists ? TraceSettings.TickTraceTypeSettings[TraceIdx].GeneratedObjectType.GetValue() : EObjectTypeQuery::ObjectTypeQuery_MAX;
+	}
 
 	/** @brief Return the radially traced actor.
 	 * @todo integrate some mass entity tracing into this? Or a subclass of the trace component
@@ -163,11 +186,13 @@ protected:
 	void ClearAllTraceResults();
 	
 
-	/** @brief Performs a shape trace along a line/direction */
+	/** @brief Performs a shape trace along a line/direction.
+	 * Dispatches the leading camera sweep and, for non-landscape traces, the comparative eye sweep async. The result is written to the trace buffer when they complete */
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable)
 	void PerformLineShapeTrace(double DeltaSeconds, const FPDTraceTickSettings& PerTickTraceSettings);
 
-	/** @brief Performs a radial trace, outwards radially from the start position */
+	/** @brief Performs a radial trace, outwards radially from the start position.
+	 * Queues a batched query with 'UPDInteractSubsystem', the results are written to the trace buffer when the batch resolves at the end of the frame */
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable)
 	void PerformRadialTrace(double DeltaSeconds, const FPDTraceTickSettings& PerTickTraceSettings);
 	
@@ -180,6 +205,19 @@ protected:
 	void PerformSimpleTrace(const FVector& TraceStart, const FVector& TraceEnd, ECollisionChannel TraceChannel, FCollisionQueryParams& TraceParams, FHitResult& TraceHitResult, bool& bTraceResultFlag) const;
 	/** @brief Actual Shape trace-pass. Sweeps the shape along the direction  */
 	void TracePass(const FVector& TraceFromLocation, const FVector& TraceEnd, ECollisionChannel TraceChannel, FCollisionQueryParams& TraceParams, FHitResult& TraceHitResult, bool& bTraceResultFlag) const;
+
+	/** @brief Queues a batched radial query with 'UPDInteractSubsystem', the results are written into 'TraceBuffer[TraceIdx]' when it resolves */
+	void QueueRadialQuery(const int32 TraceIdx, const FPDTraceTickSettings& PerTickTraceSettings);
+	/** @brief Sets up the same query params as 'TracePass', for use with the async trace API */
+	void MakeTraceParams(FCollisionQueryParams& TraceParams) const;
+	/** @brief Dispatches the leading camera sweep of a line-shape trace as an async trace */
+	void DispatchAsyncLineShapeTrace(const int32 TraceIdx, const FPDTraceTickSettings& PerTickTraceSettings);
+	/** @brief Async camera sweep finished. Writes the result for landscape traces, otherwise chains the comparative sweep from the owners eye location */
+	void OnAsyncCameraTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum, int32 TraceIdx);
+	/** @brief Async comparative sweep finished. Writes the result into 'TraceBuffer[TraceIdx]', cleared if it did not hit the same actor as the leading trace */
+	void OnAsyncComparativeTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum, int32 TraceIdx, TWeakObjectPtr<AActor> LeadingActor);
+	/** @brief Writes a finished async trace into the trace buffer and clears the in-flight flag */
+	void CompleteAsyncTrace(const int32 TraceIdx, const EPDTraceResult TraceResult, const FHitResult& HitResult);
 	
 public:
 	/** @brief Shape extent for shape trace */
@@ -223,6 +261,8 @@ protected:
 
 private:
 	int32 CurrentTraceIndex = 0;
+	/** @brief One bit per trace index, set while an async trace for that index is in flight */
+	TBitArray<> AsyncTracesInFlight{};
 	TMap<FName, int32> TraceNameToIndexMappings{};
 
 	UPROPERTY()
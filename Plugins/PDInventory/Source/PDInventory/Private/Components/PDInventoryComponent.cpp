@@ -61,31 +61,30 @@ void UPDInventoryComponent::RequestTradeItems(
 	if (Caller == nullptr || Caller->IsValidLowLevelFast() == false) { return; }
 
 	// Offer from caller to called
-	for (const TPair<FGameplayTag, int32> Item : OfferedItems)
+	for (const TPair<FGameplayTag, int32>& Item : OfferedItems)
 	{
-		if (Caller->ItemList.ItemToIndexMapping.Contains(Item.Key) == false) { continue; }
+		const int32* ItemIdx = Caller->ItemList.ItemToIndexMapping.Find(Item.Key);
+		if (ItemIdx == nullptr || Item.Value <= 0) { continue; } // Non-positive offers would otherwise reverse the trade direction
 		
-		const int32 TotalItemCount = Caller->ItemList.Items[*Caller->ItemList.ItemToIndexMapping.Find(Item.Key)].TotalItemCount;
+		const int32 TotalItemCount = Caller->ItemList.Items[*ItemIdx].TotalItemCount;
 		if (Item.Value <= TotalItemCount)
 		{
-			const int32 Final = FMath::Clamp(Item.Value, 0, TotalItemCount);
-			Caller->RequestUpdateItem(EPDItemNetOperation::CHANGE, Item.Key, - Final);
-			RequestUpdateItem(EPDItemNetOperation::CHANGE, Item.Key, Final);
-				
+			Caller->RequestUpdateItem(EPDItemNetOperation::CHANGE, Item.Key, - Item.Value);
+			RequestUpdateItem(EPDItemNetOperation::CHANGE, Item.Key, Item.Value);
 		}
 	}
 	
 	// Request from caller to called
-	for (const TPair<FGameplayTag, int32> Item : RequestedItems)
+	for (const TPair<FGameplayTag, int32>& Item : RequestedItems)
 	{
-		if (ItemList.ItemToIndexMapping.Contains(Item.Key) == false) { continue; }
+		const int32* ItemIdx = ItemList.ItemToIndexMapping.Find(Item.Key);
+		if (ItemIdx == nullptr || Item.Value <= 0) { continue; }
 		
-		const int32 TotalItemCount = ItemList.Items[*ItemList.ItemToIndexMapping.Find(Item.Key)].TotalItemCount;
+		const int32 TotalItemCount = ItemList.Items[*ItemIdx].TotalItemCount;
 		if (Item.Value <= TotalItemCount)
 		{
-			const int32 Final = FMath::Clamp(Item.Value, 0, TotalItemCount);
-			RequestUpdateItem(EPDItemNetOperation::CHANGE, Item.Key, - Final);
-			Caller->RequestUpdateItem(EPDItemNetOperation::CHANGE, Item.Key, Final);
+			RequestUpdateItem(EPDItemNetOperation::CHANGE, Item.Key, - Item.Value);
+			Caller->RequestUpdateItem(EPDItemNetOperation::CHANGE, Item.Key, Item.Value);
 		}
 	}	
 }
@@ -100,17 +99,21 @@ bool UPDInventoryComponent::IsAtLastAvailableStack() const
 	return Stacks.Max != INDEX_NONE && Stacks.Max == Stacks.Current;
 }
 
-bool UPDInventoryComponent::CanAfford(const TMap<FGameplayTag, int32> RequestedItems)
+bool UPDInventoryComponent::CanAfford(const TMap<FGameplayTag, int32>& RequestedItems) const
 {
 	return CanAfford(RequestedItems, 1);
 }
 
-bool UPDInventoryComponent::CanAfford(const TMap<FGameplayTag, int32> RequestedItems, int32 CountMultiplier)
+bool UPDInventoryComponent::CanAfford(const TMap<FGameplayTag, int32>& RequestedItems, int32 CountMultiplier) const
 {
 	for (const TTuple<FGameplayTag, int32>& ItemRequest : RequestedItems)
 	{
-		const FPDItemNetDatum* FoundItem = ItemList.Items.FindByKey(ItemRequest.Key);
-		if (FoundItem == nullptr || FoundItem->TotalItemCount < (ItemRequest.Value * CountMultiplier))
+		// Widen before multiplying, large multipliers would otherwise overflow into a negative cost that is always affordable
+		const int64 RequestedCount = static_cast<int64>(ItemRequest.Value) * CountMultiplier;
+		if (RequestedCount <= 0) { continue; }
+		
+		const int32* ItemIdx = ItemList.ItemToIndexMapping.Find(ItemRequest.Key);
+		if (ItemIdx == nullptr || ItemList.Items.IsValidIndex(*ItemIdx) == false || ItemList.Items[*ItemIdx].TotalItemCount < RequestedCount)
 		{
 			return false;
 		}
@@ -6,21 +6,52 @@
 #include "PDItemCommon.h"
 #include "PDInventorySubsystem.h"
 
-static TMap<int32,int32> ConstructTMapInPlace(int32 StackIdx, int32 Count)
+FPDItemNetDatum::FPDItemNetDatum(const FGameplayTag& InItemTag, int32 InCount, int32 InStackLimit)
+	: ItemTag(InItemTag), TotalItemCount(InCount), StackLimit(InStackLimit)
 {
-	TMap<int32,int32> ConstructedMap;
-	ConstructedMap.Emplace(StackIdx) = Count;
-	return ConstructedMap;
+	RefreshDerivedStackData();
 }
 
-FPDItemNetDatum::FPDItemNetDatum(const FGameplayTag& InItemTag, int32 StackIndex, int32 InCount)
-	: ItemTag(InItemTag), LastEditedStackIndex(StackIndex), TotalItemCount(InCount), Stacks(ConstructTMapInPlace(StackIndex, InCount))
+FPDItemNetDatum::FPDItemNetDatum(const FGameplayTag& InItemTag, int32 InCount)
+	: ItemTag(InItemTag), TotalItemCount(InCount)
 {
+	RefreshDerivedStackData();
 }
 
-FPDItemNetDatum::FPDItemNetDatum(const FGameplayTag& InItemTag, int32 InCount)
-	: ItemTag(InItemTag), LastEditedStackIndex(0), TotalItemCount(InCount), Stacks(ConstructTMapInPlace(0, InCount))
+int32 FPDItemNetDatum::ResolveStackLimit() const
+{
+	if (StackLimit > INDEX_NONE) { return StackLimit; }
+
+	const UPDInventorySubsystem* InvSubsystem = UPDInventorySubsystem::Get();
+	const FPDItemDefaultDatum* Datum = InvSubsystem != nullptr ? InvSubsystem->TagToItemMap.FindRef(ItemTag) : nullptr;
+	return Datum != nullptr ? FMath::Max(Datum->StackLimit, 0) : 0;
+}
+
+void FPDItemNetDatum::RefreshDerivedStackData()
+{
+	StackLimit = ResolveStackLimit();
+	LastEditedStackIndex = FMath::Max(GetStackCount() - 1, 0);
+}
+
+int32 FPDItemNetDatum::GetStackCount() const
+{
+	if (TotalItemCount <= 0) { return 0; }
+
+	// Not DivideAndRoundUp, its 'Count + Limit - 1' overflows for totals close to MAX_int32
+	const int32 Limit = ResolveStackLimit();
+	return Limit > 0 ? TotalItemCount / Limit + (TotalItemCount % Limit != 0 ? 1 : 0) : 1;
+}
+
+int32 FPDItemNetDatum::GetStackItemCount(int32 StackIdx) const
 {
+	const int32 StackCount = GetStackCount();
+	if (StackIdx < 0 || StackIdx >= StackCount) { return 0; }
+
+	const int32 Limit = ResolveStackLimit();
+	if (Limit <= 0) { return TotalItemCount; }
+
+	// Every stack but the last is full
+	return StackIdx < StackCount - 1 ? Limit : TotalItemCount - (StackCount - 1) * Limit;
 }
 
 void FPDItemNetDatum::PreReplicatedRemove(const FPDItemList& OwningList)
@@ -32,14 +63,14 @@ void FPDItemNetDatum::PreReplicatedRemove(const FPDItemList& OwningList)
 void FPDItemNetDatum::PostReplicatedAdd(const FPDItemList& OwningList)
 {
 	check(OwningList.GetOwningInventory() != nullptr)
+	RefreshDerivedStackData();
 	OwningList.GetOwningInventory()->OnDatumUpdated(this, EPDItemNetOperation::ADDNEW);
-	OwningList.ItemToIndexMapping;
-	ReplicationID;
 }
 
 void FPDItemNetDatum::PostReplicatedChange(const FPDItemList& OwningList)
 {
 	check(OwningList.GetOwningInventory() != nullptr)
+	RefreshDerivedStackData();
 	OwningList.GetOwningInventory()->OnDatumUpdated(this, EPDItemNetOperation::CHANGE);
 }
 
@@ -48,141 +79,109 @@ bool FPDItemList::NetSerialize(FNetDeltaSerializeInfo& DeltaParams)
 	return FFastArraySerializer::FastArrayDeltaSerialize<FPDItemNetDatum, FPDItemList>(Items, DeltaParams, *this);
 }
 
-bool FPDItemList::RemoveAllItemsOfType(FGameplayTag& ItemToRemove)
+void FPDItemList::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+	RebuildItemToIndexMapping();
+}
+
+void FPDItemList::RebuildItemToIndexMapping()
+{
+	ItemToIndexMapping.Reset();
+	for (int32 ItemIdx = 0; ItemIdx < Items.Num(); ItemIdx++)
+	{
+		ItemToIndexMapping.Emplace(Items[ItemIdx].ItemTag, ItemIdx);
+	}
+}
+
+void FPDItemList::_CommitItemChange(FPDItemNetDatum& Item, int32 OldStackCount)
 {
-	if (ItemToIndexMapping.Contains(ItemToRemove) == false) { return false; }
+	Item.RefreshDerivedStackData();
+	if (OwningInventory != nullptr)
+	{
+		OwningInventory->Stacks.Current += Item.GetStackCount() - OldStackCount;
+	}
 
 	MARK_PROPERTY_DIRTY_FROM_NAME(UPDInventoryComponent, ItemList, OwningInventory)
-	FPDItemNetDatum& NetDatum = Items[ItemToIndexMapping.FindRef(ItemToRemove)];
-	NetDatum.Stacks.Empty(); // clear data
-	NetDatum.LastEditedStackIndex = 0;
+	MarkItemDirty(Item);
+}
+
+bool FPDItemList::RemoveAllItemsOfType(FGameplayTag& ItemToRemove)
+{
+	const int32* ItemIdx = ItemToIndexMapping.Find(ItemToRemove);
+	if (ItemIdx == nullptr) { return false; }
+
+	// Entry is kept with a zero count, removing it would shift every index after it
+	FPDItemNetDatum& NetDatum = Items[*ItemIdx];
+	if (NetDatum.TotalItemCount == 0) { return true; }
+
+	const int32 OldStackCount = NetDatum.GetStackCount();
 	NetDatum.TotalItemCount = 0;
+	_CommitItemChange(NetDatum, OldStackCount);
 	
 	return true;
 }
 
 bool FPDItemList::RemoveStack(FGameplayTag& ItemToRemove, int32 StackIdx)
 {
-	MARK_PROPERTY_DIRTY_FROM_NAME(UPDInventoryComponent, ItemList, OwningInventory)
-	FPDItemNetDatum& NetDatum = Items[ItemToIndexMapping.FindRef(ItemToRemove)];
+	const int32* ItemIdx = ItemToIndexMapping.Find(ItemToRemove);
+	if (ItemIdx == nullptr) { return false; }
 
-	const int32 CopyOldValue = NetDatum.Stacks[StackIdx];
-	NetDatum.Stacks[StackIdx] = 0; // clear data
-	NetDatum.LastEditedStackIndex = StackIdx;
-	NetDatum.TotalItemCount -= CopyOldValue;
+	FPDItemNetDatum& NetDatum = Items[*ItemIdx];
+	const int32 StackItemCount = NetDatum.GetStackItemCount(StackIdx);
+	if (StackItemCount <= 0) { return false; }
+
+	const int32 OldStackCount = NetDatum.GetStackCount();
+	NetDatum.TotalItemCount -= StackItemCount;
+	_CommitItemChange(NetDatum, OldStackCount);
 	
 	return true;
 }
 
 bool FPDItemList::UpdateItem(FGameplayTag& ItemToUpdate, int32 AmountToAdd)
 {
-	if (ItemToIndexMapping.Contains(ItemToUpdate))
-	{
-		const FPDItemNetDatum& Item = Items[ItemToIndexMapping.FindRef(ItemToUpdate)]; // Stacks;
-		return UpdateItemAtStackIdx(ItemToUpdate, Item.LastEditedStackIndex, AmountToAdd);
-	}
-
-	return UpdateItemAtStackIdx(ItemToUpdate, INDEX_NONE, AmountToAdd);
+	const int32* ItemIdx = ItemToIndexMapping.Find(ItemToUpdate);
+	return UpdateItemAtStackIdx(ItemToUpdate, ItemIdx != nullptr ? Items[*ItemIdx].LastEditedStackIndex : INDEX_NONE, AmountToAdd);
 }
 
 bool FPDItemList::_Remove(FGameplayTag& ItemToUpdate, int32& AmountToAdd)
 {
-	FPDItemNetDatum& Item = Items[ItemToIndexMapping.FindRef(ItemToUpdate)]; // Stacks;
-	// remove all items if that is the request
-	if( Item.TotalItemCount <= FMath::Abs(AmountToAdd))
-	{
-		return RemoveAllItemsOfType(ItemToUpdate);
-	}
+	FPDItemNetDatum& Item = Items[ItemToIndexMapping.FindRef(ItemToUpdate)];
+	if (Item.TotalItemCount <= 0) { return false; }
 
-	// Tally how many stack we otherwise might need to remove
-	TArray<int32> StackIndicesToRemove{};
-	for (const TPair<int32,int32>& Stack : Item.Stacks)
-	{
-		if (Stack.Value <= FMath::Abs(AmountToAdd))
-		{
-			AmountToAdd += Stack.Value; // AmountToAdd is negative at this point
-			StackIndicesToRemove.Emplace(Stack.Key);
-			continue;
-		}
-		Item.LastEditedStackIndex = Stack.Key;
-		break;
-	}
+	// AmountToAdd is negative at this point, clamp to what we actually hold and leave the remainder in AmountToAdd
+	const int32 OldStackCount = Item.GetStackCount();
+	const int64 AmountToRemove = FMath::Min<int64>(-static_cast<int64>(AmountToAdd), Item.TotalItemCount);
+	Item.TotalItemCount -= static_cast<int32>(AmountToRemove);
+	AmountToAdd = static_cast<int32>(AmountToAdd + AmountToRemove);
 
-	// Removed tallied stacks
-	for (int32 StackIdxToRemove : StackIndicesToRemove)
-	{
-		RemoveStack(ItemToUpdate, StackIdxToRemove);
-	}
-			
-	MARK_PROPERTY_DIRTY_FROM_NAME(UPDInventoryComponent, ItemList, OwningInventory)
-	int32& StackValue = Item.Stacks[Item.LastEditedStackIndex];
-	if (Item.Stacks[Item.LastEditedStackIndex] > FMath::Abs(AmountToAdd))
-	{
-		StackValue += AmountToAdd;
-	}
+	_CommitItemChange(Item, OldStackCount);
 	return true;
 }
 
 bool FPDItemList::_Add(FGameplayTag& ItemToUpdate, int32 StackIdx, int32& AmountToAdd)
 {
-	MARK_PROPERTY_DIRTY_FROM_NAME(UPDInventoryComponent, ItemList, OwningInventory)
-	FPDItemNetDatum& Item = Items[ItemToIndexMapping.FindRef(ItemToUpdate)]; // Stacks;
-	const UPDInventorySubsystem* InvSubsystem = UPDInventorySubsystem::Get();
-	check(InvSubsystem != nullptr); // Should never be nullptr
-	
-	int32 ItemsInLastEditedStack = 0;
-	if (Item.Stacks.Contains(StackIdx))
-	{
-		ItemsInLastEditedStack = Item.Stacks[Item.LastEditedStackIndex];
-	}
-		
-	const FPDItemDefaultDatum* Datum = InvSubsystem->TagToItemMap.FindRef(ItemToUpdate);
-	const int32 Space = Datum->StackLimit - ItemsInLastEditedStack;
-		
-	TMap<int32, int32>& CurrentStacks = Item.Stacks;
-	const bool bFitsInCurrentStack = Space >= AmountToAdd;
-	if (bFitsInCurrentStack)
-	{
-		Item.TotalItemCount += AmountToAdd; 
-		*(CurrentStacks.Find(StackIdx)) += AmountToAdd;
-		if (Space == AmountToAdd)// next add should target a new stack
-		{
-			Item.LastEditedStackIndex++; // increment last edited stack and use it for the new key
-			const FPDItemNetDatum NetDatum{ItemToUpdate, Item.LastEditedStackIndex, 0};
-			ItemToIndexMapping.Emplace(ItemToUpdate) = Items.Add(NetDatum);
-		}
-			
-		return true;
-	}
+	FPDItemNetDatum& Item = Items[ItemToIndexMapping.FindRef(ItemToUpdate)];
+
+	// Stacks are packed, filling the last stack and spilling into new ones is implied by the total count
+	const int32 OldStackCount = Item.GetStackCount();
+	const int32 CurrentCount = FMath::Max(Item.TotalItemCount, 0);
+	const int64 AmountAdded = FMath::Min<int64>(AmountToAdd, static_cast<int64>(MAX_int32) - CurrentCount);
+	if (AmountAdded <= 0) { return false; }
 	
-	// split
-	AmountToAdd -= Space;
-	*(CurrentStacks.Find(StackIdx)) += Space;
-	OwningInventory->Stacks.Current++;
-			
-
-	// Final added count in last index
-	const int32 AppendedStackRemainder = AmountToAdd != Datum->StackLimit ? AmountToAdd % Datum->StackLimit : AmountToAdd;
-	// find how many stacks we need to create
-	const int32 AppendedStackCount = AmountToAdd / Datum->StackLimit;
-	for (int32 Step = 0; Step < AppendedStackCount; Step++)
-	{
-		Item.LastEditedStackIndex++;
-		CurrentStacks.Emplace(Item.LastEditedStackIndex) = AmountToAdd;
-		OwningInventory->Stacks.Current++;
-	}
-	Item.LastEditedStackIndex++;
-	CurrentStacks.Emplace(Item.LastEditedStackIndex) = AppendedStackRemainder;
+	Item.TotalItemCount = CurrentCount + static_cast<int32>(AmountAdded);
+	AmountToAdd -= static_cast<int32>(AmountAdded);
+
+	_CommitItemChange(Item, OldStackCount);
 	return true;
 }
 
 bool FPDItemList::UpdateItemAtStackIdx(FGameplayTag& ItemToUpdate, int32 StackIdx, int32 AmountToAdd)
 {
-	// @todo when adding an item, map it's tag to array IDX for fast editing of the array after, without having to search for it
 	const UPDInventorySubsystem* InvSubsystem = UPDInventorySubsystem::Get();
 	check(InvSubsystem != nullptr); // Should never be nullptr
 
-	if (InvSubsystem->TagToItemMap.Contains(ItemToUpdate) == false)
+	const FPDItemDefaultDatum* DefaultDatum = InvSubsystem->TagToItemMap.FindRef(ItemToUpdate);
+	if (DefaultDatum == nullptr)
 	{
 		const FString BuildString = "FPDItemList::AddItem -- "
 		+ FString::Printf(TEXT("\n Trying to add item with invalid tag (%s). No given ItemTables have this tag on any given entry "), *ItemToUpdate.GetTagName().ToString());
@@ -190,26 +189,28 @@ bool FPDItemList::UpdateItemAtStackIdx(FGameplayTag& ItemToUpdate, int32 StackId
 
 		return false;
 	}
+	if (AmountToAdd == 0) { return true; } // Nothing changes, nothing to replicate
 
 	// Check if item already exists, if true check its' last edited stack
 	if (ItemToIndexMapping.Contains(ItemToUpdate))
 	{
-
 		//
 		// Removing or Adding items
 		const bool bSubtraction = AmountToAdd < 0; // Want to remove items, possibly full stacks
 		 return bSubtraction
 			? _Remove(ItemToUpdate, AmountToAdd)
 			: _Add(ItemToUpdate, StackIdx, AmountToAdd);
-		
 	}
 
-	MARK_PROPERTY_DIRTY_FROM_NAME(UPDInventoryComponent, ItemList, OwningInventory)
-	const FPDItemNetDatum NetDatum{ItemToUpdate, 0, AmountToAdd};
-	ItemToIndexMapping.Emplace(ItemToUpdate) = Items.Add(NetDatum);
+	// Can't remove what we don't have
+	if (AmountToAdd < 0) { return false; }
+
+	FPDItemNetDatum& NetDatum = Items.Emplace_GetRef(ItemToUpdate, AmountToAdd, FMath::Max(DefaultDatum->StackLimit, 0));
+	ItemToIndexMapping.Emplace(ItemToUpdate) = Items.Num() - 1;
+	_CommitItemChange(NetDatum, 0);
 	return true;	
 }
-// @todo when Item.LastEditedStackIndex reaches close to it's max representation, wrap it around and make sure there are no collisions on the way
+
 
 /**
 Business Source License 1.1
@@ -148,33 +148,44 @@ void UPDInventorySubsystem::ProcessTables()
 	}	
 }
 
-bool UPDInventorySubsystem::CanInventoryAffordItem(
-	FPDItemList& CurrentItemData,
-	const FPDItemDefaultDatum& DefaultItemToConsider,
-	bool bIsCraftingCosts,
-	bool bIsRecurringCosts,
-	const int32 Stage)
+namespace PD::Inventory
 {
-	const TMap<FGameplayTag, FPDItemCosts>& SelectedCosts = bIsCraftingCosts ? DefaultItemToConsider.CraftingCosts : DefaultItemToConsider.UsageCosts;
-
-	bool bCanAfford = false;
-	for (const TTuple<FGameplayTag, FPDItemCosts>& Cost : SelectedCosts)
+	/** @brief Shared by both item data representations, 'ResolveItemCount' returns a pointer to the held count of an item or nullptr if it is not held */
+	template<typename TResolver>
+	int32 GetMaxAffordableCount(
+		const FPDItemDefaultDatum& DefaultItemToConsider,
+		const bool bIsCraftingCosts,
+		const bool bIsRecurringCosts,
+		const int32 Stage,
+		TResolver&& ResolveItemCount)
 	{
-		if (CurrentItemData.ItemToIndexMapping.Contains(Cost.Key) == false) { return false; }
+		const TMap<FGameplayTag, FPDItemCosts>& SelectedCosts = bIsCraftingCosts ? DefaultItemToConsider.CraftingCosts : DefaultItemToConsider.UsageCosts;
+		if (SelectedCosts.IsEmpty()) { return 0; } // Nothing to pay with means it is not a craftable/usable
 
-		const int32 ItemIdx = CurrentItemData.ItemToIndexMapping.FindRef(Cost.Key);
-		if (CurrentItemData.Items.IsValidIndex(ItemIdx) == false || (bIsRecurringCosts && Cost.Value.RecurringCostPerPhase.IsValidIndex(Stage) == false))
+		int32 MaxCount = MAX_int32;
+		for (const TTuple<FGameplayTag, FPDItemCosts>& Cost : SelectedCosts)
 		{
-			return false;
-		}
+			const int32* HeldCount = ResolveItemCount(Cost.Key);
+			if (HeldCount == nullptr || (bIsRecurringCosts && Cost.Value.RecurringCostPerPhase.IsValidIndex(Stage) == false)) { return 0; }
 
-		const int32 SelectedCost = bIsRecurringCosts ? Cost.Value.RecurringCostPerPhase[Stage] : Cost.Value.InitialCost;
-		if (CurrentItemData.Items[ItemIdx].TotalItemCount < SelectedCost) { return false; }
+			const int32 SelectedCost = bIsRecurringCosts ? Cost.Value.RecurringCostPerPhase[Stage] : Cost.Value.InitialCost;
+			if (*HeldCount < SelectedCost) { return 0; }
+			if (SelectedCost <= 0) { continue; } // Free, only needs to be held
 
-		bCanAfford = true;
+			MaxCount = FMath::Min(MaxCount, *HeldCount / SelectedCost);
+		}
+		return MaxCount;
 	}
+}
 
-	return bCanAfford;
+bool UPDInventorySubsystem::CanInventoryAffordItem(
+	FPDItemList& CurrentItemData,
+	const FPDItemDefaultDatum& DefaultItemToConsider,
+	bool bIsCraftingCosts,
+	bool bIsRecurringCosts,
+	const int32 Stage)
+{
+	return GetMaxAffordableCount(CurrentItemData, DefaultItemToConsider, bIsCraftingCosts, bIsRecurringCosts, Stage) > 0;
 }
 
 bool UPDInventorySubsystem::CanInventoryAffordItem(
@@ -184,26 +195,37 @@ bool UPDInventorySubsystem::CanInventoryAffordItem(
 	bool bIsRecurringCosts,
 	const int32 Stage)
 {
-	const TMap<FGameplayTag, FPDItemCosts>& SelectedCosts = bIsCraftingCosts ? DefaultItemToConsider.CraftingCosts : DefaultItemToConsider.UsageCosts;
-
-	bool bCanAfford = false;
-	for (const TTuple<FGameplayTag, FPDItemCosts>& Cost : SelectedCosts)
-	{
-		if (CurrentItemData.Contains(Cost.Key) == false) { return false; }
+	return GetMaxAffordableCount(CurrentItemData, DefaultItemToConsider, bIsCraftingCosts, bIsRecurringCosts, Stage) > 0;
+}
 
-		if (bIsRecurringCosts && Cost.Value.RecurringCostPerPhase.IsValidIndex(Stage) == false)
+int32 UPDInventorySubsystem::GetMaxAffordableCount(
+	const FPDItemList& CurrentItemData,
+	const FPDItemDefaultDatum& DefaultItemToConsider,
+	bool bIsCraftingCosts,
+	bool bIsRecurringCosts,
+	const int32 Stage)
+{
+	return PD::Inventory::GetMaxAffordableCount(DefaultItemToConsider, bIsCraftingCosts, bIsRecurringCosts, Stage,
+		[&CurrentItemData](const FGameplayTag& ItemTag) -> const int32*
 		{
-			return false;
-		}
-		
-
-		const int32 SelectedCost = bIsRecurringCosts ? Cost.Value.RecurringCostPerPhase[Stage] : Cost.Value.InitialCost;
-		if (CurrentItemData.FindRef(Cost.Key).TotalItemCount < SelectedCost) { return false; }
-
-		bCanAfford = true;
-	}
+			const int32* ItemIdx = CurrentItemData.ItemToIndexMapping.Find(ItemTag);
+			return ItemIdx != nullptr && CurrentItemData.Items.IsValidIndex(*ItemIdx) ? &CurrentItemData.Items[*ItemIdx].TotalItemCount : nullptr;
+		});
+}
 
-	return bCanAfford;
+int32 UPDInventorySubsystem::GetMaxAffordableCount(
+	const TMap<FGameplayTag, FPDLightItemDatum>& CurrentItemData,
+	const FPDItemDefaultDatum& DefaultItemToConsider,
+	bool bIsCraftingCosts,
+	bool bIsRecurringCosts,
+	const int32 Stage)
+{
+	return PD::Inventory::GetMaxAffordableCount(DefaultItemToConsider, bIsCraftingCosts, bIsRecurringCosts, Stage,
+		[&CurrentItemData](const FGameplayTag& ItemTag) -> const int32*
+		{
+			const FPDLightItemDatum* LightDatum = CurrentItemData.Find(ItemTag);
+			return LightDatum != nullptr ? &LightDatum->TotalItemCount : nullptr;
+		});
 }
 
 const FPDItemDefaultDatum* UPDInventorySubsystem::GetDefaultDatum(const FName& RowName)
@@ -0,0 +1,246 @@
+﻿/* @author: Ario Amin @ Permafrost Development. @copyright: Full BSL(1.1) License included at bottom of the file  */
+
+#include "PDInventorySubsystem.h"
+#include "PDItemCommon.h"
+#include "Components/PDInventoryComponent.h"
+#include "Net/PDItemNetDatum.h"
+#include "NativeGameplayTags.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace PD::Inventory::Tests
+{
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Test_Inventory_Wood, "Test.Inventory.Wood");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Test_Inventory_Stone, "Test.Inventory.Stone");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Test_Inventory_Gold, "Test.Inventory.Gold");
+
+	/** @brief Fills the list directly, an explicit stack limit keeps the datums from resolving it through the inventory subsystem */
+	void FillItemList(FPDItemList& ItemList, const TMap<FGameplayTag, int32>& HeldItems)
+	{
+		ItemList.Items.Reset();
+		for (const TPair<FGameplayTag, int32>& HeldItem : HeldItems)
+		{
+			ItemList.Items.Emplace(HeldItem.Key, HeldItem.Value, 0);
+		}
+		ItemList.RebuildItemToIndexMapping();
+	}
+
+	/** @brief Item with a single crafting cost line per entry of 'Costs' */
+	FPDItemDefaultDatum MakeCraftable(const TMap<FGameplayTag, int32>& Costs, const TArray<int32>& RecurringCosts = {})
+	{
+		FPDItemDefaultDatum Datum;
+		for (const TPair<FGameplayTag, int32>& Cost : Costs)
+		{
+			FPDItemCosts& ItemCosts = Datum.CraftingCosts.Add(Cost.Key);
+			ItemCosts.InitialCost = Cost.Value;
+			ItemCosts.RecurringCostPerPhase = RecurringCosts;
+		}
+		return Datum;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPDAffordabilityMultiplierTest, "PD.Inventory.Affordability.CountMultiplier", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FPDAffordabilityMultiplierTest::RunTest(const FString& Parameters)
+{
+	using namespace PD::Inventory::Tests;
+	UPDInventoryComponent* Inventory = NewObject<UPDInventoryComponent>();
+	FillItemList(Inventory->ItemList, {{TAG_Test_Inventory_Wood, 10}, {TAG_Test_Inventory_Stone, 7}});
+
+	const TMap<FGameplayTag, int32> Cost{{TAG_Test_Inventory_Wood, 3}, {TAG_Test_Inventory_Stone, 2}};
+	TestTrue(TEXT("A single unit is affordable"), Inventory->CanAfford(Cost));
+	TestTrue(TEXT("Three units are affordable"), Inventory->CanAfford(Cost, 3));
+	TestFalse(TEXT("Four units exceed the wood held"), Inventory->CanAfford(Cost, 4));
+	TestTrue(TEXT("A zero multiplier costs nothing"), Inventory->CanAfford(Cost, 0));
+	TestFalse(TEXT("Items that are not held can not be paid with"), Inventory->CanAfford({{TAG_Test_Inventory_Gold, 1}}));
+	TestTrue(TEXT("Non-positive request lines are ignored"), Inventory->CanAfford({{TAG_Test_Inventory_Gold, 0}, {TAG_Test_Inventory_Wood, -5}}));
+
+	// The crafting path agrees with the multiplier path
+	const FPDItemDefaultDatum Craftable = MakeCraftable(Cost);
+	TestEqual(TEXT("Max affordable count is limited by the scarcest item"), UPDInventorySubsystem::GetMaxAffordableCount(Inventory->ItemList, Craftable, true, false, 0), 3);
+	for (int32 Multiplier = 1; Multiplier <= 5; Multiplier++)
+	{
+		const bool bByMaxCount = UPDInventorySubsystem::GetMaxAffordableCount(Inventory->ItemList, Craftable, true, false, 0) >= Multiplier;
+		TestEqual(*FString::Printf(TEXT("Max count and multiplier agree for x%d"), Multiplier), Inventory->CanAfford(Cost, Multiplier), bByMaxCount);
+	}
+
+	// Recurring costs are picked per stage, a stage that does not exist can not be afforded
+	const FPDItemDefaultDatum Recurring = MakeCraftable({{TAG_Test_Inventory_Wood, 1}}, {4, 1});
+	TestEqual(TEXT("Recurring stage 0 uses its own cost"), UPDInventorySubsystem::GetMaxAffordableCount(Inventory->ItemList, Recurring, true, true, 0), 2);
+	TestEqual(TEXT("Recurring stage 1 uses its own cost"), UPDInventorySubsystem::GetMaxAffordableCount(Inventory->ItemList, Recurring, true, true, 1), 10);
+	TestEqual(TEXT("A missing recurring stage is unaffordable"), UPDInventorySubsystem::GetMaxAffordableCount(Inventory->ItemList, Recurring, true, true, 2), 0);
+	TestFalse(TEXT("A missing recurring stage fails the affordability check"), UPDInventorySubsystem::CanInventoryAffordItem(Inventory->ItemList, Recurring, true, true, 2));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPDAffordabilityOverflowTest, "PD.Inventory.Affordability.Overflow", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FPDAffordabilityOverflowTest::RunTest(const FString& Parameters)
+{
+	using namespace PD::Inventory::Tests;
+	UPDInventoryComponent* Inventory = NewObject<UPDInventoryComponent>();
+	FillItemList(Inventory->ItemList, {{TAG_Test_Inventory_Wood, 2000000000}});
+
+	// 2^30 * 4 wraps to 0 in int32 arithmetic, 2^30 * 3 wraps negative, both would read as free
+	const TMap<FGameplayTag, int32> Cost{{TAG_Test_Inventory_Wood, 1 << 30}};
+	TestTrue(TEXT("A single large cost is affordable"), Inventory->CanAfford(Cost, 1));
+	TestFalse(TEXT("A product wrapping to zero is not affordable"), Inventory->CanAfford(Cost, 4));
+	TestFalse(TEXT("A product wrapping negative is not affordable"), Inventory->CanAfford(Cost, 3));
+	TestFalse(TEXT("The largest multiplier is not affordable"), Inventory->CanAfford(Cost, MAX_int32));
+	TestFalse(TEXT("The largest single cost beyond what is held is not affordable"), Inventory->CanAfford({{TAG_Test_Inventory_Wood, MAX_int32}}, MAX_int32));
+
+	// Division based max count can not overflow, even with the item count at its limit
+	FillItemList(Inventory->ItemList, {{TAG_Test_Inventory_Wood, MAX_int32}});
+	TestEqual(TEXT("A unit cost against a full count is affordable MAX_int32 times"),
+		UPDInventorySubsystem::GetMaxAffordableCount(Inventory->ItemList, MakeCraftable({{TAG_Test_Inventory_Wood, 1}}), true, false, 0), MAX_int32);
+	TestEqual(TEXT("The largest cost against a full count is affordable once"),
+		UPDInventorySubsystem::GetMaxAffordableCount(Inventory->ItemList, MakeCraftable({{TAG_Test_Inventory_Wood, MAX_int32}}), true, false, 0), 1);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPDAffordabilityEmptyCostTest, "PD.Inventory.Affordability.EmptyCost", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FPDAffordabilityEmptyCostTest::RunTest(const FString& Parameters)
+{
+	using namespace PD::Inventory::Tests;
+	FPDItemList ItemList;
+	FillItemList(ItemList, {{TAG_Test_Inventory_Wood, 10}});
+	const TMap<FGameplayTag, FPDLightItemDatum> LightItems{{TAG_Test_Inventory_Wood, FPDLightItemDatum{TAG_Test_Inventory_Wood, 10}}};
+
+	// An item without costs is not a craftable, both the check and the count say so for both item representations
+	const FPDItemDefaultDatum NoCosts{};
+	TestFalse(TEXT("No costs is not affordable"), UPDInventorySubsystem::CanInventoryAffordItem(ItemList, NoCosts, true, false, 0));
+	TestEqual(TEXT("No costs has a max count of zero"), UPDInventorySubsystem::GetMaxAffordableCount(ItemList, NoCosts, true, false, 0), 0);
+	TestFalse(TEXT("No costs is not affordable from light data"), UPDInventorySubsystem::CanInventoryAffordItem(LightItems, NoCosts, true, false, 0));
+	TestEqual(TEXT("No costs has a max count of zero from light data"), UPDInventorySubsystem::GetMaxAffordableCount(LightItems, NoCosts, true, false, 0), 0);
+
+	// A free cost line only requires the item to be held
+	const FPDItemDefaultDatum FreeHeld = MakeCraftable({{TAG_Test_Inventory_Wood, 0}});
+	TestTrue(TEXT("A free cost of a held item is affordable"), UPDInventorySubsystem::CanInventoryAffordItem(ItemList, FreeHeld, true, false, 0));
+	TestEqual(TEXT("A free cost of a held item is affordable without limit"), UPDInventorySubsystem::GetMaxAffordableCount(ItemList, FreeHeld, true, false, 0), MAX_int32);
+	TestEqual(TEXT("Light data agrees on free costs"), UPDInventorySubsystem::GetMaxAffordableCount(LightItems, FreeHeld, true, false, 0), MAX_int32);
+
+	const FPDItemDefaultDatum FreeMissing = MakeCraftable({{TAG_Test_Inventory_Gold, 0}});
+	TestFalse(TEXT("A free cost of an item that is not held is not affordable"), UPDInventorySubsystem::CanInventoryAffordItem(ItemList, FreeMissing, true, false, 0));
+	TestEqual(TEXT("A free cost of an item that is not held has a max count of zero"), UPDInventorySubsystem::GetMaxAffordableCount(ItemList, FreeMissing, true, false, 0), 0);
+
+	// Usage costs are kept apart from crafting costs
+	TestFalse(TEXT("Crafting costs do not count as usage costs"), UPDInventorySubsystem::CanInventoryAffordItem(ItemList, FreeHeld, false, false, 0));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
+
+/**
+Business Source License 1.1
+
+Parameters
+
+Licensor:             Ario Amin (@ Permafrost Development)
+Licensed Work:        RTSOpen (Source available on github)
+                      The Licensed Work is (c) 2024 Ario Amin (@ Permafrost Development)
+Additional Use Grant: You may make free use of the Licensed Work in a commercial product or service provided these three additional conditions as met; 
+                      1. Must give attributions to the original author of the Licensed Work, in 'Credits' if that is applicable.
+                      2. The Licensed Work must be Compiled before being redistributed.
+                      3. The Licensed Work Source may be linked but may not be packaged into the product or service being sold
+                      4. Must not be resold or repackaged or redistributed as another product, is only allowed to be used within a commercial or non-commercial game project.
+                      5. Teams with yearly budgets larger than 100000 USD must contact the owner for a custom license or buy the framework from a marketplace it has been made available on.
+
+                      "Credits" indicate a scrolling screen with attributions. This is usually in a products end-state
+
+                      "Package" means the collection of files distributed by the Licensor, and derivatives of that collection
+                      and/or of those files..   
+
+                      "Source" form means the source code, documentation source, and configuration files for the Package, usually in human-readable format.
+
+                      "Compiled" form means the compiled bytecode, object code, binary, or any other
+                      form resulting from mechanical transformation or translation of the Source form.
+
+Change Date:          2028-04-17
+
+Change License:       Apache License, Version 2.0
+
+For information about alternative licensing arrangements for the Software,
+please visit: https://permadev.se/
+
+Notice
+
+The Business Source License (this document, or the “License”) is not an Open
+Source license. However, the Licensed Work will eventually be made available
+under an Open Source License, as stated in this License.
+
+License text copyright (c) 2017 MariaDB Corporation Ab, All Rights Reserved.
+“Business Source License” is a trademark of MariaDB Corporation Ab.
+
+-----------------------------------------------------------------------------
+
+Business Source License 1.1
+
+Terms
+
+The Licensor hereby grants you the right to copy, modify, create derivative
+works, redistribute, and make non-production use of the Licensed Work. The
+Licensor may make an Additional Use Grant, above, permitting limited
+production use.
+
+Effective on the Change Date, or the fourth anniversary of the first publicly
+available distribution of a specific version of the Licensed Work under this
+License, whichever comes first, the Licensor hereby grants you rights under
+the terms of the Change License, and the rights granted in the paragraph
+above terminate.
+
+If your use of the Licensed Work does not comply with the requirements
+currently in effect as described in this License, you must purchase a
+commercial license from the Licensor, its affiliated entities, or authorized
+resellers, or you must refrain from using the Licensed Work.
+
+All copies of the original and modified Licensed Work, and derivative works
+of the Licensed Work, are subject to this License. This License applies
+separately for each version of the Licensed Work and the Change Date may vary
+for each version of the Licensed Work released by Licensor.
+
+You must conspicuously display this License on each original or modified copy
+of the Licensed Work. If you receive the Licensed Work in original or
+modified form from a third party, the terms and conditions set forth in this
+License apply to your use of that work.
+
+Any use of the Licensed Work in violation of this License will automatically
+terminate your rights under this License for the current and all other
+versions of the Licensed Work.
+
+This License does not grant you any right in any trademark or logo of
+Licensor or its affiliates (provided that you may use a trademark or logo of
+Licensor as expressly required by this License).
+
+TO THE EXTENT PERMITTED BY APPLICABLE LAW, THE LICENSED WORK IS PROVIDED ON
+AN “AS IS” BASIS. LICENSOR HEREBY DISCLAIMS ALL WARRANTIES AND CONDITIONS,
+EXPRESS OR IMPLIED, INCLUDING (WITHOUT LIMITATION) WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT, AND
+TITLE.
+
+MariaDB hereby grants you permission to use this License’s text to license
+your works, and to refer to it using the trademark “Business Source License”,
+as long as you comply with the Covenants of Licensor below.
+
+Covenants of Licensor
+
+In consideration of the right to use this License’s text and the “Business
+Source License” name and trademark, Licensor covenants to MariaDB, and to all
+other recipients of the licensed work to be provided by Licensor:
+
+1. To specify as the Change License the GPL Version 2.0 or any later version,
+   or a license that is compatible with GPL Version 2.0 or a later version,
+   where “compatible” means that software provided under the Change License can
+   be included in a program with software provided under GPL Version 2.0 or a
+   later version. Licensor may specify additional Change Licenses without
+   limitation.
+
+2. To either: (a) specify an additional grant of rights to use that does not
+   impose any additional restriction on the right granted in this License, as
+   the Additional Use Grant; or (b) insert the text “None”.
+
+3. To specify a Change Date.
+
+4. Not to modify this License in any other way.
+ **/
@@ -0,0 +1,463 @@
+﻿/* @author: Ario Amin @ Permafrost Development. @copyright: Full BSL(1.1) License included at bottom of the file  */
+
+#include "Net/PDItemNetDatum.h"
+#include "PDInventorySubsystem.h"
+#include "PDItemCommon.h"
+#include "Components/PDInventoryComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "NativeGameplayTags.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace PD::Inventory::NetDatum::Tests
+{
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Test_NetDatum_Stacked, "Test.Inventory.NetDatum.Stacked");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Test_NetDatum_Unlimited, "Test.Inventory.NetDatum.Unlimited");
+
+	constexpr int32 TestStackLimit = 10;
+
+	/** @brief Registers the test items in the inventory subsystem for the lifetime of the scope, the item list only accepts items it can resolve */
+	struct FScopedTestItems
+	{
+		FScopedTestItems()
+		{
+			Subsystem = UPDInventorySubsystem::Get();
+			if (Subsystem == nullptr) { return; }
+			
+			Stacked.ItemTag = TAG_Test_NetDatum_Stacked;
+			Stacked.StackLimit = TestStackLimit;
+			Unlimited.ItemTag = TAG_Test_NetDatum_Unlimited;
+			Unlimited.StackLimit = 0;
+			Subsystem->TagToItemMap.Emplace(Stacked.ItemTag, &Stacked);
+			Subsystem->TagToItemMap.Emplace(Unlimited.ItemTag, &Unlimited);
+		}
+		~FScopedTestItems()
+		{
+			if (Subsystem == nullptr) { return; }
+			
+			Subsystem->TagToItemMap.Remove(Stacked.ItemTag);
+			Subsystem->TagToItemMap.Remove(Unlimited.ItemTag);
+		}
+
+		UPDInventorySubsystem* Subsystem = nullptr;
+		FPDItemDefaultDatum Stacked{};
+		FPDItemDefaultDatum Unlimited{};
+	};
+
+	/** @brief Transient world with an actor owning each inventory, 'RequestUpdateItem' expects an owner */
+	struct FScopedTestInventories
+	{
+		explicit FScopedTestInventories(const int32 InventoryCount)
+		{
+			World = UWorld::CreateWorld(EWorldType::Game, false);
+			for (int32 InventoryIdx = 0; InventoryIdx < InventoryCount; InventoryIdx++)
+			{
+				AActor* Owner = World->SpawnActor<AActor>();
+				UPDInventoryComponent* Inventory = NewObject<UPDInventoryComponent>(Owner);
+				Inventory->Stacks.Current = 0;
+				Inventories.Emplace(Inventory);
+			}
+		}
+		~FScopedTestInventories()
+		{
+			World->DestroyWorld(false);
+			World->RemoveFromRoot();
+		}
+
+		UWorld* World = nullptr;
+		TArray<UPDInventoryComponent*> Inventories{};
+	};
+
+	/** @brief Total count of the item in the inventory, 0 if it has no entry */
+	int32 GetTotal(const UPDInventoryComponent* Inventory, const FGameplayTag& ItemTag)
+	{
+		const int32* ItemIdx = Inventory->ItemList.ItemToIndexMapping.Find(ItemTag);
+		return ItemIdx != nullptr ? Inventory->ItemList.Items[*ItemIdx].TotalItemCount : 0;
+	}
+
+	/** @brief Checks that the mapping, the derived stacks and the inventories stack tracker agree with the total counts */
+	bool CheckInvariants(FAutomationTestBase& Test, const UPDInventoryComponent* Inventory, const FString& Context)
+	{
+		const FPDItemList& ItemList = Inventory->ItemList;
+		int32 StackSum = 0;
+		for (int32 ItemIdx = 0; ItemIdx < ItemList.Items.Num(); ItemIdx++)
+		{
+			const FPDItemNetDatum& Item = ItemList.Items[ItemIdx];
+			if (ItemList.ItemToIndexMapping.FindRef(Item.ItemTag) != ItemIdx)
+			{
+				Test.AddError(FString::Printf(TEXT("%s: mapping of %s does not point at index %d"), *Context, *Item.ItemTag.ToString(), ItemIdx));
+				return false;
+			}
+			if (Item.TotalItemCount < 0)
+			{
+				Test.AddError(FString::Printf(TEXT("%s: %s holds a negative count %d"), *Context, *Item.ItemTag.ToString(), Item.TotalItemCount));
+				return false;
+			}
+
+			const int32 StackCount = Item.GetStackCount();
+			int32 ItemSum = 0;
+			for (int32 StackIdx = 0; StackIdx < StackCount; StackIdx++)
+			{
+				ItemSum += Item.GetStackItemCount(StackIdx);
+			}
+			if (ItemSum != Item.TotalItemCount || Item.LastEditedStackIndex != FMath::Max(StackCount - 1, 0))
+			{
+				Test.AddError(FString::Printf(TEXT("%s: %s stacks hold %d of %d, last edited stack %d of %d"), *Context, *Item.ItemTag.ToString(), ItemSum, Item.TotalItemCount, Item.LastEditedStackIndex, StackCount));
+				return false;
+			}
+			StackSum += StackCount;
+		}
+
+		if (Inventory->Stacks.Current != StackSum)
+		{
+			Test.AddError(FString::Printf(TEXT("%s: inventory tracks %d stacks, items occupy %d"), *Context, Inventory->Stacks.Current, StackSum));
+			return false;
+		}
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPDItemNetDatumStackDerivationTest, "PD.Inventory.ItemNetDatum.StackDerivation", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FPDItemNetDatumStackDerivationTest::RunTest(const FString& Parameters)
+{
+	// Edge cases, an explicit stack limit keeps the datum from resolving it through the inventory subsystem
+	{
+		const FPDItemNetDatum Empty(FGameplayTag::EmptyTag, 0, 10);
+		TestEqual(TEXT("An empty item has no stacks"), Empty.GetStackCount(), 0);
+		TestEqual(TEXT("An empty item reports nothing in its first stack"), Empty.GetStackItemCount(0), 0);
+
+		const FPDItemNetDatum Unlimited(FGameplayTag::EmptyTag, 12345, 0);
+		TestEqual(TEXT("An unlimited item occupies a single stack"), Unlimited.GetStackCount(), 1);
+		TestEqual(TEXT("An unlimited items single stack holds everything"), Unlimited.GetStackItemCount(0), 12345);
+
+		const FPDItemNetDatum Exact(FGameplayTag::EmptyTag, 30, 10);
+		TestEqual(TEXT("An exact multiple of the limit fills every stack"), Exact.GetStackCount(), 3);
+		TestEqual(TEXT("The last stack of an exact multiple is full"), Exact.GetStackItemCount(2), 10);
+		TestEqual(TEXT("Out of range stacks hold nothing"), Exact.GetStackItemCount(3), 0);
+		TestEqual(TEXT("Negative stack indices hold nothing"), Exact.GetStackItemCount(-1), 0);
+	}
+
+	// Property sweep, stacks must be packed and add up to the total for any total and limit
+	FRandomStream Stream(0x5EED);
+	for (int32 Iteration = 0; Iteration < 2000; Iteration++)
+	{
+		const int32 StackLimit = Stream.RandRange(1, 250);
+		const int32 TotalItemCount = Stream.RandRange(1, 100000);
+		const FPDItemNetDatum Datum(FGameplayTag::EmptyTag, TotalItemCount, StackLimit);
+
+		const int32 StackCount = Datum.GetStackCount();
+		if (TestEqual(TEXT("Stack count is the total divided by the limit, rounded up"), StackCount, FMath::DivideAndRoundUp(TotalItemCount, StackLimit)) == false)
+		{
+			return false;
+		}
+		TestEqual(TEXT("The last edited stack is the last stack"), Datum.LastEditedStackIndex, StackCount - 1);
+
+		int32 Sum = 0;
+		for (int32 StackIdx = 0; StackIdx < StackCount; StackIdx++)
+		{
+			const int32 StackItemCount = Datum.GetStackItemCount(StackIdx);
+			const bool bIsLastStack = StackIdx == StackCount - 1;
+			if (bIsLastStack == false && StackItemCount != StackLimit)
+			{
+				AddError(FString::Printf(TEXT("Stack %d of %d holds %d, expected a full stack of %d (total %d)"), StackIdx, StackCount, StackItemCount, StackLimit, TotalItemCount));
+				return false;
+			}
+			if (bIsLastStack && (StackItemCount <= 0 || StackItemCount > StackLimit))
+			{
+				AddError(FString::Printf(TEXT("Last stack holds %d, expected (0, %d] (total %d)"), StackItemCount, StackLimit, TotalItemCount));
+				return false;
+			}
+			Sum += StackItemCount;
+		}
+		if (TestEqual(TEXT("Stacks add up to the total count"), Sum, TotalItemCount) == false) { return false; }
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPDItemNetDatumAddRemoveTest, "PD.Inventory.ItemNetDatum.AddRemove", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FPDItemNetDatumAddRemoveTest::RunTest(const FString& Parameters)
+{
+	using namespace PD::Inventory::NetDatum::Tests;
+	const FScopedTestItems TestItems;
+	if (TestItems.Subsystem == nullptr)
+	{
+		AddError(TEXT("Inventory subsystem is not available"));
+		return false;
+	}
+	
+	FScopedTestInventories TestInventories(1);
+	UPDInventoryComponent* Inventory = TestInventories.Inventories[0];
+	FPDItemList& ItemList = Inventory->ItemList;
+	FGameplayTag Stacked = TAG_Test_NetDatum_Stacked;
+
+	TestFalse(TEXT("Removing an item that was never added fails"), ItemList.UpdateItem(Stacked, -1));
+	TestEqual(TEXT("A failed removal adds no entry"), ItemList.Items.Num(), 0);
+	
+	TestTrue(TEXT("Adding a new item succeeds"), ItemList.UpdateItem(Stacked, 25));
+	TestEqual(TEXT("25 items occupy three stacks"), ItemList.Items[0].GetStackCount(), 3);
+	TestEqual(TEXT("The last stack holds the remainder"), ItemList.Items[0].GetStackItemCount(2), 5);
+	CheckInvariants(*this, Inventory, TEXT("After adding"));
+
+	// Removal drains the last stack first and crosses into the full stack before it
+	TestTrue(TEXT("Removing across a stack boundary succeeds"), ItemList.UpdateItem(Stacked, -7));
+	TestEqual(TEXT("Removal across a boundary leaves the rest"), GetTotal(Inventory, Stacked), 18);
+	TestEqual(TEXT("The emptied stack is released"), ItemList.Items[0].GetStackCount(), 2);
+	TestEqual(TEXT("The stack before the boundary was drained"), ItemList.Items[0].GetStackItemCount(1), 8);
+	CheckInvariants(*this, Inventory, TEXT("After removing across a boundary"));
+
+	TestTrue(TEXT("Removing down to a stack boundary succeeds"), ItemList.UpdateItem(Stacked, -8));
+	TestEqual(TEXT("A single full stack remains"), ItemList.Items[0].GetStackCount(), 1);
+	TestEqual(TEXT("The remaining stack is full"), ItemList.Items[0].GetStackItemCount(0), TestStackLimit);
+	CheckInvariants(*this, Inventory, TEXT("After removing to a boundary"));
+
+	// Removing more than is held clamps to what is held, the entry is kept so no indices shift
+	TestTrue(TEXT("Removing more than is held succeeds"), ItemList.UpdateItem(Stacked, -50));
+	TestEqual(TEXT("Over-removal clamps at zero"), GetTotal(Inventory, Stacked), 0);
+	TestEqual(TEXT("The entry is kept"), ItemList.Items.Num(), 1);
+	TestEqual(TEXT("An empty item occupies no stacks"), ItemList.Items[0].GetStackCount(), 0);
+	TestFalse(TEXT("Removing from an empty item fails"), ItemList.UpdateItem(Stacked, -1));
+	CheckInvariants(*this, Inventory, TEXT("After removing more than is held"));
+
+	// Additions saturate instead of wrapping
+	TestTrue(TEXT("Adding up to the limit succeeds"), ItemList.UpdateItem(Stacked, MAX_int32));
+	TestFalse(TEXT("Adding past the limit fails"), ItemList.UpdateItem(Stacked, 1));
+	TestEqual(TEXT("The total saturates"), GetTotal(Inventory, Stacked), MAX_int32);
+	CheckInvariants(*this, Inventory, TEXT("After saturating"));
+	ItemList.RemoveAllItemsOfType(Stacked);
+
+	// Random sequence against a reference count, for a stacked and an unlimited item
+	FRandomStream Stream(0xD17A);
+	TMap<FGameplayTag, int64> Expected{{TAG_Test_NetDatum_Stacked, 0}, {TAG_Test_NetDatum_Unlimited, 0}};
+	for (int32 Step = 0; Step < 2000; Step++)
+	{
+		FGameplayTag ItemTag = Stream.FRand() < 0.5f ? TAG_Test_NetDatum_Stacked : TAG_Test_NetDatum_Unlimited;
+		const int32 Amount = Stream.RandRange(-40, 40);
+		ItemList.UpdateItem(ItemTag, Amount);
+
+		int64& ExpectedCount = Expected.FindChecked(ItemTag);
+		ExpectedCount = FMath::Max<int64>(ExpectedCount + Amount, 0);
+		if (TestEqual(TEXT("Total count matches the reference"), GetTotal(Inventory, ItemTag), static_cast<int32>(ExpectedCount)) == false) { return false; }
+		if (CheckInvariants(*this, Inventory, FString::Printf(TEXT("Step %d"), Step)) == false) { return false; }
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPDItemNetDatumChangeTradeTest, "PD.Inventory.ItemNetDatum.ChangeAndTrade", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FPDItemNetDatumChangeTradeTest::RunTest(const FString& Parameters)
+{
+	using namespace PD::Inventory::NetDatum::Tests;
+	const FScopedTestItems TestItems;
+	if (TestItems.Subsystem == nullptr)
+	{
+		AddError(TEXT("Inventory subsystem is not available"));
+		return false;
+	}
+
+	FScopedTestInventories TestInventories(2);
+	UPDInventoryComponent* Seller = TestInventories.Inventories[0];
+	UPDInventoryComponent* Buyer = TestInventories.Inventories[1];
+	const FGameplayTag Stacked = TAG_Test_NetDatum_Stacked;
+	const FGameplayTag Unlimited = TAG_Test_NetDatum_Unlimited;
+
+	// Change requests go through the same path as direct updates
+	Seller->RequestUpdateItem(EPDItemNetOperation::ADDNEW, Stacked, 35);
+	Seller->RequestUpdateItem(EPDItemNetOperation::CHANGE, Stacked, -12);
+	Buyer->RequestUpdateItem(EPDItemNetOperation::ADDNEW, Unlimited, 100);
+	TestEqual(TEXT("Changes apply to the seller"), GetTotal(Seller, Stacked), 23);
+	TestEqual(TEXT("Changes apply to the buyer"), GetTotal(Buyer, Unlimited), 100);
+	CheckInvariants(*this, Seller, TEXT("Seller after changes"));
+	CheckInvariants(*this, Buyer, TEXT("Buyer after changes"));
+
+	// Buyer offers unlimited items and requests stacked items, both sides keep their totals
+	Seller->RequestTradeItems(Buyer, {{Unlimited, 40}}, {{Stacked, 13}});
+	TestEqual(TEXT("Seller paid the requested items"), GetTotal(Seller, Stacked), 10);
+	TestEqual(TEXT("Buyer received the requested items"), GetTotal(Buyer, Stacked), 13);
+	TestEqual(TEXT("Seller received the offered items"), GetTotal(Seller, Unlimited), 40);
+	TestEqual(TEXT("Buyer paid the offered items"), GetTotal(Buyer, Unlimited), 60);
+	CheckInvariants(*this, Seller, TEXT("Seller after trading"));
+	CheckInvariants(*this, Buyer, TEXT("Buyer after trading"));
+
+	// Offers and requests larger than what is held, or non-positive, are skipped and never move items
+	Seller->RequestTradeItems(Buyer, {{Unlimited, 61}, {Stacked, -5}}, {{Stacked, 11}, {Unlimited, 0}});
+	TestEqual(TEXT("Skipped trade leaves the seller's stacked items"), GetTotal(Seller, Stacked), 10);
+	TestEqual(TEXT("Skipped trade leaves the buyer's stacked items"), GetTotal(Buyer, Stacked), 13);
+	TestEqual(TEXT("Skipped trade leaves the seller's unlimited items"), GetTotal(Seller, Unlimited), 40);
+	TestEqual(TEXT("Skipped trade leaves the buyer's unlimited items"), GetTotal(Buyer, Unlimited), 60);
+	CheckInvariants(*this, Seller, TEXT("Seller after skipped trade"));
+	CheckInvariants(*this, Buyer, TEXT("Buyer after skipped trade"));
+
+	// Trading out everything held empties the entry but keeps it
+	Seller->RequestTradeItems(Buyer, {}, {{Stacked, 10}});
+	TestEqual(TEXT("Seller traded away every stacked item"), GetTotal(Seller, Stacked), 0);
+	TestEqual(TEXT("Buyer holds every stacked item"), GetTotal(Buyer, Stacked), 23);
+	TestTrue(TEXT("Seller keeps the empty entry"), Seller->ItemList.ItemToIndexMapping.Contains(Stacked));
+	CheckInvariants(*this, Seller, TEXT("Seller after emptying"));
+	CheckInvariants(*this, Buyer, TEXT("Buyer after emptying"));
+
+	Buyer->RequestUpdateItem(EPDItemNetOperation::REMOVEALL, Stacked, 0);
+	TestEqual(TEXT("Remove all empties the item"), GetTotal(Buyer, Stacked), 0);
+	CheckInvariants(*this, Buyer, TEXT("Buyer after remove all"));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPDItemNetDatumDeltaSizeTest, "PD.Inventory.ItemNetDatum.DeltaSize", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FPDItemNetDatumDeltaSizeTest::RunTest(const FString& Parameters)
+{
+	using namespace PD::Inventory::NetDatum::Tests;
+
+	// Only the tag and the total count may replicate, the derived stack data and fast array bookkeeping are local
+	int32 ReplicatedBytes = 0;
+	TArray<FString> ReplicatedNames;
+	for (TFieldIterator<FProperty> PropertyIt(FPDItemNetDatum::StaticStruct()); PropertyIt; ++PropertyIt)
+	{
+		if (PropertyIt->HasAnyPropertyFlags(CPF_RepSkip)) { continue; }
+		
+		ReplicatedBytes += PropertyIt->GetSize();
+		ReplicatedNames.Emplace(PropertyIt->GetName());
+	}
+	TestTrue(TEXT("Only ItemTag and TotalItemCount replicate"), ReplicatedNames.Num() == 2 && ReplicatedNames.Contains(TEXT("ItemTag")) && ReplicatedNames.Contains(TEXT("TotalItemCount")));
+	TestTrue(FString::Printf(TEXT("Replicated payload of %d bytes fits the documented 16 bytes"), ReplicatedBytes), ReplicatedBytes <= 16);
+
+	const FScopedTestItems TestItems;
+	if (TestItems.Subsystem == nullptr)
+	{
+		AddError(TEXT("Inventory subsystem is not available"));
+		return false;
+	}
+
+	// A change re-sends only the item that changed
+	FScopedTestInventories TestInventories(1);
+	FPDItemList& ItemList = TestInventories.Inventories[0]->ItemList;
+	FGameplayTag Stacked = TAG_Test_NetDatum_Stacked;
+	FGameplayTag Unlimited = TAG_Test_NetDatum_Unlimited;
+	ItemList.UpdateItem(Stacked, 5);
+	ItemList.UpdateItem(Unlimited, 5);
+
+	const int32 StackedKey = ItemList.Items[ItemList.ItemToIndexMapping.FindRef(Stacked)].ReplicationKey;
+	const int32 UnlimitedKey = ItemList.Items[ItemList.ItemToIndexMapping.FindRef(Unlimited)].ReplicationKey;
+	ItemList.UpdateItem(Stacked, 20);
+	TestTrue(TEXT("The changed item is dirtied"), ItemList.Items[ItemList.ItemToIndexMapping.FindRef(Stacked)].ReplicationKey != StackedKey);
+	TestEqual(TEXT("The unchanged item is not dirtied"), ItemList.Items[ItemList.ItemToIndexMapping.FindRef(Unlimited)].ReplicationKey, UnlimitedKey);
+
+	const int32 ChangedKey = ItemList.Items[ItemList.ItemToIndexMapping.FindRef(Stacked)].ReplicationKey;
+	ItemList.UpdateItem(Stacked, 0);
+	TestEqual(TEXT("A zero change dirties nothing"), ItemList.Items[ItemList.ItemToIndexMapping.FindRef(Stacked)].ReplicationKey, ChangedKey);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
+
+/**
+Business Source License 1.1
+
+Parameters
+
+Licensor:             Ario Amin (@ Permafrost Development)
+Licensed Work:        RTSOpen (Source available on github)
+                      The Licensed Work is (c) 2024 Ario Amin (@ Permafrost Development)
+Additional Use Grant: You may make free use of the Licensed Work in a commercial product or service provided these three additional conditions as met; 
+                      1. Must give attributions to the original author of the Licensed Work, in 'Credits' if that is applicable.
+                      2. The Licensed Work must be Compiled before being redistributed.
+                      3. The Licensed Work Source may be linked but may not be packaged into the product or service being sold
+                      4. Must not be resold or repackaged or redistributed as another product, is only allowed to be used within a commercial or non-commercial game project.
+                      5. Teams with yearly budgets larger than 100000 USD must contact the owner for a custom license or buy the framework from a marketplace it has been made available on.
+
+                      "Credits" indicate a scrolling screen with attributions. This is usually in a products end-state
+
+                      "Package" means the collection of files distributed by the Licensor, and derivatives of that collection
+                      and/or of those files..   
+
+                      "Source" form means the source code, documentation source, and configuration files for the Package, usually in human-readable format.
+
+                      "Compiled" form means the compiled bytecode, object code, binary, or any other
+                      form resulting from mechanical transformation or translation of the Source form.
+
+Change Date:          2028-04-17
+
+Change License:       Apache License, Version 2.0
+
+For information about alternative licensing arrangements for the Software,
+please visit: https://permadev.se/
+
+Notice
+
+The Business Source License (this document, or the “License”) is not an Open
+Source license. However, the Licensed Work will eventually be made available
+under an Open Source License, as stated in this License.
+
+License text copyright (c) 2017 MariaDB Corporation Ab, All Rights Reserved.
+“Business Source License” is a trademark of MariaDB Corporation Ab.
+
+-----------------------------------------------------------------------------
+
+Business Source License 1.1
+
+Terms
+
+The Licensor hereby grants you the right to copy, modify, create derivative
+works, redistribute, and make non-production use of the Licensed Work. The
+Licensor may make an Additional Use Grant, above, permitting limited
+production use.
+
+Effective on the Change Date, or the fourth anniversary of the first publicly
+available distribution of a specific version of the Licensed Work under this
+License, whichever comes first, the Licensor hereby grants you rights under
+the terms of the Change License, and the rights granted in the paragraph
+above terminate.
+
+If your use of the Licensed Work does not comply with the requirements
+currently in effect as described in this License, you must purchase a
+commercial license from the Licensor, its affiliated entities, or authorized
+resellers, or you must refrain from using the Licensed Work.
+
+All copies of the original and modified Licensed Work, and derivative works
+of the Licensed Work, are subject to this License. This License applies
+separately for each version of the Licensed Work and the Change Date may vary
+for each version of the Licensed Work released by Licensor.
+
+You must conspicuously display this License on each original or modified copy
+of the Licensed Work. If you receive the Licensed Work in original or
+modified form from a third party, the terms and conditions set forth in this
+License apply to your use of that work.
+
+Any use of the Licensed Work in violation of this License will automatically
+terminate your rights under this License for the current and all other
+versions of the Licensed Work.
+
+This License does not grant you any right in any trademark or logo of
+Licensor or its affiliates (provided that you may use a trademark or logo of
+Licensor as expressly required by this License).
+
+TO THE EXTENT PERMITTED BY APPLICABLE LAW, THE LICENSED WORK IS PROVIDED ON
+AN “AS IS” BASIS. LICENSOR HEREBY DISCLAIMS ALL WARRANTIES AND CONDITIONS,
+EXPRESS OR IMPLIED, INCLUDING (WITHOUT LIMITATION) WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT, AND
+TITLE.
+
+MariaDB hereby grants you permission to use this License’s text to license
+your works, and to refer to it using the trademark “Business Source License”,
+as long as you comply with the Covenants of Licensor below.
+
+Covenants of Licensor
+
+In consideration of the right to use this License’s text and the “Business
+Source License” name and trademark, Licensor covenants to MariaDB, and to all
+other recipients of the licensed work to be provided by Licensor:
+
+1. To specify as the Change License the GPL Version 2.0 or any later version,
+   or a license that is compatible with GPL Version 2.0 or a later version,
+   where “compatible” means that software provided under the Change License can
+   be included in a program with software provided under GPL Version 2.0 or a
+   later version. Licensor may specify additional Change Licenses without
+   limitation.
+
+2. To either: (a) specify an additional grant of rights to use that does not
+   impose any additional restriction on the right granted in this License, as
+   the Additional Use Grant; or (b) insert the text “None”.
+
+3. To specify a Change Date.
+
+4. Not to modify this License in any other way.
+ **/
@@ -57,10 +57,11 @@ public:
 	bool IsAtLastAvailableStack() const;
 	
 	/** @brief Checks if can afford to use the requested items */
-	bool CanAfford(const TMap<FGameplayTag, int32> RequestedItems);
+	bool CanAfford(const TMap<FGameplayTag, int32>& RequestedItems) const;
+
+	/** @brief Checks if can afford to use the requested items, CountMultiplier times over */
+	bool CanAfford(const TMap<FGameplayTag, int32>& RequestedItems, int32 CountMultiplier) const;
 
-	/** @brief Checks if can afford to use the requested items */
-	bool CanAfford(const TMap<FGameplayTag, int32> RequestedItems, int32 CountMultiplier);
 	
 
 public:
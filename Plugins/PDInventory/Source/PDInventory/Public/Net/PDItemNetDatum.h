@@ -45,14 +45,15 @@ struct FPDLightItemDatum
 
 /** 
  * @brief Inventory system network datum struct.
- * - Contains a Tag ID, Total Item Count, and index for the last edited stack, and a map of all actual stacks.
+ * - Contains a Tag ID and Total Item Count. Stacks are packed, every stack but the last is full,
+ *   so they are derived from the total count and the items stack limit instead of being stored per stack.
  * - Also contains a function to export the 'FPDItemNetDatum' as a 'FPDLightItemDatum'
  * 
- * Datum size: 112 bytes
+ * Replicated payload: 16 bytes (Tag + TotalItemCount), the stack limit and last edited stack are resolved locally
  * Extreme case, 1000 players + 1000 NPCs, all with with inventory
  * Average TX-rate: 4 updates per second per inventory
- * Average Total TX per second; (448.000 * 2) 896,000 bytes per second, or ~900 kilobytes = inventory data per connection
- * For any given player this will consist of about 112 bytes out per second, and incoming packets consist of 99% of the load
+ * Average Total TX per second; (64.000 * 2) 128,000 bytes per second, or ~128 kilobytes = inventory data per connection
+ * Only items that have actually changed are marked dirty, so untouched items are not re-sent
  */
 USTRUCT(BlueprintType)
 struct FPDItemNetDatum : public FFastArraySerializerItem 
@@ -61,7 +62,7 @@ struct FPDItemNetDatum : public FFastArraySerializerItem
 
 	// ConstructInPlace
 	FPDItemNetDatum(){};
-	FPDItemNetDatum(const FGameplayTag& InItemTag, int32 StackIndex, int32 InCount);
+	FPDItemNetDatum(const FGameplayTag& InItemTag, int32 InCount, int32 InStackLimit);
 	FPDItemNetDatum(const FGameplayTag& InItemTag, int32 InCount);
 
 	/** @brief This is called on the client when they receive a replicated update.
@@ -78,18 +79,26 @@ struct FPDItemNetDatum : public FFastArraySerializerItem
 	UPROPERTY(BlueprintReadWrite)
 	FGameplayTag ItemTag{};
 
-	/** @brief the last edited stack.*/
-	UPROPERTY(BlueprintReadWrite)
+	/** @brief the last edited stack. Stacks are packed so this is always the last (possibly partial) stack, derived locally */
+	UPROPERTY(BlueprintReadWrite, NotReplicated)
 	int32 LastEditedStackIndex = INDEX_NONE;
 	
 	/** @brief The total item count this entity carries */
 	UPROPERTY(BlueprintReadWrite)
 	int32 TotalItemCount = INDEX_NONE;
-	
-	/** @brief Map of the players actual stacks
-	 * @todo Might need to replace this, t-map is too weighty, an array could do with some index caching */
-	UPROPERTY(BlueprintReadWrite)
-	TMap<int32 /* StackIndex */, int32 /* ItemCount */> Stacks{};
+
+	/** @brief Cached stack limit for this item, resolved from the inventory subsystem. INDEX_NONE or below means it has not been resolved yet */
+	UPROPERTY(BlueprintReadWrite, NotReplicated)
+	int32 StackLimit = INDEX_NONE;
+
+	/** @brief Returns the cached stack limit, or resolves it from the inventory subsystem if it has not been cached. 0 means unlimited */
+	int32 ResolveStackLimit() const;
+	/** @brief Resolves and caches 'StackLimit' and refreshes 'LastEditedStackIndex' from the current total count */
+	void RefreshDerivedStackData();
+	/** @brief Number of stacks the total count occupies */
+	int32 GetStackCount() const;
+	/** @brief Item count in the stack at 'StackIdx', 0 if the stack does not exist */
+	int32 GetStackItemCount(int32 StackIdx) const;
 
 	/** @brief Export data in the form of a 'FPDLightItemDatum' */
 	FPDLightItemDatum ExportLight() const { return FPDLightItemDatum{ItemTag, TotalItemCount}; }
@@ -115,15 +124,20 @@ struct FPDItemList : public FFastArraySerializer
 
 	/** @brief Only calls into 'FFastArraySerializer::NetSerialize' for now, reserved for later use */
 	bool NetSerialize(FNetDeltaSerializeInfo& DeltaParams);
+	/** @brief Called on the client after a replicated update has been applied. Rebuilds 'ItemToIndexMapping', as it is not replicated and removals shift indices */
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
+	/** @brief Rebuilds 'ItemToIndexMapping' from the 'Items' array */
+	void RebuildItemToIndexMapping();
 	
 	/** @brief Clears all items and stacks of the given type from the 'Items' array*/
 	bool RemoveAllItemsOfType(FGameplayTag& ItemToRemove);
-	/** @brief Removes a stack of the given type alongside the stacks given index from the 'Items' array*/
+	/** @brief Removes the items held in the stack at the given index, the remaining stacks are re-packed */
 	bool RemoveStack(FGameplayTag& ItemToRemove, int32 StackIdx);
 
 	/** @brief Adds an item of given type and amount to the 'Items' array*/
 	bool UpdateItem(FGameplayTag& ItemToUpdate, int32 AmountToAdd);
-	/** @brief Adds an item of given type and amount to the 'Items' array at the specified index */
+	/** @brief Adds an item of given type and amount to the 'Items' array at the specified index
+	 * @note Stacks are packed, additions fill the last stack first and removals drain it first, so 'StackIdx' is only kept for API compatibility */
 	bool UpdateItemAtStackIdx(FGameplayTag& ItemToUpdate, int32 StackIdx, int32 AmountToAdd);
 
 	/** @brief Return the inventory that owns this fastarray */
@@ -132,10 +146,12 @@ struct FPDItemList : public FFastArraySerializer
 	FORCEINLINE void SetOwningInventory(UPDInventoryComponent* InInventory) { OwningInventory = InInventory; }
 
 private:
-	/** @brief Internal private function that performs removal of an item */
+	/** @brief Internal private function that performs removal of an item. AmountToAdd is left with the amount that could not be removed */
 	bool _Remove(FGameplayTag& ItemToUpdate, int32& AmountToAdd);
-	/** @brief Internal private function that performs addition of an item */
+	/** @brief Internal private function that performs addition of an item. AmountToAdd is left with the amount that did not fit */
 	bool _Add(FGameplayTag& ItemToUpdate, int32 StackIdx, int32& AmountToAdd);
+	/** @brief Refreshes derived stack data, tracks the owners stack count and marks the item dirty for replication */
+	void _CommitItemChange(FPDItemNetDatum& Item, int32 OldStackCount);
 
 public:
 	/** @brief The underlying TArray data which the fastarray class is operating on */
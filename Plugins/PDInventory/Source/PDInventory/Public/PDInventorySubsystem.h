@@ -43,6 +43,23 @@ public:
 		bool bIsRecurringCosts,
 		const int32 Stage);
 
+	/** @brief How many times over the input object can afford the item in question, resolving items via 'ItemToIndexMapping'.
+	 *  @return 0 whenever 'CanInventoryAffordItem' would return false, i.e. no costs, a missing item or a missing recurring stage. MAX_int32 if every cost is free */
+	static int32 GetMaxAffordableCount(
+		const FPDItemList& CurrentItemData,
+		const FPDItemDefaultDatum& DefaultItemToConsider,
+		bool bIsCraftingCosts,
+		bool bIsRecurringCosts,
+		const int32 Stage);
+	/** @brief How many times over the input object can afford the item in question.
+	 *  @return 0 whenever 'CanInventoryAffordItem' would return false, i.e. no costs, a missing item or a missing recurring stage. MAX_int32 if every cost is free */
+	static int32 GetMaxAffordableCount(
+		const TMap<FGameplayTag, FPDLightItemDatum>& CurrentItemData,
+		const FPDItemDefaultDatum& DefaultItemToConsider,
+		bool bIsCraftingCosts,
+		bool bIsRecurringCosts,
+		const int32 Stage);
+
 	/** @brief Returns the default datum for a given rowname, if said row has been mapped */
 	const FPDItemDefaultDatum* GetDefaultDatum(const FName& RowName);
 	/** @brief Returns the default datum for a given item tag, if said entry has been mapped */
@@ -249,6 +249,110 @@ inline uint32 GetTypeHash(const FPDStatMapping& StatMapping)
 	return Hash;
 }
 
+/** @brief A single requested stat change, used to batch many level/experience changes into one 'UPDStatHandler::ApplyProgressionBatch' call */
+USTRUCT(BlueprintType)
+struct PDBASEPROGRESSION_API FPDStatProgressionDelta
+{
+	GENERATED_BODY()
+
+	/** @brief Tag of the stat to modify */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FGameplayTag StatTag;
+
+	/** @brief Experience to add, any level-ups this results in are resolved in the same batch */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 ExperienceDelta = 0;
+
+	/** @brief Levels to add, applied before the experience delta */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 LevelDelta = 0;
+};
+
+/** @brief Baked progression lookups for a single stat, built once by the stat subsystem.
+ * @details Samples the experience curve and prefix-sums the token curves for levels [0, MaxLevel],
+ * so a multi-level change resolves with a search and a prefix-sum difference instead of evaluating the curves once per level.
+ * @note Levels past the baked range fall back to evaluating the curves directly */
+struct PDBASEPROGRESSION_API FPDStatProgressionTable
+{
+	/** @brief Upper bound on baked levels, guards against huge tables from misconfigured 'MaxLevel' values */
+	static constexpr int32 MaxBakedLevels = 4096;
+	
+	/** @brief Samples 'StatRow's experience and token curves */
+	void Bake(const FPDStatsRow& StatRow);
+
+	/** @brief Returns the level reached from 'CurrentLevel' when holding 'TotalExperience'.
+	 * @note Keeps the per-call rule of 'IncreaseStatExperience': each level we have met the threshold of grants one more level */
+	int32 ResolveLevelFromExperience(const FPDStatsRow& StatRow, int32 CurrentLevel, int32 TotalExperience) const;
+
+	/** @brief Returns the tokens of 'TokenCategory' granted by levelling from 'FromLevel' to 'ToLevel', 0 if 'ToLevel' is not above 'FromLevel' */
+	int32 GetTokensGrantedBetween(const FPDStatsRow& StatRow, const FGameplayTag& TokenCategory, int32 FromLevel, int32 ToLevel) const;
+
+	/** @brief Experience needed to leave each level, indexed by level */
+	TArray<float> ExperienceThresholds;
+	/** @brief True if 'ExperienceThresholds' never decreases, allows binary searching it */
+	bool bMonotonicThresholds = true;
+	
+	/** @brief Per token category, Entry 'L' holds the total tokens granted for levels [0, L) */
+	TMap<FGameplayTag, TArray<int32>> TokenPrefixSums;
+};
+
+/** @brief A single skill compiled from the skill-tree tables, dense-indexed in 'FPDCompiledSkillGraph::Nodes' */
+struct PDBASEPROGRESSION_API FPDCompiledSkillNode
+{
+	/** @brief Tag of the skills stat */
+	FGameplayTag SkillTag;
+	/** @brief Tag of the tree that owns this skill */
+	FGameplayTag TreeTag;
+	/** @brief Index into 'FPDCompiledSkillGraph::TokenCategories' */
+	int32 TokenCategoryIndex = INDEX_NONE;
+	/** @brief Tokens of the category that it costs to unlock this skill */
+	int32 TokenCost = 0;
+	/** @brief Tokens that need to have been spent on the category before this skill may be unlocked */
+	int32 MinTokenLevel = 0;
+};
+
+/** @brief All skill-trees compiled into a flat graph with dense skill indices.
+ * @details Built once at load by the stat subsystem, so unlock/lock checks are bitset operations against a handlers unlocked-skills bitset
+ * instead of resolving table-row handles by walking the trees. Cycles and dangling row references are reported in 'CompileErrors' */
+struct PDBASEPROGRESSION_API FPDCompiledSkillGraph
+{
+	/** @brief Clears and compiles the given trees */
+	void Compile(const TArray<const FPDSkillTree*>& Trees);
+	/** @brief Clears all compiled data */
+	void Reset();
+
+	/** @brief Returns the dense index of the skill, or INDEX_NONE. Top-level skills also resolve from their category key */
+	int32 FindSkillIndex(const FGameplayTag& SkillTag) const;
+	/** @brief Number of compiled skills, the size of any bitset indexed by skill */
+	int32 NumSkills() const { return Nodes.Num(); }
+	/** @brief Returns the tag of the token category this skill costs */
+	const FGameplayTag& GetTokenCategory(int32 SkillIdx) const;
+
+	/** @brief True if every skill directly preceding 'SkillIdx' is set in 'UnlockedSkills' */
+	bool HasUnlockedPrerequisites(int32 SkillIdx, const TBitArray<>& UnlockedSkills) const;
+	/** @brief True if any skill directly following 'SkillIdx' is set in 'UnlockedSkills' */
+	bool HasUnlockedDependents(int32 SkillIdx, const TBitArray<>& UnlockedSkills) const;
+
+	/** @brief The compiled skills */
+	TArray<FPDCompiledSkillNode> Nodes;
+	/** @brief Skill tags mapped to their dense index */
+	TMap<FGameplayTag, int32> SkillIndices;
+	/** @brief Per skill, the skills that need to be unlocked before it. Direct parents only, the invariant holds transitively */
+	TArray<TBitArray<>> Prerequisites;
+	/** @brief Per skill, the skills that directly require it */
+	TArray<TBitArray<>> Dependents;
+	/** @brief Interned token categories, indexed by 'FPDCompiledSkillNode::TokenCategoryIndex' */
+	TArray<FGameplayTag> TokenCategories;
+	/** @brief Problems found while compiling, cycles and dangling references */
+	TArray<FString> CompileErrors;
+
+private:
+	/** @brief Compiles a branch and recurses into its paths. Returns the branches skill index, or INDEX_NONE if it could not be compiled */
+	int32 CompileBranch(const FPDSkillTree& Tree, const FPDSkillBranch& Branch, const FGameplayTag& CategoryTag, int32 ParentIdx, TArray<int32>& SkillPath, TBitArray<>& ExpandedSkills, TArray<TPair<int32, int32>>& Edges);
+	/** @brief Returns the index of the token category, interning it if needed */
+	int32 InternTokenCategory(const FGameplayTag& TokenCategory);
+};
+
 /** @brief Progression class definitions: Default stats/effects, granted/available skill-trees and a self-referencing class-tag
  * @note think: 'bard', 'warlock', etc  */
 USTRUCT(Blueprintable)
@@ -16,6 +16,7 @@
 class FPaintArgs;
 class FSlateWindowElementList;
 struct FSlateBrush;
+class UPDStatHandler;
 
 /** @brief Unused. Reserved  */
 namespace EPDStatListSections
@@ -50,6 +51,18 @@ public:
 		FGameplayTag StatTag,
 		double InTotalValue,
 		bool IncludeParent = true);
+
+	/** @brief Returns the entry at 'EntryIdx' in 'DataView', reusing the already allocated shared entry if there is one.
+	 * @note Appends a new entry when 'EntryIdx' is past the end, so views can be refilled in-place without reallocating every element */
+	template<typename TDataViewElem>
+	static TDataViewElem& AcquireSharedViewEntry(TArray<TSharedPtr<TDataViewElem>>& DataView, int32 EntryIdx)
+	{
+		if (DataView.IsValidIndex(EntryIdx) == false) { DataView.SetNum(EntryIdx + 1, false); }
+
+		TSharedPtr<TDataViewElem>& Entry = DataView[EntryIdx];
+		if (Entry.IsValid() == false) { Entry = MakeShared<TDataViewElem>(); }
+		return *Entry.Get();
+	}
 	
 };
 
@@ -215,6 +228,11 @@ public:
 	/** @brief Flag that we use to tell widgets that implements us if we are in design-time or not */
 	bool bIsDesignTime = true;
 
+	/** @brief The stat handler we are currently listening to for per-item updates */
+	TWeakObjectPtr<UPDStatHandler> BoundStatHandler;
+	/** @brief Handle to our 'OnStatDatumUpdated' binding on 'BoundStatHandler' */
+	FDelegateHandle StatUpdatedHandle;
+
 private:
 	/** @brief The settings for our widget */
 	FPDWidgetBaseSettings WidgetSettings;
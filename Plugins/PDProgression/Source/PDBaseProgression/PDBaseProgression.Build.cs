@@ -30,6 +30,7 @@ public class PDBaseProgression : ModuleRules
 				"NetCore",
 				"GameplayTags",
 				"UMG",
+				"PDSharedUI",
 			}
 		);
 	}
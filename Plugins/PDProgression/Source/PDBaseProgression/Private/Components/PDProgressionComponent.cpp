@@ -9,6 +9,13 @@
 #include "Subsystems/PDProgressionSubsystem.h"
 
 
+void UPDStatHandler::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	StatList.OwningObject = this;
+}
+
 void UPDStatHandler::BeginPlay()
 {
 	Super::BeginPlay();
@@ -16,6 +23,37 @@ void UPDStatHandler::BeginPlay()
 	UPDStatSubsystem::Get()->StatHandlers.Emplace(OwnerID, this);
 }
 
+void UPDStatHandler::OnDatumUpdated(const FPDStatNetDatum* Datum, EPDStatNetOperation Operation)
+{
+	const int32 StatIndex = static_cast<int32>(Datum - StatList.Items.GetData());
+	if (StatList.Items.IsValidIndex(StatIndex) == false) { return; }
+
+	if (Operation != EPDStatNetOperation::CHANGE && HasCompleteAuthority() == false) { bLocalStatMappingsDirty = true; }
+	UpdateUnlockedSkill(*Datum, Operation == EPDStatNetOperation::REMOVE);
+	
+	OnStatDatumUpdated.Broadcast(StatIndex, *Datum, Operation);
+}
+
+void UPDStatHandler::PostStatListReceived()
+{
+	if (bLocalStatMappingsDirty == false) { return; }
+	
+	RebuildLocalStatMappings();
+	bLocalStatMappingsDirty = false;
+}
+
+void UPDStatHandler::RebuildLocalStatMappings()
+{
+	LocalStatMappings.Reset();
+	for (int32 StatIdx = 0; StatIdx < StatList.Items.Num(); StatIdx++)
+	{
+		FPDStatMapping ConstructedStatMapping;
+		ConstructedStatMapping.Index = StatIdx;
+		ConstructedStatMapping.Tag = StatList.Items[StatIdx].ProgressionTag;
+		LocalStatMappings.Emplace(ConstructedStatMapping);
+	}
+}
+
 double UPDStatHandler::GetStatValue(const FGameplayTag& StatTag)
 {
 	if (LocalStatMappings.Contains(StatTag) == false) { return 0.0; }
@@ -29,83 +67,107 @@ double UPDStatHandler::GetStatValue(const FGameplayTag& StatTag)
 void UPDStatHandler::ModifySkill(const FGameplayTag& SkillTag, const bool bUnlock)
 {
 	static UPDStatSubsystem* StatSubsystem = UPDStatSubsystem::Get();
-	FPDSkillTree* Tree = StatSubsystem->GetTreeTypeDataPtrFromSkill(SkillTag);
-	if (Tree == nullptr)
+	const FPDCompiledSkillGraph& SkillGraph = StatSubsystem->CompiledSkillGraph;
+	
+	const int32 SkillIdx = SkillGraph.FindSkillIndex(SkillTag);
+	if (SkillIdx == INDEX_NONE)
 	{
 		UE_LOG(PDLog_Progression, Error,
 			TEXT("UPDStatHandler::ModifySkill "
 				"-- Failed finding a tree that matched with skill(%s) "), *SkillTag.GetTagName().ToString());
 		return;
 	}
+	
+	// Bits are kept current per changed stat in 'OnDatumUpdated', only a missing or out of date bit array needs the full sync
+	if (UnlockedSkills.Num() != SkillGraph.NumSkills()) { SyncUnlockedSkills(); }
+	if (UnlockedSkills[SkillIdx] == bUnlock) { return; } // Already in the requested state
 
-	const auto ProcessFoundSkill =
-		[&](const FGameplayTag& InSkillTag)
-		{
-			const FPDSkillBranch& SkillBranch = Tree->Skills.FindRef(InSkillTag);
-			
-			const int32 MinimumTokensSpent = SkillBranch.TokenRules.MinTokenLevel;
-			const int32 SkillCost = SkillBranch.TokenRules.TokenValue;
+	const FPDCompiledSkillNode& Skill = SkillGraph.Nodes[SkillIdx];
+	if (bUnlock)
+	{
+		if (SkillGraph.HasUnlockedPrerequisites(SkillIdx, UnlockedSkills) == false) { return; }
 
-			const FGameplayTag& TokenCategory = SkillBranch.TokenRules.TokenType;
-			FPDSkillTokenBase* CategoryTokenValues = Tokens.FindByKey(TokenCategory);
-			FPDSkillTokenBase* TotalTokensSpentOnCategory = TokensSpentTotal.FindByKey(TokenCategory);
+		const FGameplayTag& TokenCategory = SkillGraph.GetTokenCategory(SkillIdx);
+		FPDSkillTokenBase* CategoryTokenValues = Tokens.FindByKey(TokenCategory);
+		FPDSkillTokenBase* TotalTokensSpentOnCategory = TokensSpentTotal.FindByKey(TokenCategory);
 		
-			const bool bMetCategoryProgressionRequirements = TotalTokensSpentOnCategory->TokenValue >= MinimumTokensSpent;
-			const bool bCanAffordSkill = CategoryTokenValues->TokenValue >= SkillCost;
+		const bool bMetCategoryProgressionRequirements = (TotalTokensSpentOnCategory != nullptr ? TotalTokensSpentOnCategory->TokenValue : 0) >= Skill.MinTokenLevel;
+		const bool bCanAffordSkill = (CategoryTokenValues != nullptr ? CategoryTokenValues->TokenValue : 0) >= Skill.TokenCost;
+		if (bCanAffordSkill == false || bMetCategoryProgressionRequirements == false) { return; }
 
-			if (bCanAffordSkill && bMetCategoryProgressionRequirements)
+		if (Skill.TokenCost != 0)
+		{
+			MARK_PROPERTY_DIRTY_FROM_NAME(UPDStatHandler, Tokens, this)
+			MARK_PROPERTY_DIRTY_FROM_NAME(UPDStatHandler, TokensSpentTotal, this)
+			if (CategoryTokenValues != nullptr) { CategoryTokenValues->TokenValue -= Skill.TokenCost; } // Remove from user
+			
+			if (TotalTokensSpentOnCategory == nullptr)
 			{
-				// actually unlock skill here, set it's stat level to 1, should have been 0 before
-				StatList.AddStat(InSkillTag, 0, bUnlock);
-
-				CategoryTokenValues->TokenValue -=  (bUnlock)* SkillCost;      // Remove from user
-				TotalTokensSpentOnCategory->TokenValue += (bUnlock)*SkillCost; // Add to tally
+				FPDSkillTokenBase TokenBase = {TokenCategory, 0};
+				TotalTokensSpentOnCategory = &TokensSpentTotal.Add_GetRef(TokenBase);
 			}
-		};
-	
-
-	// First check if it is in the top-level
-	if (Tree->Skills.Contains(SkillTag))
+			TotalTokensSpentOnCategory->TokenValue += Skill.TokenCost; // Add to tally
+		}
+	}
+	else if (SkillGraph.HasUnlockedDependents(SkillIdx, UnlockedSkills))
 	{
-		MARK_PROPERTY_DIRTY_FROM_NAME(UPDStatHandler, StatList, this);		
-		ProcessFoundSkill(SkillTag);
-		return;
+		return; // Would orphan skills that required this one
 	}
-	
-	static FPDSkillBranch DummyBranch;
-	
-	TFunction<void(const TArray<FDataTableRowHandle>&)> BranchMapper;
 
-	// @todo slow recursion, re-do
-	// TArray<FPDSkillBranch> BranchPaths. Recursively map all skills in a tree back to the tree, for fast access downstream
-	BranchMapper= [&, SkillTag, TreeRowTag = Tree->Tag](const TArray<FDataTableRowHandle>& BranchPaths)
+	UnlockedSkills[SkillIdx] = bUnlock;
+	SetSkillStatLevel(Skill.SkillTag, bUnlock ? 1 : 0);
+}
+
+void UPDStatHandler::SyncUnlockedSkills()
+{
+	static UPDStatSubsystem* StatSubsystem = UPDStatSubsystem::Get();
+	const FPDCompiledSkillGraph& SkillGraph = StatSubsystem->CompiledSkillGraph;
+
+	UnlockedSkills.Init(false, SkillGraph.NumSkills());
+	for (const FPDStatMapping& StatMapping : LocalStatMappings)
 	{
-		for (const FDataTableRowHandle& SkillBranchHandle : BranchPaths)
-		{
-			FPDSkillBranch& SkillBranch = SkillBranchHandle.IsNull() ? DummyBranch : *SkillBranchHandle.GetRow<FPDSkillBranch>("");
-			
-			const FPDStatsRow* InnerBranchStat = SkillBranch.BranchRootSkill.GetRow<FPDStatsRow>("");
-			if (InnerBranchStat == nullptr) { continue; }
+		const int32 SkillIdx = SkillGraph.FindSkillIndex(StatMapping.Tag);
+		if (SkillIdx == INDEX_NONE || StatList.Items.IsValidIndex(StatMapping.Index) == false) { continue; }
+		
+		UnlockedSkills[SkillIdx] = StatList.Items[StatMapping.Index].CurrentLevel > 0;
+	}
+}
 
-			// found the skill
-			if (SkillTag == InnerBranchStat->ProgressionTag)
-			{
-				MARK_PROPERTY_DIRTY_FROM_NAME(UPDStatHandler, StatList, this);		
-				ProcessFoundSkill(SkillTag);
-				
-				break;
-			}
-			
-			BranchMapper(SkillBranch.BranchPaths);
-		}
-	};
+void UPDStatHandler::UpdateUnlockedSkill(const FPDStatNetDatum& Datum, const bool bRemoved)
+{
+	static UPDStatSubsystem* StatSubsystem = UPDStatSubsystem::Get();
+	const FPDCompiledSkillGraph& SkillGraph = StatSubsystem->CompiledSkillGraph;
 	
-	// Otherwise, Find the skill inside the tree
-	for (const TTuple<FGameplayTag, FPDSkillBranch>& SkillBranchTuple : Tree->Skills)
+	// Not synced yet, the next 'ModifySkill' does a full sync anyway
+	if (UnlockedSkills.Num() != SkillGraph.NumSkills()) { return; }
+
+	const int32 SkillIdx = SkillGraph.FindSkillIndex(Datum.ProgressionTag);
+	if (SkillIdx == INDEX_NONE) { return; }
+
+	UnlockedSkills[SkillIdx] = bRemoved == false && Datum.CurrentLevel > 0;
+}
+
+void UPDStatHandler::SetSkillStatLevel(const FGameplayTag& SkillTag, int32 Level)
+{
+	MARK_PROPERTY_DIRTY_FROM_NAME(UPDStatHandler, StatList, this);
+
+	const FPDStatMapping* StatMapping = LocalStatMappings.Find(SkillTag);
+	if (StatMapping == nullptr)
 	{
-		// Root
-		BranchMapper(SkillBranchTuple.Value.BranchPaths);
-	}		
+		StatList.AddStat(SkillTag, 0, Level);
+
+		// Maps the index to the tag
+		FPDStatMapping ConstructedStatMapping;
+		ConstructedStatMapping.Index = StatList.Items.Num() - 1;
+		ConstructedStatMapping.Tag = SkillTag;		
+		LocalStatMappings.Emplace(ConstructedStatMapping);
+		return;
+	}
+
+	FPDStatNetDatum& SkillNetDatum = StatList.Items[StatMapping->Index];
+	SkillNetDatum.CurrentLevel = Level;
+	SkillNetDatum.CurrentStatValue = UPDStatSubsystem::Get()->GetStatTypeData(SkillTag).Representation.ResolveValue(Level);
+	StatList.MarkStatDirty(SkillNetDatum);
 }
 
 void UPDStatHandler::AttemptUnlockSkill_Implementation(const FGameplayTag& SkillTag)
@@ -147,10 +209,19 @@ bool UPDStatHandler::HasCompleteAuthority() const
 
 void UPDStatHandler::GrantTokens(const FGameplayTag& StatTag, int32 LevelDelta, const int32 CurrentLevel)
 {
+	GrantTokensBetweenLevels(StatTag, CurrentLevel - LevelDelta, CurrentLevel);
+}
+
+void UPDStatHandler::GrantTokensBetweenLevels(const FGameplayTag& StatTag, int32 OldLevel, int32 NewLevel)
+{
+	if (NewLevel <= OldLevel) { return; }
+	
 	static const UPDStatSubsystem* StatSubsystem = UPDStatSubsystem::Get();
+	const FPDStatsRow& StatDefaultValue = StatSubsystem->GetStatTypeData(StatTag);
+	const FPDStatProgressionTable* ProgressionTable = StatSubsystem->GetStatProgressionTable(StatTag);
+	static const FPDStatProgressionTable EmptyProgressionTable;
 	
 	MARK_PROPERTY_DIRTY_FROM_NAME(UPDStatHandler, Tokens, this)
-	const FPDStatsRow& StatDefaultValue = StatSubsystem->GetStatTypeData(StatTag);
 	for (const TTuple<FGameplayTag, UCurveFloat*>& TokenCategoryCurveTuple
 	     : StatDefaultValue.TokensToGrantPerLevel)
 	{
@@ -162,14 +233,9 @@ void UPDStatHandler::GrantTokens(const FGameplayTag& StatTag, int32 LevelDelta,
 			continue;
 		}
 
-		int32 AllNewlyGrantedCategoryTokens = 0;
-		int32 LevelDeltaCopy = LevelDelta;
-
-		for (; LevelDeltaCopy > 0; LevelDeltaCopy--)
-		{
-			const float TokensAsFloats = TokenCategoryCurveTuple.Value->GetFloatValue(CurrentLevel - LevelDeltaCopy);
-			AllNewlyGrantedCategoryTokens += TokensAsFloats + 0.5f;
-		}
+		const int32 AllNewlyGrantedCategoryTokens =
+			(ProgressionTable != nullptr ? *ProgressionTable : EmptyProgressionTable)
+				.GetTokensGrantedBetween(StatDefaultValue, TokenCategoryCurveTuple.Key, OldLevel, NewLevel);
 
 		FPDSkillTokenBase* CategoryTokenValues = Tokens.FindByKey(TokenCategoryCurveTuple.Key);
 		if (CategoryTokenValues == nullptr)
@@ -185,106 +251,133 @@ void UPDStatHandler::GrantTokens(const FGameplayTag& StatTag, int32 LevelDelta,
 
 void UPDStatHandler::IncreaseStatLevel_Implementation(const FGameplayTag& StatTag, int32 LevelDelta)
 {
-	if (LocalStatMappings.Contains(StatTag) == false)
-	{
-		// @todo Set up developer settings to allow this to fail (as happens now) or to just add the missing stat upon this call
-		UE_LOG(PDLog_Progression, Warning,
-			TEXT("UPDStatHandler::IncreaseStatLevel_Implementation "
-			"-- Owners statlist did not contain the requested stat(%s)"
-			" @todo Set up developer settings to allow this to fail (as happens now) or to just add the missing stat upon this call "), *StatTag.GetTagName().ToString())
-		return;
-	}
-	if (HasCompleteAuthority() == false) { return; }
-
-
-	// @DONE Map all cross-behaviours in the subsystems latent initialization
-	// @DONE cont.  And make use of it to resolve crossbehaviours
+	FPDStatProgressionDelta ProgressionDelta;
+	ProgressionDelta.StatTag = StatTag;
+	ProgressionDelta.LevelDelta = LevelDelta;
+	ApplyProgressionBatch({ProgressionDelta});
+}
 
-	const UPDStatSubsystem* StatSubsystem = UPDStatSubsystem::Get();
-	const int32 StatIndex = LocalStatMappings.Find(StatTag)->Index;
-	FPDStatNetDatum& StatNetDatum = StatList.Items[StatIndex];
+void UPDStatHandler::IncreaseStatExperience_Implementation(const FGameplayTag& StatTag, int32 ExperienceDelta)
+{
+	FPDStatProgressionDelta ProgressionDelta;
+	ProgressionDelta.StatTag = StatTag;
+	ProgressionDelta.ExperienceDelta = ExperienceDelta;
+	ApplyProgressionBatch({ProgressionDelta});
+}
 
-	MARK_PROPERTY_DIRTY_FROM_NAME(UPDStatHandler, StatList, this)
-	const int32 CurrentLevel = (StatNetDatum.CurrentLevel += LevelDelta);
+void UPDStatHandler::ApplyProgressionBatch(const TArray<FPDStatProgressionDelta>& ProgressionDeltas)
+{
+	if (HasCompleteAuthority() == false) { return; }
 
-	StatNetDatum.CurrentStatValue =
-	UPDStatSubsystem::Get()->
-		GetStatTypeData(StatTag).Representation.ResolveValue(CurrentLevel);
+	static const UPDStatSubsystem* StatSubsystem = UPDStatSubsystem::Get();
 
-	// Granting Tokens
-	GrantTokens(StatTag, LevelDelta, CurrentLevel);
+	// Values of every touched stat before the batch, keyed by index in 'StatList'.
+	// Collected up-front so a stat is resolved once no matter how many deltas in the batch target it
+	struct FPDPendingStatChange
+	{
+		int32 OldLevel = 0;
+		int32 OldExperience = 0;
+	};
+	TMap<int32, FPDPendingStatChange> PendingChanges;
+	PendingChanges.Reserve(ProgressionDeltas.Num());
 	
-	const TMap<FGameplayTag, TArray<FGameplayTag>>& StatCrossBehaviourMap = StatSubsystem->StatCrossBehaviourMap;
-	if (StatCrossBehaviourMap.Contains(StatTag) == false) { return; }
-
-	// The stat we just leveled up is now calling all stat that the levelled up stat is an effector to,
-	// and updates their effect on said stat
-	TArray<FGameplayTag> UpdateTargets = StatCrossBehaviourMap.FindRef(StatTag);
-	for (const FGameplayTag& Target : UpdateTargets)
+	for (const FPDStatProgressionDelta& ProgressionDelta : ProgressionDeltas)
 	{
-		const FPDStatsRow& TargetStat = StatSubsystem->GetStatTypeData(Target);
-
-		// @note The calling stat will always exist in the target stats 'RulesAffectedBy',
-		// as this is what has decided the cross behaviour was mapped in the first place
-		const FPDStatsCrossBehaviourRules& CrossBehaviourRules = TargetStat.RulesAffectedBy.FindRef(StatTag);
-		if (CrossBehaviourRules.RuleSetLevelCurveMultiplier == nullptr)
+		const FPDStatMapping* StatMapping = LocalStatMappings.Find(ProgressionDelta.StatTag);
+		if (StatMapping == nullptr)
 		{
+			// @todo Set up developer settings to allow this to fail (as happens now) or to just add the missing stat upon this call
+			UE_LOG(PDLog_Progression, Warning,
+				TEXT("UPDStatHandler::ApplyProgressionBatch "
+				"-- Owners statlist did not contain the requested stat(%s)"
+				" @todo Set up developer settings to allow this to fail (as happens now) or to just add the missing stat upon this call "), *ProgressionDelta.StatTag.GetTagName().ToString())
 			continue;
 		}
 
-		const float OldCrossBehaviourMultiplier =
-			CrossBehaviourRules.RuleSetLevelCurveMultiplier->GetFloatValue(CurrentLevel - LevelDelta);
-		const float CrossBehaviourMultiplier =
-			CrossBehaviourRules.RuleSetLevelCurveMultiplier->GetFloatValue(CurrentLevel);
-
-		const float OldCrossBehaviourResult = CrossBehaviourRules.CrossBehaviourBaseValue * OldCrossBehaviourMultiplier;
-		const float CrossBehaviourResult = CrossBehaviourRules.CrossBehaviourBaseValue * CrossBehaviourMultiplier;
+		FPDStatNetDatum& StatNetDatum = StatList.Items[StatMapping->Index];
+		if (PendingChanges.Contains(StatMapping->Index) == false)
+		{
+			PendingChanges.Emplace(StatMapping->Index, FPDPendingStatChange{StatNetDatum.CurrentLevel, StatNetDatum.CurrentExperience});
+		}
+		
+		StatNetDatum.CurrentLevel += ProgressionDelta.LevelDelta;
+		if (ProgressionDelta.ExperienceDelta == 0) { continue; }
+		
+		const FPDStatsRow& StatDefaults = StatSubsystem->GetStatTypeData(ProgressionDelta.StatTag);
+		const FPDStatProgressionTable* ProgressionTable = StatSubsystem->GetStatProgressionTable(ProgressionDelta.StatTag);
+		if (StatDefaults.ExperienceCurve == nullptr || ProgressionTable == nullptr)
+		{
+			// @todo Set up developer settings to allow this to apply some basic scaling operation if we hit this case, curves are math in the end
+			UE_LOG(PDLog_Progression, Error,
+				TEXT("UPDStatHandler::ApplyProgressionBatch "
+				"-- Ensure your stat((%s)) has an experience curve applied to it"
+				" @todo Set up developer settings to allow this to apply some basic scaling operation if we hit this case, curves are math in the end"), *ProgressionDelta.StatTag.GetTagName().ToString())
+			continue;
+		}
 
-		// Remove old result
-		StatNetDatum.CrossBehaviourValue -= OldCrossBehaviourResult; 
-		// Add New result
-		StatNetDatum.CrossBehaviourValue += CrossBehaviourResult; 
+		StatNetDatum.CurrentExperience += ProgressionDelta.ExperienceDelta;
+		StatNetDatum.CurrentLevel = ProgressionTable->ResolveLevelFromExperience(StatDefaults, StatNetDatum.CurrentLevel, StatNetDatum.CurrentExperience);
 	}
-}
+	if (PendingChanges.IsEmpty()) { return; }
 
-void UPDStatHandler::IncreaseStatExperience_Implementation(const FGameplayTag& StatTag, int32 ExperienceDelta)
-{
-	if (LocalStatMappings.Contains(StatTag) == false)
+	// Cross-behaviours only depend on the levels of the stats that affect us,
+	// so every sources contribution is accumulated per target and then applied once
+	TMap<int32, int32> CrossBehaviourDeltas;
+	for (const TTuple<int32, FPDPendingStatChange>& PendingChange : PendingChanges)
 	{
-		// @todo Set up developer settings to allow this to fail (as happens now) or to just add the missing stat upon this call
-		UE_LOG(PDLog_Progression, Warning,
-			TEXT("UPDStatHandler::IncreaseStatExperience_Implementation "
-			"-- Owners statlist did not contain the requested stat(%s)"
-			" @todo Set up developer settings to allow this to fail (as happens now) or to just add the missing stat upon this call "), *StatTag.GetTagName().ToString())
-		return;
-	}
-	if (HasCompleteAuthority() == false) { return; }
+		FPDStatNetDatum& StatNetDatum = StatList.Items[PendingChange.Key];
+		const int32 OldLevel = PendingChange.Value.OldLevel;
+		const int32 NewLevel = StatNetDatum.CurrentLevel;
+		if (OldLevel == NewLevel)
+		{
+			if (StatNetDatum.CurrentExperience != PendingChange.Value.OldExperience) { StatList.MarkStatDirty(StatNetDatum); }
+			continue;
+		}
+		
+		const FGameplayTag& StatTag = StatNetDatum.ProgressionTag;
+		StatNetDatum.CurrentStatValue = StatSubsystem->GetStatTypeData(StatTag).Representation.ResolveValue(NewLevel);
+		StatList.MarkStatDirty(StatNetDatum);
 
-	static UPDStatSubsystem* StatSubsystem = UPDStatSubsystem::Get();
-	const FPDStatsRow& StatDefaults = StatSubsystem->GetStatTypeData(StatTag);
+		// Granting Tokens
+		GrantTokensBetweenLevels(StatTag, OldLevel, NewLevel);
 
-	if (StatDefaults.ExperienceCurve == nullptr)
+		// The stat we just leveled up is now updating its effect on all stats that the levelled up stat is an effector to
+		const TArray<FGameplayTag>* UpdateTargets = StatSubsystem->StatCrossBehaviourMap.Find(StatTag);
+		if (UpdateTargets == nullptr) { continue; }
+		
+		for (const FGameplayTag& Target : *UpdateTargets)
+		{
+			const FPDStatMapping* TargetMapping = LocalStatMappings.Find(Target);
+			if (TargetMapping == nullptr) { continue; }
+			
+			// @note The calling stat will always exist in the target stats 'RulesAffectedBy',
+			// as this is what has decided the cross behaviour was mapped in the first place
+			const FPDStatsCrossBehaviourRules* CrossBehaviourRules = StatSubsystem->GetStatTypeData(Target).RulesAffectedBy.Find(StatTag);
+			if (CrossBehaviourRules == nullptr || CrossBehaviourRules->RuleSetLevelCurveMultiplier == nullptr)
+			{
+				continue;
+			}
+
+			const int32 OldCrossBehaviourResult =
+				CrossBehaviourRules->CrossBehaviourBaseValue * CrossBehaviourRules->RuleSetLevelCurveMultiplier->GetFloatValue(OldLevel);
+			const int32 CrossBehaviourResult =
+				CrossBehaviourRules->CrossBehaviourBaseValue * CrossBehaviourRules->RuleSetLevelCurveMultiplier->GetFloatValue(NewLevel);
+			
+			// Remove old result, Add New result
+			CrossBehaviourDeltas.FindOrAdd(TargetMapping->Index) += CrossBehaviourResult - OldCrossBehaviourResult;
+		}
+	}
+
+	for (const TTuple<int32, int32>& CrossBehaviourDelta : CrossBehaviourDeltas)
 	{
-		// @todo Set up developer settings to allow this to apply some basic scaling operation if we hit this case, curves are math in the end
-		UE_LOG(PDLog_Progression, Error,
-			TEXT("UPDStatHandler::IncreaseStatExperience_Implementation "
-			"-- Ensure your stat((%s)) has an experience curve applied to it"
-			" @todo Set up developer settings to allow this to apply some basic scaling operation if we hit this case, curves are math in the end"), *StatTag.GetTagName().ToString())
-		return;
+		if (CrossBehaviourDelta.Value == 0) { continue; }
+		
+		FPDStatNetDatum& TargetNetDatum = StatList.Items[CrossBehaviourDelta.Key];
+		TargetNetDatum.CrossBehaviourValue += CrossBehaviourDelta.Value;
+		StatList.MarkStatDirty(TargetNetDatum);
 	}
 	
 	MARK_PROPERTY_DIRTY_FROM_NAME(UPDStatHandler, StatList, this)
-	const int32 StatIndex = LocalStatMappings.Find(StatTag)->Index;
-	FPDStatNetDatum& StatNetDatum = StatList.Items[StatIndex];
-
-	// Check if we may level up
-	const int32 ExpLimitForCurrentLevel =
-		StatDefaults.ExperienceCurve->GetFloatValue(StatNetDatum.CurrentLevel);
-	StatNetDatum.CurrentExperience += ExperienceDelta;	
-	if (StatNetDatum.CurrentExperience >= ExpLimitForCurrentLevel)
-	{
-		IncreaseStatLevel(StatTag);
-	}
 }
 
 void UPDStatHandler::SetClass_Implementation(const FGameplayTag& ClassTag)
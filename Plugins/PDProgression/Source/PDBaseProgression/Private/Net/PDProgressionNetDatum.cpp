@@ -2,6 +2,7 @@
 
 #include "Net/PDProgressionNetDatum.h"
 
+#include "Components/PDProgressionComponent.h"
 #include "Subsystems/PDProgressionSubsystem.h"
 
 double FPDStatNetDatum::GetAppliedValue() const
@@ -18,22 +19,19 @@ double FPDStatNetDatum::GetProcessedCrossBehaviour() const
 void FPDStatNetDatum::PreReplicatedRemove(const FPDStatList& OwningList)
 {
 	check(OwningList.OwningObject != nullptr)
-	// OwningList.OwningObject->OnDatumUpdated(this, EPDStatNetOperation::REMOVE);
+	OwningList.OwningObject->OnDatumUpdated(this, EPDStatNetOperation::REMOVE);
 }
 
 void FPDStatNetDatum::PostReplicatedAdd(const FPDStatList& OwningList)
 {
 	check(OwningList.OwningObject != nullptr)
-	// OwningList.OwningObject->OnDatumUpdated(this, EPDStatNetOperation::ADDNEW);
-	// OwningList.ItemToIndexMapping;
-	// ReplicationID;
+	OwningList.OwningObject->OnDatumUpdated(this, EPDStatNetOperation::ADDNEW);
 }
 
 void FPDStatNetDatum::PostReplicatedChange(const FPDStatList& OwningList)
 {
 	check(OwningList.OwningObject != nullptr)
-	// OwningList.OwningObject->OnDatumUpdated(this, EPDStatNetOperation::CHANGE);
-
+	OwningList.OwningObject->OnDatumUpdated(this, EPDStatNetOperation::CHANGE);
 }
 
 bool FPDStatList::NetSerialize(FNetDeltaSerializeInfo& DeltaParams)
@@ -43,6 +41,11 @@ bool FPDStatList::NetSerialize(FNetDeltaSerializeInfo& DeltaParams)
 		<FPDStatNetDatum, FPDStatList>(Items, DeltaParams, *this);
 }
 
+void FPDStatList::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+	if (OwningObject != nullptr) { OwningObject->PostStatListReceived(); }
+}
+
 void FPDStatList::AddStat(const FGameplayTag& StatTag, int32 StatExperience, int32 StatLevel)
 {
 	FPDStatNetDatum ConstructedNetDatum;
@@ -54,8 +57,10 @@ void FPDStatList::AddStat(const FGameplayTag& StatTag, int32 StatExperience, int
 		UPDStatSubsystem::Get()->
 			GetStatTypeData(StatTag).Representation.ResolveValue(StatLevel);
 	
-	FPDStatNetDatum Item = Items.Emplace_GetRef(ConstructedNetDatum);
+	FPDStatNetDatum& Item = Items.Emplace_GetRef(ConstructedNetDatum);
 	MarkItemDirty(Item);
+
+	if (OwningObject != nullptr) { OwningObject->OnDatumUpdated(&Item, EPDStatNetOperation::ADDNEW); }
 }
 
 void FPDStatList::AddActiveEffect(const FGameplayTag& StatTag, int32 StatExperience, int32 StatLevel)
@@ -68,6 +73,13 @@ void FPDStatList::AddPassiveEffect(const FGameplayTag& StatTag, int32 StatExperi
 	AddStat(StatTag, StatExperience, StatLevel); // placeholder, reserved for later use
 }
 
+void FPDStatList::MarkStatDirty(FPDStatNetDatum& Item)
+{
+	MarkItemDirty(Item);
+	
+	if (OwningObject != nullptr) { OwningObject->OnDatumUpdated(&Item, EPDStatNetOperation::CHANGE); }
+}
+
 /**
 Business Source License 1.1
 
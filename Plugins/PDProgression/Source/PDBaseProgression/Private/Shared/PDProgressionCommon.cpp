@@ -1,6 +1,7 @@
 /* @author: Ario Amin @ Permafrost Development. @copyright: Full BSL(1.1) License included at bottom of the file  */
 
 #include "PDProgressionCommon.h"
+#include "Algo/BinarySearch.h"
 
 double FPDStatsValue::ResolveValue(int32 Level) const
 {
@@ -18,6 +19,283 @@ double FPDStatsValue::ResolveValue(int32 Level) const
 	return (BaseValue * ProgressionModifier) / static_cast<double>(BaseDivisor);
 }
 
+/** @brief Rounds a sampled token curve value the same way the per-level token grants always have */
+static int32 RoundTokenGrant(const float TokensAsFloats)
+{
+	return static_cast<int32>(TokensAsFloats + 0.5f);
+}
+
+void FPDStatProgressionTable::Bake(const FPDStatsRow& StatRow)
+{
+	const int32 BakedLevels = FMath::Clamp(StatRow.MaxLevel, 1, MaxBakedLevels) + 1;
+
+	ExperienceThresholds.Reset();
+	bMonotonicThresholds = true;
+	if (StatRow.ExperienceCurve != nullptr)
+	{
+		ExperienceThresholds.SetNumUninitialized(BakedLevels);
+		for (int32 Level = 0; Level < BakedLevels; Level++)
+		{
+			ExperienceThresholds[Level] = StatRow.ExperienceCurve->GetFloatValue(Level);
+			bMonotonicThresholds &= Level == 0 || ExperienceThresholds[Level] >= ExperienceThresholds[Level - 1];
+		}
+	}
+
+	TokenPrefixSums.Reset();
+	for (const TTuple<FGameplayTag, UCurveFloat*>& TokenCategoryCurveTuple : StatRow.TokensToGrantPerLevel)
+	{
+		if (TokenCategoryCurveTuple.Value == nullptr) { continue; }
+
+		TArray<int32>& PrefixSums = TokenPrefixSums.Emplace(TokenCategoryCurveTuple.Key);
+		PrefixSums.SetNumUninitialized(BakedLevels + 1);
+		PrefixSums[0] = 0;
+		for (int32 Level = 0; Level < BakedLevels; Level++)
+		{
+			PrefixSums[Level + 1] = PrefixSums[Level] + RoundTokenGrant(TokenCategoryCurveTuple.Value->GetFloatValue(Level));
+		}
+	}
+}
+
+int32 FPDStatProgressionTable::ResolveLevelFromExperience(const FPDStatsRow& StatRow, int32 CurrentLevel, int32 TotalExperience) const
+{
+	if (StatRow.ExperienceCurve == nullptr) { return CurrentLevel; }
+	
+	int32 Level = CurrentLevel;
+	const float Experience = TotalExperience;
+	if (Level >= 0 && Level < ExperienceThresholds.Num())
+	{
+		if (bMonotonicThresholds)
+		{
+			// First level whose threshold we have not yet met
+			const TConstArrayView<float> RemainingThresholds = MakeArrayView(ExperienceThresholds).Slice(Level, ExperienceThresholds.Num() - Level);
+			Level += Algo::UpperBound(RemainingThresholds, Experience);
+		}
+		else
+		{
+			while (Level < ExperienceThresholds.Num() && Experience >= ExperienceThresholds[Level]) { Level++; }
+		}
+		
+		if (Level < ExperienceThresholds.Num()) { return Level; }
+	}
+
+	// Past the baked range, only keep levelling while the curve keeps increasing so a flat curve can't spin forever
+	float LastThreshold = Level > 0 ? StatRow.ExperienceCurve->GetFloatValue(Level - 1) : -UE_MAX_FLT;
+	for (float Threshold = StatRow.ExperienceCurve->GetFloatValue(Level);
+		Experience >= Threshold && Threshold > LastThreshold;
+		Threshold = StatRow.ExperienceCurve->GetFloatValue(Level))
+	{
+		LastThreshold = Threshold;
+		Level++;
+	}
+	return Level;
+}
+
+int32 FPDStatProgressionTable::GetTokensGrantedBetween(const FPDStatsRow& StatRow, const FGameplayTag& TokenCategory, int32 FromLevel, int32 ToLevel) const
+{
+	if (ToLevel <= FromLevel) { return 0; }
+
+	int32 GrantedTokens = 0;
+	int32 Level = FromLevel;
+	
+	const TArray<int32>* PrefixSums = TokenPrefixSums.Find(TokenCategory);
+	if (PrefixSums != nullptr && Level >= 0)
+	{
+		const int32 BakedEnd = FMath::Min(ToLevel, PrefixSums->Num() - 1);
+		if (Level < BakedEnd)
+		{
+			GrantedTokens += (*PrefixSums)[BakedEnd] - (*PrefixSums)[Level];
+			Level = BakedEnd;
+		}
+	}
+	if (Level >= ToLevel) { return GrantedTokens; }
+
+	// Outside the baked range
+	const UCurveFloat* TokenCurve = StatRow.TokensToGrantPerLevel.FindRef(TokenCategory);
+	if (TokenCurve == nullptr) { return GrantedTokens; }
+	
+	for (; Level < ToLevel; Level++)
+	{
+		GrantedTokens += RoundTokenGrant(TokenCurve->GetFloatValue(Level));
+	}
+	return GrantedTokens;
+}
+
+void FPDCompiledSkillGraph::Reset()
+{
+	Nodes.Reset();
+	SkillIndices.Reset();
+	Prerequisites.Reset();
+	Dependents.Reset();
+	TokenCategories.Reset();
+	CompileErrors.Reset();
+}
+
+void FPDCompiledSkillGraph::Compile(const TArray<const FPDSkillTree*>& Trees)
+{
+	Reset();
+
+	TArray<int32> SkillPath;
+	TBitArray<> ExpandedSkills;
+	TArray<TPair<int32, int32>> Edges; // Parent, Child
+	for (const FPDSkillTree* Tree : Trees)
+	{
+		if (Tree == nullptr) { continue; }
+		
+		for (const TTuple<FGameplayTag, FPDSkillBranch>& SkillBranchTuple : Tree->Skills)
+		{
+			// Root
+			CompileBranch(*Tree, SkillBranchTuple.Value, SkillBranchTuple.Key, INDEX_NONE, SkillPath, ExpandedSkills, Edges);
+		}
+	}
+
+	Prerequisites.Init(TBitArray<>(false, Nodes.Num()), Nodes.Num());
+	Dependents.Init(TBitArray<>(false, Nodes.Num()), Nodes.Num());
+	for (const TPair<int32, int32>& Edge : Edges)
+	{
+		Prerequisites[Edge.Value][Edge.Key] = true;
+		Dependents[Edge.Key][Edge.Value] = true;
+	}
+}
+
+int32 FPDCompiledSkillGraph::CompileBranch(
+	const FPDSkillTree& Tree,
+	const FPDSkillBranch& Branch,
+	const FGameplayTag& CategoryTag,
+	int32 ParentIdx,
+	TArray<int32>& SkillPath,
+	TBitArray<>& ExpandedSkills,
+	TArray<TPair<int32, int32>>& Edges)
+{
+	const FPDStatsRow* SkillStat = Branch.BranchRootSkill.DataTable != nullptr ? Branch.BranchRootSkill.GetRow<FPDStatsRow>("") : nullptr;
+	if (SkillStat == nullptr)
+	{
+		CompileErrors.Emplace(FString::Printf(TEXT("Tree(%s) -- Branch has a dangling 'BranchRootSkill' reference (%s)"),
+			*Tree.Tag.GetTagName().ToString(), *Branch.BranchRootSkill.RowName.ToString()));
+		
+		// Top-level branches are still reachable by their category key
+		if (CategoryTag.IsValid() == false) { return INDEX_NONE; }
+	}
+	const FGameplayTag& SkillTag = SkillStat != nullptr ? SkillStat->ProgressionTag : CategoryTag;
+
+	int32 SkillIdx = FindSkillIndex(SkillTag);
+	if (SkillIdx == INDEX_NONE)
+	{
+		FPDCompiledSkillNode& Node = Nodes.AddDefaulted_GetRef();
+		Node.SkillTag = SkillTag;
+		Node.TreeTag = Tree.Tag;
+		Node.TokenCategoryIndex = InternTokenCategory(Branch.TokenRules.TokenType);
+		Node.TokenCost = Branch.TokenRules.TokenValue;
+		Node.MinTokenLevel = Branch.TokenRules.MinTokenLevel;
+		
+		SkillIdx = Nodes.Num() - 1;
+		SkillIndices.Emplace(SkillTag, SkillIdx);
+		ExpandedSkills.Add(false);
+	}
+	else if (Nodes[SkillIdx].TreeTag != Tree.Tag)
+	{
+		CompileErrors.Emplace(FString::Printf(TEXT("Tree(%s) -- Skill(%s) is already owned by tree(%s), keeping the first"),
+			*Tree.Tag.GetTagName().ToString(), *SkillTag.GetTagName().ToString(), *Nodes[SkillIdx].TreeTag.GetTagName().ToString()));
+		return INDEX_NONE;
+	}
+	
+	if (CategoryTag.IsValid() && CategoryTag != SkillTag)
+	{
+		const int32* ExistingIdx = SkillIndices.Find(CategoryTag);
+		if (ExistingIdx == nullptr)
+		{
+			SkillIndices.Emplace(CategoryTag, SkillIdx);
+		}
+		else if (*ExistingIdx != SkillIdx)
+		{
+			CompileErrors.Emplace(FString::Printf(TEXT("Tree(%s) -- Category key (%s) already maps to skill(%s), keeping the first"),
+				*Tree.Tag.GetTagName().ToString(), *CategoryTag.GetTagName().ToString(), *Nodes[*ExistingIdx].SkillTag.GetTagName().ToString()));
+		}
+	}
+
+	if (SkillPath.Contains(SkillIdx))
+	{
+		CompileErrors.Emplace(FString::Printf(TEXT("Tree(%s) -- Skill(%s) is part of a cycle, dropping the edge that closes it"),
+			*Tree.Tag.GetTagName().ToString(), *SkillTag.GetTagName().ToString()));
+		return INDEX_NONE;
+	}
+	
+	if (ParentIdx != INDEX_NONE)
+	{
+		Edges.AddUnique(TPair<int32, int32>{ParentIdx, SkillIdx});
+	}
+
+	// Shared branches only need expanding once
+	if (ExpandedSkills[SkillIdx]) { return SkillIdx; }
+	ExpandedSkills[SkillIdx] = true;
+	
+	SkillPath.Push(SkillIdx);
+	for (const FDataTableRowHandle& SkillBranchHandle : Branch.BranchPaths)
+	{
+		const FPDSkillBranch* InnerBranch = SkillBranchHandle.DataTable != nullptr ? SkillBranchHandle.GetRow<FPDSkillBranch>("") : nullptr;
+		if (InnerBranch == nullptr)
+		{
+			CompileErrors.Emplace(FString::Printf(TEXT("Tree(%s) -- Skill(%s) has a dangling branch path reference (%s)"),
+				*Tree.Tag.GetTagName().ToString(), *SkillTag.GetTagName().ToString(), *SkillBranchHandle.RowName.ToString()));
+			continue;
+		}
+		
+		CompileBranch(Tree, *InnerBranch, FGameplayTag::EmptyTag, SkillIdx, SkillPath, ExpandedSkills, Edges);
+	}
+	SkillPath.Pop();
+	
+	return SkillIdx;
+}
+
+int32 FPDCompiledSkillGraph::InternTokenCategory(const FGameplayTag& TokenCategory)
+{
+	const int32 ExistingIdx = TokenCategories.Find(TokenCategory); // Expecting very few categories
+	return ExistingIdx != INDEX_NONE ? ExistingIdx : TokenCategories.Add(TokenCategory);
+}
+
+int32 FPDCompiledSkillGraph::FindSkillIndex(const FGameplayTag& SkillTag) const
+{
+	const int32* SkillIdx = SkillIndices.Find(SkillTag);
+	return SkillIdx != nullptr ? *SkillIdx : INDEX_NONE;
+}
+
+const FGameplayTag& FPDCompiledSkillGraph::GetTokenCategory(int32 SkillIdx) const
+{
+	return TokenCategories[Nodes[SkillIdx].TokenCategoryIndex];
+}
+
+/** @brief True if (A & B) has any bit set, compares whole words at a time. Both arrays are expected to be sized to the same skill count */
+static bool AnySharedBits(const TBitArray<>& A, const TBitArray<>& B)
+{
+	const int32 NumWords = FMath::DivideAndRoundUp(FMath::Min(A.Num(), B.Num()), NumBitsPerDWORD);
+	const uint32* AWords = A.GetData();
+	const uint32* BWords = B.GetData();
+	for (int32 WordIdx = 0; WordIdx < NumWords; WordIdx++)
+	{
+		if ((AWords[WordIdx] & BWords[WordIdx]) != 0) { return true; }
+	}
+	return false;
+}
+
+bool FPDCompiledSkillGraph::HasUnlockedPrerequisites(int32 SkillIdx, const TBitArray<>& UnlockedSkills) const
+{
+	const TBitArray<>& Required = Prerequisites[SkillIdx];
+	const int32 NumWords = FMath::DivideAndRoundUp(Required.Num(), NumBitsPerDWORD);
+	if (UnlockedSkills.Num() != Required.Num()) { return false; }
+	
+	const uint32* RequiredWords = Required.GetData();
+	const uint32* UnlockedWords = UnlockedSkills.GetData();
+	for (int32 WordIdx = 0; WordIdx < NumWords; WordIdx++)
+	{
+		if ((RequiredWords[WordIdx] & ~UnlockedWords[WordIdx]) != 0) { return false; }
+	}
+	return true;
+}
+
+bool FPDCompiledSkillGraph::HasUnlockedDependents(int32 SkillIdx, const TBitArray<>& UnlockedSkills) const
+{
+	return AnySharedBits(Dependents[SkillIdx], UnlockedSkills);
+}
+
 /**
 Business Source License 1.1
 
@@ -4,6 +4,7 @@
 
 #include "Components/PDProgressionComponent.h"
 #include "Net/PDProgressionNetDatum.h"
+#include "PDTableIngestion.h"
 
 UPDStatSubsystem* UPDStatSubsystem::Get()
 {
@@ -11,100 +12,115 @@ UPDStatSubsystem* UPDStatSubsystem::Get()
 	if (Self == nullptr)
 	{
 		Self = GEngine->GetEngineSubsystem<UPDStatSubsystem>();
-		Self->LatentInitialization();
+	}
+
+	// First use beat the streaming, finish it here rather than hand out empty lookups
+	if (Self->bHasPublishedTableData == false && IsInGameThread())
+	{
+		FPDTableIngestion::Get().Flush(TableIngestionName);
 	}
 	
 	return Self;
 }
 
+void UPDStatSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	LatentInitialization();
+}
+
 void UPDStatSubsystem::LatentInitialization()
 {
 	const UPDProgressionSubsystemSettings* DefaultSubsystemSettings =
 		GetDefault<UPDProgressionSubsystemSettings>();
 
-	for (const TSoftObjectPtr<UDataTable>& Elem
-	     : DefaultSubsystemSettings->ProgressionClassTables)
-	{
-		const UDataTable* Table = Elem.LoadSynchronous();
-		if (Table == nullptr) { continue; }
-		
-		TArray<FPDProgressionClassRow*> ClassRows;
-		Table->GetAllRows("", ClassRows);
-		for (FPDProgressionClassRow* ClassRow : ClassRows)
-		{
-			if (ClassRow == nullptr) { continue; }
-			ClassTypes.Emplace(ClassRow->Tag, ClassRow);
-		}
-	}
-	for (const TSoftObjectPtr<UDataTable>&  Elem
-		: DefaultSubsystemSettings->ProgressionStatTables)
+	TArray<TSoftObjectPtr<UDataTable>> TablePaths;
+	TablePaths.Append(DefaultSubsystemSettings->ProgressionClassTables);
+	TablePaths.Append(DefaultSubsystemSettings->ProgressionStatTables);
+	TablePaths.Append(DefaultSubsystemSettings->ProgressionTreeTables);
+
+	FPDTableIngestion::Get().Ingest<FPDStatSubsystemTableData>(
+		TableIngestionName,
+		TablePaths,
+		[](const TArray<UDataTable*>& Tables, FPDStatSubsystemTableData& OutData) { BuildTableData(Tables, OutData); },
+		[this](const TArray<UDataTable*>& Tables, FPDStatSubsystemTableData&& Data) { PublishTableData(MoveTemp(Data)); });
+}
+
+void UPDStatSubsystem::BuildTableData(const TArray<UDataTable*>& Tables, FPDStatSubsystemTableData& OutData)
+{
+	// Tables of all three kinds are ingested together, dispatch on their row structure
+	for (const UDataTable* Table : Tables)
 	{
-		const UDataTable* Table = Elem.LoadSynchronous();
-		if (Table == nullptr) { continue; }
-		
-		TArray<FPDStatsRow*> StatRows;
-		Table->GetAllRows("", StatRows);
-		for (FPDStatsRow* StatRow : StatRows)
+		if (Table->RowStruct == FPDProgressionClassRow::StaticStruct())
 		{
-			if (StatRow == nullptr) { continue; }
-			DefaultStats.Emplace(StatRow->ProgressionTag, StatRow);
-
-			for (const TTuple<FGameplayTag, FPDStatsCrossBehaviourRules>& Rule
-				: StatRow->RulesAffectedBy)
+			TArray<FPDProgressionClassRow*> ClassRows;
+			Table->GetAllRows("", ClassRows);
+			for (FPDProgressionClassRow* ClassRow : ClassRows)
 			{
-				StatCrossBehaviourMap.FindOrAdd(Rule.Key).AddUnique(StatRow->ProgressionTag);
-				StatCrossBehaviourBackMapped.FindOrAdd(StatRow->ProgressionTag).AddUnique(Rule.Key);
+				if (ClassRow == nullptr) { continue; }
+				OutData.ClassTypes.Emplace(ClassRow->Tag, ClassRow);
 			}
-			
-		}		
-	}
-	for (const TSoftObjectPtr<UDataTable>&  Elem
-		: DefaultSubsystemSettings->ProgressionTreeTables)
-	{
-		const UDataTable* Table = Elem.LoadSynchronous();
-		if (Table == nullptr) { continue; }
-		
-		TArray<FPDSkillTree*> TreeRows;
-		Table->GetAllRows("", TreeRows);
-		for (FPDSkillTree* TreeRow : TreeRows)
+		}
+		else if (Table->RowStruct == FPDStatsRow::StaticStruct())
 		{
-			if (TreeRow == nullptr) { continue; }
-			TreeTypes.Emplace(TreeRow->Tag, TreeRow);
-
-			for (const TTuple<FGameplayTag, FPDSkillBranch>& SkillBranchTuple
-				: TreeRow->Skills)
+			TArray<FPDStatsRow*> StatRows;
+			Table->GetAllRows("", StatRows);
+			for (FPDStatsRow* StatRow : StatRows)
 			{
-				// Root
-				SkillToTreeMapping.Emplace(SkillBranchTuple.Key, TreeRow->Tag);
-				
+				if (StatRow == nullptr) { continue; }
+				OutData.DefaultStats.Emplace(StatRow->ProgressionTag, StatRow);
+				OutData.StatProgressionTables.FindOrAdd(StatRow->ProgressionTag).Bake(*StatRow);
 
-				const FPDStatsRow* BranchStat = SkillBranchTuple.Value.BranchRootSkill.GetRow<FPDStatsRow>("");
-				if (BranchStat == nullptr) { continue; }
-				SkillToTreeMapping.Emplace(BranchStat->ProgressionTag, TreeRow->Tag);
-
-				static const FPDSkillBranch DummySkillBranch;
-
-				
-				// TArray<FPDSkillBranch> BranchPaths. Recursively map all skills in a tree back to the tree, for fast access downstream
-				TFunction<void(const TArray<FDataTableRowHandle>&)> BranchMapper;
-				BranchMapper = [&, TreeRowTag = TreeRow->Tag](const TArray<FDataTableRowHandle>& BranchPaths)
+				for (const TTuple<FGameplayTag, FPDStatsCrossBehaviourRules>& Rule
+					: StatRow->RulesAffectedBy)
 				{
-					for (const FDataTableRowHandle& SkillBranchHandle : BranchPaths)
-					{
-						const FPDSkillBranch& SkillBranch = SkillBranchHandle.IsNull() ? DummySkillBranch : *SkillBranchHandle.GetRow<FPDSkillBranch>("");
-						const FPDStatsRow* InnerBranchStat = SkillBranch.BranchRootSkill.GetRow<FPDStatsRow>("");
-						if (InnerBranchStat == nullptr) { continue; }
-						SkillToTreeMapping.Emplace(InnerBranchStat->ProgressionTag, TreeRowTag);
-
-						BranchMapper(SkillBranch.BranchPaths);
-					}
-				};
-
-				BranchMapper(SkillBranchTuple.Value.BranchPaths);
-				
+					OutData.StatCrossBehaviourMap.FindOrAdd(Rule.Key).AddUnique(StatRow->ProgressionTag);
+					OutData.StatCrossBehaviourBackMapped.FindOrAdd(StatRow->ProgressionTag).AddUnique(Rule.Key);
+				}
+			}
+		}
+		else if (Table->RowStruct == FPDSkillTree::StaticStruct())
+		{
+			TArray<FPDSkillTree*> TreeRows;
+			Table->GetAllRows("", TreeRows);
+			for (FPDSkillTree* TreeRow : TreeRows)
+			{
+				if (TreeRow == nullptr) { continue; }
+				OutData.TreeTypes.Emplace(TreeRow->Tag, TreeRow);
 			}
+		}
+	}
 
-		}		
+	// Compile all trees into a flat graph, resolving every branch handle once here rather than on every skill unlock
+	TArray<const FPDSkillTree*> CompiledTrees;
+	for (const TTuple<FGameplayTag, FPDSkillTree*>& TreeTuple : OutData.TreeTypes)
+	{
+		CompiledTrees.Emplace(TreeTuple.Value);
+	}
+	OutData.CompiledSkillGraph.Compile(CompiledTrees);
+	
+	// Map all skills in a tree back to the tree, for fast access downstream
+	for (const TTuple<FGameplayTag, int32>& SkillIndexTuple : OutData.CompiledSkillGraph.SkillIndices)
+	{
+		OutData.SkillToTreeMapping.Emplace(SkillIndexTuple.Key, OutData.CompiledSkillGraph.Nodes[SkillIndexTuple.Value].TreeTag);
+	}
+}
+
+void UPDStatSubsystem::PublishTableData(FPDStatSubsystemTableData&& Data)
+{
+	TreeTypes = MoveTemp(Data.TreeTypes);
+	SkillToTreeMapping = MoveTemp(Data.SkillToTreeMapping);
+	CompiledSkillGraph = MoveTemp(Data.CompiledSkillGraph);
+	ClassTypes = MoveTemp(Data.ClassTypes);
+	DefaultStats = MoveTemp(Data.DefaultStats);
+	StatCrossBehaviourMap = MoveTemp(Data.StatCrossBehaviourMap);
+	StatCrossBehaviourBackMapped = MoveTemp(Data.StatCrossBehaviourBackMapped);
+	StatProgressionTables = MoveTemp(Data.StatProgressionTables);
+	bHasPublishedTableData = true;
+	
+	for (const FString& CompileError : CompiledSkillGraph.CompileErrors)
+	{
+		UE_LOG(PDLog_Progression, Error, TEXT("UPDStatSubsystem::PublishTableData -- Skill-tree compile error: %s"), *CompileError);
 	}
 }
 
@@ -231,6 +247,11 @@ FPDStatsRow* UPDStatSubsystem::GetStatTypeDataPtr(const FGameplayTag& RequestedS
 		: nullptr;
 }
 
+const FPDStatProgressionTable* UPDStatSubsystem::GetStatProgressionTable(const FGameplayTag& RequestedStat) const
+{
+	return StatProgressionTables.Find(RequestedStat);
+}
+
 FString UPDStatSubsystem::GetTagNameLeaf(const FGameplayTag& Tag)
 {
 	const FString& TagProtoString = Tag.GetTagName().ToString();
@@ -262,7 +262,7 @@ void UPDStatListInnerWidget::SetFonts_OffsetsDataView(const FSlateFontInfo& Titl
 
 void UPDStatListInnerWidget::RefreshInnerStatList()
 {
-	NetDataView.Empty();
+	NetDataView.Reset();
 	if (InnerStatList.IsValid())
 	{
 		UpdateDataViewWithEditorTestEntries(NetDataView, EditorTestEntries_BaseList);
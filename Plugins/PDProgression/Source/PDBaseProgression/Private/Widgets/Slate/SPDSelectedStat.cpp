@@ -208,28 +208,25 @@ void SPDSelectedStat_LevelData::UpdateChildSlot()
 
 void SPDSelectedStat_LevelData::PrepareData()
 {
-	TArray<TSharedPtr<FPDSkillTokenBase>>*& TokenArrayPtr = HeaderDataViews.Key.DataViewPtr;
-	const TSharedPtr<SListView<TSharedPtr<FPDSkillTokenBase>>>& TokenArrayListView = HeaderDataViews.Key.ListView;
-	TArray<TSharedPtr<FPDStatViewAffectedStat>>*& AffectedStatsPtr = HeaderDataViews.Value.DataViewPtr;
-	const TSharedPtr<SListView<TSharedPtr<FPDStatViewAffectedStat>>>& AffectedStatsListView = HeaderDataViews.Value.ListView;
-	
-	if (TokenArrayPtr == nullptr || TokenArrayListView.IsValid() == false) { return; }
-	if (AffectedStatsPtr == nullptr || AffectedStatsListView.IsValid() == false) { return; }
+	TArray<TSharedPtr<FPDSkillTokenBase>>* TokenArrayPtr = HeaderDataViews.Key.DataViewPtr;
+	TArray<TSharedPtr<FPDStatViewAffectedStat>>* AffectedStatsPtr = HeaderDataViews.Value.DataViewPtr;
+	if (TokenArrayPtr == nullptr || AffectedStatsPtr == nullptr) { return; }
 	
 	static UPDStatSubsystem* StatSubsystem = UPDStatSubsystem::Get();
+	UPDStatHandler* OwnersStatHandler = StatSubsystem->StatHandlers.FindRef(OwnerID);
+	BindToStatHandler(OwnersStatHandler);
+	if (OwnersStatHandler == nullptr) { return; }
+
 	const FPDStatsRow& SelectedStat = StatSubsystem->GetStatTypeData(SelectedStatTag);
 	const TArray<FGameplayTag>& StatsThatWeAffect = StatSubsystem->StatCrossBehaviourMap.FindRef(SelectedStatTag);
 
-	UPDStatHandler** OwnersStatHandler = StatSubsystem->StatHandlers.Find(OwnerID);
-	if (OwnersStatHandler == nullptr || *OwnersStatHandler == nullptr) { return; }
-
 	constexpr int32 DeltaLevel = 1;
-	const FPDStatMapping* StatMapping = (*OwnersStatHandler)->LocalStatMappings.Find(SelectedStatTag);
-	int32 SelectedStatNextLevel = DeltaLevel + (StatMapping == nullptr
+	const FPDStatMapping* StatMapping = OwnersStatHandler->LocalStatMappings.Find(SelectedStatTag);
+	const int32 SelectedStatNextLevel = DeltaLevel + (StatMapping == nullptr
 		? 0
-		: SelectedStatNextLevel = (*OwnersStatHandler)->StatList.Items[StatMapping->Index].CurrentLevel);
+		: OwnersStatHandler->StatList.Items[StatMapping->Index].CurrentLevel);
 
-	
+	int32 AffectedStatCount = 0;
 	for (const FGameplayTag& StatTargetTag : StatsThatWeAffect)
 	{
 		const FPDStatsRow* StatTargetDefaultDataPtr = StatSubsystem->GetStatTypeDataPtr(StatTargetTag);
@@ -245,14 +242,13 @@ void SPDSelectedStat_LevelData::PrepareData()
 			SelectedStatTag,
 			DeltaNewLevelOffset);
 		
-		
-		TSharedPtr<FPDStatViewAffectedStat> ConstructedAffectedStatView = MakeShared<FPDStatViewAffectedStat>();
-		ConstructedAffectedStatView->AffectedStat = StatTargetTag;
-		ConstructedAffectedStatView->TotalAffectedDelta = DeltaNewLevelOffset;
-
-		AffectedStatsPtr->Emplace(ConstructedAffectedStatView);
+		FPDStatViewAffectedStat& AffectedStatView = FPDStatStatics::AcquireSharedViewEntry(*AffectedStatsPtr, AffectedStatCount++);
+		AffectedStatView.AffectedStat = StatTargetTag;
+		AffectedStatView.TotalAffectedDelta = DeltaNewLevelOffset;
 	}
-	
+	AffectedStatsPtr->SetNum(AffectedStatCount, false);
+
+	int32 TokenCount = 0;
 	for (const TTuple<FGameplayTag, UCurveFloat*>& TokenCategoryCompound : SelectedStat.TokensToGrantPerLevel)
 	{
 		const UCurveFloat* TokenProgressCurve = TokenCategoryCompound.Value;
@@ -264,12 +260,44 @@ void SPDSelectedStat_LevelData::PrepareData()
 			continue;
 		}
 
-		TSharedPtr<FPDSkillTokenBase> ConstructedTokenView = MakeShared<FPDSkillTokenBase>();
-		ConstructedTokenView->TokenType = TokenCategoryCompound.Key;
-		ConstructedTokenView->TokenValue += (TokenProgressCurve->GetFloatValue(SelectedStatNextLevel) + 0.5f);
-		
-		TokenArrayPtr->Emplace(ConstructedTokenView);
+		FPDSkillTokenBase& TokenView = FPDStatStatics::AcquireSharedViewEntry(*TokenArrayPtr, TokenCount++);
+		TokenView.TokenType = TokenCategoryCompound.Key;
+		TokenView.TokenValue = static_cast<int32>(TokenProgressCurve->GetFloatValue(SelectedStatNextLevel) + 0.5f);
+	}
+	TokenArrayPtr->SetNum(TokenCount, false);
+}
+
+SPDSelectedStat_LevelData::~SPDSelectedStat_LevelData()
+{
+	BindToStatHandler(nullptr);
+}
+
+void SPDSelectedStat_LevelData::BindToStatHandler(UPDStatHandler* StatHandler)
+{
+	if (BoundStatHandler.Get() == StatHandler && (StatHandler == nullptr || StatUpdatedHandle.IsValid())) { return; }
+
+	if (UPDStatHandler* PreviousStatHandler = BoundStatHandler.Get())
+	{
+		PreviousStatHandler->OnStatDatumUpdated.Remove(StatUpdatedHandle);
 	}
+	StatUpdatedHandle.Reset();
+	
+	BoundStatHandler = StatHandler;
+	if (StatHandler == nullptr) { return; }
+	
+	StatUpdatedHandle = StatHandler->OnStatDatumUpdated.AddSP(this, &SPDSelectedStat_LevelData::OnStatDatumUpdated);
+}
+
+void SPDSelectedStat_LevelData::OnStatDatumUpdated(int32 StatIndex, const FPDStatNetDatum& Datum, EPDStatNetOperation Operation)
+{
+	if (Operation == EPDStatNetOperation::REMOVE || Datum.ProgressionTag != SelectedStatTag) { return; }
+
+	PrepareData();
+	
+	const TSharedPtr<SListView<TSharedPtr<FPDSkillTokenBase>>>& TokenArrayListView = HeaderDataViews.Key.ListView;
+	const TSharedPtr<SListView<TSharedPtr<FPDStatViewAffectedStat>>>& AffectedStatsListView = HeaderDataViews.Value.ListView;
+	if (TokenArrayListView.IsValid()) { TokenArrayListView->RebuildList(); }
+	if (AffectedStatsListView.IsValid()) { AffectedStatsListView->RebuildList(); }
 }
 
 FReply  SPDSelectedStat_LevelData::DesignTimeTranslation(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
@@ -410,31 +438,26 @@ void SPDSelectedStat_OffsetData::Construct(
 
 void SPDSelectedStat_OffsetData::PrepareData()
 {
-	TArray<TSharedPtr<FPDStatViewModifySource>>*& SelectedStatModifierSources = HeaderDataViews.Value.DataViewPtr;
-	const TSharedPtr<SListView<TSharedPtr<FPDStatViewModifySource>>>& ModifySourceListView = HeaderDataViews.Value.ListView;
-	if (SelectedStatModifierSources == nullptr || ModifySourceListView.IsValid() == false)
-	{
-		return;
-	}
+	TArray<TSharedPtr<FPDStatViewModifySource>>* SelectedStatModifierSources = HeaderDataViews.Value.DataViewPtr;
+	if (SelectedStatModifierSources == nullptr) { return; }
 	
 	static UPDStatSubsystem* StatSubsystem = UPDStatSubsystem::Get();
+	UPDStatHandler* OwnersStatHandler = StatSubsystem->StatHandlers.FindRef(OwnerID);
+	BindToStatHandler(OwnersStatHandler);
+	if (OwnersStatHandler == nullptr) { return; }
+
 	const FPDStatsRow& SelectedStat = StatSubsystem->GetStatTypeData(SelectedStatTag);
 	const TArray<FGameplayTag>& StatsThatAffectUs = StatSubsystem->StatCrossBehaviourBackMapped.FindRef(SelectedStatTag);
 
-	UPDStatHandler** OwnersStatHandler = StatSubsystem->StatHandlers.Find(OwnerID);
-	if (OwnersStatHandler == nullptr || *OwnersStatHandler == nullptr)
-	{
-		return;
-	}
-	
+	int32 ModifySourceCount = 0;
 	for (const FGameplayTag& StatSourceTag : StatsThatAffectUs)
 	{
 		FPDStatsCrossBehaviourRules CrossBehaviourRules;
 
-		const FPDStatMapping* StatMapping = (*OwnersStatHandler)->LocalStatMappings.Find(StatSourceTag);
-		int32 StatSourceLevel = (StatMapping == nullptr
+		const FPDStatMapping* StatMapping = OwnersStatHandler->LocalStatMappings.Find(StatSourceTag);
+		const int32 StatSourceLevel = (StatMapping == nullptr
 			? 0
-			: StatSourceLevel = (*OwnersStatHandler)->StatList.Items[StatMapping->Index].CurrentLevel);		
+			: OwnersStatHandler->StatList.Items[StatMapping->Index].CurrentLevel);		
 		
 		double CrossBehaviourOffset_Normalized;
 		StatSubsystem->ResolveCrossBehaviours(
@@ -444,16 +467,48 @@ void SPDSelectedStat_OffsetData::PrepareData()
 			CrossBehaviourRules,
 			CrossBehaviourOffset_Normalized);
 
-		TSharedPtr<FPDStatViewModifySource> ConstructedModifySourceView = MakeShared<FPDStatViewModifySource>();
-		ConstructedModifySourceView->StatTag = StatSourceTag;
-		ConstructedModifySourceView->AppliedStatOffset = CrossBehaviourOffset_Normalized;
-		ConstructedModifySourceView->StatOffsetCurveSource = CrossBehaviourRules.RuleSetLevelCurveMultiplier; 
+		FPDStatViewModifySource& ModifySourceView = FPDStatStatics::AcquireSharedViewEntry(*SelectedStatModifierSources, ModifySourceCount++);
+		ModifySourceView.StatTag = StatSourceTag;
+		ModifySourceView.AppliedStatOffset = CrossBehaviourOffset_Normalized;
+		ModifySourceView.StatOffsetCurveSource = CrossBehaviourRules.RuleSetLevelCurveMultiplier; 
 
 		// @todo, need to write a shader that visualizes this curve for us, and where on the curve we are at
-		
-		SelectedStatModifierSources->Emplace(ConstructedModifySourceView);
 	}
+	SelectedStatModifierSources->SetNum(ModifySourceCount, false);
+}
+
+SPDSelectedStat_OffsetData::~SPDSelectedStat_OffsetData()
+{
+	BindToStatHandler(nullptr);
+}
+
+void SPDSelectedStat_OffsetData::BindToStatHandler(UPDStatHandler* StatHandler)
+{
+	if (BoundStatHandler.Get() == StatHandler && (StatHandler == nullptr || StatUpdatedHandle.IsValid())) { return; }
+
+	if (UPDStatHandler* PreviousStatHandler = BoundStatHandler.Get())
+	{
+		PreviousStatHandler->OnStatDatumUpdated.Remove(StatUpdatedHandle);
+	}
+	StatUpdatedHandle.Reset();
+	
+	BoundStatHandler = StatHandler;
+	if (StatHandler == nullptr) { return; }
+	
+	StatUpdatedHandle = StatHandler->OnStatDatumUpdated.AddSP(this, &SPDSelectedStat_OffsetData::OnStatDatumUpdated);
+}
+
+void SPDSelectedStat_OffsetData::OnStatDatumUpdated(int32 StatIndex, const FPDStatNetDatum& Datum, EPDStatNetOperation Operation)
+{
+	if (Operation == EPDStatNetOperation::REMOVE) { return; }
 	
+	const TArray<FGameplayTag>* StatsThatAffectUs = UPDStatSubsystem::Get()->StatCrossBehaviourBackMapped.Find(SelectedStatTag);
+	if (StatsThatAffectUs == nullptr || StatsThatAffectUs->Contains(Datum.ProgressionTag) == false) { return; }
+
+	PrepareData();
+
+	const TSharedPtr<SListView<TSharedPtr<FPDStatViewModifySource>>>& ModifySourceListView = HeaderDataViews.Value.ListView;
+	if (ModifySourceListView.IsValid()) { ModifySourceListView->RebuildList(); }
 }
 
 void SPDSelectedStat_OffsetData::Refresh(
@@ -32,6 +32,11 @@ FText SPDStatList::StatProgress_Header_ModifiedOffset = LOCTEXT("Stat_HeaderRow_
 
 //
 // STAT-LIST MAIN
+SPDStatList::~SPDStatList()
+{
+	BindToStatHandler(nullptr);
+}
+
 void SPDStatList::Construct(const FArguments& InArgs, int32 InOwnerID, TArray<TSharedPtr<FPDStatNetDatum>>& DataViewRef, const FPDWidgetBaseSettings& WidgetSettingsUpdate)
 {
 	Refresh(InOwnerID, DataViewRef, WidgetSettingsUpdate);
@@ -55,29 +60,190 @@ void SPDStatList::Refresh(int32 InOwnerID, TArray<TSharedPtr<FPDStatNetDatum>>&
 	else
 	{
 		PrepareData();
-		if (bIsSectionWidthChanged) { RefreshHeaderRow(0); }
-		
 		ActualList->SetItemsSource(StatsAsSharedArray);
-		ActualList->RebuildList();
-		ActualList->Invalidate(EInvalidateWidgetReason::Paint);
+		
+		// Rows read their values from the shared row data, only a changed layout needs them to be regenerated
+		if (bIsSectionWidthChanged)
+		{
+			RefreshHeaderRow(0);
+			ActualList->RebuildList();
+		}
+		else
+		{
+			ActualList->RequestListRefresh();
+		}
 	}
-	
-	Invalidate(EInvalidateWidgetReason::Paint);	
 }
 
 void SPDStatList::PrepareData()
 {
+	InitializeFonts();
+	
 	UPDStatHandler* SelectedStatHandler = UPDStatSubsystem::Get()->StatHandlers.FindRef(OwnerID);
-	if (SelectedStatHandler != nullptr)
+	BindToStatHandler(SelectedStatHandler);
+	if (SelectedStatHandler == nullptr || StatsAsSharedArray == nullptr) { return; }
+
+	const TArray<FPDStatNetDatum>& StatItems = SelectedStatHandler->StatList.Items;
+	for (int32 StatIdx = 0; StatIdx < StatItems.Num(); StatIdx++)
+	{
+		FPDStatStatics::AcquireSharedViewEntry(RowData, StatIdx) = StatItems[StatIdx];
+	}
+	RowData.SetNum(StatItems.Num(), false);
+
+	RefreshFilteredView();
+}
+
+void SPDStatList::SetCategoryFilter(const FGameplayTag& InCategoryFilter)
+{
+	if (CategoryFilter == InCategoryFilter) { return; }
+	
+	CategoryFilter = InCategoryFilter;
+	RefreshFilteredView();
+
+	const TSharedPtr<SListView<TSharedPtr<FPDStatNetDatum>>>& ActualList = HeaderDataViews.Value.ListView;
+	if (ActualList.IsValid()) { ActualList->RequestListRefresh(); }
+}
+
+void SPDStatList::SetSortMode(EPDStatListSortMode InSortMode)
+{
+	if (SortMode == InSortMode) { return; }
+
+	SortMode = InSortMode;
+	if (SortMode == EPDStatListSortMode::None)
+	{
+		RefreshFilteredView(); // Restores the owners order
+	}
+	else
+	{
+		SortView();
+	}
+
+	const TSharedPtr<SListView<TSharedPtr<FPDStatNetDatum>>>& ActualList = HeaderDataViews.Value.ListView;
+	if (ActualList.IsValid()) { ActualList->RequestListRefresh(); }
+}
+
+void SPDStatList::BindToStatHandler(UPDStatHandler* StatHandler)
+{
+	if (BoundStatHandler.Get() == StatHandler && (StatHandler == nullptr || StatUpdatedHandle.IsValid())) { return; }
+
+	if (UPDStatHandler* PreviousStatHandler = BoundStatHandler.Get())
+	{
+		PreviousStatHandler->OnStatDatumUpdated.Remove(StatUpdatedHandle);
+	}
+	StatUpdatedHandle.Reset();
+	RowData.Reset();
+	
+	BoundStatHandler = StatHandler;
+	if (StatHandler == nullptr) { return; }
+	
+	StatUpdatedHandle = StatHandler->OnStatDatumUpdated.AddSP(this, &SPDStatList::OnStatDatumUpdated);
+}
+
+void SPDStatList::OnStatDatumUpdated(int32 StatIndex, const FPDStatNetDatum& Datum, EPDStatNetOperation Operation)
+{
+	const TSharedPtr<SListView<TSharedPtr<FPDStatNetDatum>>>& ActualList = HeaderDataViews.Value.ListView;
+	if (ActualList.IsValid() == false || StatsAsSharedArray == nullptr) { return; }
+
+	switch (Operation)
 	{
-		for (const FPDStatNetDatum& Item : SelectedStatHandler->StatList.Items)
+	case EPDStatNetOperation::REMOVE:
+		{
+			// The datum is still in the list at this point and removals may re-order the fastarray,
+			// so hide the row now and re-resolve all rows once the update has been applied
+			if (RowData.IsValidIndex(StatIndex)) { StatsAsSharedArray->Remove(RowData[StatIndex]); }
+			ActualList->RequestListRefresh();
+			
+			if (bIsPendingFullRefresh) { break; }
+			bIsPendingFullRefresh = true;
+			RegisterActiveTimer(0.0f, FWidgetActiveTimerDelegate::CreateLambda(
+				[this](double, float)
+				{
+					bIsPendingFullRefresh = false;
+					PrepareData();
+					HeaderDataViews.Value.ListView->RequestListRefresh();
+					return EActiveTimerReturnType::Stop;
+				}));
+			break;
+		}
+	case EPDStatNetOperation::ADDNEW:
+		{
+			const bool bIsNewRow = RowData.IsValidIndex(StatIndex) == false || RowData[StatIndex].IsValid() == false;
+			FPDStatStatics::AcquireSharedViewEntry(RowData, StatIndex) = Datum;
+			if (bIsNewRow && PassesCategoryFilter(Datum))
+			{
+				StatsAsSharedArray->Emplace(RowData[StatIndex]);
+				SortView();
+			}
+			ActualList->RequestListRefresh();
+			break;
+		}
+	case EPDStatNetOperation::CHANGE:
 		{
-			TSharedRef<FPDStatNetDatum> SharedNetDatum = MakeShared<FPDStatNetDatum>(Item);
-			StatsAsSharedArray->Emplace(SharedNetDatum);
+			if (RowData.IsValidIndex(StatIndex) == false || RowData[StatIndex].IsValid() == false)
+			{
+				OnStatDatumUpdated(StatIndex, Datum, EPDStatNetOperation::ADDNEW);
+				break;
+			}
+			
+			const TSharedPtr<FPDStatNetDatum>& Row = RowData[StatIndex];
+			*Row.Get() = Datum;
+			
+			if (SortMode != EPDStatListSortMode::None && SortMode != EPDStatListSortMode::Tag)
+			{
+				SortView();
+				ActualList->RequestListRefresh();
+			}
+
+			// Rows that are not generated (scrolled out of view) will read the new values when they are generated
+			const TSharedPtr<ITableRow> TableRow = ActualList->WidgetFromItem(Row);
+			if (TableRow.IsValid()) { TableRow->AsWidget()->Invalidate(EInvalidateWidgetReason::Layout); }
+			break;
 		}
 	}
+}
+
+void SPDStatList::RefreshFilteredView()
+{
+	if (StatsAsSharedArray == nullptr) { return; }
+
+	StatsAsSharedArray->Reset(RowData.Num());
+	for (const TSharedPtr<FPDStatNetDatum>& Row : RowData)
+	{
+		if (Row.IsValid() && PassesCategoryFilter(*Row.Get())) { StatsAsSharedArray->Emplace(Row); }
+	}
+	SortView();
+}
 
-	InitializeFonts();
+void SPDStatList::SortView()
+{
+	if (StatsAsSharedArray == nullptr) { return; }
+	
+	switch (SortMode)
+	{
+	case EPDStatListSortMode::None:
+		break;
+	case EPDStatListSortMode::Tag:
+		StatsAsSharedArray->StableSort([](const TSharedPtr<FPDStatNetDatum>& A, const TSharedPtr<FPDStatNetDatum>& B)
+			{ return A->ProgressionTag.GetTagName().Compare(B->ProgressionTag.GetTagName()) < 0; });
+		break;
+	case EPDStatListSortMode::Level:
+		StatsAsSharedArray->StableSort([](const TSharedPtr<FPDStatNetDatum>& A, const TSharedPtr<FPDStatNetDatum>& B)
+			{ return A->CurrentLevel > B->CurrentLevel; });
+		break;
+	case EPDStatListSortMode::Experience:
+		StatsAsSharedArray->StableSort([](const TSharedPtr<FPDStatNetDatum>& A, const TSharedPtr<FPDStatNetDatum>& B)
+			{ return A->CurrentExperience > B->CurrentExperience; });
+		break;
+	case EPDStatListSortMode::Value:
+		StatsAsSharedArray->StableSort([](const TSharedPtr<FPDStatNetDatum>& A, const TSharedPtr<FPDStatNetDatum>& B)
+			{ return A->GetAppliedValue() > B->GetAppliedValue(); });
+		break;
+	}
+}
+
+bool SPDStatList::PassesCategoryFilter(const FPDStatNetDatum& StatNetDatum) const
+{
+	return CategoryFilter.IsValid() == false || StatNetDatum.ProgressionTag.MatchesTag(CategoryFilter);
 }
 
 TSharedPtr<SHeaderRow> SPDStatList::RefreshHeaderRow(int32 HeaderRowIdx)
@@ -137,12 +303,17 @@ TSharedRef<ITableRow> SPDStatList::MakeListViewWidget_AllStatData(TSharedPtr<FPD
 
 	const FText StatNameAsText     = FText::FromString(UPDStatSubsystem::GetTagNameLeaf(StatTag));
 	const FText StatCategoryAsText = FText::FromString(UPDStatSubsystem::GetTagCategory(StatTag));
-	
-	const FText LevelAsText        = FText::FromString(FString::FromInt(CurrentStatNetDatum.CurrentLevel));
-	const FText ExperienceAsText   = FText::FromString(FString::FromInt(CurrentStatNetDatum.CurrentExperience));
 
-	const FText AppliedValueAsText = FText::FromString(FString::Printf(TEXT("%lf"), CurrentStatNetDatum.GetAppliedValue()));
-	const FText ModifiersAsText    = FText::FromString(FString::Printf(TEXT("%lf"), CurrentStatNetDatum.GetProcessedCrossBehaviour()));
+	// Values are bound to the shared row data, so updates only need to invalidate this row instead of regenerating it
+	const TAttribute<FText> LevelAsText = TAttribute<FText>::CreateLambda(
+		[InItem]() { return FText::FromString(FString::FromInt(InItem->CurrentLevel)); });
+	const TAttribute<FText> ExperienceAsText = TAttribute<FText>::CreateLambda(
+		[InItem]() { return FText::FromString(FString::FromInt(InItem->CurrentExperience)); });
+
+	const TAttribute<FText> AppliedValueAsText = TAttribute<FText>::CreateLambda(
+		[InItem]() { return FText::FromString(FString::Printf(TEXT("%lf"), InItem->GetAppliedValue())); });
+	const TAttribute<FText> ModifiersAsText = TAttribute<FText>::CreateLambda(
+		[InItem]() { return FText::FromString(FString::Printf(TEXT("%lf"), InItem->GetProcessedCrossBehaviour())); });
 
 	
 	//
@@ -20,6 +20,8 @@ struct FPDStatKeyFuncs : BaseKeyFuncs<FPDStatMapping, FGameplayTag, false>
 	static uint32 GetKeyHash(const FGameplayTag& Key) { return GetTypeHash(Key); }
 };
 
+/** @brief Per-item stat notification. Passes the index of the datum in 'StatList.Items', the datum itself and what happened to it */
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FPDOnStatDatumUpdated, int32 /*StatIndex*/, const FPDStatNetDatum& /*Datum*/, EPDStatNetOperation /*Operation*/);
 
 /** @brief Progression system network manager */
 UCLASS(Blueprintable)
@@ -29,9 +31,19 @@ class PDBASEPROGRESSION_API UPDStatHandler : public UActorComponent
 
 public:
 
+	/** @brief Sets ourselves as the owner of 'StatList' so the fastarray can route its per-item callbacks to us */
+	virtual void PostInitProperties() override;
 	/** @brief Registers this StatHandler with the UPDStatSubsystem  */
 	virtual void BeginPlay() override;
 
+	/** @brief Called by 'StatList' when a single datum has been added, changed or is about to be removed.
+	 * @details Broadcasts 'OnStatDatumUpdated' so views can update only the affected entry. Flags the local mappings for a rebuild on adds/removals */
+	void OnDatumUpdated(const FPDStatNetDatum* Datum, EPDStatNetOperation Operation);
+	/** @brief Called by 'StatList' after a replicated update has been applied. Rebuilds 'LocalStatMappings' if entries were added or removed */
+	void PostStatListReceived();
+	/** @brief Rebuilds 'LocalStatMappings' from the current entries in 'StatList' */
+	void RebuildLocalStatMappings();
+
 	/** @brief Finds the stat and returns it's applied value, if it exists.
 	 *  @details If it exists then return the applied stat value, otherwise return 0*/
 	UFUNCTION(BlueprintCallable)
@@ -43,10 +55,17 @@ public:
 	void IncreaseStatLevel(const FGameplayTag& StatTag, int32 LevelDelta = 1);
 
 	/** @brief Finds the stat and increases it's experience by the given amount, if the owner has complete authority .
-	 *  @details Increases experience and in-case we increase level it calls IncreaseStatLevel*/
+	 *  @details Increases experience and resolves every level-up the new experience total reaches */
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable)
 	void IncreaseStatExperience(const FGameplayTag& StatTag, int32 ExperienceDelta);	
 
+	/** @brief Applies any number of level and experience changes in one pass, if the owner has complete authority.
+	 *  @details Each touched stat resolves its final level once, grants its tokens from the subsystems baked prefix-sums
+	 *  and then the cross-behaviour changes are accumulated per affected stat and applied once.
+	 *  Every touched stat is marked dirty a single time so the whole batch goes out as one replication update */
+	UFUNCTION(BlueprintCallable)
+	void ApplyProgressionBatch(const TArray<FPDStatProgressionDelta>& ProgressionDeltas);
+
 	/** @brief Finds a skill stat and attempts to unlock it, if the owner has complete authority .
 	 *  @details Sets a skill stat to level 1, fails if we do not have the necessary tokens to unlock it
 	 *  @todo Apply skill effects (Also, consider allowing stats to have stat tied to them, stats that unlock and activate upon this stat unlocking)*/
@@ -62,8 +81,16 @@ public:
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable)
 	void SetClass(const FGameplayTag& ClassTag);
 
-	/** @brief Called by unlock and lock skill, handles the actual logic. See@LockSkill & @UnlockSkill  */
+	/** @brief Called by unlock and lock skill, handles the actual logic. See@LockSkill & @UnlockSkill
+	 * @details Checks against the subsystems compiled skill graph: unlocking needs all prerequisite skills unlocked and the token requirements met,
+	 * locking fails while any skill that requires this one is still unlocked */
 	void ModifySkill(const FGameplayTag& SkillTag, bool bUnlock);
+	/** @brief Rebuilds 'UnlockedSkills' from the skill stats currently in 'StatList' */
+	void SyncUnlockedSkills();
+	/** @brief Updates the bit in 'UnlockedSkills' of the skill 'Datum' is the stat for, if it is one. Called for every added/changed/removed stat */
+	void UpdateUnlockedSkill(const FPDStatNetDatum& Datum, bool bRemoved);
+	/** @brief Sets the level of a skills stat, adding and mapping the stat if we do not have it yet */
+	void SetSkillStatLevel(const FGameplayTag& SkillTag, int32 Level);
 	/** @brief Check owner net-mode/role. If we have appropriate authority in the correct context then return true. 
 	 * @details - Returns true if we are standalone or server and we have authority.
 	 * @details - Return false proxy or max/none owner roles. and if NetMode is NM_Client*/
@@ -72,6 +99,8 @@ public:
 	/** @brief Grants the owner all tokens granted between the current level and the new level  */
 	UFUNCTION(BlueprintCallable)
 	void GrantTokens(const FGameplayTag& StatTag, int32 LevelDelta, int32 CurrentLevel);
+	/** @brief Grants the owner all tokens granted by levelling from 'OldLevel' to 'NewLevel', resolved from the subsystems baked prefix-sums */
+	void GrantTokensBetweenLevels(const FGameplayTag& StatTag, int32 OldLevel, int32 NewLevel);
 
 	/** @brief Boiler plate for replication setup */
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
@@ -99,6 +128,17 @@ public:
 	/** @brief Locally tracked set of tags and indices in 'StatList',
 	 * @note has a custom key matching function so we can resolve an FPDStatMapping::index from a given tag */
 	TSet<FPDStatMapping, FPDStatKeyFuncs> LocalStatMappings;
+
+	/** @brief Fires once per added/changed/removed stat, on the server when a stat is marked dirty and on clients when it replicates */
+	FPDOnStatDatumUpdated OnStatDatumUpdated;
+
+	/** @brief Set when entries have been added or removed on a client, 'LocalStatMappings' is rebuilt after the update has been received */
+	bool bLocalStatMappingsDirty = false;
+
+	/** @brief Locally tracked unlocked skills, indexed by the subsystems compiled skill graph.
+	 * @note Mirrors the skill stats in 'StatList', updated per changed stat from 'OnDatumUpdated' as skill levels may change through other paths.
+	 * Fully re-synced by 'ModifySkill' only when its size does not match the compiled skill graph */
+	TBitArray<> UnlockedSkills;
 };
 
 
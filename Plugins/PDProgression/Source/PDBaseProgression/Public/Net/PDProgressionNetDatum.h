@@ -8,6 +8,18 @@
 #include "Net/Serialization/FastArraySerializer.h"
 #include "PDProgressionNetDatum.generated.h"
 
+class UPDStatHandler;
+
+/** @brief Enum to tell us what type of operation we should expect,
+ * in different contexts related to the stat netdatum */
+UENUM()
+enum EPDStatNetOperation
+{
+	REMOVE,
+	ADDNEW,
+	CHANGE,
+};
+
 /** @brief Replicated datum. This is the definition of a 'packet' of data we transmit per entry of a given 'fastarray'
  * @note Replicates values that represent the stats tag, it's current crossbehaviour value, it's current level and experience
  * @note Also has some helper functions to process and apply the crossbehaviour to the current stat value
@@ -69,6 +81,8 @@ struct PDBASEPROGRESSION_API FPDStatList : public FFastArraySerializer
 	
 	/** @brief Marks 'Items' so the replication system knows it should treat it differently  */
 	bool NetSerialize(FNetDeltaSerializeInfo& DeltaParams);
+	/** @brief Called on the client after a replicated update has been applied. Lets our owner rebuild its local tag mappings if entries were added or removed */
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
 
 	/** @note Adds any given stat to the itemlist */
 	void AddStat(const FGameplayTag& StatTag, int32 StatExperience, int32 StatLevel);
@@ -76,6 +90,13 @@ struct PDBASEPROGRESSION_API FPDStatList : public FFastArraySerializer
 	void AddActiveEffect(const FGameplayTag& StatTag, int32 StatExperience, int32 StatLevel);
 	/** @note Just calls AddStat, is a placeholder impl. reserved for later use */
 	void AddPassiveEffect(const FGameplayTag& StatTag, int32 StatExperience, int32 StatLevel);
+	/** @brief Marks the item dirty for replication and notifies our owner locally,
+	 * @note the fastarray callbacks only fire on clients, this keeps listeners on the server/standalone in sync */
+	void MarkStatDirty(FPDStatNetDatum& Item);
+
+	/** @brief The handler that owns this list, receives the per-item replication callbacks */
+	UPROPERTY(NotReplicated, Transient)
+	TObjectPtr<UPDStatHandler> OwningObject = nullptr;
 
 	/** @brief Actual inner list of items that we want to replicate */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
@@ -31,6 +31,19 @@ public:
 	TArray<TSoftObjectPtr<UDataTable>> ProgressionTreeTables;	
 };
 
+/** @brief Derived lookup data of the stat-system tables, built off the game-thread and moved into 'UPDStatSubsystem' when ready */
+struct FPDStatSubsystemTableData
+{
+	TMap<FGameplayTag, FPDSkillTree*> TreeTypes;
+	TMap<FGameplayTag, FGameplayTag> SkillToTreeMapping;
+	FPDCompiledSkillGraph CompiledSkillGraph;
+	TMap<FGameplayTag, FPDProgressionClassRow*> ClassTypes;
+	TMap<FGameplayTag, FPDStatsRow*> DefaultStats;
+	TMap<FGameplayTag, TArray<FGameplayTag>> StatCrossBehaviourMap;
+	TMap<FGameplayTag, TArray<FGameplayTag>> StatCrossBehaviourBackMapped;
+	TMap<FGameplayTag, FPDStatProgressionTable> StatProgressionTables;
+};
+
 /** @brief The subsystem for the stat system.
  * @details Handles mapping the stat-system tables for quick downstream access to data and common calculations in the stat-system */
 UCLASS(Blueprintable)
@@ -38,11 +51,19 @@ class PDBASEPROGRESSION_API UPDStatSubsystem : public UEngineSubsystem
 {
 	GENERATED_BODY()
 public:
-	/** @brief Singleton-style getter, used for simplifying access, thus it is used for code-productivity */
+	/** @brief Singleton-style getter, used for simplifying access, thus it is used for code-productivity
+	 * @note Flushes the table ingestion if it is called on the game-thread before the tables have been published */
 	static UPDStatSubsystem* Get();
 
-	/** @brief Maps all the the classes, skilltrees and stats, along-side stat crossbehaviours*/
+	/** @brief Starts the table ingestion */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** @brief Requests the asynchronous ingestion of all the progression tables, see 'BuildTableData' */
 	void LatentInitialization();
+	/** @brief Maps all the the classes, skilltrees and stats, along-side stat crossbehaviours. Runs on a worker thread */
+	static void BuildTableData(const TArray<UDataTable*>& Tables, FPDStatSubsystemTableData& OutData);
+	/** @brief Moves the built table data in place. Runs on the game-thread */
+	void PublishTableData(FPDStatSubsystemTableData&& Data);
 
 	/** @brief Resolves the cross behaviour for the given stat, in case it has a 'RuleSetLevelCurveMultiplier' set. Otherwise do not modify per level  */
 	void ResolveCrossBehaviours(
@@ -101,6 +122,10 @@ public:
 	 * @note Returns a nullptr if the class is not found */
 	FPDStatsRow* GetStatTypeDataPtr(const FGameplayTag& RequestedStat) const;
 
+	/** @brief Stat-tag keyed access to the baked experience/token lookups of 'Stats',
+	 * @note Returns a nullptr if the stat is not found */
+	const FPDStatProgressionTable* GetStatProgressionTable(const FGameplayTag& RequestedStat) const;
+
 	/** @brief Gets the name of the tag, at the depth this tag is at. meaning ParentA.ParentB.ThisTag returns "ThisTag" */
 	UFUNCTION(BlueprintCallable)
 	static FString GetTagNameLeaf(const FGameplayTag& Tag);
@@ -118,6 +143,9 @@ public:
 
 	/** @brief Tree table row tags mapped by their containing skill-tags. Used for fast down-stream access  */
 	TMap<FGameplayTag, FGameplayTag> SkillToTreeMapping;
+
+	/** @brief All skill-trees compiled into a flat graph, used for constant-time unlock/lock checks */
+	FPDCompiledSkillGraph CompiledSkillGraph;
 	
 	/** @brief Class table row entries mapped by their class-tag. Used for fast down-stream access */
 	TMap<FGameplayTag, FPDProgressionClassRow*> ClassTypes;
@@ -129,6 +157,14 @@ public:
 	/** @brief Key is a 'Tag' that is affected by value of the 'List of Tags' */
 	TMap<FGameplayTag, TArray<FGameplayTag>> StatCrossBehaviourBackMapped;
 
+	/** @brief Baked experience thresholds and token prefix-sums, mapped by their stat-tag. Used by batched progression */
+	TMap<FGameplayTag, FPDStatProgressionTable> StatProgressionTables;
+
+
+	/** @brief Has the table data been published */
+	bool bHasPublishedTableData = false;
+	/** @brief Name of our table ingestion */
+	inline static const FName TableIngestionName = TEXT("PDStatSubsystem");
 
 	/** @brief Mapped stat-handlers, mapped by owner-/player-id,
 	 * @note Will have all the games stat-handlers on the server. If on the client, it will 1 entry per player connected via the same client  */
@@ -17,6 +17,7 @@
 class FPaintArgs;
 class FSlateWindowElementList;
 struct FSlateBrush;
+class UPDStatHandler;
 
 
 // @todo (PRIO 1) Need a widget for a button to upgrade a stat and a developer setting to tell if the button should be visible or not, this is be able to cater to different players // Todo also make the inventory system
@@ -37,6 +38,9 @@ public:
 	SLATE_BEGIN_ARGS(SPDSelectedStat_LevelData){}
 	SLATE_END_ARGS()
 
+	/** @brief Unbinds from the stat handler we are listening to, if any */
+	virtual ~SPDSelectedStat_LevelData() override;
+
 	/** @brief Copies parameters into member properties then calls 'PrepareData' and 'UpdateChildSlot'.
 	 * Is used by slate when a new widget is constructed */
 	void Construct(
@@ -70,8 +74,13 @@ public:
 	/** @brief Builds the data-view headers and the child-slot composition (Defines the widget-layout) */
 	virtual void UpdateChildSlot() override;
 
-	/** @brief Resolves the token types and amounts we will grant upon reaching the next level, caches the results */
+	/** @brief Resolves the token types and amounts we will grant upon reaching the next level, caches the results
+	 * @note Refills the data-views in-place, reusing their already allocated entries */
 	void PrepareData();
+	/** @brief Listens to per-item updates from 'StatHandler', drops any previous binding */
+	void BindToStatHandler(UPDStatHandler* StatHandler);
+	/** @brief Per-item update from our stat handler. Re-resolves our data-views only if the selected stat changed, as nothing else affects them */
+	void OnStatDatumUpdated(int32 StatIndex, const FPDStatNetDatum& Datum, EPDStatNetOperation Operation);
 
 	//
 	// Translation
@@ -111,6 +120,9 @@ public:
 	SLATE_BEGIN_ARGS(SPDSelectedStat_OffsetData){}
 	SLATE_END_ARGS()
 
+	/** @brief Unbinds from the stat handler we are listening to, if any */
+	virtual ~SPDSelectedStat_OffsetData() override;
+
 	/** @brief Copies parameters into member properties then calls 'PrepareData' and 'UpdateChildSlot'.
 	 * Is used by slate when a new widget is constructed */
 	void Construct(const FArguments& InArgs,
@@ -119,8 +131,13 @@ public:
 		TArray<TSharedPtr<FPDStatViewModifySource>>& ArrayRef,
 		const FPDWidgetBaseSettings& WidgetSettingsUpdate);
 
-	/** @brief Resolves the expected cross behaviour value increase for next level, caches the results */
+	/** @brief Resolves the expected cross behaviour value increase for next level, caches the results
+	 * @note Refills the data-view in-place, reusing its already allocated entries */
 	void PrepareData();
+	/** @brief Listens to per-item updates from 'StatHandler', drops any previous binding */
+	void BindToStatHandler(UPDStatHandler* StatHandler);
+	/** @brief Per-item update from our stat handler. Re-resolves our data-view only if one of the stats that affect the selected stat changed */
+	void OnStatDatumUpdated(int32 StatIndex, const FPDStatNetDatum& Datum, EPDStatNetOperation Operation);
 	/** @brief Refreshes the elements in 'HeaderDataViews.Value.DataViewPtr' and calls rebuild on 'HeaderDataViews.Value.ListView'  */
 	void Refresh(
 		int32 InOwnerID,
@@ -15,6 +15,7 @@
 class FPaintArgs;
 class FSlateWindowElementList;
 struct FSlateBrush;
+class UPDStatHandler;
 
 
 // @todo (PRIO 1) Need a widget for a button to upgrade a stat and a developer setting to tell if the button should be visible or not, this is be able to cater to different players // Todo also make the inventory system
@@ -22,6 +23,16 @@ struct FSlateBrush;
 
 // @todo (PRIO 3/BACKLOG) Need a widget for selecting the Category : Create a view that shows other, unlocked, stats in the same category
 
+/** @brief How 'SPDStatList' orders its visible rows */
+enum class EPDStatListSortMode : uint8
+{
+	None,       /**< Keeps the order of the owners stat-list */
+	Tag,        /**< Sorts on the full stat tag, which groups the rows by category */
+	Level,      /**< Sorts on the current level, highest first */
+	Experience, /**< Sorts on the current experience, highest first */
+	Value,      /**< Sorts on the applied value, highest first */
+};
+
 /** @brief @inprogress Widget for data regarding all the users stats, has entries such as Category/Stat-name/levels/experience/value-offsets */
 class PDBASEPROGRESSION_API SPDStatList
 	: public SCompoundWidget
@@ -35,15 +46,36 @@ public:
  		SLATE_EVENT(FOnUserScrolled, OnUserScrolled)
  		SLATE_EVENT(FOnClicked, OnUserClicked)
 	SLATE_END_ARGS()
+
+	/** @brief Unbinds from the stat handler we are listening to, if any */
+	virtual ~SPDStatList() override;
 	
 	/** @brief Stores a pointer to the copied save data and then Calls UpdateChildSlot, passing ArrayRef as the opaquedata parameter */
 	void Construct(const FArguments& InArgs, int32 InOwnerID, TArray<TSharedPtr<FPDStatNetDatum>>& DataViewRef, const FPDWidgetBaseSettings& WidgetSettingsUpdate);
 	/** @brief Refreshes our list view, used when there has been an update to the data we want to view 
 	 * @details Refreshes the elements in 'HeaderDataViews.Key.DataViewPtr' and calls rebuild on 'HeaderDataViews.Key.ListView'  */
 	void Refresh(int32 InOwnerID, TArray<TSharedPtr<FPDStatNetDatum>>& DataViewRef, const FPDWidgetBaseSettings& WidgetSettingsUpdate);
-	/** @brief Prepares our view data. Iterates our owners StatList and fills 'StatsAsSharedArray' accordingly  */
+	/** @brief Prepares our view data. Copies our owners StatList into 'RowData', reusing the already allocated rows, then refills 'StatsAsSharedArray' from it
+	 * @note Leaves 'StatsAsSharedArray' untouched if we have no owning stat handler, so any design-time test entries are kept */
 	void PrepareData();
 
+	/** @brief Only shows stats whose tag matches 'InCategoryFilter', an empty tag shows all stats. Refills the view in-place */
+	void SetCategoryFilter(const FGameplayTag& InCategoryFilter);
+	/** @brief Changes how the visible rows are ordered and re-sorts the view in-place */
+	void SetSortMode(EPDStatListSortMode InSortMode);
+	
+	/** @brief Listens to per-item updates from 'StatHandler', drops any previous binding and the rows that belonged to it */
+	void BindToStatHandler(UPDStatHandler* StatHandler);
+	/** @brief Per-item update from our stat handler. Copies the datum into its existing row and only invalidates that rows widget,
+	 * @note Adds/removes and value changes that affect the current sort order will refresh the list-view items, without rebuilding the existing rows */
+	void OnStatDatumUpdated(int32 StatIndex, const FPDStatNetDatum& Datum, EPDStatNetOperation Operation);
+	/** @brief Refills 'StatsAsSharedArray' from 'RowData' with the category filter applied, then sorts it. Keeps the arrays allocation */
+	void RefreshFilteredView();
+	/** @brief Sorts 'StatsAsSharedArray' in-place based on 'SortMode' */
+	void SortView();
+	/** @brief Returns true if the stat should be visible with our current category filter */
+	bool PassesCategoryFilter(const FPDStatNetDatum& StatNetDatum) const;
+
 	/** @brief Defines our header definition, is called on construction but is also called on table changes after construction */
 	virtual TSharedPtr<SHeaderRow> RefreshHeaderRow(int32 HeaderRowIdx = 0) override;
 
@@ -55,7 +87,16 @@ public:
 	void OnComponentSelected_AllStatData(TSharedPtr<FPDStatNetDatum> InItem, ESelectInfo::Type InSelectInfo);
 	
 	/** @brief Array 'View' that is used to display the data related to this editor widget */
-	TArray<TSharedPtr<FPDStatNetDatum>>* StatsAsSharedArray;
+	TArray<TSharedPtr<FPDStatNetDatum>>* StatsAsSharedArray = nullptr;
+
+	/** @brief Shared row data, indexed the same as our owners 'StatList.Items'. Updates are copied into these in-place so the list-view keeps its generated rows */
+	TArray<TSharedPtr<FPDStatNetDatum>> RowData;
+	/** @brief Category we filter the view on, an empty tag shows all stats */
+	FGameplayTag CategoryFilter;
+	/** @brief How the visible rows are currently ordered */
+	EPDStatListSortMode SortMode = EPDStatListSortMode::None;
+	/** @brief Set while we have a full refresh queued for the next frame, after a removal */
+	bool bIsPendingFullRefresh = false;
 
 	//
 	// Translation	
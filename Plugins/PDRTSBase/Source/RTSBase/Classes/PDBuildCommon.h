@@ -361,6 +361,10 @@ struct PDRTSBASE_API FPDBuildAction : public FTableRowBase
 	/** @brief The cost of this action, defaults to free */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RTSBase|WorkerUnits")
 	TMap<FGameplayTag, int32> ActionCost{};
+
+	/** @brief Seconds it takes a building to produce one unit, only used when the action tag is a unit type (TAG_AI_Type). Zero produces on the next production tick */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RTSBase|WorkerUnits", Meta = (ClampMin = 0))
+	double ProductionTime = 0.0;
 	
 	/** @brief Not needed, but use to display clearer name, with being set to nothing the name will be tha buildables tag converted to a name */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RTSBase|WorkerUnits")
@@ -498,6 +502,119 @@ struct PDRTSBASE_API FPDBuildWorker : public FTableRowBase
 };
 
 
+/** @brief Flat, index-addressed one-to-many relationship between interned build tags.
+ * Values of each key are deduplicated and sorted, so containment checks are a binary search over a contiguous slice */
+struct PDRTSBASE_API FPDBuildTagRelation
+{
+	/** @brief Flattens the source relation. Keys outside of [0, KeyCount) are dropped */
+	void Bake(const int32 KeyCount, const TMap<int32, TArray<int32>>& Source);
+	/** @brief Clears the relation */
+	void Reset();
+
+	/** @brief Returns the values related to the given key, empty if the key is out of range */
+	TConstArrayView<int32> Get(const int32 KeyIdx) const;
+	/** @brief Is the value related to the given key */
+	bool Contains(const int32 KeyIdx, const int32 ValueIdx) const;
+
+	/** @brief Start offset into 'Values' per key, has one trailing entry so that 'Offsets[Key + 1]' is always the end */
+	TArray<int32> Offsets{};
+	/** @brief All related values, packed per key */
+	TArray<int32> Values{};
+};
+
+/** @brief Lookup tables baked from the build context, worker and buildable tables when they are loaded.
+ * Every tag the tables reference is interned to an index, the row data and relationships are then addressed by that index */
+struct PDRTSBASE_API FPDBuildLookupTables
+{
+	/** @brief Returns the index of the tag, interning it if it has not been seen yet */
+	int32 InternTag(const FGameplayTag& Tag);
+	/** @brief Returns the index of the tag, or INDEX_NONE if it was never interned */
+	int32 FindTagIndex(const FGameplayTag& Tag) const;
+	/** @brief Returns the tag at the given index, or the empty tag if out of range */
+	const FGameplayTag& GetTag(const int32 TagIdx) const;
+	/** @brief Clears all tables */
+	void Reset();
+
+	/** @brief Interned tags, the index into this array is the tags index in every other table */
+	TArray<FGameplayTag> InternedTags{};
+	/** @brief Reverse lookup of 'InternedTags' */
+	TMap<FGameplayTag, int32> TagIndices{};
+
+	/** @brief Buildable data per tag index, nullptr where the tag is not a buildable tag */
+	TArray<const FPDBuildableData*> BuildableData{};
+	/** @brief Build contexts per tag index, nullptr where the tag is not a build context tag */
+	TArray<const FPDBuildContext*> BuildContexts{};
+	/** @brief Workers per tag index, nullptr where the tag is not a worker type tag */
+	TArray<const FPDBuildWorker*> Workers{};
+
+	/** @brief Buildable tag index -> parent build context tag indices */
+	FPDBuildTagRelation ParentContexts_PerBuildable{};
+	/** @brief Build context tag index -> worker type tag indices that are granted the context */
+	FPDBuildTagRelation Workers_PerBuildContext{};
+	/** @brief Buildable tag index -> worker type tag indices that may build it */
+	FPDBuildTagRelation ValidWorkers_PerBuildable{};
+};
+
+
+/** @brief Result of testing a single cell of a placement footprint against the occupancy grid */
+USTRUCT(BlueprintType)
+struct PDRTSBASE_API FPDBuildFootprintCell
+{
+	GENERATED_BODY()
+
+	/** @brief The grid cell */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "RTSBase|BuildSystem")
+	FIntPoint Cell = FIntPoint::ZeroValue;
+	/** @brief World location of the cells center, at the footprints lowest point */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "RTSBase|BuildSystem")
+	FVector CellCenter = FVector::ZeroVector;
+	/** @brief Is the cell occupied by a building, resource or other blocking occupant */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "RTSBase|BuildSystem")
+	bool bBlocked = false;
+};
+
+/** @brief 2D occupancy grid of buildings, resources and other blocking occupants.
+ * Occupants are added, moved and removed incrementally, each cell keeps a count of how many occupants cover it.
+ * Has no dependency on the physics scene, placements are validated by testing the cells of a footprint */
+struct PDRTSBASE_API FPDBuildOccupancyGrid
+{
+	explicit FPDBuildOccupancyGrid(const double InCellSize = 200.0) : CellSize(FMath::Max(InCellSize, UE_KINDA_SMALL_NUMBER)) {}
+
+	/** @brief Adds the occupant or, if it already exists, moves it to cover the cells of the new bounds */
+	void SetOccupant(const int32 OccupantID, const FBox& WorldBounds);
+	/** @brief Removes the occupant and releases its cells. Returns false if the occupant was not in the grid */
+	bool RemoveOccupant(const int32 OccupantID);
+	/** @brief Clears the grid */
+	void Reset();
+
+	/** @brief Tests every cell of the footprint, writes one result per cell into OutCells.
+	 * @return True if no cell of the footprint is blocked */
+	bool ValidateFootprint(const FBox& Footprint, TArray<FPDBuildFootprintCell>& OutCells) const;
+	/** @brief Is the cell covered by any occupant */
+	bool IsCellBlocked(const FIntPoint& Cell) const { return CellOccupancy.Contains(Cell); }
+	/** @brief Writes the cells the bounds cover into OutCells. Bounds that only touch a cells edge do not cover it */
+	void GetCoveredCells(const FBox& WorldBounds, TArray<FIntPoint>& OutCells) const;
+	/** @brief Returns the cell containing the location */
+	FIntPoint GetCell(const FVector& Location) const;
+	/** @brief Returns the world location of the center of the cell, at the given height */
+	FVector GetCellCenter(const FIntPoint& Cell, const double Z = 0.0) const;
+	/** @brief Is the occupant in the grid */
+	bool HasOccupant(const int32 OccupantID) const { return OccupantCells.Contains(OccupantID); }
+	/** @brief Amount of occupants in the grid */
+	int32 NumOccupants() const { return OccupantCells.Num(); }
+
+	/** @brief Tolerance applied to the bounds when finding covered cells, so neighbours that share an edge do not block each other */
+	static constexpr double EdgeTolerance = 1.0;
+	
+	/** @brief Size of a cell in unreal units */
+	double CellSize = 200.0;
+	/** @brief Occupant count per covered cell. Cells with no occupants are not stored */
+	TMap<FIntPoint, int32> CellOccupancy{};
+	/** @brief Cells covered per occupant, used to release the cells when an occupant moves or is removed */
+	TMap<int32 /*OccupantID*/, TArray<FIntPoint>> OccupantCells{};
+};
+
+
 /** @brief Build system behaviour settings
  * @todo @refactor turn into datatable row type and set up a table for it, replace current default entry in developer settings
  */
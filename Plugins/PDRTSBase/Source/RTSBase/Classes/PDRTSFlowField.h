@@ -0,0 +1,251 @@
+﻿/* @author: Ario Amin @ Permafrost Development. @copyright: Full BSL(1.1) License included at bottom of the file  */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "PDRTSFlowField.generated.h"
+
+/** @brief Flow-field developer settings, modify in .ini config or in editor project settings */
+UCLASS(Config = "Game", DefaultConfig)
+class PDRTSBASE_API UPDFlowFieldSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UPDFlowFieldSettings(){}
+
+	/** @brief Selection groups with at least this many entities get a flow field instead of a shared navpath */
+	UPROPERTY(Config, EditAnywhere, Category = "FlowField")
+	int32 MinGroupSizeForFlowField = 64;
+
+	/** @brief Size of a single walkability cell, in world units */
+	UPROPERTY(Config, EditAnywhere, Category = "FlowField")
+	double CellSize = 200.0;
+
+	/** @brief Upper limit of cells along either axis, the cell size is grown to fit if the area would exceed it */
+	UPROPERTY(Config, EditAnywhere, Category = "FlowField")
+	int32 MaxGridDimension = 256;
+
+	/** @brief Upper limit of cells in the whole grid, every cell costs a navmesh projection on the game-thread when the field is requested.
+	 *  @note The cell size is grown to fit if the area would exceed it */
+	UPROPERTY(Config, EditAnywhere, Category = "FlowField")
+	int32 MaxGridCells = 4096;
+
+	/** @brief Entities only follow a group flow field if their own target is within this distance of the fields destination.
+	 *  @note Needs to cover the formation spread around the group target, anything further away is treated as a stale field from an older order */
+	UPROPERTY(Config, EditAnywhere, Category = "FlowField")
+	double DestinationMatchRadius = 2000.0;
+
+	/** @brief Padding added around the selection and the destination when sizing the grid */
+	UPROPERTY(Config, EditAnywhere, Category = "FlowField")
+	double GridPadding = 2000.0;
+
+	/** @brief Vertical extent used when projecting cell centers onto the navmesh */
+	UPROPERTY(Config, EditAnywhere, Category = "FlowField")
+	double NavProjectionHeight = 500.0;
+};
+
+/** @brief Coarse 2d walkability grid, one cost byte per cell.
+ * @note Has no dependency on the navigation system unless 'BuildFromNavigation' is called, so synthetic grids can be filled by hand via 'SetCost' */
+struct PDRTSBASE_API FPDFlowFieldGrid
+{
+	/** @brief Cost of a cell that may not be entered */
+	static constexpr uint8 BlockedCost = MAX_uint8;
+
+	/** @brief Resizes the grid and fills every cell with 'DefaultCost' */
+	void Initialize(const FVector2D& InOrigin, double InCellSize, const FIntPoint& InDimensions, uint8 DefaultCost = 1);
+
+	/** @brief Sizes the grid to cover 'Bounds' and marks cells blocked where their center does not project onto the navmesh
+	 *  @note Grows the cell size if 'Bounds' would need more than 'MaxDimension' cells along an axis or more than 'MaxCellCount' cells in total. Leaves all cells walkable if the world has no navigation system */
+	void BuildFromNavigation(UWorld* World, const FBox& Bounds, double InCellSize, int32 MaxDimension, int32 MaxCellCount, double ProjectionHeight);
+
+	/** @brief Is the cell inside the grid */
+	FORCEINLINE bool IsValidCell(const FIntPoint& Cell) const
+	{
+		return Cell.X >= 0 && Cell.Y >= 0 && Cell.X < Dimensions.X && Cell.Y < Dimensions.Y;
+	}
+	/** @brief Flat index of the cell, does not validate */
+	FORCEINLINE int32 ToIndex(const FIntPoint& Cell) const { return Cell.Y * Dimensions.X + Cell.X; }
+	/** @brief Cell from a flat index, does not validate */
+	FORCEINLINE FIntPoint ToCell(const int32 Index) const { return FIntPoint(Index % Dimensions.X, Index / Dimensions.X); }
+
+	/** @brief Floors the world location into a cell, may return a cell outside of the grid */
+	FIntPoint WorldToCell(const FVector& WorldLocation) const;
+	/** @brief World location of the cell center, at height 'Z' */
+	FVector CellToWorld(const FIntPoint& Cell, double Z = 0.0) const;
+
+	/** @brief Cost of the cell, cells outside of the grid are treated as blocked */
+	uint8 GetCost(const FIntPoint& Cell) const;
+	/** @brief Sets the cost of the cell, ignored if the cell is outside of the grid */
+	void SetCost(const FIntPoint& Cell, uint8 Cost);
+	/** @brief Is the cell inside the grid and not blocked */
+	FORCEINLINE bool IsWalkable(const FIntPoint& Cell) const { return GetCost(Cell) != BlockedCost; }
+
+	/** @brief World location of the grids minimum corner */
+	FVector2D Origin = FVector2D::ZeroVector;
+	/** @brief Size of a single cell, in world units */
+	double CellSize = 200.0;
+	/** @brief Cell count along X and Y */
+	FIntPoint Dimensions = FIntPoint::ZeroValue;
+	/** @brief Per-cell cost, row-major */
+	TArray<uint8> Costs;
+};
+
+/** @brief Integration field and per-cell direction towards a single destination.
+ * @note Built once per destination, after which every unit samples it in constant time regardless of group size */
+struct PDRTSBASE_API FPDFlowField
+{
+	/** @brief Integrated cost of a cell that can not reach the destination */
+	static constexpr uint32 UnreachableCost = MAX_uint32;
+	/** @brief Direction value of the goal cell */
+	static constexpr uint8 GoalDirection = 8;
+	/** @brief Direction value of a cell that can not reach the destination */
+	static constexpr uint8 NoDirection = MAX_uint8;
+
+	/** @brief Copies the grid and runs an 8-connected dijkstra outwards from the destination cell, then resolves a direction for every reachable cell.
+	 *  @return false if the destination is outside of the grid or on a blocked cell */
+	bool Build(const FPDFlowFieldGrid& InGrid, const FVector& InDestination);
+
+	/** @brief Direction to move in from 'WorldLocation', in the XY plane.
+	 *  @note Points straight at the destination when inside the goal cell or outside of the grid.
+	 *  @return false if the location can not reach the destination */
+	bool SampleDirection(const FVector& WorldLocation, FVector& OutDirection) const;
+
+	/** @brief Can 'WorldLocation' reach the destination through the field */
+	bool IsReachable(const FVector& WorldLocation) const;
+	/** @brief Is 'WorldLocation' within the destination cell */
+	bool IsInGoalCell(const FVector& WorldLocation) const;
+	/** @brief Integrated cost of the cell, 'UnreachableCost' if outside of the grid or unreachable */
+	uint32 GetIntegratedCost(const FIntPoint& Cell) const;
+
+	/** @brief The walkability grid the field was built on */
+	const FPDFlowFieldGrid& GetGrid() const { return Grid; }
+	/** @brief The destination the field was built towards */
+	const FVector& GetDestination() const { return Destination; }
+
+private:
+	/** @brief Walkability grid copy, kept so sampling does not depend on the source grids lifetime */
+	FPDFlowFieldGrid Grid;
+	/** @brief Destination the field flows towards */
+	FVector Destination = FVector::ZeroVector;
+	/** @brief Cell containing the destination */
+	FIntPoint GoalCell = FIntPoint::NoneValue;
+	/** @brief Per-cell integrated cost to the destination */
+	TArray<uint32> Integration;
+	/** @brief Per-cell neighbour index (0-7), 'GoalDirection' or 'NoDirection' */
+	TArray<uint8> Directions;
+};
+
+/**
+Business Source License 1.1
+
+Parameters
+
+Licensor:             Ario Amin (@ Permafrost Development)
+Licensed Work:        RTSOpen (Source available on github)
+                      The Licensed Work is (c) 2024 Ario Amin (@ Permafrost Development)
+Additional Use Grant: You may make free use of the Licensed Work in a commercial product or service provided these three additional conditions as met; 
+                      1. Must give attributions to the original author of the Licensed Work, in 'Credits' if that is applicable.
+                      2. The Licensed Work must be Compiled before being redistributed.
+                      3. The Licensed Work Source may be linked but may not be packaged into the product or service being sold
+                      4. Must not be resold or repackaged or redistributed as another product, is only allowed to be used within a commercial or non-commercial game project.
+                      5. Teams with yearly budgets larger than 100000 USD must contact the owner for a custom license or buy the framework from a marketplace it has been made available on.
+
+                      "Credits" indicate a scrolling screen with attributions. This is usually in a products end-state
+
+                      "Package" means the collection of files distributed by the Licensor, and derivatives of that collection
+                      and/or of those files..   
+
+                      "Source" form means the source code, documentation source, and configuration files for the Package, usually in human-readable format.
+
+                      "Compiled" form means the compiled bytecode, object code, binary, or any other
+                      form resulting from mechanical transformation or translation of the Source form.
+
+Change Date:          2028-04-17
+
+Change License:       Apache License, Version 2.0
+
+For information about alternative licensing arrangements for the Software,
+please visit: https://permadev.se/
+
+Notice
+
+The Business Source License (this document, or the “License”) is not an Open
+Source license. However, the Licensed Work will eventually be made available
+under an Open Source License, as stated in this License.
+
+License text copyright (c) 2017 MariaDB Corporation Ab, All Rights Reserved.
+“Business Source License” is a trademark of MariaDB Corporation Ab.
+
+-----------------------------------------------------------------------------
+
+Business Source License 1.1
+
+Terms
+
+The Licensor hereby grants you the right to copy, modify, create derivative
+works, redistribute, and make non-production use of the Licensed Work. The
+Licensor may make an Additional Use Grant, above, permitting limited
+production use.
+
+Effective on the Change Date, or the fourth anniversary of the first publicly
+available distribution of a specific version of the Licensed Work under this
+License, whichever comes first, the Licensor hereby grants you rights under
+the terms of the Change License, and the rights granted in the paragraph
+above terminate.
+
+If your use of the Licensed Work does not comply with the requirements
+currently in effect as described in this License, you must purchase a
+commercial license from the Licensor, its affiliated entities, or authorized
+resellers, or you must refrain from using the Licensed Work.
+
+All copies of the original and modified Licensed Work, and derivative works
+of the Licensed Work, are subject to this License. This License applies
+separately for each version of the Licensed Work and the Change Date may vary
+for each version of the Licensed Work released by Licensor.
+
+You must conspicuously display this License on each original or modified copy
+of the Licensed Work. If you receive the Licensed Work in original or
+modified form from a third party, the terms and conditions set forth in this
+License apply to your use of that work.
+
+Any use of the Licensed Work in violation of this License will automatically
+terminate your rights under this License for the current and all other
+versions of the Licensed Work.
+
+This License does not grant you any right in any trademark or logo of
+Licensor or its affiliates (provided that you may use a trademark or logo of
+Licensor as expressly required by this License).
+
+TO THE EXTENT PERMITTED BY APPLICABLE LAW, THE LICENSED WORK IS PROVIDED ON
+AN “AS IS” BASIS. LICENSOR HEREBY DISCLAIMS ALL WARRANTIES AND CONDITIONS,
+EXPRESS OR IMPLIED, INCLUDING (WITHOUT LIMITATION) WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT, AND
+TITLE.
+
+MariaDB hereby grants you permission to use this License’s text to license
+your works, and to refer to it using the trademark “Business Source License”,
+as long as you comply with the Covenants of Licensor below.
+
+Covenants of Licensor
+
+In consideration of the right to use this License’s text and the “Business
+Source License” name and trademark, Licensor covenants to MariaDB, and to all
+other recipients of the licensed work to be provided by Licensor:
+
+1. To specify as the Change License the GPL Version 2.0 or any later version,
+   or a license that is compatible with GPL Version 2.0 or a later version,
+   where “compatible” means that software provided under the Change License can
+   be included in a program with software provided under GPL Version 2.0 or a
+   later version. Licensor may specify additional Change Licenses without
+   limitation.
+
+2. To either: (a) specify an additional grant of rights to use that does not
+   impose any additional restriction on the right granted in this License, as
+   the Additional Use Grant; or (b) insert the text “None”.
+
+3. To specify a Change Date.
+
+4. Not to modify this License in any other way.
+ **/
@@ -561,6 +561,23 @@ using FPDOctreeUserQuery = struct QPDUserQuery_t
 		}
 	}
 
+	/** @brief Order independent signature of the entities in a keyed entity buffer.
+	 * @note Cheap way for users to tell if the population of a query has changed, without reading any of the buffered locations */
+	uint32 GetQueryBufferEntitySignature(const int32 Key) const
+	{
+		FReadScopeLock Lock(BufferRWLock);
+
+		const TArray<FLEntityCompound>* BufferPtr = CurrentBuffer.Find(Key);
+		if (BufferPtr == nullptr) { return 0; }
+
+		uint32 Signature = BufferPtr->Num();
+		for (const FLEntityCompound& EntityCompound : *BufferPtr)
+		{
+			Signature += GetTypeHash(EntityCompound.EntityHandle) * 2654435761u; // Knuth multiplicative mix, summed so buffer order does not matter
+		}
+		return Signature;
+	}
+
 	FORCEINLINE void SetCallingUser(AActor* Caller) { CallingUser = Caller;}
 
 
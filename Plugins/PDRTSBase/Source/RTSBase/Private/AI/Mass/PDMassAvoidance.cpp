@@ -0,0 +1,354 @@
+﻿/* @author: Ario Amin @ Permafrost Development. @copyright: Full BSL(1.1) License included at bottom of the file  */
+#include "AI/Mass/PDMassAvoidance.h"
+#include "PDRTSCommon.h"
+
+#include "HAL/IConsoleManager.h"
+
+FPDAvoidanceParams FPDAvoidanceParams::FromSettings(const UPDAvoidanceSettings& Settings)
+{
+	FPDAvoidanceParams Params;
+	Params.SeparationBuffer = Settings.SeparationBuffer;
+	Params.SeparationStrength = Settings.SeparationStrength;
+	Params.AvoidanceStrength = Settings.AvoidanceStrength;
+	Params.PredictionHorizon = FMath::Max(Settings.PredictionHorizon, UE_KINDA_SMALL_NUMBER);
+	Params.MaxNeighbours = FMath::Max(Settings.MaxNeighboursPerAgent, 1);
+	return Params;
+}
+
+//
+// Agents
+void FPDAvoidanceAgents::Reset(const int32 ExpectedCount)
+{
+	PosX.Reset(ExpectedCount);
+	PosY.Reset(ExpectedCount);
+	VelX.Reset(ExpectedCount);
+	VelY.Reset(ExpectedCount);
+	Radius.Reset(ExpectedCount);
+}
+
+int32 FPDAvoidanceAgents::Add(const FVector& Location, const FVector& Velocity, const float InRadius)
+{
+	PosX.Emplace(Location.X);
+	PosY.Emplace(Location.Y);
+	VelX.Emplace(Velocity.X);
+	VelY.Emplace(Velocity.Y);
+	return Radius.Emplace(InRadius);
+}
+
+//
+// Grid
+void FPDAvoidanceGrid::Build(const FPDAvoidanceAgents& Agents, const float InCellSize, const int32 MaxCells)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_PDAvoidanceGrid_Build);
+
+	const int32 Count = Agents.Num();
+	Sorted.Reset(Count);
+	SortedToAgent.SetNumUninitialized(Count);
+	AgentCell.SetNumUninitialized(Count);
+	if (Count == 0)
+	{
+		Dimensions = FIntPoint::ZeroValue;
+		CellStart.Reset();
+		return;
+	}
+
+	FVector2f Min(MAX_flt, MAX_flt);
+	FVector2f Max(-MAX_flt, -MAX_flt);
+	for (int32 Idx = 0; Idx < Count; Idx++)
+	{
+		Min.X = FMath::Min(Min.X, Agents.PosX[Idx]);
+		Min.Y = FMath::Min(Min.Y, Agents.PosY[Idx]);
+		Max.X = FMath::Max(Max.X, Agents.PosX[Idx]);
+		Max.Y = FMath::Max(Max.Y, Agents.PosY[Idx]);
+	}
+
+	// Grow the cells if the agents are too spread out, the neighbourhood stays 3x3 regardless
+	const FVector2f Extent = Max - Min;
+	CellSize = FMath::Max(InCellSize, 1.f);
+	const float MinCellSizeForArea = FMath::Sqrt((Extent.X + CellSize) * (Extent.Y + CellSize) / FMath::Max(MaxCells, 1));
+	CellSize = FMath::Max(CellSize, MinCellSizeForArea);
+
+	Origin = Min;
+	Dimensions = FIntPoint(
+		FMath::FloorToInt32(Extent.X / CellSize) + 1,
+		FMath::FloorToInt32(Extent.Y / CellSize) + 1);
+
+	//
+	// Counting sort by cell
+	CellStart.SetNumZeroed(Dimensions.X * Dimensions.Y + 1);
+	const float InvCellSize = 1.f / CellSize;
+	for (int32 Idx = 0; Idx < Count; Idx++)
+	{
+		const int32 CellX = FMath::Min(static_cast<int32>((Agents.PosX[Idx] - Origin.X) * InvCellSize), Dimensions.X - 1);
+		const int32 CellY = FMath::Min(static_cast<int32>((Agents.PosY[Idx] - Origin.Y) * InvCellSize), Dimensions.Y - 1);
+		const int32 Cell = CellY * Dimensions.X + CellX;
+		AgentCell[Idx] = Cell;
+		CellStart[Cell + 1]++;
+	}
+	for (int32 Cell = 1; Cell < CellStart.Num(); Cell++) { CellStart[Cell] += CellStart[Cell - 1]; }
+
+	Sorted.PosX.SetNumUninitialized(Count);
+	Sorted.PosY.SetNumUninitialized(Count);
+	Sorted.VelX.SetNumUninitialized(Count);
+	Sorted.VelY.SetNumUninitialized(Count);
+	Sorted.Radius.SetNumUninitialized(Count);
+
+	TArray<int32> WriteCursor(CellStart.GetData(), CellStart.Num() - 1);
+	for (int32 Idx = 0; Idx < Count; Idx++)
+	{
+		const int32 SortedIdx = WriteCursor[AgentCell[Idx]]++;
+		Sorted.PosX[SortedIdx] = Agents.PosX[Idx];
+		Sorted.PosY[SortedIdx] = Agents.PosY[Idx];
+		Sorted.VelX[SortedIdx] = Agents.VelX[Idx];
+		Sorted.VelY[SortedIdx] = Agents.VelY[Idx];
+		Sorted.Radius[SortedIdx] = Agents.Radius[Idx];
+		SortedToAgent[SortedIdx] = Idx;
+	}
+}
+
+int32 FPDAvoidanceGrid::ComputeSteering(const FPDAvoidanceAgents& Agents, const int32 AgentIdx, const FPDAvoidanceParams& Params, FVector2f& OutForce) const
+{
+	const float PX = Agents.PosX[AgentIdx];
+	const float PY = Agents.PosY[AgentIdx];
+	const float VX = Agents.VelX[AgentIdx];
+	const float VY = Agents.VelY[AgentIdx];
+	const float R = Agents.Radius[AgentIdx] + Params.SeparationBuffer;
+	const float InvHorizon = 1.f / Params.PredictionHorizon;
+
+	const int32 Cell = AgentCell[AgentIdx];
+	const int32 CellX = Cell % Dimensions.X;
+	const int32 CellY = Cell / Dimensions.X;
+
+	float ForceX = 0.f;
+	float ForceY = 0.f;
+	int32 Remaining = Params.MaxNeighbours + 1; // Agent tests itself once, it contributes nothing
+
+	// Own row first, then the rows above and below. The cap is split evenly over the rows left, a row that needs less hands the rest on,
+	// so a crowded row visited early can not starve the others. A row that is cut short keeps its window centred on the agents own column
+	constexpr int32 RowOffsets[3] = {0, -1, 1};
+	int32 RowsLeft = FMath::Min(CellY + 1, Dimensions.Y - 1) - FMath::Max(CellY - 1, 0) + 1;
+	for (const int32 RowOffset : RowOffsets)
+	{
+		const int32 Y = CellY + RowOffset;
+		if (Y < 0 || Y >= Dimensions.Y || Remaining <= 0) { continue; }
+
+		// Cells along a row are adjacent in the sorted arrays, so each row of the neighbourhood is one contiguous run
+		const int32 RowCell = Y * Dimensions.X;
+		const int32 RowStart = CellStart[RowCell + FMath::Max(CellX - 1, 0)];
+		const int32 RowEnd = CellStart[RowCell + FMath::Min(CellX + 1, Dimensions.X - 1) + 1];
+		const int32 RunLength = FMath::Min(RowEnd - RowStart, FMath::DivideAndRoundUp(Remaining, RowsLeft));
+		const int32 CentredStart = (CellStart[RowCell + CellX] + CellStart[RowCell + CellX + 1] - RunLength) / 2;
+		const int32 RunStart = FMath::Clamp(CentredStart, RowStart, RowEnd - RunLength);
+		const int32 RunEnd = RunStart + RunLength;
+		Remaining -= RunLength;
+		RowsLeft--;
+
+		// Branch-free over the run so the compiler can vectorize it
+		for (int32 Other = RunStart; Other < RunEnd; Other++)
+		{
+			const float DX = PX - Sorted.PosX[Other];
+			const float DY = PY - Sorted.PosY[Other];
+			const float DistSq = DX * DX + DY * DY;
+			const float InvDist = DistSq > UE_SMALL_NUMBER ? FMath::InvSqrt(DistSq) : 0.f;
+			const float MinDist = R + Sorted.Radius[Other];
+
+			// Separation, linear falloff from full overlap to the separation distance
+			const float Overlap = FMath::Max(MinDist - DistSq * InvDist, 0.f) / MinDist;
+			const float Separation = Overlap * Params.SeparationStrength * InvDist;
+			ForceX += DX * Separation;
+			ForceY += DY * Separation;
+
+			// Predictive, push away from the point of closest approach if it is within the separation distance
+			const float RVX = VX - Sorted.VelX[Other];
+			const float RVY = VY - Sorted.VelY[Other];
+			const float RelSpeedSq = RVX * RVX + RVY * RVY;
+			const float TimeToClosest = FMath::Clamp(-(DX * RVX + DY * RVY) / FMath::Max(RelSpeedSq, UE_SMALL_NUMBER), 0.f, Params.PredictionHorizon);
+			const float CX = DX + RVX * TimeToClosest;
+			const float CY = DY + RVY * TimeToClosest;
+			const float ClosestSq = CX * CX + CY * CY;
+			const float InvClosest = ClosestSq > UE_SMALL_NUMBER ? FMath::InvSqrt(ClosestSq) : 0.f;
+			const float Urgency = (1.f - TimeToClosest * InvHorizon) * (ClosestSq < MinDist * MinDist ? 1.f : 0.f) * (InvDist > 0.f ? 1.f : 0.f);
+			const float Avoidance = Urgency * Params.AvoidanceStrength * InvClosest;
+			ForceX += CX * Avoidance;
+			ForceY += CY * Avoidance;
+		}
+	}
+
+	OutForce = FVector2f(ForceX, ForceY);
+	return Params.MaxNeighbours + 1 - Remaining;
+}
+
+//
+// Benchmark, runs the grid and steering over synthetic agents so it can be profiled without a world or renderer
+namespace PD::Mass::Avoidance
+{
+	static void RunBenchmark(const TArray<FString>& Args)
+	{
+		const int32 AgentCount = Args.IsValidIndex(0) ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 50000;
+		const int32 Iterations = Args.IsValidIndex(1) ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 10;
+		const float Density = Args.IsValidIndex(2) ? FMath::Max(FCString::Atof(*Args[2]), 0.01f) : 0.5f; // Agents per 100x100 area
+
+		const UPDAvoidanceSettings* Settings = GetDefault<UPDAvoidanceSettings>();
+		const FPDAvoidanceParams Params = FPDAvoidanceParams::FromSettings(*Settings);
+		const float HalfExtent = FMath::Sqrt(AgentCount / Density) * 100.f * 0.5f;
+
+		FRandomStream Stream(0x5eed);
+		FPDAvoidanceAgents Agents;
+		Agents.Reset(AgentCount);
+		for (int32 Idx = 0; Idx < AgentCount; Idx++)
+		{
+			const FVector Location(Stream.FRandRange(-HalfExtent, HalfExtent), Stream.FRandRange(-HalfExtent, HalfExtent), 0.0);
+			const FVector Velocity(Stream.FRandRange(-300.f, 300.f), Stream.FRandRange(-300.f, 300.f), 0.0);
+			Agents.Add(Location, Velocity, Settings->DefaultAgentRadius);
+		}
+
+		FPDAvoidanceGrid Grid;
+		double BuildSeconds = 0.0;
+		double SteerSeconds = 0.0;
+		int64 NeighbourTests = 0;
+		FVector2f ForceSum = FVector2f::ZeroVector;
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			const double BuildStart = FPlatformTime::Seconds();
+			Grid.Build(Agents, Settings->CellSize);
+			const double SteerStart = FPlatformTime::Seconds();
+			for (int32 Idx = 0; Idx < AgentCount; Idx++)
+			{
+				FVector2f Force;
+				NeighbourTests += Grid.ComputeSteering(Agents, Idx, Params, Force);
+				ForceSum += Force;
+			}
+			const double SteerEnd = FPlatformTime::Seconds();
+			BuildSeconds += SteerStart - BuildStart;
+			SteerSeconds += SteerEnd - SteerStart;
+		}
+
+		const double AgentSteps = static_cast<double>(AgentCount) * Iterations;
+		UE_LOG(PDLog_RTSBase, Display,
+			TEXT("PD.Mass.Avoidance.Benchmark -- %i agents x %i iterations: build %.3f ms, steering %.3f ms per iteration, %.1f ns per agent, %.1f tests per agent (checksum %f)"),
+			AgentCount, Iterations,
+			BuildSeconds * 1000.0 / Iterations,
+			SteerSeconds * 1000.0 / Iterations,
+			(BuildSeconds + SteerSeconds) * 1e9 / AgentSteps,
+			NeighbourTests / AgentSteps,
+			ForceSum.X + ForceSum.Y);
+	}
+
+	static FAutoConsoleCommand BenchmarkCommand(
+		TEXT("PD.Mass.Avoidance.Benchmark"),
+		TEXT("Runs local avoidance over synthetic agents. Args: [AgentCount=50000] [Iterations=10] [AgentsPer100x100=0.5]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunBenchmark));
+}
+
+/**
+Business Source License 1.1
+
+Parameters
+
+Licensor:             Ario Amin (@ Permafrost Development)
+Licensed Work:        RTSOpen (Source available on github)
+                      The Licensed Work is (c) 2024 Ario Amin (@ Permafrost Development)
+Additional Use Grant: You may make free use of the Licensed Work in a commercial product or service provided these three additional conditions as met; 
+                      1. Must give attributions to the original author of the Licensed Work, in 'Credits' if that is applicable.
+                      2. The Licensed Work must be Compiled before being redistributed.
+                      3. The Licensed Work Source may be linked but may not be packaged into the product or service being sold
+                      4. Must not be resold or repackaged or redistributed as another product, is only allowed to be used within a commercial or non-commercial game project.
+                      5. Teams with yearly budgets larger than 100000 USD must contact the owner for a custom license or buy the framework from a marketplace it has been made available on.
+
+                      "Credits" indicate a scrolling screen with attributions. This is usually in a products end-state
+
+                      "Package" means the collection of files distributed by the Licensor, and derivatives of that collection
+                      and/or of those files..   
+
+                      "Source" form means the source code, documentation source, and configuration files for the Package, usually in human-readable format.
+
+                      "Compiled" form means the compiled bytecode, object code, binary, or any other
+                      form resulting from mechanical transformation or translation of the Source form.
+
+Change Date:          2028-04-17
+
+Change License:       Apache License, Version 2.0
+
+For information about alternative licensing arrangements for the Software,
+please visit: https://permadev.se/
+
+Notice
+
+The Business Source License (this document, or the “License”) is not an Open
+Source license. However, the Licensed Work will eventually be made available
+under an Open Source License, as stated in this License.
+
+License text copyright (c) 2017 MariaDB Corporation Ab, All Rights Reserved.
+“Business Source License” is a trademark of MariaDB Corporation Ab.
+
+-----------------------------------------------------------------------------
+
+Business Source License 1.1
+
+Terms
+
+The Licensor hereby grants you the right to copy, modify, create derivative
+works, redistribute, and make non-production use of the Licensed Work. The
+Licensor may make an Additional Use Grant, above, permitting limited
+production use.
+
+Effective on the Change Date, or the fourth anniversary of the first publicly
+available distribution of a specific version of the Licensed Work under this
+License, whichever comes first, the Licensor hereby grants you rights under
+the terms of the Change License, and the rights granted in the paragraph
+above terminate.
+
+If your use of the Licensed Work does not comply with the requirements
+currently in effect as described in this License, you must purchase a
+commercial license from the Licensor, its affiliated entities, or authorized
+resellers, or you must refrain from using the Licensed Work.
+
+All copies of the original and modified Licensed Work, and derivative works
+of the Licensed Work, are subject to this License. This License applies
+separately for each version of the Licensed Work and the Change Date may vary
+for each version of the Licensed Work released by Licensor.
+
+You must conspicuously display this License on each original or modified copy
+of the Licensed Work. If you receive the Licensed Work in original or
+modified form from a third party, the terms and conditions set forth in this
+License apply to your use of that work.
+
+Any use of the Licensed Work in violation of this License will automatically
+terminate your rights under this License for the current and all other
+versions of the Licensed Work.
+
+This License does not grant you any right in any trademark or logo of
+Licensor or its affiliates (provided that you may use a trademark or logo of
+Licensor as expressly required by this License).
+
+TO THE EXTENT PERMITTED BY APPLICABLE LAW, THE LICENSED WORK IS PROVIDED ON
+AN “AS IS” BASIS. LICENSOR HEREBY DISCLAIMS ALL WARRANTIES AND CONDITIONS,
+EXPRESS OR IMPLIED, INCLUDING (WITHOUT LIMITATION) WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT, AND
+TITLE.
+
+MariaDB hereby grants you permission to use this License’s text to license
+your works, and to refer to it using the trademark “Business Source License”,
+as long as you comply with the Covenants of Licensor below.
+
+Covenants of Licensor
+
+In consideration of the right to use this License’s text and the “Business
+Source License” name and trademark, Licensor covenants to MariaDB, and to all
+other recipients of the licensed work to be provided by Licensor:
+
+1. To specify as the Change License the GPL Version 2.0 or any later version,
+   or a license that is compatible with GPL Version 2.0 or a later version,
+   where “compatible” means that software provided under the Change License can
+   be included in a program with software provided under GPL Version 2.0 or a
+   later version. Licensor may specify additional Change Licenses without
+   limitation.
+
+2. To either: (a) specify an additional grant of rights to use that does not
+   impose any additional restriction on the right granted in this License, as
+   the Additional Use Grant; or (b) insert the text “None”.
+
+3. To specify a Change Date.
+
+4. Not to modify this License in any other way.
+ **/
@@ -0,0 +1,246 @@
+﻿/* @author: Ario Amin @ Permafrost Development. @copyright: Full BSL(1.1) License included at bottom of the file  */
+#include "AI/Mass/PDMassPathLOD.h"
+#include "AI/Mass/PDMassFragments.h"
+#include "AI/Mass/PDMassProcessors.h"
+#include "PDRTSCommon.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "MassNavigationFragments.h"
+#include "MassRepresentationFragments.h"
+#include "NavigationSystem.h"
+
+//
+// Benchmark, runs path LOD over synthetic entities so it can be profiled without spawning them.
+// Compares against the same loop with path LOD disabled, where every moving entity has its move target updated every frame
+namespace PD::Mass::PathLOD
+{
+	/** @brief Move target bookkeeping done by UPDProcessor_MoveTarget::Execute for every entity that is due an update */
+	FORCEINLINE void UpdateMoveTarget(FMassMoveTargetFragment& MoveTarget, const FTransform& Transform)
+	{
+		const FVector ToGoal = MoveTarget.Center - Transform.GetLocation();
+		MoveTarget.DistanceToGoal = ToGoal.Length();
+		MoveTarget.Forward = ToGoal.GetSafeNormal();
+	}
+
+	static void RunBenchmark(const TArray<FString>& Args, UWorld* World)
+	{
+		if (World == nullptr)
+		{
+			UE_LOG(PDLog_RTSBase, Warning, TEXT("PD.Mass.PathLOD.Benchmark -- Needs a world to create move actions in"))
+			return;
+		}
+
+		const int32 EntityCount = Args.IsValidIndex(0) ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 50000;
+		const int32 Iterations = Args.IsValidIndex(1) ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 60;
+		const float ChurnPercent = Args.IsValidIndex(2) ? FMath::Clamp(FCString::Atof(*Args[2]), 0.f, 100.f) : 1.f; // Entities that change visibility each frame
+
+		const UPDPathLODSettings* Settings = GetDefault<UPDPathLODSettings>();
+		const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+		const float HalfExtent = FMath::Sqrt(static_cast<float>(EntityCount)) * 200.f * 0.5f;
+		double Now = World->GetTimeSeconds();
+
+		// Roughly what a zoomed out RTS camera sees, a few close entities and most of the map far away or off-screen
+		FRandomStream Stream(0x5eed);
+		TArray<FPDMFragment_PathLOD> PathLODs;
+		TArray<FMassRepresentationLODFragment> RepLODs;
+		TArray<FMassMoveTargetFragment> MoveTargets;
+		TArray<FTransform> Transforms;
+		TArray<FMassEntityHandle> Entities;
+		PathLODs.SetNum(EntityCount);
+		RepLODs.SetNum(EntityCount);
+		MoveTargets.SetNum(EntityCount);
+		Transforms.SetNum(EntityCount);
+		Entities.SetNum(EntityCount);
+		for (int32 Idx = 0; Idx < EntityCount; Idx++)
+		{
+			const float LODRoll = Stream.FRand();
+			FMassRepresentationLODFragment& RepLOD = RepLODs[Idx];
+			RepLOD.LOD = LODRoll < 0.1f ? EMassLOD::High : LODRoll < 0.3f ? EMassLOD::Medium : LODRoll < 0.6f ? EMassLOD::Low : EMassLOD::Off;
+			RepLOD.Visibility = RepLOD.LOD <= EMassLOD::Medium ? EMassVisibility::CanBeSeen : EMassVisibility::CulledByDistance;
+
+			Transforms[Idx].SetLocation(FVector(Stream.FRandRange(-HalfExtent, HalfExtent), Stream.FRandRange(-HalfExtent, HalfExtent), 0.0));
+
+			FMassMoveTargetFragment& MoveTarget = MoveTargets[Idx];
+			MoveTarget.CreateNewAction(EMassMovementAction::Move, *World);
+			MoveTarget.Center = FVector(Stream.FRandRange(-HalfExtent, HalfExtent), Stream.FRandRange(-HalfExtent, HalfExtent), 0.0);
+			MoveTarget.DesiredSpeed.Set(Stream.FRandRange(200.f, 400.f));
+
+			PathLODs[Idx].LastUpdateTime = Now;
+			Entities[Idx] = FMassEntityHandle(Idx, 1);
+		}
+
+		TArray<FMassMoveTargetFragment> BaselineMoveTargets = MoveTargets;
+		const int32 ChurnCount = FMath::RoundToInt32(EntityCount * ChurnPercent * 0.01f);
+		const double DeltaTime = 1.0 / 60.0;
+
+		double LODSeconds = 0.0;
+		double BaselineSeconds = 0.0;
+		int64 UpdatedCount = 0;
+		double DistanceSum = 0.0;
+		uint64 FrameCounter = GFrameCounter;
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			Now += DeltaTime;
+			FrameCounter++;
+
+			// Churn is applied outside of the timed section, it only decides which entities take the correction path
+			for (int32 ChurnIdx = 0; ChurnIdx < ChurnCount; ChurnIdx++)
+			{
+				FMassRepresentationLODFragment& RepLOD = RepLODs[Stream.RandHelper(EntityCount)];
+				RepLOD.Visibility = RepLOD.Visibility == EMassVisibility::CanBeSeen ? EMassVisibility::CulledByFrustum : EMassVisibility::CanBeSeen;
+			}
+
+			const double LODStart = FPlatformTime::Seconds();
+			for (int32 Idx = 0; Idx < EntityCount; Idx++)
+			{
+				FMassMoveTargetFragment& MoveTarget = MoveTargets[Idx];
+				if (UPDProcessor_MoveTarget::ProcessPathLOD(PathLODs[Idx], RepLODs[Idx], MoveTarget, Transforms[Idx], Entities[Idx], *Settings, NavSys, Now, FrameCounter) == false)
+				{
+					continue;
+				}
+				UpdateMoveTarget(MoveTarget, Transforms[Idx]);
+				UpdatedCount++;
+			}
+			const double BaselineStart = FPlatformTime::Seconds();
+			for (int32 Idx = 0; Idx < EntityCount; Idx++)
+			{
+				UpdateMoveTarget(BaselineMoveTargets[Idx], Transforms[Idx]);
+			}
+			const double BaselineEnd = FPlatformTime::Seconds();
+			LODSeconds += BaselineStart - LODStart;
+			BaselineSeconds += BaselineEnd - BaselineStart;
+		}
+
+		for (int32 Idx = 0; Idx < EntityCount; Idx++) { DistanceSum += MoveTargets[Idx].DistanceToGoal + BaselineMoveTargets[Idx].DistanceToGoal; }
+
+		const double EntitySteps = static_cast<double>(EntityCount) * Iterations;
+		UE_LOG(PDLog_RTSBase, Display,
+			TEXT("PD.Mass.PathLOD.Benchmark -- %i entities x %i iterations (%s navmesh): path LOD %.3f ms per iteration, %.1f ns per entity, %.1f%% updated per frame. Without path LOD %.3f ms per iteration, %.1f ns per entity (checksum %f)"),
+			EntityCount, Iterations, NavSys != nullptr ? TEXT("with") : TEXT("no"),
+			LODSeconds * 1000.0 / Iterations,
+			LODSeconds * 1e9 / EntitySteps,
+			UpdatedCount * 100.0 / EntitySteps,
+			BaselineSeconds * 1000.0 / Iterations,
+			BaselineSeconds * 1e9 / EntitySteps,
+			DistanceSum);
+	}
+
+	static FAutoConsoleCommand BenchmarkCommand(
+		TEXT("PD.Mass.PathLOD.Benchmark"),
+		TEXT("Runs UPDProcessor_MoveTarget path LOD over synthetic entities. Args: [EntityCount=50000] [Iterations=60] [VisibilityChurnPercent=1]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunBenchmark));
+}
+
+/**
+Business Source License 1.1
+
+Parameters
+
+Licensor:             Ario Amin (@ Permafrost Development)
+Licensed Work:        RTSOpen (Source available on github)
+                      The Licensed Work is (c) 2024 Ario Amin (@ Permafrost Development)
+Additional Use Grant: You may make free use of the Licensed Work in a commercial product or service provided these three additional conditions as met; 
+                      1. Must give attributions to the original author of the Licensed Work, in 'Credits' if that is applicable.
+                      2. The Licensed Work must be Compiled before being redistributed.
+                      3. The Licensed Work Source may be linked but may not be packaged into the product or service being sold
+                      4. Must not be resold or repackaged or redistributed as another product, is only allowed to be used within a commercial or non-commercial game project.
+                      5. Teams with yearly budgets larger than 100000 USD must contact the owner for a custom license or buy the framework from a marketplace it has been made available on.
+
+                      "Credits" indicate a scrolling screen with attributions. This is usually in a products end-state
+
+                      "Package" means the collection of files distributed by the Licensor, and derivatives of that collection
+                      and/or of those files..   
+
+                      "Source" form means the source code, documentation source, and configuration files for the Package, usually in human-readable format.
+
+                      "Compiled" form means the compiled bytecode, object code, binary, or any other
+                      form resulting from mechanical transformation or translation of the Source form.
+
+Change Date:          2028-04-17
+
+Change License:       Apache License, Version 2.0
+
+For information about alternative licensing arrangements for the Software,
+please visit: https://permadev.se/
+
+Notice
+
+The Business Source License (this document, or the “License”) is not an Open
+Source license. However, the Licensed Work will eventually be made available
+under an Open Source License, as stated in this License.
+
+License text copyright (c) 2017 MariaDB Corporation Ab, All Rights Reserved.
+“Business Source License” is a trademark of MariaDB Corporation Ab.
+
+-----------------------------------------------------------------------------
+
+Business Source License 1.1
+
+Terms
+
+The Licensor hereby grants you the right to copy, modify, create derivative
+works, redistribute, and make non-production use of the Licensed Work. The
+Licensor may make an Additional Use Grant, above, permitting limited
+production use.
+
+Effective on the Change Date, or the fourth anniversary of the first publicly
+available distribution of a specific version of the Licensed Work under this
+License, whichever comes first, the Licensor hereby grants you rights under
+the terms of the Change License, and the rights granted in the paragraph
+above terminate.
+
+If your use of the Licensed Work does not comply with the requirements
+currently in effect as described in this License, you must purchase a
+commercial license from the Licensor, its affiliated entities, or authorized
+resellers, or you must refrain from using the Licensed Work.
+
+All copies of the original and modified Licensed Work, and derivative works
+of the Licensed Work, are subject to this License. This License applies
+separately for each version of the Licensed Work and the Change Date may vary
+for each version of the Licensed Work released by Licensor.
+
+You must conspicuously display this License on each original or modified copy
+of the Licensed Work. If you receive the Licensed Work in original or
+modified form from a third party, the terms and conditions set forth in this
+License apply to your use of that work.
+
+Any use of the Licensed Work in violation of this License will automatically
+terminate your rights under this License for the current and all other
+versions of the Licensed Work.
+
+This License does not grant you any right in any trademark or logo of
+Licensor or its affiliates (provided that you may use a trademark or logo of
+Licensor as expressly required by this License).
+
+TO THE EXTENT PERMITTED BY APPLICABLE LAW, THE LICENSED WORK IS PROVIDED ON
+AN “AS IS” BASIS. LICENSOR HEREBY DISCLAIMS ALL WARRANTIES AND CONDITIONS,
+EXPRESS OR IMPLIED, INCLUDING (WITHOUT LIMITATION) WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT, AND
+TITLE.
+
+MariaDB hereby grants you permission to use this License’s text to license
+your works, and to refer to it using the trademark “Business Source License”,
+as long as you comply with the Covenants of Licensor below.
+
+Covenants of Licensor
+
+In consideration of the right to use this License’s text and the “Business
+Source License” name and trademark, Licensor covenants to MariaDB, and to all
+other recipients of the licensed work to be provided by Licensor:
+
+1. To specify as the Change License the GPL Version 2.0 or any later version,
+   or a license that is compatible with GPL Version 2.0 or a later version,
+   where “compatible” means that software provided under the Change License can
+   be included in a program with software provided under GPL Version 2.0 or a
+   later version. Licensor may specify additional Change Licenses without
+   limitation.
+
+2. To either: (a) specify an additional grant of rights to use that does not
+   impose any additional restriction on the right granted in this License, as
+   the Additional Use Grant; or (b) insert the text “None”.
+
+3. To specify a Change Date.
+
+4. Not to modify this License in any other way.
+ **/
@@ -12,6 +12,7 @@
 #include "MassExecutionContext.h"
 #include "MassCommonTypes.h"
 #include "MassCommonUtils.h"
+#include "MassEntityView.h"
 
 // Mass (Fragments)
 #include "MassCrowdFragments.h"
@@ -22,6 +23,7 @@
 
 // Mass (Subsystems)
 #include "MassSignalSubsystem.h"
+#include "MassStateTreeTypes.h"
 #include "MassRepresentationSubsystem.h"
 
 // A2T
@@ -212,7 +214,8 @@ bool UPDMProcessor_EntityCosmetics::ProcessMaterialInstanceData(
 	// const FMassRepresentationLODFragment& RepLOD,
 	const FMassRepresentationFragment& Rep,
 	FMassInstancedStaticMeshInfo& ISMInfo,
-	FPDMFragment_RTSEntityBase* RTSEntityFragment)
+	FPDMFragment_RTSEntityBase* RTSEntityFragment,
+	bool bIsSelected)
 {
 	const FMassLODSignificanceRange* Range = ISMInfo.GetLODSignificanceRange(Rep.PrevLODSignificance);
 	if (Range == nullptr)
@@ -250,8 +253,7 @@ bool UPDMProcessor_EntityCosmetics::ProcessMaterialInstanceData(
 	}
 
 	UInstancedStaticMeshComponent* RTSBaseUnitComponent = FirstFoundInstance->GetISMComponent();
-	const bool bIsSelected = RTSEntityFragment->SelectionState == EPDEntitySelectionState::ENTITY_SELECTED;
-	const bool bIsUnset = RTSEntityFragment->SelectionState == EPDEntitySelectionState::ENTITY_UNSET;
+	const bool bIsUnset = bIsSelected == false && RTSEntityFragment->SelectionState == EPDEntitySelectionState::ENTITY_UNSET;
 
 	const double OpacityModifier = 1.0 * bIsSelected;
 	const double DilationModifier = 1.0 * (bIsSelected == false && bIsUnset == false);
@@ -283,6 +285,9 @@ void UPDMProcessor_EntityCosmetics::Execute(FMassEntityManager& EntityManager, F
 
 		// Access private member safely and legally according to ISO: https://eel.is/c++draft/temp.friend
 		const TArrayView<FMassInstancedStaticMeshInfo>& MeshInfoInnerArray = MeshInfo.*TPrivateAccessor<MassISMArrayTagType>::TypeValue;
+
+		// Selection is a tag, so it is the same for the whole chunk
+		const bool bIsChunkSelected = InContext.DoesArchetypeHaveTag<FPDMTag_Selected>();
 		
 		for (int32 EntityIdx = 0; EntityIdx < InContext.GetNumEntities(); ++EntityIdx)
 		{
@@ -293,7 +298,7 @@ void UPDMProcessor_EntityCosmetics::Execute(FMassEntityManager& EntityManager, F
 			
 			// const FMassRepresentationLODFragment& RepLOD = RepresentationLODFragments.IsValidIndex(EntityIdx) ? RepresentationLODFragments[EntityIdx] : FMassRepresentationLODFragment();
 			ProcessVertexAnimation(EntityIdx, RepresentationLODFragments, Rep, RTSEntityFragment, AnimationData, Velocity, MeshInfo, MeshInfoInnerArray, this);
-			ProcessMaterialInstanceData(InContext.GetEntity(EntityIdx) /* , RepLOD */, Rep,MeshInfo[Rep.StaticMeshDescIndex], RTSEntityFragment);
+			ProcessMaterialInstanceData(InContext.GetEntity(EntityIdx) /* , RepLOD */, Rep,MeshInfo[Rep.StaticMeshDescIndex], RTSEntityFragment, bIsChunkSelected);
 		}
 	});
 }
@@ -320,6 +325,8 @@ void UPDProcessor_MoveTarget::ConfigureQueries()
 	EntityQuery.AddRequirement<FMassMoveTargetFragment>(EMassFragmentAccess::ReadWrite);
 	EntityQuery.AddChunkRequirement<FMassSimulationVariableTickChunkFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
 	EntityQuery.AddSharedRequirement<FPDMFragment_SharedEntity>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FPDMFragment_PathLOD>(EMassFragmentAccess::ReadWrite, EMassFragmentPresence::Optional);
+	EntityQuery.AddRequirement<FMassRepresentationLODFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
 	EntityQuery.SetChunkFilter(&FMassSimulationVariableTickChunkFragment::ShouldTickChunkThisFrame);
 	EntityQuery.RegisterWithProcessor(*this);
 }
@@ -329,12 +336,22 @@ void UPDProcessor_MoveTarget::ConfigureQueries()
 // Navpath calculations when? somewhere in here in this execute function
 void UPDProcessor_MoveTarget::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
 {
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_PDMoveTarget);
+
+	const UPDPathLODSettings* LODSettings = GetDefault<UPDPathLODSettings>();
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const double Now = GetWorld()->GetTimeSeconds();
+	const uint64 FrameCounter = GFrameCounter;
+
 	TArray<FMassEntityHandle> EntitiesToSignal;
-	EntityQuery.ForEachEntityChunk(EntityManager, Context, ([this, &EntitiesToSignal](FMassExecutionContext& Context)
+	EntityQuery.ForEachEntityChunk(EntityManager, Context, ([&](FMassExecutionContext& Context)
 	{
 		TMutFragment<FTransformFragment>& TransformsList = MUTVIEW(Context, FTransformFragment);
 		TMutFragment<FMassMoveTargetFragment>& MoveTargets = MUTVIEW(Context, FMassMoveTargetFragment);
+		TMutFragment<FPDMFragment_PathLOD> PathLODs = MUTVIEW(Context, FPDMFragment_PathLOD);
+		TConstFragment<FMassRepresentationLODFragment> LODs = CONSTVIEW(Context, FMassRepresentationLODFragment);
 		FPDMFragment_SharedEntity& SharedFragment = MUTSHAREDVIEW(Context, FPDMFragment_SharedEntity);
+		const bool bUsePathLOD = LODSettings->bEnablePathLOD && PathLODs.IsEmpty() == false && LODs.IsEmpty() == false;
 		
 		//
 		// Update Shared navpath fragments 
@@ -360,9 +377,14 @@ void UPDProcessor_MoveTarget::Execute(FMassEntityManager& EntityManager, FMassEx
 		for (int32 EntityIndex = 0; EntityIndex < Context.GetNumEntities(); ++EntityIndex)
 		{
 			FMassMoveTargetFragment& MoveTarget = MoveTargets[EntityIndex];
+			FTransform& Transform = TransformsList[EntityIndex].GetMutableTransform();
+			if (bUsePathLOD
+				&& ProcessPathLOD(PathLODs[EntityIndex], LODs[EntityIndex], MoveTarget, Transform, Context.GetEntity(EntityIndex), *LODSettings, NavSys, Now, FrameCounter) == false)
+			{
+				continue;
+			}
 			if (MoveTarget.GetCurrentAction() != EMassMovementAction::Move) { continue; }
 			
-			const FTransform& Transform = TransformsList[EntityIndex].GetTransform();
 			MoveTarget.DistanceToGoal = (MoveTarget.Center - Transform.GetLocation()).Length();
 			MoveTarget.Forward = (MoveTarget.Center - Transform.GetLocation()).GetSafeNormal();
 			if (MoveTarget.DistanceToGoal > MoveTarget.SlackRadius) { continue; }
@@ -372,13 +394,312 @@ void UPDProcessor_MoveTarget::Execute(FMassEntityManager& EntityManager, FMassEx
 		}
 	}));
 
-	if (EntitiesToSignal.IsEmpty()) { return; }
-	SignalSubsystem->SignalEntities(UE::Mass::Signals::FollowPointPathDone, EntitiesToSignal);
+	if (EntitiesToSignal.IsEmpty() || SignalAggregator == nullptr) { return; }
+	SignalAggregator->SignalEntities(UE::Mass::Signals::FollowPointPathDone, EntitiesToSignal);
+}
+
+bool UPDProcessor_MoveTarget::ProcessPathLOD(
+	FPDMFragment_PathLOD& PathLOD,
+	const FMassRepresentationLODFragment& RepLOD,
+	FMassMoveTargetFragment& MoveTarget,
+	FTransform& Transform,
+	const FMassEntityHandle& Entity,
+	const UPDPathLODSettings& Settings,
+	const UNavigationSystemV1* NavSys,
+	const double Now,
+	const uint64 FrameCounter)
+{
+	const bool bVisible = RepLOD.Visibility == EMassVisibility::CanBeSeen;
+	const bool bMoving = MoveTarget.GetCurrentAction() == EMassMovementAction::Move;
+
+	//
+	// Came into view or stopped moving, hand the entity back to steering. Correct the straight line drift onto the navmesh
+	if (PathLOD.bExtrapolating && (bVisible || bMoving == false))
+	{
+		PathLOD.bExtrapolating = false;
+		PathLOD.LastUpdateTime = Now;
+		if (MoveTarget.DesiredSpeed.Get() <= 0.f) { MoveTarget.DesiredSpeed.Set(PathLOD.ExtrapolationSpeed); }
+
+		FNavLocation Projected;
+		const FVector Extent(Settings.MaxExtrapolationStep, Settings.MaxExtrapolationStep, Settings.CorrectionProjectionHeight);
+		if (NavSys != nullptr && NavSys->ProjectPointToNavigation(Transform.GetLocation(), Projected, Extent))
+		{
+			Transform.SetLocation(Projected.Location);
+		}
+		return true;
+	}
+
+	if (bMoving == false)
+	{
+		PathLOD.LastUpdateTime = Now;
+		return true;
+	}
+
+	// Staggered by entity index so a LOD band spreads its updates evenly over the interval
+	const int32 LODIdx = FMath::Min(static_cast<int32>(RepLOD.LOD), static_cast<int32>(EMassLOD::Off));
+	const int32 Interval = FMath::Max(Settings.LODUpdateIntervals[LODIdx], 1);
+	if ((FrameCounter + Entity.Index) % Interval != 0) { return false; }
+
+	const double Elapsed = Now - PathLOD.LastUpdateTime;
+	PathLOD.LastUpdateTime = Now;
+	if (bVisible || Settings.bExtrapolateHiddenEntities == false) { return true; }
+
+	//
+	// Hidden, take the entity off steering and advance it in one step for the time since its last update.
+	// Tasks may have set a new speed along with a new path point, pick it up before zeroing it again
+	const float DesiredSpeed = MoveTarget.DesiredSpeed.Get();
+	if (DesiredSpeed > 0.f)
+	{
+		PathLOD.ExtrapolationSpeed = DesiredSpeed;
+		MoveTarget.DesiredSpeed.Set(0.f);
+	}
+	if (PathLOD.bExtrapolating == false)
+	{
+		PathLOD.bExtrapolating = true;
+		return true;
+	}
+
+	const FVector ToGoal = MoveTarget.Center - Transform.GetLocation();
+	const double Step = FMath::Min3(PathLOD.ExtrapolationSpeed * Elapsed, static_cast<double>(Settings.MaxExtrapolationStep), ToGoal.Length());
+	Transform.SetLocation(Transform.GetLocation() + ToGoal.GetSafeNormal() * Step);
+	return true;
 }
 
 void UPDProcessor_MoveTarget::Initialize(UObject& Owner)
 {
-	SignalSubsystem = UWorld::GetSubsystem<UMassSignalSubsystem>(GetWorld());
+	SignalAggregator = UPDSignalAggregator::Get(&Owner);
+}
+
+//
+// Wander scheduling
+UPDProcessor_WanderScheduler::UPDProcessor_WanderScheduler()
+{
+	ExecutionOrder.ExecuteBefore.Add(UPDProcessor_MoveTarget::StaticClass()->GetFName());
+	ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::All);
+	bRequiresGameThreadExecution = true;
+}
+
+void UPDProcessor_WanderScheduler::Initialize(UObject& Owner)
+{
+	Super::Initialize(Owner);
+	WanderSubsystem = UPDWanderSubsystem::Get(&Owner);
+	SignalAggregator = UPDSignalAggregator::Get(&Owner);
+}
+
+void UPDProcessor_WanderScheduler::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FPDMFragment_Wander>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FMassMoveTargetFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.RegisterWithProcessor(*this);
+}
+
+void UPDProcessor_WanderScheduler::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	if (WanderSubsystem == nullptr || SignalAggregator == nullptr) { return; }
+
+	const UPDWanderSettings* Settings = GetDefault<UPDWanderSettings>();
+	DueDecisions.Reset();
+	WanderSubsystem->PopDueDecisions(GetWorld()->GetTimeSeconds(), Settings->MaxDecisionsPerFrame, DueDecisions);
+	if (DueDecisions.IsEmpty()) { return; }
+
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_PDWanderScheduler);
+
+	TArray<FMassEntityHandle> EntitiesToSignal;
+	EntitiesToSignal.Reserve(DueDecisions.Num());
+	for (const FPDWanderDecision& Decision : DueDecisions)
+	{
+		if (EntityManager.IsEntityValid(Decision.Entity) == false) { continue; }
+
+		const FMassEntityView EntityView(EntityManager, Decision.Entity);
+		FPDMFragment_Wander* Wander = EntityView.GetFragmentDataPtr<FPDMFragment_Wander>();
+		FMassMoveTargetFragment* MoveTarget = EntityView.GetFragmentDataPtr<FMassMoveTargetFragment>();
+		const FTransformFragment* Transform = EntityView.GetFragmentDataPtr<FTransformFragment>();
+
+		// Stale, the wander task has exited or been re-entered since this decision was scheduled
+		if (Wander == nullptr || MoveTarget == nullptr || Transform == nullptr
+			|| Wander->bAwaitingTarget == false || Wander->DecisionSerial != Decision.Serial)
+		{
+			continue;
+		}
+
+		const TArray<FVector>& Pool = WanderSubsystem->FindOrBuildPointPool(Wander->HomeLocation, Wander->Radius);
+		const FVector& Point = Pool[FMath::RandHelper(Pool.Num())];
+		const FVector& Location = Transform->GetTransform().GetLocation();
+
+		MoveTarget->CreateNewAction(EMassMovementAction::Move, *GetWorld());
+		MoveTarget->Center = Point;
+		MoveTarget->SlackRadius = Wander->SuccessRadius;
+		MoveTarget->DistanceToGoal = FVector::Dist(Location, Point);
+		MoveTarget->Forward = (Point - Location).GetSafeNormal();
+
+		Wander->bAwaitingTarget = false;
+		Wander->bHasTarget = true;
+		EntitiesToSignal.Emplace(Decision.Entity);
+	}
+	if (EntitiesToSignal.IsEmpty()) { return; }
+
+	// Wake now to pick up the new target, and once more after the timeout in case the entity never arrives
+	SignalAggregator->SignalEntities(UE::Mass::Signals::StateTreeActivate, EntitiesToSignal);
+	SignalAggregator->DelaySignalEntities(UE::Mass::Signals::StateTreeActivate, EntitiesToSignal, Settings->MoveTimeout);
+}
+
+//
+// Signal aggregation
+UPDProcessor_SignalFlush::UPDProcessor_SignalFlush()
+{
+	ExecutionOrder.ExecuteBefore.Add(UE::Mass::ProcessorGroupNames::Behavior);
+	ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::All);
+	bRequiresGameThreadExecution = true;
+}
+
+void UPDProcessor_SignalFlush::Initialize(UObject& Owner)
+{
+	Super::Initialize(Owner);
+	SignalAggregator = UPDSignalAggregator::Get(&Owner);
+}
+
+void UPDProcessor_SignalFlush::ConfigureQueries()
+{
+	ProcessorRequirements.AddSubsystemRequirement<UMassSignalSubsystem>(EMassFragmentAccess::ReadWrite);
+}
+
+void UPDProcessor_SignalFlush::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	if (SignalAggregator == nullptr) { return; }
+	SignalAggregator->Flush(EntityManager);
+}
+
+UPDProcessor_SignalCostSample::UPDProcessor_SignalCostSample()
+{
+	ExecutionOrder.ExecuteAfter.Add(UE::Mass::ProcessorGroupNames::Behavior);
+	ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::All);
+	bRequiresGameThreadExecution = true;
+}
+
+void UPDProcessor_SignalCostSample::Initialize(UObject& Owner)
+{
+	Super::Initialize(Owner);
+	SignalAggregator = UPDSignalAggregator::Get(&Owner);
+}
+
+void UPDProcessor_SignalCostSample::ConfigureQueries()
+{
+}
+
+void UPDProcessor_SignalCostSample::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	if (SignalAggregator == nullptr) { return; }
+	SignalAggregator->SampleWakeupCost();
+}
+
+//
+// Local avoidance
+UPDProcessor_LocalAvoidance::UPDProcessor_LocalAvoidance()
+{
+	ExecutionOrder.ExecuteInGroup = UE::Mass::ProcessorGroupNames::Avoidance;
+	ExecutionOrder.ExecuteAfter.Add(UPDProcessor_MoveTarget::StaticClass()->GetFName());
+	ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::All);
+}
+
+void UPDProcessor_LocalAvoidance::Initialize(UObject& Owner)
+{
+	Super::Initialize(Owner);
+}
+
+void UPDProcessor_LocalAvoidance::ConfigureQueries()
+{
+	EntityQuery.AddTagRequirement<FPDMTag_RTSEntity>(EMassFragmentPresence::All);
+	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FMassVelocityFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FMassForceFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FAgentRadiusFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
+	EntityQuery.AddRequirement<FMassRepresentationLODFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
+	EntityQuery.RegisterWithProcessor(*this);
+}
+
+void UPDProcessor_LocalAvoidance::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	const UPDAvoidanceSettings* Settings = GetDefault<UPDAvoidanceSettings>();
+	if (Settings->bEnableLocalAvoidance == false) { return; }
+
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_PDLocalAvoidance);
+
+	//
+	// Gather, every agent is an obstacle. Agents are staggered over their LOD interval by entity index
+	const uint64 FrameCounter = GFrameCounter;
+	Agents.Reset(Agents.Num());
+	for (TArray<int32>& LODAgents : DueAgents) { LODAgents.Reset(); }
+
+	EntityQuery.ForEachEntityChunk(EntityManager, Context, [&](FMassExecutionContext& LambdaContext)
+	{
+		TConstFragment<FTransformFragment> Transforms = CONSTVIEW(LambdaContext, FTransformFragment);
+		TConstFragment<FMassVelocityFragment> Velocities = CONSTVIEW(LambdaContext, FMassVelocityFragment);
+		TConstFragment<FAgentRadiusFragment> Radii = CONSTVIEW(LambdaContext, FAgentRadiusFragment);
+		TConstFragment<FMassRepresentationLODFragment> LODs = CONSTVIEW(LambdaContext, FMassRepresentationLODFragment);
+
+		for (int32 EntityIdx = 0; EntityIdx < LambdaContext.GetNumEntities(); ++EntityIdx)
+		{
+			const int32 AgentIdx = Agents.Add(
+				Transforms[EntityIdx].GetTransform().GetLocation(),
+				Velocities[EntityIdx].Value,
+				Radii.IsEmpty() ? Settings->DefaultAgentRadius : Radii[EntityIdx].Radius);
+
+			const int32 LOD = LODs.IsEmpty() ? EMassLOD::High : FMath::Min(static_cast<int32>(LODs[EntityIdx].LOD), static_cast<int32>(EMassLOD::Off));
+			const int32 Interval = Settings->LODUpdateIntervals[LOD];
+			if (Interval <= 0 || (FrameCounter + LambdaContext.GetEntity(EntityIdx).Index) % Interval != 0) { continue; }
+
+			DueAgents[LOD].Emplace(AgentIdx);
+		}
+	});
+	if (Agents.Num() == 0) { return; }
+
+	Grid.Build(Agents, Settings->CellSize);
+
+	//
+	// Steer, highest LOD first until the frame budget runs out. Skipped frames are made up for by scaling with the interval.
+	// Each LOD and stagger phase starts where the budget cut it off the last time that phase came around,
+	// otherwise the agents gathered last would never get to steer
+	const FPDAvoidanceParams Params = FPDAvoidanceParams::FromSettings(*Settings);
+	AgentForces.Init(FVector2f::ZeroVector, Agents.Num());
+
+	int32 RemainingTests = Settings->MaxNeighbourTestsPerFrame;
+	for (int32 LOD = EMassLOD::High; LOD <= EMassLOD::Off && RemainingTests > 0; LOD++)
+	{
+		const TArray<int32>& LODAgents = DueAgents[LOD];
+		const int32 DueCount = LODAgents.Num();
+		if (DueCount == 0) { continue; }
+
+		const int32 Interval = FMath::Max(Settings->LODUpdateIntervals[LOD], 1);
+		const float IntervalScale = static_cast<float>(Interval);
+		if (DueAgentsStart[LOD].Num() != Interval) { DueAgentsStart[LOD].Init(0, Interval); }
+		
+		int32& PhaseStart = DueAgentsStart[LOD][static_cast<int32>(FrameCounter % Interval)];
+		const int32 StartIdx = PhaseStart % DueCount;
+		int32 SteeredCount = 0;
+		while (SteeredCount < DueCount && RemainingTests > 0)
+		{
+			const int32 AgentIdx = LODAgents[(StartIdx + SteeredCount) % DueCount];
+			FVector2f Force;
+			RemainingTests -= Grid.ComputeSteering(Agents, AgentIdx, Params, Force);
+			AgentForces[AgentIdx] = Force * IntervalScale;
+			SteeredCount++;
+		}
+		PhaseStart = SteeredCount < DueCount ? (StartIdx + SteeredCount) % DueCount : 0;
+	}
+
+	//
+	// Write back, chunks are visited in the same order as the gather
+	int32 AgentIdx = 0;
+	EntityQuery.ForEachEntityChunk(EntityManager, Context, [&](FMassExecutionContext& LambdaContext)
+	{
+		TMutFragment<FMassForceFragment> Forces = MUTVIEW(LambdaContext, FMassForceFragment);
+		for (int32 EntityIdx = 0; EntityIdx < LambdaContext.GetNumEntities(); ++EntityIdx, ++AgentIdx)
+		{
+			const FVector2f& Force = AgentForces[AgentIdx];
+			Forces[EntityIdx].Value += FVector(Force.X, Force.Y, 0.0);
+		}
+	});
 }
 
 namespace PD::Mass::Crowd
@@ -0,0 +1,302 @@
+﻿/* @author: Ario Amin @ Permafrost Development. @copyright: Full BSL(1.1) License included at bottom of the file  */
+#include "AI/Mass/PDMassSignals.h"
+#include "AI/Mass/PDMassFragments.h"
+
+#include "MassEntityManager.h"
+#include "MassEntityView.h"
+#include "MassSignalSubsystem.h"
+#include "Engine/World.h"
+#include "Misc/ScopeLock.h"
+
+DECLARE_STATS_GROUP(TEXT("PD Mass Signals"), STATGROUP_PDMassSignals, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Signals delivered"), STAT_PDMassSignalsDelivered, STATGROUP_PDMassSignals);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Signals deferred"), STAT_PDMassSignalsDeferred, STATGROUP_PDMassSignals);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Signals merged"), STAT_PDMassSignalsMerged, STATGROUP_PDMassSignals);
+
+UPDSignalAggregator* UPDSignalAggregator::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject != nullptr ? WorldContextObject->GetWorld() : nullptr;
+	return World != nullptr ? World->GetSubsystem<UPDSignalAggregator>() : nullptr;
+}
+
+void UPDSignalAggregator::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	SignalSubsystem = Collection.InitializeDependency<UMassSignalSubsystem>();
+	WakeupCostEstimate = FMath::Max(GetDefault<UPDSignalSettings>()->InitialWakeupCostUs, 0.01f) * 1e-6;
+}
+
+void UPDSignalAggregator::SignalEntity(const FName SignalName, const FMassEntityHandle& Entity, const EPDSignalUrgency Urgency)
+{
+	if (GetDefault<UPDSignalSettings>()->bEnableAggregation == false)
+	{
+		if (SignalSubsystem != nullptr) { SignalSubsystem->SignalEntity(SignalName, Entity); }
+		return;
+	}
+	FScopeLock Lock(&QueueLock);
+	Enqueue(SignalName, Entity, Urgency == EPDSignalUrgency::Immediate);
+}
+
+void UPDSignalAggregator::SignalEntities(const FName SignalName, const TConstArrayView<FMassEntityHandle> Entities, const EPDSignalUrgency Urgency)
+{
+	if (GetDefault<UPDSignalSettings>()->bEnableAggregation == false)
+	{
+		if (SignalSubsystem != nullptr) { SignalSubsystem->SignalEntities(SignalName, Entities); }
+		return;
+	}
+
+	FScopeLock Lock(&QueueLock);
+	for (const FMassEntityHandle& Entity : Entities)
+	{
+		Enqueue(SignalName, Entity, Urgency == EPDSignalUrgency::Immediate);
+	}
+}
+
+void UPDSignalAggregator::DelaySignalEntity(const FName SignalName, const FMassEntityHandle& Entity, const float DelaySeconds)
+{
+	DelaySignalEntities(SignalName, MakeArrayView(&Entity, 1), DelaySeconds);
+}
+
+void UPDSignalAggregator::DelaySignalEntities(const FName SignalName, const TConstArrayView<FMassEntityHandle> Entities, const float DelaySeconds)
+{
+	if (GetDefault<UPDSignalSettings>()->bEnableAggregation == false)
+	{
+		if (SignalSubsystem != nullptr) { SignalSubsystem->DelaySignalEntities(SignalName, Entities, DelaySeconds); }
+		return;
+	}
+
+	const double DueTime = GetWorld()->GetTimeSeconds() + DelaySeconds;
+	const auto IsEarlier = [](const FDelayedSignal& A, const FDelayedSignal& B) { return A.DueTime < B.DueTime; };
+	FScopeLock Lock(&QueueLock);
+	for (const FMassEntityHandle& Entity : Entities)
+	{
+		Delayed.HeapPush({DueTime, SignalName, Entity}, IsEarlier);
+	}
+}
+
+void UPDSignalAggregator::Enqueue(const FName SignalName, const FMassEntityHandle& Entity, const bool bImmediate)
+{
+	bool bAlreadyPending = false;
+	FPendingSignal& PendingSignal = Pending.FindOrAdd(Entity);
+	if (PendingSignal.SignalNames.IsEmpty())
+	{
+		PendingSignal.QueuedFrame = GFrameCounter;
+	}
+	else
+	{
+		bAlreadyPending = PendingSignal.SignalNames.Contains(SignalName);
+	}
+
+	// Urgency only ever escalates, a merged deferrable signal must not hold back an immediate one
+	PendingSignal.bImmediate |= bImmediate;
+	if (bAlreadyPending)
+	{
+		MergedSinceFlush++;
+		return;
+	}
+	PendingSignal.SignalNames.Emplace(SignalName);
+}
+
+void UPDSignalAggregator::Flush(const FMassEntityManager& EntityManager)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_PDSignalAggregator_Flush);
+
+	const UPDSignalSettings* Settings = GetDefault<UPDSignalSettings>();
+	FScopeLock Lock(&QueueLock);
+
+	// Release due delayed signals into the pending set, this is where repeated wait/animation timers get merged
+	const double Now = GetWorld()->GetTimeSeconds();
+	const auto IsEarlier = [](const FDelayedSignal& A, const FDelayedSignal& B) { return A.DueTime < B.DueTime; };
+	while (Delayed.IsEmpty() == false && Delayed.HeapTop().DueTime <= Now)
+	{
+		FDelayedSignal DueSignal;
+		Delayed.HeapPop(DueSignal, IsEarlier, false);
+		Enqueue(DueSignal.SignalName, DueSignal.Entity, false);
+	}
+
+	LastFlushDelivered = 0;
+	if (Pending.IsEmpty() == false && SignalSubsystem != nullptr)
+	{
+		// Forced (immediate or waited too long) before selected before the rest, oldest first within each
+		enum : uint64 { Forced = 0, Selected = 1, Background = 2 };
+		const uint64 MaxDeferFrames = static_cast<uint64>(FMath::Max(Settings->MaxDeferFrames, 0));
+
+		DeliveryOrder.Reset(Pending.Num());
+		for (TPair<FMassEntityHandle, FPendingSignal>& PendingPair : Pending)
+		{
+			const FPendingSignal& PendingSignal = PendingPair.Value;
+			uint64 Priority = Background;
+			if (PendingSignal.bImmediate || GFrameCounter - PendingSignal.QueuedFrame >= MaxDeferFrames)
+			{
+				Priority = Forced;
+			}
+			else if (EntityManager.IsEntityValid(PendingPair.Key)
+				&& FMassEntityView(EntityManager, PendingPair.Key).HasTag<FPDMTag_Selected>())
+			{
+				Priority = Selected;
+			}
+			DeliveryOrder.Emplace((Priority << 56) | (PendingSignal.QueuedFrame & ((1ull << 56) - 1)), PendingPair.Key);
+		}
+		DeliveryOrder.Sort([](const TPair<uint64, FMassEntityHandle>& A, const TPair<uint64, FMassEntityHandle>& B) { return A.Key < B.Key; });
+
+		const double BudgetSeconds = FMath::Max(Settings->WakeupBudgetMs, 0.f) * 1e-3;
+		const int32 BudgetWakeups = FMath::Max(Settings->MinWakeupsPerFrame, FMath::FloorToInt32(BudgetSeconds / WakeupCostEstimate));
+
+		for (TPair<FName, TArray<FMassEntityHandle>>& Batch : DeliveryBatches) { Batch.Value.Reset(); }
+		for (const TPair<uint64, FMassEntityHandle>& Entry : DeliveryOrder)
+		{
+			const bool bForced = (Entry.Key >> 56) == Forced;
+			if (bForced == false && LastFlushDelivered >= BudgetWakeups) { break; }
+
+			FPendingSignal PendingSignal;
+			Pending.RemoveAndCopyValue(Entry.Value, PendingSignal);
+			for (const FName& SignalName : PendingSignal.SignalNames)
+			{
+				DeliveryBatches.FindOrAdd(SignalName).Emplace(Entry.Value);
+			}
+			LastFlushDelivered++;
+		}
+
+		for (const TPair<FName, TArray<FMassEntityHandle>>& Batch : DeliveryBatches)
+		{
+			if (Batch.Value.IsEmpty()) { continue; }
+			SignalSubsystem->SignalEntities(Batch.Key, Batch.Value);
+		}
+	}
+
+	FrameCounters.Delivered = LastFlushDelivered;
+	FrameCounters.Deferred = Pending.Num();
+	FrameCounters.Merged = MergedSinceFlush;
+	MergedSinceFlush = 0;
+	TotalCounters.Delivered += FrameCounters.Delivered;
+	TotalCounters.Deferred += FrameCounters.Deferred;
+	TotalCounters.Merged += FrameCounters.Merged;
+	INC_DWORD_STAT_BY(STAT_PDMassSignalsDelivered, FrameCounters.Delivered);
+	INC_DWORD_STAT_BY(STAT_PDMassSignalsDeferred, FrameCounters.Deferred);
+	INC_DWORD_STAT_BY(STAT_PDMassSignalsMerged, FrameCounters.Merged);
+
+	LastFlushEndTime = FPlatformTime::Seconds();
+}
+
+void UPDSignalAggregator::SampleWakeupCost()
+{
+	if (LastFlushDelivered <= 0) { return; }
+
+	// Includes whatever else runs in the behaviour group, so it errs on the side of a smaller budget
+	const double CostPerWakeup = (FPlatformTime::Seconds() - LastFlushEndTime) / LastFlushDelivered;
+	WakeupCostEstimate = FMath::Max(FMath::Lerp(WakeupCostEstimate, CostPerWakeup, 0.1), 1e-8);
+	LastFlushDelivered = 0;
+}
+
+/**
+Business Source License 1.1
+
+Parameters
+
+Licensor:             Ario Amin (@ Permafrost Development)
+Licensed Work:        RTSOpen (Source available on github)
+                      The Licensed Work is (c) 2024 Ario Amin (@ Permafrost Development)
+Additional Use Grant: You may make free use of the Licensed Work in a commercial product or service provided these three additional conditions as met; 
+                      1. Must give attributions to the original author of the Licensed Work, in 'Credits' if that is applicable.
+                      2. The Licensed Work must be Compiled before being redistributed.
+                      3. The Licensed Work Source may be linked but may not be packaged into the product or service being sold
+                      4. Must not be resold or repackaged or redistributed as another product, is only allowed to be used within a commercial or non-commercial game project.
+                      5. Teams with yearly budgets larger than 100000 USD must contact the owner for a custom license or buy the framework from a marketplace it has been made available on.
+
+                      "Credits" indicate a scrolling screen with attributions. This is usually in a products end-state
+
+                      "Package" means the collection of files distributed by the Licensor, and derivatives of that collection
+                      and/or of those files..   
+
+                      "Source" form means the source code, documentation source, and configuration files for the Package, usually in human-readable format.
+
+                      "Compiled" form means the compiled bytecode, object code, binary, or any other
+                      form resulting from mechanical transformation or translation of the Source form.
+
+Change Date:          2028-04-17
+
+Change License:       Apache License, Version 2.0
+
+For information about alternative licensing arrangements for the Software,
+please visit: https://permadev.se/
+
+Notice
+
+The Business Source License (this document, or the “License”) is not an Open
+Source license. However, the Licensed Work will eventually be made available
+under an Open Source License, as stated in this License.
+
+License text copyright (c) 2017 MariaDB Corporation Ab, All Rights Reserved.
+“Business Source License” is a trademark of MariaDB Corporation Ab.
+
+-----------------------------------------------------------------------------
+
+Business Source License 1.1
+
+Terms
+
+The Licensor hereby grants you the right to copy, modify, create derivative
+works, redistribute, and make non-production use of the Licensed Work. The
+Licensor may make an Additional Use Grant, above, permitting limited
+production use.
+
+Effective on the Change Date, or the fourth anniversary of the first publicly
+available distribution of a specific version of the Licensed Work under this
+License, whichever comes first, the Licensor hereby grants you rights under
+the terms of the Change License, and the rights granted in the paragraph
+above terminate.
+
+If your use of the Licensed Work does not comply with the requirements
+currently in effect as described in this License, you must purchase a
+commercial license from the Licensor, its affiliated entities, or authorized
+resellers, or you must refrain from using the Licensed Work.
+
+All copies of the original and modified Licensed Work, and derivative works
+of the Licensed Work, are subject to this License. This License applies
+separately for each version of the Licensed Work and the Change Date may vary
+for each version of the Licensed Work released by Licensor.
+
+You must conspicuously display this License on each original or modified copy
+of the Licensed Work. If you receive the Licensed Work in original or
+modified form from a third party, the terms and conditions set forth in this
+License apply to your use of that work.
+
+Any use of the Licensed Work in violation of this License will automatically
+terminate your rights under this License for the current and all other
+versions of the Licensed Work.
+
+This License does not grant you any right in any trademark or logo of
+Licensor or its affiliates (provided that you may use a trademark or logo of
+Licensor as expressly required by this License).
+
+TO THE EXTENT PERMITTED BY APPLICABLE LAW, THE LICENSED WORK IS PROVIDED ON
+AN “AS IS” BASIS. LICENSOR HEREBY DISCLAIMS ALL WARRANTIES AND CONDITIONS,
+EXPRESS OR IMPLIED, INCLUDING (WITHOUT LIMITATION) WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT, AND
+TITLE.
+
+MariaDB hereby grants you permission to use this License’s text to license
+your works, and to refer to it using the trademark “Business Source License”,
+as long as you comply with the Covenants of Licensor below.
+
+Covenants of Licensor
+
+In consideration of the right to use this License’s text and the “Business
+Source License” name and trademark, Licensor covenants to MariaDB, and to all
+other recipients of the licensed work to be provided by Licensor:
+
+1. To specify as the Change License the GPL Version 2.0 or any later version,
+   or a license that is compatible with GPL Version 2.0 or a later version,
+   where “compatible” means that software provided under the Change License can
+   be included in a program with software provided under GPL Version 2.0 or a
+   later version. Licensor may specify additional Change Licenses without
+   limitation.
+
+2. To either: (a) specify an additional grant of rights to use that does not
+   impose any additional restriction on the right granted in this License, as
+   the Additional Use Grant; or (b) insert the text “None”.
+
+3. To specify a Change Date.
+
+4. Not to modify this License in any other way.
+ **/
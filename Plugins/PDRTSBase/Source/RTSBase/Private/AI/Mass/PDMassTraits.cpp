@@ -19,6 +19,8 @@ void UPDMTrait_RTSEntity::BuildTemplate(FMassEntityTemplateBuildContext& BuildCo
 	
 	BuildContext.AddFragment<FPDMFragment_RTSEntityBase>();
 	BuildContext.AddFragment<FPDMFragment_EntityAnimation>();
+	BuildContext.AddFragment<FPDMFragment_Wander>();
+	BuildContext.AddFragment<FPDMFragment_PathLOD>();
 	BuildContext.AddTag<FPDMTag_RTSEntity>();
 	
 	const FConstSharedStruct AnimDataFragment = EntitySubsystem->GetMutableEntityManager().GetOrCreateConstSharedFragment(SharedAnimData);
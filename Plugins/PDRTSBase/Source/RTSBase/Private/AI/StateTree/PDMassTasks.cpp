@@ -1,6 +1,7 @@
 ﻿/* @author: Ario Amin @ Permafrost Development. @copyright: Full BSL(1.1) License included at bottom of the file  */
 #include "AI/StateTree/PDMassTasks.h"
 #include "AI/Mass/PDMassFragments.h"
+#include "PDRTSBaseSubsystem.h"
 
 #include "MassCommonFragments.h"
 #include "MassEntitySubsystem.h"
@@ -124,6 +125,7 @@ void FPDMTask_MoveToTarget::ProcessNewSharedPath(const FPDMPathParameters& Param
 		
 		TArray<FVector> PathPoints = Params.NavPath->PathPoints;
 		PathPoints[0] = StartLocation;
+		PathPoints.Last() = Params.ResolveLocation(); // Group path ends at the group target, finish at this entities own (formation) target
 
 		Params.InstanceData.NavPath = std::move(PathPoints);
 		Params.InstanceData.CurrentNavPathIndex = 0;
@@ -136,6 +138,28 @@ void FPDMTask_MoveToTarget::ProcessNewSharedPath(const FPDMPathParameters& Param
 	}
 }
 
+void FPDMTask_MoveToTarget::ProcessFlowFieldStep(const FPDMPathParameters& Params)
+{
+	const FPDFlowField& FlowField = *Params.InstanceData.FlowField;
+	const FVector& Location = Params.TransformFragment.GetTransform().GetLocation();
+	const FVector TargetLocation = Params.ResolveLocation();
+	const double CellSize = FlowField.GetGrid().CellSize;
+
+	// The field flows towards the group target, entities with their own formation slot break off once they are close to it
+	FVector Direction;
+	if (FlowField.IsInGoalCell(Location)
+		|| FVector::DistSquared2D(Location, TargetLocation) <= FMath::Square(CellSize * 2.0)
+		|| FlowField.SampleDirection(Location, Direction) == false)
+	{
+		Params.InstanceData.FlowField.Reset();
+		Params.MoveTarget.Center = TargetLocation;
+		return;
+	}
+
+	// Look a cell and a half ahead so the slack radius is crossed roughly once per cell
+	Params.MoveTarget.Center = Location + Direction * (CellSize * 1.5);
+}
+
 void FPDMTask_MoveToTarget::OnPathSelected(FPDMFragment_RTSEntityBase& RTSData, const bool bShouldUseSharedNavigation, const FVector& LastPoint) const
 {
 	// Empty base call, reserved.
@@ -180,9 +204,31 @@ EStateTreeRunStatus FPDMTask_MoveToTarget::EnterState(FStateTreeExecutionContext
 	const FPDMPathParameters
 		PathParams(InstanceData,MoveTarget, TransformFragment, EntitySubsystem, bIsEntityValid, InstanceData.OptTargets, NavPath);
 
-	NavPath == nullptr ?
-		ProcessNewPriorityPath(PathParams)
-		: ProcessNewSharedPath(PathParams);
+	// Flow fields take precedence, they are only generated for selection groups too large to share a single navpath.
+	// Group fields outlive the order that built them, so only follow one if it still leads to this entities own target
+	const UPDRTSBaseSubsystem* RTSSubsystem = UPDRTSBaseSubsystem::Get();
+	InstanceData.FlowField =
+		RTSData.QueuedUnitPath.IsEmpty() && RTSData.SelectionGroupIndex != INDEX_NONE && RTSSubsystem != nullptr
+			? RTSSubsystem->FindSelectionGroupFlowField(RTSData.OwnerID, RTSData.SelectionGroupIndex)
+			: nullptr;
+	if (InstanceData.FlowField.IsValid()
+		&& FVector::DistSquared2D(InstanceData.FlowField->GetDestination(), PathParams.ResolveLocation()) > FMath::Square(GetDefault<UPDFlowFieldSettings>()->DestinationMatchRadius))
+	{
+		InstanceData.FlowField.Reset();
+	}
+
+	if (InstanceData.FlowField.IsValid())
+	{
+		InstanceData.NavPath.Reset();
+		InstanceData.CurrentNavPathIndex = 0;
+		ProcessFlowFieldStep(PathParams);
+	}
+	else
+	{
+		NavPath == nullptr ?
+			ProcessNewPriorityPath(PathParams)
+			: ProcessNewSharedPath(PathParams);
+	}
 
 	const FVector& LastPoint = PathParams.MoveTarget.Center;
 	OnPathSelected(RTSData, bShouldUseSharedNavigation, LastPoint);
@@ -215,6 +261,20 @@ EStateTreeRunStatus FPDMTask_MoveToTarget::Tick(FStateTreeExecutionContext& Cont
 
 	if (MoveTarget.DistanceToGoal <= MoveTarget.SlackRadius)
 	{
+		// Resample the flow field, last step resets the field and targets the final location 
+		if (InstanceData.FlowField.IsValid())
+		{
+			UMassEntitySubsystem& EntitySubsystem = Context.GetExternalData(EntitySubsystemHandle);
+			const FTransformFragment& TransformFragment = Context.GetExternalData(TransformHandle);
+			const bool bIsEntityValid = EntitySubsystem.GetEntityManager().IsEntityValid(InstanceData.OptTargets.ActionTargetAsEntity);
+
+			const FPDMPathParameters
+				PathParams(InstanceData, MoveTarget, TransformFragment, EntitySubsystem, bIsEntityValid, InstanceData.OptTargets);
+			ProcessFlowFieldStep(PathParams);
+			MoveTarget.CreateNewAction(EMassMovementAction::Move, *Context.GetWorld());
+			return EStateTreeRunStatus::Running;
+		}
+
 		// Get new center if we are not at last index yet 
 		if (InstanceData.CurrentNavPathIndex < (InstanceData.NavPath.Num() - 1) )
 		{
@@ -232,6 +292,7 @@ EStateTreeRunStatus FPDMTask_MoveToTarget::Tick(FStateTreeExecutionContext& Cont
 }
 void FPDMTask_MoveToTarget::ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
 {
+	Context.GetInstanceData(*this).FlowField.Reset();
 	Super::ExitState(Context, Transition);
 }
 
@@ -240,26 +301,33 @@ void FPDMTask_MoveToTarget::ExitState(FStateTreeExecutionContext& Context, const
 bool FPDMTask_RandomWander::Link(FStateTreeLinker& Linker)
 {
 	Linker.LinkExternalData(TransformHandle);
-	Linker.LinkExternalData(MassSignalSubsystemHandle);
 	Linker.LinkExternalData(MoveTargetHandle);
+	Linker.LinkExternalData(WanderHandle);
+	Linker.LinkExternalData(WanderSubsystemHandle);
 	return true;
 }
 
 EStateTreeRunStatus FPDMTask_RandomWander::EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
 {
-	FMassMoveTargetFragment& MoveTargetFragment = Context.GetExternalData(MoveTargetHandle);
+	FPDMFragment_Wander& Wander = Context.GetExternalData(WanderHandle);
 	const FTransform& Transform = Context.GetExternalData(TransformHandle).GetTransform();
 	const FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
-	
-	const float& Radius = InstanceData.StartRadiusRandomLimit;
-	FVector RandomLocation = FVector(FMath::RandRange(-Radius, Radius), FMath::RandRange(-Radius, Radius), 0.f);
-	RandomLocation += Transform.GetLocation();
 
-	MoveTargetFragment.CreateNewAction(EMassMovementAction::Move, *Context.GetWorld());
-	MoveTargetFragment.Center = RandomLocation;
+	if (Wander.bHasHome == false)
+	{
+		Wander.HomeLocation = Transform.GetLocation();
+		Wander.bHasHome = true;
+	}
+	Wander.Radius = InstanceData.StartRadiusRandomLimit;
+	Wander.SuccessRadius = InstanceData.SuccessRadius;
+	Wander.bAwaitingTarget = true;
+	Wander.bHasTarget = false;
+	Wander.DecisionSerial++;
 
+	// Sleep until the scheduler has picked a point, it signals the entity when it does
 	const FMassStateTreeExecutionContext& MassContext = static_cast<FMassStateTreeExecutionContext&>(Context);
-	Context.GetExternalData(MassSignalSubsystemHandle).DelaySignalEntity(UE::Mass::Signals::StateTreeActivate, MassContext.GetEntity(), 0.1f);
+	const double DecisionTime = Context.GetWorld()->GetTimeSeconds() + FMath::FRandRange(InstanceData.MinDecisionDelay, FMath::Max(InstanceData.MinDecisionDelay, InstanceData.MaxDecisionDelay));
+	Context.GetExternalData(WanderSubsystemHandle).ScheduleDecision(MassContext.GetEntity(), Wander.DecisionSerial, DecisionTime);
 	
 	return EStateTreeRunStatus::Running;
 }
@@ -267,8 +335,12 @@ EStateTreeRunStatus FPDMTask_RandomWander::EnterState(FStateTreeExecutionContext
 EStateTreeRunStatus FPDMTask_RandomWander::Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const
 {
 	FMassMoveTargetFragment& MoveTarget = Context.GetExternalData(MoveTargetHandle);
+	FPDMFragment_Wander& Wander = Context.GetExternalData(WanderHandle);
 	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
 
+	// Woken by some other signal before the scheduler assigned a point
+	if (Wander.bHasTarget == false) { return EStateTreeRunStatus::Running; }
+
 	// Abort if moving slower than our conditions/task parameters allow
 	switch (InstanceData.StuckMovementRules.ShouldContinueMovement(DeltaTime))
 	{
@@ -277,19 +349,19 @@ EStateTreeRunStatus FPDMTask_RandomWander::Tick(FStateTreeExecutionContext& Cont
 	default: break;
 	}
 	
-	if (MoveTarget.DistanceToGoal <= InstanceData.SuccessRadius)
+	if (MoveTarget.GetCurrentAction() != EMassMovementAction::Move || MoveTarget.DistanceToGoal <= InstanceData.SuccessRadius)
 	{
 		MoveTarget.CreateNewAction(EMassMovementAction::Stand, *Context.GetWorld());
 		return EStateTreeRunStatus::Succeeded;
 	}
-
-	const FMassStateTreeExecutionContext& MassContext = static_cast<FMassStateTreeExecutionContext&>(Context);
-	Context.GetExternalData(MassSignalSubsystemHandle).DelaySignalEntity(UE::Mass::Signals::StateTreeActivate, MassContext.GetEntity(), DeltaTime == 0.0 ? 0.1 : DeltaTime );	
 	
 	return EStateTreeRunStatus::Running;
 }
 void FPDMTask_RandomWander::ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
 {
+	FPDMFragment_Wander& Wander = Context.GetExternalData(WanderHandle);
+	Wander.bAwaitingTarget = false;
+	Wander.bHasTarget = false;
 	Super::ExitState(Context, Transition);
 }
 
@@ -297,7 +369,7 @@ void FPDMTask_RandomWander::ExitState(FStateTreeExecutionContext& Context, const
 // Wait a given amount of time
 bool FPDMTask_Wait::Link(FStateTreeLinker& Linker)
 {
-	Linker.LinkExternalData(MassSignalSubsystemHandle);
+	Linker.LinkExternalData(SignalAggregatorHandle);
 	return true;
 }
 
@@ -305,8 +377,8 @@ EStateTreeRunStatus FPDMTask_Wait::EnterState(FStateTreeExecutionContext& Contex
 {
 	const FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
 	const FMassStateTreeExecutionContext& MassContext = static_cast<FMassStateTreeExecutionContext&>(Context);
-	auto& MassSignalSubsystem = Context.GetExternalData(MassSignalSubsystemHandle);
-	MassSignalSubsystem.DelaySignalEntity(UE::Mass::Signals::StateTreeActivate, MassContext.GetEntity(), InstanceData.Duration);
+	UPDSignalAggregator& SignalAggregator = Context.GetExternalData(SignalAggregatorHandle);
+	SignalAggregator.DelaySignalEntity(UE::Mass::Signals::StateTreeActivate, MassContext.GetEntity(), InstanceData.Duration);
 	
 	return EStateTreeRunStatus::Running;
 }
@@ -322,8 +394,8 @@ EStateTreeRunStatus FPDMTask_Wait::Tick(FStateTreeExecutionContext& Context, con
 	}
 	
 	const FMassStateTreeExecutionContext& StateTreeContext = static_cast<FMassStateTreeExecutionContext&>(Context);
-	auto& MassSignalSubsystem = Context.GetExternalData(MassSignalSubsystemHandle);
-	MassSignalSubsystem.DelaySignalEntity(UE::Mass::Signals::StateTreeActivate, StateTreeContext.GetEntity(), InstanceData.Duration - InstanceData.TimePassed);
+	UPDSignalAggregator& SignalAggregator = Context.GetExternalData(SignalAggregatorHandle);
+	SignalAggregator.DelaySignalEntity(UE::Mass::Signals::StateTreeActivate, StateTreeContext.GetEntity(), InstanceData.Duration - InstanceData.TimePassed);
 	
 	return EStateTreeRunStatus::Running;
 }
@@ -340,7 +412,7 @@ void FPDMTask_Wait::ExitState(FStateTreeExecutionContext& Context, const FStateT
 bool FPDMTask_PlayAnimation::Link(FStateTreeLinker& Linker)
 {
 	Linker.LinkExternalData(MoveTargetHandle);
-	Linker.LinkExternalData(MassSignalSubsystemHandle);
+	Linker.LinkExternalData(SignalAggregatorHandle);
 	Linker.LinkExternalData(AnimationHandle);
 	
 	return true;
@@ -363,8 +435,8 @@ EStateTreeRunStatus FPDMTask_PlayAnimation::EnterState(FStateTreeExecutionContex
 	const float Duration = InstanceData.Duration;
 	if (Duration > 0.0f)
 	{
-		UMassSignalSubsystem& MassSignalSubsystem = MassContext.GetExternalData(MassSignalSubsystemHandle);
-		MassSignalSubsystem.DelaySignalEntity(UE::Mass::Signals::LookAtFinished, MassContext.GetEntity(), Duration);
+		UPDSignalAggregator& SignalAggregator = MassContext.GetExternalData(SignalAggregatorHandle);
+		SignalAggregator.DelaySignalEntity(UE::Mass::Signals::LookAtFinished, MassContext.GetEntity(), Duration);
 	}
 
 	return EStateTreeRunStatus::Running;
@@ -386,8 +458,8 @@ EStateTreeRunStatus FPDMTask_PlayAnimation::Tick(FStateTreeExecutionContext& Con
 	}
 
 	const FMassStateTreeExecutionContext& MassContext = static_cast<FMassStateTreeExecutionContext&>(Context);
-	UMassSignalSubsystem& MassSignalSubsystem = MassContext.GetExternalData(MassSignalSubsystemHandle);
-	MassSignalSubsystem.DelaySignalEntity(UE::Mass::Signals::LookAtFinished, MassContext.GetEntity(), Duration);
+	UPDSignalAggregator& SignalAggregator = MassContext.GetExternalData(SignalAggregatorHandle);
+	SignalAggregator.DelaySignalEntity(UE::Mass::Signals::LookAtFinished, MassContext.GetEntity(), Duration);
 	
 	return Duration <= 0.0f ? EStateTreeRunStatus::Failed : EStateTreeRunStatus::Running;
 
@@ -3,6 +3,121 @@
 #include "Actors/PDRTSCameraManager.h"
 
 #include "PDRTSCommon.h"
+#include "Curves/CurveFloat.h"
+
+//
+// Compiled camera modes
+FPDCameraModeParams FPDCameraModeParams::Compile(const FPDCameraManagerSettings& Settings)
+{
+	FPDCameraModeParams Params;
+	Params.PitchMin    = Settings.Pitch.Min;
+	Params.PitchMax    = Settings.Pitch.Max;
+	Params.YawMin      = Settings.Yaw.Min;
+	Params.YawMax      = Settings.Yaw.Max;
+	Params.FOV         = Settings.FOV;
+	Params.OrthoWidth  = Settings.OrthoWidth;
+	Params.LagSpeed    = FMath::Max(Settings.CameraLagSpeed, 0.0);
+	Params.FadeAmount  = Settings.FadeAmount;
+	Params.FadeColour  = Settings.FadeColour;
+	Params.BlendInTime = FMath::Max(Settings.BlendInTime, 0.0);
+
+	// Bake the curve so blending never evaluates the curve asset, and is unaffected by the asset until the tables are recompiled
+	const UCurveFloat* Curve = Settings.BlendInCurve;
+	for (int32 SampleIdx = 0; SampleIdx < BlendCurveSampleCount; SampleIdx++)
+	{
+		const float Time01 = static_cast<float>(SampleIdx) / static_cast<float>(BlendCurveSampleCount - 1);
+		Params.BlendInCurve[SampleIdx] = Curve != nullptr ? Curve->GetFloatValue(Time01) : Time01;
+	}
+	return Params;
+}
+
+FPDCameraModeParams FPDCameraModeParams::Blend(const FPDCameraModeParams& From, const FPDCameraModeParams& To, double Alpha)
+{
+	// Discrete switches happen half-way through the blend
+	const bool bPastHalfway = Alpha >= 0.5;
+	
+	FPDCameraModeParams Params = To;
+	Params.PitchMin = FMath::Lerp(From.PitchMin, To.PitchMin, Alpha);
+	Params.PitchMax = FMath::Lerp(From.PitchMax, To.PitchMax, Alpha);
+	Params.YawMin   = FMath::Lerp(From.YawMin, To.YawMin, Alpha);
+	Params.YawMax   = FMath::Lerp(From.YawMax, To.YawMax, Alpha);
+	Params.FOV      = FMath::Lerp(From.FOV, To.FOV, Alpha);
+	Params.LagSpeed = FMath::Lerp(From.LagSpeed, To.LagSpeed, Alpha);
+
+	// Only blend the ortho width if both modes are orthographic, otherwise switch projection
+	const bool bFromOrtho = From.OrthoWidth >= 1.0;
+	const bool bToOrtho   = To.OrthoWidth >= 1.0;
+	Params.OrthoWidth = bFromOrtho && bToOrtho
+		? FMath::Lerp(From.OrthoWidth, To.OrthoWidth, Alpha)
+		: (bPastHalfway ? To.OrthoWidth : From.OrthoWidth);
+
+	// Only blend the fade if both modes control it
+	const bool bFromFade = From.FadeAmount > (SMALL_NUMBER - 1.0);
+	const bool bToFade   = To.FadeAmount > (SMALL_NUMBER - 1.0);
+	if (bFromFade && bToFade)
+	{
+		Params.FadeAmount = FMath::Lerp(From.FadeAmount, To.FadeAmount, Alpha);
+		Params.FadeColour = FMath::Lerp(From.FadeColour, To.FadeColour, static_cast<float>(Alpha));
+	}
+	else
+	{
+		Params.FadeAmount = bPastHalfway ? To.FadeAmount : From.FadeAmount;
+		Params.FadeColour = bPastHalfway ? To.FadeColour : From.FadeColour;
+	}
+	return Params;
+}
+
+double FPDCameraModeParams::EvaluateBlendInCurve(double NormalizedTime) const
+{
+	const double SampleTime = FMath::Clamp(NormalizedTime, 0.0, 1.0) * (BlendCurveSampleCount - 1);
+	const int32 LowerIdx = FMath::Min(FMath::FloorToInt32(SampleTime), BlendCurveSampleCount - 2);
+	return FMath::Lerp(
+		static_cast<double>(BlendInCurve[LowerIdx]),
+		static_cast<double>(BlendInCurve[LowerIdx + 1]),
+		SampleTime - LowerIdx);
+}
+
+//
+// Camera mode blending
+void FPDCameraModeBlend::BlendTo(const FPDCameraModeParams& Target)
+{
+	if (Target.BlendInTime <= SMALL_NUMBER)
+	{
+		SnapTo(Target);
+		return;
+	}
+
+	// Start from wherever we currently are, an interrupted blend continues smoothly from its current state
+	From = Current;
+	To = Target;
+	Elapsed = 0.0;
+	Duration = Target.BlendInTime;
+}
+
+void FPDCameraModeBlend::SnapTo(const FPDCameraModeParams& Target)
+{
+	From = To = Current = Target;
+	Elapsed = Duration = 0.0;
+}
+
+bool FPDCameraModeBlend::Step(double DeltaTime)
+{
+	if (IsBlending() == false) { return false; }
+
+	Elapsed = FMath::Min(Elapsed + FMath::Max(DeltaTime, 0.0), Duration);
+	if (IsBlending() == false)
+	{
+		Current = To;
+		return true;
+	}
+
+	const double Alpha = To.EvaluateBlendInCurve(Elapsed / Duration);
+	Current = FPDCameraModeParams::Blend(From, To, Alpha);
+	return true;
+}
+
+//
+// Camera manager
 
 APDCameraManager::APDCameraManager()
 {
@@ -21,16 +136,42 @@ void APDCameraManager::BeginPlay()
 	ProcessTables();
 }
 
+void APDCameraManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	for (UDataTable* Table : CameraSettingsSources)
+	{
+		if (Table == nullptr) { continue; }
+		Table->OnDataTableChanged().RemoveAll(this);
+	}
+	
+	Super::EndPlay(EndPlayReason);
+}
+
 // Called by the engine
 void APDCameraManager::UpdateCamera(float DeltaTime)
 {
+	// Resolve mode changes and step the blend before the view target is updated, so the view target sees this frames parameters
+	const bool bAlreadyApplied = RequestedCameraState == OldCameraState;
+	if (bAlreadyApplied == false)
+	{
+		SetCustomMode(RequestedCameraState);
+		OldCameraState  = RequestedCameraState;
+	}
+
+	if (ModeBlend.Step(DeltaTime))
+	{
+		ApplyModeParams(ModeBlend.GetCurrent());
+	}
+	
 	Super::UpdateCamera(DeltaTime);
+}
 
-	const bool bAlreadyApplied = RequestedCameraState == OldCameraState;
-	if (bAlreadyApplied) { return; }
+FVector APDCameraManager::DampTowards(const FVector& Current, const FVector& Target, double DampingRate, double DeltaTime)
+{
+	if (DampingRate <= SMALL_NUMBER) { return Target; }
 	
-	SetCustomMode(RequestedCameraState);
-	OldCameraState  = RequestedCameraState;
+	// Remaining distance decays by exp(-Rate * Time), which composes across any sub-division of the delta time
+	return Target + (Current - Target) * FMath::Exp(-DampingRate * FMath::Max(DeltaTime, 0.0));
 }
 
 void APDCameraManager::SetCustomMode_Implementation(FGameplayTag Tag)
@@ -52,46 +193,82 @@ void APDCameraManager::SetCustomMode_Implementation(FGameplayTag Tag)
 	CurrentSettingsHandle.DataTable = TagToTable.FindRef(Tag);
 	CurrentSettingsHandle.RowName   = TagToRowname.FindRef(Tag);
 	
-	const FPDCameraManagerSettings& Settings = *TagToSettings.FindRef(Tag);
+	SettingPtr = TagToSettings.FindRef(Tag);
+
+	// Blend from the currently applied parameters into the compiled mode, the first mode applied is snapped to
+	const FPDCameraModeParams& Target = CompiledModes.FindChecked(Tag);
+	if (bHasAppliedMode)
+	{
+		ModeBlend.BlendTo(Target);
+	}
+	else
+	{
+		ModeBlend.SnapTo(Target);
+		bHasAppliedMode = true;
+	}
+	
+	ApplyModeParams(ModeBlend.GetCurrent());
+}
 
+void APDCameraManager::ApplyModeParams(const FPDCameraModeParams& Params)
+{
 	// Set up camera for given custom modes
-	ViewPitchMin = Settings.Pitch.Min;
-	ViewPitchMax = Settings.Pitch.Max;
-	ViewYawMin = Settings.Yaw.Min;
-	ViewYawMax = Settings.Yaw.Max;
+	ViewPitchMin = Params.PitchMin;
+	ViewPitchMax = Params.PitchMax;
+	ViewYawMin = Params.YawMin;
+	ViewYawMax = Params.YawMax;
 
-	SetFOV(Settings.FOV);
+	SetFOV(Params.FOV);
 
-	bIsOrthographic = Settings.OrthoWidth >= 1.0f;
-	SetOrthoWidth(Settings.OrthoWidth);
+	bIsOrthographic = Params.OrthoWidth >= 1.0;
+	SetOrthoWidth(Params.OrthoWidth);
 	
-	const bool bSkipFadeSettings = Settings.FadeAmount <= (SMALL_NUMBER - 1.0);
+	const bool bSkipFadeSettings = Params.FadeAmount <= (SMALL_NUMBER - 1.0);
 	if (bSkipFadeSettings) { return; }
 	
-	FadeAmount = Settings.FadeAmount;
-	FadeColor  = Settings.FadeColour;
+	FadeAmount = Params.FadeAmount;
+	FadeColor  = Params.FadeColour;
 }
 
 void APDCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime)
 {
 	Super::UpdateViewTarget(OutVT, DeltaTime);
 
-	if (SettingPtr != nullptr && SettingPtr->CameraLagSpeed > SMALL_NUMBER)
+	const double LagSpeed = ModeBlend.GetCurrent().LagSpeed;
+	if (bHasLaggedLocation == false || LagSpeed <= SMALL_NUMBER)
 	{
-		const FVector DesiredPos = OutVT.POV.Location;
-		const FVector CurrentPos = OutVT.POV.Location + CurrentLagVelocity;
-
-		const FVector NewCameraLagVelocity = (DesiredPos - CurrentPos) * SettingPtr->CameraLagSpeed;
-		CurrentLagVelocity = NewCameraLagVelocity * DeltaTime  +  CurrentLagVelocity * (1.f - DeltaTime);
-
-		OutVT.POV.Location = DesiredPos - CurrentLagVelocity;
+		// Keep tracking while lag is disabled, so enabling it does not pull the camera from a stale location
+		LaggedLocation = OutVT.POV.Location;
+		bHasLaggedLocation = true;
+		return;
 	}
+
+	LaggedLocation = DampTowards(LaggedLocation, OutVT.POV.Location, LagSpeed, DeltaTime);
+	OutVT.POV.Location = LaggedLocation;
 }
 
+void APDCameraManager::OnSettingsTableChanged()
+{
+	TagToSettings.Empty();
+	TagToTable.Empty();
+	TagToRowname.Empty();
+	CompiledModes.Empty();
+	SettingPtr = nullptr;
+	
+	ProcessTables();
+
+	// Re-target the active mode, blends from the currently applied parameters into the reloaded ones
+	const FPDCameraModeParams* ReloadedMode = CompiledModes.Find(OldCameraState);
+	if (ReloadedMode == nullptr) { return; }
+	
+	SettingPtr = TagToSettings.FindRef(OldCameraState);
+	ModeBlend.BlendTo(*ReloadedMode);
+	ApplyModeParams(ModeBlend.GetCurrent());
+}
 
 void APDCameraManager::ProcessTables()
 {
-	for (const UDataTable* Table : CameraSettingsSources)
+	for (UDataTable* Table : CameraSettingsSources)
 	{
 		if (Table == nullptr
 			|| Table->IsValidLowLevelFast() == false
@@ -100,6 +277,10 @@ void APDCameraManager::ProcessTables()
 			continue;
 		}
 
+		// Hot-reload, recompile when a source table is edited or re-imported
+		Table->OnDataTableChanged().RemoveAll(this);
+		Table->OnDataTableChanged().AddUObject(this, &APDCameraManager::OnSettingsTableChanged);
+
 		TArray<FPDCameraManagerSettings*> Rows;
 		Table->GetAllRows("", Rows);
 		TArray<FName> RowNames = Table->GetRowNames();
@@ -141,6 +322,7 @@ void APDCameraManager::ProcessTables()
 			TagToSettings.Emplace(DefaultDatum->CameraMode) = DefaultDatum;
 			TagToTable.Emplace(CameraMode) = Table;
 			TagToRowname.Emplace(CameraMode) = Name;
+			CompiledModes.Emplace(CameraMode) = FPDCameraModeParams::Compile(*DefaultDatum);
 		}
 	}
 }
@@ -2,6 +2,7 @@
 
 #include "Effects/PDFogOfWar.h"
 #include "PDRTSCommon.h"
+#include "PDTableIngestion.h"
 #include "RHICommandList.h"
 #include "Rendering/Texture2DResource.h"
 
@@ -327,6 +328,12 @@ void UPDFogOfWarSubsystem::OnWorldBeginPlay(UWorld& InWorld)
 	ProcessTables();
 }
 
+void UPDFogOfWarSubsystem::Deinitialize()
+{
+	FPDTableIngestion::Get().Release(GetTableIngestionName());
+	Super::Deinitialize();
+}
+
 bool UPDFogOfWarSubsystem::HasCompleteAuthority() const
 {
 	switch (GetWorld()->GetNetMode())
@@ -393,6 +400,8 @@ void UPDFogOfWarSubsystem::UpdateWorldLocation(AController* RequestedController,
 
 void UPDFogOfWarSubsystem::SetCustomMode_Implementation(FGameplayTag Tag)
 {
+	FPDTableIngestion::Get().Flush(GetTableIngestionName()); // No-op if the tables have already been published
+	
 	// If TagToSettings has a valid entry, then TagToTable & TagToRowName also have the same valid entries  
 	if (TagToSettings.Contains(Tag) == false)
 	{
@@ -422,11 +431,22 @@ TStatId UPDFogOfWarSubsystem::GetStatId() const
 
 void UPDFogOfWarSubsystem::ProcessTables()
 {
-	const UPDFogOfWarSettingsSource* FogOfWarGlobalSettings = GetDefault<UPDFogOfWarSettingsSource>();
-	
-	for (const TSoftObjectPtr<UDataTable> SoftObjectTablePtr : FogOfWarGlobalSettings->SettingsTables)
+	FPDTableIngestion::Get().Ingest<FPDFogOfWarTableData>(
+		GetTableIngestionName(),
+		GetDefault<UPDFogOfWarSettingsSource>()->SettingsTables,
+		[](const TArray<UDataTable*>& Tables, FPDFogOfWarTableData& OutData) { BuildTableData(Tables, OutData); },
+		[this](const TArray<UDataTable*>& Tables, FPDFogOfWarTableData&& Data)
+		{
+			TagToSettings = MoveTemp(Data.TagToSettings);
+			TagToTable = MoveTemp(Data.TagToTable);
+			TagToRowname = MoveTemp(Data.TagToRowname);
+		});
+}
+
+void UPDFogOfWarSubsystem::BuildTableData(const TArray<UDataTable*>& Tables, FPDFogOfWarTableData& OutData)
+{
+	for (const UDataTable* Table : Tables)
 	{
-		const UDataTable* Table = SoftObjectTablePtr.LoadSynchronous();
 		if (Table == nullptr
 			|| Table->IsValidLowLevelFast() == false
 			|| Table->RowStruct != FPDFogOfWarSettings::StaticStruct())
@@ -447,7 +467,7 @@ void UPDFogOfWarSubsystem::ProcessTables()
 
 			if (FOWMode.IsValid() == false)
 			{
-				FString BuildString = "UPDFogOfWarSubsystem::ProcessTables -- "
+				FString BuildString = "UPDFogOfWarSubsystem::BuildTableData -- "
 				+ FString::Printf(TEXT("Processing table(%s)"), *Table->GetName()) 
 				+ FString::Printf(TEXT("\n Trying to add settings on row (%s) Which does not have a valid gameplay tag. Skipping processing entry"), *Name.ToString());
 				UE_LOG(PDLog_RTSBase, Error, TEXT("%s"), *BuildString);
@@ -457,11 +477,11 @@ void UPDFogOfWarSubsystem::ProcessTables()
 			}
 			
 			// @note If duplicates, ignore duplicate and output errors to screen and to log
-			if (TagToSettings.Contains(FOWMode))
+			if (OutData.TagToSettings.Contains(FOWMode))
 			{
-				const UDataTable* RetrievedTable = *TagToTable.Find(FOWMode);
+				const UDataTable* RetrievedTable = *OutData.TagToTable.Find(FOWMode);
 				
-				FString BuildString = "UPDFogOfWarSubsystem::ProcessTables -- "
+				FString BuildString = "UPDFogOfWarSubsystem::BuildTableData -- "
 				+ FString::Printf(TEXT("Processing table(%s)"), *Table->GetName()) 
 				+ FString::Printf(TEXT("\n Trying to add setting(%s) which has already been added by previous table(%s)."),
 						*FOWMode.GetTagName().ToString(), RetrievedTable != nullptr ? *RetrievedTable->GetName() : *FString("INVALID TABLE"));
@@ -472,9 +492,9 @@ void UPDFogOfWarSubsystem::ProcessTables()
 			}
 			
 
-			TagToSettings.Emplace(FOWMode) = DefaultDatum;
-			TagToTable.Emplace(FOWMode) = Table;
-			TagToRowname.Emplace(FOWMode) = Name;
+			OutData.TagToSettings.Emplace(FOWMode) = DefaultDatum;
+			OutData.TagToTable.Emplace(FOWMode) = Table;
+			OutData.TagToRowname.Emplace(FOWMode) = Name;
 		}
 	}
 }
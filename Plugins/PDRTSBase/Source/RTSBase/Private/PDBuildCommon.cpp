@@ -2,6 +2,9 @@
 
 #include "PDBuildCommon.h"
 
+#include "Algo/BinarySearch.h"
+#include "Algo/Unique.h"
+
 /** Define the gameplay "AI.Type." tags */
 UE_DEFINE_GAMEPLAY_TAG(TAG_AI_Type, "AI.Type");
 UE_DEFINE_GAMEPLAY_TAG(TAG_AI_Type_DefaultUnit, "AI.Type.DefaultUnit");
@@ -40,6 +43,176 @@ UE_DEFINE_GAMEPLAY_TAG(TAG_BUILD_ActionContext_WorkerHut1, "BUILD.ActionContext.
 UE_DEFINE_GAMEPLAY_TAG(TAG_BUILD_ActionContext_Barracks0, "BUILD.ActionContext.Barracks0");
 UE_DEFINE_GAMEPLAY_TAG(TAG_BUILD_ActionContext_Barracks1, "BUILD.ActionContext.Barracks1");
 
+void FPDBuildTagRelation::Bake(const int32 KeyCount, const TMap<int32, TArray<int32>>& Source)
+{
+	Reset();
+	Offsets.SetNumZeroed(KeyCount + 1);
+
+	// Count, then prefix sum into offsets, then fill
+	TArray<TArray<int32>> SortedValues;
+	SortedValues.SetNum(KeyCount);
+	for (const TTuple<int32, TArray<int32>>& Entry : Source)
+	{
+		if (Entry.Key < 0 || Entry.Key >= KeyCount) { continue; }
+
+		TArray<int32>& KeyValues = SortedValues[Entry.Key];
+		KeyValues = Entry.Value;
+		KeyValues.Sort();
+		KeyValues.SetNum(Algo::Unique(KeyValues));
+		Offsets[Entry.Key + 1] = KeyValues.Num();
+	}
+
+	for (int32 KeyIdx = 0; KeyIdx < KeyCount; KeyIdx++)
+	{
+		Offsets[KeyIdx + 1] += Offsets[KeyIdx];
+	}
+
+	Values.Reserve(Offsets[KeyCount]);
+	for (const TArray<int32>& KeyValues : SortedValues)
+	{
+		Values.Append(KeyValues);
+	}
+}
+
+void FPDBuildTagRelation::Reset()
+{
+	Offsets.Reset();
+	Values.Reset();
+}
+
+TConstArrayView<int32> FPDBuildTagRelation::Get(const int32 KeyIdx) const
+{
+	if (KeyIdx < 0 || KeyIdx + 1 >= Offsets.Num()) { return {}; }
+	return TConstArrayView<int32>(Values.GetData() + Offsets[KeyIdx], Offsets[KeyIdx + 1] - Offsets[KeyIdx]);
+}
+
+bool FPDBuildTagRelation::Contains(const int32 KeyIdx, const int32 ValueIdx) const
+{
+	const TConstArrayView<int32> KeyValues = Get(KeyIdx);
+	return Algo::BinarySearch(KeyValues, ValueIdx) != INDEX_NONE;
+}
+
+int32 FPDBuildLookupTables::InternTag(const FGameplayTag& Tag)
+{
+	if (const int32* ExistingIdx = TagIndices.Find(Tag)) { return *ExistingIdx; }
+
+	const int32 TagIdx = InternedTags.Emplace(Tag);
+	TagIndices.Emplace(Tag, TagIdx);
+	BuildableData.Emplace(nullptr);
+	BuildContexts.Emplace(nullptr);
+	Workers.Emplace(nullptr);
+	return TagIdx;
+}
+
+int32 FPDBuildLookupTables::FindTagIndex(const FGameplayTag& Tag) const
+{
+	const int32* TagIdx = TagIndices.Find(Tag);
+	return TagIdx != nullptr ? *TagIdx : INDEX_NONE;
+}
+
+const FGameplayTag& FPDBuildLookupTables::GetTag(const int32 TagIdx) const
+{
+	return InternedTags.IsValidIndex(TagIdx) ? InternedTags[TagIdx] : FGameplayTag::EmptyTag;
+}
+
+void FPDBuildLookupTables::Reset()
+{
+	InternedTags.Reset();
+	TagIndices.Reset();
+	BuildableData.Reset();
+	BuildContexts.Reset();
+	Workers.Reset();
+	ParentContexts_PerBuildable.Reset();
+	Workers_PerBuildContext.Reset();
+	ValidWorkers_PerBuildable.Reset();
+}
+
+void FPDBuildOccupancyGrid::SetOccupant(const int32 OccupantID, const FBox& WorldBounds)
+{
+	RemoveOccupant(OccupantID);
+	if (WorldBounds.IsValid == false) { return; }
+
+	TArray<FIntPoint>& Cells = OccupantCells.Add(OccupantID);
+	GetCoveredCells(WorldBounds, Cells);
+	for (const FIntPoint& Cell : Cells)
+	{
+		CellOccupancy.FindOrAdd(Cell, 0)++;
+	}
+}
+
+bool FPDBuildOccupancyGrid::RemoveOccupant(const int32 OccupantID)
+{
+	TArray<FIntPoint> Cells;
+	if (OccupantCells.RemoveAndCopyValue(OccupantID, Cells) == false) { return false; }
+
+	for (const FIntPoint& Cell : Cells)
+	{
+		int32* Count = CellOccupancy.Find(Cell);
+		if (Count == nullptr) { continue; }
+		
+		if (--(*Count) <= 0) { CellOccupancy.Remove(Cell); }
+	}
+	return true;
+}
+
+void FPDBuildOccupancyGrid::Reset()
+{
+	CellOccupancy.Reset();
+	OccupantCells.Reset();
+}
+
+bool FPDBuildOccupancyGrid::ValidateFootprint(const FBox& Footprint, TArray<FPDBuildFootprintCell>& OutCells) const
+{
+	OutCells.Reset();
+	if (Footprint.IsValid == false) { return false; }
+
+	TArray<FIntPoint> Cells;
+	GetCoveredCells(Footprint, Cells);
+	
+	bool bIsFree = true;
+	OutCells.Reserve(Cells.Num());
+	for (const FIntPoint& Cell : Cells)
+	{
+		FPDBuildFootprintCell& Result = OutCells.AddDefaulted_GetRef();
+		Result.Cell = Cell;
+		Result.CellCenter = GetCellCenter(Cell, Footprint.Min.Z);
+		Result.bBlocked = IsCellBlocked(Cell);
+		bIsFree &= Result.bBlocked == false;
+	}
+	return bIsFree;
+}
+
+void FPDBuildOccupancyGrid::GetCoveredCells(const FBox& WorldBounds, TArray<FIntPoint>& OutCells) const
+{
+	OutCells.Reset();
+	if (WorldBounds.IsValid == false) { return; }
+
+	const FVector Tolerance{EdgeTolerance, EdgeTolerance, 0.0};
+	const FIntPoint MinCell = GetCell(WorldBounds.Min + Tolerance);
+	const FIntPoint MaxCell = GetCell(FVector::Max(WorldBounds.Max - Tolerance, WorldBounds.Min + Tolerance));
+	
+	OutCells.Reserve((MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1));
+	for (int32 CellX = MinCell.X; CellX <= MaxCell.X; CellX++)
+	{
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; CellY++)
+		{
+			OutCells.Emplace(CellX, CellY);
+		}
+	}
+}
+
+FIntPoint FPDBuildOccupancyGrid::GetCell(const FVector& Location) const
+{
+	return FIntPoint{
+		static_cast<int32>(FMath::Floor(Location.X / CellSize)),
+		static_cast<int32>(FMath::Floor(Location.Y / CellSize))};
+}
+
+FVector FPDBuildOccupancyGrid::GetCellCenter(const FIntPoint& Cell, const double Z) const
+{
+	return FVector{(Cell.X + 0.5) * CellSize, (Cell.Y + 0.5) * CellSize, Z};
+}
+
 
 /**
 Business Source License 1.1
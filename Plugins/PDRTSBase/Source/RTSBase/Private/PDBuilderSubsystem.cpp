@@ -5,38 +5,104 @@
 
 #include "NiagaraComponent.h"
 #include "PDBuildCommon.h"
+#include "PDRTSSharedHashGrid.h"
+#include "PDTableIngestion.h"
+#include "Engine/World.h"
 #include "Interfaces/PDRTSBuildableGhostInterface.h"
 
 void UPDBuilderSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
-	for (const TSoftObjectPtr<UDataTable>& TablePath : GetDefault<UPDBuilderSubsystemSettings>()->BuildContextTables)
-	{
-		ProcessBuildContextTable(TablePath);
-	}
-
-	for (const TSoftObjectPtr<UDataTable>& TablePath : GetDefault<UPDBuilderSubsystemSettings>()->BuildWorkerTables)
-	{
-		ProcessBuildContextTable(TablePath);
-	}
-
-	for (const TSoftObjectPtr<UDataTable>& TablePath : GetDefault<UPDBuilderSubsystemSettings>()->BuildActionContextTables)
-	{
-		ProcessBuildContextTable(TablePath);
-	}
+	LoadAndProcessAllBuildTables(GetDefault<UPDBuilderSubsystemSettings>());
 
 	GetMutableDefault<UPDBuilderSubsystemSettings>()->OnSettingChanged().AddLambda(
 		[&](UObject* SettingsToChange, FPropertyChangedEvent& PropertyEvent)
 		{
 			OnDeveloperSettingsChanged(SettingsToChange,PropertyEvent);
 		});
+
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddUObject(this, &UPDBuilderSubsystem::OnWorldCleanup);
+}
+
+void UPDBuilderSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+	Super::Deinitialize();
+}
+
+void UPDBuilderSubsystem::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	OccupancyGrids.Remove(World);
 }
 
 const TCHAR* StrCtxt_ProcessBuildData = *FString("UPDBuilderSubsystem::ProcessBuildContextTable");
 
-void UPDBuilderSubsystem::ProcessBuildContextTable(const TSoftObjectPtr<UDataTable>& TablePath)
+/** @brief Resolves a row handle, records it as a broken row reference if it does not resolve to a row of the expected type */
+template<typename TRowType>
+static TRowType* ResolveBuildRowHandle(const FDataTableRowHandle& RowHandle, const FString& Referencer, TArray<FString>& BrokenRowReferences)
+{
+	TRowType* Row = RowHandle.DataTable != nullptr && RowHandle.DataTable->RowStruct == TRowType::StaticStruct()
+		? RowHandle.GetRow<TRowType>(Referencer)
+		: nullptr;
+	if (Row != nullptr) { return Row; }
+
+	BrokenRowReferences.Emplace(FString::Printf(TEXT("%s -> (Table: %s, Row: %s, Expected row type: %s)"),
+		*Referencer,
+		RowHandle.DataTable != nullptr ? *RowHandle.DataTable->GetName() : TEXT("None"),
+		*RowHandle.RowName.ToString(),
+		*TRowType::StaticStruct()->GetName()));
+	return nullptr;
+}
+
+void UPDBuilderSubsystem::LoadAndProcessAllBuildTables(const UPDBuilderSubsystemSettings* Settings)
+{
+	// Context tables first, then workers and then action contexts, the ingestion keeps this order
+	TArray<TSoftObjectPtr<UDataTable>> TablePaths;
+	TablePaths.Append(Settings->BuildContextTables);
+	TablePaths.Append(Settings->BuildWorkerTables);
+	TablePaths.Append(Settings->BuildActionContextTables);
+
+	// Processing writes straight into the subsystems lookup maps and bakes them, so it stays on the game-thread. Only the streaming is asynchronous
+	FPDTableIngestion::Get().Ingest(
+		TableIngestionName,
+		TablePaths,
+		[](const TArray<UDataTable*>& Tables) {},
+		[this](const TArray<UDataTable*>& Tables)
+		{
+			ProcessAllBuildTables(Tables);
+			bHasProcessedBuildTables = true;
+		});
+}
+
+void UPDBuilderSubsystem::ProcessAllBuildTables(const TArray<UDataTable*>& Tables)
+{
+	ResetBuildTableData();
+	for (UDataTable* Table : Tables)
+	{
+		ProcessBuildContextTable(Table);
+	}
+	BakeLookupTables();
+}
+
+void UPDBuilderSubsystem::ResetBuildTableData()
+{
+	BuildContextTables.Empty();
+	GrantedBuildContexts_WorkerTag.Empty();
+	WorkerTags_PerBuildContext.Empty();
+	ValidUnitTypes_PerBuildable.Empty();
+	GrantedActionContexts_KeyedByBuildableTag.Empty();
+	ActionData_WTag.Empty();
+	BuildContexts_WTag.Empty();
+	BuildableData_WTag.Empty();
+	BuildableParentContexts_ByBuildableTag.Empty();
+	Buildable_WClass.Empty();
+	BuildableData_WTagReverse.Empty();
+	BrokenRowReferences.Empty();
+	LookupTables.Reset();
+}
+
+void UPDBuilderSubsystem::ProcessBuildContextTable(UDataTable* BuildContextTable)
 {
-	UDataTable* BuildContextTable = TablePath.LoadSynchronous();
 	if (BuildContextTable == nullptr) { return; }
 		
 	BuildContextTables.Emplace(BuildContextTable);
@@ -48,9 +114,11 @@ void UPDBuilderSubsystem::ProcessBuildContextTable(const TSoftObjectPtr<UDataTab
 		{
 			for (const FDataTableRowHandle& BuildableDatum : BuildContext->BuildablesData)
 			{
-				const FString CtxtStr = FString::Printf(TEXT("UPDBuilderSubsystem::ProcessBuildContextTable(BuildableDatum: %s)"), *BuildableDatum.RowName.ToString());
-				FPDBuildable* Buildable = BuildableDatum.GetRow<FPDBuildable>(CtxtStr);
-				BuildableParentContexts_ByBuildableTag.FindOrAdd(Buildable->BuildableTag).Emplace(BuildContext->ContextTag);
+				const FString CtxtStr = FString::Printf(TEXT("UPDBuilderSubsystem::ProcessBuildContextTable(Context: %s, BuildableDatum: %s)"), *BuildContext->ContextTag.ToString(), *BuildableDatum.RowName.ToString());
+				FPDBuildable* Buildable = ResolveBuildRowHandle<FPDBuildable>(BuildableDatum, CtxtStr, BrokenRowReferences);
+				if (Buildable == nullptr) { continue; }
+				
+				BuildableParentContexts_ByBuildableTag.FindOrAdd(Buildable->BuildableTag).AddUnique(BuildContext->ContextTag);
 				
 				BuildableData_WTag.Emplace(Buildable->BuildableTag, &Buildable->BuildableData);
 				BuildableData_WTagReverse.Emplace(&Buildable->BuildableData, Buildable->BuildableTag);
@@ -72,9 +140,11 @@ void UPDBuilderSubsystem::ProcessBuildContextTable(const TSoftObjectPtr<UDataTab
 			// Map all context tags to their valid worker types, will be needed to properly find applicable worker types efficiently during runtime
 			for (const FDataTableRowHandle& ContextHandle : GrantedContext->GrantedContexts)
 			{
-				const FString CtxtStr = FString::Printf(TEXT("UPDBuilderSubsystem::ProcessBuildContextTable(ContextHandle: %s)"), *ContextHandle.RowName.ToString());
-				const FPDBuildContext* BuildContext = ContextHandle.GetRow<FPDBuildContext>("");
-				WorkerTags_PerBuildContext.FindOrAdd(BuildContext->ContextTag).Emplace(GrantedContext->WorkerType);
+				const FString CtxtStr = FString::Printf(TEXT("UPDBuilderSubsystem::ProcessBuildContextTable(Worker: %s, ContextHandle: %s)"), *GrantedContext->WorkerType.ToString(), *ContextHandle.RowName.ToString());
+				const FPDBuildContext* BuildContext = ResolveBuildRowHandle<FPDBuildContext>(ContextHandle, CtxtStr, BrokenRowReferences);
+				if (BuildContext == nullptr) { continue; }
+				
+				WorkerTags_PerBuildContext.FindOrAdd(BuildContext->ContextTag).AddUnique(GrantedContext->WorkerType);
 			}
 			
 		}
@@ -88,42 +158,148 @@ void UPDBuilderSubsystem::ProcessBuildContextTable(const TSoftObjectPtr<UDataTab
 		{
 			for (const FDataTableRowHandle& ActionDatum : GrantedContext->ActionData)
 			{
-				const FString CtxtStr = FString::Printf(TEXT("UPDBuilderSubsystem::ProcessBuildContextTable(ActionDatum: %s)"), *ActionDatum.RowName.ToString());
-				FPDBuildAction* Action = ActionDatum.GetRow<FPDBuildAction>(CtxtStr);
+				const FString CtxtStr = FString::Printf(TEXT("UPDBuilderSubsystem::ProcessBuildContextTable(ActionContext: %s, ActionDatum: %s)"), *GrantedContext->ContextTag.ToString(), *ActionDatum.RowName.ToString());
+				FPDBuildAction* Action = ResolveBuildRowHandle<FPDBuildAction>(ActionDatum, CtxtStr, BrokenRowReferences);
+				if (Action == nullptr) { continue; }
+				
 				ActionData_WTag.Emplace(Action->ActionTag, Action);
 			}			
 			
 			GrantedActionContexts_KeyedByBuildableTag.Emplace(GrantedContext->ContextTag, GrantedContext);
 		}
 	}
+}
 
+void UPDBuilderSubsystem::BakeLookupTables()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_BakeBuildLookupTables)
+	
+	LookupTables.Reset();
+	
+	// Intern every tag the tables know of and store the row data by index
+	for (const TTuple<FGameplayTag, const FPDBuildContext*>& BuildContextEntry : BuildContexts_WTag)
+	{
+		const int32 ContextIdx = LookupTables.InternTag(BuildContextEntry.Key);
+		LookupTables.BuildContexts[ContextIdx] = BuildContextEntry.Value;
+	}
+	for (const TTuple<FGameplayTag, const FPDBuildableData*>& BuildableEntry : BuildableData_WTag)
+	{
+		const int32 BuildableIdx = LookupTables.InternTag(BuildableEntry.Key);
+		LookupTables.BuildableData[BuildableIdx] = BuildableEntry.Value;
+	}
+	for (const TTuple<FGameplayTag, const FPDBuildWorker*>& WorkerEntry : GrantedBuildContexts_WorkerTag)
+	{
+		const int32 WorkerIdx = LookupTables.InternTag(WorkerEntry.Key);
+		LookupTables.Workers[WorkerIdx] = WorkerEntry.Value;
+	}
 
-	// tally up all the valid worker types per buildable
-	for (const TTuple<UClass*, const FPDBuildable*>& Buildable_WClass_Entry : Buildable_WClass)
+	// Relationships, by interned index
+	TMap<int32, TArray<int32>> ParentContexts;
+	for (const TTuple<FGameplayTag, TArray<FGameplayTag>>& Entry : BuildableParentContexts_ByBuildableTag)
 	{
-		const TArray<FGameplayTag>& ParentContextTags = BuildableParentContexts_ByBuildableTag.FindRef(Buildable_WClass_Entry.Value->BuildableTag);
-		
-		for (const FGameplayTag& ContextTag : ParentContextTags)
+		TArray<int32>& ContextIndices = ParentContexts.FindOrAdd(LookupTables.InternTag(Entry.Key));
+		for (const FGameplayTag& ContextTag : Entry.Value) { ContextIndices.Emplace(LookupTables.InternTag(ContextTag)); }
+	}
+	TMap<int32, TArray<int32>> ContextWorkers;
+	for (const TTuple<FGameplayTag, TArray<FGameplayTag>>& Entry : WorkerTags_PerBuildContext)
+	{
+		TArray<int32>& WorkerIndices = ContextWorkers.FindOrAdd(LookupTables.InternTag(Entry.Key));
+		for (const FGameplayTag& WorkerTag : Entry.Value) { WorkerIndices.Emplace(LookupTables.InternTag(WorkerTag)); }
+	}
+
+	const int32 TagCount = LookupTables.InternedTags.Num();
+	LookupTables.ParentContexts_PerBuildable.Bake(TagCount, ParentContexts);
+	LookupTables.Workers_PerBuildContext.Bake(TagCount, ContextWorkers);
+
+	// Tally up all the valid worker types per buildable
+	TMap<int32, TArray<int32>> BuildableWorkers;
+	for (const TTuple<int32, TArray<int32>>& Entry : ParentContexts)
+	{
+		TArray<int32>& WorkerIndices = BuildableWorkers.FindOrAdd(Entry.Key);
+		for (const int32 ContextIdx : LookupTables.ParentContexts_PerBuildable.Get(Entry.Key))
 		{
-			if (WorkerTags_PerBuildContext.Contains(ContextTag) == false)
-			{
-				UE_LOG(PDLog_BuildSystem, Warning, TEXT("There are no worker types allowed for build context: %s"), *ContextTag.GetTagName().ToString())
-				continue;
-			}
-			const TArray<FGameplayTag>* ValidWorkerTypesForContext = WorkerTags_PerBuildContext.Find(ContextTag);
-			check(ValidWorkerTypesForContext != nullptr && "If the entry exists in WorkerTags_PerBuildContext it should never be nullptr at this point. Take a good look in the mirror if hitting this assertion")
-			
-			ValidUnitTypes_PerBuildable.FindOrAdd(Buildable_WClass_Entry.Value->BuildableTag).Append(*ValidWorkerTypesForContext);
+			WorkerIndices.Append(LookupTables.Workers_PerBuildContext.Get(ContextIdx));
 		}
 	}
+	LookupTables.ValidWorkers_PerBuildable.Bake(TagCount, BuildableWorkers);
 
+	// Keep the tag keyed map in sync for existing callers, deduplicated via the baked relation
+	ValidUnitTypes_PerBuildable.Empty();
+	for (const TTuple<int32, TArray<int32>>& Entry : BuildableWorkers)
+	{
+		TArray<FGameplayTag>& WorkerTypes = ValidUnitTypes_PerBuildable.FindOrAdd(LookupTables.GetTag(Entry.Key));
+		for (const int32 WorkerIdx : LookupTables.ValidWorkers_PerBuildable.Get(Entry.Key)) { WorkerTypes.Emplace(LookupTables.GetTag(WorkerIdx)); }
+	}
 
+	ValidateLookupTables();
+}
+
+int32 UPDBuilderSubsystem::ValidateLookupTables() const
+{
+	int32 IssueCount = BrokenRowReferences.Num();
+	for (const FString& BrokenRowReference : BrokenRowReferences)
+	{
+		UE_LOG(PDLog_BuildSystem, Error, TEXT("UPDBuilderSubsystem::ValidateLookupTables -- Broken row reference: %s"), *BrokenRowReference)
+	}
+
+	for (int32 TagIdx = 0; TagIdx < LookupTables.InternedTags.Num(); TagIdx++)
+	{
+		const FGameplayTag& Tag = LookupTables.GetTag(TagIdx);
+		if (LookupTables.BuildContexts[TagIdx] != nullptr && LookupTables.Workers_PerBuildContext.Get(TagIdx).IsEmpty())
+		{
+			UE_LOG(PDLog_BuildSystem, Warning, TEXT("UPDBuilderSubsystem::ValidateLookupTables -- There are no worker types allowed for build context: %s"), *Tag.ToString())
+			IssueCount++;
+		}
+		if (LookupTables.BuildableData[TagIdx] != nullptr && LookupTables.ValidWorkers_PerBuildable.Get(TagIdx).IsEmpty())
+		{
+			UE_LOG(PDLog_BuildSystem, Warning, TEXT("UPDBuilderSubsystem::ValidateLookupTables -- No worker type is able to build buildable: %s"), *Tag.ToString())
+			IssueCount++;
+		}
+	}
 	
+	UE_LOG(PDLog_BuildSystem, Log, TEXT("UPDBuilderSubsystem::ValidateLookupTables -- Baked %i tags, %i parent-context links, %i context-worker links, %i buildable-worker links. Found %i issue(s)"),
+		LookupTables.InternedTags.Num(),
+		LookupTables.ParentContexts_PerBuildable.Values.Num(),
+		LookupTables.Workers_PerBuildContext.Values.Num(),
+		LookupTables.ValidWorkers_PerBuildable.Values.Num(),
+		IssueCount)
+	return IssueCount;
 }
 
 const FPDBuildContext* UPDBuilderSubsystem::GetBuildContextEntry(const FGameplayTag& BuildContextTag)
 {
-	return BuildContexts_WTag.Contains(BuildContextTag) ? *BuildContexts_WTag.Find(BuildContextTag) : nullptr;
+	const int32 TagIdx = LookupTables.FindTagIndex(BuildContextTag);
+	return TagIdx != INDEX_NONE ? LookupTables.BuildContexts[TagIdx] : nullptr;
+}
+
+int32 UPDBuilderSubsystem::GetBuildTagIndex(const FGameplayTag& Tag) const
+{
+	return LookupTables.FindTagIndex(Tag);
+}
+
+TConstArrayView<int32> UPDBuilderSubsystem::GetValidWorkerIndices(const int32 BuildableIdx) const
+{
+	return LookupTables.ValidWorkers_PerBuildable.Get(BuildableIdx);
+}
+
+bool UPDBuilderSubsystem::IsWorkerValidForBuildable(const int32 WorkerIdx, const int32 BuildableIdx) const
+{
+	return LookupTables.ValidWorkers_PerBuildable.Contains(BuildableIdx, WorkerIdx);
+}
+
+bool UPDBuilderSubsystem::IsWorkerValidForBuildable(const FGameplayTag& WorkerTag, const FGameplayTag& BuildableTag) const
+{
+	return IsWorkerValidForBuildable(LookupTables.FindTagIndex(WorkerTag), LookupTables.FindTagIndex(BuildableTag));
+}
+
+void UPDBuilderSubsystem::GetValidWorkerTypes(const FGameplayTag& BuildableTag, TArray<FGameplayTag>& OutWorkerTypes) const
+{
+	const TConstArrayView<int32> WorkerIndices = GetValidWorkerIndices(LookupTables.FindTagIndex(BuildableTag));
+	OutWorkerTypes.Reset(WorkerIndices.Num());
+	for (const int32 WorkerIdx : WorkerIndices)
+	{
+		OutWorkerTypes.Emplace(LookupTables.GetTag(WorkerIdx));
+	}
 }
 
 const FPDBuildable* UPDBuilderSubsystem::GetBuildableFromClass(const TSubclassOf<AActor> Class)
@@ -150,7 +326,8 @@ const FPDBuildable* UPDBuilderSubsystem::GetBuildableWithActionsFromClassStatic(
 
 const FPDBuildableData* UPDBuilderSubsystem::GetBuildableData(const FGameplayTag& BuildableTag)
 {
-	return BuildableData_WTag.Contains(BuildableTag) ? *BuildableData_WTag.Find(BuildableTag) : nullptr;
+	const int32 TagIdx = LookupTables.FindTagIndex(BuildableTag);
+	return TagIdx != INDEX_NONE ? LookupTables.BuildableData[TagIdx] : nullptr;
 }
 
 const FGameplayTag& UPDBuilderSubsystem::GetBuildableTagFromData(const FPDBuildableData* BuildableData)
@@ -160,7 +337,8 @@ const FGameplayTag& UPDBuilderSubsystem::GetBuildableTagFromData(const FPDBuilda
 
 const FPDBuildWorker* UPDBuilderSubsystem::GetWorkerData(const FGameplayTag& WorkerTag)
 {
-	return GrantedBuildContexts_WorkerTag.Contains(WorkerTag) ? *GrantedBuildContexts_WorkerTag.Find(WorkerTag) : nullptr;
+	const int32 TagIdx = LookupTables.FindTagIndex(WorkerTag);
+	return TagIdx != INDEX_NONE ? LookupTables.Workers[TagIdx] : nullptr;
 }
 
 const FPDBuildWorker* UPDBuilderSubsystem::GetWorkerDataStatic(const FGameplayTag& WorkerTag)
@@ -188,7 +366,12 @@ void UPDBuilderSubsystem::PassOverDataFromQueue()
 
 UPDBuilderSubsystem* UPDBuilderSubsystem::Get()
 {
-	return GEngine->GetEngineSubsystem<UPDBuilderSubsystem>();
+	UPDBuilderSubsystem* Self = GEngine->GetEngineSubsystem<UPDBuilderSubsystem>();
+	if (Self->bHasProcessedBuildTables == false && IsInGameThread())
+	{
+		FPDTableIngestion::Get().Flush(TableIngestionName);
+	}
+	return Self;
 }
 
 void UPDBuilderSubsystem::ProcessGhostStageDataAsset(const AActor* GhostActor, const bool bIsStartOfStage, const FPDRTSGhostStageData& SelectedStageData)
@@ -241,6 +424,9 @@ void UPDBuilderSubsystem::ProcessGhostStageDataAsset(const AActor* GhostActor, c
 	{
 		// @todo hook some event here where users can control mesh transition by other means 
 		ActorMeshComp->SetStaticMesh(SelectedStageData.StageDA->StageGhostMesh);
+
+		// Stage meshes may differ in size, keep the ghosts footprint in sync with the new mesh
+		UPDBuilderSubsystem::Get()->RefreshOccupant(GhostActor);
 	}
 
 	bCanApplyVFX &= NiagaraComp != nullptr;
@@ -317,6 +503,52 @@ void UPDBuilderSubsystem::WorldInit(const UWorld* World)
 	WorldBuildableLocationList.Empty();
 }
 
+FPDBuildOccupancyGrid& UPDBuilderSubsystem::GetOccupancyGrid(const UWorld* World)
+{
+	FPDBuildOccupancyGrid* Grid = OccupancyGrids.Find(World);
+	if (Grid != nullptr) { return *Grid; }
+	
+	return OccupancyGrids.Emplace(World, FPDBuildOccupancyGrid{GetDefault<UPDHashGridDeveloperSettings>()->UniformCellSize});
+}
+
+void UPDBuilderSubsystem::RegisterOccupant(const AActor* Occupant)
+{
+	if (Occupant == nullptr || Occupant->GetWorld() == nullptr) { return; }
+
+	GetOccupancyGrid(Occupant->GetWorld()).SetOccupant(Occupant->GetUniqueID(), Occupant->GetComponentsBoundingBox(true));
+}
+
+void UPDBuilderSubsystem::RefreshOccupant(const AActor* Occupant)
+{
+	if (Occupant == nullptr || Occupant->GetWorld() == nullptr) { return; }
+
+	FPDBuildOccupancyGrid& Grid = GetOccupancyGrid(Occupant->GetWorld());
+	if (Grid.HasOccupant(Occupant->GetUniqueID()) == false) { return; }
+	
+	Grid.SetOccupant(Occupant->GetUniqueID(), Occupant->GetComponentsBoundingBox(true));
+}
+
+void UPDBuilderSubsystem::DeregisterOccupant(const AActor* Occupant)
+{
+	if (Occupant == nullptr) { return; }
+	
+	DeregisterOccupantByID(Occupant->GetUniqueID());
+}
+
+void UPDBuilderSubsystem::DeregisterOccupantByID(const int32 OccupantID)
+{
+	for (TPair<const UWorld*, FPDBuildOccupancyGrid>& GridEntry : OccupancyGrids)
+	{
+		if (GridEntry.Value.RemoveOccupant(OccupantID)) { return; }
+	}
+}
+
+bool UPDBuilderSubsystem::ValidatePlacement(const UWorld* World, const FBox& Footprint, TArray<FPDBuildFootprintCell>& OutCells)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_ValidateBuildPlacement)
+	return GetOccupancyGrid(World).ValidateFootprint(Footprint, OutCells);
+}
+
 void UPDBuilderSubsystem::OnDeveloperSettingsChanged(UObject* SettingsToChange, FPropertyChangedEvent& PropertyEvent)
 {
 	const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(PropertyEvent.Property);
@@ -326,19 +558,10 @@ void UPDBuilderSubsystem::OnDeveloperSettingsChanged(UObject* SettingsToChange,
 	if(ObjectProperty == nullptr) { return; }
 	
 	if(ObjectProperty->PropertyClass != UDataTable::StaticClass()) { return; }
-	
-	BuildContextTables.Empty();
-	for(const TSoftObjectPtr<UDataTable>& TablePath : Cast<UPDBuilderSubsystemSettings>(SettingsToChange)->BuildContextTables)
-	{
-		ProcessBuildContextTable(TablePath);
-	}
 
-	GrantedBuildContexts_WorkerTag.Empty();
-	for (const TSoftObjectPtr<UDataTable>& TablePath : GetDefault<UPDBuilderSubsystemSettings>()->BuildWorkerTables)
-	{
-		ProcessBuildContextTable(TablePath);
-	}		
-	
+	// Re-ingest every table and re-bake, partial re-ingestion would leave stale relations in the baked tables
+	const UPDBuilderSubsystemSettings* Settings = Cast<UPDBuilderSubsystemSettings>(SettingsToChange);
+	LoadAndProcessAllBuildTables(Settings != nullptr ? Settings : GetDefault<UPDBuilderSubsystemSettings>());
 }
 
 TArray<FPDActorCompound>& UPDBuilderSubsystem::BlockMutationOfBuildableTrackingData()
@@ -11,6 +11,7 @@
 #include "MassVisualizer.h"
 #include "NavigationSystem.h"
 #include "PDBuilderSubsystem.h"
+#include "PDTableIngestion.h"
 #include "Interfaces/PDRTSBuildableGhostInterface.h"
 #include "Pawns/PDRTSBaseUnit.h"
 
@@ -37,26 +38,23 @@ FRWLock UPDRTSBaseSubsystem::PlayerDataLock{};
 void UPDRTSBaseSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
-	LoadAndProcessTables();
-}
-
-void UPDRTSBaseSubsystem::LoadAndProcessTables()
-{
-	for (const TSoftObjectPtr<UDataTable>& TablePath : GetDefault<UPDRTSSubsystemSettings>()->WorkTables)
-	{
-		UDataTable* ResolvedTable = TablePath.LoadSynchronous();
-		WorkTables.Emplace(ResolvedTable);
-
-		ResolvedTable->OnDataTableChanged().AddLambda([&]() { ProcessTables(); });
-	}
 
 	GetMutableDefault<UPDRTSSubsystemSettings>()->OnSettingChanged().AddLambda(
 		[&](UObject* SettingsToChange, FPropertyChangedEvent& PropertyEvent)
 		{
 			OnDeveloperSettingsChanged(SettingsToChange,PropertyEvent);
 		});
+	
+	LoadAndProcessTables();
+}
 
-	ProcessTables();
+void UPDRTSBaseSubsystem::LoadAndProcessTables()
+{
+	FPDTableIngestion::Get().Ingest<FPDWorkTableData>(
+		TableIngestionName,
+		GetDefault<UPDRTSSubsystemSettings>()->WorkTables,
+		[](const TArray<UDataTable*>& Tables, FPDWorkTableData& OutData) { BuildWorkTableData(Tables, OutData); },
+		[this](const TArray<UDataTable*>& Tables, FPDWorkTableData&& Data) { PublishWorkTableData(Tables, MoveTemp(Data)); });
 }
 
 void UPDRTSBaseSubsystem::DispatchOctreeGeneration()
@@ -71,17 +69,14 @@ void UPDRTSBaseSubsystem::DispatchOctreeGeneration()
 
 void UPDRTSBaseSubsystem::ProcessTables()
 {
-	ProcessFailCounter++;
-	if (WorkTables.IsEmpty())
-	{
-		const FString BuildString = "UPDRTSBaseSubsystem::ProcessTables -- "
-		+ FString::Printf(TEXT("\n 'WorkTables' array is empty. Is not able to process data"));
-		UE_LOG(PDLog_RTSBase, Error, TEXT("%s"), *BuildString);
-		
-		return;
-	}
-	
-	for (const UDataTable* Table : WorkTables)
+	FPDWorkTableData Data;
+	BuildWorkTableData(WorkTables, Data);
+	PublishWorkTableData(WorkTables, MoveTemp(Data));
+}
+
+void UPDRTSBaseSubsystem::BuildWorkTableData(const TArray<UDataTable*>& Tables, FPDWorkTableData& OutData)
+{
+	for (const UDataTable* Table : Tables)
 	{
 		if (Table == nullptr
 			|| Table->IsValidLowLevelFast() == false
@@ -113,9 +108,9 @@ void UPDRTSBaseSubsystem::ProcessTables()
 			}
 			
 			// @note If duplicates, ignore duplicate and output errors to screen and to log
-			if (TagToJobMap.Contains(JobTag))
+			if (OutData.TagToJobMap.Contains(JobTag))
 			{
-				const UDataTable* RetrievedTable = TagToTable.FindRef(JobTag);
+				const UDataTable* RetrievedTable = OutData.TagToTable.FindRef(JobTag);
 				
 				const FString BuildString = "UPDInventorySubsystem::ProcessTables -- "
 				+ FString::Printf(TEXT("Processing table(%s)"), *Table->GetName()) 
@@ -127,12 +122,38 @@ void UPDRTSBaseSubsystem::ProcessTables()
 				continue;
 			}
 			
-			TagToJobMap.Emplace(DefaultDatum->JobTag) = DefaultDatum;
-			NameToTagMap.Emplace(Name) = JobTag;
-			TagToNameMap.Emplace(JobTag) = Name;
-			TagToTable.Emplace(JobTag) = Table;
+			OutData.TagToJobMap.Emplace(DefaultDatum->JobTag) = DefaultDatum;
+			OutData.NameToTagMap.Emplace(Name) = JobTag;
+			OutData.TagToNameMap.Emplace(JobTag) = Name;
+			OutData.TagToTable.Emplace(JobTag) = Table;
 		}
 	}
+}
+
+void UPDRTSBaseSubsystem::PublishWorkTableData(const TArray<UDataTable*>& Tables, FPDWorkTableData&& Data)
+{
+	// Re-process whenever one of the tables is edited
+	if (WorkTables != Tables)
+	{
+		for (UDataTable* Table : WorkTables) { Table->OnDataTableChanged().RemoveAll(this); }
+		WorkTables = Tables;
+		for (UDataTable* Table : WorkTables) { Table->OnDataTableChanged().AddUObject(this, &UPDRTSBaseSubsystem::ProcessTables); }
+	}
+	
+	ProcessFailCounter++;
+	if (WorkTables.IsEmpty())
+	{
+		const FString BuildString = "UPDRTSBaseSubsystem::PublishWorkTableData -- "
+		+ FString::Printf(TEXT("\n 'WorkTables' array is empty. Is not able to process data"));
+		UE_LOG(PDLog_RTSBase, Error, TEXT("%s"), *BuildString);
+		
+		return;
+	}
+
+	TagToJobMap = MoveTemp(Data.TagToJobMap);
+	NameToTagMap = MoveTemp(Data.NameToTagMap);
+	TagToNameMap = MoveTemp(Data.TagToNameMap);
+	TagToTable = MoveTemp(Data.TagToTable);
 	ProcessFailCounter = 0;
 	bHasProcessedTables = true;
 }
@@ -145,28 +166,72 @@ void UPDRTSBaseSubsystem::RequestNavpathGenerationForSelectionGroup(
 {
 	if (SelectionGroup != INDEX_NONE)
 	{
-		const FVector TargetLocation =
-			TargetCompound.ActionTargetAsActor != nullptr ? TargetCompound.ActionTargetAsActor->GetActorLocation()
-			: EntityManager->IsEntityValid(TargetCompound.ActionTargetAsEntity) ? EntityManager->GetFragmentDataPtr<FTransformFragment>(TargetCompound.ActionTargetAsEntity)->GetTransform().GetLocation()
-			: TargetCompound.ActionTargetAsLocation.Get();
+		const FVector TargetLocation = ResolveTargetLocation(TargetCompound);
 
 		const UNavigationPath* Navpath = UNavigationSystemV1::FindPathToLocationSynchronously(GetWorld(), SelectionCenter, TargetLocation);
 		SelectionGroupNavData.FindOrAdd(OwnerID).SelectionGroupNavData.FindOrAdd(SelectionGroup) = Navpath;
 		DirtySharedData.Emplace(OwnerID, SelectionGroup);
+		SelectionGroupFlowFields.Remove(MakeTuple(OwnerID, SelectionGroup));
 		// bGroupPathsDirtied = true;
 	}	
 }
 
+void UPDRTSBaseSubsystem::RequestFlowFieldForSelectionGroup(
+	const int32 OwnerID,
+	const int32 SelectionGroup,
+	const FVector& SelectionCenter,
+	const FPDTargetCompound& TargetCompound)
+{
+	if (SelectionGroup == INDEX_NONE) { return; }
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_PDRTSBaseSubsystem_RequestFlowField);
+
+	const UPDFlowFieldSettings* Settings = GetDefault<UPDFlowFieldSettings>();
+	const FVector TargetLocation = ResolveTargetLocation(TargetCompound);
+
+	FBox GridBounds(ForceInit);
+	GridBounds += SelectionCenter;
+	GridBounds += TargetLocation;
+	GridBounds = GridBounds.ExpandBy(FVector(Settings->GridPadding, Settings->GridPadding, 0.0));
+
+	FPDFlowFieldGrid Grid;
+	Grid.BuildFromNavigation(GetWorld(), GridBounds, Settings->CellSize, Settings->MaxGridDimension, Settings->MaxGridCells, Settings->NavProjectionHeight);
+
+	const TSharedRef<FPDFlowField> FlowField = MakeShared<FPDFlowField>();
+	if (FlowField->Build(Grid, TargetLocation) == false)
+	{
+		// Destination is off the walkable grid, fall back to a regular shared navpath
+		UE_LOG(PDLog_RTSBase, Warning, TEXT("UPDRTSBaseSubsystem::RequestFlowFieldForSelectionGroup -- Target is not on a walkable cell, falling back to a shared navpath"))
+		RequestNavpathGenerationForSelectionGroup(OwnerID, SelectionGroup, SelectionCenter, TargetCompound);
+		return;
+	}
+
+	SelectionGroupFlowFields.FindOrAdd(MakeTuple(OwnerID, SelectionGroup)) = FlowField;
+}
+
+TSharedPtr<const FPDFlowField> UPDRTSBaseSubsystem::FindSelectionGroupFlowField(const int32 OwnerID, const int32 SelectionGroup) const
+{
+	return SelectionGroupFlowFields.FindRef(MakeTuple(OwnerID, SelectionGroup));
+}
+
+FVector UPDRTSBaseSubsystem::ResolveTargetLocation(const FPDTargetCompound& TargetCompound) const
+{
+	return TargetCompound.ActionTargetAsActor != nullptr ? TargetCompound.ActionTargetAsActor->GetActorLocation()
+		: EntityManager->IsEntityValid(TargetCompound.ActionTargetAsEntity) ? EntityManager->GetFragmentDataPtr<FTransformFragment>(TargetCompound.ActionTargetAsEntity)->GetTransform().GetLocation()
+		: TargetCompound.ActionTargetAsLocation.Get();
+}
+
 const FPDWorkUnitDatum* UPDRTSBaseSubsystem::GetWorkEntry(const FGameplayTag& JobTag)
 {
-	if (bHasProcessedTables == false && ProcessFailCounter < 2) { ProcessTables(); }
+	// Mass tasks can get here off the game-thread, flushing is only allowed on it
+	if (bHasProcessedTables == false && ProcessFailCounter < 2 && IsInGameThread()) { FPDTableIngestion::Get().Flush(TableIngestionName); }
 	
 	return TagToJobMap.Contains(JobTag) ? TagToJobMap.FindRef(JobTag) : nullptr;
 }
 
 const FPDWorkUnitDatum* UPDRTSBaseSubsystem::GetWorkEntry(const FName& JobRowName)
 {
-	if (bHasProcessedTables == false && ProcessFailCounter < 2) { ProcessTables(); }
+	// Mass tasks can get here off the game-thread, flushing is only allowed on it
+	if (bHasProcessedTables == false && ProcessFailCounter < 2 && IsInGameThread()) { FPDTableIngestion::Get().Flush(TableIngestionName); }
 	
 	const FGameplayTag& JobTag = NameToTagMap.Contains(JobRowName) ? NameToTagMap.FindRef(JobRowName) : FGameplayTag::EmptyTag;
 	return GetWorkEntry(JobTag);
@@ -258,16 +323,7 @@ void UPDRTSBaseSubsystem::OnDeveloperSettingsChanged(UObject* SettingsToChange,
 	
 	if(ObjectProperty->PropertyClass != UDataTable::StaticClass()) { return; }
 
-	WorkTables.Empty(); // clear array and refill with edited properties.
-	for(const TSoftObjectPtr<UDataTable>& TablePath : Cast<UPDRTSSubsystemSettings>(SettingsToChange)->WorkTables)
-	{
-		UDataTable* ResolvedTable = TablePath.LoadSynchronous();
-		WorkTables.Emplace(ResolvedTable);
-		
-		ResolvedTable->OnDataTableChanged().AddLambda([&]() { ProcessTables(); });
-	}
-
-	ProcessTables();
+	LoadAndProcessTables(); // Re-ingest with the edited properties
 }
 
 
@@ -0,0 +1,335 @@
+﻿/* @author: Ario Amin @ Permafrost Development. @copyright: Full BSL(1.1) License included at bottom of the file  */
+#include "PDRTSFlowField.h"
+
+#include "NavigationSystem.h"
+
+namespace PD::FlowField
+{
+	/** @brief Neighbour offsets, odd indices are the diagonals */
+	static const FIntPoint NeighbourOffsets[8] =
+	{
+		FIntPoint( 1,  0), FIntPoint( 1,  1), FIntPoint( 0,  1), FIntPoint(-1,  1),
+		FIntPoint(-1,  0), FIntPoint(-1, -1), FIntPoint( 0, -1), FIntPoint( 1, -1)
+	};
+	/** @brief Unit direction per neighbour offset */
+	static const FVector NeighbourDirections[8] =
+	{
+		FVector( 1.0,  0.0, 0.0), FVector( UE_INV_SQRT_2,  UE_INV_SQRT_2, 0.0), FVector( 0.0,  1.0, 0.0), FVector(-UE_INV_SQRT_2,  UE_INV_SQRT_2, 0.0),
+		FVector(-1.0,  0.0, 0.0), FVector(-UE_INV_SQRT_2, -UE_INV_SQRT_2, 0.0), FVector( 0.0, -1.0, 0.0), FVector( UE_INV_SQRT_2, -UE_INV_SQRT_2, 0.0)
+	};
+	/** @brief Step costs, straight and diagonal */
+	static constexpr uint32 StraightStepCost = 10;
+	static constexpr uint32 DiagonalStepCost = 14;
+
+	/** @brief Diagonal steps are only allowed if both adjacent straight cells are walkable, stops units cutting the corners of blocked cells */
+	FORCEINLINE bool CanStep(const FPDFlowFieldGrid& Grid, const FIntPoint& From, const int32 NeighbourIdx)
+	{
+		const FIntPoint& Offset = NeighbourOffsets[NeighbourIdx];
+		if (Grid.IsWalkable(From + Offset) == false) { return false; }
+		if ((NeighbourIdx & 1) == 0) { return true; }
+
+		return Grid.IsWalkable(FIntPoint(From.X + Offset.X, From.Y))
+			&& Grid.IsWalkable(FIntPoint(From.X, From.Y + Offset.Y));
+	}
+}
+
+//
+// Grid
+void FPDFlowFieldGrid::Initialize(const FVector2D& InOrigin, const double InCellSize, const FIntPoint& InDimensions, const uint8 DefaultCost)
+{
+	Origin = InOrigin;
+	CellSize = FMath::Max(InCellSize, UE_KINDA_SMALL_NUMBER);
+	Dimensions = FIntPoint(FMath::Max(InDimensions.X, 0), FMath::Max(InDimensions.Y, 0));
+	Costs.Init(DefaultCost, Dimensions.X * Dimensions.Y);
+}
+
+void FPDFlowFieldGrid::BuildFromNavigation(UWorld* World, const FBox& Bounds, const double InCellSize, const int32 MaxDimension, const int32 MaxCellCount, const double ProjectionHeight)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_PDFlowFieldGrid_BuildFromNavigation);
+
+	const FVector Size = Bounds.GetSize();
+	const int32 ClampedMaxDimension = FMath::Max(MaxDimension, 1);
+	const int32 ClampedMaxCellCount = FMath::Max(MaxCellCount, 1);
+	double FittedCellSize = FMath::Max(
+		FMath::Max3(InCellSize, Size.X / ClampedMaxDimension, Size.Y / ClampedMaxDimension),
+		FMath::Sqrt(Size.X * Size.Y / ClampedMaxCellCount));
+
+	const auto FitDimensions = [&]()
+	{
+		return FIntPoint(
+			FMath::Clamp(FMath::CeilToInt32(Size.X / FittedCellSize), 1, ClampedMaxDimension),
+			FMath::Clamp(FMath::CeilToInt32(Size.Y / FittedCellSize), 1, ClampedMaxDimension));
+	};
+
+	// Rounding each axis up can still overshoot the cell budget by a row and a column, grow the cells until it fits
+	FIntPoint FittedDimensions = FitDimensions();
+	while (FittedDimensions.X * FittedDimensions.Y > ClampedMaxCellCount && (FittedDimensions.X > 1 || FittedDimensions.Y > 1))
+	{
+		FittedCellSize *= 1.05;
+		FittedDimensions = FitDimensions();
+	}
+
+	Initialize(FVector2D(Bounds.Min), FittedCellSize, FittedDimensions);
+
+	const UNavigationSystemV1* NavSys = World != nullptr ? FNavigationSystem::GetCurrent<UNavigationSystemV1>(World) : nullptr;
+	if (NavSys == nullptr) { return; }
+
+	const double CenterZ = Bounds.GetCenter().Z;
+	const FVector ProjectionExtent(CellSize * 0.5, CellSize * 0.5, Bounds.GetExtent().Z + ProjectionHeight);
+	for (int32 Idx = 0; Idx < Costs.Num(); Idx++)
+	{
+		FNavLocation Projected;
+		const bool bIsWalkable = NavSys->ProjectPointToNavigation(CellToWorld(ToCell(Idx), CenterZ), Projected, ProjectionExtent);
+		Costs[Idx] = bIsWalkable ? 1 : BlockedCost;
+	}
+}
+
+FIntPoint FPDFlowFieldGrid::WorldToCell(const FVector& WorldLocation) const
+{
+	return FIntPoint(
+		FMath::FloorToInt32((WorldLocation.X - Origin.X) / CellSize),
+		FMath::FloorToInt32((WorldLocation.Y - Origin.Y) / CellSize));
+}
+
+FVector FPDFlowFieldGrid::CellToWorld(const FIntPoint& Cell, const double Z) const
+{
+	return FVector(
+		Origin.X + (Cell.X + 0.5) * CellSize,
+		Origin.Y + (Cell.Y + 0.5) * CellSize,
+		Z);
+}
+
+uint8 FPDFlowFieldGrid::GetCost(const FIntPoint& Cell) const
+{
+	return IsValidCell(Cell) ? Costs[ToIndex(Cell)] : BlockedCost;
+}
+
+void FPDFlowFieldGrid::SetCost(const FIntPoint& Cell, const uint8 Cost)
+{
+	if (IsValidCell(Cell) == false) { return; }
+	Costs[ToIndex(Cell)] = Cost;
+}
+
+//
+// Field
+bool FPDFlowField::Build(const FPDFlowFieldGrid& InGrid, const FVector& InDestination)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_PDFlowField_Build);
+
+	Grid = InGrid;
+	Destination = InDestination;
+	GoalCell = Grid.WorldToCell(Destination);
+
+	const int32 CellCount = Grid.Costs.Num();
+	Integration.Init(UnreachableCost, CellCount);
+	Directions.Init(NoDirection, CellCount);
+	if (Grid.IsWalkable(GoalCell) == false) { return false; }
+
+	//
+	// Integration, dijkstra outwards from the goal cell
+	using FOpenEntry = TPair<uint32 /*Cost*/, int32 /*CellIdx*/>;
+	const auto CostPredicate = [](const FOpenEntry& A, const FOpenEntry& B) { return A.Key < B.Key; };
+
+	TArray<FOpenEntry> Open;
+	Open.Reserve(Grid.Dimensions.X + Grid.Dimensions.Y);
+
+	const int32 GoalIdx = Grid.ToIndex(GoalCell);
+	Integration[GoalIdx] = 0;
+	Open.HeapPush(FOpenEntry(0, GoalIdx), CostPredicate);
+
+	while (Open.IsEmpty() == false)
+	{
+		FOpenEntry Current;
+		Open.HeapPop(Current, CostPredicate, false);
+		if (Current.Key != Integration[Current.Value]) { continue; } // Stale entry, cell was already settled at a lower cost
+
+		const FIntPoint CurrentCell = Grid.ToCell(Current.Value);
+		for (int32 NeighbourIdx = 0; NeighbourIdx < 8; NeighbourIdx++)
+		{
+			if (PD::FlowField::CanStep(Grid, CurrentCell, NeighbourIdx) == false) { continue; }
+
+			const FIntPoint NeighbourCell = CurrentCell + PD::FlowField::NeighbourOffsets[NeighbourIdx];
+			const int32 NeighbourFlatIdx = Grid.ToIndex(NeighbourCell);
+			const uint32 StepCost = (NeighbourIdx & 1) ? PD::FlowField::DiagonalStepCost : PD::FlowField::StraightStepCost;
+			const uint32 NewCost = Current.Key + StepCost * Grid.Costs[NeighbourFlatIdx];
+			if (NewCost >= Integration[NeighbourFlatIdx]) { continue; }
+
+			Integration[NeighbourFlatIdx] = NewCost;
+			Open.HeapPush(FOpenEntry(NewCost, NeighbourFlatIdx), CostPredicate);
+		}
+	}
+
+	//
+	// Directions, each reachable cell points at its cheapest steppable neighbour
+	for (int32 CellIdx = 0; CellIdx < CellCount; CellIdx++)
+	{
+		if (Integration[CellIdx] == UnreachableCost) { continue; }
+		if (CellIdx == GoalIdx)
+		{
+			Directions[CellIdx] = GoalDirection;
+			continue;
+		}
+
+		const FIntPoint Cell = Grid.ToCell(CellIdx);
+		uint32 BestCost = Integration[CellIdx];
+		for (int32 NeighbourIdx = 0; NeighbourIdx < 8; NeighbourIdx++)
+		{
+			if (PD::FlowField::CanStep(Grid, Cell, NeighbourIdx) == false) { continue; }
+
+			const uint32 NeighbourCost = Integration[Grid.ToIndex(Cell + PD::FlowField::NeighbourOffsets[NeighbourIdx])];
+			if (NeighbourCost >= BestCost) { continue; }
+
+			BestCost = NeighbourCost;
+			Directions[CellIdx] = static_cast<uint8>(NeighbourIdx);
+		}
+	}
+
+	return true;
+}
+
+bool FPDFlowField::SampleDirection(const FVector& WorldLocation, FVector& OutDirection) const
+{
+	const FIntPoint Cell = Grid.WorldToCell(WorldLocation);
+	const uint8 Direction = Grid.IsValidCell(Cell) ? Directions[Grid.ToIndex(Cell)] : GoalDirection;
+	switch (Direction)
+	{
+	case NoDirection:
+		OutDirection = FVector::ZeroVector;
+		return false;
+	case GoalDirection:
+		OutDirection = (Destination - WorldLocation).GetSafeNormal2D();
+		return true;
+	default:
+		OutDirection = PD::FlowField::NeighbourDirections[Direction];
+		return true;
+	}
+}
+
+bool FPDFlowField::IsReachable(const FVector& WorldLocation) const
+{
+	const FIntPoint Cell = Grid.WorldToCell(WorldLocation);
+	return Grid.IsValidCell(Cell) == false || Directions[Grid.ToIndex(Cell)] != NoDirection;
+}
+
+bool FPDFlowField::IsInGoalCell(const FVector& WorldLocation) const
+{
+	return Grid.WorldToCell(WorldLocation) == GoalCell;
+}
+
+uint32 FPDFlowField::GetIntegratedCost(const FIntPoint& Cell) const
+{
+	return Grid.IsValidCell(Cell) ? Integration[Grid.ToIndex(Cell)] : UnreachableCost;
+}
+
+/**
+Business Source License 1.1
+
+Parameters
+
+Licensor:             Ario Amin (@ Permafrost Development)
+Licensed Work:        RTSOpen (Source available on github)
+                      The Licensed Work is (c) 2024 Ario Amin (@ Permafrost Development)
+Additional Use Grant: You may make free use of the Licensed Work in a commercial product or service provided these three additional conditions as met; 
+                      1. Must give attributions to the original author of the Licensed Work, in 'Credits' if that is applicable.
+                      2. The Licensed Work must be Compiled before being redistributed.
+                      3. The Licensed Work Source may be linked but may not be packaged into the product or service being sold
+                      4. Must not be resold or repackaged or redistributed as another product, is only allowed to be used within a commercial or non-commercial game project.
+                      5. Teams with yearly budgets larger than 100000 USD must contact the owner for a custom license or buy the framework from a marketplace it has been made available on.
+
+                      "Credits" indicate a scrolling screen with attributions. This is usually in a products end-state
+
+                      "Package" means the collection of files distributed by the Licensor, and derivatives of that collection
+                      and/or of those files..   
+
+                      "Source" form means the source code, documentation source, and configuration files for the Package, usually in human-readable format.
+
+                      "Compiled" form means the compiled bytecode, object code, binary, or any other
+                      form resulting from mechanical transformation or translation of the Source form.
+
+Change Date:          2028-04-17
+
+Change License:       Apache License, Version 2.0
+
+For information about alternative licensing arrangements for the Software,
+please visit: https://permadev.se/
+
+Notice
+
+The Business Source License (this document, or the “License”) is not an Open
+Source license. However, the Licensed Work will eventually be made available
+under an Open Source License, as stated in this License.
+
+License text copyright (c) 2017 MariaDB Corporation Ab, All Rights Reserved.
+“Business Source License” is a trademark of MariaDB Corporation Ab.
+
+-----------------------------------------------------------------------------
+
+Business Source License 1.1
+
+Terms
+
+The Licensor hereby grants you the right to copy, modify, create derivative
+works, redistribute, and make non-production use of the Licensed Work. The
+Licensor may make an Additional Use Grant, above, permitting limited
+production use.
+
+Effective on the Change Date, or the fourth anniversary of the first publicly
+available distribution of a specific version of the Licensed Work under this
+License, whichever comes first, the Licensor hereby grants you rights under
+the terms of the Change License, and the rights granted in the paragraph
+above terminate.
+
+If your use of the Licensed Work does not comply with the requirements
+currently in effect as described in this License, you must purchase a
+commercial license from the Licensor, its affiliated entities, or authorized
+resellers, or you must refrain from using the Licensed Work.
+
+All copies of the original and modified Licensed Work, and derivative works
+of the Licensed Work, are subject to this License. This License applies
+separately for each version of the Licensed Work and the Change Date may vary
+for each version of the Licensed Work released by Licensor.
+
+You must conspicuously display this License on each original or modified copy
+of the Licensed Work. If you receive the Licensed Work in original or
+modified form from a third party, the terms and conditions set forth in this
+License apply to your use of that work.
+
+Any use of the Licensed Work in violation of this License will automatically
+terminate your rights under this License for the current and all other
+versions of the Licensed Work.
+
+This License does not grant you any right in any trademark or logo of
+Licensor or its affiliates (provided that you may use a trademark or logo of
+Licensor as expressly required by this License).
+
+TO THE EXTENT PERMITTED BY APPLICABLE LAW, THE LICENSED WORK IS PROVIDED ON
+AN “AS IS” BASIS. LICENSOR HEREBY DISCLAIMS ALL WARRANTIES AND CONDITIONS,
+EXPRESS OR IMPLIED, INCLUDING (WITHOUT LIMITATION) WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT, AND
+TITLE.
+
+MariaDB hereby grants you permission to use this License’s text to license
+your works, and to refer to it using the trademark “Business Source License”,
+as long as you comply with the Covenants of Licensor below.
+
+Covenants of Licensor
+
+In consideration of the right to use this License’s text and the “Business
+Source License” name and trademark, Licensor covenants to MariaDB, and to all
+other recipients of the licensed work to be provided by Licensor:
+
+1. To specify as the Change License the GPL Version 2.0 or any later version,
+   or a license that is compatible with GPL Version 2.0 or a later version,
+   where “compatible” means that software provided under the Change License can
+   be included in a program with software provided under GPL Version 2.0 or a
+   later version. Licensor may specify additional Change Licenses without
+   limitation.
+
+2. To either: (a) specify an additional grant of rights to use that does not
+   impose any additional restriction on the right granted in this License, as
+   the Additional Use Grant; or (b) insert the text “None”.
+
+3. To specify a Change Date.
+
+4. Not to modify this License in any other way.
+ **/
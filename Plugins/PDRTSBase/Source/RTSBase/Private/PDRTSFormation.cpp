@@ -0,0 +1,250 @@
+﻿/* @author: Ario Amin @ Permafrost Development. @copyright: Full BSL(1.1) License included at bottom of the file  */
+#include "PDRTSFormation.h"
+
+void FPDFormation::BuildLayout(
+	const EPDFormationShape Shape,
+	const int32 SlotCount,
+	const FVector& Center,
+	const FVector& Facing,
+	const double InSpacing,
+	FPDFormationLayout& OutLayout)
+{
+	OutLayout.Slots.Reset(SlotCount);
+	OutLayout.RowCounts.Reset();
+	OutLayout.Forward = Facing.GetSafeNormal2D(UE_SMALL_NUMBER, FVector::ForwardVector);
+	OutLayout.Right = FVector(-OutLayout.Forward.Y, OutLayout.Forward.X, 0.0);
+	if (SlotCount <= 0) { return; }
+
+	//
+	// Row counts, front row first
+	switch (Shape)
+	{
+	case EPDFormationShape::Line:
+		OutLayout.RowCounts.Add(SlotCount);
+		break;
+	case EPDFormationShape::Box:
+		{
+			const int32 Columns = FMath::CeilToInt32(FMath::Sqrt(static_cast<double>(SlotCount)));
+			for (int32 Remaining = SlotCount; Remaining > 0; Remaining -= Columns)
+			{
+				OutLayout.RowCounts.Add(FMath::Min(Columns, Remaining));
+			}
+		}
+		break;
+	case EPDFormationShape::Wedge:
+		{
+			int32 Remaining = SlotCount;
+			for (int32 Row = 0; Remaining > 0; Row++)
+			{
+				const int32 RowCount = FMath::Min(Row * 2 + 1, Remaining);
+				OutLayout.RowCounts.Add(RowCount);
+				Remaining -= RowCount;
+			}
+		}
+		break;
+	}
+
+	//
+	// Slots, the formation is centered on 'Center' in both axes. A zero spacing (zero unit radius) would stack every slot on one point
+	const double Spacing = FMath::Max(InSpacing, MinSpacing);
+	const double FrontOffset = (OutLayout.RowCounts.Num() - 1) * 0.5 * Spacing;
+	for (int32 Row = 0; Row < OutLayout.RowCounts.Num(); Row++)
+	{
+		const int32 RowCount = OutLayout.RowCounts[Row];
+		const double ForwardOffset = FrontOffset - Row * Spacing;
+		const double LeftOffset = (RowCount - 1) * 0.5 * Spacing;
+		for (int32 Column = 0; Column < RowCount; Column++)
+		{
+			const double RightOffset = Column * Spacing - LeftOffset;
+			OutLayout.Slots.Emplace(Center + OutLayout.Forward * ForwardOffset + OutLayout.Right * RightOffset);
+		}
+	}
+}
+
+void FPDFormation::AssignSlots(
+	const FPDFormationLayout& Layout,
+	const TConstArrayView<FVector> UnitLocations,
+	const int32 RefinementPasses,
+	TArray<int32>& OutSlotPerUnit)
+{
+	const int32 Count = UnitLocations.Num();
+	OutSlotPerUnit.Init(INDEX_NONE, Count);
+	if (ensure(Count == Layout.Slots.Num()) == false) { return; }
+
+	//
+	// Initial assignment, keep the units relative placement within the group
+	TArray<int32> UnitOrder;
+	UnitOrder.SetNumUninitialized(Count);
+	for (int32 Idx = 0; Idx < Count; Idx++) { UnitOrder[Idx] = Idx; }
+
+	const auto ForwardOf = [&](const int32 UnitIdx) { return UnitLocations[UnitIdx].Dot(Layout.Forward); };
+	const auto RightOf = [&](const int32 UnitIdx) { return UnitLocations[UnitIdx].Dot(Layout.Right); };
+
+	UnitOrder.Sort([&](const int32 A, const int32 B) { return ForwardOf(A) > ForwardOf(B); });
+
+	int32 RowStart = 0;
+	for (const int32 RowCount : Layout.RowCounts)
+	{
+		TArrayView<int32> RowUnits(UnitOrder.GetData() + RowStart, RowCount);
+		RowUnits.Sort([&](const int32 A, const int32 B) { return RightOf(A) < RightOf(B); });
+
+		for (int32 Column = 0; Column < RowCount; Column++) { OutSlotPerUnit[RowUnits[Column]] = RowStart + Column; }
+		RowStart += RowCount;
+	}
+
+	//
+	// Refinement, swap the occupants of neighbouring slots if that shortens their combined travel
+	TArray<int32> UnitPerSlot;
+	UnitPerSlot.SetNumUninitialized(Count);
+	for (int32 UnitIdx = 0; UnitIdx < Count; UnitIdx++) { UnitPerSlot[OutSlotPerUnit[UnitIdx]] = UnitIdx; }
+
+	const auto TrySwap = [&](const int32 SlotA, const int32 SlotB) -> bool
+	{
+		const FVector& UnitA = UnitLocations[UnitPerSlot[SlotA]];
+		const FVector& UnitB = UnitLocations[UnitPerSlot[SlotB]];
+		const double Current = FVector::Dist2D(UnitA, Layout.Slots[SlotA]) + FVector::Dist2D(UnitB, Layout.Slots[SlotB]);
+		const double Swapped = FVector::Dist2D(UnitA, Layout.Slots[SlotB]) + FVector::Dist2D(UnitB, Layout.Slots[SlotA]);
+		if (Swapped >= Current - UE_KINDA_SMALL_NUMBER) { return false; }
+
+		Swap(UnitPerSlot[SlotA], UnitPerSlot[SlotB]);
+		return true;
+	};
+
+	for (int32 Pass = 0; Pass < RefinementPasses; Pass++)
+	{
+		bool bAnySwapped = false;
+		RowStart = 0;
+		for (int32 Row = 0; Row < Layout.RowCounts.Num(); Row++)
+		{
+			const int32 RowCount = Layout.RowCounts[Row];
+			const int32 NextRowStart = RowStart + RowCount;
+			const int32 NextRowCount = Layout.RowCounts.IsValidIndex(Row + 1) ? Layout.RowCounts[Row + 1] : 0;
+			for (int32 Column = 0; Column < RowCount; Column++)
+			{
+				const int32 Slot = RowStart + Column;
+				if (Column + 1 < RowCount) { bAnySwapped |= TrySwap(Slot, Slot + 1); }
+
+				// Slot behind, rows are centered so the matching column is offset by half the row count difference
+				const int32 BehindColumn = Column + (NextRowCount - RowCount) / 2;
+				if (BehindColumn >= 0 && BehindColumn < NextRowCount) { bAnySwapped |= TrySwap(Slot, NextRowStart + BehindColumn); }
+			}
+			RowStart = NextRowStart;
+		}
+		if (bAnySwapped == false) { break; }
+	}
+
+	for (int32 Slot = 0; Slot < Count; Slot++) { OutSlotPerUnit[UnitPerSlot[Slot]] = Slot; }
+}
+
+/**
+Business Source License 1.1
+
+Parameters
+
+Licensor:             Ario Amin (@ Permafrost Development)
+Licensed Work:        RTSOpen (Source available on github)
+                      The Licensed Work is (c) 2024 Ario Amin (@ Permafrost Development)
+Additional Use Grant: You may make free use of the Licensed Work in a commercial product or service provided these three additional conditions as met; 
+                      1. Must give attributions to the original author of the Licensed Work, in 'Credits' if that is applicable.
+                      2. The Licensed Work must be Compiled before being redistributed.
+                      3. The Licensed Work Source may be linked but may not be packaged into the product or service being sold
+                      4. Must not be resold or repackaged or redistributed as another product, is only allowed to be used within a commercial or non-commercial game project.
+                      5. Teams with yearly budgets larger than 100000 USD must contact the owner for a custom license or buy the framework from a marketplace it has been made available on.
+
+                      "Credits" indicate a scrolling screen with attributions. This is usually in a products end-state
+
+                      "Package" means the collection of files distributed by the Licensor, and derivatives of that collection
+                      and/or of those files..   
+
+                      "Source" form means the source code, documentation source, and configuration files for the Package, usually in human-readable format.
+
+                      "Compiled" form means the compiled bytecode, object code, binary, or any other
+                      form resulting from mechanical transformation or translation of the Source form.
+
+Change Date:          2028-04-17
+
+Change License:       Apache License, Version 2.0
+
+For information about alternative licensing arrangements for the Software,
+please visit: https://permadev.se/
+
+Notice
+
+The Business Source License (this document, or the “License”) is not an Open
+Source license. However, the Licensed Work will eventually be made available
+under an Open Source License, as stated in this License.
+
+License text copyright (c) 2017 MariaDB Corporation Ab, All Rights Reserved.
+“Business Source License” is a trademark of MariaDB Corporation Ab.
+
+-----------------------------------------------------------------------------
+
+Business Source License 1.1
+
+Terms
+
+The Licensor hereby grants you the right to copy, modify, create derivative
+works, redistribute, and make non-production use of the Licensed Work. The
+Licensor may make an Additional Use Grant, above, permitting limited
+production use.
+
+Effective on the Change Date, or the fourth anniversary of the first publicly
+available distribution of a specific version of the Licensed Work under this
+License, whichever comes first, the Licensor hereby grants you rights under
+the terms of the Change License, and the rights granted in the paragraph
+above terminate.
+
+If your use of the Licensed Work does not comply with the requirements
+currently in effect as described in this License, you must purchase a
+commercial license from the Licensor, its affiliated entities, or authorized
+resellers, or you must refrain from using the Licensed Work.
+
+All copies of the original and modified Licensed Work, and derivative works
+of the Licensed Work, are subject to this License. This License applies
+separately for each version of the Licensed Work and the Change Date may vary
+for each version of the Licensed Work released by Licensor.
+
+You must conspicuously display this License on each original or modified copy
+of the Licensed Work. If you receive the Licensed Work in original or
+modified form from a third party, the terms and conditions set forth in this
+License apply to your use of that work.
+
+Any use of the Licensed Work in violation of this License will automatically
+terminate your rights under this License for the current and all other
+versions of the Licensed Work.
+
+This License does not grant you any right in any trademark or logo of
+Licensor or its affiliates (provided that you may use a trademark or logo of
+Licensor as expressly required by this License).
+
+TO THE EXTENT PERMITTED BY APPLICABLE LAW, THE LICENSED WORK IS PROVIDED ON
+AN “AS IS” BASIS. LICENSOR HEREBY DISCLAIMS ALL WARRANTIES AND CONDITIONS,
+EXPRESS OR IMPLIED, INCLUDING (WITHOUT LIMITATION) WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT, AND
+TITLE.
+
+MariaDB hereby grants you permission to use this License’s text to license
+your works, and to refer to it using the trademark “Business Source License”,
+as long as you comply with the Covenants of Licensor below.
+
+Covenants of Licensor
+
+In consideration of the right to use this License’s text and the “Business
+Source License” name and trademark, Licensor covenants to MariaDB, and to all
+other recipients of the licensed work to be provided by Licensor:
+
+1. To specify as the Change License the GPL Version 2.0 or any later version,
+   or a license that is compatible with GPL Version 2.0 or a later version,
+   where “compatible” means that software provided under the Change License can
+   be included in a program with software provided under GPL Version 2.0 or a
+   later version. Licensor may specify additional Change Licenses without
+   limitation.
+
+2. To either: (a) specify an additional grant of rights to use that does not
+   impose any additional restriction on the right granted in this License, as
+   the Additional Use Grant; or (b) insert the text “None”.
+
+3. To specify a Change Date.
+
+4. Not to modify this License in any other way.
+ **/
@@ -185,7 +185,7 @@ void UPDEntityPinger::Ping_Implementation(UWorld* World, const FPDEntityPingDatu
 			}
 			else
 			{
-				SelectedUnitTypes = BuilderSubsystem->ValidUnitTypes_PerBuildable.FindRef(BuilderSubsystem->Buildable_WClass.FindRef(ConstPingDatum.WorldActor->GetClass())->BuildableTag);
+				BuilderSubsystem->GetValidWorkerTypes(BuilderSubsystem->Buildable_WClass.FindRef(ConstPingDatum.WorldActor->GetClass())->BuildableTag, SelectedUnitTypes);
 			}
 
 			TArray<FMassEntityHandle> Handles =
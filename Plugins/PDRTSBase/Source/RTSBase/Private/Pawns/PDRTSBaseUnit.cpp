@@ -6,6 +6,8 @@
 #include "MassEntityManager.h"
 #include "PDRTSBaseSubsystem.h"
 #include "PDRTSCommon.h"
+#include "PDRTSFormation.h"
+#include "NavigationSystem.h"
 #include "AI/Mass/PDMassFragments.h"
 
 FPDTargetCompound EmptyCompound{};
@@ -91,21 +93,102 @@ void UPDRTSBaseUnit::RequestActionMulti(
 	int32                                 CallingOwnerID,
 	const FPDTargetCompound&              TargetCompound,
 	const FGameplayTag&                   RequestedJob,
-	const TMap<int32, FMassEntityHandle>& EntityHandleMap,
+	TConstArrayView<FMassEntityHandle>    EntityHandles,
 	const FVector&                        SelectionCenter,
 	int32                                 SelectionGroup)
 {
 	UPDRTSBaseSubsystem* RTSSubsystem = UPDRTSBaseSubsystem::Get();
 	if (RTSSubsystem != nullptr)
 	{
-		RTSSubsystem->RequestNavpathGenerationForSelectionGroup(CallingOwnerID, SelectionGroup, SelectionCenter, TargetCompound);
+		// Large groups share a flow field so each unit steers from where it stands instead of bunching up on one polyline
+		EntityHandles.Num() >= GetDefault<UPDFlowFieldSettings>()->MinGroupSizeForFlowField
+			? RTSSubsystem->RequestFlowFieldForSelectionGroup(CallingOwnerID, SelectionGroup, SelectionCenter, TargetCompound)
+			: RTSSubsystem->RequestNavpathGenerationForSelectionGroup(CallingOwnerID, SelectionGroup, SelectionCenter, TargetCompound);
 	}
 	
-	for (const TTuple<int, FMassEntityHandle>& SelectedEntityIt : EntityHandleMap)
+	// Only plain location targets get a formation, actor and entity targets are interacted with at the target itself
+	const UPDFormationSettings* FormationSettings = GetDefault<UPDFormationSettings>();
+	const bool bShouldUseFormation =
+		FormationSettings->bUseFormationsForGroupMoves
+		&& EntityHandles.Num() > 1
+		&& EntityManager != nullptr
+		&& TargetCompound.ActionTargetAsActor == nullptr
+		&& EntityManager->IsEntityValid(TargetCompound.ActionTargetAsEntity) == false;
+	if (bShouldUseFormation == false)
 	{
-		const FMassEntityHandle& SelectedHandle = SelectedEntityIt.Value;
-		RequestAction(CallingOwnerID, TargetCompound, RequestedJob, SelectedHandle);
-	}	
+		for (const FMassEntityHandle& SelectedHandle : EntityHandles)
+		{
+			RequestAction(CallingOwnerID, TargetCompound, RequestedJob, SelectedHandle);
+		}
+		return;
+	}
+
+	DispatchFormationMove(CallingOwnerID, TargetCompound, RequestedJob, EntityHandles);
+}
+
+void UPDRTSBaseUnit::DispatchFormationMove(
+	int32                                 CallingOwnerID,
+	const FPDTargetCompound&              TargetCompound,
+	const FGameplayTag&                   RequestedJob,
+	TConstArrayView<FMassEntityHandle>    EntityHandles)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_PDRTSBaseUnit_DispatchFormationMove);
+	const UPDFormationSettings* FormationSettings = GetDefault<UPDFormationSettings>();
+
+	TArray<FMassEntityHandle> ValidHandles;
+	TArray<FVector> UnitLocations;
+	ValidHandles.Reserve(EntityHandles.Num());
+	UnitLocations.Reserve(EntityHandles.Num());
+
+	double MaxUnitRadius = 0.0;
+	FVector GroupCentroid = FVector::ZeroVector;
+	for (const FMassEntityHandle& SelectedHandle : EntityHandles)
+	{
+		const FTransformFragment* Transform = EntityManager->IsEntityValid(SelectedHandle) ? EntityManager->GetFragmentDataPtr<FTransformFragment>(SelectedHandle) : nullptr;
+		if (Transform == nullptr) { continue; }
+
+		const FAgentRadiusFragment* Radius = EntityManager->GetFragmentDataPtr<FAgentRadiusFragment>(SelectedHandle);
+		// Radius fragments left at zero would collapse the spacing, treat them as missing
+		MaxUnitRadius = FMath::Max(MaxUnitRadius, Radius != nullptr && Radius->Radius > 0.f ? static_cast<double>(Radius->Radius) : FormationSettings->DefaultUnitRadius);
+
+		ValidHandles.Emplace(SelectedHandle);
+		GroupCentroid += UnitLocations.Emplace_GetRef(Transform->GetTransform().GetLocation());
+	}
+	if (ValidHandles.IsEmpty()) { return; }
+	GroupCentroid /= ValidHandles.Num();
+
+	//
+	// Slots face along the direction the group is travelling
+	const FVector TargetLocation = TargetCompound.ActionTargetAsLocation.Get();
+	FPDFormationLayout Layout;
+	FPDFormation::BuildLayout(
+		FormationSettings->DefaultShape,
+		ValidHandles.Num(),
+		TargetLocation,
+		TargetLocation - GroupCentroid,
+		MaxUnitRadius * 2.0 * FormationSettings->SpacingScale,
+		Layout);
+
+	const UNavigationSystemV1* NavSys = FormationSettings->bProjectSlotsToNavigation ? FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()) : nullptr;
+	if (NavSys != nullptr)
+	{
+		const FVector ProjectionExtent(MaxUnitRadius, MaxUnitRadius, 500.0);
+		for (FVector& Slot : Layout.Slots)
+		{
+			FNavLocation Projected;
+			if (NavSys->ProjectPointToNavigation(Slot, Projected, ProjectionExtent)) { Slot = Projected.Location; }
+		}
+	}
+
+	TArray<int32> SlotPerUnit;
+	FPDFormation::AssignSlots(Layout, UnitLocations, FormationSettings->RefinementPasses, SlotPerUnit);
+
+	FPDTargetCompound SlotTarget = TargetCompound;
+	for (int32 UnitIdx = 0; UnitIdx < ValidHandles.Num(); UnitIdx++)
+	{
+		SlotTarget.ActionTargetAsLocation.Set(Layout.Slots[SlotPerUnit[UnitIdx]]);
+		RequestAction(CallingOwnerID, SlotTarget, RequestedJob, ValidHandles[UnitIdx]);
+	}
 }
 
 
@@ -0,0 +1,239 @@
+﻿/* @author: Ario Amin @ Permafrost Development. @copyright: Full BSL(1.1) License included at bottom of the file  */
+
+#include "PDBuildCommon.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace PD::Build::Tests
+{
+	constexpr double CellSize = 100.0;
+
+	/** @brief Bounds exactly covering the cells from MinCell to MaxCell, inclusive */
+	FBox CellBounds(const FIntPoint& MinCell, const FIntPoint& MaxCell)
+	{
+		return FBox{
+			FVector{MinCell.X * CellSize, MinCell.Y * CellSize, 0.0},
+			FVector{(MaxCell.X + 1) * CellSize, (MaxCell.Y + 1) * CellSize, 100.0}};
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPDBuildOccupancyMarkTest, "PD.RTSBase.BuildOccupancy.Mark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FPDBuildOccupancyMarkTest::RunTest(const FString& Parameters)
+{
+	using namespace PD::Build::Tests;
+	FPDBuildOccupancyGrid Grid{CellSize};
+	Grid.SetOccupant(1, CellBounds({0, 0}, {1, 2}));
+
+	TestEqual(TEXT("One occupant"), Grid.NumOccupants(), 1);
+	TestTrue(TEXT("Occupant is in the grid"), Grid.HasOccupant(1));
+	TestEqual(TEXT("2x3 cells covered"), Grid.CellOccupancy.Num(), 6);
+	for (int32 CellX = 0; CellX <= 1; CellX++)
+	{
+		for (int32 CellY = 0; CellY <= 2; CellY++)
+		{
+			TestTrue(FString::Printf(TEXT("Cell (%d, %d) is blocked"), CellX, CellY), Grid.IsCellBlocked({CellX, CellY}));
+		}
+	}
+	TestFalse(TEXT("Cell past the bounds is free"), Grid.IsCellBlocked({2, 0}));
+	TestFalse(TEXT("Cell before the bounds is free"), Grid.IsCellBlocked({-1, 0}));
+
+	// Negative coordinates floor into the negative cells
+	Grid.SetOccupant(2, CellBounds({-2, -2}, {-2, -2}));
+	TestTrue(TEXT("Negative cell is blocked"), Grid.IsCellBlocked({-2, -2}));
+	TestFalse(TEXT("Neighbouring negative cell is free"), Grid.IsCellBlocked({-1, -1}));
+
+	// Invalid bounds never enter the grid
+	Grid.SetOccupant(3, FBox{ForceInit});
+	TestFalse(TEXT("Invalid bounds are not registered"), Grid.HasOccupant(3));
+	TestEqual(TEXT("Two occupants"), Grid.NumOccupants(), 2);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPDBuildOccupancyClearTest, "PD.RTSBase.BuildOccupancy.Clear", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FPDBuildOccupancyClearTest::RunTest(const FString& Parameters)
+{
+	using namespace PD::Build::Tests;
+	FPDBuildOccupancyGrid Grid{CellSize};
+	Grid.SetOccupant(1, CellBounds({0, 0}, {1, 1}));
+	Grid.SetOccupant(2, CellBounds({1, 1}, {2, 2}));
+	TestEqual(TEXT("Shared cell is counted twice"), Grid.CellOccupancy.FindRef({1, 1}), 2);
+
+	// Removing one occupant keeps the cell it shares with the other blocked
+	TestTrue(TEXT("Removing a registered occupant succeeds"), Grid.RemoveOccupant(1));
+	TestFalse(TEXT("Removing it again fails"), Grid.RemoveOccupant(1));
+	TestFalse(TEXT("Released cell is free"), Grid.IsCellBlocked({0, 0}));
+	TestTrue(TEXT("Shared cell is still blocked"), Grid.IsCellBlocked({1, 1}));
+	TestEqual(TEXT("Shared cell is counted once"), Grid.CellOccupancy.FindRef({1, 1}), 1);
+
+	// Moving an occupant releases its old cells
+	Grid.SetOccupant(2, CellBounds({5, 5}, {5, 5}));
+	TestFalse(TEXT("Old cell of the moved occupant is free"), Grid.IsCellBlocked({2, 2}));
+	TestTrue(TEXT("New cell of the moved occupant is blocked"), Grid.IsCellBlocked({5, 5}));
+	TestEqual(TEXT("Moved occupant covers one cell"), Grid.CellOccupancy.Num(), 1);
+
+	TestTrue(TEXT("Removing the last occupant succeeds"), Grid.RemoveOccupant(2));
+	TestEqual(TEXT("No cells stored"), Grid.CellOccupancy.Num(), 0);
+	TestEqual(TEXT("No occupants"), Grid.NumOccupants(), 0);
+
+	Grid.SetOccupant(3, CellBounds({0, 0}, {3, 3}));
+	Grid.Reset();
+	TestEqual(TEXT("Reset clears the cells"), Grid.CellOccupancy.Num(), 0);
+	TestEqual(TEXT("Reset clears the occupants"), Grid.NumOccupants(), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPDBuildOccupancyOverlapTest, "PD.RTSBase.BuildOccupancy.Overlap", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FPDBuildOccupancyOverlapTest::RunTest(const FString& Parameters)
+{
+	using namespace PD::Build::Tests;
+	FPDBuildOccupancyGrid Grid{CellSize};
+	Grid.SetOccupant(1, CellBounds({0, 0}, {1, 1}));
+
+	TArray<FPDBuildFootprintCell> Cells;
+	TestFalse(TEXT("Overlapping footprint is rejected"), Grid.ValidateFootprint(CellBounds({1, 1}, {2, 2}), Cells));
+	TestEqual(TEXT("One result per footprint cell"), Cells.Num(), 4);
+
+	int32 BlockedCount = 0;
+	for (const FPDBuildFootprintCell& Cell : Cells)
+	{
+		BlockedCount += Cell.bBlocked ? 1 : 0;
+		TestEqual(TEXT("Result is blocked only for the occupied cell"), Cell.bBlocked, Cell.Cell == FIntPoint{1, 1});
+	}
+	TestEqual(TEXT("Exactly one blocked cell"), BlockedCount, 1);
+
+	const FPDBuildFootprintCell* CornerCell = Cells.FindByPredicate([](const FPDBuildFootprintCell& Cell) { return Cell.Cell == FIntPoint{2, 2}; });
+	TestTrue(TEXT("Footprint corner cell is reported"), CornerCell != nullptr);
+	if (CornerCell != nullptr)
+	{
+		TestTrue(TEXT("Cell center sits at the footprints lowest point"), CornerCell->CellCenter.Equals(FVector{250.0, 250.0, 0.0}));
+	}
+
+	// Footprints sharing only an edge with the occupant do not overlap it
+	TestTrue(TEXT("Edge touching footprint is accepted"), Grid.ValidateFootprint(CellBounds({2, 0}, {3, 1}), Cells));
+	TestTrue(TEXT("Corner touching footprint is accepted"), Grid.ValidateFootprint(CellBounds({2, 2}, {2, 2}), Cells));
+
+	// A footprint inside a single cell only covers that cell
+	const FBox InsideCell{FVector{210.0, 210.0, 0.0}, FVector{290.0, 290.0, 10.0}};
+	TestTrue(TEXT("Small free footprint is accepted"), Grid.ValidateFootprint(InsideCell, Cells));
+	TestEqual(TEXT("Small footprint covers one cell"), Cells.Num(), 1);
+
+	TestFalse(TEXT("Invalid footprint is rejected"), Grid.ValidateFootprint(FBox{ForceInit}, Cells));
+	TestEqual(TEXT("Invalid footprint has no cells"), Cells.Num(), 0);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
+
+/**
+Business Source License 1.1
+
+Parameters
+
+Licensor:             Ario Amin (@ Permafrost Development)
+Licensed Work:        RTSOpen (Source available on github)
+                      The Licensed Work is (c) 2024 Ario Amin (@ Permafrost Development)
+Additional Use Grant: You may make free use of the Licensed Work in a commercial product or service provided these three additional conditions as met; 
+                      1. Must give attributions to the original author of the Licensed Work, in 'Credits' if that is applicable.
+                      2. The Licensed Work must be Compiled before being redistributed.
+                      3. The Licensed Work Source may be linked but may not be packaged into the product or service being sold
+                      4. Must not be resold or repackaged or redistributed as another product, is only allowed to be used within a commercial or non-commercial game project.
+                      5. Teams with yearly budgets larger than 100000 USD must contact the owner for a custom license or buy the framework from a marketplace it has been made available on.
+
+                      "Credits" indicate a scrolling screen with attributions. This is usually in a products end-state
+
+                      "Package" means the collection of files distributed by the Licensor, and derivatives of that collection
+                      and/or of those files..   
+
+                      "Source" form means the source code, documentation source, and configuration files for the Package, usually in human-readable format.
+
+                      "Compiled" form means the compiled bytecode, object code, binary, or any other
+                      form resulting from mechanical transformation or translation of the Source form.
+
+Change Date:          2028-04-17
+
+Change License:       Apache License, Version 2.0
+
+For information about alternative licensing arrangements for the Software,
+please visit: https://permadev.se/
+
+Notice
+
+The Business Source License (this document, or the “License”) is not an Open
+Source license. However, the Licensed Work will eventually be made available
+under an Open Source License, as stated in this License.
+
+License text copyright (c) 2017 MariaDB Corporation Ab, All Rights Reserved.
+“Business Source License” is a trademark of MariaDB Corporation Ab.
+
+-----------------------------------------------------------------------------
+
+Business Source License 1.1
+
+Terms
+
+The Licensor hereby grants you the right to copy, modify, create derivative
+works, redistribute, and make non-production use of the Licensed Work. The
+Licensor may make an Additional Use Grant, above, permitting limited
+production use.
+
+Effective on the Change Date, or the fourth anniversary of the first publicly
+available distribution of a specific version of the Licensed Work under this
+License, whichever comes first, the Licensor hereby grants you rights under
+the terms of the Change License, and the rights granted in the paragraph
+above terminate.
+
+If your use of the Licensed Work does not comply with the requirements
+currently in effect as described in this License, you must purchase a
+commercial license from the Licensor, its affiliated entities, or authorized
+resellers, or you must refrain from using the Licensed Work.
+
+All copies of the original and modified Licensed Work, and derivative works
+of the Licensed Work, are subject to this License. This License applies
+separately for each version of the Licensed Work and the Change Date may vary
+for each version of the Licensed Work released by Licensor.
+
+You must conspicuously display this License on each original or modified copy
+of the Licensed Work. If you receive the Licensed Work in original or
+modified form from a third party, the terms and conditions set forth in this
+License apply to your use of that work.
+
+Any use of the Licensed Work in violation of this License will automatically
+terminate your rights under this License for the current and all other
+versions of the Licensed Work.
+
+This License does not grant you any right in any trademark or logo of
+Licensor or its affiliates (provided that you may use a trademark or logo of
+Licensor as expressly required by this License).
+
+TO THE EXTENT PERMITTED BY APPLICABLE LAW, THE LICENSED WORK IS PROVIDED ON
+AN “AS IS” BASIS. LICENSOR HEREBY DISCLAIMS ALL WARRANTIES AND CONDITIONS,
+EXPRESS OR IMPLIED, INCLUDING (WITHOUT LIMITATION) WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT, AND
+TITLE.
+
+MariaDB hereby grants you permission to use this License’s text to license
+your works, and to refer to it using the trademark “Business Source License”,
+as long as you comply with the Covenants of Licensor below.
+
+Covenants of Licensor
+
+In consideration of the right to use this License’s text and the “Business
+Source License” name and trademark, Licensor covenants to MariaDB, and to all
+other recipients of the licensed work to be provided by Licensor:
+
+1. To specify as the Change License the GPL Version 2.0 or any later version,
+   or a license that is compatible with GPL Version 2.0 or a later version,
+   where “compatible” means that software provided under the Change License can
+   be included in a program with software provided under GPL Version 2.0 or a
+   later version. Licensor may specify additional Change Licenses without
+   limitation.
+
+2. To either: (a) specify an additional grant of rights to use that does not
+   impose any additional restriction on the right granted in this License, as
+   the Additional Use Grant; or (b) insert the text “None”.
+
+3. To specify a Change Date.
+
+4. Not to modify this License in any other way.
+ **/
@@ -0,0 +1,241 @@
+﻿/* @author: Ario Amin @ Permafrost Development. @copyright: Full BSL(1.1) License included at bottom of the file  */
+
+#include "Actors/PDRTSCameraManager.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace PD::Camera::Tests
+{
+	/** @brief Compiles a mode with a linear blend-in curve */
+	FPDCameraModeParams MakeMode(const double FOV, const double BlendInTime)
+	{
+		FPDCameraManagerSettings Settings;
+		Settings.FOV = FOV;
+		Settings.BlendInTime = BlendInTime;
+		return FPDCameraModeParams::Compile(Settings);
+	}
+
+	/** @brief Random delta-times between 240 and 15 fps */
+	double RandomDeltaTime(FRandomStream& Stream)
+	{
+		return Stream.FRandRange(1.0 / 240.0, 1.0 / 15.0);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPDCameraModeBlendStepTest, "PD.RTSBase.Camera.ModeBlendStep", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FPDCameraModeBlendStepTest::RunTest(const FString& Parameters)
+{
+	using namespace PD::Camera::Tests;
+	const FPDCameraModeParams StartMode = MakeMode(90.0, 0.0);
+	const FPDCameraModeParams TargetMode = MakeMode(60.0, 1.0);
+
+	// Varied frame times must land on the target after the blend-in time, moving monotonically towards it
+	FRandomStream Stream(0xCA3E);
+	for (int32 Run = 0; Run < 32; Run++)
+	{
+		FPDCameraModeBlend ModeBlend;
+		ModeBlend.SnapTo(StartMode);
+		ModeBlend.BlendTo(TargetMode);
+
+		double Elapsed = 0.0;
+		double LastFOV = ModeBlend.GetCurrent().FOV;
+		while (ModeBlend.IsBlending() && Elapsed < 2.0)
+		{
+			const double DeltaTime = RandomDeltaTime(Stream);
+			ModeBlend.Step(DeltaTime);
+			Elapsed += DeltaTime;
+
+			if (TestTrue(TEXT("The blend never moves away from the target"), ModeBlend.GetCurrent().FOV <= LastFOV + KINDA_SMALL_NUMBER) == false) { return false; }
+			LastFOV = ModeBlend.GetCurrent().FOV;
+		}
+
+		TestFalse(TEXT("The blend finishes"), ModeBlend.IsBlending());
+		TestTrue(TEXT("The blend finishes within a frame of the blend-in time"), Elapsed >= 1.0 && Elapsed < 1.0 + 1.0 / 15.0);
+		TestEqual(TEXT("The blend lands exactly on the target"), ModeBlend.GetCurrent().FOV, 60.0);
+	}
+
+	// Half-way through, the result only depends on the elapsed time and not on how it was stepped
+	FPDCameraModeBlend Coarse;
+	Coarse.SnapTo(StartMode);
+	Coarse.BlendTo(TargetMode);
+	Coarse.Step(0.5);
+
+	FPDCameraModeBlend Fine;
+	Fine.SnapTo(StartMode);
+	Fine.BlendTo(TargetMode);
+	for (int32 StepIdx = 0; StepIdx < 60; StepIdx++) { Fine.Step(0.5 / 60.0); }
+
+	TestEqual(TEXT("A linear blend is half-way after half the blend-in time"), Coarse.GetCurrent().FOV, 75.0, 1e-3);
+	TestEqual(TEXT("Fine and coarse stepping agree"), Fine.GetCurrent().FOV, Coarse.GetCurrent().FOV, 1e-3);
+
+	// Negative delta-times are ignored, a zero blend-in time snaps
+	Coarse.Step(-1.0);
+	TestEqual(TEXT("Negative delta-times do not rewind the blend"), Coarse.GetCurrent().FOV, 75.0, 1e-3);
+	Coarse.BlendTo(StartMode);
+	TestFalse(TEXT("A zero blend-in time snaps"), Coarse.IsBlending());
+	TestEqual(TEXT("Snapping applies the target immediately"), Coarse.GetCurrent().FOV, 90.0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPDCameraDampTowardsTest, "PD.RTSBase.Camera.DampTowards", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FPDCameraDampTowardsTest::RunTest(const FString& Parameters)
+{
+	using namespace PD::Camera::Tests;
+	const FVector Start(0.0, 0.0, 0.0);
+	const FVector Target(1000.0, -500.0, 250.0);
+	constexpr double DampingRate = 6.0;
+	constexpr double TotalTime = 0.75;
+
+	// Reference result from a single step over the whole duration
+	const FVector Reference = APDCameraManager::DampTowards(Start, Target, DampingRate, TotalTime);
+
+	FRandomStream Stream(0xDA3B);
+	for (int32 Run = 0; Run < 32; Run++)
+	{
+		FVector Current = Start;
+		double Remaining = TotalTime;
+		double LastDistance = FVector::Dist(Current, Target);
+		while (Remaining > 0.0)
+		{
+			const double DeltaTime = FMath::Min(RandomDeltaTime(Stream), Remaining);
+			Current = APDCameraManager::DampTowards(Current, Target, DampingRate, DeltaTime);
+			Remaining -= DeltaTime;
+
+			const double Distance = FVector::Dist(Current, Target);
+			if (TestTrue(TEXT("Damping never moves away from the target"), Distance <= LastDistance) == false) { return false; }
+			LastDistance = Distance;
+		}
+
+		if (TestTrue(TEXT("Varied delta-times land on the same point as a single step"), Current.Equals(Reference, 1e-6)) == false) { return false; }
+	}
+
+	// Converges on the target and never overshoots it, regardless of the frame time
+	FVector Converged = Start;
+	for (int32 StepIdx = 0; StepIdx < 600; StepIdx++)
+	{
+		Converged = APDCameraManager::DampTowards(Converged, Target, DampingRate, RandomDeltaTime(Stream));
+	}
+	TestTrue(TEXT("Damping converges on the target"), Converged.Equals(Target, 1e-3));
+	TestTrue(TEXT("A huge delta-time does not overshoot"), APDCameraManager::DampTowards(Start, Target, DampingRate, 1000.0).Equals(Target, 1e-6));
+	TestTrue(TEXT("A zero damping rate snaps to the target"), APDCameraManager::DampTowards(Start, Target, 0.0, 1.0 / 60.0).Equals(Target));
+	TestTrue(TEXT("A negative delta-time does not move"), APDCameraManager::DampTowards(Start, Target, DampingRate, -1.0).Equals(Start));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
+
+/**
+Business Source License 1.1
+
+Parameters
+
+Licensor:             Ario Amin (@ Permafrost Development)
+Licensed Work:        RTSOpen (Source available on github)
+                      The Licensed Work is (c) 2024 Ario Amin (@ Permafrost Development)
+Additional Use Grant: You may make free use of the Licensed Work in a commercial product or service provided these three additional conditions as met; 
+                      1. Must give attributions to the original author of the Licensed Work, in 'Credits' if that is applicable.
+                      2. The Licensed Work must be Compiled before being redistributed.
+                      3. The Licensed Work Source may be linked but may not be packaged into the product or service being sold
+                      4. Must not be resold or repackaged or redistributed as another product, is only allowed to be used within a commercial or non-commercial game project.
+                      5. Teams with yearly budgets larger than 100000 USD must contact the owner for a custom license or buy the framework from a marketplace it has been made available on.
+
+                      "Credits" indicate a scrolling screen with attributions. This is usually in a products end-state
+
+                      "Package" means the collection of files distributed by the Licensor, and derivatives of that collection
+                      and/or of those files..   
+
+                      "Source" form means the source code, documentation source, and configuration files for the Package, usually in human-readable format.
+
+                      "Compiled" form means the compiled bytecode, object code, binary, or any other
+                      form resulting from mechanical transformation or translation of the Source form.
+
+Change Date:          2028-04-17
+
+Change License:       Apache License, Version 2.0
+
+For information about alternative licensing arrangements for the Software,
+please visit: https://permadev.se/
+
+Notice
+
+The Business Source License (this document, or the “License”) is not an Open
+Source license. However, the Licensed Work will eventually be made available
+under an Open Source License, as stated in this License.
+
+License text copyright (c) 2017 MariaDB Corporation Ab, All Rights Reserved.
+“Business Source License” is a trademark of MariaDB Corporation Ab.
+
+-----------------------------------------------------------------------------
+
+Business Source License 1.1
+
+Terms
+
+The Licensor hereby grants you the right to copy, modify, create derivative
+works, redistribute, and make non-production use of the Licensed Work. The
+Licensor may make an Additional Use Grant, above, permitting limited
+production use.
+
+Effective on the Change Date, or the fourth anniversary of the first publicly
+available distribution of a specific version of the Licensed Work under this
+License, whichever comes first, the Licensor hereby grants you rights under
+the terms of the Change License, and the rights granted in the paragraph
+above terminate.
+
+If your use of the Licensed Work does not comply with the requirements
+currently in effect as described in this License, you must purchase a
+commercial license from the Licensor, its affiliated entities, or authorized
+resellers, or you must refrain from using the Licensed Work.
+
+All copies of the original and modified Licensed Work, and derivative works
+of the Licensed Work, are subject to this License. This License applies
+separately for each version of the Licensed Work and the Change Date may vary
+for each version of the Licensed Work released by Licensor.
+
+You must conspicuously display this License on each original or modified copy
+of the Licensed Work. If you receive the Licensed Work in original or
+modified form from a third party, the terms and conditions set forth in this
+License apply to your use of that work.
+
+Any use of the Licensed Work in violation of this License will automatically
+terminate your rights under this License for the current and all other
+versions of the Licensed Work.
+
+This License does not grant you any right in any trademark or logo of
+Licensor or its affiliates (provided that you may use a trademark or logo of
+Licensor as expressly required by this License).
+
+TO THE EXTENT PERMITTED BY APPLICABLE LAW, THE LICENSED WORK IS PROVIDED ON
+AN “AS IS” BASIS. LICENSOR HEREBY DISCLAIMS ALL WARRANTIES AND CONDITIONS,
+EXPRESS OR IMPLIED, INCLUDING (WITHOUT LIMITATION) WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT, AND
+TITLE.
+
+MariaDB hereby grants you permission to use this License’s text to license
+your works, and to refer to it using the trademark “Business Source License”,
+as long as you comply with the Covenants of Licensor below.
+
+Covenants of Licensor
+
+In consideration of the right to use this License’s text and the “Business
+Source License” name and trademark, Licensor covenants to MariaDB, and to all
+other recipients of the licensed work to be provided by Licensor:
+
+1. To specify as the Change License the GPL Version 2.0 or any later version,
+   or a license that is compatible with GPL Version 2.0 or a later version,
+   where “compatible” means that software provided under the Change License can
+   be included in a program with software provided under GPL Version 2.0 or a
+   later version. Licensor may specify additional Change Licenses without
+   limitation.
+
+2. To either: (a) specify an additional grant of rights to use that does not
+   impose any additional restriction on the right granted in this License, as
+   the Additional Use Grant; or (b) insert the text “None”.
+
+3. To specify a Change Date.
+
+4. Not to modify this License in any other way.
+ **/
@@ -0,0 +1,301 @@
+﻿/* @author: Ario Amin @ Permafrost Development. @copyright: Full BSL(1.1) License included at bottom of the file  */
+
+#include "PDRTSFlowField.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace PD::FlowField::Tests
+{
+	/** @brief 10x10 grid of 100 unit cells, origin at the world origin */
+	FPDFlowFieldGrid MakeOpenGrid()
+	{
+		FPDFlowFieldGrid Grid;
+		Grid.Initialize(FVector2D::ZeroVector, 100.0, FIntPoint(10, 10));
+		return Grid;
+	}
+
+	/** @brief World location at the center of the cell */
+	FVector CellCenter(const FPDFlowFieldGrid& Grid, const int32 X, const int32 Y)
+	{
+		return Grid.CellToWorld(FIntPoint(X, Y));
+	}
+
+	/** @brief Follows the field from 'Start' one cell-length at a time, returns the amount of steps taken until the goal cell is reached or INDEX_NONE if it never is */
+	int32 WalkField(const FPDFlowField& FlowField, const FVector& Start, const int32 MaxSteps)
+	{
+		FVector Location = Start;
+		for (int32 Step = 0; Step < MaxSteps; Step++)
+		{
+			if (FlowField.IsInGoalCell(Location)) { return Step; }
+
+			FVector Direction;
+			if (FlowField.SampleDirection(Location, Direction) == false) { return INDEX_NONE; }
+
+			// Snap back to the cell center so diagonal steps do not drift across cell borders
+			const FPDFlowFieldGrid& Grid = FlowField.GetGrid();
+			Location = Grid.CellToWorld(Grid.WorldToCell(Location + Direction * Grid.CellSize * UE_SQRT_2));
+		}
+		return INDEX_NONE;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPDFlowFieldOpenGridTest, "PD.RTSBase.FlowField.OpenGrid", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FPDFlowFieldOpenGridTest::RunTest(const FString& Parameters)
+{
+	using namespace PD::FlowField::Tests;
+	const FPDFlowFieldGrid Grid = MakeOpenGrid();
+	const FVector Destination = CellCenter(Grid, 8, 5);
+
+	FPDFlowField FlowField;
+	if (TestTrue(TEXT("A walkable destination builds"), FlowField.Build(Grid, Destination)) == false) { return false; }
+
+	TestTrue(TEXT("The goal cell costs nothing"), FlowField.GetIntegratedCost(FIntPoint(8, 5)) == 0u);
+	TestTrue(TEXT("A straight neighbour costs a straight step"), FlowField.GetIntegratedCost(FIntPoint(7, 5)) == 10u);
+	TestTrue(TEXT("A diagonal neighbour costs a diagonal step"), FlowField.GetIntegratedCost(FIntPoint(7, 4)) == 14u);
+	TestTrue(TEXT("Cells outside of the grid are unreachable"), FlowField.GetIntegratedCost(FIntPoint(-1, 0)) == FPDFlowField::UnreachableCost);
+
+	FVector Direction;
+	TestTrue(TEXT("A cell in line with the goal samples"), FlowField.SampleDirection(CellCenter(Grid, 2, 5), Direction));
+	TestTrue(TEXT("A cell in line with the goal points straight at it"), Direction.Equals(FVector(1.0, 0.0, 0.0)));
+	TestTrue(TEXT("A cell on the goal diagonal samples"), FlowField.SampleDirection(CellCenter(Grid, 5, 2), Direction));
+	TestTrue(TEXT("A cell on the goal diagonal moves diagonally"), Direction.Equals(FVector(UE_INV_SQRT_2, UE_INV_SQRT_2, 0.0)));
+
+	// Inside the goal cell and outside of the grid the field points at the exact destination
+	const FVector InGoalCell = Destination + FVector(-30.0, 0.0, 0.0);
+	TestTrue(TEXT("The goal cell is detected"), FlowField.IsInGoalCell(InGoalCell));
+	TestFalse(TEXT("A neighbouring cell is not the goal cell"), FlowField.IsInGoalCell(CellCenter(Grid, 7, 5)));
+	TestTrue(TEXT("The goal cell samples"), FlowField.SampleDirection(InGoalCell, Direction));
+	TestTrue(TEXT("The goal cell points at the destination"), Direction.Equals(FVector(1.0, 0.0, 0.0)));
+	TestTrue(TEXT("Locations outside of the grid sample"), FlowField.SampleDirection(FVector(-500.0, 550.0, 0.0), Direction));
+	TestTrue(TEXT("Locations outside of the grid point at the destination"), Direction.Equals((Destination - FVector(-500.0, 550.0, 0.0)).GetSafeNormal2D()));
+
+	// Every cell of an open grid reaches the goal in at most as many steps as its chebyshev distance
+	for (int32 Y = 0; Y < Grid.Dimensions.Y; Y++)
+	{
+		for (int32 X = 0; X < Grid.Dimensions.X; X++)
+		{
+			const int32 Steps = WalkField(FlowField, CellCenter(Grid, X, Y), 100);
+			if (TestEqual(FString::Printf(TEXT("Cell (%d, %d) takes the shortest route to the goal"), X, Y), Steps, FMath::Max(FMath::Abs(X - 8), FMath::Abs(Y - 5))) == false) { return false; }
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPDFlowFieldBlockedCellsTest, "PD.RTSBase.FlowField.BlockedCells", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FPDFlowFieldBlockedCellsTest::RunTest(const FString& Parameters)
+{
+	using namespace PD::FlowField::Tests;
+
+	// Wall along x = 5 with a single gap at the top row
+	FPDFlowFieldGrid Grid = MakeOpenGrid();
+	for (int32 Y = 0; Y < Grid.Dimensions.Y - 1; Y++) { Grid.SetCost(FIntPoint(5, Y), FPDFlowFieldGrid::BlockedCost); }
+
+	FPDFlowField FlowField;
+	if (TestTrue(TEXT("A walkable destination behind a wall builds"), FlowField.Build(Grid, CellCenter(Grid, 8, 0))) == false) { return false; }
+
+	TestFalse(TEXT("Wall cells are unreachable"), FlowField.IsReachable(CellCenter(Grid, 5, 0)));
+	TestTrue(TEXT("Wall cells have no integrated cost"), FlowField.GetIntegratedCost(FIntPoint(5, 0)) == FPDFlowField::UnreachableCost);
+
+	FVector Direction;
+	TestFalse(TEXT("Wall cells do not sample"), FlowField.SampleDirection(CellCenter(Grid, 5, 0), Direction));
+	TestTrue(TEXT("Wall cells return a zero direction"), Direction.IsZero());
+
+	// Right in front of the wall the route leads up towards the gap instead of into the wall
+	TestTrue(TEXT("The cell in front of the wall samples"), FlowField.SampleDirection(CellCenter(Grid, 4, 0), Direction));
+	TestTrue(TEXT("The cell in front of the wall does not step into it"), Direction.X <= 0.0 && Direction.Y > 0.0);
+
+	const int32 Steps = WalkField(FlowField, CellCenter(Grid, 0, 0), 100);
+	TestTrue(TEXT("The far side of the wall reaches the goal"), Steps != INDEX_NONE);
+	TestTrue(TEXT("The route goes through the gap"), Steps >= 2 * (Grid.Dimensions.Y - 1));
+
+	// Diagonals may not cut the corner of a blocked cell
+	FPDFlowFieldGrid CornerGrid = MakeOpenGrid();
+	CornerGrid.SetCost(FIntPoint(5, 4), FPDFlowFieldGrid::BlockedCost);
+	FPDFlowField CornerField;
+	CornerField.Build(CornerGrid, CellCenter(CornerGrid, 5, 5));
+	TestTrue(TEXT("Corner cutting is not allowed"), CornerField.GetIntegratedCost(FIntPoint(4, 4)) == 10u + 10u);
+	TestTrue(TEXT("Diagonals away from the blocked cell are still allowed"), CornerField.GetIntegratedCost(FIntPoint(6, 6)) == 14u);
+
+	// Higher cell costs are routed around when a cheaper detour exists
+	FPDFlowFieldGrid CostGrid = MakeOpenGrid();
+	for (int32 Y = 3; Y <= 7; Y++) { CostGrid.SetCost(FIntPoint(5, Y), 20); }
+	FPDFlowField CostField;
+	CostField.Build(CostGrid, CellCenter(CostGrid, 8, 5));
+	TestTrue(TEXT("The straight route through expensive cells is avoided"), CostField.GetIntegratedCost(FIntPoint(2, 5)) < 6u * 10u + 19u * 10u);
+	TestTrue(TEXT("Expensive cells are still reachable"), CostField.IsReachable(CellCenter(CostGrid, 5, 5)));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPDFlowFieldUnreachableTest, "PD.RTSBase.FlowField.Unreachable", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FPDFlowFieldUnreachableTest::RunTest(const FString& Parameters)
+{
+	using namespace PD::FlowField::Tests;
+	FPDFlowFieldGrid Grid = MakeOpenGrid();
+
+	FPDFlowField FlowField;
+	TestFalse(TEXT("A destination outside of the grid fails"), FlowField.Build(Grid, FVector(-50.0, 50.0, 0.0)));
+
+	Grid.SetCost(FIntPoint(8, 5), FPDFlowFieldGrid::BlockedCost);
+	TestFalse(TEXT("A blocked destination fails"), FlowField.Build(Grid, CellCenter(Grid, 8, 5)));
+	Grid.SetCost(FIntPoint(8, 5), 1);
+
+	// Enclose the corner cell (0, 0) completely
+	Grid.SetCost(FIntPoint(1, 0), FPDFlowFieldGrid::BlockedCost);
+	Grid.SetCost(FIntPoint(0, 1), FPDFlowFieldGrid::BlockedCost);
+	Grid.SetCost(FIntPoint(1, 1), FPDFlowFieldGrid::BlockedCost);
+	if (TestTrue(TEXT("A walkable destination builds"), FlowField.Build(Grid, CellCenter(Grid, 8, 5))) == false) { return false; }
+
+	FVector Direction;
+	TestFalse(TEXT("An enclosed pocket is unreachable"), FlowField.IsReachable(CellCenter(Grid, 0, 0)));
+	TestFalse(TEXT("An enclosed pocket does not sample"), FlowField.SampleDirection(CellCenter(Grid, 0, 0), Direction));
+	TestTrue(TEXT("The rest of the grid is reachable"), FlowField.IsReachable(CellCenter(Grid, 2, 2)));
+	TestTrue(TEXT("Locations outside of the grid count as reachable"), FlowField.IsReachable(FVector(-500.0, -500.0, 0.0)));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPDFlowFieldGridBudgetTest, "PD.RTSBase.FlowField.GridBudget", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FPDFlowFieldGridBudgetTest::RunTest(const FString& Parameters)
+{
+	// Without a world there is no navigation system, so only the sizing is exercised and every cell is left walkable
+	const FBox Bounds(FVector(0.0, 0.0, -100.0), FVector(100000.0, 30000.0, 100.0));
+
+	FPDFlowFieldGrid Grid;
+	Grid.BuildFromNavigation(nullptr, Bounds, 200.0, 256, 4096, 500.0);
+	TestTrue(TEXT("The grid stays within the cell budget"), Grid.Dimensions.X * Grid.Dimensions.Y <= 4096);
+	TestTrue(TEXT("The grid stays within the per-axis limit"), Grid.Dimensions.X <= 256 && Grid.Dimensions.Y <= 256);
+	TestTrue(TEXT("The grid still covers the bounds along X"), Grid.Dimensions.X * Grid.CellSize >= 100000.0);
+	TestTrue(TEXT("The grid still covers the bounds along Y"), Grid.Dimensions.Y * Grid.CellSize >= 30000.0);
+	TestEqual(TEXT("Cell count matches the dimensions"), Grid.Costs.Num(), Grid.Dimensions.X * Grid.Dimensions.Y);
+	TestFalse(TEXT("Without navigation every cell is walkable"), Grid.Costs.Contains(FPDFlowFieldGrid::BlockedCost));
+
+	// Small areas keep the requested cell size
+	const FBox SmallBounds(FVector::ZeroVector, FVector(2000.0, 1000.0, 0.0));
+	Grid.BuildFromNavigation(nullptr, SmallBounds, 200.0, 256, 4096, 500.0);
+	TestEqual(TEXT("Small areas keep the requested cell size"), Grid.CellSize, 200.0);
+	TestTrue(TEXT("Small areas are sized by the requested cell size"), Grid.Dimensions == FIntPoint(10, 5));
+
+	// Degenerate budgets collapse to a single cell instead of looping
+	Grid.BuildFromNavigation(nullptr, Bounds, 200.0, 256, 0, 500.0);
+	TestTrue(TEXT("A zero budget collapses to a single cell"), Grid.Dimensions == FIntPoint(1, 1));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
+
+/**
+Business Source License 1.1
+
+Parameters
+
+Licensor:             Ario Amin (@ Permafrost Development)
+Licensed Work:        RTSOpen (Source available on github)
+                      The Licensed Work is (c) 2024 Ario Amin (@ Permafrost Development)
+Additional Use Grant: You may make free use of the Licensed Work in a commercial product or service provided these three additional conditions as met; 
+                      1. Must give attributions to the original author of the Licensed Work, in 'Credits' if that is applicable.
+                      2. The Licensed Work must be Compiled before being redistributed.
+                      3. The Licensed Work Source may be linked but may not be packaged into the product or service being sold
+                      4. Must not be resold or repackaged or redistributed as another product, is only allowed to be used within a commercial or non-commercial game project.
+                      5. Teams with yearly budgets larger than 100000 USD must contact the owner for a custom license or buy the framework from a marketplace it has been made available on.
+
+                      "Credits" indicate a scrolling screen with attributions. This is usually in a products end-state
+
+                      "Package" means the collection of files distributed by the Licensor, and derivatives of that collection
+                      and/or of those files..   
+
+                      "Source" form means the source code, documentation source, and configuration files for the Package, usually in human-readable format.
+
+                      "Compiled" form means the compiled bytecode, object code, binary, or any other
+                      form resulting from mechanical transformation or translation of the Source form.
+
+Change Date:          2028-04-17
+
+Change License:       Apache License, Version 2.0
+
+For information about alternative licensing arrangements for the Software,
+please visit: https://permadev.se/
+
+Notice
+
+The Business Source License (this document, or the “License”) is not an Open
+Source license. However, the Licensed Work will eventually be made available
+under an Open Source License, as stated in this License.
+
+License text copyright (c) 2017 MariaDB Corporation Ab, All Rights Reserved.
+“Business Source License” is a trademark of MariaDB Corporation Ab.
+
+-----------------------------------------------------------------------------
+
+Business Source License 1.1
+
+Terms
+
+The Licensor hereby grants you the right to copy, modify, create derivative
+works, redistribute, and make non-production use of the Licensed Work. The
+Licensor may make an Additional Use Grant, above, permitting limited
+production use.
+
+Effective on the Change Date, or the fourth anniversary of the first publicly
+available distribution of a specific version of the Licensed Work under this
+License, whichever comes first, the Licensor hereby grants you rights under
+the terms of the Change License, and the rights granted in the paragraph
+above terminate.
+
+If your use of the Licensed Work does not comply with the requirements
+currently in effect as described in this License, you must purchase a
+commercial license from the Licensor, its affiliated entities, or authorized
+resellers, or you must refrain from using the Licensed Work.
+
+All copies of the original and modified Licensed Work, and derivative works
+of the Licensed Work, are subject to this License. This License applies
+separately for each version of the Licensed Work and the Change Date may vary
+for each version of the Licensed Work released by Licensor.
+
+You must conspicuously display this License on each original or modified copy
+of the Licensed Work. If you receive the Licensed Work in original or
+modified form from a third party, the terms and conditions set forth in this
+License apply to your use of that work.
+
+Any use of the Licensed Work in violation of this License will automatically
+terminate your rights under this License for the current and all other
+versions of the Licensed Work.
+
+This License does not grant you any right in any trademark or logo of
+Licensor or its affiliates (provided that you may use a trademark or logo of
+Licensor as expressly required by this License).
+
+TO THE EXTENT PERMITTED BY APPLICABLE LAW, THE LICENSED WORK IS PROVIDED ON
+AN “AS IS” BASIS. LICENSOR HEREBY DISCLAIMS ALL WARRANTIES AND CONDITIONS,
+EXPRESS OR IMPLIED, INCLUDING (WITHOUT LIMITATION) WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT, AND
+TITLE.
+
+MariaDB hereby grants you permission to use this License’s text to license
+your works, and to refer to it using the trademark “Business Source License”,
+as long as you comply with the Covenants of Licensor below.
+
+Covenants of Licensor
+
+In consideration of the right to use this License’s text and the “Business
+Source License” name and trademark, Licensor covenants to MariaDB, and to all
+other recipients of the licensed work to be provided by Licensor:
+
+1. To specify as the Change License the GPL Version 2.0 or any later version,
+   or a license that is compatible with GPL Version 2.0 or a later version,
+   where “compatible” means that software provided under the Change License can
+   be included in a program with software provided under GPL Version 2.0 or a
+   later version. Licensor may specify additional Change Licenses without
+   limitation.
+
+2. To either: (a) specify an additional grant of rights to use that does not
+   impose any additional restriction on the right granted in this License, as
+   the Additional Use Grant; or (b) insert the text “None”.
+
+3. To specify a Change Date.
+
+4. Not to modify this License in any other way.
+ **/
@@ -0,0 +1,265 @@
+﻿/* @author: Ario Amin @ Permafrost Development. @copyright: Full BSL(1.1) License included at bottom of the file  */
+
+#include "PDRTSFormation.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace PD::Formation::Tests
+{
+	/** @brief Is every slot used exactly once */
+	bool IsPermutation(const TArray<int32>& SlotPerUnit, const int32 SlotCount)
+	{
+		if (SlotPerUnit.Num() != SlotCount) { return false; }
+
+		TBitArray<> Used(false, SlotCount);
+		for (const int32 Slot : SlotPerUnit)
+		{
+			if (Slot < 0 || Slot >= SlotCount || Used[Slot]) { return false; }
+			Used[Slot] = true;
+		}
+		return true;
+	}
+
+	/** @brief Summed 2d distance from every unit to its assigned slot */
+	double TotalTravel(const FPDFormationLayout& Layout, TConstArrayView<FVector> UnitLocations, const TArray<int32>& SlotPerUnit)
+	{
+		double Travel = 0.0;
+		for (int32 UnitIdx = 0; UnitIdx < UnitLocations.Num(); UnitIdx++)
+		{
+			Travel += FVector::Dist2D(UnitLocations[UnitIdx], Layout.Slots[SlotPerUnit[UnitIdx]]);
+		}
+		return Travel;
+	}
+
+	/** @brief Smallest 2d distance between any two slots */
+	double MinSlotDistance(const FPDFormationLayout& Layout)
+	{
+		double MinDistance = TNumericLimits<double>::Max();
+		for (int32 SlotA = 0; SlotA < Layout.Slots.Num(); SlotA++)
+		{
+			for (int32 SlotB = SlotA + 1; SlotB < Layout.Slots.Num(); SlotB++)
+			{
+				MinDistance = FMath::Min(MinDistance, FVector::Dist2D(Layout.Slots[SlotA], Layout.Slots[SlotB]));
+			}
+		}
+		return MinDistance;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPDFormationBuildLayoutTest, "PD.RTSBase.Formation.BuildLayout", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FPDFormationBuildLayoutTest::RunTest(const FString& Parameters)
+{
+	using namespace PD::Formation::Tests;
+	const FVector Center(1000.0, -500.0, 0.0);
+
+	for (const EPDFormationShape Shape : {EPDFormationShape::Line, EPDFormationShape::Box, EPDFormationShape::Wedge})
+	{
+		for (const int32 SlotCount : {1, 2, 7, 16, 50})
+		{
+			FPDFormationLayout Layout;
+			FPDFormation::BuildLayout(Shape, SlotCount, Center, FVector(0.0, 1.0, 0.0), 100.0, Layout);
+
+			const FString Context = FString::Printf(TEXT("Shape %d, %d slots"), static_cast<int32>(Shape), SlotCount);
+			int32 RowSum = 0;
+			for (const int32 RowCount : Layout.RowCounts) { RowSum += RowCount; }
+
+			TestEqual(*FString::Printf(TEXT("%s: slot count"), *Context), Layout.Slots.Num(), SlotCount);
+			TestEqual(*FString::Printf(TEXT("%s: row counts sum up to the slot count"), *Context), RowSum, SlotCount);
+			TestTrue(*FString::Printf(TEXT("%s: facing is normalized"), *Context), Layout.Forward.Equals(FVector(0.0, 1.0, 0.0)));
+			if (SlotCount > 1)
+			{
+				TestTrue(*FString::Printf(TEXT("%s: slots are spaced apart"), *Context), MinSlotDistance(Layout) >= 100.0 - KINDA_SMALL_NUMBER);
+			}
+
+			// Each row is centered on the formation axis
+			int32 RowStart = 0;
+			for (const int32 RowCount : Layout.RowCounts)
+			{
+				double RightSum = 0.0;
+				for (int32 Column = 0; Column < RowCount; Column++) { RightSum += (Layout.Slots[RowStart + Column] - Center).Dot(Layout.Right); }
+				TestEqual(*FString::Printf(TEXT("%s: rows are centered"), *Context), RightSum, 0.0, 1e-6);
+				RowStart += RowCount;
+			}
+		}
+	}
+
+	// A zero spacing, ie. from a zero unit radius, still yields distinct slots
+	FPDFormationLayout ZeroLayout;
+	FPDFormation::BuildLayout(EPDFormationShape::Box, 16, Center, FVector::ForwardVector, 0.0, ZeroLayout);
+	TestTrue(TEXT("A zero spacing does not stack slots"), MinSlotDistance(ZeroLayout) >= FPDFormation::MinSpacing - KINDA_SMALL_NUMBER);
+
+	FPDFormationLayout EmptyLayout;
+	FPDFormation::BuildLayout(EPDFormationShape::Wedge, 0, Center, FVector::ForwardVector, 100.0, EmptyLayout);
+	TestTrue(TEXT("No slots yields an empty layout"), EmptyLayout.Slots.IsEmpty() && EmptyLayout.RowCounts.IsEmpty());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPDFormationAssignSlotsTest, "PD.RTSBase.Formation.AssignSlots", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FPDFormationAssignSlotsTest::RunTest(const FString& Parameters)
+{
+	using namespace PD::Formation::Tests;
+
+	// A group that already stands in formation, just further back, keeps its relative placement
+	FPDFormationLayout Layout;
+	FPDFormation::BuildLayout(EPDFormationShape::Box, 25, FVector(2000.0, 0.0, 0.0), FVector::ForwardVector, 100.0, Layout);
+
+	TArray<FVector> UnitLocations;
+	for (const FVector& Slot : Layout.Slots) { UnitLocations.Emplace(Slot - FVector(2000.0, 0.0, 0.0)); }
+
+	TArray<int32> SlotPerUnit;
+	FPDFormation::AssignSlots(Layout, UnitLocations, 4, SlotPerUnit);
+	TestTrue(TEXT("Every slot is used exactly once"), IsPermutation(SlotPerUnit, Layout.Slots.Num()));
+	for (int32 UnitIdx = 0; UnitIdx < UnitLocations.Num(); UnitIdx++)
+	{
+		if (TestEqual(TEXT("A translated formation maps onto the same slots"), SlotPerUnit[UnitIdx], UnitIdx) == false) { break; }
+	}
+
+	// Scattered groups, refinement never makes the result worse and beats a naive in-order assignment
+	FRandomStream Stream(0xF0A7);
+	for (int32 Run = 0; Run < 16; Run++)
+	{
+		const int32 Count = Stream.RandRange(20, 200);
+		FPDFormation::BuildLayout(static_cast<EPDFormationShape>(Run % 3), Count, FVector(5000.0, 5000.0, 0.0), FVector(1.0, 1.0, 0.0), 120.0, Layout);
+
+		UnitLocations.Reset();
+		for (int32 UnitIdx = 0; UnitIdx < Count; UnitIdx++) { UnitLocations.Emplace(Stream.FRandRange(-2000.0, 2000.0), Stream.FRandRange(-2000.0, 2000.0), 0.0); }
+
+		TArray<int32> Unrefined;
+		FPDFormation::AssignSlots(Layout, UnitLocations, 0, Unrefined);
+		FPDFormation::AssignSlots(Layout, UnitLocations, 4, SlotPerUnit);
+
+		TArray<int32> InOrder;
+		for (int32 UnitIdx = 0; UnitIdx < Count; UnitIdx++) { InOrder.Add(UnitIdx); }
+
+		const double RefinedTravel = TotalTravel(Layout, UnitLocations, SlotPerUnit);
+		TestTrue(TEXT("Unrefined assignments are valid"), IsPermutation(Unrefined, Count));
+		TestTrue(TEXT("Refined assignments are valid"), IsPermutation(SlotPerUnit, Count));
+		TestTrue(TEXT("Refinement never increases total travel"), RefinedTravel <= TotalTravel(Layout, UnitLocations, Unrefined) + KINDA_SMALL_NUMBER);
+		TestTrue(TEXT("The assignment beats an in-order assignment"), RefinedTravel <= TotalTravel(Layout, UnitLocations, InOrder) + KINDA_SMALL_NUMBER);
+	}
+
+	// Units stacked on a single point, ie. spawned together, still get distinct slots
+	FPDFormation::BuildLayout(EPDFormationShape::Wedge, 12, FVector(500.0, 0.0, 0.0), FVector::ForwardVector, 0.0, Layout);
+	UnitLocations.Init(FVector::ZeroVector, 12);
+	FPDFormation::AssignSlots(Layout, UnitLocations, 4, SlotPerUnit);
+	TestTrue(TEXT("Stacked units are assigned distinct slots"), IsPermutation(SlotPerUnit, 12));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
+
+/**
+Business Source License 1.1
+
+Parameters
+
+Licensor:             Ario Amin (@ Permafrost Development)
+Licensed Work:        RTSOpen (Source available on github)
+                      The Licensed Work is (c) 2024 Ario Amin (@ Permafrost Development)
+Additional Use Grant: You may make free use of the Licensed Work in a commercial product or service provided these three additional conditions as met; 
+                      1. Must give attributions to the original author of the Licensed Work, in 'Credits' if that is applicable.
+                      2. The Licensed Work must be Compiled before being redistributed.
+                      3. The Licensed Work Source may be linked but may not be packaged into the product or service being sold
+                      4. Must not be resold or repackaged or redistributed as another product, is only allowed to be used within a commercial or non-commercial game project.
+                      5. Teams with yearly budgets larger than 100000 USD must contact the owner for a custom license or buy the framework from a marketplace it has been made available on.
+
+                      "Credits" indicate a scrolling screen with attributions. This is usually in a products end-state
+
+                      "Package" means the collection of files distributed by the Licensor, and derivatives of that collection
+                      and/or of those files..   
+
+                      "Source" form means the source code, documentation source, and configuration files for the Package, usually in human-readable format.
+
+                      "Compiled" form means the compiled bytecode, object code, binary, or any other
+                      form resulting from mechanical transformation or translation of the Source form.
+
+Change Date:          2028-04-17
+
+Change License:       Apache License, Version 2.0
+
+For information about alternative licensing arrangements for the Software,
+please visit: https://permadev.se/
+
+Notice
+
+The Business Source License (this document, or the “License”) is not an Open
+Source license. However, the Licensed Work will eventually be made available
+under an Open Source License, as stated in this License.
+
+License text copyright (c) 2017 MariaDB Corporation Ab, All Rights Reserved.
+“Business Source License” is a trademark of MariaDB Corporation Ab.
+
+-----------------------------------------------------------------------------
+
+Business Source License 1.1
+
+Terms
+
+The Licensor hereby grants you the right to copy, modify, create derivative
+works, redistribute, and make non-production use of the Licensed Work. The
+Licensor may make an Additional Use Grant, above, permitting limited
+production use.
+
+Effective on the Change Date, or the fourth anniversary of the first publicly
+available distribution of a specific version of the Licensed Work under this
+License, whichever comes first, the Licensor hereby grants you rights under
+the terms of the Change License, and the rights granted in the paragraph
+above terminate.
+
+If your use of the Licensed Work does not comply with the requirements
+currently in effect as described in this License, you must purchase a
+commercial license from the Licensor, its affiliated entities, or authorized
+resellers, or you must refrain from using the Licensed Work.
+
+All copies of the original and modified Licensed Work, and derivative works
+of the Licensed Work, are subject to this License. This License applies
+separately for each version of the Licensed Work and the Change Date may vary
+for each version of the Licensed Work released by Licensor.
+
+You must conspicuously display this License on each original or modified copy
+of the Licensed Work. If you receive the Licensed Work in original or
+modified form from a third party, the terms and conditions set forth in this
+License apply to your use of that work.
+
+Any use of the Licensed Work in violation of this License will automatically
+terminate your rights under this License for the current and all other
+versions of the Licensed Work.
+
+This License does not grant you any right in any trademark or logo of
+Licensor or its affiliates (provided that you may use a trademark or logo of
+Licensor as expressly required by this License).
+
+TO THE EXTENT PERMITTED BY APPLICABLE LAW, THE LICENSED WORK IS PROVIDED ON
+AN “AS IS” BASIS. LICENSOR HEREBY DISCLAIMS ALL WARRANTIES AND CONDITIONS,
+EXPRESS OR IMPLIED, INCLUDING (WITHOUT LIMITATION) WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT, AND
+TITLE.
+
+MariaDB hereby grants you permission to use this License’s text to license
+your works, and to refer to it using the trademark “Business Source License”,
+as long as you comply with the Covenants of Licensor below.
+
+Covenants of Licensor
+
+In consideration of the right to use this License’s text and the “Business
+Source License” name and trademark, Licensor covenants to MariaDB, and to all
+other recipients of the licensed work to be provided by Licensor:
+
+1. To specify as the Change License the GPL Version 2.0 or any later version,
+   or a license that is compatible with GPL Version 2.0 or a later version,
+   where “compatible” means that software provided under the Change License can
+   be included in a program with software provided under GPL Version 2.0 or a
+   later version. Licensor may specify additional Change Licenses without
+   limitation.
+
+2. To either: (a) specify an additional grant of rights to use that does not
+   impose any additional restriction on the right granted in this License, as
+   the Additional Use Grant; or (b) insert the text “None”.
+
+3. To specify a Change Date.
+
+4. Not to modify this License in any other way.
+ **/
@@ -0,0 +1,227 @@
+﻿/* @author: Ario Amin @ Permafrost Development. @copyright: Full BSL(1.1) License included at bottom of the file  */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "PDMassAvoidance.generated.h"
+
+/** @brief Local avoidance developer settings, modify in .ini config or in editor project settings */
+UCLASS(Config = "Game", DefaultConfig)
+class PDRTSBASE_API UPDAvoidanceSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UPDAvoidanceSettings(){}
+
+	/** @brief Toggles UPDProcessor_LocalAvoidance */
+	UPROPERTY(Config, EditAnywhere, Category = "Avoidance")
+	bool bEnableLocalAvoidance = true;
+
+	/** @brief Neighbour bucket size, should be at least the largest agent diameter plus the separation buffer */
+	UPROPERTY(Config, EditAnywhere, Category = "Avoidance")
+	float CellSize = 200.f;
+
+	/** @brief Radius used for entities without a FAgentRadiusFragment */
+	UPROPERTY(Config, EditAnywhere, Category = "Avoidance")
+	float DefaultAgentRadius = 40.f;
+
+	/** @brief Extra distance kept between agents on top of their radii */
+	UPROPERTY(Config, EditAnywhere, Category = "Avoidance")
+	float SeparationBuffer = 10.f;
+
+	/** @brief Force applied at full overlap, falls off linearly to zero at the separation distance */
+	UPROPERTY(Config, EditAnywhere, Category = "Avoidance")
+	float SeparationStrength = 600.f;
+
+	/** @brief Force applied when a neighbour is on a collision course, scaled by how soon the closest approach is */
+	UPROPERTY(Config, EditAnywhere, Category = "Avoidance")
+	float AvoidanceStrength = 300.f;
+
+	/** @brief How far ahead, in seconds, approaching neighbours are considered */
+	UPROPERTY(Config, EditAnywhere, Category = "Avoidance")
+	float PredictionHorizon = 1.0f;
+
+	/** @brief Max neighbour candidates tested per agent, caps the cost of an agent stood in a dense blob */
+	UPROPERTY(Config, EditAnywhere, Category = "Avoidance")
+	int32 MaxNeighboursPerAgent = 16;
+
+	/** @brief Max neighbour tests per frame across all agents. Agents are processed highest LOD first, the rest wait for a later frame */
+	UPROPERTY(Config, EditAnywhere, Category = "Avoidance")
+	int32 MaxNeighbourTestsPerFrame = 500000;
+
+	/** @brief Update interval, in frames, per representation LOD (High, Medium, Low, Off). 0 never updates */
+	UPROPERTY(Config, EditAnywhere, Category = "Avoidance")
+	int32 LODUpdateIntervals[4] = {1, 2, 4, 0};
+};
+
+/** @brief Per-agent steering parameters, resolved from UPDAvoidanceSettings */
+struct PDRTSBASE_API FPDAvoidanceParams
+{
+	float SeparationBuffer = 10.f;
+	float SeparationStrength = 600.f;
+	float AvoidanceStrength = 300.f;
+	float PredictionHorizon = 1.0f;
+	int32 MaxNeighbours = 16;
+
+	/** @brief Copies the steering parameters from the settings */
+	static FPDAvoidanceParams FromSettings(const UPDAvoidanceSettings& Settings);
+};
+
+/** @brief Agents as a structure of arrays, in the XY plane */
+struct PDRTSBASE_API FPDAvoidanceAgents
+{
+	/** @brief Empties the arrays, keeps their allocations */
+	void Reset(int32 ExpectedCount = 0);
+	/** @brief Appends an agent, returns its index */
+	int32 Add(const FVector& Location, const FVector& Velocity, float Radius);
+	/** @brief Agent count */
+	FORCEINLINE int32 Num() const { return PosX.Num(); }
+
+	TArray<float> PosX;
+	TArray<float> PosY;
+	TArray<float> VelX;
+	TArray<float> VelY;
+	TArray<float> Radius;
+};
+
+/** @brief Uniform bucket grid over a set of agents.
+ * @note Agents are counting-sorted by cell into contiguous arrays, so each cell is a dense run that the steering loop streams through without indirection */
+struct PDRTSBASE_API FPDAvoidanceGrid
+{
+	/** @brief Buckets the agents, cell size grows if the agents are spread over more than 'MaxCells' cells */
+	void Build(const FPDAvoidanceAgents& Agents, float InCellSize, int32 MaxCells = 1 << 20);
+
+	/** @brief Separation and predictive avoidance force for an agent, from its 3x3 cell neighbourhood.
+	 *  @return Amount of neighbour candidates tested */
+	int32 ComputeSteering(const FPDAvoidanceAgents& Agents, int32 AgentIdx, const FPDAvoidanceParams& Params, FVector2f& OutForce) const;
+
+	/** @brief Cell size actually used */
+	float CellSize = 200.f;
+	/** @brief World location of the grids minimum corner */
+	FVector2f Origin = FVector2f::ZeroVector;
+	/** @brief Cell count along X and Y */
+	FIntPoint Dimensions = FIntPoint::ZeroValue;
+
+	/** @brief First sorted index of each cell, has one trailing entry so a cell spans [CellStart[Cell], CellStart[Cell + 1]) */
+	TArray<int32> CellStart;
+	/** @brief Cell of each agent, by agent index */
+	TArray<int32> AgentCell;
+	/** @brief Agent data in cell order */
+	FPDAvoidanceAgents Sorted;
+	/** @brief Agent index of each sorted entry */
+	TArray<int32> SortedToAgent;
+};
+
+/**
+Business Source License 1.1
+
+Parameters
+
+Licensor:             Ario Amin (@ Permafrost Development)
+Licensed Work:        RTSOpen (Source available on github)
+                      The Licensed Work is (c) 2024 Ario Amin (@ Permafrost Development)
+Additional Use Grant: You may make free use of the Licensed Work in a commercial product or service provided these three additional conditions as met; 
+                      1. Must give attributions to the original author of the Licensed Work, in 'Credits' if that is applicable.
+                      2. The Licensed Work must be Compiled before being redistributed.
+                      3. The Licensed Work Source may be linked but may not be packaged into the product or service being sold
+                      4. Must not be resold or repackaged or redistributed as another product, is only allowed to be used within a commercial or non-commercial game project.
+                      5. Teams with yearly budgets larger than 100000 USD must contact the owner for a custom license or buy the framework from a marketplace it has been made available on.
+
+                      "Credits" indicate a scrolling screen with attributions. This is usually in a products end-state
+
+                      "Package" means the collection of files distributed by the Licensor, and derivatives of that collection
+                      and/or of those files..   
+
+                      "Source" form means the source code, documentation source, and configuration files for the Package, usually in human-readable format.
+
+                      "Compiled" form means the compiled bytecode, object code, binary, or any other
+                      form resulting from mechanical transformation or translation of the Source form.
+
+Change Date:          2028-04-17
+
+Change License:       Apache License, Version 2.0
+
+For information about alternative licensing arrangements for the Software,
+please visit: https://permadev.se/
+
+Notice
+
+The Business Source License (this document, or the “License”) is not an Open
+Source license. However, the Licensed Work will eventually be made available
+under an Open Source License, as stated in this License.
+
+License text copyright (c) 2017 MariaDB Corporation Ab, All Rights Reserved.
+“Business Source License” is a trademark of MariaDB Corporation Ab.
+
+-----------------------------------------------------------------------------
+
+Business Source License 1.1
+
+Terms
+
+The Licensor hereby grants you the right to copy, modify, create derivative
+works, redistribute, and make non-production use of the Licensed Work. The
+Licensor may make an Additional Use Grant, above, permitting limited
+production use.
+
+Effective on the Change Date, or the fourth anniversary of the first publicly
+available distribution of a specific version of the Licensed Work under this
+License, whichever comes first, the Licensor hereby grants you rights under
+the terms of the Change License, and the rights granted in the paragraph
+above terminate.
+
+If your use of the Licensed Work does not comply with the requirements
+currently in effect as described in this License, you must purchase a
+commercial license from the Licensor, its affiliated entities, or authorized
+resellers, or you must refrain from using the Licensed Work.
+
+All copies of the original and modified Licensed Work, and derivative works
+of the Licensed Work, are subject to this License. This License applies
+separately for each version of the Licensed Work and the Change Date may vary
+for each version of the Licensed Work released by Licensor.
+
+You must conspicuously display this License on each original or modified copy
+of the Licensed Work. If you receive the Licensed Work in original or
+modified form from a third party, the terms and conditions set forth in this
+License apply to your use of that work.
+
+Any use of the Licensed Work in violation of this License will automatically
+terminate your rights under this License for the current and all other
+versions of the Licensed Work.
+
+This License does not grant you any right in any trademark or logo of
+Licensor or its affiliates (provided that you may use a trademark or logo of
+Licensor as expressly required by this License).
+
+TO THE EXTENT PERMITTED BY APPLICABLE LAW, THE LICENSED WORK IS PROVIDED ON
+AN “AS IS” BASIS. LICENSOR HEREBY DISCLAIMS ALL WARRANTIES AND CONDITIONS,
+EXPRESS OR IMPLIED, INCLUDING (WITHOUT LIMITATION) WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT, AND
+TITLE.
+
+MariaDB hereby grants you permission to use this License’s text to license
+your works, and to refer to it using the trademark “Business Source License”,
+as long as you comply with the Covenants of Licensor below.
+
+Covenants of Licensor
+
+In consideration of the right to use this License’s text and the “Business
+Source License” name and trademark, Licensor covenants to MariaDB, and to all
+other recipients of the licensed work to be provided by Licensor:
+
+1. To specify as the Change License the GPL Version 2.0 or any later version,
+   or a license that is compatible with GPL Version 2.0 or a later version,
+   where “compatible” means that software provided under the Change License can
+   be included in a program with software provided under GPL Version 2.0 or a
+   later version. Licensor may specify additional Change Licenses without
+   limitation.
+
+2. To either: (a) specify an additional grant of rights to use that does not
+   impose any additional restriction on the right granted in this License, as
+   the Additional Use Grant; or (b) insert the text “None”.
+
+3. To specify a Change Date.
+
+4. Not to modify this License in any other way.
+ **/
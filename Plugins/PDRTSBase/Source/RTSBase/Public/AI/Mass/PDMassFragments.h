@@ -19,6 +19,8 @@ class UAnimToTextureDataAsset;
 // MassTags
 /** @brief MassTag: RTSEntityTag */
 USTRUCT() struct PDRTSBASE_API FPDMTag_RTSEntity : public FMassTag { GENERATED_BODY(); };
+/** @brief MassTag: Selected. Added/removed through deferred commands on selection changes, so cosmetics can resolve selection per chunk */
+USTRUCT() struct PDRTSBASE_API FPDMTag_Selected : public FMassTag { GENERATED_BODY(); };
 
 /** @brief MassFragment: SimpleMovementFragment */
 USTRUCT()
@@ -114,6 +116,60 @@ struct PDRTSBASE_API FPDMFragment_EntityAnimation : public FMassFragment
 	int AnimPosition = 0;
 };
 
+/** @brief Wander state, the wander scheduler assigns targets to entities that are awaiting one. See UPDWanderSubsystem */
+USTRUCT()
+struct PDRTSBASE_API FPDMFragment_Wander : public FMassFragment
+{
+	GENERATED_BODY()
+
+	/** @brief Location wander points are picked around, set the first time the entity wanders */
+	UPROPERTY()
+	FVector HomeLocation = FVector::ZeroVector;
+
+	/** @brief Wander radius around the home location */
+	UPROPERTY()
+	float Radius = 100.f;
+
+	/** @brief Distance to the wander point at which the move counts as done */
+	UPROPERTY()
+	float SuccessRadius = 100.f;
+
+	/** @brief Bumped for each scheduled decision, stale decisions left in the scheduler are discarded by it */
+	UPROPERTY()
+	uint32 DecisionSerial = 0;
+
+	/** @brief Has the home location been set */
+	UPROPERTY()
+	bool bHasHome = false;
+
+	/** @brief Is a wander task waiting on the scheduler for a target */
+	UPROPERTY()
+	bool bAwaitingTarget = false;
+
+	/** @brief Has the scheduler assigned a target to the running wander task */
+	UPROPERTY()
+	bool bHasTarget = false;
+};
+
+/** @brief Path following LOD state, see UPDPathLODSettings */
+USTRUCT()
+struct PDRTSBASE_API FPDMFragment_PathLOD : public FMassFragment
+{
+	GENERATED_BODY()
+
+	/** @brief World time of the last move target update, extrapolated steps cover the time since */
+	UPROPERTY()
+	double LastUpdateTime = 0.0;
+
+	/** @brief Speed the entity is extrapolated at, its desired speed from before it was hidden */
+	UPROPERTY()
+	float ExtrapolationSpeed = 0.f;
+
+	/** @brief Is the entity being moved in extrapolated steps, cleared and corrected when it comes into view */
+	UPROPERTY()
+	bool bExtrapolating = false;
+};
+
 /** @brief Target compound keeps track of the target, either a static location, a given actor and mass-entities*/
 USTRUCT(Blueprintable)
 struct PDRTSBASE_API FPDTargetCompound
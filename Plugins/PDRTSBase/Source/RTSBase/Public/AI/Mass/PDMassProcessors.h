@@ -8,12 +8,18 @@
 #include "MassRepresentationProcessor.h"
 #include "MassVisualizationLODProcessor.h"
 #include "MassSignalProcessorBase.h"
+#include "AI/Mass/PDMassAvoidance.h"
+#include "AI/Mass/PDMassPathLOD.h"
+#include "AI/Mass/PDMassSignals.h"
+#include "AI/Mass/PDMassWander.h"
 #include "PDMassProcessors.generated.h"
 
 struct FMassVelocityFragment;
 struct FPDMFragment_RTSEntityBase;
 class UMassCrowdRepresentationSubsystem;
 struct FMassMoveTargetFragment;
+struct FMassRepresentationLODFragment;
+struct FPDMFragment_PathLOD;
 struct FPDMFragment_EntityAnimation;
 class UMassSignalSubsystem;
 class UNavigationSystemV1;
@@ -45,6 +51,8 @@ using TMutSharedFragment = TFrag&;
  * @brief Moves the entities around to a given target, tasks have the responsibility to create actual multi-point paths
  * @note Executes before avoidance
  * @note Calculates shared navpaths for selection groups which have been marked as dirty
+ * @note Updates are staggered over an interval per representation LOD, entities that can not be seen are advanced in extrapolated steps
+ * and projected back onto the navmesh once they come into view. See UPDPathLODSettings
  */
 UCLASS()
 class PDRTSBASE_API UPDProcessor_MoveTarget : public UMassProcessor
@@ -58,15 +66,147 @@ public:
 	/* Macro helper to declare the required processor functions */
 	DECLARE_PROCESSOR_BODY
 
+	/**
+	 * @brief Applies path following LOD to a single entity
+	 * @return false if the entity is not due an update this frame
+	 * @note Hidden entities have their desired speed zeroed so steering leaves them be, it is restored once they come into view
+	 */
+	static bool ProcessPathLOD(
+		FPDMFragment_PathLOD& PathLOD,
+		const FMassRepresentationLODFragment& RepLOD,
+		FMassMoveTargetFragment& MoveTarget,
+		FTransform& Transform,
+		const FMassEntityHandle& Entity,
+		const UPDPathLODSettings& Settings,
+		const UNavigationSystemV1* NavSys,
+		double Now,
+		uint64 FrameCounter);
+
 private:
 	/** @brief Processors entity query,
-	 *  @requires FTransformFragment, FMassMoveTargetFragment, FMassSimulationVariableTickChunkFragment, FPDMFragment_SharedEntity*/
+	 *  @requires FTransformFragment, FMassMoveTargetFragment, FMassSimulationVariableTickChunkFragment, FPDMFragment_SharedEntity,
+	 *  (optional) FPDMFragment_PathLOD, FMassRepresentationLODFragment */
 	FMassEntityQuery EntityQuery;
 	
-	/** @brief Local Signal subsystem pointer
-	 * @note UPDProcessor_MoveTarget::Execute Calls SignalSubsystem->SignalEntities(UE::Mass::Signals::FollowPointPathDone, ..)
+	/** @brief Local signal aggregator pointer
+	 * @note UPDProcessor_MoveTarget::Execute Calls SignalAggregator->SignalEntities(UE::Mass::Signals::FollowPointPathDone, ..)
 	 * when entities has finished moving to their targets */
-	TObjectPtr<UMassSignalSubsystem> SignalSubsystem;
+	UPROPERTY()
+	TObjectPtr<UPDSignalAggregator> SignalAggregator = nullptr;
+};
+
+/**
+ * @brief Resolves due wander decisions from UPDWanderSubsystem, assigns each entity a point from its homes reachable point pool
+ * @note Only the entities that were given a point are signalled, idle wanderers cost nothing between decisions
+ * - Execution Order: Before 'UPDProcessor_MoveTarget'
+ */
+UCLASS()
+class PDRTSBASE_API UPDProcessor_WanderScheduler : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	/** @brief Sets execution order and execution flags, runs on the game-thread as point pools query the navigation system */
+	UPDProcessor_WanderScheduler();
+
+	/* Macro helper to declare the required processor functions */
+	DECLARE_PROCESSOR_BODY
+
+private:
+	/** @brief Declares the fragment access of the scheduler, decisions are resolved per entity through entity views,
+	 *  @requires FPDMFragment_Wander, FMassMoveTargetFragment, FTransformFragment */
+	FMassEntityQuery EntityQuery;
+
+	/** @brief Decisions popped this frame, kept to reuse the allocation */
+	TArray<FPDWanderDecision> DueDecisions;
+
+	/** @brief Local pointer to the wander subsystem, owns the decision wheel and point pools */
+	UPROPERTY()
+	TObjectPtr<UPDWanderSubsystem> WanderSubsystem = nullptr;
+
+	/** @brief Local signal aggregator pointer, wakes the state tree of entities given a point */
+	UPROPERTY()
+	TObjectPtr<UPDSignalAggregator> SignalAggregator = nullptr;
+};
+
+/**
+ * @brief Delivers the signals queued in UPDSignalAggregator, within the frames wakeup budget
+ * - Execution Order: Before 'UE::Mass::ProcessorGroupNames::Behavior'
+ */
+UCLASS()
+class PDRTSBASE_API UPDProcessor_SignalFlush : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	/** @brief Sets execution order and execution flags, runs on the game-thread as the signal subsystem is not thread-safe */
+	UPDProcessor_SignalFlush();
+
+	/* Macro helper to declare the required processor functions */
+	DECLARE_PROCESSOR_BODY
+
+private:
+	/** @brief Local signal aggregator pointer */
+	UPROPERTY()
+	TObjectPtr<UPDSignalAggregator> SignalAggregator = nullptr;
+};
+
+/**
+ * @brief Samples how long the state trees woken by the last flush took, feeds the aggregators wakeup cost estimate
+ * - Execution Order: After 'UE::Mass::ProcessorGroupNames::Behavior'
+ */
+UCLASS()
+class PDRTSBASE_API UPDProcessor_SignalCostSample : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	/** @brief Sets execution order and execution flags */
+	UPDProcessor_SignalCostSample();
+
+	/* Macro helper to declare the required processor functions */
+	DECLARE_PROCESSOR_BODY
+
+private:
+	/** @brief Local signal aggregator pointer */
+	UPROPERTY()
+	TObjectPtr<UPDSignalAggregator> SignalAggregator = nullptr;
+};
+
+/**
+ * @brief Neighbour-aware separation and predictive avoidance for RTS entities, adds its steering to FMassForceFragment
+ * @note Every RTS entity is bucketed as an obstacle each frame, only the entities due by their representation LOD interval steer
+ * @note Steering is budgeted per frame, highest LOD first. See UPDAvoidanceSettings
+ * - Execution Group: 'UE::Mass::ProcessorGroupNames::Avoidance', After 'UPDProcessor_MoveTarget'
+ */
+UCLASS()
+class PDRTSBASE_API UPDProcessor_LocalAvoidance : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	/** @brief Sets execution order and execution flags */
+	UPDProcessor_LocalAvoidance();
+
+	/* Macro helper to declare the required processor functions */
+	DECLARE_PROCESSOR_BODY
+
+private:
+	/** @brief Processors entity query,
+	 *  @requires FPDMTag_RTSEntity, FTransformFragment, FMassVelocityFragment, FMassForceFragment, (optional) FAgentRadiusFragment, (optional) FMassRepresentationLODFragment */
+	FMassEntityQuery EntityQuery;
+
+	/** @brief All agents gathered this frame, in query order */
+	FPDAvoidanceAgents Agents;
+	/** @brief Neighbour buckets over 'Agents' */
+	FPDAvoidanceGrid Grid;
+	/** @brief Agents due to steer this frame, per LOD (High, Medium, Low, Off) */
+	TArray<int32> DueAgents[4];
+	/** @brief Per LOD and stagger phase, position in 'DueAgents' to start steering from. Advanced past the last steered agent when the frame budget runs out.
+	 * Which agents are due is keyed on their entity index modulo the LOD interval, so the same due list only comes back with the same phase */
+	TArray<int32> DueAgentsStart[4];
+	/** @brief Resolved steering force per agent, written back in query order */
+	TArray<FVector2f> AgentForces;
 };
 
 /**
@@ -115,13 +255,14 @@ public:
 		const FMassInstancedStaticMeshInfoArrayView& MeshInfo,
 		const TArrayView<FMassInstancedStaticMeshInfo>& MeshInfoInnerArray,
 		const UPDMProcessor_EntityCosmetics* Self);
-	/** @brief Process material instance data injection */
+	/** @brief Process material instance data injection. 'bIsSelected' is resolved per chunk, from the FPDMTag_Selected tag */
 	static bool ProcessMaterialInstanceData(
 		const FMassEntityHandle& EntityHandle,
 		// const FMassRepresentationLODFragment& RepLOD,
 		const FMassRepresentationFragment& Rep,
 		FMassInstancedStaticMeshInfo& ISMInfo,
-		FPDMFragment_RTSEntityBase* RTSEntityFragment);
+		FPDMFragment_RTSEntityBase* RTSEntityFragment,
+		bool bIsSelected);
 
 	/** @brief Dispatch A2T data as batched custom data to the FMassInstancedStaticMeshInfo, passing it along to the ISM */
 	void UpdateISMVertexAnimation(FMassInstancedStaticMeshInfo& ISMInfo, FPDMFragment_EntityAnimation& AnimationData,
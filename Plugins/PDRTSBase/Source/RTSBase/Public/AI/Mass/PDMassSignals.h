@@ -0,0 +1,263 @@
+﻿/* @author: Ario Amin @ Permafrost Development. @copyright: Full BSL(1.1) License included at bottom of the file  */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "HAL/CriticalSection.h"
+#include "Engine/DeveloperSettings.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PDMassSignals.generated.h"
+
+class UMassSignalSubsystem;
+struct FMassEntityManager;
+
+/** @brief Signal aggregation developer settings, modify in .ini config or in editor project settings */
+UCLASS(Config = "Game", DefaultConfig)
+class PDRTSBASE_API UPDSignalSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UPDSignalSettings(){}
+
+	/** @brief If false every signal is forwarded straight to the mass signal subsystem */
+	UPROPERTY(Config, EditAnywhere, Category = "Signals")
+	bool bEnableAggregation = true;
+
+	/** @brief Time the woken state trees may spend per frame, deferrable wakeups past it wait for a later frame */
+	UPROPERTY(Config, EditAnywhere, Category = "Signals")
+	float WakeupBudgetMs = 2.0f;
+
+	/** @brief Cost of a single wakeup until it has been measured, in microseconds */
+	UPROPERTY(Config, EditAnywhere, Category = "Signals")
+	float InitialWakeupCostUs = 5.0f;
+
+	/** @brief Wakeups delivered per frame regardless of the budget, so a bad cost sample can not stall delivery */
+	UPROPERTY(Config, EditAnywhere, Category = "Signals")
+	int32 MinWakeupsPerFrame = 64;
+
+	/** @brief Frames a deferrable wakeup may wait before it is delivered regardless of the budget */
+	UPROPERTY(Config, EditAnywhere, Category = "Signals")
+	int32 MaxDeferFrames = 4;
+};
+
+/** @brief Signal urgency :: Enum class : uint8 */
+UENUM()
+enum class EPDSignalUrgency : uint8
+{
+	Immediate  = 0 UMETA(DisplayName="Immediate"),
+	Deferrable = 1 UMETA(DisplayName="Deferrable"),
+};
+
+/** @brief Aggregation counters */
+struct FPDSignalCounters
+{
+	/** @brief Entity wakeups handed to the mass signal subsystem */
+	uint64 Delivered = 0;
+	/** @brief Pending entities left for a later frame, counted once per frame they wait */
+	uint64 Deferred = 0;
+	/** @brief Signals folded into one already pending for the same entity */
+	uint64 Merged = 0;
+};
+
+/**
+ * @brief Sits in front of UMassSignalSubsystem for RTS entities.
+ * - Deduplicates signals per entity, repeated signals while one is pending are merged
+ * - Delivers deferrable signals under a per-frame wakeup budget, player-selected entities first then oldest first
+ * - Immediate signals bypass the budget
+ * @note Queueing is thread-safe, processors running off the game-thread may signal through it
+ * @note Flushed by UPDProcessor_SignalFlush ahead of the behaviour group, the wakeup cost is sampled by UPDProcessor_SignalCostSample after it
+ */
+UCLASS()
+class PDRTSBASE_API UPDSignalAggregator : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** @brief Shorthand to get the subsystem */
+	static UPDSignalAggregator* Get(const UObject* WorldContextObject);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** @brief Queues a signal for the entity */
+	void SignalEntity(FName SignalName, const FMassEntityHandle& Entity, EPDSignalUrgency Urgency = EPDSignalUrgency::Deferrable);
+	/** @brief Queues a signal for each of the entities */
+	void SignalEntities(FName SignalName, TConstArrayView<FMassEntityHandle> Entities, EPDSignalUrgency Urgency = EPDSignalUrgency::Deferrable);
+	/** @brief Queues a deferrable signal for the entity once 'DelaySeconds' has passed */
+	void DelaySignalEntity(FName SignalName, const FMassEntityHandle& Entity, float DelaySeconds);
+	/** @brief Queues a deferrable signal for each of the entities once 'DelaySeconds' has passed */
+	void DelaySignalEntities(FName SignalName, TConstArrayView<FMassEntityHandle> Entities, float DelaySeconds);
+
+	/** @brief Releases due delayed signals and delivers pending signals within this frames budget */
+	void Flush(const FMassEntityManager& EntityManager);
+	/** @brief Feeds the time the behaviour group took after the last flush into the wakeup cost estimate */
+	void SampleWakeupCost();
+
+	/** @brief Counters of the last flush */
+	const FPDSignalCounters& GetFrameCounters() const { return FrameCounters; }
+	/** @brief Counters since the subsystem was created */
+	const FPDSignalCounters& GetTotalCounters() const { return TotalCounters; }
+	/** @brief Current estimate of a single wakeups cost, in seconds */
+	double GetWakeupCostEstimate() const { return WakeupCostEstimate; }
+
+private:
+	/** @brief Signal waiting to be delivered */
+	struct FPendingSignal
+	{
+		TArray<FName, TInlineAllocator<2>> SignalNames;
+		uint64 QueuedFrame = 0;
+		bool bImmediate = false;
+	};
+	/** @brief Signal waiting on its delay */
+	struct FDelayedSignal
+	{
+		double DueTime = 0.0;
+		FName SignalName;
+		FMassEntityHandle Entity;
+	};
+
+	/** @brief Adds to the pending set, merging with an already pending entry for the entity, caller holds QueueLock */
+	void Enqueue(FName SignalName, const FMassEntityHandle& Entity, bool bImmediate);
+
+	/** @brief Guards the pending set and the delayed heap */
+	FCriticalSection QueueLock;
+
+	/** @brief Pending signals keyed by entity */
+	TMap<FMassEntityHandle, FPendingSignal> Pending;
+	/** @brief Min-heap on due time */
+	TArray<FDelayedSignal> Delayed;
+
+	/** @brief Scratch, entities ordered for delivery */
+	TArray<TPair<uint64 /*SortKey*/, FMassEntityHandle>> DeliveryOrder;
+	/** @brief Scratch, delivered entities grouped by signal */
+	TMap<FName, TArray<FMassEntityHandle>> DeliveryBatches;
+
+	FPDSignalCounters FrameCounters;
+	/** @brief Merges since the last flush, merges happen between flushes so they are tallied separately */
+	uint64 MergedSinceFlush = 0;
+	FPDSignalCounters TotalCounters;
+
+	/** @brief Smoothed cost of a single wakeup, in seconds */
+	double WakeupCostEstimate = 0.0;
+	/** @brief Platform time at the end of the last flush */
+	double LastFlushEndTime = 0.0;
+	/** @brief Wakeups handed out by the last flush */
+	int32 LastFlushDelivered = 0;
+
+	/** @brief Cached signal subsystem, the actual delivery mechanism */
+	UPROPERTY()
+	TObjectPtr<UMassSignalSubsystem> SignalSubsystem = nullptr;
+};
+
+/**
+Business Source License 1.1
+
+Parameters
+
+Licensor:             Ario Amin (@ Permafrost Development)
+Licensed Work:        RTSOpen (Source available on github)
+                      The Licensed Work is (c) 2024 Ario Amin (@ Permafrost Development)
+Additional Use Grant: You may make free use of the Licensed Work in a commercial product or service provided these three additional conditions as met; 
+                      1. Must give attributions to the original author of the Licensed Work, in 'Credits' if that is applicable.
+                      2. The Licensed Work must be Compiled before being redistributed.
+                      3. The Licensed Work Source may be linked but may not be packaged into the product or service being sold
+                      4. Must not be resold or repackaged or redistributed as another product, is only allowed to be used within a commercial or non-commercial game project.
+                      5. Teams with yearly budgets larger than 100000 USD must contact the owner for a custom license or buy the framework from a marketplace it has been made available on.
+
+                      "Credits" indicate a scrolling screen with attributions. This is usually in a products end-state
+
+                      "Package" means the collection of files distributed by the Licensor, and derivatives of that collection
+                      and/or of those files..   
+
+                      "Source" form means the source code, documentation source, and configuration files for the Package, usually in human-readable format.
+
+                      "Compiled" form means the compiled bytecode, object code, binary, or any other
+                      form resulting from mechanical transformation or translation of the Source form.
+
+Change Date:          2028-04-17
+
+Change License:       Apache License, Version 2.0
+
+For information about alternative licensing arrangements for the Software,
+please visit: https://permadev.se/
+
+Notice
+
+The Business Source License (this document, or the “License”) is not an Open
+Source license. However, the Licensed Work will eventually be made available
+under an Open Source License, as stated in this License.
+
+License text copyright (c) 2017 MariaDB Corporation Ab, All Rights Reserved.
+“Business Source License” is a trademark of MariaDB Corporation Ab.
+
+-----------------------------------------------------------------------------
+
+Business Source License 1.1
+
+Terms
+
+The Licensor hereby grants you the right to copy, modify, create derivative
+works, redistribute, and make non-production use of the Licensed Work. The
+Licensor may make an Additional Use Grant, above, permitting limited
+production use.
+
+Effective on the Change Date, or the fourth anniversary of the first publicly
+available distribution of a specific version of the Licensed Work under this
+License, whichever comes first, the Licensor hereby grants you rights under
+the terms of the Change License, and the rights granted in the paragraph
+above terminate.
+
+If your use of the Licensed Work does not comply with the requirements
+currently in effect as described in this License, you must purchase a
+commercial license from the Licensor, its affiliated entities, or authorized
+resellers, or you must refrain from using the Licensed Work.
+
+All copies of the original and modified Licensed Work, and derivative works
+of the Licensed Work, are subject to this License. This License applies
+separately for each version of the Licensed Work and the Change Date may vary
+for each version of the Licensed Work released by Licensor.
+
+You must conspicuously display this License on each original or modified copy
+of the Licensed Work. If you receive the Licensed Work in original or
+modified form from a third party, the terms and conditions set forth in this
+License apply to your use of that work.
+
+Any use of the Licensed Work in violation of this License will automatically
+terminate your rights under this License for the current and all other
+versions of the Licensed Work.
+
+This License does not grant you any right in any trademark or logo of
+Licensor or its affiliates (provided that you may use a trademark or logo of
+Licensor as expressly required by this License).
+
+TO THE EXTENT PERMITTED BY APPLICABLE LAW, THE LICENSED WORK IS PROVIDED ON
+AN “AS IS” BASIS. LICENSOR HEREBY DISCLAIMS ALL WARRANTIES AND CONDITIONS,
+EXPRESS OR IMPLIED, INCLUDING (WITHOUT LIMITATION) WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT, AND
+TITLE.
+
+MariaDB hereby grants you permission to use this License’s text to license
+your works, and to refer to it using the trademark “Business Source License”,
+as long as you comply with the Covenants of Licensor below.
+
+Covenants of Licensor
+
+In consideration of the right to use this License’s text and the “Business
+Source License” name and trademark, Licensor covenants to MariaDB, and to all
+other recipients of the licensed work to be provided by Licensor:
+
+1. To specify as the Change License the GPL Version 2.0 or any later version,
+   or a license that is compatible with GPL Version 2.0 or a later version,
+   where “compatible” means that software provided under the Change License can
+   be included in a program with software provided under GPL Version 2.0 or a
+   later version. Licensor may specify additional Change Licenses without
+   limitation.
+
+2. To either: (a) specify an additional grant of rights to use that does not
+   impose any additional restriction on the right granted in this License, as
+   the Additional Use Grant; or (b) insert the text “None”.
+
+3. To specify a Change Date.
+
+4. Not to modify this License in any other way.
+ **/
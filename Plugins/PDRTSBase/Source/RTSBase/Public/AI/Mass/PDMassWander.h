@@ -0,0 +1,206 @@
+﻿/* @author: Ario Amin @ Permafrost Development. @copyright: Full BSL(1.1) License included at bottom of the file  */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "Engine/DeveloperSettings.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PDMassWander.generated.h"
+
+/** @brief Wander scheduling developer settings, modify in .ini config or in editor project settings */
+UCLASS(Config = "Game", DefaultConfig)
+class PDRTSBASE_API UPDWanderSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UPDWanderSettings(){}
+
+	/** @brief Time span of a single scheduler bucket, decisions within the same bucket are resolved in the same frame */
+	UPROPERTY(Config, EditAnywhere, Category = "Wander")
+	double BucketDuration = 0.05;
+
+	/** @brief Amount of buckets in the scheduler wheel, decisions further ahead than BucketDuration * BucketCount are clamped to the last bucket */
+	UPROPERTY(Config, EditAnywhere, Category = "Wander")
+	int32 BucketCount = 256;
+
+	/** @brief Max wander decisions resolved per frame, the remainder carries over to the next frame */
+	UPROPERTY(Config, EditAnywhere, Category = "Wander")
+	int32 MaxDecisionsPerFrame = 256;
+
+	/** @brief Homes within the same cell of this size share a point pool */
+	UPROPERTY(Config, EditAnywhere, Category = "Wander")
+	double PoolCellSize = 1000.0;
+
+	/** @brief Reachable points generated per pool */
+	UPROPERTY(Config, EditAnywhere, Category = "Wander")
+	int32 PointsPerPool = 32;
+
+	/** @brief Time after a target is assigned at which the state tree is woken to re-evaluate, in case the entity never arrives */
+	UPROPERTY(Config, EditAnywhere, Category = "Wander")
+	float MoveTimeout = 10.f;
+};
+
+/** @brief Scheduled wander decision */
+struct FPDWanderDecision
+{
+	/** @brief Entity awaiting a target */
+	FMassEntityHandle Entity;
+	/** @brief Matches FPDMFragment_Wander::DecisionSerial unless the decision went stale */
+	uint32 Serial = 0;
+};
+
+/**
+ * @brief Wander scheduler, owns the decision time-wheel and the reachable point pools
+ * @note Wander tasks schedule a decision when they are entered, UPDProcessor_WanderScheduler pops the due decisions each frame
+ * and only wakes the entities it actually assigned a target to
+ */
+UCLASS()
+class PDRTSBASE_API UPDWanderSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** @brief Shorthand to get the subsystem */
+	static UPDWanderSubsystem* Get(const UObject* WorldContextObject);
+
+	/** @brief Schedules a decision for the entity at 'DecisionTime' (world seconds) */
+	void ScheduleDecision(const FMassEntityHandle& Entity, uint32 Serial, double DecisionTime);
+
+	/** @brief Pops decisions due at or before 'Now', at most 'MaxDecisions'. Anything left in a due bucket stays at the front for the next call */
+	void PopDueDecisions(double Now, int32 MaxDecisions, TArray<FPDWanderDecision>& OutDecisions);
+
+	/** @brief Reachable points around 'Home' within 'Radius'. Pools are built on first request and shared by all homes in the same pool cell
+	 *  @note Falls back to uniform points in the radius if the world has no navigation system */
+	const TArray<FVector>& FindOrBuildPointPool(const FVector& Home, float Radius);
+
+	/** @brief Drops all scheduled decisions and pools */
+	void Reset();
+
+private:
+	/** @brief Sizes the wheel from the settings and aligns the current slot to 'Now' */
+	void EnsureWheel(double Now);
+
+	/** @brief Decision wheel, slot 'CurrentSlot % Buckets.Num()' is the oldest */
+	TArray<TArray<FPDWanderDecision>> Buckets;
+	/** @brief Absolute slot index the wheel is currently at */
+	int64 CurrentSlot = INDEX_NONE;
+	/** @brief Cached from settings */
+	double BucketDuration = 0.05;
+
+	/** @brief Point pools, keyed by home cell X/Y and rounded radius */
+	TMap<FIntVector, TArray<FVector>> PointPools;
+};
+
+/**
+Business Source License 1.1
+
+Parameters
+
+Licensor:             Ario Amin (@ Permafrost Development)
+Licensed Work:        RTSOpen (Source available on github)
+                      The Licensed Work is (c) 2024 Ario Amin (@ Permafrost Development)
+Additional Use Grant: You may make free use of the Licensed Work in a commercial product or service provided these three additional conditions as met; 
+                      1. Must give attributions to the original author of the Licensed Work, in 'Credits' if that is applicable.
+                      2. The Licensed Work must be Compiled before being redistributed.
+                      3. The Licensed Work Source may be linked but may not be packaged into the product or service being sold
+                      4. Must not be resold or repackaged or redistributed as another product, is only allowed to be used within a commercial or non-commercial game project.
+                      5. Teams with yearly budgets larger than 100000 USD must contact the owner for a custom license or buy the framework from a marketplace it has been made available on.
+
+                      "Credits" indicate a scrolling screen with attributions. This is usually in a products end-state
+
+                      "Package" means the collection of files distributed by the Licensor, and derivatives of that collection
+                      and/or of those files..   
+
+                      "Source" form means the source code, documentation source, and configuration files for the Package, usually in human-readable format.
+
+                      "Compiled" form means the compiled bytecode, object code, binary, or any other
+                      form resulting from mechanical transformation or translation of the Source form.
+
+Change Date:          2028-04-17
+
+Change License:       Apache License, Version 2.0
+
+For information about alternative licensing arrangements for the Software,
+please visit: https://permadev.se/
+
+Notice
+
+The Business Source License (this document, or the “License”) is not an Open
+Source license. However, the Licensed Work will eventually be made available
+under an Open Source License, as stated in this License.
+
+License text copyright (c) 2017 MariaDB Corporation Ab, All Rights Reserved.
+“Business Source License” is a trademark of MariaDB Corporation Ab.
+
+-----------------------------------------------------------------------------
+
+Business Source License 1.1
+
+Terms
+
+The Licensor hereby grants you the right to copy, modify, create derivative
+works, redistribute, and make non-production use of the Licensed Work. The
+Licensor may make an Additional Use Grant, above, permitting limited
+production use.
+
+Effective on the Change Date, or the fourth anniversary of the first publicly
+available distribution of a specific version of the Licensed Work under this
+License, whichever comes first, the Licensor hereby grants you rights under
+the terms of the Change License, and the rights granted in the paragraph
+above terminate.
+
+If your use of the Licensed Work does not comply with the requirements
+currently in effect as described in this License, you must purchase a
+commercial license from the Licensor, its affiliated entities, or authorized
+resellers, or you must refrain from using the Licensed Work.
+
+All copies of the original and modified Licensed Work, and derivative works
+of the Licensed Work, are subject to this License. This License applies
+separately for each version of the Licensed Work and the Change Date may vary
+for each version of the Licensed Work released by Licensor.
+
+You must conspicuously display this License on each original or modified copy
+of the Licensed Work. If you receive the Licensed Work in original or
+modified form from a third party, the terms and conditions set forth in this
+License apply to your use of that work.
+
+Any use of the Licensed Work in violation of this License will automatically
+terminate your rights under this License for the current and all other
+versions of the Licensed Work.
+
+This License does not grant you any right in any trademark or logo of
+Licensor or its affiliates (provided that you may use a trademark or logo of
+Licensor as expressly required by this License).
+
+TO THE EXTENT PERMITTED BY APPLICABLE LAW, THE LICENSED WORK IS PROVIDED ON
+AN “AS IS” BASIS. LICENSOR HEREBY DISCLAIMS ALL WARRANTIES AND CONDITIONS,
+EXPRESS OR IMPLIED, INCLUDING (WITHOUT LIMITATION) WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT, AND
+TITLE.
+
+MariaDB hereby grants you permission to use this License’s text to license
+your works, and to refer to it using the trademark “Business Source License”,
+as long as you comply with the Covenants of Licensor below.
+
+Covenants of Licensor
+
+In consideration of the right to use this License’s text and the “Business
+Source License” name and trademark, Licensor covenants to MariaDB, and to all
+other recipients of the licensed work to be provided by Licensor:
+
+1. To specify as the Change License the GPL Version 2.0 or any later version,
+   or a license that is compatible with GPL Version 2.0 or a later version,
+   where “compatible” means that software provided under the Change License can
+   be included in a program with software provided under GPL Version 2.0 or a
+   later version. Licensor may specify additional Change Licenses without
+   limitation.
+
+2. To either: (a) specify an additional grant of rights to use that does not
+   impose any additional restriction on the right granted in this License, as
+   the Additional Use Grant; or (b) insert the text “None”.
+
+3. To specify a Change Date.
+
+4. Not to modify this License in any other way.
+ **/
@@ -5,6 +5,9 @@
 #include "MassEntityTypes.h"
 #include "MassStateTreeTypes.h"
 #include "PDRTSCommon.h"
+#include "PDRTSFlowField.h"
+#include "AI/Mass/PDMassWander.h"
+#include "AI/Mass/PDMassSignals.h"
 #include "AI/Mass/PDMassFragments.h"
 #include "PDMassTasks.generated.h"
 
@@ -91,6 +94,9 @@ struct FPDMTaskData_MoveToHandle
 	/** @brief Result of the candidates search request (Input) */
 	UPROPERTY(VisibleAnywhere, Category = "Data")
 	int16 CurrentNavPathIndex;
+
+	/** @brief Flow field of the entities selection group, only set if the group was large enough to be given one */
+	TSharedPtr<const FPDFlowField> FlowField;
 	
 	/** @brief Settings to control our parameters when we should abort a movement */
 	UPROPERTY(EditAnywhere, Category = "Data")
@@ -170,6 +176,8 @@ struct PDRTSBASE_API FPDMTask_MoveToTarget : public FMassStateTreeTaskBase
 	static void ProcessNewPriorityPath(const FPDMPathParameters& Params);
 	/** @brief Resolves the navpath at current path index for shared pathing, @bug Navpath generates invalid points, commented out for the moment, will resolve issue within a couple of commits */
 	static void ProcessNewSharedPath(const FPDMPathParameters& Params);
+	/** @brief Steers a cell and a half ahead along the instance datas flow field, heads straight for the target once in the goal cell, near its own target or if the field can not be sampled */
+	static void ProcessFlowFieldStep(const FPDMPathParameters& Params);
 	virtual void OnPathSelected(FPDMFragment_RTSEntityBase& RTSData, bool bShouldUseSharedNavigation, const FVector& LastPoint) const;
 
 	/* Links/handles */
@@ -199,14 +207,22 @@ struct FPDMTaskData_RandomWander
 	UPROPERTY(EditAnywhere, Category = Parameter)
 	float SuccessRadius = 100.f;
 
+	/** @brief Min delay before the wander scheduler assigns a point, value can be set from state-tree editor */
+	UPROPERTY(EditAnywhere, Category = Parameter)
+	float MinDecisionDelay = 1.f;
+
+	/** @brief Max delay before the wander scheduler assigns a point, value can be set from state-tree editor */
+	UPROPERTY(EditAnywhere, Category = Parameter)
+	float MaxDecisionDelay = 4.f;
+
 	/** @brief Settings to control our parameters when we should abort a movement */
 	UPROPERTY(EditAnywhere, Category = "Data")
 	FPDMStuckMovementConditions StuckMovementRules{};	
 };
 
 /**
- * @brief Task to move to a random target, either another entity or a world actor
- * @note Works by generating a random point for the movement processor to read from
+ * @brief Task to move to a random point around the entities home location
+ * @note Schedules a decision with UPDWanderSubsystem on enter and then sleeps, UPDProcessor_WanderScheduler assigns the point and wakes the state tree
  */
 USTRUCT()
 struct PDRTSBASE_API FPDMTask_RandomWander : public FMassStateTreeTaskBase
@@ -219,7 +235,8 @@ struct PDRTSBASE_API FPDMTask_RandomWander : public FMassStateTreeTaskBase
 	/* Links/handles */
 	TStateTreeExternalDataHandle<FMassMoveTargetFragment> MoveTargetHandle;
 	TStateTreeExternalDataHandle<FTransformFragment> TransformHandle;
-	TStateTreeExternalDataHandle<UMassSignalSubsystem> MassSignalSubsystemHandle;
+	TStateTreeExternalDataHandle<FPDMFragment_Wander> WanderHandle;
+	TStateTreeExternalDataHandle<UPDWanderSubsystem> WanderSubsystemHandle;
 };
 
 //
@@ -251,7 +268,7 @@ struct PDRTSBASE_API FPDMTask_Wait : public FMassStateTreeTaskBase
 
 protected:
 	/* Links/handles */
-	TStateTreeExternalDataHandle<UMassSignalSubsystem> MassSignalSubsystemHandle;
+	TStateTreeExternalDataHandle<UPDSignalAggregator> SignalAggregatorHandle;
 };
 
 
@@ -293,7 +310,7 @@ struct PDRTSBASE_API FPDMTask_PlayAnimation : public FMassStateTreeTaskBase
 protected:
 	/* Links/handles */
 	TStateTreeExternalDataHandle<FMassMoveTargetFragment> MoveTargetHandle;
-	TStateTreeExternalDataHandle<UMassSignalSubsystem> MassSignalSubsystemHandle;
+	TStateTreeExternalDataHandle<UPDSignalAggregator> SignalAggregatorHandle;
 	TStateTreeExternalDataHandle<FPDMFragment_EntityAnimation> AnimationHandle;
 };
 
@@ -4,8 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "GameplayTags.h"
+#include "Containers/StaticArray.h"
 #include "PDRTSCameraManager.generated.h"
 
+class UCurveFloat;
+
 /** @brief A simple struct which is acting as an intervals boundaries*/
 USTRUCT(BlueprintType, Blueprintable)
 struct PDRTSBASE_API FPDInterval
@@ -28,7 +31,7 @@ struct PDRTSBASE_API FPDInterval
  * - Controls the Cameras FOV
  * - Controls the Cameras near clip plane
  * - Custom camera lag
- * 
+ * - Blend-in time and curve, used when switching to this mode
  */
 USTRUCT(BlueprintType, Blueprintable)
 struct PDRTSBASE_API FPDCameraManagerSettings : public FTableRowBase
@@ -59,10 +62,18 @@ struct PDRTSBASE_API FPDCameraManagerSettings : public FTableRowBase
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Camera)
     double OrthoWidth = 0.0;
     
-	/** @brief Custom camera lag. Unused. */
+	/** @brief Custom camera lag. Exponential damping rate (1/s), 0 disables lag. Frame-rate independent */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Camera)
     double CameraLagSpeed = 0.0;
 
+	/** @brief Time in seconds to blend into this mode from the previous mode, 0 snaps */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Camera)
+    double BlendInTime = 0.0;
+
+	/** @brief Optional blend-in curve, maps normalized blend time [0,1] to blend alpha [0,1]. Linear if not set */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Camera)
+    TObjectPtr<UCurveFloat> BlendInCurve = nullptr;
+
 	/** @brief Revise if actually wanted */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Camera)
     double FadeAmount = -1.0;
@@ -72,6 +83,60 @@ struct PDRTSBASE_API FPDCameraManagerSettings : public FTableRowBase
     FLinearColor FadeColour;
 };
 
+/** @brief A camera mode compiled from its settings row into a flat parameter block. This is what the camera manager blends and applies */
+struct PDRTSBASE_API FPDCameraModeParams
+{
+	/** @brief Sample count of the baked blend-in curve */
+	static constexpr int32 BlendCurveSampleCount = 17;
+
+	double PitchMin = -89.0;
+	double PitchMax = 89.0;
+	double YawMin = 0.0;
+	double YawMax = 359.999;
+	double FOV = 90.0;
+	/** @brief 0 is Interpreted as Ortho view being disabled */
+	double OrthoWidth = 0.0;
+	double LagSpeed = 0.0;
+	/** @brief Negative is interpreted as the mode not touching the fade settings */
+	double FadeAmount = -1.0;
+	FLinearColor FadeColour = FLinearColor::Black;
+
+	double BlendInTime = 0.0;
+	/** @brief Blend-in curve baked at even intervals over [0,1], so blending never touches the curve asset */
+	TStaticArray<float, BlendCurveSampleCount> BlendInCurve{InPlace, 0.0f};
+
+	/** @brief Compiles a settings row, bakes its blend-in curve */
+	static FPDCameraModeParams Compile(const FPDCameraManagerSettings& Settings);
+	/** @brief Blends every parameter between 'From' and 'To'. Discrete parameters switch at the half-way point */
+	static FPDCameraModeParams Blend(const FPDCameraModeParams& From, const FPDCameraModeParams& To, double Alpha);
+	/** @brief Evaluates the baked blend-in curve at the normalized blend time */
+	double EvaluateBlendInCurve(double NormalizedTime) const;
+};
+
+/** @brief Blends from the currently applied camera mode parameters towards a target mode, over the target modes blend-in time and curve
+ * @note Progress is accumulated time, so the blend lands on the target after the same duration regardless of how it was stepped */
+struct PDRTSBASE_API FPDCameraModeBlend
+{
+	/** @brief Starts blending from the current parameters towards 'Target'. Snaps if 'Target' has no blend-in time */
+	void BlendTo(const FPDCameraModeParams& Target);
+	/** @brief Snaps to 'Target' */
+	void SnapTo(const FPDCameraModeParams& Target);
+	/** @brief Advances the blend. @return true if the current parameters changed */
+	bool Step(double DeltaTime);
+
+	/** @brief Is a blend in progress */
+	bool IsBlending() const { return Elapsed < Duration; }
+	/** @brief Blended parameters */
+	const FPDCameraModeParams& GetCurrent() const { return Current; }
+
+private:
+	FPDCameraModeParams From{};
+	FPDCameraModeParams To{};
+	FPDCameraModeParams Current{};
+	double Elapsed = 0.0;
+	double Duration = 0.0;
+};
+
 /** @brief The camera manager class. Gets settings from a settings datatable-row handle */
 UCLASS()
 class PDRTSBASE_API APDCameraManager : public APlayerCameraManager
@@ -85,20 +150,29 @@ public:
     virtual void OnConstruction(const FTransform& Transform) override;
 	/** @brief Calls Super::BeginPlay then proceeds to call 'ProcessTables' */
     virtual void BeginPlay() override;
+	/** @brief Unbinds from the settings tables */
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	/** @brief Sets the given mode and loads the settings for that mode */
     UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = Camera)
     void SetCustomMode(FGameplayTag Tag);
 
-	/** @brief Updates the RequestedCameraState and calls 'SetCustomMode' if it has changed */
+	/** @brief Updates the RequestedCameraState and calls 'SetCustomMode' if it has changed, then steps any active mode blend */
     virtual void UpdateCamera(float DeltaTime) override;
 
+	/** @brief Exponentially damps 'Current' towards 'Target'. Frame-rate independent, stepping twice with half the delta-time lands on the same result */
+	static FVector DampTowards(const FVector& Current, const FVector& Target, double DampingRate, double DeltaTime);
+
 protected:
 	/** @brief Updates the view-target with custom camera lag applied */
     virtual void UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime) override;
     
-	/** @brief Process all camera settings tables */
+	/** @brief Process all camera settings tables and compiles each mode into 'CompiledModes' */
     void ProcessTables();
+	/** @brief Bound to the settings tables, re-processes them and re-targets the active mode */
+    void OnSettingsTableChanged();
+	/** @brief Applies compiled (possibly blended) mode parameters to the camera */
+    void ApplyModeParams(const FPDCameraModeParams& Params);
     
 public:
 	/** @brief Camera settings handle. Points to the camera settings entry we want to apply to this manager. */
@@ -127,9 +201,18 @@ public:
 	/** @brief Map to associate a type tag with the rowname of the entry it was sourced from */
     TMap<FGameplayTag /*Type tag*/, FName /*Rowname*/> TagToRowname;
 
-	/** @brief Current lag velocity value. Use for the custom camera lag */
+	/** @brief Compiled camera modes, keyed by their mode tag */
+    TMap<FGameplayTag /*Type tag*/, FPDCameraModeParams> CompiledModes;
+	/** @brief Blend between the previous and the active camera mode */
+    FPDCameraModeBlend ModeBlend{};
+	/** @brief Has any mode been applied yet, the first one is snapped to */
+    bool bHasAppliedMode = false;
+
+	/** @brief Current lagged camera location. Use for the custom camera lag */
     UPROPERTY()
-    FVector CurrentLagVelocity{0.0,0.0,0.0};
+    FVector LaggedLocation{0.0,0.0,0.0};
+	/** @brief Has 'LaggedLocation' been initialized */
+    bool bHasLaggedLocation = false;
 };
 
 
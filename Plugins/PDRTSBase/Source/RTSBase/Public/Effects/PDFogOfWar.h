@@ -196,6 +196,14 @@ public:
 	TArray<TSoftObjectPtr<UDataTable>> SettingsTables{};	
 };
 
+/** @brief Associative maps of the fog of war settings tables, built off the game-thread and moved into 'UPDFogOfWarSubsystem' when ready */
+struct FPDFogOfWarTableData
+{
+	TMap<FGameplayTag /*Type tag*/, FPDFogOfWarSettings* /*SettingsRow*/> TagToSettings;
+	TMap<FGameplayTag /*Type tag*/, const UDataTable* /*Table*/> TagToTable;
+	TMap<FGameplayTag /*Type tag*/, FName /*Rowname*/> TagToRowname;
+};
+
 /** @brief The camera manager class. Gets settings from a settings datatable-row handle */
 UCLASS(BlueprintType)
 class PDRTSBASE_API UPDFogOfWarSubsystem : public UTickableWorldSubsystem
@@ -207,6 +215,8 @@ public:
 	
 	/** @brief Calls Super::BeginPlay then proceeds to call 'ProcessTables' */
 	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	/** @brief Releases our table ingestion */
+	virtual void Deinitialize() override;
 
 	/** @brief Ensures the that the world is not a client world, only server or single player worlds allowed */
 	bool HasCompleteAuthority() const;
@@ -234,8 +244,12 @@ public:
 
 
 protected:
-	/** @brief Process all camera settings tables */
+	/** @brief Requests the asynchronous ingestion of all fog of war settings tables, keyed by 'GetTableIngestionName' as there is one subsystem per world */
     void ProcessTables();
+	/** @brief Ingestion key, the subsystems path name. Is world-qualified, unlike the object name which is the same in every world */
+	FName GetTableIngestionName() const { return FName(*GetPathName()); }
+	/** @brief Builds the associative maps from the given tables. Runs on a worker thread */
+	static void BuildTableData(const TArray<UDataTable*>& Tables, FPDFogOfWarTableData& OutData);
     
 public:
 	/** @brief 'Fog of War settings' handle. Points to the settings entry we want to apply to this manager. */
@@ -20,14 +20,31 @@ class PDRTSBASE_API UPDBuilderSubsystem : public UEngineSubsystem
 	GENERATED_BODY()
 public:
 	/** @brief Shorthand to get the subsystem,
-	 * @note as the engine will instantiate these subsystem earlier than anything will reasonably call Get()  */
+	 * @note as the engine will instantiate these subsystem earlier than anything will reasonably call Get()
+	 * @note Flushes the table ingestion if it is called on the game-thread before the build tables have been processed */
 	static UPDBuilderSubsystem* Get();
 
-	void ProcessBuildContextTable(const TSoftObjectPtr<UDataTable>& TablePath);
+	/** @brief Ingests a single build table into the tag keyed maps. Broken row references are recorded in 'BrokenRowReferences' */
+	void ProcessBuildContextTable(UDataTable* BuildContextTable);
+	/** @brief Requests the asynchronous streaming of every table listed in the settings, processes them with 'ProcessAllBuildTables' when they are loaded */
+	void LoadAndProcessAllBuildTables(const UPDBuilderSubsystemSettings* Settings);
+	/** @brief Clears all previously ingested data, ingests the given tables and then bakes the lookup tables */
+	void ProcessAllBuildTables(const TArray<UDataTable*>& Tables);
+	/** @brief Clears all ingested table data and the baked lookup tables */
+	void ResetBuildTableData();
+	/** @brief Interns every ingested tag and flattens the context, worker and buildable relationships into 'LookupTables' */
+	void BakeLookupTables();
+	/** @brief Validation pass over the baked tables. Reports broken row references, contexts without workers and unbuildable buildables.
+	 * @return Amount of issues found */
+	int32 ValidateLookupTables() const;
 	/** @brief Loads the worktables when the subsystem initializes during engine startup, far earlier than any world exists.
 	 * It uses developer settings (UPDRTSSubsystemSettings) to read and write selected worktable paths via config, and or project settings window  
 	 */
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	/** @brief Unbinds from world cleanup */
+	virtual void Deinitialize() override;
+	/** @brief Bound to FWorldDelegates::OnWorldCleanup. Drops the cleaned up worlds occupancy grid */
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
 	
 	/** @brief Bound to the given developer setting. Resolved the paths into actual tables which we cache to via hash maps */
 	void OnDeveloperSettingsChanged(UObject* SettingsToChange, FPropertyChangedEvent& PropertyEvent);
@@ -48,6 +65,17 @@ public:
 
 	/** @brief Returns the default Buildable data via it's Buildable-tag*/
 	static const FPDBuildWorker* GetWorkerDataStatic(const FGameplayTag& WorkerTag);	
+
+	/** @brief Returns the interned index of a buildable, build context or worker tag. INDEX_NONE if the tag is not known to the build tables */
+	int32 GetBuildTagIndex(const FGameplayTag& Tag) const;
+	/** @brief Returns the interned indices of the worker types that may build the buildable at the given index */
+	TConstArrayView<int32> GetValidWorkerIndices(const int32 BuildableIdx) const;
+	/** @brief Array lookup, may the worker at the given index build the buildable at the given index */
+	bool IsWorkerValidForBuildable(const int32 WorkerIdx, const int32 BuildableIdx) const;
+	/** @brief May the worker type build the buildable */
+	bool IsWorkerValidForBuildable(const FGameplayTag& WorkerTag, const FGameplayTag& BuildableTag) const;
+	/** @brief Writes the worker types that may build the buildable into OutWorkerTypes */
+	void GetValidWorkerTypes(const FGameplayTag& BuildableTag, TArray<FGameplayTag>& OutWorkerTypes) const;
 	
 	/** @brief Queue a removal from the buildable octree */
 	void QueueRemoveFromWorldBuildTree(int32 UID);
@@ -72,6 +100,24 @@ public:
 	/** @brief Reserved */
 	void WorldInit(const UWorld* World);
 
+	/** @brief Returns the occupancy grid of the world, creates it if needed. Cells are sized and aligned as the hash grid */
+	FPDBuildOccupancyGrid& GetOccupancyGrid(const UWorld* World);
+	/** @brief Adds the occupant to its worlds occupancy grid, or moves it if it is already in the grid. Uses the bounds of the occupants components, colliding or not, as ghosts may have their collision disabled */
+	UFUNCTION(BlueprintCallable, Category = "Actor|Ghost")
+	void RegisterOccupant(const AActor* Occupant);
+	/** @brief Re-reads the bounds of an occupant that is already in its worlds occupancy grid, call after its mesh has changed.
+	 * Occupants that are not in the grid, such as preview ghosts, are left out of it */
+	UFUNCTION(BlueprintCallable, Category = "Actor|Ghost")
+	void RefreshOccupant(const AActor* Occupant);
+	/** @brief Removes the occupant from the occupancy grids */
+	UFUNCTION(BlueprintCallable, Category = "Actor|Ghost")
+	void DeregisterOccupant(const AActor* Occupant);
+	/** @brief Removes the occupant from the occupancy grids by ID. Safe to call when the occupant has no world anymore */
+	void DeregisterOccupantByID(const int32 OccupantID);
+	/** @brief Tests the footprint against the worlds occupancy grid, writes one result per cell into OutCells.
+	 * @return True if the placement is legal, i.e. no cell of the footprint is blocked */
+	bool ValidatePlacement(const UWorld* World, const FBox& Footprint, TArray<FPDBuildFootprintCell>& OutCells);
+
 
 	/** @brief Tell the subsystem we won't allow direct changes to WorldBuildActorArrays (Lists of users and their buildable actor arrays),
 	 * and that we might be processing select removals of actual buildables  */
@@ -127,6 +173,15 @@ public:
 	/** @brief Mapped for fast access. Mapped upon subsystem loading the developer settings 'UPDRTSSubsystemSettings' */
 	TMap<FPDBuildableData*, FGameplayTag> BuildableData_WTagReverse{};	
 
+	/** @brief Deduplicated, index addressed tables baked from the maps above after all build tables have been ingested */
+	FPDBuildLookupTables LookupTables{};
+	/** @brief Row references that failed to resolve while ingesting the build tables, reported by 'ValidateLookupTables' */
+	TArray<FString> BrokenRowReferences{};
+	/** @brief Have the streamed build tables been processed */
+	bool bHasProcessedBuildTables = false;
+	/** @brief Name of our build table ingestion */
+	inline static const FName TableIngestionName = TEXT("PDBuilderSubsystem");
+
 	
 	/** @brief The actual octree our buildable actors will make use of*/
 	PD::Mass::Actor::Octree WorldBuildActorOctree;
@@ -157,6 +212,11 @@ public:
 	/** @brief  Queued additions of user actor arrays, additions requested while our auxiliary async task in 'UPDOctreeProcessor::Execute' is iterating 'WorldBuildActorArrays'  */
 	TDeque<TTuple<int32, void*>> QueuedAdditions_BuildablesArrayPointers{};
 	
+	/** @brief Occupancy grid per world, maintained incrementally as occupants register, move and deregister */
+	TMap<const UWorld*, FPDBuildOccupancyGrid> OccupancyGrids{};
+	/** @brief Handle for the world cleanup binding */
+	FDelegateHandle WorldCleanupHandle;
+	
 	/** @brief Tracking worlds that has been setup with this WorldOctree.  */
 	TMap<void*, bool> WorldsWithOctrees{};
 
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "PDRTSSharedOctree.h"
+#include "PDRTSFlowField.h"
 #include "AI/Mass/PDMassFragments.h"
 
 #include "Tickable.h"
@@ -27,6 +28,15 @@ class UTextureRenderTarget2D;
 struct FPDWorkUnitDatum;
 
 
+/** @brief Derived lookup data of the work tables, built off the game-thread and moved into 'UPDRTSBaseSubsystem' when ready */
+struct FPDWorkTableData
+{
+	TMap<const FGameplayTag, const FPDWorkUnitDatum*> TagToJobMap{};
+	TMap<const FName, FGameplayTag> NameToTagMap{};
+	TMap<const FGameplayTag, FName> TagToNameMap{};
+	TMap<const FGameplayTag, const UDataTable*> TagToTable{};
+};
+
 DECLARE_DELEGATE_SevenParams(FRTSBuildGlobalSortEntityShader, FRHICommandListImmediate& /*RHICmdList*/, UTextureRenderTarget2D* /*RenderTarget*/, const TRefCountPtr<FRDGPooledBuffer>& /*EntityInputPooledBuffer*/, TArray<FLinearColor> /*InData*/, float /* CameraYawInRadians */ , FVector /*RegionMin*/, FVector /*RegionSize*/)
 
 /** @brief RTS Subsystem 
@@ -74,16 +84,22 @@ public:
 	UFUNCTION()
 	void DispatchOctreeGeneration();
 	
-	/** @brief Bound to the given developer setting. Resolved the paths into actual WorkTables Array */
+	/** @brief Bound to the given developer setting. Re-ingests the work tables */
 	void OnDeveloperSettingsChanged(UObject* SettingsToChange, FPropertyChangedEvent& PropertyEvent);
 
-	/** @brief Processes the tables in 'WorkTables' and fills a number of maps for fast lookups downstream for entity jobs and such */
+	/** @brief Processes the tables in 'WorkTables' and fills a number of maps for fast lookups downstream for entity jobs and such.
+	 * @note Synchronous, used when an already ingested table changes */
 	UFUNCTION()
 	void ProcessTables();
 
-	/** @brief Loads tables into 'WorkTables' and calls ProcessTables */
+	/** @brief Requests the asynchronous ingestion of the work tables, which fills 'WorkTables' and the lookup maps when ready */
 	UFUNCTION()
 	void LoadAndProcessTables();
+
+	/** @brief Builds the lookup maps from the given work tables. Thread-safe, is run on a worker thread during ingestion */
+	static void BuildWorkTableData(const TArray<UDataTable*>& Tables, FPDWorkTableData& OutData);
+	/** @brief Moves the built lookup maps in place. Runs on the game-thread */
+	void PublishWorkTableData(const TArray<UDataTable*>& Tables, FPDWorkTableData&& Data);
 	
 	/** @brief Requests to generate a navpath for the selection group to the given target*/
 	UFUNCTION()
@@ -92,6 +108,20 @@ public:
 		int32 SelectionGroup,
 		const FVector& SelectionCenter,
 		const FPDTargetCompound& TargetCompound);
+
+	/** @brief Requests to build a flow field for the selection group towards the given target, replaces any shared navpath the group had
+	 *  @note Grid covers the selection center and the target plus 'UPDFlowFieldSettings::GridPadding' */
+	virtual void RequestFlowFieldForSelectionGroup(
+		int32 OwnerID,
+		int32 SelectionGroup,
+		const FVector& SelectionCenter,
+		const FPDTargetCompound& TargetCompound);
+
+	/** @brief Returns the flow field of the selection group, if it has one */
+	TSharedPtr<const FPDFlowField> FindSelectionGroupFlowField(int32 OwnerID, int32 SelectionGroup) const;
+
+	/** @brief Resolves the world location of the target compound, actor before entity before static location */
+	FVector ResolveTargetLocation(const FPDTargetCompound& TargetCompound) const;
 	
 	/** @brief Returns the default work data via it's job-tag*/
 	const FPDWorkUnitDatum* GetWorkEntry(const FGameplayTag& JobTag);
@@ -153,6 +183,9 @@ public:
 	 *  @todo think on a solution which marks which actual data we want to update for the group, but this for now works as a solid enough optimization
 	 */
 	TArray<TTuple<int32 /*OwnerID*/, int32/*Player 'Selection-group' Index */> > DirtySharedData{};
+
+	/** @brief Selection group flow fields, keyed by owner ID and selection group index. Shared so running move tasks keep a field alive after it has been replaced */
+	TMap<TTuple<int32 /*OwnerID*/, int32/*Player 'Selection-group' Index */>, TSharedPtr<const FPDFlowField>> SelectionGroupFlowFields{};
 	
 	/** @brief Map for fast lookups. Keyed by job-tag, valued by default data entry */
 	TMap<const FGameplayTag, const FPDWorkUnitDatum*> TagToJobMap{};
@@ -174,6 +207,9 @@ public:
 	/** @brief Reserved for later use */
 	FStreamableManager DataStreamer;
 
+	/** @brief Name of our work table ingestion */
+	inline static const FName TableIngestionName = TEXT("PDRTSBaseSubsystem");
+
 	/** @brief Cached entity manager ptr*/
 	const FMassEntityManager* EntityManager = nullptr;
 
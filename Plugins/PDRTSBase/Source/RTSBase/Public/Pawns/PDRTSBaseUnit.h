@@ -64,9 +64,17 @@ public:
 		int32 CallingOwnerID,
 		const FPDTargetCompound& TargetCompound,
 		const FGameplayTag& RequestedJob,
-		const TMap<int32, FMassEntityHandle>& EntityHandleMap,
+		TConstArrayView<FMassEntityHandle>    EntityHandles,
 		const FVector&                        SelectionCenter,
 		int32 SelectionGroup = INDEX_NONE);
+
+	/** @brief Spreads a group move order over formation slots around the target location, each entity is requested to move to its own slot
+	 *  @note Called by RequestActionMulti for plain location targets, see UPDFormationSettings */
+	void DispatchFormationMove(
+		int32 CallingOwnerID,
+		const FPDTargetCompound& TargetCompound,
+		const FGameplayTag& RequestedJob,
+		TConstArrayView<FMassEntityHandle>    EntityHandles);
 	
 	/** @brief Assigns the entity manager for the world we are in, so we can refer to it and modify fragments when needed */
 	FORCEINLINE void SetEntityManager(const FMassEntityManager* InEntityManager) { EntityManager = InEntityManager;}
@@ -0,0 +1,242 @@
+﻿/* @author: Ario Amin @ Permafrost Development. @copyright: Full BSL(1.1) License included at bottom of the file  */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataTable.h"
+#include "Engine/StreamableManager.h"
+#include "Tasks/Task.h"
+
+/** @brief Ingestion states: [STREAMING, BUILDING, READY] */
+enum class EPDTableIngestionState : uint8
+{
+	STREAMING, /**< @brief Tables are being streamed in */
+	BUILDING,  /**< @brief Tables are loaded, derived data is being built on a worker thread */
+	READY,     /**< @brief Derived data has been published to the consumer */
+};
+
+/** @brief Startup timings of a single ingestion, in seconds. Reported by 'FPDTableIngestion::LogTimingReport' */
+struct FPDTableIngestionTimings
+{
+	/** @brief Time spent streaming the tables */
+	double StreamSeconds = 0.0;
+	/** @brief Time spent building derived data, on a worker thread */
+	double BuildSeconds = 0.0;
+	/** @brief Time spent publishing derived data, on the game-thread */
+	double PublishSeconds = 0.0;
+	/** @brief Time from request to being ready */
+	double TotalSeconds = 0.0;
+	/** @brief Was this ingestion flushed by a consumer that could not wait for it */
+	bool bWasFlushed = false;
+};
+
+/**
+ * @brief Shared asynchronous DataTable ingestion.
+ * @details Consumers register a named ingestion with a list of soft table references. The tables are streamed in,
+ * the consumers 'Build' function is run on a worker thread to build derived lookup data,
+ * and the consumers 'Publish' function is then called on the game-thread to swap that data in, in one go.
+ * @note 'Build' must only read from the tables, the tables are kept loaded by the ingestion for as long as it is registered
+ * @note All functions, bar 'Build', are expected to be called on the game-thread 
+ */
+class PDSHAREDUI_API FPDTableIngestion
+{
+public:
+	/** @brief Builds derived data from the tables. Called on a worker thread */
+	using FBuildFunction = TUniqueFunction<void(const TArray<UDataTable*>& /*Tables*/)>;
+	/** @brief Publishes the derived data. Called on the game-thread */
+	using FPublishFunction = TUniqueFunction<void(const TArray<UDataTable*>& /*Tables*/)>;
+
+	/** @brief Shared instance */
+	static FPDTableIngestion& Get();
+
+	/** @brief Starts (or restarts) the named ingestion. A restart discards any results of the previous, still in-flight, request */
+	void Ingest(FName ConsumerName, const TArray<TSoftObjectPtr<UDataTable>>& TablePaths, FBuildFunction&& Build, FPublishFunction&& Publish);
+
+	/** @brief Typed variant, 'Build' fills a fresh 'TBuildResult' on a worker thread and 'Publish' receives it by rvalue to move it into place */
+	template<typename TBuildResult>
+	void Ingest(
+		FName ConsumerName,
+		const TArray<TSoftObjectPtr<UDataTable>>& TablePaths,
+		TUniqueFunction<void(const TArray<UDataTable*>& /*Tables*/, TBuildResult& /*OutResult*/)>&& Build,
+		TUniqueFunction<void(const TArray<UDataTable*>& /*Tables*/, TBuildResult&& /*Result*/)>&& Publish)
+	{
+		const TSharedRef<TBuildResult> Result = MakeShared<TBuildResult>();
+		Ingest(
+			ConsumerName,
+			TablePaths,
+			[Result, InnerBuild = MoveTemp(Build)](const TArray<UDataTable*>& Tables) mutable { InnerBuild(Tables, *Result); },
+			[Result, InnerPublish = MoveTemp(Publish)](const TArray<UDataTable*>& Tables) mutable { InnerPublish(Tables, MoveTemp(*Result)); });
+	}
+
+	/** @brief Blocks until the named ingestion has been published. For consumers whose data is requested before it is ready */
+	void Flush(FName ConsumerName);
+	/** @brief Drops the named ingestion, discards in-flight results and releases the tables */
+	void Release(FName ConsumerName);
+
+	/** @brief Is the named ingestion published */
+	bool IsReady(FName ConsumerName) const;
+	/** @brief Calls 'Callback' once the named ingestion has been published, immediately if it already has been */
+	void OnReady(FName ConsumerName, TUniqueFunction<void()>&& Callback);
+
+	/** @brief Returns the timings of the named ingestion, nullptr if it was never requested */
+	const FPDTableIngestionTimings* GetTimings(FName ConsumerName) const;
+	/** @brief Logs the timings of every ingestion. Is called once by itself when the first set of ingestions has been published */
+	void LogTimingReport() const;
+
+private:
+	/** @brief Book-keeping of a single named ingestion */
+	struct FEntry
+	{
+		FName ConsumerName = NAME_None;
+		/** @brief Unique per request, stale callbacks compare against it */
+		uint32 Generation = 0;
+		EPDTableIngestionState State = EPDTableIngestionState::STREAMING;
+		
+		TArray<TSoftObjectPtr<UDataTable>> TablePaths{};
+		TArray<UDataTable*> Tables{};
+		/** @brief Keeps the tables loaded */
+		TSharedPtr<FStreamableHandle> StreamHandle = nullptr;
+		UE::Tasks::FTask BuildTask{};
+		
+		FBuildFunction Build{};
+		FPublishFunction Publish{};
+		TArray<TUniqueFunction<void()>> ReadyCallbacks{};
+
+		double RequestTime = 0.0;
+		double StreamedTime = 0.0;
+		double BuiltTime = 0.0;
+		FPDTableIngestionTimings Timings{};
+	};
+
+	/** @brief Stream completion, resolves the tables and launches the build task */
+	void OnStreamed(FName ConsumerName, uint32 Generation);
+	/** @brief Build completion, dispatched back onto the game-thread */
+	void OnBuilt(FName ConsumerName, uint32 Generation);
+	/** @brief Publishes the built data and fires the readiness callbacks */
+	void PublishEntry(FEntry& Entry);
+
+	/** @brief Finds the entry if it still is on the given generation */
+	TSharedPtr<FEntry> FindEntry(FName ConsumerName, uint32 Generation) const;
+
+	/** @brief All registered ingestions */
+	TMap<FName, TSharedRef<FEntry>> Entries{};
+	/** @brief Streams the tables */
+	FStreamableManager StreamableManager{};
+	/** @brief Source of the entry generations */
+	uint32 GenerationCounter = 0;
+	/** @brief Has the startup report been logged */
+	bool bHasLoggedStartupReport = false;
+};
+
+/**
+Business Source License 1.1
+
+Parameters
+
+Licensor:             Ario Amin (@ Permafrost Development)
+Licensed Work:        RTSOpen (Source available on github)
+                      The Licensed Work is (c) 2024 Ario Amin (@ Permafrost Development)
+Additional Use Grant: You may make free use of the Licensed Work in a commercial product or service provided these three additional conditions as met; 
+                      1. Must give attributions to the original author of the Licensed Work, in 'Credits' if that is applicable.
+                      2. The Licensed Work must be Compiled before being redistributed.
+                      3. The Licensed Work Source may be linked but may not be packaged into the product or service being sold
+                      4. Must not be resold or repackaged or redistributed as another product, is only allowed to be used within a commercial or non-commercial game project.
+                      5. Teams with yearly budgets larger than 100000 USD must contact the owner for a custom license or buy the framework from a marketplace it has been made available on.
+
+                      "Credits" indicate a scrolling screen with attributions. This is usually in a products end-state
+
+                      "Package" means the collection of files distributed by the Licensor, and derivatives of that collection
+                      and/or of those files..   
+
+                      "Source" form means the source code, documentation source, and configuration files for the Package, usually in human-readable format.
+
+                      "Compiled" form means the compiled bytecode, object code, binary, or any other
+                      form resulting from mechanical transformation or translation of the Source form.
+
+Change Date:          2028-04-17
+
+Change License:       Apache License, Version 2.0
+
+For information about alternative licensing arrangements for the Software,
+please visit: https://permadev.se/
+
+Notice
+
+The Business Source License (this document, or the “License”) is not an Open
+Source license. However, the Licensed Work will eventually be made available
+under an Open Source License, as stated in this License.
+
+License text copyright (c) 2017 MariaDB Corporation Ab, All Rights Reserved.
+“Business Source License” is a trademark of MariaDB Corporation Ab.
+
+-----------------------------------------------------------------------------
+
+Business Source License 1.1
+
+Terms
+
+The Licensor hereby grants you the right to copy, modify, create derivative
+works, redistribute, and make non-production use of the Licensed Work. The
+Licensor may make an Additional Use Grant, above, permitting limited
+production use.
+
+Effective on the Change Date, or the fourth anniversary of the first publicly
+available distribution of a specific version of the Licensed Work under this
+License, whichever comes first, the Licensor hereby grants you rights under
+the terms of the Change License, and the rights granted in the paragraph
+above terminate.
+
+If your use of the Licensed Work does not comply with the requirements
+currently in effect as described in this License, you must purchase a
+commercial license from the Licensor, its affiliated entities, or authorized
+resellers, or you must refrain from using the Licensed Work.
+
+All copies of the original and modified Licensed Work, and derivative works
+of the Licensed Work, are subject to this License. This License applies
+separately for each version of the Licensed Work and the Change Date may vary
+for each version of the Licensed Work released by Licensor.
+
+You must conspicuously display this License on each original or modified copy
+of the Licensed Work. If you receive the Licensed Work in original or
+modified form from a third party, the terms and conditions set forth in this
+License apply to your use of that work.
+
+Any use of the Licensed Work in violation of this License will automatically
+terminate your rights under this License for the current and all other
+versions of the Licensed Work.
+
+This License does not grant you any right in any trademark or logo of
+Licensor or its affiliates (provided that you may use a trademark or logo of
+Licensor as expressly required by this License).
+
+TO THE EXTENT PERMITTED BY APPLICABLE LAW, THE LICENSED WORK IS PROVIDED ON
+AN “AS IS” BASIS. LICENSOR HEREBY DISCLAIMS ALL WARRANTIES AND CONDITIONS,
+EXPRESS OR IMPLIED, INCLUDING (WITHOUT LIMITATION) WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT, AND
+TITLE.
+
+MariaDB hereby grants you permission to use this License’s text to license
+your works, and to refer to it using the trademark “Business Source License”,
+as long as you comply with the Covenants of Licensor below.
+
+Covenants of Licensor
+
+In consideration of the right to use this License’s text and the “Business
+Source License” name and trademark, Licensor covenants to MariaDB, and to all
+other recipients of the licensed work to be provided by Licensor:
+
+1. To specify as the Change License the GPL Version 2.0 or any later version,
+   or a license that is compatible with GPL Version 2.0 or a later version,
+   where “compatible” means that software provided under the Change License can
+   be included in a program with software provided under GPL Version 2.0 or a
+   later version. Licensor may specify additional Change Licenses without
+   limitation.
+
+2. To either: (a) specify an additional grant of rights to use that does not
+   impose any additional restriction on the right granted in this License, as
+   the Additional Use Grant; or (b) insert the text “None”.
+
+3. To specify a Change Date.
+
+4. Not to modify this License in any other way.
+ **/
@@ -0,0 +1,327 @@
+﻿/* @author: Ario Amin @ Permafrost Development. @copyright: Full BSL(1.1) License included at bottom of the file  */
+
+#include "PDTableIngestion.h"
+#include "PDUIBaseDefinitions.h"
+
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+
+FPDTableIngestion& FPDTableIngestion::Get()
+{
+	static FPDTableIngestion Self;
+	return Self;
+}
+
+void FPDTableIngestion::Ingest(FName ConsumerName, const TArray<TSoftObjectPtr<UDataTable>>& TablePaths, FBuildFunction&& Build, FPublishFunction&& Publish)
+{
+	check(IsInGameThread())
+
+	const TSharedRef<FEntry> Entry = MakeShared<FEntry>();
+	Entry->ConsumerName = ConsumerName;
+	Entry->TablePaths = TablePaths;
+	Entry->Build = MoveTemp(Build);
+	Entry->Publish = MoveTemp(Publish);
+	Entry->RequestTime = FPlatformTime::Seconds();
+	Entry->Generation = ++GenerationCounter;
+
+	// Restarting, carry over anyone still waiting on the previous request
+	if (const TSharedRef<FEntry>* PreviousEntry = Entries.Find(ConsumerName))
+	{
+		if ((*PreviousEntry)->State != EPDTableIngestionState::READY)
+		{
+			Entry->ReadyCallbacks = MoveTemp((*PreviousEntry)->ReadyCallbacks);
+		}
+		if ((*PreviousEntry)->StreamHandle.IsValid()) { (*PreviousEntry)->StreamHandle->CancelHandle(); }
+	}
+	Entries.Emplace(ConsumerName, Entry);
+
+	TArray<FSoftObjectPath> AssetPaths;
+	for (const TSoftObjectPtr<UDataTable>& TablePath : TablePaths)
+	{
+		if (TablePath.IsNull()) { continue; }
+		AssetPaths.AddUnique(TablePath.ToSoftObjectPath());
+	}
+
+	const uint32 Generation = Entry->Generation;
+	if (AssetPaths.IsEmpty())
+	{
+		OnStreamed(ConsumerName, Generation);
+		return;
+	}
+
+	Entry->StreamHandle = StreamableManager.RequestAsyncLoad(
+		AssetPaths,
+		FStreamableDelegate::CreateRaw(this, &FPDTableIngestion::OnStreamed, ConsumerName, Generation));
+}
+
+void FPDTableIngestion::OnStreamed(FName ConsumerName, uint32 Generation)
+{
+	const TSharedPtr<FEntry> Entry = FindEntry(ConsumerName, Generation);
+	if (Entry.IsValid() == false || Entry->State != EPDTableIngestionState::STREAMING) { return; }
+
+	Entry->StreamedTime = FPlatformTime::Seconds();
+	Entry->State = EPDTableIngestionState::BUILDING;
+	Entry->Tables.Reset();
+	for (const TSoftObjectPtr<UDataTable>& TablePath : Entry->TablePaths)
+	{
+		UDataTable* Table = TablePath.Get();
+		if (Table == nullptr)
+		{
+			UE_LOG(PDLog_SharedUI, Error, TEXT("FPDTableIngestion(%s) -- Failed to load table (%s), skipping it"), *ConsumerName.ToString(), *TablePath.ToString())
+			continue;
+		}
+		Entry->Tables.Emplace(Table);
+	}
+
+	// The entry is captured by the task, it outlives a restart or release that happens while it is still building 
+	Entry->BuildTask = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[Entry, ConsumerName, Generation]()
+		{
+			Entry->Build(Entry->Tables);
+			Entry->BuiltTime = FPlatformTime::Seconds();
+			AsyncTask(ENamedThreads::GameThread, [ConsumerName, Generation]() { Get().OnBuilt(ConsumerName, Generation); });
+		});
+}
+
+void FPDTableIngestion::OnBuilt(FName ConsumerName, uint32 Generation)
+{
+	const TSharedPtr<FEntry> Entry = FindEntry(ConsumerName, Generation);
+	if (Entry.IsValid() == false || Entry->State != EPDTableIngestionState::BUILDING) { return; }
+
+	PublishEntry(*Entry);
+}
+
+void FPDTableIngestion::PublishEntry(FEntry& Entry)
+{
+	// Marked ready before publishing, a consumer that flushes from within its own 'Publish' is a no-op rather than a second publish 
+	const double PublishStartTime = FPlatformTime::Seconds();
+	Entry.State = EPDTableIngestionState::READY;
+	Entry.Publish(Entry.Tables);
+
+	const double PublishEndTime = FPlatformTime::Seconds();
+	Entry.Timings.StreamSeconds = Entry.StreamedTime - Entry.RequestTime;
+	Entry.Timings.BuildSeconds = Entry.BuiltTime - Entry.StreamedTime;
+	Entry.Timings.PublishSeconds = PublishEndTime - PublishStartTime;
+	Entry.Timings.TotalSeconds = PublishEndTime - Entry.RequestTime;
+
+	// Callbacks may register new callbacks or restart ingestions, swap them out first 
+	TArray<TUniqueFunction<void()>> ReadyCallbacks = MoveTemp(Entry.ReadyCallbacks);
+	Entry.ReadyCallbacks.Reset();
+	for (TUniqueFunction<void()>& Callback : ReadyCallbacks) { Callback(); }
+
+	if (bHasLoggedStartupReport) { return; }
+	for (const TPair<FName, TSharedRef<FEntry>>& EntryPair : Entries)
+	{
+		if (EntryPair.Value->State != EPDTableIngestionState::READY) { return; }
+	}
+	bHasLoggedStartupReport = true;
+	LogTimingReport();
+}
+
+void FPDTableIngestion::Flush(FName ConsumerName)
+{
+	check(IsInGameThread())
+
+	const TSharedRef<FEntry>* EntryPtr = Entries.Find(ConsumerName);
+	if (EntryPtr == nullptr) { return; }
+
+	const TSharedRef<FEntry> Entry = *EntryPtr;
+	if (Entry->State == EPDTableIngestionState::READY) { return; }
+
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_PDTableIngestionFlush)
+	Entry->Timings.bWasFlushed = true;
+	if (Entry->State == EPDTableIngestionState::STREAMING)
+	{
+		if (Entry->StreamHandle.IsValid()) { Entry->StreamHandle->WaitUntilComplete(); }
+		OnStreamed(ConsumerName, Entry->Generation); // No-op if the handle already called it
+	}
+
+	if (Entry->State == EPDTableIngestionState::BUILDING)
+	{
+		Entry->BuildTask.Wait();
+		PublishEntry(*Entry); // The queued 'OnBuilt' will find the entry ready and skip it
+	}
+}
+
+void FPDTableIngestion::Release(FName ConsumerName)
+{
+	check(IsInGameThread())
+
+	const TSharedRef<FEntry>* EntryPtr = Entries.Find(ConsumerName);
+	if (EntryPtr == nullptr) { return; }
+	
+	if ((*EntryPtr)->StreamHandle.IsValid()) { (*EntryPtr)->StreamHandle->ReleaseHandle(); }
+	Entries.Remove(ConsumerName);
+}
+
+bool FPDTableIngestion::IsReady(FName ConsumerName) const
+{
+	const TSharedRef<FEntry>* EntryPtr = Entries.Find(ConsumerName);
+	return EntryPtr != nullptr && (*EntryPtr)->State == EPDTableIngestionState::READY;
+}
+
+void FPDTableIngestion::OnReady(FName ConsumerName, TUniqueFunction<void()>&& Callback)
+{
+	check(IsInGameThread())
+
+	const TSharedRef<FEntry>* EntryPtr = Entries.Find(ConsumerName);
+	if (EntryPtr != nullptr && (*EntryPtr)->State == EPDTableIngestionState::READY)
+	{
+		Callback();
+		return;
+	}
+
+	if (EntryPtr == nullptr)
+	{
+		UE_LOG(PDLog_SharedUI, Warning, TEXT("FPDTableIngestion::OnReady -- No ingestion named (%s) has been requested, the callback will never fire"), *ConsumerName.ToString())
+		return;
+	}
+	(*EntryPtr)->ReadyCallbacks.Emplace(MoveTemp(Callback));
+}
+
+const FPDTableIngestionTimings* FPDTableIngestion::GetTimings(FName ConsumerName) const
+{
+	const TSharedRef<FEntry>* EntryPtr = Entries.Find(ConsumerName);
+	return EntryPtr != nullptr ? &(*EntryPtr)->Timings : nullptr;
+}
+
+void FPDTableIngestion::LogTimingReport() const
+{
+	FString BuildString = "FPDTableIngestion::LogTimingReport -- ";
+	for (const TPair<FName, TSharedRef<FEntry>>& EntryPair : Entries)
+	{
+		const FEntry& Entry = *EntryPair.Value;
+		const FPDTableIngestionTimings& Timings = Entry.Timings;
+		BuildString += Entry.State == EPDTableIngestionState::READY 
+			? FString::Printf(TEXT("\n (%s) Tables(%i) Stream(%.2fms) Build(%.2fms) Publish(%.2fms) Total(%.2fms)%s"),
+				*EntryPair.Key.ToString(),
+				Entry.Tables.Num(),
+				Timings.StreamSeconds * 1000.0,
+				Timings.BuildSeconds * 1000.0,
+				Timings.PublishSeconds * 1000.0,
+				Timings.TotalSeconds * 1000.0,
+				Timings.bWasFlushed ? TEXT(" [Flushed]") : TEXT(""))
+			: FString::Printf(TEXT("\n (%s) Still in-flight"), *EntryPair.Key.ToString());
+	}
+	UE_LOG(PDLog_SharedUI, Log, TEXT("%s"), *BuildString);
+}
+
+TSharedPtr<FPDTableIngestion::FEntry> FPDTableIngestion::FindEntry(FName ConsumerName, uint32 Generation) const
+{
+	const TSharedRef<FEntry>* EntryPtr = Entries.Find(ConsumerName);
+	if (EntryPtr == nullptr || (*EntryPtr)->Generation != Generation) { return nullptr; }
+	return *EntryPtr;
+}
+
+/**
+Business Source License 1.1
+
+Parameters
+
+Licensor:             Ario Amin (@ Permafrost Development)
+Licensed Work:        RTSOpen (Source available on github)
+                      The Licensed Work is (c) 2024 Ario Amin (@ Permafrost Development)
+Additional Use Grant: You may make free use of the Licensed Work in a commercial product or service provided these three additional conditions as met; 
+                      1. Must give attributions to the original author of the Licensed Work, in 'Credits' if that is applicable.
+                      2. The Licensed Work must be Compiled before being redistributed.
+                      3. The Licensed Work Source may be linked but may not be packaged into the product or service being sold
+                      4. Must not be resold or repackaged or redistributed as another product, is only allowed to be used within a commercial or non-commercial game project.
+                      5. Teams with yearly budgets larger than 100000 USD must contact the owner for a custom license or buy the framework from a marketplace it has been made available on.
+
+                      "Credits" indicate a scrolling screen with attributions. This is usually in a products end-state
+
+                      "Package" means the collection of files distributed by the Licensor, and derivatives of that collection
+                      and/or of those files..   
+
+                      "Source" form means the source code, documentation source, and configuration files for the Package, usually in human-readable format.
+
+                      "Compiled" form means the compiled bytecode, object code, binary, or any other
+                      form resulting from mechanical transformation or translation of the Source form.
+
+Change Date:          2028-04-17
+
+Change License:       Apache License, Version 2.0
+
+For information about alternative licensing arrangements for the Software,
+please visit: https://permadev.se/
+
+Notice
+
+The Business Source License (this document, or the “License”) is not an Open
+Source license. However, the Licensed Work will eventually be made available
+under an Open Source License, as stated in this License.
+
+License text copyright (c) 2017 MariaDB Corporation Ab, All Rights Reserved.
+“Business Source License” is a trademark of MariaDB Corporation Ab.
+
+-----------------------------------------------------------------------------
+
+Business Source License 1.1
+
+Terms
+
+The Licensor hereby grants you the right to copy, modify, create derivative
+works, redistribute, and make non-production use of the Licensed Work. The
+Licensor may make an Additional Use Grant, above, permitting limited
+production use.
+
+Effective on the Change Date, or the fourth anniversary of the first publicly
+available distribution of a specific version of the Licensed Work under this
+License, whichever comes first, the Licensor hereby grants you rights under
+the terms of the Change License, and the rights granted in the paragraph
+above terminate.
+
+If your use of the Licensed Work does not comply with the requirements
+currently in effect as described in this License, you must purchase a
+commercial license from the Licensor, its affiliated entities, or authorized
+resellers, or you must refrain from using the Licensed Work.
+
+All copies of the original and modified Licensed Work, and derivative works
+of the Licensed Work, are subject to this License. This License applies
+separately for each version of the Licensed Work and the Change Date may vary
+for each version of the Licensed Work released by Licensor.
+
+You must conspicuously display this License on each original or modified copy
+of the Licensed Work. If you receive the Licensed Work in original or
+modified form from a third party, the terms and conditions set forth in this
+License apply to your use of that work.
+
+Any use of the Licensed Work in violation of this License will automatically
+terminate your rights under this License for the current and all other
+versions of the Licensed Work.
+
+This License does not grant you any right in any trademark or logo of
+Licensor or its affiliates (provided that you may use a trademark or logo of
+Licensor as expressly required by this License).
+
+TO THE EXTENT PERMITTED BY APPLICABLE LAW, THE LICENSED WORK IS PROVIDED ON
+AN “AS IS” BASIS. LICENSOR HEREBY DISCLAIMS ALL WARRANTIES AND CONDITIONS,
+EXPRESS OR IMPLIED, INCLUDING (WITHOUT LIMITATION) WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT, AND
+TITLE.
+
+MariaDB hereby grants you permission to use this License’s text to license
+your works, and to refer to it using the trademark “Business Source License”,
+as long as you comply with the Covenants of Licensor below.
+
+Covenants of Licensor
+
+In consideration of the right to use this License’s text and the “Business
+Source License” name and trademark, Licensor covenants to MariaDB, and to all
+other recipients of the licensed work to be provided by Licensor:
+
+1. To specify as the Change License the GPL Version 2.0 or any later version,
+   or a license that is compatible with GPL Version 2.0 or a later version,
+   where “compatible” means that software provided under the Change License can
+   be included in a program with software provided under GPL Version 2.0 or a
+   later version. Licensor may specify additional Change Licenses without
+   limitation.
+
+2. To either: (a) specify an additional grant of rights to use that does not
+   impose any additional restriction on the right granted in this License, as
+   the Additional Use Grant; or (b) insert the text “None”.
+
+3. To specify a Change Date.
+
+4. Not to modify this License in any other way.
+ **/
@@ -3,42 +3,44 @@
 #include "Actors/PDUserMessageNetworkManager.h"
 
 #include "PDMessageWidgetCommon.h"
-#include "Net/UnrealNetwork.h"
-#include "Net/Core/PushModel/PushModel.h"
+#include "Components/PDUserMessageRecipientComponent.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/PlayerController.h"
 
 APDUserMessageNetworkManager::APDUserMessageNetworkManager(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
-	NetUpdateFrequency = 0; // No Polling, we are going state based
-	NetDormancy = DORM_Awake; // Stay awake, never know which player might need a message from the server sent to them
+	// Only ticks on frames that have raised messages, and after everything else has had the chance to raise them
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+	PrimaryActorTick.TickGroup = TG_PostUpdateWork;
 }
 
-void APDUserMessageNetworkManager::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+void APDUserMessageNetworkManager::BeginPlay()
 {
-	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-
-	FDoRepLifetimeParams Params{};
-	Params.Condition = ELifetimeCondition::COND_None;
-	Params.bIsPushBased = true;
+	Super::BeginPlay();
 
-	// As we are going stateful, we control when we make an update, and if the message is teh same it is likely we want to replay it, remember we flush the messages on the server the frame after it is sent
-	Params.RepNotifyCondition = ELifetimeRepNotifyCondition::REPNOTIFY_Always;
+#if WITH_SERVER_CODE
+	if (HasAuthority() == false) { return; }
 
-	DOREPLIFETIME_WITH_PARAMS(APDUserMessageNetworkManager, LatestFrame, Params)
+	PostLoginHandle = FGameModeEvents::GameModePostLoginEvent.AddUObject(this, &APDUserMessageNetworkManager::OnPlayerPostLogin);
+	LogoutHandle = FGameModeEvents::GameModeLogoutEvent.AddUObject(this, &APDUserMessageNetworkManager::OnPlayerLogout);
+#endif
 }
 
-
-void APDUserMessageNetworkManager::BeginPlay()
+void APDUserMessageNetworkManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::BeginPlay();
-}
+	FGameModeEvents::GameModePostLoginEvent.Remove(PostLoginHandle);
+	FGameModeEvents::GameModeLogoutEvent.Remove(LogoutHandle);
 
+	Super::EndPlay(EndPlayReason);
+}
 
 void APDUserMessageNetworkManager::TickActor(float DeltaTime, ELevelTick TickType, FActorTickFunction& ThisTickFunction)
 {
 #if WITH_SERVER_CODE
-	MARK_PROPERTY_DIRTY_FROM_NAME(APDUserMessageNetworkManager, LatestFrame, this)
-	LatestFrame.Clear();
+	FlushMessageFrame();
+	SetActorTickEnabled(false);
 #endif	
 	
 	Super::TickActor(DeltaTime, TickType, ThisTickFunction);
@@ -47,10 +49,10 @@ void APDUserMessageNetworkManager::TickActor(float DeltaTime, ELevelTick TickTyp
 void APDUserMessageNetworkManager::AppendToMessageFrame(const FGameplayTag& NewMessageTag, APlayerController* TargetController)
 {
 #if WITH_SERVER_CODE
-	MARK_PROPERTY_DIRTY_FROM_NAME(APDUserMessageNetworkManager, LatestFrame, this)
-	int32& LatestMessageIndexForPlayer = CurrentIndexPerPlayer.FindOrAdd(TargetController);
-	LatestFrame.Items.Add(FPDUserMessageDatum{LatestMessageIndexForPlayer++, NewMessageTag, TargetController});
-	ForceNetUpdate();
+	if (TargetController == nullptr) { return; }
+
+	Outbox.Enqueue(TargetController, NewMessageTag);
+	SetActorTickEnabled(true);
 #else
 	UE_LOG(PDLog_MessageSystem, Warning, TEXT("APDUserMessageNetworkManager::AppendToMessageFrame -- Invalid call. Was called on client"))	
 #endif	
@@ -59,15 +61,41 @@ void APDUserMessageNetworkManager::AppendToMessageFrame(const FGameplayTag& NewM
 void APDUserMessageNetworkManager::AppendToMessageFrame(const FNativeGameplayTag& NewMessageTag, APlayerController* TargetController)
 {
 #if WITH_SERVER_CODE
-	MARK_PROPERTY_DIRTY_FROM_NAME(APDUserMessageNetworkManager, LatestFrame, this)
-	int32& LatestMessageIndexForPlayer = CurrentIndexPerPlayer.FindOrAdd(TargetController);
-	LatestFrame.Items.Add(FPDUserMessageDatum{LatestMessageIndexForPlayer++, NewMessageTag, TargetController});
-	ForceNetUpdate();
+	if (TargetController == nullptr) { return; }
+
+	Outbox.Enqueue(TargetController, NewMessageTag);
+	SetActorTickEnabled(true);
 #else
 	UE_LOG(PDLog_MessageSystem, Warning, TEXT("APDUserMessageNetworkManager::AppendToMessageFrame -- Invalid call. Was called on client"))
 #endif	
 }
 
+void APDUserMessageNetworkManager::FlushMessageFrame()
+{
+	if (Outbox.HasPendingMessages() == false) { return; }
+
+	Outbox.Flush([](APlayerController* Target, const TArray<FPDUserMessageDatum>& Batch)
+	{
+		UPDUserMessageRecipientComponent* Recipient = UPDUserMessageRecipientComponent::FindOrAddRecipient(Target);
+		if (Recipient == nullptr) { return; }
+
+		Recipient->PushMessageBatch(Batch);
+	});
+}
+
+void APDUserMessageNetworkManager::OnPlayerPostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer)
+{
+	if (GameMode == nullptr || GameMode->GetWorld() != GetWorld()) { return; }
+
+	UPDUserMessageRecipientComponent::FindOrAddRecipient(NewPlayer);
+}
+
+void APDUserMessageNetworkManager::OnPlayerLogout(AGameModeBase* GameMode, AController* ExitingController)
+{
+	if (GameMode == nullptr || GameMode->GetWorld() != GetWorld()) { return; }
+
+	Outbox.RemoveRecipient(Cast<APlayerController>(ExitingController));
+}
 
 /*
 Business Source License 1.1
@@ -13,7 +13,7 @@ void IPDUserRecipientInterface::SendUserMessage_Implementation(int32 MessageIdx,
 		const bool bIsNextInOrder = CurrentMessageIndexSession + 1 == MessageIdx;
 		const bool bIsOutOfOrder = bIsNextInOrder == false;
 		static const char* const Ctx = "Incoming message should always be above the latest processed index, it may be far above but never below"; 
-		check(CurrentMessageIndexSession > MessageIdx && Ctx) 
+		check(CurrentMessageIndexSession < MessageIdx && Ctx) 
 		
 		if (bIsNextInOrder)
 		{
@@ -2,41 +2,100 @@
 
 #include "Net/PDUserMessageDatum.h"
 
-#include "Interfaces/PDUserRecipientInterface.h"
+#include "PDMessageWidgetCommon.h"
+#include "Components/PDUserMessageRecipientComponent.h"
 
 void FPDUserMessageDatum::PreReplicatedRemove(const FPDUserMessageFrameList& OwningList)
 {
-	if (Target == nullptr
-		|| Target->GetClass()->ImplementsInterface(UPDUserRecipientInterface::StaticClass()) == false )
+	// Removal is the server pruning its retained window, the message has already been released
+}
+
+void FPDUserMessageDatum::PostReplicatedAdd(const FPDUserMessageFrameList& OwningList)
+{
+	UPDUserMessageRecipientComponent* Recipient = OwningList.GetOwningRecipient();
+	if (Recipient == nullptr)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Called on incorrent player"))
+		UE_LOG(PDLog_MessageSystem, Warning, TEXT("FPDUserMessageDatum::PostReplicatedAdd -- Message list has no owning recipient"))
 		return;
 	}
 
-	IPDUserRecipientInterface::Execute_SendUserMessage(Target, INDEX_NONE, FGameplayTag::EmptyTag);
-	
+	Recipient->OnMessageReceived(*this);
 }
 
-void FPDUserMessageDatum::PostReplicatedAdd(const FPDUserMessageFrameList& OwningList)
+void FPDUserMessageDatum::PostReplicatedChange(const FPDUserMessageFrameList& OwningList)
 {
-	PostReplicatedChange(OwningList);
+	PostReplicatedAdd(OwningList);
 }
 
-void FPDUserMessageDatum::PostReplicatedChange(const FPDUserMessageFrameList& OwningList)
+bool FPDUserMessageFrameList::NetSerialize(FNetDeltaSerializeInfo& DeltaParams)
+{
+	return FFastArraySerializer::FastArrayDeltaSerialize<FPDUserMessageDatum, FPDUserMessageFrameList>(Items, DeltaParams, *this);
+}
+
+//
+// Outbox
+int32 FPDUserMessageOutbox::Enqueue(APlayerController* Target, const FGameplayTag& MessageTag)
 {
-	if (Target == nullptr
-		|| Target->GetClass()->ImplementsInterface(UPDUserRecipientInterface::StaticClass()) == false )
+	int32& NextIndex = NextIndexPerRecipient.FindOrAdd(Target);
+	const int32 MessageIdx = NextIndex++;
+	PendingBatches.FindOrAdd(Target).Emplace(MessageIdx, MessageTag);
+	return MessageIdx;
+}
+
+void FPDUserMessageOutbox::Flush(TFunctionRef<void(APlayerController*, const TArray<FPDUserMessageDatum>&)> Dispatch)
+{
+	for (const TPair<TWeakObjectPtr<APlayerController>, TArray<FPDUserMessageDatum>>& BatchPair : PendingBatches)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Called on incorrent player"))
-		return;
+		APlayerController* Target = BatchPair.Key.Get();
+		if (Target == nullptr || BatchPair.Value.IsEmpty()) { continue; }
+
+		Dispatch(Target, BatchPair.Value);
 	}
+	PendingBatches.Reset();
+}
 
-	IPDUserRecipientInterface::Execute_SendUserMessage(Target, MessageIdx, MessageTag);
+void FPDUserMessageOutbox::RemoveRecipient(APlayerController* Target)
+{
+	NextIndexPerRecipient.Remove(Target);
+	PendingBatches.Remove(Target);
 }
 
-bool FPDUserMessageFrameList::NetSerialize(FNetDeltaSerializeInfo& DeltaParams)
+//
+// Order buffer
+bool FPDUserMessageOrderBuffer::Receive(const FPDUserMessageDatum& Datum)
 {
-	return FFastArraySerializer::FastArrayDeltaSerialize<FPDUserMessageDatum, FPDUserMessageFrameList>(Items, DeltaParams, *this);
+	if (Datum.MessageIdx < NextExpectedIdx || PendingMessages.Contains(Datum.MessageIdx))
+	{
+		return false;
+	}
+
+	PendingMessages.Emplace(Datum.MessageIdx, Datum.MessageTag);
+	return true;
+}
+
+void FPDUserMessageOrderBuffer::SkipTo(int32 OldestAvailableIdx)
+{
+	if (OldestAvailableIdx <= NextExpectedIdx) { return; }
+
+	UE_LOG(PDLog_MessageSystem, Warning, TEXT("FPDUserMessageOrderBuffer::SkipTo -- Messages (%i -> %i) were pruned on the server before they reached us"), NextExpectedIdx, OldestAvailableIdx - 1)
+	for (int32 StaleIdx = NextExpectedIdx; StaleIdx < OldestAvailableIdx; StaleIdx++)
+	{
+		PendingMessages.Remove(StaleIdx);
+	}
+	NextExpectedIdx = OldestAvailableIdx;
+}
+
+int32 FPDUserMessageOrderBuffer::Release(TFunctionRef<void(int32, const FGameplayTag&)> Dispatch)
+{
+	int32 ReleasedCount = 0;
+	FGameplayTag MessageTag;
+	while (PendingMessages.RemoveAndCopyValue(NextExpectedIdx, MessageTag))
+	{
+		Dispatch(NextExpectedIdx, MessageTag);
+		NextExpectedIdx++;
+		ReleasedCount++;
+	}
+	return ReleasedCount;
 }
 
 /*
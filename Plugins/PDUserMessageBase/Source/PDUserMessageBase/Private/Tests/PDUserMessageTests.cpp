@@ -0,0 +1,206 @@
+﻿/* @author: Ario Amin @ Permafrost Development. @copyright: Full BSL(1.1) License included at bottom of the file  */
+
+#include "Net/PDUserMessageDatum.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPDUserMessageOutboxRoutingTest, "PD.UserMessage.Outbox.MultiRecipientRouting", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FPDUserMessageOutboxRoutingTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 RecipientCount = 3;
+	constexpr int32 MessagesPerRecipient = 5;
+
+	TArray<APlayerController*> Recipients;
+	for (int32 Idx = 0; Idx < RecipientCount; Idx++)
+	{
+		Recipients.Emplace(NewObject<APlayerController>(GetTransientPackage()));
+	}
+
+	// Interleave the recipients, as messages raised by gameplay would be
+	FPDUserMessageOutbox Outbox;
+	for (int32 MessageIdx = 0; MessageIdx < MessagesPerRecipient; MessageIdx++)
+	{
+		for (APlayerController* Recipient : Recipients)
+		{
+			TestEqual(TEXT("Each recipient has its own gapless index sequence"), Outbox.Enqueue(Recipient, FGameplayTag::EmptyTag), MessageIdx);
+		}
+	}
+	TestTrue(TEXT("Messages are staged until flushed"), Outbox.HasPendingMessages());
+
+	TMap<APlayerController*, int32> BatchesPerRecipient;
+	Outbox.Flush([&](APlayerController* Target, const TArray<FPDUserMessageDatum>& Batch)
+	{
+		BatchesPerRecipient.FindOrAdd(Target)++;
+		TestEqual(TEXT("A batch holds every message raised for its recipient"), Batch.Num(), MessagesPerRecipient);
+		for (int32 Idx = 0; Idx < Batch.Num(); Idx++)
+		{
+			TestEqual(TEXT("A batch is in the order its messages were raised"), Batch[Idx].MessageIdx, Idx);
+		}
+	});
+
+	TestEqual(TEXT("Every recipient received a batch"), BatchesPerRecipient.Num(), RecipientCount);
+	for (const TPair<APlayerController*, int32>& BatchCount : BatchesPerRecipient)
+	{
+		TestEqual(TEXT("A flush results in a single batch per recipient"), BatchCount.Value, 1);
+	}
+	TestFalse(TEXT("A flush clears the staged batches"), Outbox.HasPendingMessages());
+
+	// Sequences carry on after a flush, and only for the recipient that was targeted
+	TestEqual(TEXT("Index sequence continues after a flush"), Outbox.Enqueue(Recipients[0], FGameplayTag::EmptyTag), MessagesPerRecipient);
+	int32 DispatchCount = 0;
+	Outbox.Flush([&](APlayerController* Target, const TArray<FPDUserMessageDatum>& Batch)
+	{
+		DispatchCount++;
+		TestTrue(TEXT("Only the targeted recipient receives a batch"), Target == Recipients[0]);
+	});
+	TestEqual(TEXT("Untargeted recipients are not dispatched to"), DispatchCount, 1);
+
+	Outbox.RemoveRecipient(Recipients[0]);
+	TestEqual(TEXT("A removed recipient starts over from index zero"), Outbox.Enqueue(Recipients[0], FGameplayTag::EmptyTag), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPDUserMessageOrderBufferTest, "PD.UserMessage.OrderBuffer.ReleasesInOrder", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FPDUserMessageOrderBufferTest::RunTest(const FString& Parameters)
+{
+	FPDUserMessageOrderBuffer OrderBuffer;
+	TArray<int32> Released;
+	const auto Collect = [&Released](int32 MessageIdx, const FGameplayTag&) { Released.Emplace(MessageIdx); };
+
+	// Arrives out of order, nothing may be released until index 0 is in
+	TestTrue(TEXT("Buffers a message ahead of the expected index"), OrderBuffer.Receive(FPDUserMessageDatum(2, FGameplayTag::EmptyTag)));
+	TestTrue(TEXT("Buffers a message ahead of the expected index"), OrderBuffer.Receive(FPDUserMessageDatum(1, FGameplayTag::EmptyTag)));
+	TestFalse(TEXT("Rejects a message that is already buffered"), OrderBuffer.Receive(FPDUserMessageDatum(1, FGameplayTag::EmptyTag)));
+	TestEqual(TEXT("Holds on to messages while a preceding one is missing"), OrderBuffer.Release(Collect), 0);
+
+	OrderBuffer.Receive(FPDUserMessageDatum(0, FGameplayTag::EmptyTag));
+	TestEqual(TEXT("Releases the contiguous run once the gap is filled"), OrderBuffer.Release(Collect), 3);
+	TestTrue(TEXT("Releases in index order"), Released == TArray<int32>{0, 1, 2});
+	TestFalse(TEXT("Rejects a message that has already been released"), OrderBuffer.Receive(FPDUserMessageDatum(1, FGameplayTag::EmptyTag)));
+
+	// Server pruned 3 and 4 before they reached us
+	Released.Reset();
+	OrderBuffer.Receive(FPDUserMessageDatum(5, FGameplayTag::EmptyTag));
+	TestEqual(TEXT("Waits on pruned messages until told to skip"), OrderBuffer.Release(Collect), 0);
+	OrderBuffer.SkipTo(5);
+	TestEqual(TEXT("Releases past the pruned messages after skipping"), OrderBuffer.Release(Collect), 1);
+	TestEqual(TEXT("Next expected index follows the released message"), OrderBuffer.NextExpectedIdx, 6);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
+
+/**
+Business Source License 1.1
+
+Parameters
+
+Licensor:             Ario Amin (@ Permafrost Development)
+Licensed Work:        RTSOpen (Source available on github)
+                      The Licensed Work is (c) 2024 Ario Amin (@ Permafrost Development)
+Additional Use Grant: You may make free use of the Licensed Work in a commercial product or service provided these three additional conditions as met; 
+                      1. Must give attributions to the original author of the Licensed Work, in 'Credits' if that is applicable.
+                      2. The Licensed Work must be Compiled before being redistributed.
+                      3. The Licensed Work Source may be linked but may not be packaged into the product or service being sold
+                      4. Must not be resold or repackaged or redistributed as another product, is only allowed to be used within a commercial or non-commercial game project.
+                      5. Teams with yearly budgets larger than 100000 USD must contact the owner for a custom license or buy the framework from a marketplace it has been made available on.
+
+                      "Credits" indicate a scrolling screen with attributions. This is usually in a products end-state
+
+                      "Package" means the collection of files distributed by the Licensor, and derivatives of that collection
+                      and/or of those files..   
+
+                      "Source" form means the source code, documentation source, and configuration files for the Package, usually in human-readable format.
+
+                      "Compiled" form means the compiled bytecode, object code, binary, or any other
+                      form resulting from mechanical transformation or translation of the Source form.
+
+Change Date:          2028-04-17
+
+Change License:       Apache License, Version 2.0
+
+For information about alternative licensing arrangements for the Software,
+please visit: https://permadev.se/
+
+Notice
+
+The Business Source License (this document, or the “License”) is not an Open
+Source license. However, the Licensed Work will eventually be made available
+under an Open Source License, as stated in this License.
+
+License text copyright (c) 2017 MariaDB Corporation Ab, All Rights Reserved.
+“Business Source License” is a trademark of MariaDB Corporation Ab.
+
+-----------------------------------------------------------------------------
+
+Business Source License 1.1
+
+Terms
+
+The Licensor hereby grants you the right to copy, modify, create derivative
+works, redistribute, and make non-production use of the Licensed Work. The
+Licensor may make an Additional Use Grant, above, permitting limited
+production use.
+
+Effective on the Change Date, or the fourth anniversary of the first publicly
+available distribution of a specific version of the Licensed Work under this
+License, whichever comes first, the Licensor hereby grants you rights under
+the terms of the Change License, and the rights granted in the paragraph
+above terminate.
+
+If your use of the Licensed Work does not comply with the requirements
+currently in effect as described in this License, you must purchase a
+commercial license from the Licensor, its affiliated entities, or authorized
+resellers, or you must refrain from using the Licensed Work.
+
+All copies of the original and modified Licensed Work, and derivative works
+of the Licensed Work, are subject to this License. This License applies
+separately for each version of the Licensed Work and the Change Date may vary
+for each version of the Licensed Work released by Licensor.
+
+You must conspicuously display this License on each original or modified copy
+of the Licensed Work. If you receive the Licensed Work in original or
+modified form from a third party, the terms and conditions set forth in this
+License apply to your use of that work.
+
+Any use of the Licensed Work in violation of this License will automatically
+terminate your rights under this License for the current and all other
+versions of the Licensed Work.
+
+This License does not grant you any right in any trademark or logo of
+Licensor or its affiliates (provided that you may use a trademark or logo of
+Licensor as expressly required by this License).
+
+TO THE EXTENT PERMITTED BY APPLICABLE LAW, THE LICENSED WORK IS PROVIDED ON
+AN “AS IS” BASIS. LICENSOR HEREBY DISCLAIMS ALL WARRANTIES AND CONDITIONS,
+EXPRESS OR IMPLIED, INCLUDING (WITHOUT LIMITATION) WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT, AND
+TITLE.
+
+MariaDB hereby grants you permission to use this License’s text to license
+your works, and to refer to it using the trademark “Business Source License”,
+as long as you comply with the Covenants of Licensor below.
+
+Covenants of Licensor
+
+In consideration of the right to use this License’s text and the “Business
+Source License” name and trademark, Licensor covenants to MariaDB, and to all
+other recipients of the licensed work to be provided by Licensor:
+
+1. To specify as the Change License the GPL Version 2.0 or any later version,
+   or a license that is compatible with GPL Version 2.0 or a later version,
+   where “compatible” means that software provided under the Change License can
+   be included in a program with software provided under GPL Version 2.0 or a
+   later version. Licensor may specify additional Change Licenses without
+   limitation.
+
+2. To either: (a) specify an additional grant of rights to use that does not
+   impose any additional restriction on the right granted in this License, as
+   the Additional Use Grant; or (b) insert the text “None”.
+
+3. To specify a Change Date.
+
+4. Not to modify this License in any other way.
+ **/
@@ -10,39 +10,51 @@
 #include "PDUserMessageNetworkManager.generated.h"
 
 struct FGameplayTag;
+class AGameModeBase;
 
+/** @brief Server-side router for user messages.
+ * Messages are staged per recipient and, once per frame, flushed to each recipients own 'UPDUserMessageRecipientComponent'.
+ * No message data is replicated by the manager itself */
 UCLASS(Blueprintable, BlueprintType)
 class PDUSERMESSAGEBASE_API APDUserMessageNetworkManager : public AActor
 {
 	GENERATED_UCLASS_BODY()
 public:
-	/** @brief  Reserved for later use. Calls super for now */
+	/** @brief  Hooks into game-mode login/logout events to prepare and clean up recipients
+	 * @note Does nothing on client. */
 	UFUNCTION()
 	virtual void BeginPlay() override;
-	/** @brief Clears the latest message frame
+	/** @brief  Unhooks the game-mode login/logout events */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	/** @brief Flushes the staged messages, one batch per recipient, then disables tick until a new message is appended
 	 * @note Does nothing on client. */
 	virtual void TickActor(float DeltaTime, ELevelTick TickType, FActorTickFunction& ThisTickFunction) override;
 
-	/** @brief  Appends message tag (FGameplayTag) to latest message frame. Forces a net update
+	/** @brief  Stages message tag (FGameplayTag) for the target controller, is sent with the rest of the frames messages
 	 * @note Does nothing on client */
 	UFUNCTION()
 	void AppendToMessageFrame(const FGameplayTag& NewMessageTag, APlayerController* TargetController);
 
-	/** @brief  Appends message tag (FNativeGameplayTag) to latest message frame. Forces a net update
+	/** @brief  Stages message tag (FNativeGameplayTag) for the target controller, is sent with the rest of the frames messages
 	 * @note Does nothing on client */
 	void AppendToMessageFrame(const FNativeGameplayTag& NewMessageTag, APlayerController* TargetController);
-	
-	/** @brief Latest message frame, keeps all messages for all connected users
-	 * @todo optimize, don't force other users to take every message as it may easily over-saturate the network */
-	UPROPERTY(Replicated)
-	FPDUserMessageFrameList LatestFrame;
-	
-	/** @brief Tells us which message index we are currently processing */
-	UPROPERTY()
-	TMap<APlayerController*,int32> CurrentIndexPerPlayer{};
-};
 
+	/** @brief Hands every staged batch to its recipient component */
+	void FlushMessageFrame();
+
+	/** @brief Adds a recipient component to the new player up front, so it has replicated before the first message is sent */
+	void OnPlayerPostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer);
+	/** @brief Drops the index sequence and any staged messages for a leaving player */
+	void OnPlayerLogout(AGameModeBase* GameMode, AController* ExitingController);
 
+	/** @brief Messages staged for the current frame, and the index sequence for each player */
+	FPDUserMessageOutbox Outbox{};
+
+	/** @brief Handle for the login event binding */
+	FDelegateHandle PostLoginHandle{};
+	/** @brief Handle for the logout event binding */
+	FDelegateHandle LogoutHandle{};
+};
 
 /*
 Business Source License 1.1
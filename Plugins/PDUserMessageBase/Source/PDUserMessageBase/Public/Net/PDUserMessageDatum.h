@@ -13,6 +13,7 @@
 
 struct FGameplayTag;
 struct FPDUserMessageFrameList; // Fwd decl for the message datum to use
+class UPDUserMessageRecipientComponent;
 
 /** @brief The networked 'fastarray' item for our user messages */
 USTRUCT(Blueprintable)
@@ -22,12 +23,15 @@ struct PDUSERMESSAGEBASE_API FPDUserMessageDatum : public FFastArraySerializerIt
 
 	FPDUserMessageDatum(){};
 
-	FPDUserMessageDatum(int32 InMessageIdx, const FGameplayTag& InMessageTag, APlayerController* InTarget)
-		: MessageIdx(InMessageIdx), MessageTag(InMessageTag), Target(InTarget)
+	FPDUserMessageDatum(int32 InMessageIdx, const FGameplayTag& InMessageTag)
+		: MessageIdx(InMessageIdx), MessageTag(InMessageTag)
 	{};
 
+	/** @brief Does nothing, removals are only the server pruning messages that has already been delivered */
 	void PreReplicatedRemove(const FPDUserMessageFrameList& OwningList);
+	/** @brief Hands the message to the owning recipient, which releases it to the player controller in order */
 	void PostReplicatedAdd(const FPDUserMessageFrameList& OwningList);
+	/** @brief Messages are never changed after being sent. Calls PostReplicatedAdd in case the index has been reused */
 	void PostReplicatedChange(const FPDUserMessageFrameList& OwningList);
 
 	/** @brief  This will increment for a player during a given session,
@@ -35,17 +39,12 @@ struct PDUSERMESSAGEBASE_API FPDUserMessageDatum : public FFastArraySerializerIt
 	UPROPERTY()
 	int32 MessageIdx = 0;
 
-	/** @brief  The tag associated with this message */
+	/** @brief  The tag associated with the message */
 	UPROPERTY()
 	FGameplayTag MessageTag = FGameplayTag::EmptyTag;
-
-	/** @brief The target player for this message
-	 * @note Should always resolve to nullptr if replicated to incorrect players */	
-	UPROPERTY()
-	APlayerController* Target = nullptr;
 };
 
-/** @brief The 'fastarray' definition for the message frame */
+/** @brief The 'fastarray' definition for a single recipients message frame */
 USTRUCT(Blueprintable)
 struct PDUSERMESSAGEBASE_API FPDUserMessageFrameList : public  FFastArraySerializer
 {
@@ -54,12 +53,21 @@ struct PDUSERMESSAGEBASE_API FPDUserMessageFrameList : public  FFastArraySeriali
 	bool NetSerialize(FNetDeltaSerializeInfo& DeltaParams);
 
 	/** @brief Clears the inner array  */
-	inline void Clear() { Items.Empty(); }
+	inline void Clear() { Items.Empty(); MarkArrayDirty(); }
+
+	/** @brief Return the recipient that owns this fastarray */
+	FORCEINLINE UPDUserMessageRecipientComponent* GetOwningRecipient() const { return OwningRecipient; }
+	/** @brief Assign the recipient that should own this fastarray */
+	FORCEINLINE void SetOwningRecipient(UPDUserMessageRecipientComponent* InRecipient) { OwningRecipient = InRecipient; }
 
 	/** @brief Inner array of items that the 'fastarray' serializer handles */
 	UPROPERTY()
 	TArray<FPDUserMessageDatum> Items;
-	
+
+protected:
+	/** @brief The owning recipient component, if it has been assigned. */
+	UPROPERTY(NotReplicated)
+	UPDUserMessageRecipientComponent* OwningRecipient = nullptr;
 };
 
 /** @brief 'Fastarray' boiler-plate */
@@ -72,6 +80,48 @@ struct TStructOpsTypeTraits<FPDUserMessageFrameList> : TStructOpsTypeTraitsBase2
 	};
 };
 
+/** @brief Server-side staging of user messages, keyed by recipient.
+ * - Assigns each recipient it's own, gapless, message index sequence
+ * - Batches everything raised for a recipient until the next flush, so a frame only results in one net update per recipient
+ * @note Has no networking dependencies, the flush callback decides how a batch reaches its recipient */
+struct PDUSERMESSAGEBASE_API FPDUserMessageOutbox
+{
+	/** @brief Stages a message for the given recipient and returns the message index it was assigned */
+	int32 Enqueue(APlayerController* Target, const FGameplayTag& MessageTag);
+
+	/** @brief Hands every staged batch to 'Dispatch', in the order they were raised, then clears the staged batches */
+	void Flush(TFunctionRef<void(APlayerController* /*Target*/, const TArray<FPDUserMessageDatum>& /*Batch*/)> Dispatch);
+
+	/** @brief Forgets a recipient entirely, both its staged messages and its index sequence */
+	void RemoveRecipient(APlayerController* Target);
+
+	/** @brief Are any messages waiting to be flushed */
+	FORCEINLINE bool HasPendingMessages() const { return PendingBatches.IsEmpty() == false; }
+
+	/** @brief Next message index for each recipient */
+	TMap<TWeakObjectPtr<APlayerController>, int32> NextIndexPerRecipient{};
+	/** @brief Messages raised since the last flush, per recipient */
+	TMap<TWeakObjectPtr<APlayerController>, TArray<FPDUserMessageDatum>> PendingBatches{};
+};
+
+/** @brief Client-side reordering of user messages.
+ * Holds on to messages that arrive ahead of a missing index and releases them strictly in index order */
+struct PDUSERMESSAGEBASE_API FPDUserMessageOrderBuffer
+{
+	/** @brief Buffers a received message. Returns false if it has already been released or buffered */
+	bool Receive(const FPDUserMessageDatum& Datum);
+
+	/** @brief Skips ahead to 'OldestAvailableIdx' if the messages we are waiting for no longer exist on the server */
+	void SkipTo(int32 OldestAvailableIdx);
+
+	/** @brief Releases every message that is next in order to 'Dispatch'. Returns the number of released messages */
+	int32 Release(TFunctionRef<void(int32 /*MessageIdx*/, const FGameplayTag& /*MessageTag*/)> Dispatch);
+
+	/** @brief The index of the next message we are allowed to release */
+	int32 NextExpectedIdx = 0;
+	/** @brief Received messages that are waiting for a preceding message */
+	TMap<int32, FGameplayTag> PendingMessages{};
+};
 
 /*
 Business Source License 1.1
@@ -32,6 +32,7 @@ DECLARE_LOG_CATEGORY_CLASS(PDLog_RTSO, Log, All);
 
 class APDInteractActor;
 class UPDRTSBaseUnit;
+struct FMassEntityManager;
 class ARTSOInteractableConversationActor;
 
 UENUM()
@@ -68,6 +69,73 @@ enum ERTSOConversationState
 	Valid                 UMETA(DisplayName="Conversation: Current State VALID"),
 };
 
+/** @brief Interns progression/mission tags into dense bit indices, shared by every players progression bitset and every requirement mask
+ * @note Bits are only ever appended, so masks and bitsets built earlier stay valid as new tags are interned. Game-thread only */
+struct RTSOPEN_API FRTSOProgressionTagRegistry
+{
+	/** @brief Returns the engine-wide registry */
+	static FRTSOProgressionTagRegistry& Get();
+
+	/** @brief Returns the bit of 'Tag', assigning it the next free bit if it has not been interned yet */
+	int32 Intern(const FGameplayTag& Tag);
+	/** @brief Returns the bit of 'Tag', or INDEX_NONE if it has not been interned */
+	int32 Find(const FGameplayTag& Tag) const;
+	/** @brief Returns the tag that was interned as 'TagBit' */
+	const FGameplayTag& GetTag(int32 TagBit) const { return BitToTag[TagBit]; }
+	/** @brief Number of interned tags */
+	int32 Num() const { return BitToTag.Num(); }
+
+	/** @brief Interns 'Tags' and returns a mask with their bits set */
+	TBitArray<> MakeMask(const TArray<FGameplayTag>& Tags);
+
+private:
+	/** @brief Tag to bit index */
+	TMap<FGameplayTag, int32> TagToBit;
+	/** @brief Bit index to tag */
+	TArray<FGameplayTag> BitToTag;
+};
+
+/** @brief A logged change to a players progression tags, flushed into the save-data incrementally */
+struct FRTSOProgressionTagChange
+{
+	/** @brief Interned bit of the tag that changed */
+	int32 TagBit = INDEX_NONE;
+	/** @brief True if the tag was added, false if it was removed */
+	bool bAdded = true;
+};
+
+/** @brief Dense per-player progression tag set. Requirement checks are word-wise AND and compare against a mask built by 'FRTSOProgressionTagRegistry'
+ * @note 'MatchBits' also has the parents of every explicit tag set, this keeps the same semantics as 'FGameplayTagContainer::HasTag' */
+struct RTSOPEN_API FRTSOProgressionTagSet
+{
+	/** @brief Adds an explicit tag, logs the change if it was not already set. Returns true if it was added */
+	bool Add(const FGameplayTag& Tag);
+	/** @brief Removes an explicit tag, logs the change if it was set. Returns true if it was removed */
+	bool Remove(const FGameplayTag& Tag);
+	/** @brief Same semantics as 'FGameplayTagContainer::HasTag' */
+	bool Has(const FGameplayTag& Tag) const;
+	/** @brief True if every bit in 'RequiredMask' is set in 'MatchBits', compares whole words at a time */
+	bool HasAll(const TBitArray<>& RequiredMask) const;
+	/** @brief Clears all tags and the change log */
+	void Reset();
+
+	/** @brief Moves the logged changes into 'OutChanges' and clears our log */
+	void ConsumeChangeLog(TArray<FRTSOProgressionTagChange>& OutChanges);
+
+	/** @brief Explicitly added tags, by interned bit */
+	TBitArray<> ExplicitBits;
+	/** @brief Explicit tags and all of their parents, by interned bit. What requirement masks are compared against */
+	TBitArray<> MatchBits;
+	/** @brief Changes to 'ExplicitBits' since the change log was last consumed */
+	TArray<FRTSOProgressionTagChange> ChangeLog;
+
+private:
+	/** @brief Rebuilds 'MatchBits' from 'ExplicitBits', needed after removals as parents may be shared between explicit tags */
+	void RebuildMatchBits();
+	/** @brief Sets 'TagBit' in 'Bits', growing it if needed */
+	static void SetBit(TBitArray<>& Bits, int32 TagBit, bool bValue);
+};
+
 /** @brief Conversation rules, used for mission-progression */
 USTRUCT(Blueprintable)
 struct FRTSOConversationRules
@@ -90,6 +158,26 @@ struct FRTSOConversationRules
 	UPROPERTY(EditAnywhere)
 	bool bCanRepeatConversation = true;
 
+	/** @brief Interns 'RequiredTags' and caches their mask, call when the rules are loaded */
+	void BuildRequiredTagMask()
+	{
+		RequiredTagMask = FRTSOProgressionTagRegistry::Get().MakeMask(RequiredTags);
+		bHasRequiredTagMask = true;
+	}
+	
+	/** @brief Returns the interned mask of 'RequiredTags', builds it if it has not been built yet */
+	const TBitArray<>& GetRequiredTagMask() const
+	{
+		if (bHasRequiredTagMask == false) { const_cast<FRTSOConversationRules*>(this)->BuildRequiredTagMask(); }
+		return RequiredTagMask;
+	}
+
+	/** @brief Builds the required tag masks for all 'Rules' */
+	static void BuildRequiredTagMasks(TArray<FRTSOConversationRules>& Rules)
+	{
+		for (FRTSOConversationRules& Rule : Rules) { Rule.BuildRequiredTagMask(); }
+	}
+
 	bool operator==(const FRTSOConversationRules& Other) const
 	{
 		// we really only care about the entry tag and required tags in comparisons 
@@ -102,6 +190,12 @@ struct FRTSOConversationRules
 	{
 		return (*this == Other) == false;
 	}
+
+private:
+	/** @brief Interned bits of 'RequiredTags', see 'FRTSOProgressionTagRegistry' */
+	TBitArray<> RequiredTagMask;
+	/** @brief Set once 'RequiredTagMask' has been built */
+	bool bHasRequiredTagMask = false;
 };
 
 /** @brief Conversation base Settings.  */
@@ -452,6 +546,178 @@ struct FRTSGodhandSettings : public FTableRowBase
 	double CameraTargetInterpSpeed = 3.0;	
 };
 
+/** @brief Dense selection group storage, keyed by stable group IDs.
+ * @note Each group is a handle array sorted by entity index, so membership tests are binary searches and group differences are single linear merges */
+struct FRTSOSelectionGroups
+{
+	/** @brief Strict ordering the group arrays are kept sorted by */
+	static bool HandleLess(const FMassEntityHandle& A, const FMassEntityHandle& B)
+	{
+		return A.Index != B.Index ? A.Index < B.Index : A.SerialNumber < B.SerialNumber;
+	}
+	/** @brief Writes the handles in sorted 'Left' which are not in sorted 'Right' to 'OutDifference' */
+	static void Difference(TConstArrayView<FMassEntityHandle> Left, TConstArrayView<FMassEntityHandle> Right, TArray<FMassEntityHandle>& OutDifference);
+	/** @brief Merges sorted 'Added', which must not overlap 'Sorted', into 'Sorted'. Merges from the back so existing members are only shifted once */
+	static void MergeSorted(TArray<FMassEntityHandle>& Sorted, TConstArrayView<FMassEntityHandle> Added);
+	/** @brief Removes the handles in sorted 'Removed' from 'Sorted' in a single compaction pass, starting at the first removed handle. Writes the handles that were actually removed to 'OutRemoved' */
+	static void RemoveSorted(TArray<FMassEntityHandle>& Sorted, TConstArrayView<FMassEntityHandle> Removed, TArray<FMassEntityHandle>& OutRemoved);
+
+	/** @brief Replaces a group, sorts and de-duplicates the given handles */
+	void SetGroup(int32 GroupID, TArray<FMassEntityHandle>&& Handles);
+	/** @brief Adds handles to a group, creates the group if anything was added. Writes the handles that were actually added to 'OutAdded', sorted */
+	void AddToGroup(int32 GroupID, TConstArrayView<FMassEntityHandle> Handles, TArray<FMassEntityHandle>& OutAdded);
+	/** @brief Removes handles from a group, removes the group if it ends up empty. Writes the handles that were actually removed to 'OutRemoved', sorted */
+	void RemoveFromGroup(int32 GroupID, TConstArrayView<FMassEntityHandle> Handles, TArray<FMassEntityHandle>& OutRemoved);
+	/** @brief Moves a group to a new ID, overwriting any group already on it. The handle array itself is moved, not copied */
+	bool MoveGroup(int32 OldID, int32 NewID);
+	/** @brief Removes a group */
+	void RemoveGroup(int32 GroupID) { Groups.Remove(GroupID); }
+
+	/** @brief Does the group exist */
+	bool Contains(int32 GroupID) const { return Groups.Contains(GroupID); }
+	/** @brief Sorted handles of a group, nullptr if the group does not exist */
+	const TArray<FMassEntityHandle>* FindGroup(int32 GroupID) const { return Groups.Find(GroupID); }
+	/** @brief Is the entity a member of the group */
+	bool IsInGroup(int32 GroupID, const FMassEntityHandle& Handle) const;
+	/** @brief Entity indices of the group members, this is what the selection events pass along */
+	void GetGroupEntityIndices(int32 GroupID, TArray<int32>& OutIndices) const;
+
+private:
+	/** @brief Sorted, de-duplicated handle arrays keyed by group ID */
+	TMap<int32, TArray<FMassEntityHandle>> Groups;
+};
+
+/** @brief A ranked hover candidate under the godhand cursor, either an interactable actor or an owned mass entity */
+struct FRTSOHoverCandidate
+{
+	/** @brief Valid if the candidate is an actor */
+	TWeakObjectPtr<AActor> Actor = nullptr;
+	/** @brief Valid if the candidate is an entity */
+	FMassEntityHandle Entity{0, 0};
+	/** @brief Squared distance from the cursor when the candidate was gathered */
+	double DistanceSquared = 0.0;
+	/** @brief Stable tie-breaker so equally distant candidates keep their order between rebuilds. Actors rank before entities */
+	uint64 TieBreakKey = 0;
+
+	/** @brief Makes an actor candidate, keyed on the actors unique ID */
+	static FRTSOHoverCandidate MakeActor(AActor* InActor, double InDistanceSquared);
+	/** @brief Makes an entity candidate, keyed on the entity serial and index */
+	static FRTSOHoverCandidate MakeEntity(const FMassEntityHandle& InEntity, double InDistanceSquared);
+	
+	bool IsEntity() const { return Entity.Index != 0; }
+
+	/** @brief Closest first, ties resolved by 'TieBreakKey' */
+	bool operator<(const FRTSOHoverCandidate& Other) const
+	{
+		return DistanceSquared != Other.DistanceSquared ? DistanceSquared < Other.DistanceSquared : TieBreakKey < Other.TieBreakKey;
+	}
+};
+
+/** @brief Everything hover resolution depends on, the candidate cache only rebuilds when one of these has changed */
+struct FRTSOHoverInputs
+{
+	/** @brief Cursor location, projected on the ground */
+	FVector CursorLocation = PD::Constants::INVALID_WORLD_LOC;
+	FVector CameraLocation = PD::Constants::INVALID_WORLD_LOC;
+	FQuat CameraRotation = FQuat::Identity;
+	/** @brief Bumped by the godhands collision overlap events */
+	uint32 ActorPopulationVersion = 0;
+	/** @brief Signature of the entities in the hover selection query group */
+	uint32 EntityPopulationSignature = 0;
+};
+
+/** @brief Ranked hover candidates for the godhand, mixing actors and entities.
+ * @note Only rebuilt when the cursor, the camera or the nearby actor/entity population has changed. Otherwise hover resolution is free */
+struct FRTSOHoverCandidateCache
+{
+	/** @brief Cursor or camera movement below this is treated as no movement, in unreal units */
+	static constexpr double LocationTolerance = 1.0;
+	/** @brief Camera rotation below this is treated as no rotation, in radians */
+	static constexpr double RotationTolerance = 0.001;
+	
+	/** @brief Do the candidates need to be rebuilt for the given inputs */
+	bool IsStale(const FRTSOHoverInputs& Inputs) const;
+	/** @brief Replaces and ranks the candidates, stores the inputs they were built for */
+	void Rebuild(const FRTSOHoverInputs& Inputs, TArray<FRTSOHoverCandidate>&& NewCandidates);
+	/** @brief Forces a rebuild on the next resolve */
+	void Invalidate() { bHasBuilt = false; }
+
+	/** @brief Closest still valid actor candidate, nullptr if none */
+	AActor* GetClosestActor() const;
+	/** @brief Closest still valid entity candidate that is currently within 'Radius' of 'CursorLocation', invalid handle if none
+	 * @note Ranks by the entities live transforms, not by the distances gathered at the last rebuild. Equally close entities resolve to the first in rank order */
+	FMassEntityHandle GetClosestEntity(const FMassEntityManager& EntityManager, const FVector& CursorLocation, double Radius) const;
+	/** @brief All candidates, closest first */
+	const TArray<FRTSOHoverCandidate>& GetCandidates() const { return Candidates; }
+
+private:
+	/** @brief Inputs the candidates were built for */
+	FRTSOHoverInputs BuiltInputs{};
+	/** @brief Ranked candidates, closest first */
+	TArray<FRTSOHoverCandidate> Candidates;
+	bool bHasBuilt = false;
+};
+
+/** @brief Screen-space index of selectable entities, used by marquee selection.
+ * - Entity locations are projected once per build with the players view-projection, so slopes and perspective are handled exactly
+ * - Projected entities are bucketed into coarse screen tiles, a rectangle query only visits the tiles it overlaps
+ * - Only entities in border tiles are tested individually, entities in fully covered tiles are taken as is */
+struct FRTSOScreenSelectionIndex
+{
+	/** @brief Width and height of a screen tile, in pixels */
+	static constexpr int32 TileSize = 64;
+
+	/** @brief Starts a new build for the given view, discards all previously indexed entities */
+	void BeginBuild(const FIntRect& InViewRect, const FMatrix& InViewProjection);
+	/** @brief Projects the world location and stores the entity if it lands inside the view */
+	void AddEntity(const FMassEntityHandle& Handle, const FVector& WorldLocation);
+	/** @brief Sorts the added entities into their tiles, the index can be queried after this */
+	void FinishBuild();
+	/** @brief Clears the index, queries return nothing until it is rebuilt */
+	void Invalidate();
+
+	/** @brief Appends every entity whose projected location lies within the rectangle spanned by the two screen positions */
+	void Query(const FVector2D& CornerA, const FVector2D& CornerB, TArray<FMassEntityHandle>& OutHandles) const;
+	/** @brief Amount of indexed entities */
+	int32 Num() const { return Entities.Num(); }
+
+private:
+	/** @brief An entity and where it was projected to */
+	struct FProjectedEntity
+	{
+		FMassEntityHandle Handle{};
+		FVector2D ScreenLocation = FVector2D::ZeroVector;
+		int32 TileIdx = INDEX_NONE;
+	};
+
+	/** @brief View the index was built for */
+	FIntRect ViewRect{};
+	FMatrix ViewProjection = FMatrix::Identity;
+	/** @brief Amount of tiles along each screen axis */
+	FIntPoint TileCount = FIntPoint::ZeroValue;
+	/** @brief Indexed entities, grouped by tile after 'FinishBuild' */
+	TArray<FProjectedEntity> Entities;
+	/** @brief Offset of each tiles first entity in 'Entities', with one trailing entry so a tiles range is [TileStarts[Idx], TileStarts[Idx + 1]) */
+	TArray<int32> TileStarts;
+};
+
+/** @brief The cursor projected onto the ground. Sampled at most once per frame and trace channel, every caller during that frame shares the same sample */
+struct FRTSOCursorGroundSample
+{
+	/** @brief Frame the sample was taken on, 'GFrameCounter' */
+	uint64 FrameNumber = MAX_uint64;
+	/** @brief Channel the sample was traced on */
+	TEnumAsByte<ECollisionChannel> TraceChannel = ECC_Visibility;
+	/** @brief Cursor position in viewport pixels, viewport center if there was no mouse input */
+	FVector2D ScreenCoordinates = FVector2D::ZeroVector;
+	/** @brief Ground hit, or a ground plane intersection at the pawns height if nothing was hit */
+	FVector IntersectionPoint = FVector::ZeroVector;
+	/** @brief Hit result of the ground trace. Synthesized when the sample came from the landscape heightfield */
+	FHitResult HitResult{};
+	/** @brief Was there mouse input when the sample was taken */
+	bool bFoundInputType = false;
+};
+
 /** @brief State struct for the godhand pawn */
 USTRUCT(BlueprintType, Blueprintable)
 struct FRTSGodhandState
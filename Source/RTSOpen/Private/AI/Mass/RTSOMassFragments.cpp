@@ -15,8 +15,6 @@ void FRTSOLightInventoryFragmentHandler::TransferItems(FRTSOLightInventoryFragme
 		OtherFragment.Inner.FindOrAdd(Item.Key).TotalItemCount += Item.Value.TotalItemCount;
 		Item.Value.TotalItemCount = 0;
 	}
-	
-	OtherFragment.Inner = Inner;
 }
 
 void FRTSOLightInventoryFragmentHandler::TransferItems(UPDInventoryComponent& OtherInventory)
@@ -11,6 +11,7 @@
 #include "StateTreeExecutionContext.h"
 #include "StateTreeLinker.h"
 #include "AI/Mass/RTSOMassFragments.h"
+#include "PDInteractSubsystem.h"
 #include "Interfaces/PDInteractInterface.h"
 #include "Interfaces/RTSOActionLogInterface.h"
 #include "Pawns/PDRTSBaseUnit.h"
@@ -48,6 +49,7 @@ bool FRTSOTask_Interact::Link(FStateTreeLinker& Linker)
 {
 	Linker.LinkExternalData(EntitySubsystemHandle);
 	Linker.LinkExternalData(InventoryHandle);
+	Linker.LinkExternalData(SignalAggregatorHandle);
 	return true;
 }
 
@@ -57,7 +59,7 @@ EStateTreeRunStatus FRTSOTask_Interact::EnterState(FStateTreeExecutionContext& C
 
 	const FMassStateTreeExecutionContext& MassContext = static_cast<FMassStateTreeExecutionContext&>(Context);
 
-	const FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
 	const FMassEntityHandle& OtherEntityHandle = InstanceData.PotentialEntityHandle;
 	const IPDInteractInterface* OtherInteractable = Cast<IPDInteractInterface>(InstanceData.PotentialInteractableActor);
 	const UMassEntitySubsystem& EntitySubsystem = Context.GetExternalData(EntitySubsystemHandle);
@@ -76,40 +78,35 @@ EStateTreeRunStatus FRTSOTask_Interact::EnterState(FStateTreeExecutionContext& C
 	UPDRTSBaseUnit* UnitHandler = *UnitHandlerDoublePtr;
 	UnitHandler->OnTaskFinished(MassContext.GetEntity()); // Make sure to use this on other tasks
 	
-	if (OtherInteractable != nullptr)
-	{
-		// call interact function on interactables
-		
-		FPDInteractionParamsWithCustomHandling Params;
-		// Temp.CustomInteractionProcessor.BindDynamic(this, );
-		// Temp.InstigatorComponentClass = UPDRTSBaseUnit::StaticClass();
-		// Temp.OptionalInteractionTags;
-
-		AController* InstigatorController = Cast<AController>(
-			RTSSubsystem.SharedOwnerIDMappings.Contains(EntityBase.OwnerID)
-				? RTSSubsystem.SharedOwnerIDMappings.FindRef(EntityBase.OwnerID)
-				: nullptr);
-		Params.InstigatorActor = InstigatorController != nullptr ? InstigatorController->GetPawn() : nullptr;
-		
-		Params.InteractionPercent = 1.01;
-		Params.InstigatorEntity = MassContext.GetEntity();
-
-		EPDInteractResult InteractResult;
-		IPDInteractInterface::Execute_OnInteract(InstanceData.PotentialInteractableActor, Params, InteractResult);
-
-		const FRTSOActionLogEvent NewActionEvent{
-			FString::Printf(TEXT("EntityID(%i) -- Interacted sucessfully with %s "),
-				MassContext.GetEntity().Index, *InstanceData.PotentialInteractableActor->GetName())}; 
-		URTSActionLogSubsystem::DispatchEvent(EntityBase.OwnerID, NewActionEvent);
-		
-		return EStateTreeRunStatus::Succeeded;
-		
-	}
-
-	if (EntitySubsystem.GetEntityManager().IsEntityValid(OtherEntityHandle))
+	const bool bIsValidTargetEntity = EntityManager.IsEntityValid(OtherEntityHandle);
+	if (OtherInteractable != nullptr || bIsValidTargetEntity)
 	{
-		// @todo interact with other entity
-		return EStateTreeRunStatus::Succeeded;
+		// Queue the interaction, the interact subsystem dispatches all of this frames requests to their targets handlers in one go
+		FPDInteractionRequest Request;
+		Request.TargetActor = OtherInteractable != nullptr ? InstanceData.PotentialInteractableActor : nullptr;
+		Request.TargetEntity = OtherInteractable != nullptr ? FMassEntityHandle{} : OtherEntityHandle;
+
+		const AController* InstigatorController = Cast<AController>(RTSSubsystem.SharedOwnerIDMappings.FindRef(EntityBase.OwnerID));
+		Request.Params.InstigatorActor = InstigatorController != nullptr ? InstigatorController->GetPawn() : nullptr;
+		Request.Params.InteractionPercent = 1.01;
+		Request.Params.InstigatorEntity = MassContext.GetEntity();
+
+		// The result is reported by the targets handler, wake the entity up so Tick can pick it up
+		InstanceData.InteractResult = MakeShared<TOptional<EPDInteractResult>>();
+		Request.OnResolved.BindLambda(
+			[WeakResult = TWeakPtr<TOptional<EPDInteractResult>>(InstanceData.InteractResult),
+			 WeakAggregator = TWeakObjectPtr<UPDSignalAggregator>(&Context.GetExternalData(SignalAggregatorHandle)),
+			 Entity = MassContext.GetEntity()](const EPDInteractResult InteractResult)
+			{
+				const TSharedPtr<TOptional<EPDInteractResult>> Result = WeakResult.Pin();
+				if (Result.IsValid() == false) { return; }
+
+				*Result = InteractResult;
+				if (WeakAggregator.IsValid()) { WeakAggregator->SignalEntity(UE::Mass::Signals::StateTreeActivate, Entity); }
+			});
+
+		UPDInteractSubsystem::Get()->RequestInteraction(EntitySubsystem.GetWorld(), MoveTemp(Request));
+		return EStateTreeRunStatus::Running;
 	}
 	
 	const FString InteractionTargetName =
@@ -126,6 +123,38 @@ EStateTreeRunStatus FRTSOTask_Interact::EnterState(FStateTreeExecutionContext& C
 	return EStateTreeRunStatus::Failed;
 }
 
+EStateTreeRunStatus FRTSOTask_Interact::Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const
+{
+	const FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+	if (InstanceData.InteractResult.IsValid() == false) { return EStateTreeRunStatus::Failed; }
+	if (InstanceData.InteractResult->IsSet() == false) { return EStateTreeRunStatus::Running; }
+
+	const FMassStateTreeExecutionContext& MassContext = static_cast<FMassStateTreeExecutionContext&>(Context);
+	const UMassEntitySubsystem& EntitySubsystem = Context.GetExternalData(EntitySubsystemHandle);
+	const FPDMFragment_RTSEntityBase& EntityBase = EntitySubsystem.GetEntityManager().GetFragmentDataChecked<FPDMFragment_RTSEntityBase>(MassContext.GetEntity());
+
+	const EPDInteractResult InteractResult = InstanceData.InteractResult->GetValue();
+	const bool bSucceeded = InteractResult == EPDInteractResult::INTERACT_SUCCESS || InteractResult == EPDInteractResult::INTERACT_DELAYED;
+
+	const FString InteractionTargetName =
+		InstanceData.PotentialInteractableActor != nullptr
+		? *InstanceData.PotentialInteractableActor->GetName()
+		: "Entity(" + FString::FromInt(InstanceData.PotentialEntityHandle.Index) + ")";
+	const FRTSOActionLogEvent NewActionEvent{
+		FString::Printf(bSucceeded ? TEXT("EntityID(%i) -- Interacted sucessfully with %s ") : TEXT("EntityID(%i) -- Failed interaction with %s "),
+			MassContext.GetEntity().Index, *InteractionTargetName)}; 
+	URTSActionLogSubsystem::DispatchEvent(EntityBase.OwnerID, NewActionEvent);
+
+	return bSucceeded ? EStateTreeRunStatus::Succeeded : EStateTreeRunStatus::Failed;
+}
+
+void FRTSOTask_Interact::ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const
+{
+	FMassStateTreeTaskBase::ExitState(Context, Transition);
+	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
+	InstanceData.InteractResult.Reset();
+}
+
 void FRTSOTask_MoveToTarget::OnPathSelected(FPDMFragment_RTSEntityBase& RTSData, bool bShouldUseSharedNavigation, const FVector& LastPoint) const
 {
 	const FRTSOActionLogEvent NewActionEvent{
@@ -19,6 +19,7 @@
 
 /* Permadev - Input */
 #include "Core/RTSOInputStackSubsystem.h"
+#include "Subsystems/RTSOProductionSubsystem.h"
 
 /* Engine - Components */
 #include "Camera/CameraComponent.h"
@@ -149,13 +150,22 @@ void AGodHandPawn::HoverTick(const float DeltaTime)
 	UPDRTSBaseSubsystem* RTSSubsystem = UPDRTSBaseSubsystem::Get();
 	const FVector& QueryLocation = CursorMesh->GetComponentLocation();
 
-	FVector MinimapQueryLocation = QueryLocation;
-	
-	
-	const FPDTraceResult& TraceResult = InteractComponent->GetTraceResult(true, TEXT("LandscapeTrace"));
-	RTSSubsystem->OctreeUserQuery.UpdateQueryPosition(EPDQueryGroups::QUERY_GROUP_MINIMAP, TraceResult.HitResult.Location);
+	// Shares this frames cursor ground sample with every other cursor query, instead of tracing the landscape again
+	const ARTSOController* PC = GetController<ARTSOController>();
+	const FVector MinimapQueryLocation = PC != nullptr ? PC->GetCursorGroundSample().IntersectionPoint : QueryLocation;
+	RTSSubsystem->OctreeUserQuery.UpdateQueryPosition(EPDQueryGroups::QUERY_GROUP_MINIMAP, MinimapQueryLocation);
 	RTSSubsystem->OctreeUserQuery.UpdateQueryPosition(EPDQueryGroups::QUERY_GROUP_HOVERSELECTION, QueryLocation);
-	
+
+	FRTSOHoverInputs HoverInputs;
+	HoverInputs.CursorLocation = Collision->GetComponentLocation();
+	HoverInputs.CameraLocation = Camera->GetComponentLocation();
+	HoverInputs.CameraRotation = Camera->GetComponentQuat();
+	HoverInputs.ActorPopulationVersion = HoverActorPopulationVersion;
+	HoverInputs.EntityPopulationSignature = RTSSubsystem->OctreeUserQuery.GetQueryBufferEntitySignature(EPDQueryGroups::QUERY_GROUP_HOVERSELECTION);
+	if (HoverCandidates.IsStale(HoverInputs))
+	{
+		RebuildHoverCandidates(HoverInputs);
+	}
 	
 	AActor* ClosestActor = FindClosestInteractableActor();
 	// Overwrite HoveredActor if they are not the same
@@ -250,37 +260,19 @@ void AGodHandPawn::BuildableGhostTick(float DeltaTime)
 		}
 	}
 
-	// Check for encroachment/overlap 
+	// Check for encroachment, test the ghosts footprint against the builder subsystems occupancy grid 
 	if (CurrentGhost->GetClass()->ImplementsInterface(UPDRTSBuildableGhostInterface::StaticClass()))
 	{
-		CurrentGhost->SetActorEnableCollision(true);
-		TArray<UStaticMeshComponent*> OverlapMeshes = IPDRTSBuildableGhostInterface::Execute_GetGhostMeshes(CurrentGhost);
-		
-		bool bIsEncroached = false;
-		for (UStaticMeshComponent* Mesh : OverlapMeshes)
+		FBox GhostFootprint(ForceInit);
+		for (const UStaticMeshComponent* Mesh : IPDRTSBuildableGhostInterface::Execute_GetGhostMeshes(CurrentGhost))
 		{
-			Mesh->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-			TArray<AActor*> OverlappedActors;
-			Mesh->GetOverlappingActors(OverlappedActors);
-			Mesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-
-			// UE_LOG(PDLog_RTSO, Warning, TEXT("AGodHandPawn::TickGhost -- Encroachment -- Check for overlap"))
-			for (const AActor* OverlappedActor : OverlappedActors)
-			{
-				if (OverlappedActor == CurrentGhost) { continue; }
-				
-				UE_LOG(PDLog_RTSO, Warning, TEXT("AGodHandPawn::TickGhost -- Encroachment -- Comparing with found component"))
-				if (OverlappedActor->GetClass()->ImplementsInterface(UPDRTSBuildableGhostInterface::StaticClass()))
-				{
-					UE_LOG(PDLog_RTSO, Warning, TEXT("AGodHandPawn::TickGhost -- Encroachment -- Failed check, is overlapping actor"))
-					bIsEncroached = true;
-					break;
-				}
-			}
+			if (Mesh == nullptr) { continue; }
+			GhostFootprint += Mesh->Bounds.GetBox();
 		}
-	
+
+		UPDBuilderSubsystem* BuilderSubsystem = UPDBuilderSubsystem::Get();
+		const bool bIsEncroached = BuilderSubsystem->ValidatePlacement(GetWorld(), GhostFootprint, GhostFootprintCells) == false;
 		IPDRTSBuildableGhostInterface::Execute_SetGhostAsEncroached(CurrentGhost, bIsEncroached);
-		CurrentGhost->SetActorEnableCollision(false);
 	}
 
 	// Previously hidden ghost unhidden
@@ -484,14 +476,8 @@ void AGodHandPawn::ActionDragMove_Implementation(const FInputActionValue& Value)
 // todo Refactor
 bool AGodHandPawn::ClickPotentialBuildable(ARTSOController* PC)
 {
-	// trace to
-	FCollisionQueryParams Params;
-	Params.MobilityType = EQueryMobilityType::Static;
-	Params.AddIgnoredActors(TArray<AActor*>{PC, this});
-	const FVector2D ScreenCoordinates = PC->GetMouseScreenCoords();
-
-	FHitResult HitResult{};
-	PC->GetHitResultAtScreenPosition(ScreenCoordinates, ECC_Visibility, Params, HitResult);
+	// Reuses this frames cursor sample on the visibility channel, it ignores the controller and pawn and only hits static geometry
+	const FHitResult& HitResult = PC->GetCursorGroundSample(ECC_Visibility).HitResult;
 	AActor* HitActor = HitResult.GetActor();
 
 	// Poor mans double click @todo refactor
@@ -750,9 +736,7 @@ bool AGodHandPawn::AttemptSelectSingleUnit()
 	{
 		ResetPathParameters();
 
-		TMap<int32, FMassEntityHandle> PassThroughHandle;
-		PassThroughHandle.Emplace(InstanceState.SelectedWorkerUnitHandle.Index, InstanceState.SelectedWorkerUnitHandle);
-		PC->GetMutableMarqueeSelectionMap().FindOrAdd(PC->GeneratedGroupID(), PassThroughHandle);
+		PC->GetMutableSelectionGroups().SetGroup(PC->GeneratedGroupID(), TArray<FMassEntityHandle>{InstanceState.SelectedWorkerUnitHandle});
 		PC->OnSelectionChange(false);
 		PC->OnMarqueeSelectionUpdated( INDEX_NONE, {InstanceState.SelectedWorkerUnitHandle.Index});
 		return true;
@@ -880,7 +864,7 @@ void AGodHandPawn::ActionMoveSelection_Implementation(const FInputActionValue& V
 	}
 	
 	const int32 CurrentGroupID = PC->GetCurrentGroupID();
-	if (PC->GetImmutableMarqueeSelectionMap().Contains(CurrentGroupID) == false)
+	if (PC->GetSelectionGroups().Contains(CurrentGroupID) == false)
 	{
 		PC->ProcessPotentialBuildableMenu(InstanceState.HoveredActor);
 		return;
@@ -925,20 +909,14 @@ void AGodHandPawn::ActionMoveSelection_Implementation(const FInputActionValue& V
 		? IPDInteractInterface::Execute_GetGenericTagContainer(InstanceState.WorkerUnitActionTarget)
 		: FallbackContainer;
 	
-	const FHitResult& Start = PC->GetLatestStartHitResult();
 	const FHitResult& Center = PC->GetLatestCenterHitResult();
-	const FHitResult& End    = PC->GetLatestEndHitResult();
-	const FVector StartLocation =
-		Center.bBlockingHit  ? Center.Location
-		: Start.bBlockingHit ? Start.Location
-		: End.bBlockingHit   ? StartLocation
-		: PD::Constants::INVALID_WORLD_LOC;
+	const FVector StartLocation = Center.bBlockingHit ? Center.Location : PD::Constants::INVALID_WORLD_LOC;
 	
 	Cast<UPDRTSBaseUnit>(ISMs[0])->RequestActionMulti(
 		PC->GetActorID(),
 		OptTarget,
 		AssociatedTags.GetByIndex(0),
-		*PC->GetImmutableMarqueeSelectionMap().Find(CurrentGroupID), 
+		*PC->GetSelectionGroups().FindGroup(CurrentGroupID), 
 		StartLocation,
 		CurrentGroupID);
 }
@@ -1009,10 +987,15 @@ FMassEntityHandle AGodHandPawn::OctreeEntityTrace_DEPRECATED(const FVector& Star
 
 AActor* AGodHandPawn::FindClosestInteractableActor() const
 {
+	return HoverCandidates.GetClosestActor();
+}
+
+void AGodHandPawn::RebuildHoverCandidates(const FRTSOHoverInputs& Inputs)
+{
+	TArray<FRTSOHoverCandidate> NewCandidates;
+	
 	TArray<AActor*> Overlap;
 	Collision->GetOverlappingActors(Overlap);
-	
-	AActor* ClosestActor = nullptr;
 	for (AActor* FoundActor : Overlap)
 	{
 		if (FoundActor == nullptr || FoundActor->GetClass()->ImplementsInterface(UPDInteractInterface::StaticClass()) == false)
@@ -1023,21 +1006,36 @@ AActor* AGodHandPawn::FindClosestInteractableActor() const
 		{
 			continue;
 		}
+		
+		NewCandidates.Emplace(FRTSOHoverCandidate::MakeActor(FoundActor, FVector::DistSquared(FoundActor->GetActorLocation(), Inputs.CursorLocation)));
+	}
 
-		if (ClosestActor == nullptr)
-		{
-			ClosestActor = FoundActor;
-			continue;
-		}
+	// Query the entity octree directly at the current cursor location, so nothing is read from a query buffer built against a previous cursor location
+	const UPDRTSBaseSubsystem* RTSBaseSubsystem = UPDRTSBaseSubsystem::Get();
+	if (EntityManager != nullptr && RTSBaseSubsystem != nullptr)
+	{
+		const double HoverRadius = Collision->GetScaledSphereRadius();
+		const int32 BuilderID = IPDRTSBuilderInterface::Execute_GetBuilderID(this);
 		
-		const float LengthToOldActor = (ClosestActor->GetActorLocation() - Collision->GetComponentLocation()).Length();
-		const float LengthToNewActor = (FoundActor->GetActorLocation() - Collision->GetComponentLocation()).Length();
-		if (LengthToNewActor < LengthToOldActor)
-		{
-			ClosestActor = FoundActor; // <- find closest actor and store in this
-		}
+		RTSBaseSubsystem->WorldEntityOctree.FindElementsWithBoundsTest(
+			FBoxCenterAndExtent{Inputs.CursorLocation, FVector{HoverRadius}},
+			[&](const FPDEntityOctreeCell& Cell)
+			{
+				if (EntityManager->IsEntityValid(Cell.EntityHandle) == false) { return; }
+
+				// Don't allow handling entities we do not own
+				const FPDMFragment_RTSEntityBase* RTSEntity = EntityManager->GetFragmentDataPtr<FPDMFragment_RTSEntityBase>(Cell.EntityHandle);
+				const FTransformFragment* TransformFragment = EntityManager->GetFragmentDataPtr<FTransformFragment>(Cell.EntityHandle);
+				if (RTSEntity == nullptr || TransformFragment == nullptr || RTSEntity->OwnerID != BuilderID) { return; }
+
+				const double DistanceSquared = FVector::DistSquared(TransformFragment->GetTransform().GetLocation(), Inputs.CursorLocation);
+				if (DistanceSquared > HoverRadius * HoverRadius) { return; }
+				
+				NewCandidates.Emplace(FRTSOHoverCandidate::MakeEntity(Cell.EntityHandle, DistanceSquared));
+			});
 	}
-	return ClosestActor;
+	
+	HoverCandidates.Rebuild(Inputs, MoveTemp(NewCandidates));
 }
 
 const FTransform& AGodHandPawn::GetEntityTransform(const FMassEntityHandle& Handle) const
@@ -1057,29 +1055,9 @@ int32 AGodHandPawn::GetEntityOwnerID(const FMassEntityHandle& Handle) const
 
 FMassEntityHandle AGodHandPawn::FindClosestMassEntity() const
 {
-	const UPDRTSBaseSubsystem* RTSBaseSubsystem = UPDRTSBaseSubsystem::Get();
-	FQueryResult_LocAndId LocAndId = RTSBaseSubsystem->OctreeUserQuery.ReadQueryBufferFromEnd<EPDQueryGroups::QUERY_GROUP_HOVERSELECTION>(0);
-	if (LocAndId.Location == FVector{})
-	{
-		return FMassEntityHandle{0,0};
-	}
-
-	// Temporary work-around to resolve edge-case created by fixing a data-race in the query buffer 
-	// Ensure that it is not a hovered entity from a previous frame still lingering in the query buffer
-	const FVector DeltaV = Collision->GetComponentLocation() - LocAndId.Location;
-	if (DeltaV.IsNearlyZero(50.0) == false)
-	{
-		return FMassEntityHandle{0,0};
-	}
-
-	// Don't allow handling entities we do not own
-	AGodHandPawn* MutableThis = const_cast<AGodHandPawn*>(this);
-	if (LocAndId.OwnerID != IPDRTSBuilderInterface::Execute_GetBuilderID(MutableThis))
-	{
-		return FMassEntityHandle{0,0};
-	}
+	if (EntityManager == nullptr) { return FMassEntityHandle{0,0}; }
 	
-	return LocAndId.EntityHandle; 
+	return HoverCandidates.GetClosestEntity(*EntityManager, Collision->GetComponentLocation(), Collision->GetScaledSphereRadius()); 
 }
 
 //
@@ -1255,6 +1233,12 @@ void AGodHandPawn::PerformAction_Destroy(const TArray<uint8>& Payload)
 		URTSActionLogSubsystem::DispatchEvent(InstigatorID, NewActionEvent);		
 	}
 	
+	// Refund anything the building still had queued
+	if (URTSOProductionSubsystem* ProductionSubsystem = URTSOProductionSubsystem::Get(this))
+	{
+		ProductionSubsystem->CancelAllProduction(BuildableActionsWidget->CurrentWorldActor);
+	}
+	
 	BuildableActionsWidget->DestroyCurrentWorldActor();	
 }
 
@@ -1334,48 +1318,21 @@ void AGodHandPawn::SelectActionMenuEntry_Implementation(ERTSBuildableActionMenuM
 				// done 0. default to a single spawn if we have no payload instructing us how many we should spawn 
 				uint32 SpawnCount = Payload.IsValidIndex(3) ? RESTORE_BYTE(Payload, 0) | RESTORE_BYTE(Payload, 1) | RESTORE_BYTE(Payload, 2) | RESTORE_BYTE(Payload, 3) : 1;
 				
-				// @DONE 0. Ensure we afford the action
-				if (InventoryComponent->CanAfford((*FoundActionData)->ActionCost), SpawnCount)
+				// Reserves the cost for all units up-front, the production subsystem spawns them once their production time has passed.
+				// Completed units from all buildings are spawned together in one batch per entity template  
+				AActor* ProducingBuilding = PC->GetBuildableActionsWidget()->CurrentWorldActor;
+				URTSOProductionSubsystem* ProductionSubsystem = URTSOProductionSubsystem::Get(this);
+				const int32 BuilderID = IPDRTSBuilderInterface::Execute_GetBuilderID(this);
+				if (ProductionSubsystem != nullptr
+					&& ProductionSubsystem->EnqueueProduction(ProducingBuilding, **FoundActionData, BuilderID, static_cast<int32>(SpawnCount), InventoryComponent))
 				{
-					// @DONE 1. Need to select a entity config and use it to spawn
-					// @DONE 2. Will need some mapping between unit-type tags and their entity configs, multiple unit-type tags may share the same configs
-					// @DONE 3. Spawn here now that have validated that the worker is valid type
-					// @todo 4. need a spawn queue and unit spawn rules, timings and such
-					
-
-					// @todo Need to generalize the spawn logic
-					UPDRTSBaseSubsystem* RTSSubsystem = UPDRTSBaseSubsystem::Get();
-					UMassSpawnerSubsystem* SpawnerSystem = UWorld::GetSubsystem<UMassSpawnerSubsystem>(GetWorld());
-					if (EntityManager == nullptr) { return; }
-				
-
-					TMap<const FMassEntityTemplateID, ARTSOBaseGM::FEntityCompoundTuple> EntitiesToSpawn{};
-
-					// Gather entities to spawn
-					FRTSSavedWorldUnits ConstructedEntityData{};
-					ConstructedEntityData.EntityUnitTag = ActionTag;
-					ConstructedEntityData.OwnerID = IPDRTSBuilderInterface::Execute_GetBuilderID(this);
-					
-					// @todo need to offset the actor location, right now it spawns in the middle of it
-					ConstructedEntityData.Location = PC->GetBuildableActionsWidget()->CurrentWorldActor->GetActorLocation();
-					for (uint32 SpawnIdx = 0; SpawnIdx < SpawnCount; SpawnIdx++)
+					if (GetController()->GetClass()->ImplementsInterface(UPDRTSBuilderInterface::StaticClass()))
 					{
-						ARTSOBaseGM::GatherEntityToSpawn(*GetWorld(), ConstructedEntityData, EntitiesToSpawn, RTSSubsystem, SpawnerSystem);
-					}
-
-					// Dispatch spawning of entities
-					for (const TTuple<const FMassEntityTemplateID, ARTSOBaseGM::FEntityCompoundTuple>& EntityTypeCompound : EntitiesToSpawn)
-					{
-						ARTSOBaseGM::DispatchEntitySpawning(EntityTypeCompound, EntityManager, SpawnerSystem);
-						
-						if (GetController()->GetClass()->ImplementsInterface(UPDRTSBuilderInterface::StaticClass()))
-						{
-							const int32 InstigatorID = IPDRTSBuilderInterface::Execute_GetBuilderID(GetController());
-							const FRTSOActionLogEvent NewActionEvent{
-								FString::Printf(TEXT("OwnerID(%i) -- Successfully Spawning entity of type %s "),
-									IPDRTSBuilderInterface::Execute_GetBuilderID(this), *ActionTag.GetTagName().ToString())}; 
-							URTSActionLogSubsystem::DispatchEvent(InstigatorID, NewActionEvent);		
-						}						
+						const int32 InstigatorID = IPDRTSBuilderInterface::Execute_GetBuilderID(GetController());
+						const FRTSOActionLogEvent NewActionEvent{
+							FString::Printf(TEXT("OwnerID(%i) -- Queued %u entities of type %s "),
+								BuilderID, SpawnCount, *ActionTag.GetTagName().ToString())}; 
+						URTSActionLogSubsystem::DispatchEvent(InstigatorID, NewActionEvent);		
 					}
 				}
 				else
@@ -1443,6 +1400,7 @@ void AGodHandPawn::PossessedBy(AController* NewController)
 void AGodHandPawn::OnCollisionBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult & SweepResult)
 {
 	UE_LOG(PDLog_RTSO, Warning, TEXT("AGodHandPawn::OnCollisionBeginOverlap"))
+	HoverActorPopulationVersion++;
 	
 	// neither an ai or any interactable
 	if (Cast<IPDInteractInterface>(OtherActor) == nullptr) { return; }
@@ -1451,6 +1409,8 @@ void AGodHandPawn::OnCollisionBeginOverlap(UPrimitiveComponent* OverlappedCompon
 
 void AGodHandPawn::ActorEndOverlapValidation()
 {
+	HoverActorPopulationVersion++;
+	
 	TArray<AActor*> Overlap;
 	GetOverlappingActors(Overlap, AActor::StaticClass());
 	InstanceState.HoveredActor = Overlap.IsEmpty() ? nullptr : InstanceState.HoveredActor;
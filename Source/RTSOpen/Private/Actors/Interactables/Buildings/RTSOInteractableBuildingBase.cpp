@@ -59,6 +59,15 @@ void ARTSOInteractableBuildingBase::BeginPlay()
 	
 	RefreshStaleSettings<true>(); // Refresh ghost
 	RefreshStaleSettings<false>(); // Refresh main
+
+	// Placed ghosts and completed buildings block placement, the preview ghost deregisters itself in OnSpawnedAsGhost
+	UPDBuilderSubsystem::Get()->RegisterOccupant(this);
+}
+
+void ARTSOInteractableBuildingBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UPDBuilderSubsystem::Get()->DeregisterOccupantByID(GetUniqueID());
+	Super::EndPlay(EndPlayReason);
 }
 
 void ARTSOInteractableBuildingBase::BeginDestroy()
@@ -316,6 +325,11 @@ void ARTSOInteractableBuildingBase::ProcessSpawn()
 	SetActorEnableCollision(SelectedSettings.bIsActorCollisionEnabled);
 
 	bIsGhost_noSerialize = TIsGhost;
+
+	// BeginPlay registered the footprint before the ghost/main mesh was settled, re-register with the final bounds.
+	// Preview ghosts are deregistered again by OnSpawnedAsGhost
+	UPDBuilderSubsystem::Get()->RegisterOccupant(this);
+	
 	if constexpr (TIsGhost == false)
 	{
 		OnBuildSuccessful(GetOwner());
@@ -469,6 +483,7 @@ void ARTSOInteractableBuildingBase::OnBuildingDestroyed_Implementation()
 	UPDBuilderSubsystem* BuilderSubsystem = UPDBuilderSubsystem::Get();
 	ensure(BuilderSubsystem != nullptr);
 	BuilderSubsystem->QueueRemoveFromWorldBuildTree(GetUniqueID());
+	BuilderSubsystem->DeregisterOccupantByID(GetUniqueID());
 
 	const AGodHandPawn* AsGodhand = Cast<AGodHandPawn>(GetOwner());
 	const ARTSOController* PC = AsGodhand != nullptr ? AsGodhand->GetController<ARTSOController>() : nullptr;
@@ -530,7 +545,11 @@ void ARTSOInteractableBuildingBase::OnSpawnedAsGhost_Implementation(const FGamep
 	ProcessSpawn<true>();
 
 	bIsPreviewGhost = bInIsPreviewGhost;
-	if (bIsPreviewGhost)  { return; };
+	if (bIsPreviewGhost)
+	{
+		UPDBuilderSubsystem::Get()->DeregisterOccupant(this);
+		return;
+	}
 	
 	if (bInRequiresWorkersToBuild)
 	{
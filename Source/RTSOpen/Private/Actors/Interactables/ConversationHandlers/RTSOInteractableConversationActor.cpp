@@ -39,7 +39,7 @@ void FRTSOConversationMetaState::ApplyValuesFromProgressionTable(FRTSOConversati
 	// ProgressionPerPlayer = ConversationProgressionEntry.BaseProgression;
 	MissionTag = ConversationProgressionEntry.MissionTag;
 	PhaseRequiredTags = ConversationProgressionEntry.PhaseRequiredTags;
-	
+	FRTSOConversationRules::BuildRequiredTagMasks(PhaseRequiredTags);
 }
 
 ARTSOInteractableConversationActor::ARTSOInteractableConversationActor()
@@ -94,9 +94,10 @@ void URTSOConversationInstance::OnChoiceNodePickedByUser(const FConversationCont
 	// @note Store selected tags on server
 	ARTSOBaseGM* GM = GetWorld() != nullptr ? GetWorld()->GetAuthGameMode<ARTSOBaseGM>() : nullptr;
 	if (GM == nullptr || ListenerAsController == nullptr) { return; }
-	GM->GameSave->Data.PlayersAndConversationTags.FindOrAdd(ListenerAsController->GetActorID()).AppendTags(ChoiceNode->ChoiceTags);
-	
 	IRTSOConversationInterface::Execute_AddProgressionTagContainer(ListenerAsController->GetPawn(), ChoiceNode->ChoiceTags);
+
+	// Flushes only the logged tag changes into the save-data
+	GM->SaveConversationProgression();
 }
 
 //
@@ -196,6 +197,7 @@ void ARTSOInteractableConversationActor::BeginPlay()
 		FRTSOConversationMetaState& MetaProgressState = InstanceDataPerMission.FindOrAdd(BaseMetaProgressDatum->MissionTag);
 		MetaProgressState.MissionTag = BaseMetaProgressDatum->MissionTag;
 		MetaProgressState.PhaseRequiredTags = BaseMetaProgressDatum->PhaseRequiredTags;
+		FRTSOConversationRules::BuildRequiredTagMasks(MetaProgressState.PhaseRequiredTags);
 
 		AttemptInitializeFirstPlayerMission(INDEX_NONE, BaseMetaProgressDatum->MissionTag);
 		
@@ -455,7 +457,7 @@ ERTSOConversationState ARTSOInteractableConversationActor::ValidateRequiredTags(
 	}
 	FRTSOConversationMetaState& MetaProgressState = *InstanceDataPerMissionPtr->Find(CurrentMission);
 	
-	const FGameplayTagContainer& ActorTagSet = Cast<IRTSOConversationInterface>(AsCallingPawn)->GetProgressionTags();
+	const IRTSOConversationInterface* CallerInterface = Cast<IRTSOConversationInterface>(AsCallingPawn);
 	const int32 LastConversationProgressionIndex = MetaProgressState.PhaseRequiredTags.Num();
 	int32 ConversationProgressionLevel = 0;
 
@@ -485,15 +487,9 @@ ERTSOConversationState ARTSOInteractableConversationActor::ValidateRequiredTags(
 			return ERTSOConversationState::CurrentStateCompleted;
 		}
 		
-		// Wish epic had implemented some form of set comparator function, they might have need to look at the TSet implementation
-		// but in-case it would be an mmo with lets say 5-10 thousand players at most we can expect that many conversations to be held as a max limit,
-		// and should be easy for the servers to handle.
-		// Realistically at a given moment the amount of validation calls will likely by much fewer
-		bool bFoundAllRequiredTags = true; // Default to true if there are no requirements
-		for (const FGameplayTag& RequiredTag : RequiredRules.RequiredTags)
-		{
-			bFoundAllRequiredTags &= ActorTagSet.HasTag(RequiredTag); // Needs them all to exist in the actor tag set
-		}
+		// Required tags are interned into a mask when the rules are loaded, so this is a word-wise AND and compare against the callers bitset.
+		// An empty mask always passes, defaulting to true if there are no requirements
+		const bool bFoundAllRequiredTags = CallerInterface->HasAllProgressionTags(RequiredRules.GetRequiredTagMask());
 		ValidatedTagState = bFoundAllRequiredTags ?
 			ERTSOConversationState::Valid : ERTSOConversationState::Invalid;
 
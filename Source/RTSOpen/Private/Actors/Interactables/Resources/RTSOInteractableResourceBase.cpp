@@ -4,6 +4,7 @@
 #include "MassEntitySubsystem.h"
 #include "PDInventorySubsystem.h"
 #include "PDItemCommon.h"
+#include "PDBuilderSubsystem.h"
 #include "PDRTSCommon.h"
 #include "AI/Mass/RTSOMassFragments.h"
 #include "Components/PDInventoryComponent.h"
@@ -42,6 +43,15 @@ void ARTSOInteractableResourceBase::BeginPlay()
 
 	EntitySubsystem = GetWorld()->GetSubsystem<UMassEntitySubsystem>();
 	EntManager = &EntitySubsystem->GetEntityManager();
+
+	// Resources block building placement
+	UPDBuilderSubsystem::Get()->RegisterOccupant(this);
+}
+
+void ARTSOInteractableResourceBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UPDBuilderSubsystem::Get()->DeregisterOccupant(this);
+	Super::EndPlay(EndPlayReason);
 }
 
 void ARTSOInteractableResourceBase::Tick(float DeltaTime)
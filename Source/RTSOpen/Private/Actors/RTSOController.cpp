@@ -16,6 +16,11 @@
 // PDRTS -- MassAI
 #include "AI/Mass/PDMassFragments.h"
 #include "AI/Mass/PDMassProcessors.h"
+#include "MassCommandBuffer.h"
+#include "MassCommonFragments.h"
+#include "MassEntitySubsystem.h"
+#include "MassExecutionContext.h"
+#include "MassRepresentationFragments.h"
 
 // EI
 #include "EnhancedInputComponent.h"
@@ -29,9 +34,19 @@
 #include "Chaos/DebugDrawQueue.h"
 #include "Components/TileView.h"
 #include "Kismet/KismetMathLibrary.h"
+#include "SceneView.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/GameViewportClient.h"
 #include "Misc/CString.h"
 #include "SaveEditor/RTSOSaveEditorWidget.h"
 #include "Widgets/Slate/SRTSOActionLog.h"
+#include "EngineUtils.h"
+#include "LandscapeProxy.h"
+
+DECLARE_STATS_GROUP(TEXT("RTSO Cursor"), STATGROUP_RTSOCursor, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cursor ground requests"), STAT_RTSOCursorGroundRequests, STATGROUP_RTSOCursor);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cursor ground traces"), STAT_RTSOCursorGroundTraces, STATGROUP_RTSOCursor);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cursor heightfield samples"), STAT_RTSOCursorHeightfieldSamples, STATGROUP_RTSOCursor);
 
 ARTSOController::ARTSOController(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer), bIsDrawingMarquee(0)
@@ -46,6 +61,10 @@ ARTSOController::ARTSOController(const FObjectInitializer& ObjectInitializer)
 	MappingContexts.Emplace(TAG_CTRL_Ctxt_DragMove);
 	MappingContexts.Emplace(TAG_CTRL_Ctxt_BuildMode);
 
+	ScreenSelectionQuery.AddRequirement<FPDMFragment_RTSEntityBase>(EMassFragmentAccess::ReadOnly);
+	ScreenSelectionQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+	ScreenSelectionQuery.AddRequirement<FMassRepresentationLODFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
+
 	HitResultTraceDistance = 10000000.0;
 }
 
@@ -62,6 +81,10 @@ void ARTSOController::BeginPlay()
 	
 	RefreshOrAddNewID();
 
+	// Streamed levels can bring or take landscapes with them, re-gather them for the heightfield sampling
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &ARTSOController::OnWorldLevelsChanged);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &ARTSOController::OnWorldLevelsChanged);
+
 	if (MMWidgetClass->IsValidLowLevelFast())
 	{
 		MainMenuWidget = CreateWidget<URTSOMainMenuBase>(this, MMWidgetClass);
@@ -106,6 +129,9 @@ void ARTSOController::BeginPlay()
 
 void ARTSOController::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	
 	UPDRTSBaseSubsystem* RTSSubsystem = UPDRTSBaseSubsystem::Get();
 	TMap<AActor*, int32>& ActorToIDMap =  RTSSubsystem->SharedOwnerIDBackMappings;
 	TMap<int32, AActor*>& IDToActorMap =  RTSSubsystem->SharedOwnerIDMappings;
@@ -306,7 +332,7 @@ void ARTSOController::ActionClearSelection_Implementation(const FInputActionValu
 	IRTSOInputInterface::ActionClearSelection_Implementation(Value);
 
 	OnSelectionChange(true);
-	MarqueeSelectedHandles.Remove(CurrentSelectionID);
+	SelectionGroups.RemoveGroup(CurrentSelectionID);
 	OnMarqueeSelectionUpdated(CurrentSelectionID, EmptyKeys);
 
 	BuildableActionsWidget->SetNewWorldActor(nullptr, FPDBuildable{});
@@ -371,7 +397,7 @@ void ARTSOController::ActionAssignSelectionToHotkey_Implementation(const FInputA
 	const int32 ImmutableIndex = Tail;
 	
 	UE_LOG(PDLog_RTSO, Warning, TEXT("ARTSOController::ActionAssignSelectionToHotkey : Requested ID : %i"), ImmutableIndex);
-	const bool bShouldSet = MarqueeSelectedHandles.Contains(CurrentSelectionID);
+	const bool bShouldSet = SelectionGroups.Contains(CurrentSelectionID);
 	if (bShouldSet)
 	{
 		UE_LOG(PDLog_RTSO, Warning, TEXT("ARTSOController::ActionAssignSelectionToHotkey : Should assign, OldID: %i, NewID: %i"), CurrentSelectionID, ImmutableIndex);
@@ -382,11 +408,10 @@ void ARTSOController::ActionAssignSelectionToHotkey_Implementation(const FInputA
 		
 		// Dispatch to BP, for visual effects and n();, and as such we only want to know the groupID if it is a explicitly stored hotkey
 		TArray<int32> Keys;
-		const TMap<int32, FMassEntityHandle>& FoundHandleMap = MarqueeSelectedHandles.FindRef(ImmutableIndex);
-		if (FoundHandleMap.IsEmpty() == false)
+		SelectionGroups.GetGroupEntityIndices(ImmutableIndex, Keys);
+		if (Keys.IsEmpty() == false)
 		{
 			UE_LOG(PDLog_RTSO, Warning, TEXT("ARTSOController::ActionAssignSelectionToHotkey - Calling 'OnMarqueeSelectionUpdated' : (Head) Requested ID : %i"), CurrentSelectionID);
-			FoundHandleMap.GenerateKeyArray(Keys);
 
 			OnSelectionChange(false); 
 			OnMarqueeSelectionUpdated( ImmutableIndex, Keys);
@@ -400,7 +425,7 @@ void ARTSOController::ActionAssignSelectionToHotkey_Implementation(const FInputA
 		UE_LOG(PDLog_RTSO, Warning, TEXT("ARTSOController::ActionAssignSelectionToHotkey : Should remove assignment"));
 
 		HotKeyedSelectionGroups.Remove(ImmutableIndex);
-		MarqueeSelectedHandles.Remove(ImmutableIndex);
+		SelectionGroups.RemoveGroup(ImmutableIndex);
 		OnMarqueeSelectionUpdated(INDEX_NONE, {});
 	}
 	
@@ -436,16 +461,15 @@ void ARTSOController::ActionHotkeySelection_Implementation(const FInputActionVal
 	//
 	// Handle selection
 	UE_LOG(PDLog_RTSO, Warning, TEXT("ARTSOController::ActionHotkeySelection : (Head) Requested ID : %i"), CurrentSelectionID);
-	if (MarqueeSelectedHandles.Contains(CurrentSelectionID))
+	if (SelectionGroups.Contains(CurrentSelectionID))
 	{
 		// Dispatch to BP, for visual effects and n();, and as such we only want to know the groupID if it is a explicitly stored hotkey
 		const int32 SelectedGID = *HotKeyedSelectionGroups.Find(CurrentSelectionID);
 		TArray<int32> Keys;
-		const TMap<int32, FMassEntityHandle>* FoundHandleMap = MarqueeSelectedHandles.Find(CurrentSelectionID);
-		if (FoundHandleMap != nullptr && FoundHandleMap->IsEmpty() == false)
+		SelectionGroups.GetGroupEntityIndices(CurrentSelectionID, Keys);
+		if (Keys.IsEmpty() == false)
 		{
 			UE_LOG(PDLog_RTSO, Warning, TEXT("ARTSOController::ActionHotkeySelection - Calling 'OnMarqueeSelectionUpdated' : (Head) Requested ID : %i"), CurrentSelectionID);
-			FoundHandleMap->GenerateKeyArray(Keys);
 			OnSelectionChange(false); 
 			OnMarqueeSelectionUpdated( SelectedGID, Keys);
 		}
@@ -626,48 +650,32 @@ FInputActionValue UInputModifierIntegerPassthrough::ModifyRaw_Implementation(con
 
 //
 // Mouse projections and marquee selection
-void ARTSOController::ProjectMouseToGroundPlane(FVector2D& ScreenCoordinates, FVector& IntersectionPoint, bool& bFoundInputType) const
+const FRTSOCursorGroundSample& ARTSOController::GetCursorGroundSample() const
 {
-	ProjectMouseToGroundPlane(DedicatedLandscapeTraceChannel, ScreenCoordinates, IntersectionPoint, bFoundInputType);
+	return GetCursorGroundSample(DedicatedLandscapeTraceChannel);
 }
 
-void ARTSOController::ProjectMouseToGroundPlane(TEnumAsByte<ECollisionChannel> OverrideTraceChannel, FVector2D& ScreenCoordinates, FVector& IntersectionPoint, bool& bFoundInputType) const
+const FRTSOCursorGroundSample& ARTSOController::GetCursorGroundSample(TEnumAsByte<ECollisionChannel> TraceChannel) const
 {
-	const FHitResult& Result = ProjectMouseToGroundPlane(OverrideTraceChannel, ScreenCoordinates, bFoundInputType);
-	if (Result.bBlockingHit)
+	INC_DWORD_STAT(STAT_RTSOCursorGroundRequests);
+	
+	FRTSOCursorGroundSample* Sample = CursorGroundSamples.FindByPredicate(
+		[TraceChannel](const FRTSOCursorGroundSample& Existing) { return Existing.TraceChannel == TraceChannel; });
+	if (Sample == nullptr)
 	{
-		IntersectionPoint = Result.Location;
-		return;
+		Sample = &CursorGroundSamples.AddDefaulted_GetRef();
+		Sample->TraceChannel = TraceChannel;
 	}
 	
-	FVector WorldLocation{}, WorldDirection{};
-	DeprojectScreenPositionToWorld(ScreenCoordinates.X, ScreenCoordinates.Y, WorldLocation, WorldDirection);
-	IntersectionPoint = FMath::LinePlaneIntersection(
-	WorldLocation, 
-	WorldLocation + (WorldDirection * 10000000.0),
-	GetPawn()->GetActorLocation(),
-	FVector{0.0, 0.0, 1.0});
-}
-
-void ARTSOController::ProjectMouseToGroundPlane(FHitResult& HitResult, TEnumAsByte<ECollisionChannel> OverrideTraceChannel, FVector2D& ScreenCoordinates, FVector& IntersectionPoint, bool& bFoundInputType) const
-{
-	HitResult = ProjectMouseToGroundPlane(OverrideTraceChannel, ScreenCoordinates, bFoundInputType);
-	if (HitResult.bBlockingHit)
+	if (Sample->FrameNumber != GFrameCounter)
 	{
-		IntersectionPoint = HitResult.Location;
-		return;
+		SampleCursorGround(*Sample);
+		Sample->FrameNumber = GFrameCounter;
 	}
-	
-	FVector WorldLocation{}, WorldDirection{};
-	DeprojectScreenPositionToWorld(ScreenCoordinates.X, ScreenCoordinates.Y, WorldLocation, WorldDirection);
-	IntersectionPoint = FMath::LinePlaneIntersection(
-	WorldLocation, 
-	WorldLocation + (WorldDirection * 10000000.0),
-	GetPawn()->GetActorLocation(),
-	FVector{0.0, 0.0, 1.0});
+	return *Sample;
 }
 
-FHitResult ARTSOController::ProjectMouseToGroundPlane(TEnumAsByte<ECollisionChannel> OverrideTraceChannel, FVector2D& ScreenCoordinates, bool& bFoundInputType) const
+void ARTSOController::SampleCursorGround(FRTSOCursorGroundSample& Sample) const
 {
 	// Lock projection to center screen
 	int32 SizeX = 0, SizeY = 0;
@@ -678,18 +686,137 @@ FHitResult ARTSOController::ProjectMouseToGroundPlane(TEnumAsByte<ECollisionChan
 	// Mouse viewport coordinates
 	float LocX = 0, LocY = 0;
 	const bool bFoundMouse = GetMousePosition(LocX, LocY);
-	FVector2D Coords2D{LocX, LocY};
-	ScreenCoordinates = bFoundMouse ? Coords2D : Size2D;
-	bFoundInputType = bFoundMouse;
+	const FVector2D Coords2D{LocX, LocY};
+	Sample.ScreenCoordinates = bFoundMouse ? Coords2D : Size2D;
+	Sample.bFoundInputType = bFoundMouse;
+	Sample.HitResult = FHitResult{};
+
+	FVector WorldLocation{}, WorldDirection{};
+	const bool bDeprojected = DeprojectScreenPositionToWorld(Sample.ScreenCoordinates.X, Sample.ScreenCoordinates.Y, WorldLocation, WorldDirection);
+
+	if (bSampleCursorHeightfield && bDeprojected && Sample.TraceChannel == DedicatedLandscapeTraceChannel)
+	{
+		FVector HeightfieldPoint;
+		if (SampleCursorHeightfield(WorldLocation, WorldDirection, HeightfieldPoint))
+		{
+			// Synthesize a hit so callers don't need to care where the sample came from
+			Sample.HitResult = FHitResult{nullptr, nullptr, HeightfieldPoint, FVector::UpVector};
+			Sample.HitResult.bBlockingHit = true;
+			Sample.HitResult.TraceStart = WorldLocation;
+			Sample.HitResult.TraceEnd = HeightfieldPoint;
+			Sample.HitResult.Distance = FVector::Distance(WorldLocation, HeightfieldPoint);
+			Sample.IntersectionPoint = HeightfieldPoint;
+			return;
+		}
+	}
 	
-	FHitResult FloorHitResult{};
 	FCollisionQueryParams Params;
 	Params.MobilityType = EQueryMobilityType::Static;
 	Params.AddIgnoredActor(this);
 	Params.AddIgnoredActor(GetPawn());
 	
-	GetHitResultAtScreenPosition(ScreenCoordinates, OverrideTraceChannel, Params, FloorHitResult);
-	return FloorHitResult;
+	INC_DWORD_STAT(STAT_RTSOCursorGroundTraces);
+	GetHitResultAtScreenPosition(Sample.ScreenCoordinates, Sample.TraceChannel, Params, Sample.HitResult);
+	if (Sample.HitResult.bBlockingHit)
+	{
+		Sample.IntersectionPoint = Sample.HitResult.Location;
+		return;
+	}
+	
+	Sample.IntersectionPoint = FMath::LinePlaneIntersection(
+		WorldLocation, 
+		WorldLocation + (WorldDirection * 10000000.0),
+		GetPawn() != nullptr ? GetPawn()->GetActorLocation() : FVector::ZeroVector,
+		FVector{0.0, 0.0, 1.0});
+}
+
+bool ARTSOController::SampleCursorHeightfield(const FVector& RayOrigin, const FVector& RayDirection, FVector& OutIntersection) const
+{
+	if (RayDirection.Z > -UE_KINDA_SMALL_NUMBER) { return false; } // Looking at or above the horizon
+
+	double GroundZ = GetPawn() != nullptr ? GetPawn()->GetActorLocation().Z : RayOrigin.Z - 1.0;
+	bool bHasSampled = false;
+	for (int32 Iteration = 0; Iteration < CursorHeightfieldIterations; Iteration++)
+	{
+		const double RayDistance = (GroundZ - RayOrigin.Z) / RayDirection.Z;
+		if (RayDistance < 0.0) { break; }
+		
+		const TOptional<float> Height = GetLandscapeHeightAt(RayOrigin + RayDirection * RayDistance);
+		if (Height.IsSet() == false) { break; }
+
+		const bool bHasConverged = FMath::IsNearlyEqual(GroundZ, static_cast<double>(Height.GetValue()), 1.0);
+		GroundZ = Height.GetValue();
+		bHasSampled = true;
+		if (bHasConverged) { break; }
+	}
+	if (bHasSampled == false) { return false; }
+	
+	OutIntersection = RayOrigin + RayDirection * ((GroundZ - RayOrigin.Z) / RayDirection.Z);
+	return true;
+}
+
+TOptional<float> ARTSOController::GetLandscapeHeightAt(const FVector& WorldLocation) const
+{
+	if (bHasGatheredCursorLandscapes == false)
+	{
+		CursorLandscapes.Reset();
+		for (TActorIterator<ALandscapeProxy> LandscapeIt(GetWorld()); LandscapeIt; ++LandscapeIt)
+		{
+			CursorLandscapes.Emplace(*LandscapeIt);
+		}
+		bHasGatheredCursorLandscapes = true;
+	}
+
+	for (const TWeakObjectPtr<ALandscapeProxy>& Landscape : CursorLandscapes)
+	{
+		if (Landscape.IsValid() == false)
+		{
+			// Unloaded without us being told, re-gather on the next lookup
+			bHasGatheredCursorLandscapes = false;
+			continue;
+		}
+		
+		INC_DWORD_STAT(STAT_RTSOCursorHeightfieldSamples);
+		const TOptional<float> Height = Landscape->GetHeightAtLocation(WorldLocation);
+		if (Height.IsSet()) { return Height; }
+	}
+	return {};
+}
+
+void ARTSOController::OnWorldLevelsChanged(ULevel* Level, UWorld* World)
+{
+	if (World != GetWorld()) { return; }
+	bHasGatheredCursorLandscapes = false;
+}
+
+void ARTSOController::ProjectMouseToGroundPlane(FVector2D& ScreenCoordinates, FVector& IntersectionPoint, bool& bFoundInputType) const
+{
+	ProjectMouseToGroundPlane(DedicatedLandscapeTraceChannel, ScreenCoordinates, IntersectionPoint, bFoundInputType);
+}
+
+void ARTSOController::ProjectMouseToGroundPlane(TEnumAsByte<ECollisionChannel> OverrideTraceChannel, FVector2D& ScreenCoordinates, FVector& IntersectionPoint, bool& bFoundInputType) const
+{
+	const FRTSOCursorGroundSample& Sample = GetCursorGroundSample(OverrideTraceChannel);
+	ScreenCoordinates = Sample.ScreenCoordinates;
+	IntersectionPoint = Sample.IntersectionPoint;
+	bFoundInputType = Sample.bFoundInputType;
+}
+
+void ARTSOController::ProjectMouseToGroundPlane(FHitResult& HitResult, TEnumAsByte<ECollisionChannel> OverrideTraceChannel, FVector2D& ScreenCoordinates, FVector& IntersectionPoint, bool& bFoundInputType) const
+{
+	const FRTSOCursorGroundSample& Sample = GetCursorGroundSample(OverrideTraceChannel);
+	HitResult = Sample.HitResult;
+	ScreenCoordinates = Sample.ScreenCoordinates;
+	IntersectionPoint = Sample.IntersectionPoint;
+	bFoundInputType = Sample.bFoundInputType;
+}
+
+FHitResult ARTSOController::ProjectMouseToGroundPlane(TEnumAsByte<ECollisionChannel> OverrideTraceChannel, FVector2D& ScreenCoordinates, bool& bFoundInputType) const
+{
+	const FRTSOCursorGroundSample& Sample = GetCursorGroundSample(OverrideTraceChannel);
+	ScreenCoordinates = Sample.ScreenCoordinates;
+	bFoundInputType = Sample.bFoundInputType;
+	return Sample.HitResult;
 }
 
 void ARTSOController::DistanceFromViewportCenter(const FVector2D& InMoveDirection, FVector& Direction, double& Strength) const
@@ -730,14 +857,14 @@ void ARTSOController::ClampMovementToScreen(FVector& MoveDirection, double& Stre
 
 void ARTSOController::OnMarqueeSelectionUpdated_Implementation(int32 SelectionGroup, const TArray<int32>& NewSelection) const
 {
-	const TMap<int32, FMassEntityHandle>* CurrentIDGroup = GetImmutableMarqueeSelectionMap().Find(CurrentSelectionID);
+	const TArray<FMassEntityHandle>* CurrentIDGroup = SelectionGroups.FindGroup(CurrentSelectionID);
 	if (NewSelection.Num() != 1)
 	{
 		UpdateBuildMenuContexts(FMassEntityHandle{0, 0});
 	}
-	else if (NewSelection.Num() == 1 && CurrentIDGroup != nullptr) // Don't do anything if this isn't true
+	else if (NewSelection.Num() == 1 && CurrentIDGroup != nullptr && CurrentIDGroup->IsEmpty() == false) // Don't do anything if this isn't true
 	{
-		UpdateBuildMenuContexts(CurrentIDGroup->begin().Value());
+		UpdateBuildMenuContexts((*CurrentIDGroup)[0]);
 	}	
 }
 
@@ -783,14 +910,13 @@ void ARTSOController::MarqueeSelection(EMarqueeSelectionEvent SelectionEvent)
 			// Dispatch to BP, for visual effects and n();, and as such we only want to know the groupID if it is a explicitly stored hotkey
 			const int32 SelectedGID = HotKeyedSelectionGroups.Contains(GetCurrentGroupID()) ? GetCurrentGroupID() : INDEX_NONE;
 			TArray<int32> Keys;
-			const TMap<int32, FMassEntityHandle>* FoundHandleMap = MarqueeSelectedHandles.Find(GetCurrentGroupID());
-			if (FoundHandleMap == nullptr || FoundHandleMap->IsEmpty())
+			SelectionGroups.GetGroupEntityIndices(GetCurrentGroupID(), Keys);
+			if (Keys.IsEmpty())
 			{
 				OnMarqueeSelectionUpdated( INDEX_NONE, {});
 				break;
 			}
 		
-			FoundHandleMap->GenerateKeyArray(Keys);
 			OnMarqueeSelectionUpdated( SelectedGID, Keys);
 			break;
 		}
@@ -881,120 +1007,80 @@ void ARTSOController::DrawBoxAndTextChaos(const FVector& BoundsCenter, const FQu
 #endif // CHAOS_DEBUG_DRAW
 }
 
-void ARTSOController::AdjustMarqueeHitResultsToMinimumHeight(FHitResult& StartHitResult, FHitResult& CenterHitResult, FHitResult& EndHitResult)
+void ARTSOController::RefreshScreenSelectionIndex()
 {
-	const double TargetZ = FMath::Min3(StartHitResult.Location.Z, CenterHitResult.Location.Z, EndHitResult.Location.Z);
-	const FVector StartHitDirection = (StartHitResult.Location - StartHitResult.TraceStart).GetSafeNormal();
-	const FVector CenterHitDirection = (CenterHitResult.Location - CenterHitResult.TraceStart).GetSafeNormal();
-	const FVector EndHitDirection = (EndHitResult.Location - EndHitResult.TraceStart).GetSafeNormal();
-
-	if (StartHitResult.Location.Z > TargetZ + SMALL_NUMBER)
-	{
-		const double ZPerDirection = StartHitDirection.Z;
-		const double ZToDecrease = StartHitResult.Location.Z - TargetZ;
-		const double DirectionIncrease = ZToDecrease / ZPerDirection;
-		
-		StartHitResult.Location = StartHitResult.Location + (StartHitDirection * DirectionIncrease);
-	}	
-	if (CenterHitResult.Location.Z > TargetZ + SMALL_NUMBER)
+	UMassEntitySubsystem* EntitySubsystem = GetWorld() != nullptr ? GetWorld()->GetSubsystem<UMassEntitySubsystem>() : nullptr;
+	const ULocalPlayer* LocalPlayer = GetLocalPlayer();
+	
+	FSceneViewProjectionData ProjectionData;
+	if (EntitySubsystem == nullptr
+		|| LocalPlayer == nullptr
+		|| LocalPlayer->ViewportClient == nullptr
+		|| LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData) == false)
 	{
-		const double ZPerDirection = CenterHitDirection.Z;
-		const double ZToDecrease = CenterHitResult.Location.Z - TargetZ;
-		const double DirectionIncrease = ZToDecrease / ZPerDirection;
-		
-		CenterHitResult.Location = CenterHitResult.Location + (CenterHitDirection * DirectionIncrease);		
-	}	
-	if (EndHitResult.Location.Z > TargetZ + SMALL_NUMBER)
+		ScreenSelectionIndex.Invalidate();
+		return;
+	}
+
+	const FIntRect ViewRect = ProjectionData.GetConstrainedViewRect();
+	const FMatrix ViewProjection = ProjectionData.ComputeViewProjectionMatrix();
+	const FVector ViewOrigin = ProjectionData.ViewOrigin;
+	const double MaxDistanceSquared = FMath::Square(MarqueeSelectionMaxDistance);
+
+	// Candidates are the entities the representation LOD has already found to be visible to the player,
+	// rather than everything within the view frustums bounding box, which grows very large with a tilted camera
+	const int32 OwnerID = IPDRTSBuilderInterface::Execute_GetBuilderID(this);
+	FMassEntityManager& EntityManager = EntitySubsystem->GetMutableEntityManager();
+	FMassExecutionContext Context(EntityManager, 0.f);
+	ScreenSelectionIndex.BeginBuild(ViewRect, ViewProjection);
+	ScreenSelectionQuery.ForEachEntityChunk(EntityManager, Context, [&](FMassExecutionContext& LambdaContext)
 	{
-		const double ZPerDirection = EndHitDirection.Z;
-		const double ZToDecrease = EndHitResult.Location.Z - TargetZ;
-		const double DirectionIncrease = ZToDecrease / ZPerDirection;
+		const TConstArrayView<FPDMFragment_RTSEntityBase> EntityBases = LambdaContext.GetFragmentView<FPDMFragment_RTSEntityBase>();
+		const TConstArrayView<FTransformFragment> Transforms = LambdaContext.GetFragmentView<FTransformFragment>();
+		const TConstArrayView<FMassRepresentationLODFragment> LODs = LambdaContext.GetFragmentView<FMassRepresentationLODFragment>();
 		
-		EndHitResult.Location = EndHitResult.Location + (EndHitDirection * DirectionIncrease);		
-	}
+		for (int32 EntityIdx = 0; EntityIdx < LambdaContext.GetNumEntities(); ++EntityIdx)
+		{
+			// Don't allow selecting/handling entities we do not own
+			if (EntityBases[EntityIdx].OwnerID != OwnerID) { continue; }
+			if (LODs.IsEmpty() == false && LODs[EntityIdx].Visibility != EMassVisibility::CanBeSeen) { continue; }
+
+			const FVector Location = Transforms[EntityIdx].GetTransform().GetLocation();
+			if (FVector::DistSquared(Location, ViewOrigin) > MaxDistanceSquared) { continue; }
+
+			ScreenSelectionIndex.AddEntity(LambdaContext.GetEntity(EntityIdx), Location);
+		}
+	});
+	ScreenSelectionIndex.FinishBuild();
 }
 
 void ARTSOController::GetEntitiesOrActorsInMarqueeSelection()
 {
-	// Viewport halfsize
-	UPDRTSBaseSubsystem* RTSSubSystem = UPDRTSBaseSubsystem::Get();
-	const FMassEntityManager* EntityManager = RTSSubSystem->EntityManager;
-	
-	PD::Mass::Entity::Octree& WorldOctree =  RTSSubSystem->WorldEntityOctree;
-
 	FCollisionQueryParams Params;
 	Params.MobilityType = EQueryMobilityType::Static;
 	Params.AddIgnoredActor(this);
 	
-	// // Clear
-	LatestStartHitResult = LatestCenterHitResult = LatestEndHitResult = FHitResult{};
-	
-	// // Sample three points at the ground, min their z component
-	FVector2D CenterSelection = StartMousePositionMarquee + ((CurrentMousePositionMarquee - StartMousePositionMarquee) * 0.5) ; 
+	// Only the center is traced, it is used as the group start location when issuing move commands to the selection
+	LatestCenterHitResult = FHitResult{};
+	const FVector2D CenterSelection = StartMousePositionMarquee + ((CurrentMousePositionMarquee - StartMousePositionMarquee) * 0.5); 
 	GetHitResultAtScreenPosition(CenterSelection, ECC_Visibility, Params, LatestCenterHitResult);
-	GetHitResultAtScreenPosition(StartMousePositionMarquee, ECC_Visibility, Params, LatestStartHitResult);
-	GetHitResultAtScreenPosition(CurrentMousePositionMarquee, ECC_Visibility, Params, LatestEndHitResult);
-	
-	// // @todo Finish function below: Adjusts bounds in case on of our tracers hit something in-between in the foreground 
-	AdjustMarqueeHitResultsToMinimumHeight(LatestStartHitResult, LatestCenterHitResult, LatestEndHitResult);
-	
-	FMinimalViewInfo OutResult;
-	CalcCamera(GetWorld()->GetDeltaSeconds(), OutResult);
-	
-	const FVector Distance = LatestEndHitResult.Location - LatestStartHitResult.Location; 
-	FQuat CameraRotation = Distance.GetSafeNormal().ToOrientationQuat();
 
-	FVector BoundsCenter = LatestCenterHitResult.Location;
-	FVector Extent = FVector(Distance.X * 0.5, Distance.Y * 0.5, (LatestStartHitResult.TraceStart - LatestStartHitResult.Location).Z * 0.5);
-	Extent = CameraRotation.RotateVector(Extent); // * -1;
-
-	const FVector OffsetZVector = FVector{0,0, (LatestStartHitResult.TraceStart - LatestStartHitResult.Location).Z};
-	const FVector OffsetXVector = FVector{Distance.X,0, 0};
-
-	// // assumes we are rotated along one of four cardinal directions
-	FVector RotatedX = OutResult.Rotation.RotateVector(OffsetXVector);
-	const FBox MarqueeWorldBox{
-		{
-			// Bottom points
-			LatestStartHitResult.Location,
-			LatestStartHitResult.Location + RotatedX,
-			LatestEndHitResult.Location,
-			LatestEndHitResult.Location   - RotatedX,
-			
-			// Upper Points
-			LatestStartHitResult.Location + OffsetZVector,
-			LatestStartHitResult.Location + OffsetZVector + RotatedX,
-			LatestEndHitResult.Location   + OffsetZVector,
-			LatestEndHitResult.Location   + OffsetZVector - RotatedX
-		}};
+	// Entities are projected to the screen and tested against the drawn rectangle itself,
+	// so the selection matches what the player sees regardless of camera perspective or terrain slope
+	RefreshScreenSelectionIndex();
 	
-	MarqueeWorldBox.GetCenterAndExtents(BoundsCenter, Extent);
-
-	OnSelectionChange(true);
-	
-	TMap<int32, FMassEntityHandle> Handles;
-	FBoxCenterAndExtent QueryBounds = FBoxCenterAndExtent(BoundsCenter, Extent);
-	WorldOctree.FindElementsWithBoundsTest(QueryBounds, [&](const FPDEntityOctreeCell& Cell)
-	{
-		if (Cell.EntityHandle.Index == 0 || EntityManager->IsEntityValid(Cell.EntityHandle) == false) { return; }
-
-		// Don't allow selecting/handling entities we do not own
-		FPDMFragment_RTSEntityBase* EntityBaseFrag = EntityManager->GetFragmentDataPtr<FPDMFragment_RTSEntityBase>(Cell.EntityHandle);
-		if (EntityBaseFrag == nullptr || EntityBaseFrag->OwnerID != IPDRTSBuilderInterface::Execute_GetBuilderID(this))
-		{
-			return;
-		}
-		
-		Handles.Emplace(Cell.EntityHandle.Index, Cell.EntityHandle);
-	});
+	TArray<FMassEntityHandle> Handles;
+	ScreenSelectionIndex.Query(StartMousePositionMarquee, CurrentMousePositionMarquee, Handles);
 
 	CurrentSelectionID = INDEX_NONE;
 	if (Handles.IsEmpty() == false)
 	{
 		CurrentSelectionID = GeneratedGroupID();
 		UE_LOG(PDLog_RTSO, Warning, TEXT("ARTSOController::GetEntitiesOrActorsInMarqueeSelection : (Head) Generated ID : %i"), CurrentSelectionID);
-		MarqueeSelectedHandles.FindOrAdd(CurrentSelectionID, std::move(Handles));
+		SelectionGroups.SetGroup(CurrentSelectionID, MoveTemp(Handles));
 	}
+	
+	// Diffs against the previous selection, only entities entering or leaving the selection are touched
 	OnSelectionChange(false);
 	
 	
@@ -1004,59 +1090,105 @@ void ARTSOController::GetEntitiesOrActorsInMarqueeSelection()
 
 	// Chaos debug draws on an async call
 	const FVector DebugExtent = FVector(25.0);
-	DrawBoxAndTextChaos(LatestStartHitResult.Location, QueryBounds.Extent.ToOrientationQuat(), DebugExtent, FString("StartSelection"));
-	DrawBoxAndTextChaos(LatestCenterHitResult.Location, QueryBounds.Extent.ToOrientationQuat(), DebugExtent, FString("CenterSelection"));
-	DrawBoxAndTextChaos(LatestEndHitResult.Location, QueryBounds.Extent.ToOrientationQuat(), DebugExtent, FString("EndSelection"));
-
-	DrawBoxAndTextChaos(
-		FVector(QueryBounds.Center),
-		FQuat(0),
-		FVector(QueryBounds.Extent),
-		FString("MarqueeSelection"),
-		FColor::Yellow);
-	
+	const TArray<FMassEntityHandle>* SelectedGroup = SelectionGroups.FindGroup(CurrentSelectionID);
+	const FString DebugBoxTitle = FString::Printf(TEXT("MarqueeSelection(%i of %i in view)"), SelectedGroup != nullptr ? SelectedGroup->Num() : 0, ScreenSelectionIndex.Num());
+	DrawBoxAndTextChaos(LatestCenterHitResult.Location, FQuat::Identity, DebugExtent, DebugBoxTitle, FColor::Yellow);
 #endif
 }
 
 void ARTSOController::ReorderGroupIndex(const int32 OldID, const int32 NewID)
 {
-	if (MarqueeSelectedHandles.Contains(OldID) == false || NewID < 0 || NewID > 10) { return; }
+	if (SelectionGroups.Contains(OldID) == false || NewID < 0 || NewID > 10) { return; }
 
-	MarqueeSelectedHandles.FindOrAdd(NewID) = *MarqueeSelectedHandles.Find(OldID);
-	MarqueeSelectedHandles.Remove(OldID);
+	SelectionGroups.MoveGroup(OldID, NewID);
 }
 
 void ARTSOController::OnSelectionChange(bool bClearSelection)
 {
-	const AGodHandPawn* PawnAsGodhand = GetPawn<AGodHandPawn>();
-	if (PawnAsGodhand == nullptr || GetImmutableMarqueeSelectionMap().Contains(CurrentSelectionID) == false)
+	const TArray<FMassEntityHandle>* NewGroup = bClearSelection ? nullptr : SelectionGroups.FindGroup(CurrentSelectionID);
+	const TConstArrayView<FMassEntityHandle> NewSelection = NewGroup != nullptr ? TConstArrayView<FMassEntityHandle>(*NewGroup) : TConstArrayView<FMassEntityHandle>();
+	const int32 NewGroupID = NewGroup != nullptr ? CurrentSelectionID : INDEX_NONE;
+
+	TArray<FMassEntityHandle> Deselected;
+	TArray<FMassEntityHandle> Selected;
+	FRTSOSelectionGroups::Difference(AppliedSelection, NewSelection, Deselected);
+	FRTSOSelectionGroups::Difference(NewSelection, AppliedSelection, Selected);
+	
+	DeferSelectionState(Deselected, false, AppliedSelectionGroupID);
+	if (NewGroupID != AppliedSelectionGroupID)
 	{
-		return;
+		// Group was re-keyed, i.e. moved to a hotkey, the retained entities need their group index updated as well 
+		DeferSelectionState(NewSelection, true, NewGroupID);
+	}
+	else
+	{
+		DeferSelectionState(Selected, true, NewGroupID);
+	}
+
+	AppliedSelection = NewSelection;
+	AppliedSelectionGroupID = NewGroupID;
+}
+
+void ARTSOController::AddToSelectionGroup(int32 GroupID, TConstArrayView<FMassEntityHandle> Handles)
+{
+	TArray<FMassEntityHandle> Added;
+	SelectionGroups.AddToGroup(GroupID, Handles, Added);
+	if (GroupID != AppliedSelectionGroupID || Added.IsEmpty()) { return; }
+
+	// The applied selection mirrors the group, only merge in what was added
+	DeferSelectionState(Added, true, GroupID);
+	FRTSOSelectionGroups::MergeSorted(AppliedSelection, Added);
+}
+
+void ARTSOController::RemoveFromSelectionGroup(int32 GroupID, TConstArrayView<FMassEntityHandle> Handles)
+{
+	TArray<FMassEntityHandle> Removed;
+	SelectionGroups.RemoveFromGroup(GroupID, Handles, Removed);
+	if (GroupID != AppliedSelectionGroupID || Removed.IsEmpty()) { return; }
+
+	DeferSelectionState(Removed, false, GroupID);
+	TArray<FMassEntityHandle> RemovedFromApplied;
+	FRTSOSelectionGroups::RemoveSorted(AppliedSelection, Removed, RemovedFromApplied);
+	if (AppliedSelection.IsEmpty()) { AppliedSelectionGroupID = CurrentSelectionID = INDEX_NONE; }
+}
+
+void ARTSOController::DeferSelectionState(TConstArrayView<FMassEntityHandle> Handles, bool bSelected, int32 GroupID) const
+{
+	const UPDRTSBaseSubsystem* RTSSubSystem = UPDRTSBaseSubsystem::Get();
+	const FMassEntityManager* EntityManager = RTSSubSystem != nullptr ? RTSSubSystem->EntityManager : nullptr;
+	if (Handles.IsEmpty() || EntityManager == nullptr) { return; }
+
+	TArray<FMassEntityHandle> ValidHandles;
+	ValidHandles.Reserve(Handles.Num());
+	for (const FMassEntityHandle& EntityHandle : Handles)
+	{
+		if (EntityManager->IsEntityValid(EntityHandle) == false) { continue; }
+		ValidHandles.Emplace(EntityHandle);
 	}
+	if (ValidHandles.IsEmpty()) { return; }
 
-	const TMap<int32, FMassEntityHandle>* CurrentIDGroup = GetImmutableMarqueeSelectionMap().Find(CurrentSelectionID);
-	// const TArray<TObjectPtr<UInstancedStaticMeshComponent>>& ISMs = UPDRTSBaseSubsystem::Get()->GetMassISMs(PawnAsGodhand->GetWorld());
+	// Tag changes are batched by the command buffer and applied per archetype,
+	// cosmetics are resolved from the tag in UPDMProcessor_EntityCosmetics::Execute 
+	FMassCommandBuffer& CommandBuffer = EntityManager->Defer();
+	for (const FMassEntityHandle& EntityHandle : ValidHandles)
 	{
-		TArray<FMassEntityHandle> MarqueeSelectionArray;
-		CurrentIDGroup->GenerateValueArray(MarqueeSelectionArray);
+		if (bSelected) { CommandBuffer.AddTag<FPDMTag_Selected>(EntityHandle); }
+		else { CommandBuffer.RemoveTag<FPDMTag_Selected>(EntityHandle); }
+	}
 	
-		const TArray<FMassEntityHandle>& MarqueeSelectionArrayRef = MarqueeSelectionArray; 
-		ParallelFor(MarqueeSelectionArray.Num(),
-			[&MarqueeSelectionArrayRef, &PawnAsGodhand, bClearSelection, SelectionID = CurrentSelectionID, OwnerID = ActorID](const int32 Idx)
+	CommandBuffer.PushCommand<FMassDeferredSetCommand>(
+		[Handles = MoveTemp(ValidHandles), bSelected, GroupID, OwnerID = ActorID.GetID()](FMassEntityManager& Manager)
+		{
+			for (const FMassEntityHandle& EntityHandle : Handles)
 			{
-				const FMassEntityHandle& EntityHandle = MarqueeSelectionArrayRef[Idx];
-				if (PawnAsGodhand->EntityManager->IsEntityValid(EntityHandle) == false) { return; }
-
-				FPDMFragment_RTSEntityBase* PermadevEntityBase = PawnAsGodhand->EntityManager->GetFragmentDataPtr<FPDMFragment_RTSEntityBase>(EntityHandle);
-				if (PermadevEntityBase == nullptr) { return; }
+				FPDMFragment_RTSEntityBase* PermadevEntityBase = Manager.IsEntityValid(EntityHandle) ? Manager.GetFragmentDataPtr<FPDMFragment_RTSEntityBase>(EntityHandle) : nullptr;
+				if (PermadevEntityBase == nullptr) { continue; }
 				
-				// Processing handled in UPDMProcessor_EntityCosmetics::Execute function
-				PermadevEntityBase->SelectionState = bClearSelection ? EPDEntitySelectionState::ENTITY_NOTSELECTED : EPDEntitySelectionState::ENTITY_SELECTED;
-				PermadevEntityBase->SelectionGroupIndex = SelectionID;
-				PermadevEntityBase->OwnerID = OwnerID.GetID(); 
-			
-			}, EParallelForFlags::BackgroundPriority);
-	}
+				PermadevEntityBase->SelectionState = bSelected ? EPDEntitySelectionState::ENTITY_SELECTED : EPDEntitySelectionState::ENTITY_NOTSELECTED;
+				PermadevEntityBase->SelectionGroupIndex = GroupID;
+				PermadevEntityBase->OwnerID = OwnerID;
+			}
+		});
 }
 
 void ARTSOController::UpdateBuildMenuContexts(const FMassEntityHandle& CurrentEntity) const
@@ -6,6 +6,7 @@
 #include "PDInteractSubsystem.h"
 #include "PDRTSBaseSubsystem.h"
 #include "Actors/GodHandPawn.h"
+#include "AI/Mass/RTSOMassFragments.h"
 #include "Actors/RTSOController.h"
 #include "Actors/Interactables/ConversationHandlers/RTSOInteractableConversationActor.h"
 
@@ -13,6 +14,7 @@
 #include "MassEntitySubsystem.h"
 #include "MassSpawnerSubsystem.h"
 #include "PDBuilderSubsystem.h"
+#include "Subsystems/RTSOProductionSubsystem.h"
 #include "Components/PDInventoryComponent.h"
 #include "GameFramework/GameStateBase.h"
 #include "Kismet/GameplayStatics.h"
@@ -38,6 +40,11 @@ void ARTSOBaseGM::BeginPlay()
 	Super::BeginPlay();
 	
 	GameSave = Cast<URTSOpenSaveGame>(UGameplayStatics::CreateSaveGameObject(URTSOpenSaveGame::StaticClass()));
+
+	UPDInteractSubsystem::Get()->RegisterEntityInteractionHandler(
+		GetWorld(),
+		FRTSOLightInventoryFragment::StaticStruct(),
+		FPDOnInteractionBatch::CreateUObject(this, &ARTSOBaseGM::HandleEntityInventoryInteractions));
 	
 	URTSOBaseGI* GI = Cast<URTSOBaseGI>(GetWorld()->GetGameInstance());
 	if (GI == nullptr) { return; }
@@ -49,6 +56,8 @@ void ARTSOBaseGM::BeginPlay()
 
 void ARTSOBaseGM::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	UPDInteractSubsystem::Get()->DeregisterEntityInteractionHandler(GetWorld(), FRTSOLightInventoryFragment::StaticStruct());
+
 	UPDRTSBaseSubsystem* RTSSubsystem = UPDRTSBaseSubsystem::Get();
 
 	TArray<TSharedPtr<FOctreeElementId2>> CellIDs;
@@ -73,6 +82,28 @@ void ARTSOBaseGM::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	Super::EndPlay(EndPlayReason);
 }
 
+void ARTSOBaseGM::HandleEntityInventoryInteractions(const UWorld* World, TConstArrayView<FPDInteractionRequest> Requests, TArrayView<EPDInteractResult> OutResults)
+{
+	const UMassEntitySubsystem* EntitySubsystem = World != nullptr ? World->GetSubsystem<UMassEntitySubsystem>() : nullptr;
+	if (EntitySubsystem == nullptr) { return; }
+
+	const FMassEntityManager& EntityManager = EntitySubsystem->GetEntityManager();
+	for (int32 RequestIdx = 0; RequestIdx < Requests.Num(); RequestIdx++)
+	{
+		const FPDInteractionRequest& Request = Requests[RequestIdx];
+		OutResults[RequestIdx] = EPDInteractResult::INTERACT_FAIL;
+		if (Request.Params.InstigatorEntity == Request.TargetEntity) { continue; }
+		if (EntityManager.IsEntityValid(Request.Params.InstigatorEntity) == false || EntityManager.IsEntityValid(Request.TargetEntity) == false) { continue; }
+		
+		FRTSOLightInventoryFragment* InstigatorInventory = EntityManager.GetFragmentDataPtr<FRTSOLightInventoryFragment>(Request.Params.InstigatorEntity);
+		FRTSOLightInventoryFragment* TargetInventory = EntityManager.GetFragmentDataPtr<FRTSOLightInventoryFragment>(Request.TargetEntity);
+		if (InstigatorInventory == nullptr || TargetInventory == nullptr) { continue; }
+
+		InstigatorInventory->Handler.TransferItems(*TargetInventory);
+		OutResults[RequestIdx] = EPDInteractResult::INTERACT_SUCCESS;
+	}
+}
+
 void ARTSOBaseGM::Logout(AController* Exiting)
 {
 	Super::Logout(Exiting);
@@ -194,6 +225,7 @@ void ARTSOBaseGM::ProcessChangesAndSaveGame_Implementation(const FString& Slot,
 	check(GameSave != nullptr)
 
 	// Async call might be needed here and then after it has finished call SaveGame()
+	SaveConversationProgression();
 	SaveConversationActorStates();
 	SaveInteractables();
 	SaveAllPlayerStates();
@@ -204,10 +236,38 @@ void ARTSOBaseGM::ProcessChangesAndSaveGame_Implementation(const FString& Slot,
 	GetWorld()->GetTimerManager().SetTimer(GameSave->Data.SaveThrottleHandle, SaveGameCallback, 4, false);
 }
 
-// Not needed, data updated directly after each choice injunction,
-// keep here and reserve it for possible use if the data-structure we want to store data from grows larger/more complex
 void ARTSOBaseGM::SaveConversationProgression_Implementation()
 {
+	check(GameSave != nullptr)
+
+	// Only applies the tag changes logged since our last save, instead of re-copying every players tag container
+	// Walks every player controller in the world, not only the tracked ones, so pending changes on untracked controllers are not dropped
+	const FRTSOProgressionTagRegistry& Registry = FRTSOProgressionTagRegistry::Get();
+	TArray<FRTSOProgressionTagChange> TagChanges;
+	for (FConstPlayerControllerIterator ControllerIt = GetWorld()->GetPlayerControllerIterator(); ControllerIt; ++ControllerIt)
+	{
+		ARTSOController* Controller = Cast<ARTSOController>(ControllerIt->Get());
+		IRTSOConversationInterface* PawnInterface = Controller != nullptr ? Cast<IRTSOConversationInterface>(Controller->GetPawn()) : nullptr;
+		if (PawnInterface == nullptr) { continue; }
+
+		TagChanges.Reset();
+		PawnInterface->ConsumeProgressionTagChanges(TagChanges);
+		if (TagChanges.IsEmpty()) { continue; }
+
+		FGameplayTagContainer& SavedTags = GameSave->Data.PlayersAndConversationTags.FindOrAdd(Controller->GetActorID());
+		for (const FRTSOProgressionTagChange& TagChange : TagChanges)
+		{
+			const FGameplayTag& ChangedTag = Registry.GetTag(TagChange.TagBit);
+			if (TagChange.bAdded)
+			{
+				SavedTags.AddTag(ChangedTag);
+			}
+			else
+			{
+				SavedTags.RemoveTag(ChangedTag);
+			}
+		}
+	}
 }
 
 void ARTSOBaseGM::SaveConversationActorStates_Implementation()
@@ -312,6 +372,7 @@ void ARTSOBaseGM::SaveAllItems_Implementation()
 	
 	TMap<int32, AActor*>& IDToActorMap =  UPDRTSBaseSubsystem::Get()->SharedOwnerIDMappings;
 	TMap<int32 /*ID*/, FRTSSavedItems> AccumulatedItems{};
+	const URTSOProductionSubsystem* Production = URTSOProductionSubsystem::Get(this);
 	for (const TTuple<int32 /*PersistentID*/, AActor* >& ItemDataEntry : IDToActorMap)
 	{
 		int32 ID = ItemDataEntry.Key;
@@ -328,7 +389,14 @@ void ARTSOBaseGM::SaveAllItems_Implementation()
 			UE_LOG(PDLog_RTSO, Error, TEXT("AsController does not own a valid godhand pawn"));
 			continue;	
 		}
-		AccumulatedItems.Emplace(ID, FRTSSavedItems{CurrentGodHandPawn->InventoryComponent->ItemList.Items});
+		
+		// Production queues are not saved, hand back the cost they have reserved so it is not lost when the save is loaded
+		FRTSSavedItems SavedItems{CurrentGodHandPawn->InventoryComponent->ItemList.Items};
+		if (Production != nullptr)
+		{
+			Production->AddReservedCosts(CurrentGodHandPawn->InventoryComponent, SavedItems.Items);
+		}
+		AccumulatedItems.Emplace(ID, MoveTemp(SavedItems));
 	}
 	
 	GameSave->Data.Inventories.Append(AccumulatedItems); // overwrite any previous value, this is slow so only allow saving resources every 4 seconds at max, limited by the latent action below 
@@ -933,8 +1001,9 @@ void ARTSOBaseGM::FinalizeLoadInventoryData(const TMap<int32, AActor*>& OwnerIDM
 
 		for (const FPDItemNetDatum& ChangedItem : ItemsToUpdate.Items)
 		{
-			const FPDItemNetDatum& ExistingItem = Inv->ItemList.Items[Inv->ItemList.ItemToIndexMapping.FindRef(ChangedItem.ItemTag)];
-			Inv->RequestUpdateItem(EPDItemNetOperation::CHANGE, ChangedItem.ItemTag, ChangedItem.TotalItemCount - ExistingItem.TotalItemCount);
+			const int32* ExistingItemIdx = Inv->ItemList.ItemToIndexMapping.Find(ChangedItem.ItemTag);
+			const int32 ExistingCount = ExistingItemIdx != nullptr ? FMath::Max(Inv->ItemList.Items[*ExistingItemIdx].TotalItemCount, 0) : 0;
+			Inv->RequestUpdateItem(EPDItemNetOperation::CHANGE, ChangedItem.ItemTag, ChangedItem.TotalItemCount - ExistingCount);
 		}						
 	}
 }
@@ -980,6 +1049,7 @@ void ARTSOBaseGM::FinalizeLoadConversationActors()
 					FRTSOConversationMetaState& MissionInstanceData = ExistingActor->InstanceDataPerMission.FindOrAdd(MetaProgressionDatum.MissionTag); 
 					MissionInstanceData.MissionTag = MetaProgressionDatum.MissionTag;
 					MissionInstanceData.PhaseRequiredTags = MetaProgressionDatum.PhaseRequiredTags;
+					FRTSOConversationRules::BuildRequiredTagMasks(MissionInstanceData.PhaseRequiredTags);
 					MissionInstanceData.ProgressionPerPlayer.FindOrAdd(UserID) = MetaProgressionDatum.BaseProgression;
 				}
 			}
@@ -1046,6 +1116,7 @@ void ARTSOBaseGM::FinalizeLoadConversationActors()
 					FRTSOConversationMetaState& MissionInstanceData = ExistingActor->InstanceDataPerMission.FindOrAdd(MetaProgressionDatum.MissionTag); 
 					MissionInstanceData.MissionTag = MetaProgressionDatum.MissionTag;
 					MissionInstanceData.PhaseRequiredTags = MetaProgressionDatum.PhaseRequiredTags;
+					FRTSOConversationRules::BuildRequiredTagMasks(MissionInstanceData.PhaseRequiredTags);
 					MissionInstanceData.ProgressionPerPlayer.FindOrAdd(UserID) = MetaProgressionDatum.BaseProgression;
 				}
 			}
@@ -3,6 +3,7 @@
 #include "Interfaces/RTSOActionLogInterface.h"
 
 #include "PDMessageWidgetCommon.h"
+#include "PDTableIngestion.h"
 #include "Widgets/Slate/SRTSOActionLog.h"
 
 
@@ -16,48 +17,56 @@ URTSActionLogSubsystem* URTSActionLogSubsystem::Get()
 	if (Self == nullptr || Self->IsValidLowLevelFast() == false)
 	{
 		Self = GEngine->GetEngineSubsystem<URTSActionLogSubsystem>();
-		
-		URTSActionLogUserSettings* ActionLogUserSettings = GetMutableDefault<URTSActionLogUserSettings>();
-		if (ActionLogUserSettings->bHasBeenProcessed == false)
-		{
-			const URTSActionLogDefaultDeveloperSettings* ActionLogDeveloperSettings = GetDefault<URTSActionLogDefaultDeveloperSettings>();
+	}
+	
+	return Self;
+}
+
+void URTSActionLogSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	
+	URTSActionLogUserSettings* ActionLogUserSettings = GetMutableDefault<URTSActionLogUserSettings>();
+	if (ActionLogUserSettings->bHasBeenProcessed == false)
+	{
+		const URTSActionLogDefaultDeveloperSettings* ActionLogDeveloperSettings = GetDefault<URTSActionLogDefaultDeveloperSettings>();
 #if WITH_EDITOR			
-			ActionLogUserSettings->bShowActionLogTimestamps = ActionLogDeveloperSettings->bShowActionLogTimestamps;
+		ActionLogUserSettings->bShowActionLogTimestamps = ActionLogDeveloperSettings->bShowActionLogTimestamps;
 #endif
-		
-			if (ActionLogDeveloperSettings->ActionLogStyleTables.IsEmpty() == false)
+	
+		if (ActionLogDeveloperSettings->ActionLogStyleTables.IsEmpty() == false)
+		{
+			ActionLogUserSettings->bHasBeenProcessed = true;
+			for (const TSoftObjectPtr<UDataTable>& StyleTableSoftObject : ActionLogDeveloperSettings->ActionLogStyleTables)
 			{
-				ActionLogUserSettings->bHasBeenProcessed = true;
-				for (const TSoftObjectPtr<UDataTable>& StyleTableSoftObject : ActionLogDeveloperSettings->ActionLogStyleTables)
-				{
-					ActionLogUserSettings->ActionLogStyleTables.Emplace(StyleTableSoftObject);
-				}
+				ActionLogUserSettings->ActionLogStyleTables.Emplace(StyleTableSoftObject);
 			}
 		}
-		Self->bShowTimestamps = ActionLogUserSettings->bShowActionLogTimestamps;
-		
-		for (const TSoftObjectPtr<UDataTable>& StyleTable : GetDefault<URTSActionLogUserSettings>()->ActionLogStyleTables)
+	}
+	bShowTimestamps = ActionLogUserSettings->bShowActionLogTimestamps;
+
+	// Styles are cosmetic, entries dispatched before the tables are ready are simply drawn with the default style 
+	using FStyleDataMap = TMap<FGameplayTag /*StyleID*/, FRTSActionLogStyleData>;
+	FPDTableIngestion::Get().Ingest<FStyleDataMap>(
+		TEXT("RTSActionLogSubsystem"),
+		GetDefault<URTSActionLogUserSettings>()->ActionLogStyleTables,
+		[](const TArray<UDataTable*>& Tables, FStyleDataMap& OutStyleDataMap)
 		{
-			TArray<FRTSActionLogStyleCompound*> LogStyleRows;
-			UDataTable* LoadedTable = StyleTable.LoadSynchronous();
-
-			if (LoadedTable == nullptr)
+			for (const UDataTable* LoadedTable : Tables)
 			{
-				UE_LOG(PDLog_MessageSystem, Error, TEXT("URTSActionLogSubsystem -- Failed to load LogStyle table from settings! (Null entry encountered)"))
-				continue;
-			}
-			
-			LoadedTable->GetAllRows(TEXT(""), LogStyleRows);
-			for (FRTSActionLogStyleCompound* StyleCompound : LogStyleRows)
-			{
-				if (StyleCompound == nullptr) { continue; }
-				Self->StyleDataMap.Emplace(StyleCompound->StyleID,StyleCompound->StyleData);
+				TArray<FRTSActionLogStyleCompound*> LogStyleRows;
+				LoadedTable->GetAllRows(TEXT(""), LogStyleRows);
+				for (FRTSActionLogStyleCompound* StyleCompound : LogStyleRows)
+				{
+					if (StyleCompound == nullptr) { continue; }
+					OutStyleDataMap.Emplace(StyleCompound->StyleID,StyleCompound->StyleData);
+				}
 			}
-		}
-		
-	}
-	
-	return Self;
+		},
+		[this](const TArray<UDataTable*>& Tables, FStyleDataMap&& BuiltStyleDataMap)
+		{
+			StyleDataMap = MoveTemp(BuiltStyleDataMap);
+		});
 }
 
 #define LOCTEXT_NAMESPACE "SRTSOActionLog"
@@ -10,6 +10,12 @@
 #include "Internationalization/TextKey.h"
 #include "Subsystems/RTSOSettingsSubsystem.h"
 #include "UObject/UnrealType.h"
+#include "MassEntityManager.h"
+#include "MassCommonFragments.h"
+#include "SceneView.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+#include "Algo/Unique.h"
 
 #if WITH_EDITOR
 #include "Editor.h"
@@ -37,6 +43,436 @@
 #endif // WITH_EDITOR
 
 
+//
+// Progression tags
+FRTSOProgressionTagRegistry& FRTSOProgressionTagRegistry::Get()
+{
+	static FRTSOProgressionTagRegistry Registry;
+	return Registry;
+}
+
+int32 FRTSOProgressionTagRegistry::Intern(const FGameplayTag& Tag)
+{
+	check(IsInGameThread())
+	
+	if (const int32* ExistingBit = TagToBit.Find(Tag)) { return *ExistingBit; }
+
+	const int32 TagBit = BitToTag.Emplace(Tag);
+	TagToBit.Emplace(Tag, TagBit);
+	return TagBit;
+}
+
+int32 FRTSOProgressionTagRegistry::Find(const FGameplayTag& Tag) const
+{
+	const int32* ExistingBit = TagToBit.Find(Tag);
+	return ExistingBit != nullptr ? *ExistingBit : INDEX_NONE;
+}
+
+TBitArray<> FRTSOProgressionTagRegistry::MakeMask(const TArray<FGameplayTag>& Tags)
+{
+	TBitArray<> Mask;
+	for (const FGameplayTag& Tag : Tags)
+	{
+		if (Tag.IsValid() == false) { continue; }
+		
+		const int32 TagBit = Intern(Tag);
+		if (Mask.Num() <= TagBit) { Mask.Add(false, TagBit + 1 - Mask.Num()); }
+		Mask[TagBit] = true;
+	}
+	return Mask;
+}
+
+void FRTSOProgressionTagSet::SetBit(TBitArray<>& Bits, int32 TagBit, bool bValue)
+{
+	if (Bits.Num() <= TagBit)
+	{
+		if (bValue == false) { return; }
+		Bits.Add(false, TagBit + 1 - Bits.Num());
+	}
+	Bits[TagBit] = bValue;
+}
+
+bool FRTSOProgressionTagSet::Add(const FGameplayTag& Tag)
+{
+	if (Tag.IsValid() == false) { return false; }
+	
+	FRTSOProgressionTagRegistry& Registry = FRTSOProgressionTagRegistry::Get();
+	const int32 TagBit = Registry.Intern(Tag);
+	if (ExplicitBits.IsValidIndex(TagBit) && ExplicitBits[TagBit]) { return false; }
+
+	SetBit(ExplicitBits, TagBit, true);
+	SetBit(MatchBits, TagBit, true);
+	for (FGameplayTag ParentTag = Tag.RequestDirectParent(); ParentTag.IsValid(); ParentTag = ParentTag.RequestDirectParent())
+	{
+		SetBit(MatchBits, Registry.Intern(ParentTag), true);
+	}
+	
+	ChangeLog.Add({TagBit, true});
+	return true;
+}
+
+bool FRTSOProgressionTagSet::Remove(const FGameplayTag& Tag)
+{
+	const int32 TagBit = FRTSOProgressionTagRegistry::Get().Find(Tag);
+	if (ExplicitBits.IsValidIndex(TagBit) == false || ExplicitBits[TagBit] == false) { return false; }
+
+	ExplicitBits[TagBit] = false;
+	RebuildMatchBits();
+	
+	ChangeLog.Add({TagBit, false});
+	return true;
+}
+
+bool FRTSOProgressionTagSet::Has(const FGameplayTag& Tag) const
+{
+	const int32 TagBit = FRTSOProgressionTagRegistry::Get().Find(Tag);
+	return MatchBits.IsValidIndex(TagBit) && MatchBits[TagBit];
+}
+
+bool FRTSOProgressionTagSet::HasAll(const TBitArray<>& RequiredMask) const
+{
+	const int32 NumRequiredWords = FMath::DivideAndRoundUp(RequiredMask.Num(), NumBitsPerDWORD);
+	const int32 NumMatchWords = FMath::DivideAndRoundUp(MatchBits.Num(), NumBitsPerDWORD);
+	const uint32* RequiredWords = RequiredMask.GetData();
+	const uint32* MatchWords = MatchBits.GetData();
+	for (int32 WordIdx = 0; WordIdx < NumRequiredWords; WordIdx++)
+	{
+		// Bits past our size are unset
+		const uint32 MatchWord = WordIdx < NumMatchWords ? MatchWords[WordIdx] : 0;
+		if ((RequiredWords[WordIdx] & ~MatchWord) != 0) { return false; }
+	}
+	return true;
+}
+
+void FRTSOProgressionTagSet::Reset()
+{
+	ExplicitBits.Reset();
+	MatchBits.Reset();
+	ChangeLog.Reset();
+}
+
+void FRTSOProgressionTagSet::ConsumeChangeLog(TArray<FRTSOProgressionTagChange>& OutChanges)
+{
+	OutChanges.Append(ChangeLog);
+	ChangeLog.Reset();
+}
+
+void FRTSOProgressionTagSet::RebuildMatchBits()
+{
+	FRTSOProgressionTagRegistry& Registry = FRTSOProgressionTagRegistry::Get();
+	
+	MatchBits.Init(false, ExplicitBits.Num());
+	for (TConstSetBitIterator<> ExplicitIt(ExplicitBits); ExplicitIt; ++ExplicitIt)
+	{
+		const int32 TagBit = ExplicitIt.GetIndex();
+		MatchBits[TagBit] = true;
+		for (FGameplayTag ParentTag = Registry.GetTag(TagBit).RequestDirectParent(); ParentTag.IsValid(); ParentTag = ParentTag.RequestDirectParent())
+		{
+			SetBit(MatchBits, Registry.Intern(ParentTag), true);
+		}
+	}
+}
+
+//
+// Selection groups
+void FRTSOSelectionGroups::Difference(TConstArrayView<FMassEntityHandle> Left, TConstArrayView<FMassEntityHandle> Right, TArray<FMassEntityHandle>& OutDifference)
+{
+	OutDifference.Reset();
+	
+	int32 RightIdx = 0;
+	for (const FMassEntityHandle& Handle : Left)
+	{
+		while (Right.IsValidIndex(RightIdx) && HandleLess(Right[RightIdx], Handle)) { RightIdx++; }
+		
+		const bool bInRight = Right.IsValidIndex(RightIdx) && Right[RightIdx] == Handle;
+		if (bInRight == false) { OutDifference.Emplace(Handle); }
+	}
+}
+
+void FRTSOSelectionGroups::SetGroup(int32 GroupID, TArray<FMassEntityHandle>&& Handles)
+{
+	if (Handles.IsEmpty())
+	{
+		Groups.Remove(GroupID);
+		return;
+	}
+	
+	Algo::Sort(Handles, &FRTSOSelectionGroups::HandleLess);
+	Handles.SetNum(Algo::Unique(Handles));
+	Groups.FindOrAdd(GroupID) = MoveTemp(Handles);
+}
+
+void FRTSOSelectionGroups::MergeSorted(TArray<FMassEntityHandle>& Sorted, TConstArrayView<FMassEntityHandle> Added)
+{
+	if (Added.IsEmpty()) { return; }
+
+	int32 SortedIdx = Sorted.Num() - 1;
+	int32 AddedIdx = Added.Num() - 1;
+	Sorted.SetNumUninitialized(Sorted.Num() + Added.Num(), false);
+	for (int32 WriteIdx = Sorted.Num() - 1; AddedIdx >= 0; WriteIdx--)
+	{
+		const bool bTakeAdded = SortedIdx < 0 || HandleLess(Sorted[SortedIdx], Added[AddedIdx]);
+		Sorted[WriteIdx] = bTakeAdded ? Added[AddedIdx--] : Sorted[SortedIdx--];
+	}
+}
+
+void FRTSOSelectionGroups::RemoveSorted(TArray<FMassEntityHandle>& Sorted, TConstArrayView<FMassEntityHandle> Removed, TArray<FMassEntityHandle>& OutRemoved)
+{
+	OutRemoved.Reset();
+	if (Removed.IsEmpty() || Sorted.IsEmpty()) { return; }
+
+	// Everything before the first removed handle stays in place
+	const int32 FirstIdx = Algo::LowerBound(Sorted, Removed[0], &FRTSOSelectionGroups::HandleLess);
+	int32 RemovedIdx = 0;
+	int32 WriteIdx = FirstIdx;
+	for (int32 ReadIdx = FirstIdx; ReadIdx < Sorted.Num(); ReadIdx++)
+	{
+		const FMassEntityHandle Handle = Sorted[ReadIdx];
+		while (Removed.IsValidIndex(RemovedIdx) && HandleLess(Removed[RemovedIdx], Handle)) { RemovedIdx++; }
+
+		if (Removed.IsValidIndex(RemovedIdx) && Removed[RemovedIdx] == Handle)
+		{
+			OutRemoved.Emplace(Handle);
+			continue;
+		}
+		Sorted[WriteIdx++] = Handle;
+	}
+	Sorted.SetNum(WriteIdx, false);
+}
+
+void FRTSOSelectionGroups::AddToGroup(int32 GroupID, TConstArrayView<FMassEntityHandle> Handles, TArray<FMassEntityHandle>& OutAdded)
+{
+	TArray<FMassEntityHandle> SortedHandles(Handles);
+	Algo::Sort(SortedHandles, &FRTSOSelectionGroups::HandleLess);
+	SortedHandles.SetNum(Algo::Unique(SortedHandles));
+
+	// Only create the group once we know something is actually added to it
+	TArray<FMassEntityHandle>* Group = Groups.Find(GroupID);
+	if (Group == nullptr)
+	{
+		OutAdded = SortedHandles;
+		if (SortedHandles.IsEmpty() == false) { Groups.Emplace(GroupID, MoveTemp(SortedHandles)); }
+		return;
+	}
+	
+	Difference(SortedHandles, *Group, OutAdded);
+	MergeSorted(*Group, OutAdded);
+}
+
+void FRTSOSelectionGroups::RemoveFromGroup(int32 GroupID, TConstArrayView<FMassEntityHandle> Handles, TArray<FMassEntityHandle>& OutRemoved)
+{
+	OutRemoved.Reset();
+	
+	TArray<FMassEntityHandle>* Group = Groups.Find(GroupID);
+	if (Group == nullptr) { return; }
+
+	TArray<FMassEntityHandle> SortedHandles(Handles);
+	Algo::Sort(SortedHandles, &FRTSOSelectionGroups::HandleLess);
+	SortedHandles.SetNum(Algo::Unique(SortedHandles));
+	RemoveSorted(*Group, SortedHandles, OutRemoved);
+
+	if (Group->IsEmpty()) { Groups.Remove(GroupID); }
+}
+
+bool FRTSOSelectionGroups::MoveGroup(int32 OldID, int32 NewID)
+{
+	if (OldID == NewID) { return Groups.Contains(OldID); }
+	
+	TArray<FMassEntityHandle> MovedGroup;
+	if (Groups.RemoveAndCopyValue(OldID, MovedGroup) == false) { return false; }
+
+	Groups.FindOrAdd(NewID) = MoveTemp(MovedGroup);
+	return true;
+}
+
+bool FRTSOSelectionGroups::IsInGroup(int32 GroupID, const FMassEntityHandle& Handle) const
+{
+	const TArray<FMassEntityHandle>* Group = Groups.Find(GroupID);
+	return Group != nullptr && Algo::BinarySearch(*Group, Handle, &FRTSOSelectionGroups::HandleLess) != INDEX_NONE;
+}
+
+void FRTSOSelectionGroups::GetGroupEntityIndices(int32 GroupID, TArray<int32>& OutIndices) const
+{
+	OutIndices.Reset();
+	
+	const TArray<FMassEntityHandle>* Group = Groups.Find(GroupID);
+	if (Group == nullptr) { return; }
+
+	OutIndices.Reserve(Group->Num());
+	for (const FMassEntityHandle& Handle : *Group)
+	{
+		OutIndices.Emplace(Handle.Index);
+	}
+}
+
+//
+// Godhand hover candidates
+FRTSOHoverCandidate FRTSOHoverCandidate::MakeActor(AActor* InActor, double InDistanceSquared)
+{
+	FRTSOHoverCandidate Candidate;
+	Candidate.Actor = InActor;
+	Candidate.DistanceSquared = InDistanceSquared;
+	Candidate.TieBreakKey = static_cast<uint64>(InActor->GetUniqueID());
+	return Candidate;
+}
+
+FRTSOHoverCandidate FRTSOHoverCandidate::MakeEntity(const FMassEntityHandle& InEntity, double InDistanceSquared)
+{
+	FRTSOHoverCandidate Candidate;
+	Candidate.Entity = InEntity;
+	Candidate.DistanceSquared = InDistanceSquared;
+	// High bit set so actors rank first on equal distance
+	Candidate.TieBreakKey = (1ull << 63) | (static_cast<uint64>(static_cast<uint32>(InEntity.SerialNumber) & 0x7FFFFFFF) << 32) | static_cast<uint32>(InEntity.Index);
+	return Candidate;
+}
+
+bool FRTSOHoverCandidateCache::IsStale(const FRTSOHoverInputs& Inputs) const
+{
+	if (bHasBuilt == false) { return true; }
+
+	return BuiltInputs.ActorPopulationVersion != Inputs.ActorPopulationVersion
+		|| BuiltInputs.EntityPopulationSignature != Inputs.EntityPopulationSignature
+		|| BuiltInputs.CursorLocation.Equals(Inputs.CursorLocation, LocationTolerance) == false
+		|| BuiltInputs.CameraLocation.Equals(Inputs.CameraLocation, LocationTolerance) == false
+		|| BuiltInputs.CameraRotation.Equals(Inputs.CameraRotation, RotationTolerance) == false;
+}
+
+void FRTSOHoverCandidateCache::Rebuild(const FRTSOHoverInputs& Inputs, TArray<FRTSOHoverCandidate>&& NewCandidates)
+{
+	BuiltInputs = Inputs;
+	Candidates = MoveTemp(NewCandidates);
+	Candidates.Sort();
+	bHasBuilt = true;
+}
+
+AActor* FRTSOHoverCandidateCache::GetClosestActor() const
+{
+	for (const FRTSOHoverCandidate& Candidate : Candidates)
+	{
+		if (Candidate.IsEntity()) { continue; }
+		
+		// Candidates are not re-ranked between rebuilds, skip any actor that has been destroyed since
+		AActor* Actor = Candidate.Actor.Get();
+		if (Actor != nullptr) { return Actor; }
+	}
+	return nullptr;
+}
+
+FMassEntityHandle FRTSOHoverCandidateCache::GetClosestEntity(const FMassEntityManager& EntityManager, const FVector& CursorLocation, const double Radius) const
+{
+	// Entities keep moving between rebuilds, their gathered distances go stale. Re-rank against their live transforms and drop any that left the radius
+	FMassEntityHandle ClosestEntity{0, 0};
+	double ClosestDistanceSquared = Radius * Radius;
+	for (const FRTSOHoverCandidate& Candidate : Candidates)
+	{
+		if (Candidate.IsEntity() == false || EntityManager.IsEntityValid(Candidate.Entity) == false) { continue; }
+
+		const FTransformFragment* TransformFragment = EntityManager.GetFragmentDataPtr<FTransformFragment>(Candidate.Entity);
+		if (TransformFragment == nullptr) { continue; }
+
+		const double DistanceSquared = FVector::DistSquared(TransformFragment->GetTransform().GetLocation(), CursorLocation);
+		if (DistanceSquared >= ClosestDistanceSquared) { continue; } // Ties keep the earlier, better ranked, candidate
+
+		ClosestEntity = Candidate.Entity;
+		ClosestDistanceSquared = DistanceSquared;
+	}
+	return ClosestEntity;
+}
+
+//
+// Marquee screen selection index
+void FRTSOScreenSelectionIndex::BeginBuild(const FIntRect& InViewRect, const FMatrix& InViewProjection)
+{
+	ViewRect = InViewRect;
+	ViewProjection = InViewProjection;
+	TileCount = FIntPoint{
+		FMath::DivideAndRoundUp(FMath::Max(ViewRect.Width(), 1), TileSize),
+		FMath::DivideAndRoundUp(FMath::Max(ViewRect.Height(), 1), TileSize)};
+	
+	Entities.Reset();
+	TileStarts.Reset();
+}
+
+void FRTSOScreenSelectionIndex::AddEntity(const FMassEntityHandle& Handle, const FVector& WorldLocation)
+{
+	FVector2D ScreenLocation;
+	if (FSceneView::ProjectWorldToScreen(WorldLocation, ViewRect, ViewProjection, ScreenLocation) == false) { return; } // Behind the camera
+	if (ScreenLocation.X < ViewRect.Min.X || ScreenLocation.Y < ViewRect.Min.Y || ScreenLocation.X >= ViewRect.Max.X || ScreenLocation.Y >= ViewRect.Max.Y) { return; }
+
+	const int32 TileX = FMath::Clamp(FMath::FloorToInt32(ScreenLocation.X - ViewRect.Min.X) / TileSize, 0, TileCount.X - 1);
+	const int32 TileY = FMath::Clamp(FMath::FloorToInt32(ScreenLocation.Y - ViewRect.Min.Y) / TileSize, 0, TileCount.Y - 1);
+	Entities.Emplace(FProjectedEntity{Handle, ScreenLocation, TileY * TileCount.X + TileX});
+}
+
+void FRTSOScreenSelectionIndex::FinishBuild()
+{
+	// Counting sort by tile
+	const int32 NumTiles = TileCount.X * TileCount.Y;
+	TileStarts.SetNumZeroed(NumTiles + 1);
+	for (const FProjectedEntity& Projected : Entities)
+	{
+		TileStarts[Projected.TileIdx + 1]++;
+	}
+	for (int32 TileIdx = 0; TileIdx < NumTiles; TileIdx++)
+	{
+		TileStarts[TileIdx + 1] += TileStarts[TileIdx];
+	}
+
+	TArray<int32> WriteOffsets(TileStarts.GetData(), NumTiles);
+	TArray<FProjectedEntity> Sorted;
+	Sorted.SetNumUninitialized(Entities.Num());
+	for (const FProjectedEntity& Projected : Entities)
+	{
+		Sorted[WriteOffsets[Projected.TileIdx]++] = Projected;
+	}
+	Entities = MoveTemp(Sorted);
+}
+
+void FRTSOScreenSelectionIndex::Invalidate()
+{
+	TileCount = FIntPoint::ZeroValue;
+	Entities.Reset();
+	TileStarts.Reset();
+}
+
+void FRTSOScreenSelectionIndex::Query(const FVector2D& CornerA, const FVector2D& CornerB, TArray<FMassEntityHandle>& OutHandles) const
+{
+	if (Entities.IsEmpty() || TileStarts.IsEmpty()) { return; }
+	
+	const FVector2D Min = FVector2D::Min(CornerA, CornerB);
+	const FVector2D Max = FVector2D::Max(CornerA, CornerB);
+	
+	const int32 MinTileX = FMath::Clamp(FMath::FloorToInt32(Min.X - ViewRect.Min.X) / TileSize, 0, TileCount.X - 1);
+	const int32 MinTileY = FMath::Clamp(FMath::FloorToInt32(Min.Y - ViewRect.Min.Y) / TileSize, 0, TileCount.Y - 1);
+	const int32 MaxTileX = FMath::Clamp(FMath::FloorToInt32(Max.X - ViewRect.Min.X) / TileSize, 0, TileCount.X - 1);
+	const int32 MaxTileY = FMath::Clamp(FMath::FloorToInt32(Max.Y - ViewRect.Min.Y) / TileSize, 0, TileCount.Y - 1);
+	
+	for (int32 TileY = MinTileY; TileY <= MaxTileY; TileY++)
+	{
+		for (int32 TileX = MinTileX; TileX <= MaxTileX; TileX++)
+		{
+			const int32 TileIdx = TileY * TileCount.X + TileX;
+
+			// Tiles fully inside the rectangle need no per-entity test
+			const FVector2D TileMin{ViewRect.Min.X + TileX * TileSize, ViewRect.Min.Y + TileY * TileSize};
+			const FVector2D TileMax = TileMin + FVector2D(TileSize);
+			const bool bIsCovered = TileMin.X >= Min.X && TileMin.Y >= Min.Y && TileMax.X <= Max.X && TileMax.Y <= Max.Y;
+			
+			for (int32 EntityIdx = TileStarts[TileIdx]; EntityIdx < TileStarts[TileIdx + 1]; EntityIdx++)
+			{
+				const FProjectedEntity& Projected = Entities[EntityIdx];
+				if (bIsCovered == false
+					&& (Projected.ScreenLocation.X < Min.X || Projected.ScreenLocation.Y < Min.Y || Projected.ScreenLocation.X > Max.X || Projected.ScreenLocation.Y > Max.Y))
+				{
+					continue;
+				}
+				OutHandles.Emplace(Projected.Handle);
+			}
+		}
+	}
+}
+
+
 bool FRTSOSettingsKeyData::Serialize(FArchive& Ar)
 {
 	Ar << HiddenSettingIdToMatchAgainst;
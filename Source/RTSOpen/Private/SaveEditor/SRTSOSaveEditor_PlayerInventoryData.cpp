@@ -246,9 +246,10 @@ TSharedRef<ITableRow> SRTSOSaveEditor_PlayerInventoryData::MakeListViewWidget_It
 	FPDItemNetDatum& SavedItemDatum = *InItem.Get();
 
 	TArray<TSharedPtr<FStacksStruct>> CurrentStacksAsSharedTupleArray;
-	for (const TTuple<int32, int32>& SelectedStack : SavedItemDatum.Stacks)
+	const int32 StackCount = SavedItemDatum.GetStackCount();
+	for (int32 StackIdx = 0; StackIdx < StackCount; StackIdx++)
 	{
-		FStacksStruct StackDatum{SelectedStack.Key, SelectedStack.Value};
+		FStacksStruct StackDatum{StackIdx, SavedItemDatum.GetStackItemCount(StackIdx)};
 		CurrentStacksAsSharedTupleArray.Emplace(MakeShared<FStacksStruct>(StackDatum).ToSharedPtr());
 	}
 
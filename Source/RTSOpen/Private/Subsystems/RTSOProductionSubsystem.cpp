@@ -0,0 +1,400 @@
+﻿/* @author: Ario Amin @ Permafrost Development. @copyright: Full BSL(1.1) License included at bottom of the file  */
+#include "Subsystems/RTSOProductionSubsystem.h"
+
+#include "Core/RTSOBaseGM.h"
+#include "PDBuildCommon.h"
+#include "PDRTSBaseSubsystem.h"
+#include "PDRTSCommon.h"
+#include "Components/PDInventoryComponent.h"
+#include "MassSpawnerSubsystem.h"
+
+URTSOProductionSubsystem* URTSOProductionSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject != nullptr ? WorldContextObject->GetWorld() : nullptr;
+	return World != nullptr ? World->GetSubsystem<URTSOProductionSubsystem>() : nullptr;
+}
+
+bool URTSOProductionSubsystem::EnqueueProduction(AActor* Building, const FPDBuildAction& ActionData, int32 OwnerID, int32 Count, UPDInventoryComponent* Payer)
+{
+	if (Building == nullptr || Count <= 0) { return false; }
+
+	// Reserve the full cost up-front so the same resources can't be spent twice while the units are being produced
+	if (Payer != nullptr)
+	{
+		if (Payer->CanAfford(ActionData.ActionCost, Count) == false) { return false; }
+		
+		for (const TPair<FGameplayTag, int32>& Cost : ActionData.ActionCost)
+		{
+			Payer->RequestUpdateItem(EPDItemNetOperation::CHANGE, Cost.Key, -(Cost.Value * Count));
+		}
+	}
+
+	FRTSOProductionQueue& Queue = FindOrAddQueue(Building);
+	FRTSOProductionOrder& Order = Queue.Orders.AddDefaulted_GetRef();
+	Order.UnitTag = ActionData.ActionTag;
+	Order.OwnerID = OwnerID;
+	Order.RemainingCount = Count;
+	Order.SecondsPerUnit = FMath::Max(ActionData.ProductionTime, 0.0);
+	Order.UnitCost = ActionData.ActionCost;
+	Order.Payer = Payer;
+	return true;
+}
+
+int32 URTSOProductionSubsystem::CancelProduction(const AActor* Building, int32 OrderIdx)
+{
+	const int32* QueueIdx = QueueIndices.Find(Building);
+	if (QueueIdx == nullptr) { return 0; }
+
+	FRTSOProductionQueue& Queue = Queues[*QueueIdx];
+	if (Queue.Orders.IsValidIndex(OrderIdx) == false) { return 0; }
+
+	const int32 CancelledCount = Queue.Orders[OrderIdx].RemainingCount;
+	RefundOrder(Queue.Orders[OrderIdx], CancelledCount);
+	Queue.Orders.RemoveAt(OrderIdx);
+	
+	// Progress belonged to the unit that was being produced
+	if (OrderIdx == 0) { Queue.HeadProgress = 0.0; }
+	
+	if (Queue.Orders.IsEmpty() && Queue.RallyPoint.IsSet() == false) { RemoveQueueAt(*QueueIdx); }
+	return CancelledCount;
+}
+
+void URTSOProductionSubsystem::CancelAllProduction(const AActor* Building)
+{
+	const int32* QueueIdx = QueueIndices.Find(Building);
+	if (QueueIdx == nullptr) { return; }
+	
+	for (const FRTSOProductionOrder& Order : Queues[*QueueIdx].Orders)
+	{
+		RefundOrder(Order, Order.RemainingCount);
+	}
+	RemoveQueueAt(*QueueIdx);
+}
+
+void URTSOProductionSubsystem::SetRallyPoint(AActor* Building, const FVector& RallyPoint)
+{
+	if (Building == nullptr) { return; }
+	FindOrAddQueue(Building).RallyPoint = RallyPoint;
+}
+
+void URTSOProductionSubsystem::ClearRallyPoint(const AActor* Building)
+{
+	const int32* QueueIdx = QueueIndices.Find(Building);
+	if (QueueIdx == nullptr) { return; }
+
+	FRTSOProductionQueue& Queue = Queues[*QueueIdx];
+	Queue.RallyPoint.Reset();
+	if (Queue.Orders.IsEmpty()) { RemoveQueueAt(*QueueIdx); }
+}
+
+void URTSOProductionSubsystem::AddReservedCosts(const UPDInventoryComponent* Payer, TArray<FPDItemNetDatum>& InOutItems) const
+{
+	if (Payer == nullptr) { return; }
+
+	for (const FRTSOProductionQueue& Queue : Queues)
+	{
+		for (const FRTSOProductionOrder& Order : Queue.Orders)
+		{
+			if (Order.Payer.Get() != Payer || Order.RemainingCount <= 0) { continue; }
+
+			for (const TPair<FGameplayTag, int32>& Cost : Order.UnitCost)
+			{
+				if (Cost.Value <= 0) { continue; }
+				
+				FPDItemNetDatum* SavedItem = InOutItems.FindByKey(Cost.Key);
+				if (SavedItem == nullptr) { SavedItem = &InOutItems.Emplace_GetRef(Cost.Key, 0); }
+
+				// Widened, the reserved cost of a large order would otherwise wrap the saved count
+				const int64 RefundedCount = FMath::Max(SavedItem->TotalItemCount, 0) + static_cast<int64>(Cost.Value) * Order.RemainingCount;
+				SavedItem->TotalItemCount = static_cast<int32>(FMath::Min<int64>(RefundedCount, MAX_int32));
+			}
+		}
+	}
+}
+
+const FRTSOProductionQueue* URTSOProductionSubsystem::FindQueue(const AActor* Building) const
+{
+	const int32* QueueIdx = QueueIndices.Find(Building);
+	return QueueIdx != nullptr ? &Queues[*QueueIdx] : nullptr;
+}
+
+FRTSOProductionQueue& URTSOProductionSubsystem::FindOrAddQueue(AActor* Building)
+{
+	if (const int32* QueueIdx = QueueIndices.Find(Building))
+	{
+		return Queues[*QueueIdx];
+	}
+
+	const int32 NewIdx = Queues.AddDefaulted();
+	QueueIndices.Emplace(Building, NewIdx);
+	
+	FRTSOProductionQueue& Queue = Queues[NewIdx];
+	Queue.Building = Building;
+	Queue.BuildingKey = Building;
+	return Queue;
+}
+
+void URTSOProductionSubsystem::RemoveQueueAt(int32 QueueIdx)
+{
+	QueueIndices.Remove(Queues[QueueIdx].BuildingKey);
+	Queues.RemoveAtSwap(QueueIdx);
+	if (Queues.IsValidIndex(QueueIdx))
+	{
+		QueueIndices.FindChecked(Queues[QueueIdx].BuildingKey) = QueueIdx;
+	}
+}
+
+void URTSOProductionSubsystem::RefundOrder(const FRTSOProductionOrder& Order, int32 Count)
+{
+	UPDInventoryComponent* Payer = Order.Payer.Get();
+	if (Payer == nullptr || Count <= 0) { return; }
+	
+	for (const TPair<FGameplayTag, int32>& Cost : Order.UnitCost)
+	{
+		Payer->RequestUpdateItem(EPDItemNetOperation::CHANGE, Cost.Key, Cost.Value * Count);
+	}
+}
+
+void URTSOProductionSubsystem::Tick(float DeltaTime)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_RTSOProduction)
+	
+	Super::Tick(DeltaTime);
+
+	LastSpawnedCount = 0;
+	if (Queues.IsEmpty()) { return; }
+	
+	// Don't advance anything until mass is up, otherwise completed units would have nowhere to go
+	const UPDRTSBaseSubsystem* RTSSubsystem = UPDRTSBaseSubsystem::Get();
+	if (RTSSubsystem == nullptr || RTSSubsystem->EntityManager == nullptr || UWorld::GetSubsystem<UMassSpawnerSubsystem>(GetWorld()) == nullptr) { return; }
+	
+	AdvanceQueues(DeltaTime, GetDefault<URTSOProductionSettings>()->MaxSpawnsPerFrame);
+	FlushPendingUnits();
+}
+
+void URTSOProductionSubsystem::AdvanceQueues(double DeltaSeconds, int32 MaxSpawns)
+{
+	PendingUnits.Reset();
+	for (int32 QueueIdx = Queues.Num() - 1; QueueIdx >= 0; QueueIdx--)
+	{
+		FRTSOProductionQueue& Queue = Queues[QueueIdx];
+		if (Queue.Building.IsValid()) { continue; }
+		
+		// Building went away without cancelling, refund whatever it had left
+		for (const FRTSOProductionOrder& Order : Queue.Orders) { RefundOrder(Order, Order.RemainingCount); }
+		RemoveQueueAt(QueueIdx);
+	}
+	if (Queues.IsEmpty()) { return; }
+
+	// Start at the first queue that ran out of budget last frame, so the spawn budget rotates through every building instead of always favouring the same ones
+	const int32 QueueCount = Queues.Num();
+	const int32 StartIdx = QueueStartIdx % QueueCount;
+	int32 FirstStarvedIdx = INDEX_NONE;
+	TArray<int32, TInlineAllocator<32>> EmptiedQueues;
+	for (int32 Step = 0; Step < QueueCount; Step++)
+	{
+		const int32 QueueIdx = (StartIdx + Step) % QueueCount;
+		const int32 SpawnBudget = MaxSpawns - PendingUnits.Num();
+		
+		FRTSOProductionQueue& Queue = Queues[QueueIdx];
+		const bool bHasOrders = AdvanceQueue(Queue, DeltaSeconds, SpawnBudget);
+		if (bHasOrders == false && Queue.RallyPoint.IsSet() == false) { EmptiedQueues.Emplace(QueueIdx); }
+
+		// Starved if it got no budget at all, or used up the last of it while still holding a finished unit
+		const bool bHoldsFinishedUnit = bHasOrders && PendingUnits.Num() >= MaxSpawns && Queue.HeadProgress >= Queue.Orders[0].SecondsPerUnit;
+		if (FirstStarvedIdx == INDEX_NONE && (SpawnBudget <= 0 || bHoldsFinishedUnit)) { FirstStarvedIdx = QueueIdx; }
+	}
+	QueueStartIdx = FirstStarvedIdx != INDEX_NONE ? FirstStarvedIdx : StartIdx;
+
+	// Swap-removal pulls from the back, remove highest first so the remaining indices stay valid
+	EmptiedQueues.Sort(TGreater<int32>());
+	for (const int32 QueueIdx : EmptiedQueues)
+	{
+		RemoveQueueAt(QueueIdx);
+	}
+}
+
+bool URTSOProductionSubsystem::AdvanceQueue(FRTSOProductionQueue& Queue, double DeltaSeconds, int32 SpawnBudget)
+{
+	if (Queue.Orders.IsEmpty()) { return false; }
+
+	const AActor* Building = Queue.Building.Get();
+	const FVector SpawnLocation = Building->GetActorLocation() + Building->GetActorRotation().RotateVector(GetDefault<URTSOProductionSettings>()->SpawnOffset);
+	
+	Queue.HeadProgress += DeltaSeconds;
+	while (Queue.Orders.IsEmpty() == false)
+	{
+		FRTSOProductionOrder& Head = Queue.Orders[0];
+		if (Queue.HeadProgress < Head.SecondsPerUnit) { return true; }
+		
+		// Out of budget, hold the finished unit at the head until next frame
+		if (SpawnBudget <= 0)
+		{
+			Queue.HeadProgress = Head.SecondsPerUnit;
+			return true;
+		}
+		
+		FRTSSavedWorldUnits& Unit = PendingUnits.AddDefaulted_GetRef();
+		Unit.EntityUnitTag = Head.UnitTag;
+		Unit.OwnerID = Head.OwnerID;
+		Unit.Location = SpawnLocation;
+		if (Queue.RallyPoint.IsSet())
+		{
+			Unit.CurrentAction.ActionTag = TAG_AI_Job_WalkToTarget;
+			Unit.CurrentAction.OptTargets.ActionTargetAsLocation = FMassInt16Vector{Queue.RallyPoint.GetValue()};
+		}
+		
+		Queue.HeadProgress -= Head.SecondsPerUnit;
+		SpawnBudget--;
+		
+		Head.RemainingCount--;
+		if (Head.RemainingCount <= 0)
+		{
+			Queue.Orders.RemoveAt(0);
+		}
+	}
+
+	Queue.HeadProgress = 0.0;
+	return false;
+}
+
+void URTSOProductionSubsystem::FlushPendingUnits()
+{
+	if (PendingUnits.IsEmpty()) { return; }
+	
+	UPDRTSBaseSubsystem* RTSSubsystem = UPDRTSBaseSubsystem::Get();
+	UMassSpawnerSubsystem* SpawnerSystem = UWorld::GetSubsystem<UMassSpawnerSubsystem>(GetWorld());
+	
+	// Units from every building are pooled per entity template, one creation batch per template
+	// PendingUnits is not touched again until the next tick, so the pooled pointers stay valid throughout 
+	TMap<const FMassEntityTemplateID, ARTSOBaseGM::FEntityCompoundTuple> EntitiesToSpawn{};
+	for (const FRTSSavedWorldUnits& Unit : PendingUnits)
+	{
+		ARTSOBaseGM::GatherEntityToSpawn(*GetWorld(), Unit, EntitiesToSpawn, RTSSubsystem, SpawnerSystem);
+	}
+
+	for (const TTuple<const FMassEntityTemplateID, ARTSOBaseGM::FEntityCompoundTuple>& EntityTypeCompound : EntitiesToSpawn)
+	{
+		ARTSOBaseGM::DispatchEntitySpawning(EntityTypeCompound, RTSSubsystem->EntityManager, SpawnerSystem);
+	}
+	
+	LastSpawnedCount = PendingUnits.Num();
+}
+
+TStatId URTSOProductionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URTSOProductionSubsystem, STATGROUP_Tickables);
+}
+
+/**
+Business Source License 1.1
+
+Parameters
+
+Licensor:             Ario Amin (@ Permafrost Development)
+Licensed Work:        RTSOpen (Source available on github)
+                      The Licensed Work is (c) 2024 Ario Amin (@ Permafrost Development)
+Additional Use Grant: You may make free use of the Licensed Work in a commercial product or service provided these three additional conditions as met; 
+                      1. Must give attributions to the original author of the Licensed Work, in 'Credits' if that is applicable.
+                      2. The Licensed Work must be Compiled before being redistributed.
+                      3. The Licensed Work Source may be linked but may not be packaged into the product or service being sold
+                      4. Must not be resold or repackaged or redistributed as another product, is only allowed to be used within a commercial or non-commercial game project.
+                      5. Teams with yearly budgets larger than 100000 USD must contact the owner for a custom license or buy the framework from a marketplace it has been made available on.
+
+                      "Credits" indicate a scrolling screen with attributions. This is usually in a products end-state
+
+                      "Package" means the collection of files distributed by the Licensor, and derivatives of that collection
+                      and/or of those files..   
+
+                      "Source" form means the source code, documentation source, and configuration files for the Package, usually in human-readable format.
+
+                      "Compiled" form means the compiled bytecode, object code, binary, or any other
+                      form resulting from mechanical transformation or translation of the Source form.
+
+Change Date:          2028-04-17
+
+Change License:       Apache License, Version 2.0
+
+For information about alternative licensing arrangements for the Software,
+please visit: https://permadev.se/
+
+Notice
+
+The Business Source License (this document, or the “License”) is not an Open
+Source license. However, the Licensed Work will eventually be made available
+under an Open Source License, as stated in this License.
+
+License text copyright (c) 2017 MariaDB Corporation Ab, All Rights Reserved.
+“Business Source License” is a trademark of MariaDB Corporation Ab.
+
+-----------------------------------------------------------------------------
+
+Business Source License 1.1
+
+Terms
+
+The Licensor hereby grants you the right to copy, modify, create derivative
+works, redistribute, and make non-production use of the Licensed Work. The
+Licensor may make an Additional Use Grant, above, permitting limited
+production use.
+
+Effective on the Change Date, or the fourth anniversary of the first publicly
+available distribution of a specific version of the Licensed Work under this
+License, whichever comes first, the Licensor hereby grants you rights under
+the terms of the Change License, and the rights granted in the paragraph
+above terminate.
+
+If your use of the Licensed Work does not comply with the requirements
+currently in effect as described in this License, you must purchase a
+commercial license from the Licensor, its affiliated entities, or authorized
+resellers, or you must refrain from using the Licensed Work.
+
+All copies of the original and modified Licensed Work, and derivative works
+of the Licensed Work, are subject to this License. This License applies
+separately for each version of the Licensed Work and the Change Date may vary
+for each version of the Licensed Work released by Licensor.
+
+You must conspicuously display this License on each original or modified copy
+of the Licensed Work. If you receive the Licensed Work in original or
+modified form from a third party, the terms and conditions set forth in this
+License apply to your use of that work.
+
+Any use of the Licensed Work in violation of this License will automatically
+terminate your rights under this License for the current and all other
+versions of the Licensed Work.
+
+This License does not grant you any right in any trademark or logo of
+Licensor or its affiliates (provided that you may use a trademark or logo of
+Licensor as expressly required by this License).
+
+TO THE EXTENT PERMITTED BY APPLICABLE LAW, THE LICENSED WORK IS PROVIDED ON
+AN “AS IS” BASIS. LICENSOR HEREBY DISCLAIMS ALL WARRANTIES AND CONDITIONS,
+EXPRESS OR IMPLIED, INCLUDING (WITHOUT LIMITATION) WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT, AND
+TITLE.
+
+MariaDB hereby grants you permission to use this License’s text to license
+your works, and to refer to it using the trademark “Business Source License”,
+as long as you comply with the Covenants of Licensor below.
+
+Covenants of Licensor
+
+In consideration of the right to use this License’s text and the “Business
+Source License” name and trademark, Licensor covenants to MariaDB, and to all
+other recipients of the licensed work to be provided by Licensor:
+
+1. To specify as the Change License the GPL Version 2.0 or any later version,
+   or a license that is compatible with GPL Version 2.0 or a later version,
+   where “compatible” means that software provided under the Change License can
+   be included in a program with software provided under GPL Version 2.0 or a
+   later version. Licensor may specify additional Change Licenses without
+   limitation.
+
+2. To either: (a) specify an additional grant of rights to use that does not
+   impose any additional restriction on the right granted in this License, as
+   the Additional Use Grant; or (b) insert the text “None”.
+
+3. To specify a Change Date.
+
+4. Not to modify this License in any other way.
+ **/
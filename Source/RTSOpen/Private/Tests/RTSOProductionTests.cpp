@@ -0,0 +1,405 @@
+﻿/* @author: Ario Amin @ Permafrost Development. @copyright: Full BSL(1.1) License included at bottom of the file  */
+
+#include "Subsystems/RTSOProductionSubsystem.h"
+#include "PDBuildCommon.h"
+#include "PDBuilderSubsystem.h"
+#include "PDInventorySubsystem.h"
+#include "PDItemCommon.h"
+#include "PDRTSBaseSubsystem.h"
+#include "AI/Mass/PDMassFragments.h"
+#include "Components/PDInventoryComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "MassCommonFragments.h"
+#include "MassEntityQuery.h"
+#include "MassEntitySubsystem.h"
+#include "MassExecutionContext.h"
+#include "NativeGameplayTags.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace PD::Production::Tests
+{
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Test_Production_Wood, "Test.Production.Wood");
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_Test_Production_Stone, "Test.Production.Stone");
+
+	/** @brief Playing game world with mass running, the RTS subsystem is pointed at its entity manager for the lifetime of the scope */
+	struct FScopedProductionWorld
+	{
+		FScopedProductionWorld()
+		{
+			World = UWorld::CreateWorld(EWorldType::Game, false);
+			FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+			WorldContext.SetCurrentWorld(World);
+			World->InitializeActorsForPlay(FURL());
+			World->BeginPlay();
+
+			RTSSubsystem = UPDRTSBaseSubsystem::Get();
+			EntitySubsystem = World->GetSubsystem<UMassEntitySubsystem>();
+			if (RTSSubsystem == nullptr || EntitySubsystem == nullptr) { return; }
+			
+			PreviousEntityManager = RTSSubsystem->EntityManager;
+			RTSSubsystem->EntityManager = &EntitySubsystem->GetEntityManager();
+		}
+		~FScopedProductionWorld()
+		{
+			if (RTSSubsystem != nullptr && EntitySubsystem != nullptr) { RTSSubsystem->EntityManager = PreviousEntityManager; }
+			
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+		}
+
+		/** @brief Are mass and the production subsystem available in the world */
+		bool IsValid() const { return RTSSubsystem != nullptr && EntitySubsystem != nullptr && World->GetSubsystem<URTSOProductionSubsystem>() != nullptr; }
+
+		UWorld* World = nullptr;
+		UPDRTSBaseSubsystem* RTSSubsystem = nullptr;
+		UMassEntitySubsystem* EntitySubsystem = nullptr;
+		const FMassEntityManager* PreviousEntityManager = nullptr;
+	};
+
+	/** @brief Registers the test items in the inventory subsystem for the lifetime of the scope, inventories only accept items it can resolve */
+	struct FScopedProductionItems
+	{
+		FScopedProductionItems()
+		{
+			Subsystem = UPDInventorySubsystem::Get();
+			if (Subsystem == nullptr) { return; }
+
+			Wood.ItemTag = TAG_Test_Production_Wood;
+			Stone.ItemTag = TAG_Test_Production_Stone;
+			Subsystem->TagToItemMap.Emplace(Wood.ItemTag, &Wood);
+			Subsystem->TagToItemMap.Emplace(Stone.ItemTag, &Stone);
+		}
+		~FScopedProductionItems()
+		{
+			if (Subsystem == nullptr) { return; }
+			
+			Subsystem->TagToItemMap.Remove(Wood.ItemTag);
+			Subsystem->TagToItemMap.Remove(Stone.ItemTag);
+		}
+
+		UPDInventorySubsystem* Subsystem = nullptr;
+		FPDItemDefaultDatum Wood{};
+		FPDItemDefaultDatum Stone{};
+	};
+
+	/** @brief Total count of the item in the saved items, 0 if it has no entry */
+	int32 GetSavedTotal(const TArray<FPDItemNetDatum>& Items, const FGameplayTag& ItemTag)
+	{
+		const FPDItemNetDatum* Item = Items.FindByKey(ItemTag);
+		return Item != nullptr ? Item->TotalItemCount : 0;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRTSOProductionFairnessTest, "PD.RTSOpen.Production.BudgetFairness", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FRTSOProductionFairnessTest::RunTest(const FString& Parameters)
+{
+	// Headless, the queues are advanced without a world or mass, so nothing is spawned and only the scheduling is measured
+	constexpr int32 BuildingCount = 500;
+	constexpr int32 MaxSpawns = 256;
+	constexpr int32 FrameCount = 40;
+	constexpr double DeltaSeconds = 1.0 / 30.0;
+	
+	const TStrongObjectPtr<URTSOProductionSubsystem> Production(NewObject<URTSOProductionSubsystem>(GetTransientPackage()));
+	TArray<TStrongObjectPtr<AActor>> Buildings;
+	Buildings.Reserve(BuildingCount);
+	
+	FPDBuildAction Action;
+	Action.ProductionTime = 0.0; // Every building has a finished unit every frame, demand always exceeds the budget
+	for (int32 BuildingIdx = 0; BuildingIdx < BuildingCount; BuildingIdx++)
+	{
+		AActor* Building = Buildings.Emplace_GetRef(NewObject<AActor>(GetTransientPackage())).Get();
+		Production->SetRallyPoint(Building, FVector::ZeroVector); // Keeps the queues around while they are empty
+	}
+
+	TArray<int32> LastSpawnFrame;
+	LastSpawnFrame.Init(INDEX_NONE, BuildingCount);
+	int32 LongestWait = 0;
+	for (int32 Frame = 0; Frame < FrameCount; Frame++)
+	{
+		// Keep a single unit queued in every building, the owner ID doubles as the building index
+		for (int32 BuildingIdx = 0; BuildingIdx < BuildingCount; BuildingIdx++)
+		{
+			const FRTSOProductionQueue* Queue = Production->FindQueue(Buildings[BuildingIdx].Get());
+			if (Queue != nullptr && Queue->Orders.IsEmpty() == false) { continue; }
+			Production->EnqueueProduction(Buildings[BuildingIdx].Get(), Action, BuildingIdx, 1, nullptr);
+		}
+
+		const double StartSeconds = FPlatformTime::Seconds();
+		Production->AdvanceQueues(DeltaSeconds, MaxSpawns);
+		const double ElapsedMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+		AddInfo(FString::Printf(TEXT("Frame %i: %i units from %i buildings in %.3f ms"), Frame, Production->GetPendingUnits().Num(), BuildingCount, ElapsedMs));
+		
+		if (TestEqual(TEXT("Every frame spends exactly the spawn budget"), Production->GetPendingUnits().Num(), MaxSpawns) == false) { return false; }
+		for (const FRTSSavedWorldUnits& Unit : Production->GetPendingUnits())
+		{
+			LastSpawnFrame[Unit.OwnerID] = Frame;
+		}
+		for (int32 BuildingIdx = 0; BuildingIdx < BuildingCount; BuildingIdx++)
+		{
+			const int32 Wait = Frame - LastSpawnFrame[BuildingIdx];
+			LongestWait = FMath::Max(LongestWait, LastSpawnFrame[BuildingIdx] == INDEX_NONE ? Frame + 1 : Wait);
+		}
+	}
+
+	// 500 buildings sharing 256 spawns a frame, the budget needs two frames to go around
+	const int32 ExpectedWait = FMath::DivideAndRoundUp(BuildingCount, MaxSpawns) - 1;
+	TestTrue(TEXT("Every building spawned at least once"), LastSpawnFrame.Contains(INDEX_NONE) == false);
+	TestTrue(FString::Printf(TEXT("No building waits longer than the budget takes to rotate (waited %i frames)"), LongestWait), LongestWait <= ExpectedWait);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRTSOProductionBatchSpawnTest, "PD.RTSOpen.Production.BatchSpawn", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FRTSOProductionBatchSpawnTest::RunTest(const FString& Parameters)
+{
+	using namespace PD::Production::Tests;
+	
+	// Spawns a unit type from the projects build tables, so the real entity template is used
+	const UPDBuilderSubsystem* Builder = UPDBuilderSubsystem::Get();
+	const FPDBuildWorker* Worker = nullptr;
+	for (const FPDBuildWorker* Candidate : Builder != nullptr ? Builder->LookupTables.Workers : TArray<const FPDBuildWorker*>{})
+	{
+		if (Candidate == nullptr || Candidate->MassEntityData == nullptr || Candidate->MassEntityData->EntityConfig.IsNull()) { continue; }
+		
+		Worker = Candidate;
+		break;
+	}
+	if (Worker == nullptr)
+	{
+		AddWarning(TEXT("No worker type with an entity config in the build tables, nothing to spawn"));
+		return true;
+	}
+
+	const FScopedProductionWorld TestWorld;
+	if (TestWorld.IsValid() == false)
+	{
+		AddError(TEXT("Mass or the production subsystem is not available in the test world"));
+		return false;
+	}
+	URTSOProductionSubsystem* Production = TestWorld.World->GetSubsystem<URTSOProductionSubsystem>();
+
+	// Several buildings complete units on the same frame, they are all spawned through the same batch
+	constexpr int32 OwnerID = 4242;
+	const TArray<int32> UnitsPerBuilding{2, 3, 1};
+	FPDBuildAction Action;
+	Action.ActionTag = Worker->WorkerType;
+	Action.ProductionTime = 0.0;
+
+	TArray<FVector> SpawnLocations;
+	TArray<AActor*> Buildings;
+	for (int32 BuildingIdx = 0; BuildingIdx < UnitsPerBuilding.Num(); BuildingIdx++)
+	{
+		const FVector BuildingLocation{BuildingIdx * 2000.0, 0.0, 0.0};
+		AActor* Building = Buildings.Emplace_GetRef(TestWorld.World->SpawnActor<AStaticMeshActor>(BuildingLocation, FRotator::ZeroRotator));
+		TestTrue(TEXT("Production is queued"), Production->EnqueueProduction(Building, Action, OwnerID, UnitsPerBuilding[BuildingIdx], nullptr));
+		SpawnLocations.Emplace(BuildingLocation + GetDefault<URTSOProductionSettings>()->SpawnOffset);
+	}
+	Production->SetRallyPoint(Buildings[0], FVector{0.0, 5000.0, 0.0});
+
+	Production->Tick(0.1f);
+	TestEqual(TEXT("Every completed unit is spawned in the same frame"), Production->LastSpawnedCount, 6);
+	TestTrue(TEXT("Emptied queues without a rally point are removed"), Production->FindQueue(Buildings[1]) == nullptr && Production->FindQueue(Buildings[2]) == nullptr);
+	TestTrue(TEXT("The queue with a rally point is kept"), Production->FindQueue(Buildings[0]) != nullptr);
+
+	// The spawned entities carry the owner and location of the building that produced them
+	FMassEntityManager& EntityManager = TestWorld.EntitySubsystem->GetMutableEntityManager();
+	FMassEntityQuery Query;
+	Query.AddRequirement<FPDMFragment_RTSEntityBase>(EMassFragmentAccess::ReadOnly);
+	Query.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+
+	int32 SpawnedCount = 0;
+	TArray<int32> UnitsPerLocation;
+	UnitsPerLocation.Init(0, SpawnLocations.Num());
+	FMassExecutionContext Context(EntityManager, 0.f);
+	Query.ForEachEntityChunk(EntityManager, Context, [&](FMassExecutionContext& LambdaContext)
+	{
+		const TConstArrayView<FPDMFragment_RTSEntityBase> EntityBases = LambdaContext.GetFragmentView<FPDMFragment_RTSEntityBase>();
+		const TConstArrayView<FTransformFragment> Transforms = LambdaContext.GetFragmentView<FTransformFragment>();
+		for (int32 EntityIdx = 0; EntityIdx < LambdaContext.GetNumEntities(); ++EntityIdx)
+		{
+			if (EntityBases[EntityIdx].OwnerID != OwnerID) { continue; }
+
+			SpawnedCount++;
+			const FVector Location = Transforms[EntityIdx].GetTransform().GetLocation();
+			const int32 LocationIdx = SpawnLocations.IndexOfByPredicate([&Location](const FVector& SpawnLocation) { return SpawnLocation.Equals(Location, 1.0); });
+			if (LocationIdx != INDEX_NONE) { UnitsPerLocation[LocationIdx]++; }
+		}
+	});
+	TestEqual(TEXT("Every unit exists as an entity with the orders owner"), SpawnedCount, 6);
+	TestTrue(TEXT("Every unit spawned at the building that produced it"), UnitsPerLocation == UnitsPerBuilding);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRTSOProductionSaveReservedCostsTest, "PD.RTSOpen.Production.SaveReservedCosts", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FRTSOProductionSaveReservedCostsTest::RunTest(const FString& Parameters)
+{
+	using namespace PD::Production::Tests;
+	const FScopedProductionItems TestItems;
+	const FScopedProductionWorld TestWorld;
+	if (TestItems.Subsystem == nullptr || TestWorld.World->GetSubsystem<URTSOProductionSubsystem>() == nullptr)
+	{
+		AddError(TEXT("The inventory or production subsystem is not available"));
+		return false;
+	}
+	URTSOProductionSubsystem* Production = TestWorld.World->GetSubsystem<URTSOProductionSubsystem>();
+
+	AActor* Owner = TestWorld.World->SpawnActor<AStaticMeshActor>();
+	UPDInventoryComponent* Payer = NewObject<UPDInventoryComponent>(Owner);
+	UPDInventoryComponent* OtherInventory = NewObject<UPDInventoryComponent>(Owner);
+	FGameplayTag Wood = TAG_Test_Production_Wood;
+	Payer->ItemList.UpdateItem(Wood, 100);
+
+	FPDBuildAction Action;
+	Action.ProductionTime = 1.0;
+	Action.ActionCost = {{TAG_Test_Production_Wood, 10}, {TAG_Test_Production_Stone, 0}};
+	TestTrue(TEXT("Production is queued"), Production->EnqueueProduction(Owner, Action, 0, 3, Payer));
+	TestEqual(TEXT("The cost is reserved from the live inventory"), GetSavedTotal(Payer->ItemList.Items, TAG_Test_Production_Wood), 70);
+
+	// Saving hands the reserved cost back to the saved items only
+	TArray<FPDItemNetDatum> SavedItems = Payer->ItemList.Items;
+	Production->AddReservedCosts(Payer, SavedItems);
+	TestEqual(TEXT("Saved items include the reserved cost"), GetSavedTotal(SavedItems, TAG_Test_Production_Wood), 100);
+	TestEqual(TEXT("The live inventory keeps the reservation"), GetSavedTotal(Payer->ItemList.Items, TAG_Test_Production_Wood), 70);
+	TestEqual(TEXT("Free cost lines add nothing"), GetSavedTotal(SavedItems, TAG_Test_Production_Stone), 0);
+
+	// Produced units are paid for, only the remaining units are handed back
+	Production->AdvanceQueues(1.0, 16);
+	SavedItems = Payer->ItemList.Items;
+	Production->AddReservedCosts(Payer, SavedItems);
+	TestEqual(TEXT("Only the remaining units are handed back"), GetSavedTotal(SavedItems, TAG_Test_Production_Wood), 90);
+
+	// Items missing from the saved list are added, other inventories get nothing
+	TArray<FPDItemNetDatum> EmptyItems;
+	Production->AddReservedCosts(Payer, EmptyItems);
+	TestEqual(TEXT("A missing saved item is added"), GetSavedTotal(EmptyItems, TAG_Test_Production_Wood), 20);
+	TArray<FPDItemNetDatum> OtherItems;
+	Production->AddReservedCosts(OtherInventory, OtherItems);
+	TestTrue(TEXT("Inventories that paid for nothing get nothing"), OtherItems.IsEmpty());
+
+	// Cancelling refunds the live inventory, nothing is left reserved
+	Production->CancelAllProduction(Owner);
+	TestEqual(TEXT("Cancelling refunds the live inventory"), GetSavedTotal(Payer->ItemList.Items, TAG_Test_Production_Wood), 90);
+	SavedItems = Payer->ItemList.Items;
+	Production->AddReservedCosts(Payer, SavedItems);
+	TestEqual(TEXT("Nothing is reserved after cancelling"), GetSavedTotal(SavedItems, TAG_Test_Production_Wood), 90);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
+
+/**
+Business Source License 1.1
+
+Parameters
+
+Licensor:             Ario Amin (@ Permafrost Development)
+Licensed Work:        RTSOpen (Source available on github)
+                      The Licensed Work is (c) 2024 Ario Amin (@ Permafrost Development)
+Additional Use Grant: You may make free use of the Licensed Work in a commercial product or service provided these three additional conditions as met; 
+                      1. Must give attributions to the original author of the Licensed Work, in 'Credits' if that is applicable.
+                      2. The Licensed Work must be Compiled before being redistributed.
+                      3. The Licensed Work Source may be linked but may not be packaged into the product or service being sold
+                      4. Must not be resold or repackaged or redistributed as another product, is only allowed to be used within a commercial or non-commercial game project.
+                      5. Teams with yearly budgets larger than 100000 USD must contact the owner for a custom license or buy the framework from a marketplace it has been made available on.
+
+                      "Credits" indicate a scrolling screen with attributions. This is usually in a products end-state
+
+                      "Package" means the collection of files distributed by the Licensor, and derivatives of that collection
+                      and/or of those files..   
+
+                      "Source" form means the source code, documentation source, and configuration files for the Package, usually in human-readable format.
+
+                      "Compiled" form means the compiled bytecode, object code, binary, or any other
+                      form resulting from mechanical transformation or translation of the Source form.
+
+Change Date:          2028-04-17
+
+Change License:       Apache License, Version 2.0
+
+For information about alternative licensing arrangements for the Software,
+please visit: https://permadev.se/
+
+Notice
+
+The Business Source License (this document, or the “License”) is not an Open
+Source license. However, the Licensed Work will eventually be made available
+under an Open Source License, as stated in this License.
+
+License text copyright (c) 2017 MariaDB Corporation Ab, All Rights Reserved.
+“Business Source License” is a trademark of MariaDB Corporation Ab.
+
+-----------------------------------------------------------------------------
+
+Business Source License 1.1
+
+Terms
+
+The Licensor hereby grants you the right to copy, modify, create derivative
+works, redistribute, and make non-production use of the Licensed Work. The
+Licensor may make an Additional Use Grant, above, permitting limited
+production use.
+
+Effective on the Change Date, or the fourth anniversary of the first publicly
+available distribution of a specific version of the Licensed Work under this
+License, whichever comes first, the Licensor hereby grants you rights under
+the terms of the Change License, and the rights granted in the paragraph
+above terminate.
+
+If your use of the Licensed Work does not comply with the requirements
+currently in effect as described in this License, you must purchase a
+commercial license from the Licensor, its affiliated entities, or authorized
+resellers, or you must refrain from using the Licensed Work.
+
+All copies of the original and modified Licensed Work, and derivative works
+of the Licensed Work, are subject to this License. This License applies
+separately for each version of the Licensed Work and the Change Date may vary
+for each version of the Licensed Work released by Licensor.
+
+You must conspicuously display this License on each original or modified copy
+of the Licensed Work. If you receive the Licensed Work in original or
+modified form from a third party, the terms and conditions set forth in this
+License apply to your use of that work.
+
+Any use of the Licensed Work in violation of this License will automatically
+terminate your rights under this License for the current and all other
+versions of the Licensed Work.
+
+This License does not grant you any right in any trademark or logo of
+Licensor or its affiliates (provided that you may use a trademark or logo of
+Licensor as expressly required by this License).
+
+TO THE EXTENT PERMITTED BY APPLICABLE LAW, THE LICENSED WORK IS PROVIDED ON
+AN “AS IS” BASIS. LICENSOR HEREBY DISCLAIMS ALL WARRANTIES AND CONDITIONS,
+EXPRESS OR IMPLIED, INCLUDING (WITHOUT LIMITATION) WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT, AND
+TITLE.
+
+MariaDB hereby grants you permission to use this License’s text to license
+your works, and to refer to it using the trademark “Business Source License”,
+as long as you comply with the Covenants of Licensor below.
+
+Covenants of Licensor
+
+In consideration of the right to use this License’s text and the “Business
+Source License” name and trademark, Licensor covenants to MariaDB, and to all
+other recipients of the licensed work to be provided by Licensor:
+
+1. To specify as the Change License the GPL Version 2.0 or any later version,
+   or a license that is compatible with GPL Version 2.0 or a later version,
+   where “compatible” means that software provided under the Change License can
+   be included in a program with software provided under GPL Version 2.0 or a
+   later version. Licensor may specify additional Change Licenses without
+   limitation.
+
+2. To either: (a) specify an additional grant of rights to use that does not
+   impose any additional restriction on the right granted in this License, as
+   the Additional Use Grant; or (b) insert the text “None”.
+
+3. To specify a Change Date.
+
+4. Not to modify this License in any other way.
+ **/
@@ -0,0 +1,273 @@
+﻿/* @author: Ario Amin @ Permafrost Development. @copyright: Full BSL(1.1) License included at bottom of the file  */
+
+#include "RTSOpenCommon.h"
+#include "Algo/AllOf.h"
+#include "Algo/Sort.h"
+#include "Algo/Unique.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace PD::Selection::Tests
+{
+	/** @brief Sorted, de-duplicated handles drawn from a small index range so sets overlap often */
+	TArray<FMassEntityHandle> MakeSortedHandles(FRandomStream& Stream, const int32 MaxCount)
+	{
+		TArray<FMassEntityHandle> Handles;
+		const int32 Count = Stream.RandRange(0, MaxCount);
+		for (int32 Idx = 0; Idx < Count; Idx++)
+		{
+			Handles.Emplace(Stream.RandRange(1, 64), Stream.RandRange(1, 2));
+		}
+		Algo::Sort(Handles, &FRTSOSelectionGroups::HandleLess);
+		Handles.SetNum(Algo::Unique(Handles));
+		return Handles;
+	}
+
+	/** @brief Is the array strictly ascending, i.e. sorted and free of duplicates */
+	bool IsStrictlySorted(TConstArrayView<FMassEntityHandle> Handles)
+	{
+		for (int32 Idx = 1; Idx < Handles.Num(); Idx++)
+		{
+			if (FRTSOSelectionGroups::HandleLess(Handles[Idx - 1], Handles[Idx]) == false) { return false; }
+		}
+		return true;
+	}
+
+	/** @brief Reference set operation, the handles of 'Left' that are not in 'Right', in the order of 'Left' */
+	TArray<FMassEntityHandle> ReferenceDifference(TConstArrayView<FMassEntityHandle> Left, TConstArrayView<FMassEntityHandle> Right)
+	{
+		TArray<FMassEntityHandle> Difference;
+		for (const FMassEntityHandle& Handle : Left)
+		{
+			if (Right.Contains(Handle) == false) { Difference.Emplace(Handle); }
+		}
+		return Difference;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRTSOSelectionDifferenceTest, "PD.RTSOpen.Selection.Difference", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FRTSOSelectionDifferenceTest::RunTest(const FString& Parameters)
+{
+	using namespace PD::Selection::Tests;
+	
+	TArray<FMassEntityHandle> Difference;
+	const TArray<FMassEntityHandle> Handles{{1, 1}, {2, 1}, {2, 2}, {5, 1}};
+	FRTSOSelectionGroups::Difference(Handles, {}, Difference);
+	TestTrue(TEXT("Nothing on the right keeps the left"), Difference == Handles);
+	FRTSOSelectionGroups::Difference({}, Handles, Difference);
+	TestTrue(TEXT("Nothing on the left is empty"), Difference.IsEmpty());
+	FRTSOSelectionGroups::Difference(Handles, Handles, Difference);
+	TestTrue(TEXT("A set minus itself is empty"), Difference.IsEmpty());
+	FRTSOSelectionGroups::Difference(Handles, TArray<FMassEntityHandle>{{2, 1}}, Difference);
+	TestTrue(TEXT("Serial numbers tell handles on the same index apart"), Difference == TArray<FMassEntityHandle>{{1, 1}, {2, 2}, {5, 1}});
+
+	FRandomStream Stream(0x5E1EC7);
+	for (int32 Run = 0; Run < 500; Run++)
+	{
+		const TArray<FMassEntityHandle> Left = MakeSortedHandles(Stream, 40);
+		const TArray<FMassEntityHandle> Right = MakeSortedHandles(Stream, 40);
+		FRTSOSelectionGroups::Difference(Left, Right, Difference);
+		if (TestTrue(TEXT("Difference matches the reference"), Difference == ReferenceDifference(Left, Right)) == false) { return false; }
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRTSOSelectionMergeRemoveTest, "PD.RTSOpen.Selection.MergeAndRemove", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FRTSOSelectionMergeRemoveTest::RunTest(const FString& Parameters)
+{
+	using namespace PD::Selection::Tests;
+
+	// Edge cases, merging into and removing from empty arrays
+	{
+		TArray<FMassEntityHandle> Sorted;
+		FRTSOSelectionGroups::MergeSorted(Sorted, TArray<FMassEntityHandle>{{3, 1}, {4, 1}});
+		TestTrue(TEXT("Merging into an empty array copies the added handles"), Sorted == TArray<FMassEntityHandle>{{3, 1}, {4, 1}});
+		FRTSOSelectionGroups::MergeSorted(Sorted, {});
+		TestEqual(TEXT("Merging nothing changes nothing"), Sorted.Num(), 2);
+		FRTSOSelectionGroups::MergeSorted(Sorted, TArray<FMassEntityHandle>{{1, 1}, {9, 1}});
+		TestTrue(TEXT("Handles are merged in front of and behind the existing ones"), Sorted == TArray<FMassEntityHandle>{{1, 1}, {3, 1}, {4, 1}, {9, 1}});
+
+		TArray<FMassEntityHandle> Removed;
+		FRTSOSelectionGroups::RemoveSorted(Sorted, TArray<FMassEntityHandle>{{2, 1}, {9, 1}, {10, 1}}, Removed);
+		TestTrue(TEXT("Only handles that were held are removed"), Removed == TArray<FMassEntityHandle>{{9, 1}});
+		TestTrue(TEXT("Remaining handles keep their order"), Sorted == TArray<FMassEntityHandle>{{1, 1}, {3, 1}, {4, 1}});
+		FRTSOSelectionGroups::RemoveSorted(Sorted, {}, Removed);
+		TestTrue(TEXT("Removing nothing reports nothing"), Removed.IsEmpty() && Sorted.Num() == 3);
+		FRTSOSelectionGroups::RemoveSorted(Sorted, TArray<FMassEntityHandle>(Sorted), Removed);
+		TestTrue(TEXT("Removing every handle empties the array"), Sorted.IsEmpty() && Removed.Num() == 3);
+	}
+
+	// Property sweep against a set, merges only take handles that are not held, as AddToGroup guarantees through Difference
+	FRandomStream Stream(0xC0FFEE);
+	for (int32 Run = 0; Run < 500; Run++)
+	{
+		TArray<FMassEntityHandle> Sorted = MakeSortedHandles(Stream, 40);
+		TArray<FMassEntityHandle> Added;
+		FRTSOSelectionGroups::Difference(MakeSortedHandles(Stream, 40), Sorted, Added);
+		
+		TSet<FMassEntityHandle> Expected(Sorted);
+		Expected.Append(Added);
+		FRTSOSelectionGroups::MergeSorted(Sorted, Added);
+		if (TestTrue(TEXT("Merged array is sorted and unique"), IsStrictlySorted(Sorted)) == false) { return false; }
+		if (TestTrue(TEXT("Merged array holds both inputs"), Sorted.Num() == Expected.Num() && Algo::AllOf(Sorted, [&Expected](const FMassEntityHandle& Handle) { return Expected.Contains(Handle); })) == false) { return false; }
+
+		const TArray<FMassEntityHandle> ToRemove = MakeSortedHandles(Stream, 40);
+		const TArray<FMassEntityHandle> ExpectedRemaining = ReferenceDifference(Sorted, ToRemove);
+		const TArray<FMassEntityHandle> ExpectedRemoved = ReferenceDifference(Sorted, ExpectedRemaining);
+		TArray<FMassEntityHandle> Removed;
+		FRTSOSelectionGroups::RemoveSorted(Sorted, ToRemove, Removed);
+		if (TestTrue(TEXT("Remaining handles match the reference"), Sorted == ExpectedRemaining) == false) { return false; }
+		if (TestTrue(TEXT("Reported removals match the reference"), Removed == ExpectedRemoved) == false) { return false; }
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRTSOSelectionMoveGroupTest, "PD.RTSOpen.Selection.MoveGroup", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FRTSOSelectionMoveGroupTest::RunTest(const FString& Parameters)
+{
+	FRTSOSelectionGroups Groups;
+	Groups.SetGroup(1, TArray<FMassEntityHandle>{{4, 1}, {2, 1}, {4, 1}});
+	Groups.SetGroup(2, TArray<FMassEntityHandle>{{7, 1}});
+	TestTrue(TEXT("SetGroup sorts and de-duplicates"), *Groups.FindGroup(1) == TArray<FMassEntityHandle>{{2, 1}, {4, 1}});
+
+	const FMassEntityHandle* GroupData = Groups.FindGroup(1)->GetData();
+	TestTrue(TEXT("Moving an existing group succeeds"), Groups.MoveGroup(1, 3));
+	TestFalse(TEXT("The old ID is gone"), Groups.Contains(1));
+	TestTrue(TEXT("The new ID holds the members"), Groups.FindGroup(3) != nullptr && *Groups.FindGroup(3) == TArray<FMassEntityHandle>{{2, 1}, {4, 1}});
+	TestTrue(TEXT("The handle array is moved, not copied"), Groups.FindGroup(3) != nullptr && Groups.FindGroup(3)->GetData() == GroupData);
+
+	TestTrue(TEXT("Moving onto an existing group succeeds"), Groups.MoveGroup(3, 2));
+	TestTrue(TEXT("The target group is overwritten"), *Groups.FindGroup(2) == TArray<FMassEntityHandle>{{2, 1}, {4, 1}});
+	TestFalse(TEXT("The source group is gone"), Groups.Contains(3));
+
+	TestFalse(TEXT("Moving a missing group fails"), Groups.MoveGroup(5, 6));
+	TestFalse(TEXT("A failed move creates no group"), Groups.Contains(6));
+	TestTrue(TEXT("Moving a group onto itself keeps it"), Groups.MoveGroup(2, 2) && Groups.Contains(2));
+	TestFalse(TEXT("Moving a missing group onto itself fails"), Groups.MoveGroup(5, 5));
+
+	// The moved group keeps working with the incremental add and remove
+	TArray<FMassEntityHandle> Changed;
+	Groups.AddToGroup(2, TArray<FMassEntityHandle>{{3, 1}, {4, 1}}, Changed);
+	TestTrue(TEXT("Only new members are reported as added"), Changed == TArray<FMassEntityHandle>{{3, 1}});
+	TestTrue(TEXT("Added member is found"), Groups.IsInGroup(2, {3, 1}));
+	Groups.RemoveFromGroup(2, TArray<FMassEntityHandle>{{2, 1}, {3, 1}, {4, 1}}, Changed);
+	TestEqual(TEXT("Every member is reported as removed"), Changed.Num(), 3);
+	TestFalse(TEXT("An emptied group is removed"), Groups.Contains(2));
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
+
+/**
+Business Source License 1.1
+
+Parameters
+
+Licensor:             Ario Amin (@ Permafrost Development)
+Licensed Work:        RTSOpen (Source available on github)
+                      The Licensed Work is (c) 2024 Ario Amin (@ Permafrost Development)
+Additional Use Grant: You may make free use of the Licensed Work in a commercial product or service provided these three additional conditions as met; 
+                      1. Must give attributions to the original author of the Licensed Work, in 'Credits' if that is applicable.
+                      2. The Licensed Work must be Compiled before being redistributed.
+                      3. The Licensed Work Source may be linked but may not be packaged into the product or service being sold
+                      4. Must not be resold or repackaged or redistributed as another product, is only allowed to be used within a commercial or non-commercial game project.
+                      5. Teams with yearly budgets larger than 100000 USD must contact the owner for a custom license or buy the framework from a marketplace it has been made available on.
+
+                      "Credits" indicate a scrolling screen with attributions. This is usually in a products end-state
+
+                      "Package" means the collection of files distributed by the Licensor, and derivatives of that collection
+                      and/or of those files..   
+
+                      "Source" form means the source code, documentation source, and configuration files for the Package, usually in human-readable format.
+
+                      "Compiled" form means the compiled bytecode, object code, binary, or any other
+                      form resulting from mechanical transformation or translation of the Source form.
+
+Change Date:          2028-04-17
+
+Change License:       Apache License, Version 2.0
+
+For information about alternative licensing arrangements for the Software,
+please visit: https://permadev.se/
+
+Notice
+
+The Business Source License (this document, or the “License”) is not an Open
+Source license. However, the Licensed Work will eventually be made available
+under an Open Source License, as stated in this License.
+
+License text copyright (c) 2017 MariaDB Corporation Ab, All Rights Reserved.
+“Business Source License” is a trademark of MariaDB Corporation Ab.
+
+-----------------------------------------------------------------------------
+
+Business Source License 1.1
+
+Terms
+
+The Licensor hereby grants you the right to copy, modify, create derivative
+works, redistribute, and make non-production use of the Licensed Work. The
+Licensor may make an Additional Use Grant, above, permitting limited
+production use.
+
+Effective on the Change Date, or the fourth anniversary of the first publicly
+available distribution of a specific version of the Licensed Work under this
+License, whichever comes first, the Licensor hereby grants you rights under
+the terms of the Change License, and the rights granted in the paragraph
+above terminate.
+
+If your use of the Licensed Work does not comply with the requirements
+currently in effect as described in this License, you must purchase a
+commercial license from the Licensor, its affiliated entities, or authorized
+resellers, or you must refrain from using the Licensed Work.
+
+All copies of the original and modified Licensed Work, and derivative works
+of the Licensed Work, are subject to this License. This License applies
+separately for each version of the Licensed Work and the Change Date may vary
+for each version of the Licensed Work released by Licensor.
+
+You must conspicuously display this License on each original or modified copy
+of the Licensed Work. If you receive the Licensed Work in original or
+modified form from a third party, the terms and conditions set forth in this
+License apply to your use of that work.
+
+Any use of the Licensed Work in violation of this License will automatically
+terminate your rights under this License for the current and all other
+versions of the Licensed Work.
+
+This License does not grant you any right in any trademark or logo of
+Licensor or its affiliates (provided that you may use a trademark or logo of
+Licensor as expressly required by this License).
+
+TO THE EXTENT PERMITTED BY APPLICABLE LAW, THE LICENSED WORK IS PROVIDED ON
+AN “AS IS” BASIS. LICENSOR HEREBY DISCLAIMS ALL WARRANTIES AND CONDITIONS,
+EXPRESS OR IMPLIED, INCLUDING (WITHOUT LIMITATION) WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT, AND
+TITLE.
+
+MariaDB hereby grants you permission to use this License’s text to license
+your works, and to refer to it using the trademark “Business Source License”,
+as long as you comply with the Covenants of Licensor below.
+
+Covenants of Licensor
+
+In consideration of the right to use this License’s text and the “Business
+Source License” name and trademark, Licensor covenants to MariaDB, and to all
+other recipients of the licensed work to be provided by Licensor:
+
+1. To specify as the Change License the GPL Version 2.0 or any later version,
+   or a license that is compatible with GPL Version 2.0 or a later version,
+   where “compatible” means that software provided under the Change License can
+   be included in a program with software provided under GPL Version 2.0 or a
+   later version. Licensor may specify additional Change Licenses without
+   limitation.
+
+2. To either: (a) specify an additional grant of rights to use that does not
+   impose any additional restriction on the right granted in this License, as
+   the Additional Use Grant; or (b) insert the text “None”.
+
+3. To specify a Change Date.
+
+4. Not to modify this License in any other way.
+ **/
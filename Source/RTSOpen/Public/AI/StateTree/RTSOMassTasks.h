@@ -34,6 +34,10 @@ struct FRTSOTaskData_Interact
 	/** @brief Potential Interaction Target: Actor */
 	UPROPERTY(VisibleAnywhere, Category = Input)
 	AActor* PotentialInteractableActor;	
+
+	/** @brief Written by the requests resolution callback, unset until then
+	 * @note Shared with the callback, instance data may be moved around while the request is queued */
+	TSharedPtr<TOptional<EPDInteractResult>> InteractResult;
 };
 
 /**
@@ -76,7 +80,7 @@ struct RTSOPEN_API FRTSOTask_ActionLog : public FMassStateTreeTaskBase
 
 /**
  * @brief Interaction task.
- * @details Attempts to call Execute_OnInteract if the given target (or proxy object if the target's an entity) has an interface of type IPDInteractInterface 
+ * @details Requests a batched interaction with the given target actor or entity, see 'UPDInteractSubsystem::RequestInteraction' 
  */
 USTRUCT()
 struct RTSOPEN_API FRTSOTask_Interact : public FMassStateTreeTaskBase
@@ -85,18 +89,23 @@ struct RTSOPEN_API FRTSOTask_Interact : public FMassStateTreeTaskBase
 
 	using FInstanceDataType = FRTSOTaskData_Interact;
 	
-	/** @brief Links external data: EntitySubsystemHandle, InventoryHandle*/
+	/** @brief Links external data: EntitySubsystemHandle, InventoryHandle, SignalAggregatorHandle*/
 	virtual bool Link(FStateTreeLinker& Linker) override;
 	/** @brief Returns the static struct of the instance data shorthand */
 	virtual const UStruct* GetInstanceDataType() const override { return FInstanceDataType::StaticStruct(); }
-	/** @brief Triggers OnInteract on the actor, (and/or entity proxy when the function is finished), if it turns out to be a valid interactable
-	 * @todo write actual logic for interaction with other entity. use proxy such as the RTSBaseUnit (ISM subclass)
+	/** @brief Queues an interaction with the target actor or entity on the interact subsystem, which dispatches it to the targets native handler at the end of the frame
+	 * @note Keeps running until the request has been resolved, the resolution callback signals the entity
 	 * @todo @backlog have some notes in there which I've not fully decided on, revise at some point */
 	virtual EStateTreeRunStatus EnterState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
+	/** @brief Succeeds or fails, and logs it to the action log, once the handler has reported the interactions result */
+	virtual EStateTreeRunStatus Tick(FStateTreeExecutionContext& Context, const float DeltaTime) const override;
+	/** @brief Drops the pending result, a late resolution is ignored */
+	virtual void ExitState(FStateTreeExecutionContext& Context, const FStateTreeTransitionResult& Transition) const override;
 
 	/** @defgroup ExternalHandles */
 	TStateTreeExternalDataHandle<UMassEntitySubsystem> EntitySubsystemHandle; /**<@ingroup ExternalHandles*/
 	TStateTreeExternalDataHandle<UPDInteractSubsystem> InteractSubsystemHandle; /**<@ingroup ExternalHandles*/
+	TStateTreeExternalDataHandle<UPDSignalAggregator> SignalAggregatorHandle; /**<@ingroup ExternalHandles*/
 	TStateTreeExternalDataHandle<FRTSOLightInventoryFragment> InventoryHandle; /**<@ingroup ExternalHandles*/
 };
 
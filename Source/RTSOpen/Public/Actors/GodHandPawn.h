@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "PDItemCommon.h"
+#include "PDBuildCommon.h"
 #include "GameplayTagContainer.h"
 #include "InputActionValue.h"
 #include "MassEntityTypes.h"
@@ -146,15 +147,17 @@ public:
 	UE_DEPRECATED(5.3, "Entities are queried using the RTS subsystem. Call AGodHandPawn::FindClosestMassEntity to retrieve any entitiy overlapping the player cursor.")
 	virtual FMassEntityHandle OctreeEntityTrace_DEPRECATED(const FVector& StartLocation, const FVector& EndLocation);
 	
-	/** @brief Call into the UPDRTSBaseSubsystem and check if it's OctreeUserQuery.CurrentBuffer has anything entries for us to read */
+	/** @brief Returns the closest owned entity from the hover candidate cache that is still under the cursor, if any */
 	FMassEntityHandle FindClosestMassEntity() const;
-	/** @brief Does an overlap check and picks the closes actor inheriting from IPDInteractInterface, if any*/
+	/** @brief Returns the closest actor inheriting from IPDInteractInterface from the hover candidate cache, if any */
 	AActor* FindClosestInteractableActor() const;
 	/** @brief Helper to return the value of the given entity's transform fragment, if entity is valid. */
 	const FTransform& GetEntityTransform(const FMassEntityHandle& Handle) const;
 	int32 GetEntityOwnerID(const FMassEntityHandle& Handle) const;
-	/** @brief Calls 'FindClosestMassEntity()' and 'FindClosestInteractableActor()' */
+	/** @brief Rebuilds the hover candidates if their inputs have changed, then calls 'FindClosestMassEntity()' and 'FindClosestInteractableActor()' */
 	void HoverTick(float DeltaTime);
+	/** @brief Gathers overlapping interactable actors and owned entities near the cursor into the hover candidate cache */
+	void RebuildHoverCandidates(const FRTSOHoverInputs& Inputs);
 	
 	/* RTSO Input Interface - Start */
 	/** @brief Adds movement input to the input vector scaled by 100 */
@@ -277,6 +280,9 @@ public:
 	/** @brief The ghost mesh of the currently selected buildable */
 	UPROPERTY()
 	AActor* CurrentGhost = nullptr;
+	/** @brief Per-cell placement results of the current ghosts footprint, updated each tick while placing. Usable for rendering the footprint */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "RTS|Pawn|Build")
+	TArray<FPDBuildFootprintCell> GhostFootprintCells{};
 
 	/** @brief Spawned buildings, may be ghosts or completed buildings */
 	UPROPERTY()
@@ -316,6 +322,11 @@ public:
 
 	/** @brief Active entity manager, exists in the mass entity subsystem */
 	const FMassEntityManager* EntityManager = nullptr; 
+
+	/** @brief Ranked hover candidates, rebuilt only when the cursor, camera or nearby population changes */
+	FRTSOHoverCandidateCache HoverCandidates{};
+	/** @brief Bumped on collision overlap events, tells the hover candidate cache the nearby actor population has changed */
+	uint32 HoverActorPopulationVersion = 0;
 };
 
 
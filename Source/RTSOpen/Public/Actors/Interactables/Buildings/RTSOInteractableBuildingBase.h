@@ -53,6 +53,8 @@ public:
 	virtual void Tick(float DeltaTime) override;
 	/** @brief Only calls Super. Reserved for later use  */
 	virtual void BeginPlay() override;
+	/** @brief Deregisters as an occupant from the builder subsystem, then calls Super::EndPlay */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	/** @brief  Calls 'OnBuildingDestroyed' then calls Super::BeginDestroy */
 	virtual void BeginDestroy() override;
 
@@ -35,8 +35,10 @@ class RTSOPEN_API ARTSOInteractableResourceBase
 public:
 	/** @brief Sets default job to 'TAG_AI_Job_WalkToTarget' and enables the tickcomponent*/ 
 	ARTSOInteractableResourceBase();
-	/** @brief Caches a pointer to the entity subsystem and it's entity manager*/
+	/** @brief Caches a pointer to the entity subsystem and it's entity manager, registers as an occupant with the builder subsystem */
 	virtual void BeginPlay() override;
+	/** @brief Deregisters as an occupant from the builder subsystem */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	/** @brief Ticks usage the cooldown. @todo move into a progression/stat system*/
 	virtual void Tick(float DeltaTime) override;
 	
@@ -10,6 +10,7 @@
 #include "GameplayTagContainer.h"
 #include "InputModifiers.h"
 #include "MassEntityTypes.h"
+#include "MassEntityQuery.h"
 #include "GameFramework/PlayerController.h"
 #include "Interfaces/PDRTSBuilderInterface.h"
 #include "Interfaces/RTSOActionLogInterface.h"
@@ -52,7 +53,7 @@ class RTSOPEN_API ARTSOController
 	 * and generates or loads a persistent ID from UPDRTSBaseSubsystem and proceeds to register it
 	 * Lastly it instantiates the actual conversation widget in memory */
 	virtual void BeginPlay() override;
-	/** @brief Unregisters the actors persistent ID in UPDRTSBaseSubsystem */
+	/** @brief Unregisters the actors persistent ID in UPDRTSBaseSubsystem, unbinds from the level streaming delegates */
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	/** @brief Todo move to interface, refreshes or creates a new player ID */
@@ -120,6 +121,13 @@ class RTSOPEN_API ARTSOController
 	/*Handled via the buttons target widget class*/ // UFUNCTION() void OnReleased_Save();
 	/*Handled via the buttons target widget class*/ // UFUNCTION() void OnReleased_Load();
 	/* RTSO Menu interface - End, @todo move to actual interface if we start making more menus*/
+	
+	/** @brief Returns this frames cursor ground sample on the given channel. The first call in a frame samples it, later calls reuse it */
+	const FRTSOCursorGroundSample& GetCursorGroundSample(TEnumAsByte<ECollisionChannel> TraceChannel) const;
+	/** @brief Returns this frames cursor ground sample on 'DedicatedLandscapeTraceChannel' */
+	const FRTSOCursorGroundSample& GetCursorGroundSample() const;
+	
+	/** @brief Shorthands for 'GetCursorGroundSample', all overloads share the same per-frame sample */
 	void ProjectMouseToGroundPlane(
 		FVector2D& ScreenCoordinates,
 		FVector&   IntersectionPoint,
@@ -212,34 +220,34 @@ class RTSOPEN_API ARTSOController
 	
 	/** @brief Queues a draw-call into chaos' async debug draw queue */
 	static void DrawBoxAndTextChaos(const FVector& BoundsCenter, const FQuat& Rotation, const FVector& DebugExtent, const FString& DebugBoxTitle, FColor LineColour = FColor::Black);
-	/** @brief This function is here to fix a edge-case issue where the marquee volume is affected by large differences in z-height between the start corner and end corner world hit-results*/
-	static void AdjustMarqueeHitResultsToMinimumHeight(FHitResult& StartHitResult, FHitResult& CenterHitResult, FHitResult& EndHitResult);
-	/** @brief Queries the octree with the marquee selection volume and stores found handles in 'MarqueeSelectedHandles' */
+	/** @brief Projects the owned entities in view into 'ScreenSelectionIndex'. Candidates are the entities the representation LOD considers visible, within 'MarqueeSelectionMaxDistance' */
+	void RefreshScreenSelectionIndex();
+	/** @brief Refreshes the screen selection index, gathers the entities projected inside the drawn marquee rectangle and stores them in a new selection group */
 	UFUNCTION() void GetEntitiesOrActorsInMarqueeSelection();
 	/** @brief Reorder a selection group */
 	UFUNCTION() void ReorderGroupIndex(const int32 OldID, const int32 NewID);
-	/** @brief Returns immutable ref to 'MarqueeSelectedHandles'. A map keyed by the owner ID and value by a nested map keyed by selection indices and the nested value being the actual selection group handles*/
-	const TMap<int32, TMap<int32, FMassEntityHandle>>& GetImmutableMarqueeSelectionMap() const { return MarqueeSelectedHandles; }
-	/** @brief Returns mutable ref to 'MarqueeSelectedHandles'. A map keyed by the owner ID and value by a nested map keyed by selection indices and the nested value being the actual selection group handles*/
-	TMap<int32, TMap<int32, FMassEntityHandle>>& GetMutableMarqueeSelectionMap() { return MarqueeSelectedHandles; }
+	/** @brief Returns immutable ref to 'SelectionGroups'. Sorted entity handle arrays keyed by selection group ID */
+	const FRTSOSelectionGroups& GetSelectionGroups() const { return SelectionGroups; }
+	/** @brief Returns mutable ref to 'SelectionGroups'. Sorted entity handle arrays keyed by selection group ID */
+	FRTSOSelectionGroups& GetMutableSelectionGroups() { return SelectionGroups; }
 	
 	/** @return The conversation widget pointer, it will always be valid after begin-play in case 'ConversationWidgetClass' is pointing to a valid class */
 	UFUNCTION() URTSOConversationWidget* GetConversationWidget() const { return ConversationWidget;};
 
-	/** @brief Marquee related hit results, start corner */
-	UFUNCTION() FHitResult GetLatestStartHitResult()  { return LatestStartHitResult;};
 	/** @brief Marquee related hit results, center-point */
 	UFUNCTION() FHitResult GetLatestCenterHitResult() { return LatestCenterHitResult;};
-	/** @brief Marquee related hit results, end corner */
-	UFUNCTION() FHitResult GetLatestEndHitResult()    { return LatestEndHitResult;};	
 
 
 	UFUNCTION() UPDBuildingActionsWidgetBase* GetBuildableActionsWidget() const { return BuildableActionsWidget; }
 	UFUNCTION() URTSOActionLogUserWidget* GetActionLogWidget() const { return ActionLogWidget; }
 	
-	/** @brief Dispatches a sync 'ParallelFor' that updates 'FPDMFragment_RTSEntityBase' fragments for all entities in the current selection group 
-	 * @note Called when a new selection group is created or deselected. */
+	/** @brief Diffs the current selection group against the currently applied selection and defers selection tag and fragment updates for the difference only
+	 * @note Called when a new selection group is created, recalled or deselected. */
 	void OnSelectionChange(bool bClearSelection);
+	/** @brief Adds entities to a selection group, if it is the applied selection then only the added entities are updated */
+	void AddToSelectionGroup(int32 GroupID, TConstArrayView<FMassEntityHandle> Handles);
+	/** @brief Removes entities from a selection group, if it is the applied selection then only the removed entities are updated */
+	void RemoveFromSelectionGroup(int32 GroupID, TConstArrayView<FMassEntityHandle> Handles);
 
 protected:
 
@@ -247,6 +255,20 @@ protected:
 	 * then updates the widget based on this */
 	void UpdateBuildMenuContexts(const FMassEntityHandle& CurrentEntity) const;
 
+	/** @brief Defers adding/removing FPDMTag_Selected and updating 'FPDMFragment_RTSEntityBase' selection data for the given entities.
+	 * @note Commands are flushed by mass between processing phases, tags are changed in archetype batches and never race the cosmetics processor */
+	void DeferSelectionState(TConstArrayView<FMassEntityHandle> Handles, bool bSelected, int32 GroupID) const;
+
+	/** @brief Takes a fresh cursor ground sample into 'Sample', from the heightfield if enabled and possible, otherwise from a trace */
+	void SampleCursorGround(FRTSOCursorGroundSample& Sample) const;
+	/** @brief Intersects the cursor ray with the landscape heightfield. Starts at the pawns height and refines against the sampled terrain height
+	 * @return false if there is no landscape under the ray */
+	bool SampleCursorHeightfield(const FVector& RayOrigin, const FVector& RayDirection, FVector& OutIntersection) const;
+	/** @brief Returns the landscape height at the given world XY, unset if no landscape covers it */
+	TOptional<float> GetLandscapeHeightAt(const FVector& WorldLocation) const;
+	/** @brief Bound to the level added/removed world delegates, marks 'CursorLandscapes' for re-gathering if the level belongs to our world */
+	void OnWorldLevelsChanged(ULevel* Level, UWorld* World);
+
 private:
 	/** @brief Calls 'OnEndConversation' with a dummy payload.
 	 * @note - Is called from 'ActionExitConversation_Implementation'
@@ -265,6 +287,14 @@ public:
 	/** @brief Use for mouse-to-world projection traces */
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "RTS|Cursor|State")
 	TEnumAsByte<ECollisionChannel> DedicatedLandscapeTraceChannel = ECollisionChannel::ECC_GameTraceChannel13;	
+
+	/** @brief Sample the cursor ground location from the landscape heightfield instead of tracing, on 'DedicatedLandscapeTraceChannel' only.
+	 * Falls back to a trace where there is no landscape under the cursor */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RTS|Cursor|Settings")
+	bool bSampleCursorHeightfield = false;
+	/** @brief Height refinement steps when sampling the heightfield, each step is one height lookup */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RTS|Cursor|Settings", Meta = (ClampMin = 1, ClampMax = 8))
+	int32 CursorHeightfieldIterations = 3;
 	
 	/** @defgroup RTSInputActions. Assign these in editor @todo make developer settings struct to assign these from .ini configs also? */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "RTS|Input")
@@ -302,6 +332,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "RTS|Input")
 	double ClickToSelectErrorMin = 350.0;
 
+	/** @brief How far from the camera entities can be marquee selected, bounds the candidates of the screen selection index */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "RTS|Input")
+	double MarqueeSelectionMaxDistance = 50000.0;
+
 protected:
 	/** @brief Main menu widget base class, has a widget stack for supplying different stacked widgets */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Menu|Startscreen")
@@ -347,15 +381,9 @@ protected:
 	URTSOActionLogUserWidget* ActionLogWidget = nullptr;
 	
 	
-	/** @brief Marquee related hit results, start corner */
-	UPROPERTY(VisibleInstanceOnly)
-	FHitResult LatestStartHitResult{};
 	/** @brief Marquee related hit results, center-point */
 	UPROPERTY(VisibleInstanceOnly)
 	FHitResult LatestCenterHitResult{};
-	/** @brief Marquee related hit results, end corner */	
-	UPROPERTY(VisibleInstanceOnly)
-	FHitResult LatestEndHitResult{};
 
 	/** @brief Actors persistent ID, is generated upon BeginPlay if none already exists in the UPDRTSBaseSubsystem */
 	UPROPERTY(VisibleInstanceOnly)
@@ -383,16 +411,30 @@ protected:
 	FVector2D StartMousePositionMarquee{};
 	/** @brief Marquee - (Current) screen position */
 	FVector2D CurrentMousePositionMarquee{};
+	/** @brief Marquee - Owned entities in view, projected to screen-space and bucketed into screen tiles */
+	FRTSOScreenSelectionIndex ScreenSelectionIndex{};
+	/** @brief Marquee - Query over the selectable entities, kept alive so its archetype matches are cached between selections */
+	FMassEntityQuery ScreenSelectionQuery{};
 	
 	/** @brief Selection groups that have been hot-keyed */
 	TSet<int32> HotKeyedSelectionGroups{};	
 	/** @brief All selection groups.
 	 * - Keyed by selection ID.
-	 * - Value is a nested map keyed by entity ID and it's inner value being the actual entity handle
-	 * - The nested map could be replaced with a set but search complexity will virtually be the same. Or rather might be slower as we a hash of FMassEntityHandle could have collisions where int32 would have 0 collisions 
-	 * Space complexity will however be three times in size but even at a selection group of 10.000 entities this is still less than 120KB working memory 
+	 * - Value is a dense handle array sorted by entity index, at a selection group of 10.000 entities this is 80KB working memory 
 	 */
-	TMap<int32, TMap<int32, FMassEntityHandle>> MarqueeSelectedHandles{};
+	FRTSOSelectionGroups SelectionGroups{};
+	/** @brief Entities currently marked as selected, sorted. Selection changes are diffed against this */
+	TArray<FMassEntityHandle> AppliedSelection{};
+	/** @brief Group ID the applied selection was applied with */
+	int32 AppliedSelectionGroupID = INDEX_NONE;
+
+	/** @brief This frames cursor ground samples, one per requested trace channel */
+	mutable TArray<FRTSOCursorGroundSample, TInlineAllocator<2>> CursorGroundSamples{};
+	/** @brief Landscapes the heightfield sampling looks up heights in, gathered on first use and re-gathered when levels are added or removed */
+	mutable TArray<TWeakObjectPtr<class ALandscapeProxy>> CursorLandscapes{};
+	mutable bool bHasGatheredCursorLandscapes = false;
+	FDelegateHandle LevelAddedHandle{};
+	FDelegateHandle LevelRemovedHandle{};
 
 	/** @brief Empty key array, returned as dummy when we can't find a selection group */
 	static inline const TArray<int32> EmptyKeys = {};
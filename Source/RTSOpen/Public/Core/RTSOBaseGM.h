@@ -12,6 +12,7 @@
 class ARTSOController;
 class URTSOMainMenuBase;
 class URTSOpenSaveGame;
+struct FPDInteractionRequest;
 
 /** @brief  Load-screen state, are we just ending or in the middle of loading */
 UENUM()
@@ -89,10 +90,10 @@ class RTSOPEN_API ARTSOBaseGM : public AGameModeBase
 	GENERATED_UCLASS_BODY()
 
 public:
-	/** @brief  Creates a new savegame object and tells the GI that the GM is ready */
+	/** @brief  Creates a new savegame object, registers the entity interaction handlers and tells the GI that the GM is ready */
 	virtual void BeginPlay() override;
 
-	/** @brief Unload entities from the octree */
+	/** @brief Unload entities from the octree, deregisters the entity interaction handlers */
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	
 	//
@@ -113,7 +114,7 @@ public:
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable)
 	void ProcessChangesAndSaveGame(const FString& Slot, const bool bAllowOverwrite = false);
 
-	/** @brief Save ConversationProgression */
+	/** @brief Save ConversationProgression. Applies each tracked players logged progression tag changes to 'PlayersAndConversationTags' */
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable)
 	void SaveConversationProgression();	
 
@@ -151,6 +152,9 @@ public:
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable)
 	void OnGeneratedLandscapeReady();
 
+	/** @brief Native interaction handler for entities carrying a light inventory. Hands the instigating entities carried items over to the target entity, reports INTERACT_FAIL for requests it could not apply */
+	void HandleEntityInventoryInteractions(const UWorld* World, TConstArrayView<FPDInteractionRequest> Requests, TArrayView<EPDInteractResult> OutResults);
+
 	/** @brief Reserved. Only calls super for now */
 	virtual void Logout(AController* Exiting) override;
 	/** @brief  Spawns a default base for our player in case they do no have buildings in the world already. */
@@ -84,6 +84,9 @@ class RTSOPEN_API URTSActionLogSubsystem : public UEngineSubsystem
 public:
 	static URTSActionLogSubsystem* Get();
 
+	/** @brief Applies the default settings and requests the asynchronous ingestion of the style tables into 'StyleDataMap' */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
 	void DispatchEventInner(int32 WidgetID, const FRTSOActionLogEvent& NewActionEvent);
 	
 	static void LinkWidget(int32 WidgetID, const URTSOActionLogUserWidget* TargetWidget);
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
+#include "RTSOpenCommon.h"
 #include "RTSOActionLogInterface.h"
 #include "Interfaces/PDRTSBuilderInterface.h"
 #include "UObject/Interface.h"
@@ -47,6 +48,7 @@ public:
 	virtual void AddUniqueProgressionTag_Implementation(const FGameplayTag& NewTag)
 	{
 		AcquiredConversationProgressionTags.AddTag(NewTag);
+		AcquiredProgressionTagBits.Add(NewTag);
 	} /**< @ingroup ConversationInterface_AddProgressTag */
 
 	/** @defgroup ConversationInterface_RemoveProgressTag
@@ -56,7 +58,7 @@ public:
 	void RemoveProgressionTag(const FGameplayTag& TagToRemove);
 	virtual void RemoveProgressionTag_Implementation(const FGameplayTag& TagToRemove)
 	{
-		if (AcquiredConversationProgressionTags.HasTag(TagToRemove))
+		if (AcquiredProgressionTagBits.Remove(TagToRemove))
 		{
 			AcquiredConversationProgressionTags.RemoveTag(TagToRemove);
 		}
@@ -74,6 +76,7 @@ public:
 		for(FGameplayTag NewTag : NewTags)
 		{
 			NewContainer.AddTag(NewTag);
+			AcquiredProgressionTagBits.Add(NewTag);
 		}
 		
 		AcquiredConversationProgressionTags.AppendTags(NewContainer);
@@ -89,6 +92,7 @@ public:
 		for (const FGameplayTag& Tag : TagsToRemove)
 		{
 			AcquiredConversationProgressionTags.RemoveTag(Tag);
+			AcquiredProgressionTagBits.Remove(Tag);
 		}
 	}
 
@@ -100,6 +104,10 @@ public:
 	virtual void AddProgressionTagContainer_Implementation(const FGameplayTagContainer& NewTags)
 	{
 		AcquiredConversationProgressionTags.AppendTags(NewTags);
+		for (const FGameplayTag& NewTag : NewTags)
+		{
+			AcquiredProgressionTagBits.Add(NewTag);
+		}
 	}
 
 	
@@ -111,6 +119,10 @@ public:
 	virtual void RemoveProgressionTagContainer_Implementation(const FGameplayTagContainer& TagsToRemove)
 	{
 		AcquiredConversationProgressionTags.RemoveTags(TagsToRemove);
+		for (const FGameplayTag& Tag : TagsToRemove)
+		{
+			AcquiredProgressionTagBits.Remove(Tag);
+		}
 	}
 	
 	/** @brief Returns the list of acquired conversation progression tags */
@@ -126,13 +138,29 @@ public:
 	bool HasProgressionTag(const FGameplayTag& CompareTag);
 	virtual bool HasProgressionTag_Implementation(const FGameplayTag& CompareTag)
 	{
-		return AcquiredConversationProgressionTags.HasTag(CompareTag);
+		return AcquiredProgressionTagBits.Has(CompareTag);
+	}
+
+	/** @brief Returns true if we have every tag in 'RequiredTagMask', a mask built by 'FRTSOProgressionTagRegistry'.
+	 * @note Word-wise AND and compare against our progression bitset */
+	virtual bool HasAllProgressionTags(const TBitArray<>& RequiredTagMask) const
+	{
+		return AcquiredProgressionTagBits.HasAll(RequiredTagMask);
+	}
+
+	/** @brief Moves the progression tag changes logged since the last call into 'OutChanges', used to update the save-data incrementally */
+	virtual void ConsumeProgressionTagChanges(TArray<FRTSOProgressionTagChange>& OutChanges)
+	{
+		AcquiredProgressionTagBits.ConsumeChangeLog(OutChanges);
 	}
 	
 public:
 	/** @brief Data interface, actual data is hidden completely form the engine but accessible in code
 	 * - indirectly accessible in engine via the interface functions base implementation*/
 	FGameplayTagContainer AcquiredConversationProgressionTags{};
+
+	/** @brief Interned mirror of 'AcquiredConversationProgressionTags', used for requirement checks. Also logs changes for incremental saving */
+	FRTSOProgressionTagSet AcquiredProgressionTagBits{};
 };
 
 
@@ -0,0 +1,261 @@
+﻿/* @author: Ario Amin @ Permafrost Development. @copyright: Full BSL(1.1) License included at bottom of the file  */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "RTSOpenCommon.h"
+#include "Engine/DeveloperSettings.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "RTSOProductionSubsystem.generated.h"
+
+class UPDInventoryComponent;
+struct FPDBuildAction;
+
+/** @brief Production developer settings, modify in .ini config or in editor project settings */
+UCLASS(Config = "Game", DefaultConfig)
+class RTSOPEN_API URTSOProductionSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+public:
+	/** @brief Max amount of units that may be spawned each frame, across all buildings in the world. Units beyond the limit stay at the head of their queue until the next frame */
+	UPROPERTY(Config, EditAnywhere, Category = "Production", Meta = (ClampMin = 1))
+	int32 MaxSpawnsPerFrame = 256;
+
+	/** @brief Offset from a buildings location where its units are spawned, so they do not spawn in the middle of it */
+	UPROPERTY(Config, EditAnywhere, Category = "Production")
+	FVector SpawnOffset{0.0, 300.0, 0.0};
+};
+
+/** @brief A batch of units of the same type, queued in a building. The cost of all remaining units is reserved, i.e. already paid, until they are produced or cancelled */
+USTRUCT()
+struct RTSOPEN_API FRTSOProductionOrder
+{
+	GENERATED_BODY()
+
+	/** @brief Unit type to produce */
+	UPROPERTY()
+	FGameplayTag UnitTag{};
+	/** @brief Owner (builder) ID the produced units are assigned to */
+	int32 OwnerID = INDEX_NONE;
+	/** @brief Units left to produce in this order */
+	int32 RemainingCount = 0;
+	/** @brief Seconds it takes to produce one unit */
+	double SecondsPerUnit = 0.0;
+	/** @brief Cost of a single unit, refunded per remaining unit if the order is cancelled */
+	UPROPERTY()
+	TMap<FGameplayTag, int32> UnitCost{};
+	/** @brief The inventory that paid for this order */
+	UPROPERTY()
+	TWeakObjectPtr<UPDInventoryComponent> Payer = nullptr;
+};
+
+/** @brief Production queue of a single building. Only the order at the head of the queue makes progress */
+USTRUCT()
+struct RTSOPEN_API FRTSOProductionQueue
+{
+	GENERATED_BODY()
+
+	/** @brief The building this queue belongs to */
+	UPROPERTY()
+	TWeakObjectPtr<AActor> Building = nullptr;
+	/** @brief Key of the building in 'URTSOProductionSubsystem::QueueIndices', stays usable after the building has been destroyed */
+	TObjectKey<AActor> BuildingKey{};
+	/** @brief Queued orders, front is the order being produced */
+	UPROPERTY()
+	TArray<FRTSOProductionOrder> Orders{};
+	/** @brief Seconds spent producing the current unit of the head order */
+	double HeadProgress = 0.0;
+	/** @brief Location produced units walk to after spawning, if set */
+	TOptional<FVector> RallyPoint{};
+};
+
+/**
+ * @brief World-level unit production for buildings.
+ * - Buildings queue production orders here instead of spawning in place. Costs are reserved when an order is queued and refunded when it is cancelled
+ * - Each tick advances the head order of every queue by its build time and gathers completed units from all buildings
+ * - Completed units are spawned through one batched Mass creation per entity template, no matter how many buildings produced them
+ * - Queues are not saved, the cost they have reserved is written back into the saved inventories instead. See 'AddReservedCosts'
+ */
+UCLASS()
+class RTSOPEN_API URTSOProductionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	/** @brief Shorthand to get the production subsystem for the world of the given context object */
+	static URTSOProductionSubsystem* Get(const UObject* WorldContextObject);
+
+	/** @brief Advances all queues, then spawns every unit that completed this frame. See 'AdvanceQueues' */
+	virtual void Tick(float DeltaTime) override;
+	/** @brief Boilerplate for unreals stat system, declares and returns a cycle stat for profiling purposes */
+	virtual TStatId GetStatId() const override;
+
+	/** @brief Reserves the cost of 'Count' units from 'Payer' and queues them in the buildings production queue.
+	 * @return false if the building is invalid or the payer can not afford all units, nothing is reserved in that case */
+	bool EnqueueProduction(AActor* Building, const FPDBuildAction& ActionData, int32 OwnerID, int32 Count, UPDInventoryComponent* Payer);
+	/** @brief Cancels the order at 'OrderIdx' in the buildings queue and refunds the cost of its remaining units
+	 * @return Amount of units that were cancelled */
+	int32 CancelProduction(const AActor* Building, int32 OrderIdx);
+	/** @brief Cancels every order in the buildings queue and refunds them, call when a building is destroyed */
+	void CancelAllProduction(const AActor* Building);
+	
+	/** @brief Sets the location the buildings produced units walk to after spawning */
+	void SetRallyPoint(AActor* Building, const FVector& RallyPoint);
+	/** @brief Clears the buildings rally point, produced units stay where they spawn */
+	void ClearRallyPoint(const AActor* Building);
+	
+	/** @brief Adds the cost reserved by the unfinished orders 'Payer' has paid for to 'InOutItems', without refunding the live inventory.
+	 * @note Called when saving the payers inventory, queues are not saved so their reserved cost would otherwise be lost on load */
+	void AddReservedCosts(const UPDInventoryComponent* Payer, TArray<FPDItemNetDatum>& InOutItems) const;
+	
+	/** @brief Returns the buildings production queue, nullptr if it has none */
+	const FRTSOProductionQueue* FindQueue(const AActor* Building) const;
+
+	/** @brief Advances every queue and collects this frames completed units into 'PendingUnits', without spawning them. Is called from Tick
+	 * @note Queues are visited starting at the first one that ran out of spawn budget last frame, so no building is starved under 'MaxSpawns' */
+	void AdvanceQueues(double DeltaSeconds, int32 MaxSpawns);
+	/** @brief Units completed during the last 'AdvanceQueues' */
+	const TArray<FRTSSavedWorldUnits>& GetPendingUnits() const { return PendingUnits; }
+
+	/** @brief Units spawned during the last tick */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Production")
+	int32 LastSpawnedCount = 0;
+
+protected:
+	/** @brief Returns the buildings queue, adding an empty one if it has none */
+	FRTSOProductionQueue& FindOrAddQueue(AActor* Building);
+	/** @brief Swap-removes the queue at 'QueueIdx' and patches the index of the queue that took its place */
+	void RemoveQueueAt(int32 QueueIdx);
+	/** @brief Refunds the cost of 'Count' units of the given order to its payer */
+	static void RefundOrder(const FRTSOProductionOrder& Order, int32 Count);
+
+	/** @brief Advances the head order of the queue, appending completed units to 'PendingUnits'. Returns false once the queue is empty */
+	bool AdvanceQueue(FRTSOProductionQueue& Queue, double DeltaSeconds, int32 SpawnBudget);
+	/** @brief Spawns all 'PendingUnits', one batched Mass creation per entity template */
+	void FlushPendingUnits();
+	
+	/** @brief All production queues, dense so the tick can iterate them linearly */
+	UPROPERTY()
+	TArray<FRTSOProductionQueue> Queues{};
+	/** @brief Building to index in 'Queues' */
+	TMap<TObjectKey<AActor>, int32> QueueIndices{};
+	/** @brief Queue 'AdvanceQueues' starts at, wrapped to the queue count */
+	int32 QueueStartIdx = 0;
+
+	/** @brief Units completed this frame and waiting to be spawned, kept to avoid reallocating each frame */
+	TArray<FRTSSavedWorldUnits> PendingUnits{};
+};
+
+/**
+Business Source License 1.1
+
+Parameters
+
+Licensor:             Ario Amin (@ Permafrost Development)
+Licensed Work:        RTSOpen (Source available on github)
+                      The Licensed Work is (c) 2024 Ario Amin (@ Permafrost Development)
+Additional Use Grant: You may make free use of the Licensed Work in a commercial product or service provided these three additional conditions as met; 
+                      1. Must give attributions to the original author of the Licensed Work, in 'Credits' if that is applicable.
+                      2. The Licensed Work must be Compiled before being redistributed.
+                      3. The Licensed Work Source may be linked but may not be packaged into the product or service being sold
+                      4. Must not be resold or repackaged or redistributed as another product, is only allowed to be used within a commercial or non-commercial game project.
+                      5. Teams with yearly budgets larger than 100000 USD must contact the owner for a custom license or buy the framework from a marketplace it has been made available on.
+
+                      "Credits" indicate a scrolling screen with attributions. This is usually in a products end-state
+
+                      "Package" means the collection of files distributed by the Licensor, and derivatives of that collection
+                      and/or of those files..   
+
+                      "Source" form means the source code, documentation source, and configuration files for the Package, usually in human-readable format.
+
+                      "Compiled" form means the compiled bytecode, object code, binary, or any other
+                      form resulting from mechanical transformation or translation of the Source form.
+
+Change Date:          2028-04-17
+
+Change License:       Apache License, Version 2.0
+
+For information about alternative licensing arrangements for the Software,
+please visit: https://permadev.se/
+
+Notice
+
+The Business Source License (this document, or the “License”) is not an Open
+Source license. However, the Licensed Work will eventually be made available
+under an Open Source License, as stated in this License.
+
+License text copyright (c) 2017 MariaDB Corporation Ab, All Rights Reserved.
+“Business Source License” is a trademark of MariaDB Corporation Ab.
+
+-----------------------------------------------------------------------------
+
+Business Source License 1.1
+
+Terms
+
+The Licensor hereby grants you the right to copy, modify, create derivative
+works, redistribute, and make non-production use of the Licensed Work. The
+Licensor may make an Additional Use Grant, above, permitting limited
+production use.
+
+Effective on the Change Date, or the fourth anniversary of the first publicly
+available distribution of a specific version of the Licensed Work under this
+License, whichever comes first, the Licensor hereby grants you rights under
+the terms of the Change License, and the rights granted in the paragraph
+above terminate.
+
+If your use of the Licensed Work does not comply with the requirements
+currently in effect as described in this License, you must purchase a
+commercial license from the Licensor, its affiliated entities, or authorized
+resellers, or you must refrain from using the Licensed Work.
+
+All copies of the original and modified Licensed Work, and derivative works
+of the Licensed Work, are subject to this License. This License applies
+separately for each version of the Licensed Work and the Change Date may vary
+for each version of the Licensed Work released by Licensor.
+
+You must conspicuously display this License on each original or modified copy
+of the Licensed Work. If you receive the Licensed Work in original or
+modified form from a third party, the terms and conditions set forth in this
+License apply to your use of that work.
+
+Any use of the Licensed Work in violation of this License will automatically
+terminate your rights under this License for the current and all other
+versions of the Licensed Work.
+
+This License does not grant you any right in any trademark or logo of
+Licensor or its affiliates (provided that you may use a trademark or logo of
+Licensor as expressly required by this License).
+
+TO THE EXTENT PERMITTED BY APPLICABLE LAW, THE LICENSED WORK IS PROVIDED ON
+AN “AS IS” BASIS. LICENSOR HEREBY DISCLAIMS ALL WARRANTIES AND CONDITIONS,
+EXPRESS OR IMPLIED, INCLUDING (WITHOUT LIMITATION) WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT, AND
+TITLE.
+
+MariaDB hereby grants you permission to use this License’s text to license
+your works, and to refer to it using the trademark “Business Source License”,
+as long as you comply with the Covenants of Licensor below.
+
+Covenants of Licensor
+
+In consideration of the right to use this License’s text and the “Business
+Source License” name and trademark, Licensor covenants to MariaDB, and to all
+other recipients of the licensed work to be provided by Licensor:
+
+1. To specify as the Change License the GPL Version 2.0 or any later version,
+   or a license that is compatible with GPL Version 2.0 or a later version,
+   where “compatible” means that software provided under the Change License can
+   be included in a program with software provided under GPL Version 2.0 or a
+   later version. Licensor may specify additional Change Licenses without
+   limitation.
+
+2. To either: (a) specify an additional grant of rights to use that does not
+   impose any additional restriction on the right granted in this License, as
+   the Additional Use Grant; or (b) insert the text “None”.
+
+3. To specify a Change Date.
+
+4. Not to modify this License in any other way.
+ **/
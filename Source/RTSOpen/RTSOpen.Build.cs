@@ -52,6 +52,7 @@ public class RTSOpen : ModuleRules
 			/*Input*/        "EnhancedInput", 
 			/*Widget*/       "SlateCore", "Slate", "CommonUI", "UMG", 
 			/*Effects*/      "Niagara", "MassCrowd", 
+			/*Landscape*/    "Landscape", 
             /*Conversation*/ "CommonConversationRuntime", 
 			/*PermaDev*/     "PDInteraction", "PDInventory", "PDRTSBase", "PDConversationHelper", "PDUserMessageBase",
 		});